@@ -92,6 +92,8 @@ if(NOT MSVC)
 endif()
 check_function_exists("getifaddrs"       HAVE_GETIFADDRS)
 check_function_exists("issetugid"        HAVE_ISSETUGID)
+check_function_exists("posix_fadvise"    HAVE_POSIX_FADVISE)
+check_function_exists("posix_fallocate"  HAVE_POSIX_FALLOCATE)
 check_function_exists("setresgid"        HAVE_SETRESGID)
 check_function_exists("setresuid"        HAVE_SETRESUID)
 if (APPLE)
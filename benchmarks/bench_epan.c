@@ -0,0 +1,588 @@
+/* bench_epan.c
+ * Dissection throughput benchmark
+ *
+ * Generates fixed-seed packet corpora with randpkt_core, runs them through
+ * the dissection engine the way rawshark does, and reports packets/sec and
+ * bytes/sec per corpus as JSON. With a stored baseline, exits non-zero when
+ * a corpus regresses beyond the tolerance, so dissector performance
+ * regressions show up in CI rather than in the field.
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <config.h>
+#define WS_LOG_DOMAIN  LOG_DOMAIN_MAIN
+
+#include <glib.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ws_exit_codes.h>
+#include <wsutil/clopts_common.h>
+#include <wsutil/cmdarg_err.h>
+#include <wsutil/file_util.h>
+#include <wsutil/filesystem.h>
+#include <wsutil/json_dumper.h>
+#include <wsutil/privileges.h>
+#include <wsutil/report_message.h>
+#include <wsutil/tempfile.h>
+#include <wsutil/version_info.h>
+#include <wsutil/ws_getopt.h>
+#include <wsutil/wsjson.h>
+#include <wsutil/wslog.h>
+
+#include <epan/epan.h>
+#include <epan/epan_dissect.h>
+#include <epan/frame_data.h>
+#include <epan/prefs.h>
+#include <epan/timestamp.h>
+
+#include <wiretap/wtap.h>
+
+#include <ui/failure_message.h>
+#include <cli_main.h>
+
+#include "randpkt_core/randpkt_core.h"
+
+/* Types with no generator in randpkt_core can't be benchmarked. */
+#define DEFAULT_CORPORA "tcp,udp,dns,sctp"
+#define DEFAULT_COUNT 20000
+#define DEFAULT_MAX_BYTES 1500
+#define DEFAULT_SEED 42
+#define DEFAULT_TOLERANCE 10.0
+
+typedef struct {
+    const char *name;
+    uint64_t    packets;
+    uint64_t    bytes;
+    double      elapsed_secs;
+    double      packets_per_sec;
+    double      bytes_per_sec;
+} bench_result_t;
+
+/*
+ * Report an error in command-line arguments.
+ */
+static void
+bench_epan_cmdarg_err(const char *msg_format, va_list ap)
+{
+    fprintf(stderr, "bench_epan: ");
+    vfprintf(stderr, msg_format, ap);
+    fprintf(stderr, "\n");
+}
+
+/*
+ * Report additional information for an error in command-line arguments.
+ */
+static void
+bench_epan_cmdarg_err_cont(const char *msg_format, va_list ap)
+{
+    vfprintf(stderr, msg_format, ap);
+    fprintf(stderr, "\n");
+}
+
+static void
+usage(bool is_error)
+{
+    FILE *output = is_error ? stderr : stdout;
+    char **abbrev_list;
+    char **longname_list;
+    unsigned i = 0;
+
+    fprintf(output, "Usage: bench_epan [options]\n");
+    fprintf(output, "\n");
+    fprintf(output, "Options:\n");
+    fprintf(output, "  -t <types>        comma-separated corpus types (default: " DEFAULT_CORPORA ")\n");
+    fprintf(output, "  -c <count>        packets per corpus (default: %d)\n", DEFAULT_COUNT);
+    fprintf(output, "  -b <max bytes>    maximum bytes per packet (default: %d)\n", DEFAULT_MAX_BYTES);
+    fprintf(output, "  -s <seed>         PRNG seed for corpus generation (default: %d)\n", DEFAULT_SEED);
+    fprintf(output, "  -T                build a protocol tree for every packet\n");
+    fprintf(output, "  -o <file>         write JSON results to a file (default: standard output)\n");
+    fprintf(output, "  -B <file>         compare against a baseline JSON results file\n");
+    fprintf(output, "  -p <percent>      regression tolerance against the baseline (default: %.0f)\n", DEFAULT_TOLERANCE);
+    fprintf(output, "  -h, --help        display this help and exit.\n");
+    fprintf(output, "  -v, --version     print version information and exit.\n");
+    fprintf(output, "\n");
+    fprintf(output, "Types:\n");
+
+    randpkt_example_list(&abbrev_list, &longname_list);
+    while (abbrev_list[i] && longname_list[i]) {
+        fprintf(output, "\t%-16s%s\n", abbrev_list[i], longname_list[i]);
+        i++;
+    }
+
+    g_strfreev(abbrev_list);
+    g_strfreev(longname_list);
+}
+
+/* Generate a fixed-seed corpus for one type into a temporary file and
+ * return its pathname, or NULL on failure. */
+static char *
+generate_corpus(const char *type_name, int count, int max_bytes, uint32_t seed)
+{
+    char *tmpname = NULL;
+    GError *gerr = NULL;
+    int fd;
+    int type;
+    randpkt_example *example;
+
+    fd = create_tempfile(NULL, &tmpname, "bench_epan", ".pcapng", &gerr);
+    if (fd == -1) {
+        cmdarg_err("Can't create temporary corpus file: %s", gerr->message);
+        g_error_free(gerr);
+        return NULL;
+    }
+    ws_close(fd);
+
+    /* Same stream of packets for a given (type, count, max_bytes, seed)
+     * on every run, so results are comparable across builds. */
+    randpkt_seed_prng(seed);
+
+    type = randpkt_parse_type((char *)type_name);
+    example = randpkt_find_example(type);
+    if (randpkt_example_init(example, tmpname, max_bytes,
+                             wtap_pcapng_file_type_subtype()) != EXIT_SUCCESS) {
+        ws_unlink(tmpname);
+        g_free(tmpname);
+        return NULL;
+    }
+    randpkt_loop(example, count, 0);
+    if (!randpkt_example_close(example)) {
+        ws_unlink(tmpname);
+        g_free(tmpname);
+        return NULL;
+    }
+
+    return tmpname;
+}
+
+/* Read and dissect every packet in the corpus, timing only the read and
+ * dissection loop. Modeled on rawshark's process_packet(). */
+static bool
+bench_corpus(const char *filename, const char *type_name, bool build_tree,
+             bench_result_t *result)
+{
+    static const struct packet_provider_funcs funcs = {
+        NULL, /* get_frame_ts */
+        NULL, /* get_interface_name */
+        NULL, /* get_interface_description */
+        NULL, /* get_modified_block */
+    };
+    wtap *wth;
+    epan_t *session;
+    epan_dissect_t *edt;
+    wtap_rec rec;
+    Buffer buf;
+    frame_data fdata;
+    frame_data ref_frame;
+    frame_data prev_dis_frame;
+    const frame_data *ref = NULL;
+    frame_data *prev_dis = NULL;
+    nstime_t elapsed_time;
+    uint32_t cum_bytes = 0;
+    uint32_t count = 0;
+    uint64_t bytes = 0;
+    int64_t data_offset;
+    int64_t start, stop;
+    int err = 0;
+    char *err_info = NULL;
+
+    wth = wtap_open_offline(filename, WTAP_TYPE_AUTO, &err, &err_info, false);
+    if (wth == NULL) {
+        cfile_open_failure_message(filename, err, err_info);
+        return false;
+    }
+
+    /* A fresh session per corpus, so conversation state from one corpus
+     * can't skew the next one's numbers. */
+    session = epan_new(NULL, &funcs);
+    edt = epan_dissect_new(session, build_tree, false);
+
+    wtap_rec_init(&rec);
+    ws_buffer_init(&buf, 1514);
+    nstime_set_zero(&elapsed_time);
+
+    start = g_get_monotonic_time();
+    while (wtap_read(wth, &rec, &buf, &err, &err_info, &data_offset)) {
+        count++;
+        bytes += rec.rec_header.packet_header.caplen;
+
+        frame_data_init(&fdata, count, &rec, data_offset, cum_bytes);
+        frame_data_set_before_dissect(&fdata, &elapsed_time, &ref, prev_dis);
+        if (ref == &fdata) {
+            ref_frame = fdata;
+            ref = &ref_frame;
+        }
+
+        epan_dissect_run(edt, wtap_file_type_subtype(wth), &rec,
+                         tvb_new_real_data(ws_buffer_start_ptr(&buf),
+                                           rec.rec_header.packet_header.caplen,
+                                           rec.rec_header.packet_header.len),
+                         &fdata, NULL);
+
+        frame_data_set_after_dissect(&fdata, &cum_bytes);
+        prev_dis_frame = fdata;
+        prev_dis = &prev_dis_frame;
+
+        epan_dissect_reset(edt);
+        frame_data_destroy(&fdata);
+        wtap_rec_reset(&rec);
+    }
+    stop = g_get_monotonic_time();
+
+    if (err != 0) {
+        cfile_read_failure_message(filename, err, err_info);
+    }
+
+    epan_dissect_free(edt);
+    epan_free(session);
+    ws_buffer_free(&buf);
+    wtap_rec_cleanup(&rec);
+    wtap_close(wth);
+
+    if (err != 0 || count == 0) {
+        return false;
+    }
+
+    result->name = type_name;
+    result->packets = count;
+    result->bytes = bytes;
+    result->elapsed_secs = (stop - start) / 1e6;
+    if (result->elapsed_secs > 0.0) {
+        result->packets_per_sec = count / result->elapsed_secs;
+        result->bytes_per_sec = bytes / result->elapsed_secs;
+    } else {
+        result->packets_per_sec = 0.0;
+        result->bytes_per_sec = 0.0;
+    }
+    return true;
+}
+
+static bool
+write_results(const char *filename, const bench_result_t *results, unsigned n_results)
+{
+    FILE *fp = stdout;
+    json_dumper dumper;
+
+    if (filename != NULL) {
+        fp = ws_fopen(filename, "w");
+        if (fp == NULL) {
+            cmdarg_err("Can't open %s for writing", filename);
+            return false;
+        }
+    }
+
+    memset(&dumper, 0, sizeof(dumper));
+    dumper.output_file = fp;
+    json_dumper_begin_object(&dumper);
+    json_dumper_set_member_name(&dumper, "benchmarks");
+    json_dumper_begin_array(&dumper);
+    for (unsigned i = 0; i < n_results; i++) {
+        json_dumper_begin_object(&dumper);
+        json_dumper_set_member_name(&dumper, "name");
+        json_dumper_value_string(&dumper, results[i].name);
+        json_dumper_set_member_name(&dumper, "packets");
+        json_dumper_value_anyf(&dumper, "%" PRIu64, results[i].packets);
+        json_dumper_set_member_name(&dumper, "bytes");
+        json_dumper_value_anyf(&dumper, "%" PRIu64, results[i].bytes);
+        json_dumper_set_member_name(&dumper, "elapsed_secs");
+        json_dumper_value_anyf(&dumper, "%.6f", results[i].elapsed_secs);
+        json_dumper_set_member_name(&dumper, "packets_per_sec");
+        json_dumper_value_anyf(&dumper, "%.1f", results[i].packets_per_sec);
+        json_dumper_set_member_name(&dumper, "bytes_per_sec");
+        json_dumper_value_anyf(&dumper, "%.1f", results[i].bytes_per_sec);
+        json_dumper_end_object(&dumper);
+    }
+    json_dumper_end_array(&dumper);
+    json_dumper_end_object(&dumper);
+    json_dumper_finish(&dumper);
+
+    if (fp != stdout) {
+        fclose(fp);
+    }
+    return true;
+}
+
+/* Compare against a stored baseline; returns the number of corpora whose
+ * packets/sec fell more than tolerance_percent below it. */
+static int
+compare_baseline(const char *filename, const bench_result_t *results,
+                 unsigned n_results, double tolerance_percent)
+{
+    char *base_buf;
+    jsmntok_t *tokens;
+    jsmntok_t *benchmarks;
+    int num_tokens;
+    int regressions = 0;
+
+    if (!g_file_get_contents(filename, &base_buf, NULL, NULL)) {
+        cmdarg_err("Can't read baseline file %s", filename);
+        return -1;
+    }
+
+    num_tokens = json_parse(base_buf, NULL, 0);
+    if (num_tokens <= 0) {
+        cmdarg_err("Baseline file %s isn't valid JSON", filename);
+        g_free(base_buf);
+        return -1;
+    }
+    tokens = g_new0(jsmntok_t, num_tokens);
+    json_parse(base_buf, tokens, num_tokens);
+
+    benchmarks = json_get_array(base_buf, tokens, "benchmarks");
+    if (benchmarks == NULL) {
+        cmdarg_err("Baseline file %s has no \"benchmarks\" array", filename);
+        g_free(tokens);
+        g_free(base_buf);
+        return -1;
+    }
+
+    for (unsigned i = 0; i < n_results; i++) {
+        double base_pps = 0.0;
+        bool found = false;
+
+        for (int j = 0; j < json_get_array_len(benchmarks); j++) {
+            jsmntok_t *entry = json_get_array_index(benchmarks, j);
+            char *name = json_get_string(base_buf, entry, "name");
+
+            if (name != NULL && strcmp(name, results[i].name) == 0 &&
+                json_get_double(base_buf, entry, "packets_per_sec", &base_pps)) {
+                found = true;
+                break;
+            }
+        }
+
+        if (!found) {
+            fprintf(stderr, "bench_epan: %s: no baseline entry, skipping comparison\n",
+                    results[i].name);
+            continue;
+        }
+
+        if (results[i].packets_per_sec < base_pps * (1.0 - tolerance_percent / 100.0)) {
+            fprintf(stderr, "bench_epan: %s: REGRESSION: %.1f packets/s vs baseline %.1f (more than %.1f%% slower)\n",
+                    results[i].name, results[i].packets_per_sec, base_pps,
+                    tolerance_percent);
+            regressions++;
+        } else {
+            fprintf(stderr, "bench_epan: %s: ok: %.1f packets/s vs baseline %.1f\n",
+                    results[i].name, results[i].packets_per_sec, base_pps);
+        }
+    }
+
+    g_free(tokens);
+    g_free(base_buf);
+    return regressions;
+}
+
+int
+main(int argc, char *argv[])
+{
+    char *configuration_init_error;
+    static const struct report_message_routines bench_epan_report_routines = {
+        failure_message,
+        failure_message,
+        open_failure_message,
+        read_failure_message,
+        write_failure_message,
+        cfile_open_failure_message,
+        cfile_dump_open_failure_message,
+        cfile_read_failure_message,
+        cfile_write_failure_message,
+        cfile_close_failure_message
+    };
+    int opt;
+    char *types = NULL;
+    int count = DEFAULT_COUNT;
+    int max_bytes = DEFAULT_MAX_BYTES;
+    uint32_t seed = DEFAULT_SEED;
+    bool build_tree = false;
+    char *output_filename = NULL;
+    char *baseline_filename = NULL;
+    double tolerance_percent = DEFAULT_TOLERANCE;
+    char **type_list = NULL;
+    bench_result_t *results = NULL;
+    unsigned n_results = 0;
+    int regressions;
+    int ret = EXIT_SUCCESS;
+    static const struct ws_option long_options[] = {
+        {"help", ws_no_argument, NULL, 'h'},
+        {"version", ws_no_argument, NULL, 'v'},
+        {0, 0, 0, 0 }
+    };
+
+    cmdarg_err_init(bench_epan_cmdarg_err, bench_epan_cmdarg_err_cont);
+
+    /* Initialize log handler early so we can have proper logging during startup. */
+    ws_log_init("bench_epan", vcmdarg_err);
+
+    /* Early logging command-line initialization. */
+    ws_log_parse_args(&argc, argv, vcmdarg_err, WS_EXIT_INVALID_OPTION);
+
+    /*
+     * Get credential information for later use.
+     */
+    init_process_policies();
+
+    /*
+     * Attempt to get the pathname of the directory containing the
+     * executable file.
+     */
+    configuration_init_error = configuration_init(argv[0], NULL);
+    if (configuration_init_error != NULL) {
+        fprintf(stderr,
+            "bench_epan: Can't get pathname of directory containing the bench_epan program: %s.\n",
+            configuration_init_error);
+        g_free(configuration_init_error);
+    }
+
+    init_report_message("bench_epan", &bench_epan_report_routines);
+
+    timestamp_set_type(TS_RELATIVE);
+    timestamp_set_precision(TS_PREC_AUTO);
+    timestamp_set_seconds_type(TS_SECONDS_DEFAULT);
+
+    wtap_init(false);
+
+    if (!epan_init(NULL, NULL, true)) {
+        ret = WS_EXIT_INIT_FAILED;
+        goto clean_exit;
+    }
+
+    ws_init_version_info("Bench_epan", epan_gather_compile_info,
+                         epan_gather_runtime_info);
+
+    while ((opt = ws_getopt_long(argc, argv, "b:B:c:ho:p:s:t:Tv", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'b':
+                max_bytes = get_positive_int(ws_optarg, "max bytes");
+                if (max_bytes > 65536) {
+                    cmdarg_err("max bytes is > 65536");
+                    ret = WS_EXIT_INVALID_OPTION;
+                    goto clean_exit;
+                }
+                break;
+
+            case 'B':
+                baseline_filename = ws_optarg;
+                break;
+
+            case 'c':
+                count = get_positive_int(ws_optarg, "count");
+                break;
+
+            case 'o':
+                output_filename = ws_optarg;
+                break;
+
+            case 'p':
+                tolerance_percent = get_positive_int(ws_optarg, "tolerance");
+                break;
+
+            case 's':
+                seed = get_nonzero_uint32(ws_optarg, "seed");
+                break;
+
+            case 't':
+                types = ws_optarg;
+                break;
+
+            case 'T':
+                build_tree = true;
+                break;
+
+            case 'h':
+                show_help_header(NULL);
+                usage(false);
+                goto clean_exit;
+                break;
+
+            case 'v':
+                show_version();
+                goto clean_exit;
+                break;
+
+            default:
+                usage(true);
+                ret = WS_EXIT_INVALID_OPTION;
+                goto clean_exit;
+                break;
+        }
+    }
+
+    if (argc != ws_optind) {
+        cmdarg_err("Unexpected argument \"%s\"", argv[ws_optind]);
+        ret = WS_EXIT_INVALID_OPTION;
+        goto clean_exit;
+    }
+
+    /* Load libwireshark settings from the current profile, so dissection
+     * here matches dissection in the real programs. */
+    epan_load_settings();
+    prefs_apply_all();
+
+    type_list = g_strsplit(types ? types : DEFAULT_CORPORA, ",", -1);
+    results = g_new0(bench_result_t, g_strv_length(type_list));
+
+    for (unsigned i = 0; type_list[i] != NULL; i++) {
+        char *corpus_filename;
+
+        if (type_list[i][0] == '\0') {
+            continue;
+        }
+
+        corpus_filename = generate_corpus(type_list[i], count, max_bytes, seed);
+        if (corpus_filename == NULL) {
+            ret = EXIT_FAILURE;
+            goto clean_exit;
+        }
+
+        if (bench_corpus(corpus_filename, type_list[i], build_tree,
+                         &results[n_results])) {
+            n_results++;
+        } else {
+            ret = EXIT_FAILURE;
+        }
+
+        ws_unlink(corpus_filename);
+        g_free(corpus_filename);
+    }
+
+    if (!write_results(output_filename, results, n_results)) {
+        ret = EXIT_FAILURE;
+        goto clean_exit;
+    }
+
+    if (baseline_filename != NULL) {
+        regressions = compare_baseline(baseline_filename, results, n_results,
+                                       tolerance_percent);
+        if (regressions != 0) {
+            ret = EXIT_FAILURE;
+        }
+    }
+
+clean_exit:
+    g_free(results);
+    g_strfreev(type_list);
+    epan_cleanup();
+    wtap_cleanup();
+    return ret;
+}
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 4
+ * tab-width: 8
+ * indent-tabs-mode: nil
+ * End:
+ *
+ * vi: set shiftwidth=4 tabstop=8 expandtab:
+ * :indentSize=4:tabSize=8:noTabs=true:
+ */
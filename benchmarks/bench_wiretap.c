@@ -0,0 +1,379 @@
+/* bench_wiretap.c
+ * Wiretap read-path micro-benchmark
+ *
+ * Measures open latency, sequential read throughput and random
+ * seek_read throughput through the wtap API for each capture file in a
+ * corpus, and reports the numbers as JSON. Running the same corpus
+ * saved as uncompressed, gzip and zstd pcapng answers "how should we
+ * archive" with data, and gives wiretap I/O changes (file_wrappers.c
+ * buffer sizes and the like) a standard harness.
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <config.h>
+#define WS_LOG_DOMAIN  LOG_DOMAIN_MAIN
+
+#include <glib.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ws_exit_codes.h>
+#include <wsutil/clopts_common.h>
+#include <wsutil/cmdarg_err.h>
+#include <wsutil/file_util.h>
+#include <wsutil/filesystem.h>
+#include <wsutil/json_dumper.h>
+#include <wsutil/privileges.h>
+#include <wsutil/report_message.h>
+#include <wsutil/version_info.h>
+#include <wsutil/ws_getopt.h>
+#include <wsutil/wslog.h>
+
+#include <wiretap/wtap.h>
+
+#include <ui/failure_message.h>
+#include <cli_main.h>
+
+#define DEFAULT_SEEK_READS 1000
+#define DEFAULT_SEED 42
+
+typedef struct {
+    const char *filename;
+    const char *file_type;
+    const char *compression;
+    double      open_usecs;
+    uint64_t    packets;
+    uint64_t    bytes;
+    double      sequential_secs;
+    uint64_t    seek_reads;
+    double      seek_secs;
+} bench_file_result_t;
+
+/*
+ * Report an error in command-line arguments.
+ */
+static void
+bench_wiretap_cmdarg_err(const char *msg_format, va_list ap)
+{
+    fprintf(stderr, "bench_wiretap: ");
+    vfprintf(stderr, msg_format, ap);
+    fprintf(stderr, "\n");
+}
+
+/*
+ * Report additional information for an error in command-line arguments.
+ */
+static void
+bench_wiretap_cmdarg_err_cont(const char *msg_format, va_list ap)
+{
+    vfprintf(stderr, msg_format, ap);
+    fprintf(stderr, "\n");
+}
+
+static void
+usage(bool is_error)
+{
+    FILE *output = is_error ? stderr : stdout;
+
+    fprintf(output, "Usage: bench_wiretap [options] <infile> ...\n");
+    fprintf(output, "\n");
+    fprintf(output, "Options:\n");
+    fprintf(output, "  -n <count>        random seek_read operations per file (default: %d)\n", DEFAULT_SEEK_READS);
+    fprintf(output, "  -s <seed>         PRNG seed for choosing seek targets (default: %d)\n", DEFAULT_SEED);
+    fprintf(output, "  -o <file>         write JSON results to a file (default: standard output)\n");
+    fprintf(output, "  -h, --help        display this help and exit.\n");
+    fprintf(output, "  -v, --version     print version information and exit.\n");
+}
+
+static bool
+bench_file(const char *filename, int seek_reads, uint32_t seed,
+           bench_file_result_t *result)
+{
+    wtap *wth;
+    wtap_rec rec;
+    Buffer buf;
+    GArray *offsets;
+    GRand *rand;
+    const char *compression;
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    int64_t data_offset;
+    int64_t start, stop;
+    int err = 0;
+    char *err_info = NULL;
+    bool ok = true;
+
+    start = g_get_monotonic_time();
+    wth = wtap_open_offline(filename, WTAP_TYPE_AUTO, &err, &err_info, true);
+    stop = g_get_monotonic_time();
+    if (wth == NULL) {
+        cfile_open_failure_message(filename, err, err_info);
+        return false;
+    }
+
+    result->filename = filename;
+    result->file_type = wtap_file_type_subtype_name(wtap_file_type_subtype(wth));
+    compression = wtap_compression_type_description(wtap_get_compression_type(wth));
+    result->compression = compression ? compression : "none";
+    result->open_usecs = (double)(stop - start);
+
+    /* Sequential pass; remember each record's offset for the seek pass. */
+    wtap_rec_init(&rec);
+    ws_buffer_init(&buf, 1514);
+    offsets = g_array_new(false, false, sizeof(int64_t));
+
+    start = g_get_monotonic_time();
+    while (wtap_read(wth, &rec, &buf, &err, &err_info, &data_offset)) {
+        packets++;
+        bytes += rec.rec_header.packet_header.caplen;
+        g_array_append_val(offsets, data_offset);
+        wtap_rec_reset(&rec);
+    }
+    stop = g_get_monotonic_time();
+
+    if (err != 0) {
+        cfile_read_failure_message(filename, err, err_info);
+        ok = false;
+        goto done;
+    }
+    if (packets == 0) {
+        cmdarg_err("%s has no records, nothing to measure", filename);
+        ok = false;
+        goto done;
+    }
+
+    result->packets = packets;
+    result->bytes = bytes;
+    result->sequential_secs = (stop - start) / 1e6;
+
+    /* Random access pass, same sequence of targets for a given seed. */
+    rand = g_rand_new_with_seed(seed);
+    start = g_get_monotonic_time();
+    for (int i = 0; i < seek_reads; i++) {
+        int64_t seek_off = g_array_index(offsets, int64_t,
+            g_rand_int_range(rand, 0, (int32_t)offsets->len));
+
+        if (!wtap_seek_read(wth, seek_off, &rec, &buf, &err, &err_info)) {
+            cfile_read_failure_message(filename, err, err_info);
+            ok = false;
+            break;
+        }
+        wtap_rec_reset(&rec);
+    }
+    stop = g_get_monotonic_time();
+    g_rand_free(rand);
+
+    result->seek_reads = seek_reads;
+    result->seek_secs = (stop - start) / 1e6;
+
+done:
+    g_array_free(offsets, true);
+    ws_buffer_free(&buf);
+    wtap_rec_cleanup(&rec);
+    wtap_close(wth);
+    return ok;
+}
+
+static bool
+write_results(const char *filename, const bench_file_result_t *results,
+              unsigned n_results)
+{
+    FILE *fp = stdout;
+    json_dumper dumper;
+
+    if (filename != NULL) {
+        fp = ws_fopen(filename, "w");
+        if (fp == NULL) {
+            cmdarg_err("Can't open %s for writing", filename);
+            return false;
+        }
+    }
+
+    memset(&dumper, 0, sizeof(dumper));
+    dumper.output_file = fp;
+    json_dumper_begin_object(&dumper);
+    json_dumper_set_member_name(&dumper, "files");
+    json_dumper_begin_array(&dumper);
+    for (unsigned i = 0; i < n_results; i++) {
+        const bench_file_result_t *r = &results[i];
+
+        json_dumper_begin_object(&dumper);
+        json_dumper_set_member_name(&dumper, "filename");
+        json_dumper_value_string(&dumper, r->filename);
+        json_dumper_set_member_name(&dumper, "file_type");
+        json_dumper_value_string(&dumper, r->file_type);
+        json_dumper_set_member_name(&dumper, "compression");
+        json_dumper_value_string(&dumper, r->compression);
+        json_dumper_set_member_name(&dumper, "open_usecs");
+        json_dumper_value_anyf(&dumper, "%.1f", r->open_usecs);
+        json_dumper_set_member_name(&dumper, "packets");
+        json_dumper_value_anyf(&dumper, "%" PRIu64, r->packets);
+        json_dumper_set_member_name(&dumper, "bytes");
+        json_dumper_value_anyf(&dumper, "%" PRIu64, r->bytes);
+        json_dumper_set_member_name(&dumper, "sequential_secs");
+        json_dumper_value_anyf(&dumper, "%.6f", r->sequential_secs);
+        json_dumper_set_member_name(&dumper, "sequential_packets_per_sec");
+        json_dumper_value_anyf(&dumper, "%.1f",
+            r->sequential_secs > 0.0 ? r->packets / r->sequential_secs : 0.0);
+        json_dumper_set_member_name(&dumper, "sequential_bytes_per_sec");
+        json_dumper_value_anyf(&dumper, "%.1f",
+            r->sequential_secs > 0.0 ? r->bytes / r->sequential_secs : 0.0);
+        json_dumper_set_member_name(&dumper, "seek_reads");
+        json_dumper_value_anyf(&dumper, "%" PRIu64, r->seek_reads);
+        json_dumper_set_member_name(&dumper, "seek_secs");
+        json_dumper_value_anyf(&dumper, "%.6f", r->seek_secs);
+        json_dumper_set_member_name(&dumper, "seek_reads_per_sec");
+        json_dumper_value_anyf(&dumper, "%.1f",
+            r->seek_secs > 0.0 ? r->seek_reads / r->seek_secs : 0.0);
+        json_dumper_end_object(&dumper);
+    }
+    json_dumper_end_array(&dumper);
+    json_dumper_end_object(&dumper);
+    json_dumper_finish(&dumper);
+
+    if (fp != stdout) {
+        fclose(fp);
+    }
+    return true;
+}
+
+int
+main(int argc, char *argv[])
+{
+    char *configuration_init_error;
+    static const struct report_message_routines bench_wiretap_report_routines = {
+        failure_message,
+        failure_message,
+        open_failure_message,
+        read_failure_message,
+        write_failure_message,
+        cfile_open_failure_message,
+        cfile_dump_open_failure_message,
+        cfile_read_failure_message,
+        cfile_write_failure_message,
+        cfile_close_failure_message
+    };
+    int opt;
+    int seek_reads = DEFAULT_SEEK_READS;
+    uint32_t seed = DEFAULT_SEED;
+    char *output_filename = NULL;
+    bench_file_result_t *results;
+    unsigned n_results = 0;
+    int ret = EXIT_SUCCESS;
+    static const struct ws_option long_options[] = {
+        {"help", ws_no_argument, NULL, 'h'},
+        {"version", ws_no_argument, NULL, 'v'},
+        {0, 0, 0, 0 }
+    };
+
+    cmdarg_err_init(bench_wiretap_cmdarg_err, bench_wiretap_cmdarg_err_cont);
+
+    /* Initialize log handler early so we can have proper logging during startup. */
+    ws_log_init("bench_wiretap", vcmdarg_err);
+
+    /* Early logging command-line initialization. */
+    ws_log_parse_args(&argc, argv, vcmdarg_err, WS_EXIT_INVALID_OPTION);
+
+    /*
+     * Get credential information for later use.
+     */
+    init_process_policies();
+
+    /*
+     * Attempt to get the pathname of the directory containing the
+     * executable file.
+     */
+    configuration_init_error = configuration_init(argv[0], NULL);
+    if (configuration_init_error != NULL) {
+        fprintf(stderr,
+            "bench_wiretap: Can't get pathname of directory containing the bench_wiretap program: %s.\n",
+            configuration_init_error);
+        g_free(configuration_init_error);
+    }
+
+    init_report_message("bench_wiretap", &bench_wiretap_report_routines);
+
+    wtap_init(false);
+
+    ws_init_version_info("Bench_wiretap", NULL, NULL);
+
+    while ((opt = ws_getopt_long(argc, argv, "hn:o:s:v", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'n':
+                seek_reads = get_positive_int(ws_optarg, "seek_read count");
+                break;
+
+            case 'o':
+                output_filename = ws_optarg;
+                break;
+
+            case 's':
+                seed = get_nonzero_uint32(ws_optarg, "seed");
+                break;
+
+            case 'h':
+                show_help_header(NULL);
+                usage(false);
+                goto clean_exit;
+                break;
+
+            case 'v':
+                show_version();
+                goto clean_exit;
+                break;
+
+            default:
+                usage(true);
+                ret = WS_EXIT_INVALID_OPTION;
+                goto clean_exit;
+                break;
+        }
+    }
+
+    if (argc <= ws_optind) {
+        cmdarg_err("No capture files specified");
+        usage(true);
+        ret = WS_EXIT_INVALID_OPTION;
+        goto clean_exit;
+    }
+
+    results = g_new0(bench_file_result_t, argc - ws_optind);
+
+    for (int i = ws_optind; i < argc; i++) {
+        if (bench_file(argv[i], seek_reads, seed, &results[n_results])) {
+            n_results++;
+        } else {
+            ret = EXIT_FAILURE;
+        }
+    }
+
+    if (!write_results(output_filename, results, n_results)) {
+        ret = EXIT_FAILURE;
+    }
+
+    g_free(results);
+
+clean_exit:
+    wtap_cleanup();
+    return ret;
+}
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 4
+ * tab-width: 8
+ * indent-tabs-mode: nil
+ * End:
+ *
+ * vi: set shiftwidth=4 tabstop=8 expandtab:
+ * :indentSize=4:tabSize=8:noTabs=true:
+ */
@@ -63,6 +63,7 @@
 #include <cli_main.h>
 #include <wsutil/version_info.h>
 #include <wiretap/wtap_opttypes.h>
+#include <wiretap/pcapng.h>
 
 #ifdef HAVE_PLUGINS
 #include <wsutil/plugins.h>
@@ -1102,6 +1103,7 @@ process_cap_file(const char *filename, bool need_separator)
     nstime_t              prev_time;
     bool                  know_order = false;
     order_t               order = IN_ORDER;
+    bool                  used_tail_stats = false;
     unsigned int                 i;
     wtapng_iface_descriptions_t *idb_info;
 
@@ -1157,10 +1159,67 @@ process_cap_file(const char *filename, bool need_separator)
     wtap_set_cb_new_ipv6(cf_info.wth, count_ipv6_address);
     wtap_set_cb_new_secrets(cf_info.wth, count_decryption_secret);
 
+    /* If everything we've been asked to report can be derived from the
+     * interface statistics blocks dumpcap leaves at the end of each file
+     * it writes, pick those up instead of scanning every record. */
+    if (!(cap_data_size || cap_data_rate_byte || cap_data_rate_bit ||
+          cap_packet_size || cap_order || pkt_comments || cap_snaplen ||
+          cap_file_idb || cap_file_nrb || cap_file_dsb ||
+          (cap_file_encap && wtap_file_encap(cf_info.wth) == WTAP_ENCAP_PER_PACKET))) {
+        GArray *tail_stats = g_array_new(false, true, sizeof(pcapng_if_stats_t));
+
+        err = 0;
+        err_info = NULL;
+        if (pcapng_read_trailing_statistics(cf_info.wth, tail_stats, &err, &err_info)) {
+            if (tail_stats->len > 0) {
+                uint64_t total_delivered = 0;
+                bool complete = true;
+
+                for (i = 0; i < tail_stats->len; i++) {
+                    const pcapng_if_stats_t *st = &g_array_index(tail_stats, pcapng_if_stats_t, i);
+
+                    if (st->packets_delivered == UINT64_MAX ||
+                        !st->has_start_time || !st->has_end_time) {
+                        complete = false;
+                        break;
+                    }
+                    total_delivered += st->packets_delivered;
+                    if (i == 0) {
+                        earliest_packet_time = st->start_time;
+                        latest_packet_time = st->end_time;
+                    } else {
+                        if (nstime_cmp(&st->start_time, &earliest_packet_time) < 0)
+                            earliest_packet_time = st->start_time;
+                        if (nstime_cmp(&st->end_time, &latest_packet_time) > 0)
+                            latest_packet_time = st->end_time;
+                    }
+                }
+                if (complete && total_delivered <= UINT32_MAX) {
+                    packet = (uint32_t)total_delivered;
+                    earliest_packet_time_tsprec = wtap_file_tsprec(cf_info.wth);
+                    latest_packet_time_tsprec = earliest_packet_time_tsprec;
+                    used_tail_stats = true;
+                }
+            }
+        } else {
+            /* Don't fail over a cheap probe; just do the full scan. */
+            g_free(err_info);
+            err_info = NULL;
+        }
+        err = 0;
+        g_array_free(tail_stats, true);
+    }
+
+    /* All of the statistics we tally come from the record metadata;
+     * we never look at the packet data, so the file format may skip
+     * over it where it can. */
+    wtap_set_read_metadata_only(cf_info.wth, true);
+
     /* Tally up data that we need to parse through the file to find */
     wtap_rec_init(&rec);
     ws_buffer_init(&buf, 1514);
-    while (wtap_read(cf_info.wth, &rec, &buf, &err, &err_info, &data_offset))  {
+    while (!used_tail_stats &&
+           wtap_read(cf_info.wth, &rec, &buf, &err, &err_info, &data_offset))  {
         if (rec.presence_flags & WTAP_HAS_TS) {
             prev_time = cur_time;
             cur_time = rec.ts;
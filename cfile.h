@@ -92,7 +92,10 @@ typedef struct _capture_file {
     dfilter_t                  *rfcode;               /* Compiled read filter program */
     dfilter_t                  *dfcode;               /* Compiled display filter program */
     char                       *dfilter;              /* Display filter string */
+    GHashTable                 *dfilter_verdicts;     /* Filter text -> cached per-frame match bits */
+    GQueue                     *records_cache;        /* MRU-first cache of recently read records, for compressed files */
     bool                        redissecting;         /* true if currently redissecting (cf_redissect_packets) */
+    uint32_t                    dissection_generation; /* Bumped on each redissection; frames carry the generation they were dissected under in frame_data.dissect_gen */
     bool                        read_lock;            /* true if currently processing a file (cf_read) */
     rescan_type                 redissection_queued;  /* Queued redissection type. */
     /* search */
@@ -122,6 +125,12 @@ typedef struct _capture_file {
     field_info                 *finfo_selected;       /* Field info */
     wtap_rec                    rec;                  /* Record header */
     Buffer                      buf;                  /* Record data */
+    /* Speculative dissection of the frame the user is likely to select
+       next (see cf_select_packet) */
+    frame_data                 *prefetch_frame;       /* Frame the cached dissection is for */
+    epan_dissect_t             *prefetch_edt;         /* Cached dissection, or NULL */
+    wtap_rec                    prefetch_rec;         /* Its record header */
+    Buffer                      prefetch_buf;         /* Its record data */
 
     void *                      window;               /* Top-level window associated with file */
     unsigned long               computed_elapsed;     /* Elapsed time to load the file (in msec). */
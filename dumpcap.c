@@ -408,6 +408,21 @@ static bool need_timeout_workaround;
 
 #define WRITER_THREAD_TIMEOUT 100000 /* usecs */
 
+/*
+ * If this many packets accumulate before the update interval expires,
+ * report the count to our parent right away rather than waiting for the
+ * interval.  This bounds how many records the parent has to process per
+ * delivery, so a burst on a fast link turns into several medium-sized
+ * batches instead of one huge one that stalls the UI's event loop.
+ */
+#define SYNC_PIPE_COUNT_BATCH_MAX 20000
+
+/*
+ * How often, in seconds, to sample the per-stage drop counters into the
+ * pcapng output as interface statistics blocks.
+ */
+#define STAGE_STATS_INTERVAL 5.0
+
 static void
 dumpcap_log_writer(const char *domain, enum ws_log_level level,
                                    const char *file, long line, const char *func,
@@ -422,6 +437,7 @@ static bool quiet;
 static bool really_quiet;
 static bool use_threads;
 static uint64_t start_time;
+static uint64_t file_start_time;    /* when the current output file was started */
 
 static void capture_loop_write_packet_cb(uint8_t *pcap_src_p, const struct pcap_pkthdr *phdr,
                                          const uint8_t *pd);
@@ -3581,45 +3597,124 @@ capture_loop_init_output(capture_options *capture_opts, loop_data *ld, char *err
     return true;
 }
 
-static bool
-capture_loop_close_output(capture_options *capture_opts, loop_data *ld, int *err_close)
+/* Write an ISB for each capture device into the current pcapng output file.
+ *
+ * We do this for every file we close, including each ring buffer file at
+ * rotation, so that the trailing statistics give the file's time bounds,
+ * and, when there's a single interface so the count is unambiguous, the
+ * number of packets written to the file as isb_usrdeliv.  Tools such as
+ * capinfos can pick those up without scanning all the packets in the file.
+ */
+static void
+capture_loop_write_interface_statistics(loop_data *ld, int *err)
 {
+    unsigned int i;
+    capture_src *pcap_src;
+    uint64_t     end_time = create_timestamp();
+    uint64_t     isb_usrdeliv;
+
+    /* We only count packets written per file, not per interface. */
+    isb_usrdeliv = (ld->pcaps->len == 1) ?
+                       (uint64_t)ld->packets_written : UINT64_MAX;
 
+    for (i = 0; i < ld->pcaps->len; i++) {
+        pcap_src = g_array_index(ld->pcaps, capture_src *, i);
+        if (!pcap_src->from_cap_pipe) {
+            uint64_t isb_ifrecv, isb_ifdrop;
+            struct pcap_stat stats;
+
+            if (pcap_stats(pcap_src->pcap_h, &stats) >= 0) {
+                isb_ifrecv = pcap_src->received;
+                isb_ifdrop = stats.ps_drop + pcap_src->dropped + pcap_src->flushed;
+            } else {
+                isb_ifrecv = UINT64_MAX;
+                isb_ifdrop = UINT64_MAX;
+            }
+            pcapng_write_interface_statistics_block(ld->pdh,
+                                                    i,
+                                                    &ld->bytes_written,
+                                                    "Counters provided by dumpcap",
+                                                    file_start_time,
+                                                    end_time,
+                                                    isb_ifrecv,
+                                                    isb_ifdrop,
+                                                    isb_usrdeliv,
+                                                    err);
+        }
+    }
+}
+
+/* Write an ISB for each capture device with a comment breaking the drop
+ * totals down by stage: kernel buffer drops, drops within dumpcap (packet
+ * queue overflow in threaded mode, write problems), Npcap flushes, the
+ * current depth of the packet queue, and the number of packets written
+ * but not yet reported over the sync pipe.  Sampled periodically during
+ * a capture, these turn "we dropped packets" into "which stage was the
+ * bottleneck and when".
+ */
+static bool
+capture_loop_write_stage_statistics(loop_data *ld, int *err)
+{
     unsigned int i;
     capture_src *pcap_src;
     uint64_t     end_time = create_timestamp();
+    char         comment[512];
+
+    for (i = 0; i < ld->pcaps->len; i++) {
+        pcap_src = g_array_index(ld->pcaps, capture_src *, i);
+        if (!pcap_src->from_cap_pipe) {
+            uint64_t isb_ifrecv = UINT64_MAX, isb_ifdrop = UINT64_MAX;
+            uint32_t kernel_drop = 0, kernel_ifdrop = 0;
+            struct pcap_stat stats;
+
+            if (pcap_stats(pcap_src->pcap_h, &stats) >= 0) {
+                kernel_drop = stats.ps_drop;
+                kernel_ifdrop = stats.ps_ifdrop;
+                isb_ifrecv = pcap_src->received;
+                isb_ifdrop = stats.ps_drop + pcap_src->dropped + pcap_src->flushed;
+            }
+            snprintf(comment, sizeof comment,
+                     "dumpcap stage counters: received=%u kernel_drop=%u"
+                     " kernel_ifdrop=%u dumpcap_drop=%u flushed=%u"
+                     " queue_packets=%" PRId64 " queue_bytes=%" PRId64
+                     " sync_pipe_backlog=%u",
+                     pcap_src->received, kernel_drop, kernel_ifdrop,
+                     pcap_src->dropped, pcap_src->flushed,
+                     pcap_queue_packets, pcap_queue_bytes,
+                     ld->inpkts_to_sync_pipe);
+            if (!pcapng_write_interface_statistics_block(ld->pdh,
+                                                         i,
+                                                         &ld->bytes_written,
+                                                         comment,
+                                                         file_start_time,
+                                                         end_time,
+                                                         isb_ifrecv,
+                                                         isb_ifdrop,
+                                                         UINT64_MAX,
+                                                         err)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool
+capture_loop_close_output(capture_options *capture_opts, loop_data *ld, int *err_close)
+{
+
     bool success;
 
     ws_debug("capture_loop_close_output");
 
     if (capture_opts->multi_files_on) {
+        if (capture_opts->use_pcapng && ld->pdh != NULL) {
+            capture_loop_write_interface_statistics(ld, err_close);
+        }
         return ringbuf_libpcap_dump_close(&capture_opts->save_file, err_close);
     } else {
         if (capture_opts->use_pcapng) {
-            for (i = 0; i < global_ld.pcaps->len; i++) {
-                pcap_src = g_array_index(global_ld.pcaps, capture_src *, i);
-                if (!pcap_src->from_cap_pipe) {
-                    uint64_t isb_ifrecv, isb_ifdrop;
-                    struct pcap_stat stats;
-
-                    if (pcap_stats(pcap_src->pcap_h, &stats) >= 0) {
-                        isb_ifrecv = pcap_src->received;
-                        isb_ifdrop = stats.ps_drop + pcap_src->dropped + pcap_src->flushed;
-                   } else {
-                        isb_ifrecv = UINT64_MAX;
-                        isb_ifdrop = UINT64_MAX;
-                    }
-                    pcapng_write_interface_statistics_block(ld->pdh,
-                                                            i,
-                                                            &ld->bytes_written,
-                                                            "Counters provided by dumpcap",
-                                                            start_time,
-                                                            end_time,
-                                                            isb_ifrecv,
-                                                            isb_ifdrop,
-                                                            err_close);
-                }
-            }
+            capture_loop_write_interface_statistics(ld, err_close);
         }
         if (fclose(ld->pdh) == EOF) {
             if (err_close != NULL) {
@@ -3720,15 +3815,18 @@ capture_loop_dispatch(loop_data *ld,
                  * "select()" says we can read from it without blocking; go for
                  * it.
                  *
-                 * We don't have pcap_breakloop(), so we only process one packet
-                 * per pcap_dispatch() call, to allow a signal to stop the
-                 * processing immediately, rather than processing all packets
-                 * in a batch before quitting.
+                 * Process the whole batch of packets that's ready rather
+                 * than one packet per call; at high packet rates the
+                 * select()/pcap_dispatch() round trip per packet costs more
+                 * than the packet itself.  capture_loop_stop() uses
+                 * pcap_breakloop(), which makes pcap_dispatch() return
+                 * in mid-batch, so a signal can still stop the processing
+                 * immediately.
                  */
                 if (use_threads) {
-                    inpkts = pcap_dispatch(pcap_src->pcap_h, 1, capture_loop_queue_packet_cb, (uint8_t *)pcap_src);
+                    inpkts = pcap_dispatch(pcap_src->pcap_h, -1, capture_loop_queue_packet_cb, (uint8_t *)pcap_src);
                 } else {
-                    inpkts = pcap_dispatch(pcap_src->pcap_h, 1, capture_loop_write_packet_cb, (uint8_t *)pcap_src);
+                    inpkts = pcap_dispatch(pcap_src->pcap_h, -1, capture_loop_write_packet_cb, (uint8_t *)pcap_src);
                 }
                 if (inpkts < 0) {
                     if (inpkts == -1) {
@@ -3899,11 +3997,19 @@ capture_loop_open_output(capture_options *capture_opts, int *save_file_fd,
         else {
             if (capture_opts->multi_files_on) {
                 /* ringbuffer is enabled */
+                /* If we're switching files based on size, we know how
+                   large each ring file will get; preallocate its blocks
+                   when we open it so rotation doesn't stall on file
+                   system metadata updates.  (The size limit is checked
+                   against bytes_written / 1000, so the limit is in
+                   units of 1000 bytes.) */
                 *save_file_fd = ringbuf_init(capfile_name,
                                              (capture_opts->has_ring_num_files) ? capture_opts->ring_num_files : 0,
                                              capture_opts->group_read_access,
                                              capture_opts->compress_type,
-                                             capture_opts->has_nametimenum);
+                                             capture_opts->has_nametimenum,
+                                             capture_opts->has_autostop_filesize ?
+                                                 (uint64_t)capture_opts->autostop_filesize * 1000 : 0);
 
                 /* capfile_name is unused as the ringbuffer provides its own filename. */
                 if (*save_file_fd != -1) {
@@ -4062,6 +4168,12 @@ do_file_switch_or_stop(capture_options *capture_opts)
             return false;
         }
 
+        /* Finish off the file we're leaving with per-interface statistics,
+           so its time bounds and counts can be read without scanning it. */
+        if (capture_opts->use_pcapng && global_ld.pdh != NULL) {
+            capture_loop_write_interface_statistics(&global_ld, &global_ld.err);
+        }
+
         /* Switch to the next ringbuffer file */
         if (ringbuf_switch_file(&global_ld.pdh, &capture_opts->save_file,
                                 &global_ld.save_file_fd, &global_ld.err)) {
@@ -4069,6 +4181,7 @@ do_file_switch_or_stop(capture_options *capture_opts)
             /* File switch succeeded: reset the conditions */
             global_ld.bytes_written = 0;
             global_ld.packets_written = 0;
+            file_start_time = create_timestamp();
             if (capture_opts->use_pcapng) {
                 successful = capture_loop_init_pcapng_output(capture_opts, &global_ld, &global_ld.err);
             } else {
@@ -4215,6 +4328,7 @@ capture_loop_start(capture_options *capture_opts, bool *stats_known, struct pcap
     int               err_close;
     int               inpkts;
     GTimer           *autostop_duration_timer = NULL;
+    GTimer           *stage_stats_timer = NULL;
     bool              write_ok;
     bool              close_ok;
     bool              cfilter_error         = false;
@@ -4328,6 +4442,9 @@ capture_loop_start(capture_options *capture_opts, bool *stats_known, struct pcap
     if (capture_opts->has_autostop_duration) {
         autostop_duration_timer = g_timer_new();
     }
+    if (capture_opts->use_pcapng) {
+        stage_stats_timer = g_timer_new();
+    }
 
     if (capture_opts->multi_files_on) {
         if (capture_opts->has_file_duration) {
@@ -4342,6 +4459,7 @@ capture_loop_start(capture_options *capture_opts, bool *stats_known, struct pcap
     gettimeofday(&upd_time, NULL);
 #endif
     start_time = create_timestamp();
+    file_start_time = start_time;
     ws_info("Capture loop running.");
     capture_opts_log(LOG_DOMAIN_CAPCHILD, LOG_LEVEL_DEBUG, capture_opts);
 
@@ -4411,16 +4529,19 @@ capture_loop_start(capture_options *capture_opts, bool *stats_known, struct pcap
         /* Only update after an interval so as not to overload slow displays.
          * This also prevents too much context-switching between the dumpcap
          * and wireshark processes.
-         * XXX: Should we send updates sooner if there have been lots of
-         * packets we haven't notified the parent about, such as on fast links?
+         * On fast links we don't wait for the full interval once a lot of
+         * packets have piled up, so the parent gets several bounded batches
+         * instead of one outsized one.
          */
 #ifdef _WIN32
         cur_time = GetTickCount64();
-        if ((cur_time - upd_time) > capture_opts->update_interval)
+        if ((cur_time - upd_time) > capture_opts->update_interval ||
+            global_ld.inpkts_to_sync_pipe >= SYNC_PIPE_COUNT_BATCH_MAX)
 #else
         gettimeofday(&cur_time, NULL);
         if (((uint64_t)cur_time.tv_sec * 1000000 + cur_time.tv_usec) >
-            ((uint64_t)upd_time.tv_sec * 1000000 + upd_time.tv_usec + capture_opts->update_interval*1000))
+            ((uint64_t)upd_time.tv_sec * 1000000 + upd_time.tv_usec + capture_opts->update_interval*1000) ||
+            global_ld.inpkts_to_sync_pipe >= SYNC_PIPE_COUNT_BATCH_MAX)
 #endif
         {
 
@@ -4444,6 +4565,24 @@ capture_loop_start(capture_options *capture_opts, bool *stats_known, struct pcap
                 global_ld.inpkts_to_sync_pipe = 0;
             }
 
+            /* sample the per-stage drop counters into the output file */
+            if (stage_stats_timer != NULL && global_ld.pdh != NULL &&
+                g_timer_elapsed(stage_stats_timer, NULL) >= STAGE_STATS_INTERVAL) {
+                int stats_err = 0;
+
+                if (capture_loop_write_stage_statistics(&global_ld, &stats_err)) {
+                    g_timer_reset(stage_stats_timer);
+                } else {
+                    /* Don't kill the capture over statistics; the write
+                       error will resurface on packet data soon enough if
+                       it's persistent.  Just stop sampling. */
+                    ws_info("Couldn't write stage statistics: %s, disabling sampling",
+                            g_strerror(stats_err));
+                    g_timer_destroy(stage_stats_timer);
+                    stage_stats_timer = NULL;
+                }
+            }
+
             /* check capture duration condition */
             if (autostop_duration_timer != NULL && g_timer_elapsed(autostop_duration_timer, NULL) >= capture_opts->autostop_duration) {
                 /* The maximum capture time has elapsed; stop the capture. */
@@ -4493,6 +4632,8 @@ capture_loop_start(capture_options *capture_opts, bool *stats_known, struct pcap
         g_timer_destroy(global_ld.file_duration_timer);
     if (autostop_duration_timer != NULL)
         g_timer_destroy(autostop_duration_timer);
+    if (stage_stats_timer != NULL)
+        g_timer_destroy(stage_stats_timer);
 
     /* did we have a pcap (input) error? */
     for (i = 0; i < capture_opts->ifaces->len; i++) {
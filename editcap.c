@@ -38,6 +38,7 @@
 
 #include <wiretap/secrets-types.h>
 #include <wiretap/wtap.h>
+#include <wiretap/pcapng.h>
 
 #include "epan/etypes.h"
 #include "epan/dissectors/packet-ieee80211-radiotap-defs.h"
@@ -100,6 +101,20 @@ static fd_hash_t fd_hash[MAX_DUP_DEPTH];
 static int       dup_window    = DEFAULT_DUP_DEPTH;
 static int       cur_dup_entry;
 
+/* Multiset of the digests currently in the fd_hash[] window, so that
+ * the duplicate checks can test a frame with one lookup instead of
+ * scanning the whole window. Keys are copies of fd_hash[] entries,
+ * values track the occurrence count (the window may hold the same
+ * frame data several times) and, for the relative-time mode, the
+ * latest timestamp among the occurrences. */
+typedef struct {
+    unsigned count;
+    nstime_t newest;
+} dup_digest_val_t;
+
+static GHashTable *dup_digest_counts;
+static uint64_t    dup_digests_inserted;
+
 static uint32_t  ignored_bytes;  /* Used with -I */
 
 #define ONE_BILLION 1000000000
@@ -640,9 +655,46 @@ set_unused_info(const wtap_packet_header *phdr, uint8_t* fd) {
     }
 }
 
+static unsigned
+fd_digest_hash(const void *key)
+{
+    unsigned h;
+
+    /* The digest bytes are already uniformly distributed. */
+    memcpy(&h, ((const fd_hash_t *)key)->digest, sizeof h);
+    return h;
+}
+
+static gboolean
+fd_digest_equal(const void *a, const void *b)
+{
+    const fd_hash_t *fda = (const fd_hash_t *)a;
+    const fd_hash_t *fdb = (const fd_hash_t *)b;
+
+    return fda->len == fdb->len
+        && memcmp(fda->digest, fdb->digest, sizeof fda->digest) == 0;
+}
+
+/* Retire whatever digest the slot about to be overwritten holds, now
+ * that it leaves the window. */
+static void
+dup_window_forget_slot(void)
+{
+    dup_digest_val_t *val;
+
+    if (dup_digests_inserted < (uint64_t)dup_window)
+        return;
+
+    val = (dup_digest_val_t *)g_hash_table_lookup(dup_digest_counts,
+                                                  &fd_hash[cur_dup_entry]);
+    if (val != NULL && --val->count == 0) {
+        g_hash_table_remove(dup_digest_counts, &fd_hash[cur_dup_entry]);
+    }
+}
+
 static bool
 is_duplicate(uint8_t* fd, uint32_t len) {
-    int i;
+    dup_digest_val_t *val;
     const struct ieee80211_radiotap_header* tap_header;
 
     /*Hint to ignore some bytes at the start of the frame for the digest calculation(-I option) */
@@ -669,73 +721,60 @@ is_duplicate(uint8_t* fd, uint32_t len) {
     if (cur_dup_entry >= dup_window)
         cur_dup_entry = 0;
 
+    if (dup_digest_counts == NULL) {
+        dup_digest_counts = g_hash_table_new_full(fd_digest_hash,
+                                                  fd_digest_equal,
+                                                  g_free, g_free);
+    }
+
+    dup_window_forget_slot();
+
     /* Calculate our digest */
     gcry_md_hash_buffer(GCRY_MD_MD5, fd_hash[cur_dup_entry].digest, new_fd, new_len);
 
     fd_hash[cur_dup_entry].len = len;
+    dup_digests_inserted++;
 
-    /* Look for duplicates */
-    for (i = 0; i < dup_window; i++) {
-        if (i == cur_dup_entry)
-            continue;
-
-        if (fd_hash[i].len == fd_hash[cur_dup_entry].len
-            && memcmp(fd_hash[i].digest, fd_hash[cur_dup_entry].digest, 16) == 0) {
-            return true;
-        }
+    /* Look for duplicates among the other entries in the window. */
+    val = (dup_digest_val_t *)g_hash_table_lookup(dup_digest_counts,
+                                                  &fd_hash[cur_dup_entry]);
+    if (val != NULL) {
+        val->count++;
+        return true;
     }
 
+    val = g_new0(dup_digest_val_t, 1);
+    val->count = 1;
+    g_hash_table_insert(dup_digest_counts,
+                        g_memdup2(&fd_hash[cur_dup_entry], sizeof(fd_hash_t)),
+                        val);
     return false;
 }
 
+/*
+ * Look for relative time related duplicates by scanning the window.
+ * We check starting from the most recently added hash
+ * entries and work backwards towards older packets.
+ * This approach allows the dup test to be terminated
+ * when the relative time of a cached entry is found to
+ * be beyond the dup time window.
+ *
+ * Of course this assumes that the input trace file is
+ * "well-formed" in the sense that the packet timestamps are
+ * in strict chronologically increasing order (which is NOT
+ * always the case!!), which is why this is only used as the
+ * fallback when is_duplicate_rel_time() sees an out-of-order
+ * timestamp.
+ *
+ * The fd_hash[] table was deliberately created large (1,000,000).
+ * Looking for time related duplicates in large trace files with
+ * non-fractional dup time window values can potentially take
+ * a long time to complete.
+ */
 static bool
-is_duplicate_rel_time(uint8_t* fd, uint32_t len, const nstime_t *current) {
+rel_time_window_scan(const nstime_t *current) {
     int i;
 
-    /*Hint to ignore some bytes at the start of the frame for the digest calculation(-I option) */
-    uint32_t offset = ignored_bytes;
-    uint32_t new_len;
-    uint8_t *new_fd;
-
-    if (len <= ignored_bytes) {
-        offset = 0;
-    }
-
-    new_fd  = &fd[offset];
-    new_len = len - (offset);
-
-    cur_dup_entry++;
-    if (cur_dup_entry >= dup_window)
-        cur_dup_entry = 0;
-
-    /* Calculate our digest */
-    gcry_md_hash_buffer(GCRY_MD_MD5, fd_hash[cur_dup_entry].digest, new_fd, new_len);
-
-    fd_hash[cur_dup_entry].len = len;
-    fd_hash[cur_dup_entry].frame_time.secs = current->secs;
-    fd_hash[cur_dup_entry].frame_time.nsecs = current->nsecs;
-
-    /*
-     * Look for relative time related duplicates.
-     * This is hopefully a reasonably efficient mechanism for
-     * finding duplicates by rel time in the fd_hash[] cache.
-     * We check starting from the most recently added hash
-     * entries and work backwards towards older packets.
-     * This approach allows the dup test to be terminated
-     * when the relative time of a cached entry is found to
-     * be beyond the dup time window.
-     *
-     * Of course this assumes that the input trace file is
-     * "well-formed" in the sense that the packet timestamps are
-     * in strict chronologically increasing order (which is NOT
-     * always the case!!).
-     *
-     * The fd_hash[] table was deliberately created large (1,000,000).
-     * Looking for time related duplicates in large trace files with
-     * non-fractional dup time window values can potentially take
-     * a long time to complete.
-     */
-
     for (i = cur_dup_entry - 1;; i--) {
         nstime_t delta;
         int cmp;
@@ -801,6 +840,76 @@ is_duplicate_rel_time(uint8_t* fd, uint32_t len, const nstime_t *current) {
     return false;
 }
 
+static bool
+is_duplicate_rel_time(uint8_t* fd, uint32_t len, const nstime_t *current) {
+    dup_digest_val_t *val;
+    nstime_t delta;
+    bool dup;
+
+    /*Hint to ignore some bytes at the start of the frame for the digest calculation(-I option) */
+    uint32_t offset = ignored_bytes;
+    uint32_t new_len;
+    uint8_t *new_fd;
+
+    if (len <= ignored_bytes) {
+        offset = 0;
+    }
+
+    new_fd  = &fd[offset];
+    new_len = len - (offset);
+
+    cur_dup_entry++;
+    if (cur_dup_entry >= dup_window)
+        cur_dup_entry = 0;
+
+    if (dup_digest_counts == NULL) {
+        dup_digest_counts = g_hash_table_new_full(fd_digest_hash,
+                                                  fd_digest_equal,
+                                                  g_free, g_free);
+    }
+
+    dup_window_forget_slot();
+
+    /* Calculate our digest */
+    gcry_md_hash_buffer(GCRY_MD_MD5, fd_hash[cur_dup_entry].digest, new_fd, new_len);
+
+    fd_hash[cur_dup_entry].len = len;
+    fd_hash[cur_dup_entry].frame_time.secs = current->secs;
+    fd_hash[cur_dup_entry].frame_time.nsecs = current->nsecs;
+    dup_digests_inserted++;
+
+    val = (dup_digest_val_t *)g_hash_table_lookup(dup_digest_counts,
+                                                  &fd_hash[cur_dup_entry]);
+    if (val == NULL) {
+        /* No equal frame in the window at all. */
+        val = g_new0(dup_digest_val_t, 1);
+        val->count = 1;
+        val->newest = *current;
+        g_hash_table_insert(dup_digest_counts,
+                            g_memdup2(&fd_hash[cur_dup_entry], sizeof(fd_hash_t)),
+                            val);
+        return false;
+    }
+
+    /* Equal frames are in the window; decide by relative time against
+     * the latest of them. */
+    nstime_delta(&delta, current, &val->newest);
+
+    if (delta.secs < 0 || delta.nsecs < 0) {
+        /* The current packet is older than the newest equal frame, so
+         * the timestamps are not in chronological order. Fall back to
+         * the bounded window scan for this packet; see
+         * rel_time_window_scan() for how it treats such entries. */
+        dup = rel_time_window_scan(current);
+    } else {
+        dup = (nstime_cmp(&delta, &relative_time_window) <= 0);
+        val->newest = *current;
+    }
+
+    val->count++;
+    return dup;
+}
+
 static void
 print_usage(FILE *output)
 {
@@ -1311,6 +1420,8 @@ main(int argc, char *argv[])
     uint32_t      snaplen            = 0; /* No limit               */
     chop_t        chop               = {0, 0, 0, 0, 0, 0}; /* No chop */
     bool          adjlen             = false;
+    bool          splice_requested   = false;
+    bool          written;
     wtap_dumper  *pdh                = NULL;
     GArray       *idbs_seen          = NULL;
     uint64_t      count              = 1;
@@ -1968,7 +2079,28 @@ main(int argc, char *argv[])
     /* Set up an array of all IDBs seen */
     idbs_seen = g_array_new(FALSE, FALSE, sizeof(wtap_block_t));
 
-    /* Read all of the packets in turn */
+    /*
+     * If no option rewrites packet records, a pcapng-to-pcapng copy can
+     * splice each packet block's raw bytes into the output, patching
+     * only the interface ID, instead of re-encoding it through the
+     * dumper.  Blocks that can't be spliced (byte-swapped sections,
+     * unexpected layouts) automatically fall back to wtap_dump().
+     * Options that merely select or drop packets (ranges, time frames,
+     * -d duplicate removal) are fine; anything that changes a record's
+     * contents is not.
+     */
+    splice_requested =
+        out_file_type_subtype == wtap_pcapng_file_type_subtype() &&
+        snaplen == 0 && !adjlen &&
+        out_frame_type == -2 &&
+        chop.len_begin == 0 && chop.len_end == 0 &&
+        time_adj.tv.secs == 0 && time_adj.tv.nsecs == 0 &&
+        !do_strict_time_adjustment &&
+        err_prob < 0.0 &&
+        !set_unused && !rem_vlan &&
+        !discard_pkt_comments && frames_user_comments == NULL;
+
+    /* Read all of the packets in turn. */
     wtap_rec_init(&read_rec);
     ws_buffer_init(&read_buf, 1514);
     while (wtap_read(wth, &read_rec, &read_buf, &read_err, &read_err_info, &data_offset)) {
@@ -2504,8 +2636,29 @@ main(int argc, char *argv[])
                 wtap_dump_discard_decryption_secrets(pdh);
             }
 
-            /* Attempt to dump out current frame to the output file */
-            if (!wtap_dump(pdh, rec, buf, &write_err, &write_err_info)) {
+            /* Attempt to dump out current frame to the output file,
+             * splicing the raw pcapng block when possible */
+            written = false;
+            if (splice_requested && pcapng_can_splice(wth, pdh)) {
+                written = pcapng_splice_block(wth, pdh, rec, data_offset,
+                                              &write_err, &write_err_info);
+                if (!written && write_err != 0) {
+                    cfile_write_failure_message(argv[ws_optind], filename,
+                                                write_err, write_err_info,
+                                                read_count,
+                                                out_file_type_subtype);
+                    ret = DUMP_ERROR;
+
+                    /*
+                     * Close the dump file, but don't report an error
+                     * or set the exit code, as we've already reported
+                     * an error.
+                     */
+                    wtap_dump_close(pdh, NULL, &write_err, &write_err_info);
+                    goto clean_exit;
+                }
+            }
+            if (!written && !wtap_dump(pdh, rec, buf, &write_err, &write_err_info)) {
                 cfile_write_failure_message(argv[ws_optind], filename,
                                             write_err, write_err_info,
                                             read_count,
@@ -453,23 +453,21 @@ dnsserver_uat_fld_port_chk_cb(void* r _U_, const char* p, unsigned len _U_, cons
 static void
 c_ares_ghba_sync_cb(void *arg, int status, int timeouts _U_, struct hostent *he) {
     sync_dns_data_t *sdd = (sync_dns_data_t *)arg;
-    char **p;
 
     if (status == ARES_SUCCESS) {
-        for (p = he->h_addr_list; *p != NULL; p++) {
-            switch(sdd->family) {
-                case AF_INET:
-                    add_ipv4_name(sdd->addr.ip4, he->h_name, false);
-                    break;
-                case AF_INET6:
-                    add_ipv6_name(&sdd->addr.ip6, he->h_name, false);
-                    break;
-                default:
-                    /* Throw an exception? */
-                    break;
-            }
+        /* A reply carries one name for the address we asked about, so add
+         * it once rather than once per entry of h_addr_list. */
+        switch(sdd->family) {
+            case AF_INET:
+                add_ipv4_name(sdd->addr.ip4, he->h_name, false);
+                break;
+            case AF_INET6:
+                add_ipv6_name(&sdd->addr.ip6, he->h_name, false);
+                break;
+            default:
+                /* Throw an exception? */
+                break;
         }
-
     }
 
     /*
@@ -955,33 +953,46 @@ _serv_name_lookup(port_type proto, unsigned port, serv_port_t **value_ret)
     /* Look in the cache */
     serv_port_names = (serv_port_t *)wmem_map_lookup(serv_port_hashtable, GUINT_TO_POINTER(port));
 
-    if (serv_port_names == NULL) {
+    if (serv_port_names == NULL ||
+        !(serv_port_names->tried_protos & (1U << proto))) {
+        /*
+         * We haven't searched the tables for this port and transport
+         * yet; do so now, and remember the outcome - hit or miss - so
+         * that later lookups stop at the cache instead of repeating
+         * the searches for every packet.
+         */
+
         /* Try the user custom table */
         serv_port_custom_key_t custom_key = { (uint16_t)port, proto };
         name = wmem_map_lookup(serv_port_custom_hashtable, &custom_key);
-    }
 
-    if (name == NULL) {
-        /* now look in the global tables */
-        bool valid_proto = true;
-        switch(proto) {
-            case PT_TCP: p = ws_tcp; break;
-            case PT_UDP: p = ws_udp; break;
-            case PT_SCTP: p = ws_sctp; break;
-            case PT_DCCP: p = ws_dccp; break;
-            default: valid_proto = false;
-        }
-        if (valid_proto) {
-            serv = global_services_lookup(port, p);
-            if (serv) {
-                name = serv->name;
+        if (name == NULL) {
+            /* now look in the global tables */
+            bool valid_proto = true;
+            switch(proto) {
+                case PT_TCP: p = ws_tcp; break;
+                case PT_UDP: p = ws_udp; break;
+                case PT_SCTP: p = ws_sctp; break;
+                case PT_DCCP: p = ws_dccp; break;
+                default: valid_proto = false;
+            }
+            if (valid_proto) {
+                serv = global_services_lookup(port, p);
+                if (serv) {
+                    name = serv->name;
+                }
             }
         }
-    }
 
-    if (name) {
-        /* Cache result */
-        serv_port_names = add_service_name(proto, port, name);
+        if (name) {
+            /* Cache result */
+            serv_port_names = add_service_name(proto, port, name);
+        } else if (serv_port_names == NULL) {
+            /* Cache the miss too, as an entry with no names. */
+            serv_port_names = wmem_new0(addr_resolv_scope, serv_port_t);
+            wmem_map_insert(serv_port_hashtable, GUINT_TO_POINTER(port), serv_port_names);
+        }
+        serv_port_names->tried_protos |= (1U << proto);
     }
 
     if (value_ret != NULL)
@@ -1274,25 +1285,24 @@ fill_dummy_ip6(hashipv6_t* volatile tp)
 static void
 c_ares_ghba_cb(void *arg, int status, int timeouts _U_, struct hostent *he) {
     async_dns_queue_msg_t *caqm = (async_dns_queue_msg_t *)arg;
-    char **p;
 
     if (!caqm) return;
     /* XXX, what to do if async_dns_in_flight == 0? */
     async_dns_in_flight--;
 
     if (status == ARES_SUCCESS) {
-        for (p = he->h_addr_list; *p != NULL; p++) {
-            switch(caqm->family) {
-                case AF_INET:
-                    add_ipv4_name(caqm->addr.ip4, he->h_name, false);
-                    break;
-                case AF_INET6:
-                    add_ipv6_name(&caqm->addr.ip6, he->h_name, false);
-                    break;
-                default:
-                    /* Throw an exception? */
-                    break;
-            }
+        /* A reply carries one name for the address we asked about, so add
+         * it once rather than once per entry of h_addr_list. */
+        switch(caqm->family) {
+            case AF_INET:
+                add_ipv4_name(caqm->addr.ip4, he->h_name, false);
+                break;
+            case AF_INET6:
+                add_ipv6_name(&caqm->addr.ip6, he->h_name, false);
+                break;
+            default:
+                /* Throw an exception? */
+                break;
         }
     }
     wmem_free(addr_resolv_scope, caqm);
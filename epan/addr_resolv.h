@@ -78,6 +78,9 @@ typedef struct serv_port {
   const char       *sctp_name;
   const char       *dccp_name;
   const char       *numeric;
+  unsigned          tried_protos; /* bitmask of port_type values already
+                                   * looked up in the custom and global
+                                   * tables, so misses are cached too */
 } serv_port_t;
 
 typedef struct _resolved_name {
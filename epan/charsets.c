@@ -11,6 +11,7 @@
 #include "config.h"
 
 #include <errno.h>
+#include <string.h>
 #include <glib.h>
 
 #include <epan/proto.h>
@@ -89,7 +90,24 @@ get_ascii_string(wmem_allocator_t *scope, const uint8_t *ptr, int length)
     str = wmem_strbuf_new_sized(scope, length+1);
 
     while (length > 0) {
-        uint8_t ch = *ptr++;
+        uint8_t ch;
+
+        /* Skip over runs of ASCII eight bytes at a time rather than
+         * testing the high bit of every byte separately. */
+        while (length >= 8) {
+            uint64_t chunk;
+
+            memcpy(&chunk, ptr, sizeof(chunk));
+            if (chunk & UINT64_C(0x8080808080808080))
+                break;
+            valid_bytes += 8;
+            ptr += 8;
+            length -= 8;
+        }
+        if (length == 0)
+            break;
+
+        ch = *ptr++;
 
         if (ch < 0x80) {
             valid_bytes++;
@@ -695,6 +713,53 @@ get_unichar2_string(wmem_allocator_t *scope, const uint8_t *ptr, int length, con
     return (uint8_t *) wmem_strbuf_finalize(str);
 }
 
+/*
+ * Helper for the UCS-2 and UTF-16 converters: consume a run of ASCII
+ * characters, four 16-bit code units at a time, appending the low bytes
+ * directly to the string buffer, and return the new byte offset.  A code
+ * unit is ASCII when its high byte is zero and its low byte is under
+ * 0x80, so a single 64-bit mask test covers four units; that skips the
+ * per-character validation and UTF-8 encoding steps for the common case
+ * of protocols (SMB, LDAP, DCE/RPC) carrying ASCII names in 16-bit
+ * encodings.  ASCII code units are never surrogates, so this is safe
+ * for UTF-16 as well as UCS-2.
+ *
+ * The encoding parameter must already be normalized to ENC_BIG_ENDIAN
+ * or ENC_LITTLE_ENDIAN.
+ */
+static int
+append_ascii_16_run(wmem_strbuf_t *strbuf, const uint8_t *ptr, int length,
+                    int i, unsigned encoding)
+{
+    /* Byte patterns that must be zero for a chunk of four code units to
+     * be all-ASCII: 0xff over each high byte, 0x80 over each low byte. */
+    static const uint8_t ascii_mask[2][8] = {
+        { 0x80, 0xff, 0x80, 0xff, 0x80, 0xff, 0x80, 0xff }, /* little-endian */
+        { 0xff, 0x80, 0xff, 0x80, 0xff, 0x80, 0xff, 0x80 }, /* big-endian */
+    };
+    /* Offset of the low (ASCII) byte within a code unit; also selects
+     * the mask row above. */
+    const int lo = (encoding == ENC_BIG_ENDIAN) ? 1 : 0;
+    uint64_t chunk, mask;
+
+    memcpy(&mask, ascii_mask[lo], sizeof(mask));
+
+    while (i + 8 <= length) {
+        uint8_t out[4];
+
+        memcpy(&chunk, ptr + i, sizeof(chunk));
+        if (chunk & mask)
+            break;
+        out[0] = ptr[i + lo];
+        out[1] = ptr[i + 2 + lo];
+        out[2] = ptr[i + 4 + lo];
+        out[3] = ptr[i + 6 + lo];
+        wmem_strbuf_append_len(strbuf, out, sizeof(out));
+        i += 8;
+    }
+    return i;
+}
+
 /*
  * Given a wmem scope, a pointer, and a length, treat the string of bytes
  * referred to by the pointer and length as a UCS-2 encoded string
@@ -729,6 +794,9 @@ get_ucs_2_string(wmem_allocator_t *scope, const uint8_t *ptr, int length, unsign
     encoding = encoding & ENC_LITTLE_ENDIAN;
 
     for(; i + 1 < length; i += 2) {
+        i = append_ascii_16_run(strbuf, ptr, length, i, encoding);
+        if (i + 1 >= length)
+            break;
         if (encoding == ENC_BIG_ENDIAN) {
             uchar = pntoh16(ptr + i);
         } else {
@@ -782,6 +850,9 @@ get_utf_16_string(wmem_allocator_t *scope, const uint8_t *ptr, int length, unsig
     encoding = encoding & ENC_LITTLE_ENDIAN;
 
     for(; i + 1 < length; i += 2) {
+        i = append_ascii_16_run(strbuf, ptr, length, i, encoding);
+        if (i + 1 >= length)
+            break;
         if (encoding == ENC_BIG_ENDIAN)
             uchar2 = pntoh16(ptr + i);
         else
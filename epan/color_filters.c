@@ -51,6 +51,20 @@ static GSList *color_filter_valid_list;
 /* Color Filters can en-/disabled. */
 static bool filters_enabled = true;
 
+/* The union of the fields the active filters are interested in, so that
+ * priming a dissection makes one pass over a deduplicated array instead
+ * of one pass per filter. Rebuilt on demand after the rule set changes. */
+static GArray *color_filter_interesting_hfids;
+
+static void
+invalidate_interesting_hfids(void)
+{
+    if (color_filter_interesting_hfids != NULL) {
+        g_array_free(color_filter_interesting_hfids, TRUE);
+        color_filter_interesting_hfids = NULL;
+    }
+}
+
 /* Remember if there are temporary coloring filters set to
  * add sensitivity to the "Reset Coloring 1-10" menu item
  */
@@ -159,6 +173,9 @@ color_filters_set_tmp(uint8_t filt_nr, const char *filter, bool disabled, char *
     dfilter_t      *compiled_filter;
     uint8_t        i;
     df_error_t     *df_err = NULL;
+
+    invalidate_interesting_hfids();
+
     /* Go through the temporary filters and look for the same filter string.
      * If found, clear it so that a filter can be "moved" up and down the list
      */
@@ -305,6 +322,8 @@ color_filters_get(char** err_msg, color_filter_add_cb_func add_cb)
     FILE     *f;
     int       ret;
 
+    invalidate_interesting_hfids();
+
     /* start the list with the temporary colorizing rules */
     color_filters_add_tmp(&color_filter_list);
 
@@ -374,6 +393,7 @@ color_filters_cleanup(void)
 {
     /* delete the previously deleted filters */
     color_filter_list_delete(&color_filter_deleted_list);
+    invalidate_interesting_hfids();
 }
 
 typedef struct _color_clone
@@ -458,6 +478,8 @@ color_filters_apply(GSList *tmp_cfl, GSList *edit_cfl, char** err_msg)
 
     *err_msg = NULL;
 
+    invalidate_interesting_hfids();
+
     /* "move" old entries to the deleted list
      * we must keep them until the dissection no longer needs them */
     color_filter_deleted_list = g_slist_concat(color_filter_deleted_list, color_filter_list);
@@ -499,15 +521,24 @@ tmp_color_filters_used(void)
     return tmp_colors_set;
 }
 
-/* prepare the epan_dissect_t for the filter */
+/* collect the fields a filter is interested in (called from g_slist_foreach) */
 static void
-prime_edt(void *data, void *user_data)
+add_interesting_hfids(void *data, void *user_data)
 {
     color_filter_t *colorf = (color_filter_t *)data;
-    epan_dissect_t *edt    = (epan_dissect_t *)user_data;
+    GHashTable     *seen   = (GHashTable *)user_data;
+    const int      *fields;
+    int             num_fields, i;
 
-    if (colorf->c_colorfilter != NULL)
-        epan_dissect_prime_with_dfilter(edt, colorf->c_colorfilter);
+    if (colorf->disabled || colorf->c_colorfilter == NULL)
+        return;
+
+    fields = dfilter_interesting_fields(colorf->c_colorfilter, &num_fields);
+    for (i = 0; i < num_fields; i++) {
+        if (g_hash_table_add(seen, GINT_TO_POINTER(fields[i]))) {
+            g_array_append_val(color_filter_interesting_hfids, fields[i]);
+        }
+    }
 }
 
 /* Prime the epan_dissect_t with all the compiler
@@ -515,8 +546,23 @@ prime_edt(void *data, void *user_data)
 void
 color_filters_prime_edt(epan_dissect_t *edt)
 {
-    if (color_filters_used())
-        g_slist_foreach(color_filter_list, prime_edt, edt);
+    unsigned i;
+
+    if (!color_filters_used())
+        return;
+
+    if (color_filter_interesting_hfids == NULL) {
+        GHashTable *seen = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+        color_filter_interesting_hfids = g_array_new(FALSE, FALSE, sizeof(int));
+        g_slist_foreach(color_filter_list, add_interesting_hfids, seen);
+        g_hash_table_destroy(seen);
+    }
+
+    for (i = 0; i < color_filter_interesting_hfids->len; i++) {
+        epan_dissect_prime_with_hfid(edt,
+            g_array_index(color_filter_interesting_hfids, int, i));
+    }
 }
 
 static int
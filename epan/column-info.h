@@ -56,6 +56,10 @@ typedef struct {
   int                 col_fence;            /**< Stuff in column buffer before this index is immutable */
   bool                writable;             /**< writable or not */
   int                 hf_id;
+  void              (*col_fill)(packet_info *pinfo, const int col,
+                                const bool fill_col_exprs,
+                                const bool fill_fd_colums);
+                                            /**< Fill routine resolved from col_fmt */
 } col_item_t;
 
 /** Column info */
@@ -92,6 +96,12 @@ WS_DLL_PUBLIC void col_fill_in_frame_data(const frame_data *fd, column_info *cin
  */
 WS_DLL_PUBLIC void col_fill_in(packet_info *pinfo, const bool fill_col_exprs, const bool fill_fd_colums);
 
+/** Resolve each column's format into a direct fill routine.  Called from
+ * col_finalize() so that col_fill_in() doesn't have to re-dispatch through
+ * the format switch for every column of every packet.
+ */
+extern void col_compile_fill_funcs(column_info *cinfo);
+
 /** Fill in columns if we got an error reading the packet.
  * We set most columns to "???", and set the Info column to an error
  * message.
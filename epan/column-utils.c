@@ -1894,119 +1894,249 @@ col_fill_in_frame_data(const frame_data *fd, column_info *cinfo, const int col,
   }
 }
 
+/*
+ * Per-format fill routines with a common signature, so that a column's
+ * format can be resolved to a direct call once, when the column array is
+ * built, instead of being re-dispatched through a switch for every
+ * column of every packet.
+ */
+static void
+col_fill_fd_cols(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums)
+{
+  if (fill_fd_colums)
+    col_fill_in_frame_data(pinfo->fd, pinfo->cinfo, col, fill_col_exprs);
+}
+
+static void
+col_fill_res_src(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_addr(pinfo, col, &pinfo->src, true, fill_col_exprs, true);
+}
+
+static void
+col_fill_unres_src(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_addr(pinfo, col, &pinfo->src, true, fill_col_exprs, false);
+}
+
+static void
+col_fill_res_dl_src(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_addr(pinfo, col, &pinfo->dl_src, true, fill_col_exprs, true);
+}
+
+static void
+col_fill_unres_dl_src(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_addr(pinfo, col, &pinfo->dl_src, true, fill_col_exprs, false);
+}
+
+static void
+col_fill_res_net_src(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_addr(pinfo, col, &pinfo->net_src, true, fill_col_exprs, true);
+}
+
+static void
+col_fill_unres_net_src(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_addr(pinfo, col, &pinfo->net_src, true, fill_col_exprs, false);
+}
+
+static void
+col_fill_res_dst(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_addr(pinfo, col, &pinfo->dst, false, fill_col_exprs, true);
+}
+
+static void
+col_fill_unres_dst(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_addr(pinfo, col, &pinfo->dst, false, fill_col_exprs, false);
+}
+
+static void
+col_fill_res_dl_dst(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_addr(pinfo, col, &pinfo->dl_dst, false, fill_col_exprs, true);
+}
+
+static void
+col_fill_unres_dl_dst(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_addr(pinfo, col, &pinfo->dl_dst, false, fill_col_exprs, false);
+}
+
+static void
+col_fill_res_net_dst(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_addr(pinfo, col, &pinfo->net_dst, false, fill_col_exprs, true);
+}
+
+static void
+col_fill_unres_net_dst(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_addr(pinfo, col, &pinfo->net_dst, false, fill_col_exprs, false);
+}
+
+static void
+col_fill_res_src_port(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_port(pinfo, col, true, true, fill_col_exprs);
+}
+
+static void
+col_fill_unres_src_port(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_port(pinfo, col, false, true, fill_col_exprs);
+}
+
+static void
+col_fill_res_dst_port(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_port(pinfo, col, true, false, fill_col_exprs);
+}
+
+static void
+col_fill_unres_dst_port(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_set_port(pinfo, col, false, false, fill_col_exprs);
+}
+
+static void
+col_fill_dissector_filled(packet_info *pinfo, const int col, const bool fill_col_exprs, const bool fill_fd_colums _U_)
+{
+  col_item_t* col_item = &pinfo->cinfo->columns[col];
+
+  /*
+   * Formatting handled by expert.c (COL_EXPERT), or individual
+   * dissectors. Fill in from the text using the internal hfid.
+   */
+  if (fill_col_exprs) {
+    pinfo->cinfo->col_expr.col_expr[col] = proto_registrar_get_nth(col_item->hf_id)->abbrev;
+    (void) g_strlcpy(pinfo->cinfo->col_expr.col_expr_val[col], col_item->col_data, (col_item->col_fmt == COL_INFO) ? COL_MAX_INFO_LEN : COL_MAX_LEN);
+  }
+}
+
 void
-col_fill_in(packet_info *pinfo, const bool fill_col_exprs, const bool fill_fd_colums)
+col_compile_fill_funcs(column_info *cinfo)
 {
   int i;
   col_item_t* col_item;
 
-  if (!pinfo->cinfo)
-    return;
-
-  for (i = 0; i < pinfo->cinfo->num_cols; i++) {
-    col_item = &pinfo->cinfo->columns[i];
-    if (col_based_on_frame_data(pinfo->cinfo, i)) {
-      if (fill_fd_colums)
-        col_fill_in_frame_data(pinfo->fd, pinfo->cinfo, i, fill_col_exprs);
-    } else {
-      switch (col_item->col_fmt) {
-      case COL_DEF_SRC:
-      case COL_RES_SRC:   /* COL_DEF_SRC is currently just like COL_RES_SRC */
-        col_set_addr(pinfo, i, &pinfo->src, true, fill_col_exprs, true);
-        break;
+  for (i = 0; i < cinfo->num_cols; i++) {
+    col_item = &cinfo->columns[i];
+    if (col_based_on_frame_data(cinfo, i)) {
+      col_item->col_fill = col_fill_fd_cols;
+      continue;
+    }
+    switch (col_item->col_fmt) {
+    case COL_DEF_SRC:
+    case COL_RES_SRC:   /* COL_DEF_SRC is currently just like COL_RES_SRC */
+      col_item->col_fill = col_fill_res_src;
+      break;
 
-      case COL_UNRES_SRC:
-        col_set_addr(pinfo, i, &pinfo->src, true, fill_col_exprs, false);
-        break;
+    case COL_UNRES_SRC:
+      col_item->col_fill = col_fill_unres_src;
+      break;
 
-      case COL_DEF_DL_SRC:
-      case COL_RES_DL_SRC:
-        col_set_addr(pinfo, i, &pinfo->dl_src, true, fill_col_exprs, true);
-        break;
+    case COL_DEF_DL_SRC:
+    case COL_RES_DL_SRC:
+      col_item->col_fill = col_fill_res_dl_src;
+      break;
 
-      case COL_UNRES_DL_SRC:
-        col_set_addr(pinfo, i, &pinfo->dl_src, true, fill_col_exprs, false);
-        break;
+    case COL_UNRES_DL_SRC:
+      col_item->col_fill = col_fill_unres_dl_src;
+      break;
 
-      case COL_DEF_NET_SRC:
-      case COL_RES_NET_SRC:
-        col_set_addr(pinfo, i, &pinfo->net_src, true, fill_col_exprs, true);
-        break;
+    case COL_DEF_NET_SRC:
+    case COL_RES_NET_SRC:
+      col_item->col_fill = col_fill_res_net_src;
+      break;
 
-      case COL_UNRES_NET_SRC:
-        col_set_addr(pinfo, i, &pinfo->net_src, true, fill_col_exprs, false);
-        break;
+    case COL_UNRES_NET_SRC:
+      col_item->col_fill = col_fill_unres_net_src;
+      break;
 
-      case COL_DEF_DST:
-      case COL_RES_DST:   /* COL_DEF_DST is currently just like COL_RES_DST */
-        col_set_addr(pinfo, i, &pinfo->dst, false, fill_col_exprs, true);
-        break;
+    case COL_DEF_DST:
+    case COL_RES_DST:   /* COL_DEF_DST is currently just like COL_RES_DST */
+      col_item->col_fill = col_fill_res_dst;
+      break;
 
-      case COL_UNRES_DST:
-        col_set_addr(pinfo, i, &pinfo->dst, false, fill_col_exprs, false);
-        break;
+    case COL_UNRES_DST:
+      col_item->col_fill = col_fill_unres_dst;
+      break;
 
-      case COL_DEF_DL_DST:
-      case COL_RES_DL_DST:
-        col_set_addr(pinfo, i, &pinfo->dl_dst, false, fill_col_exprs, true);
-        break;
+    case COL_DEF_DL_DST:
+    case COL_RES_DL_DST:
+      col_item->col_fill = col_fill_res_dl_dst;
+      break;
 
-      case COL_UNRES_DL_DST:
-        col_set_addr(pinfo, i, &pinfo->dl_dst, false, fill_col_exprs, false);
-        break;
+    case COL_UNRES_DL_DST:
+      col_item->col_fill = col_fill_unres_dl_dst;
+      break;
 
-      case COL_DEF_NET_DST:
-      case COL_RES_NET_DST:
-        col_set_addr(pinfo, i, &pinfo->net_dst, false, fill_col_exprs, true);
-        break;
+    case COL_DEF_NET_DST:
+    case COL_RES_NET_DST:
+      col_item->col_fill = col_fill_res_net_dst;
+      break;
 
-      case COL_UNRES_NET_DST:
-        col_set_addr(pinfo, i, &pinfo->net_dst, false, fill_col_exprs, false);
-        break;
+    case COL_UNRES_NET_DST:
+      col_item->col_fill = col_fill_unres_net_dst;
+      break;
 
-      case COL_DEF_SRC_PORT:
-      case COL_RES_SRC_PORT:  /* COL_DEF_SRC_PORT is currently just like COL_RES_SRC_PORT */
-        col_set_port(pinfo, i, true, true, fill_col_exprs);
-        break;
+    case COL_DEF_SRC_PORT:
+    case COL_RES_SRC_PORT:  /* COL_DEF_SRC_PORT is currently just like COL_RES_SRC_PORT */
+      col_item->col_fill = col_fill_res_src_port;
+      break;
 
-      case COL_UNRES_SRC_PORT:
-        col_set_port(pinfo, i, false, true, fill_col_exprs);
-        break;
+    case COL_UNRES_SRC_PORT:
+      col_item->col_fill = col_fill_unres_src_port;
+      break;
 
-      case COL_DEF_DST_PORT:
-      case COL_RES_DST_PORT:  /* COL_DEF_DST_PORT is currently just like COL_RES_DST_PORT */
-        col_set_port(pinfo, i, true, false, fill_col_exprs);
-        break;
+    case COL_DEF_DST_PORT:
+    case COL_RES_DST_PORT:  /* COL_DEF_DST_PORT is currently just like COL_RES_DST_PORT */
+      col_item->col_fill = col_fill_res_dst_port;
+      break;
 
-      case COL_UNRES_DST_PORT:
-        col_set_port(pinfo, i, false, false, fill_col_exprs);
-        break;
+    case COL_UNRES_DST_PORT:
+      col_item->col_fill = col_fill_unres_dst_port;
+      break;
 
-      case COL_CUSTOM:
-        /* Formatting handled by col_custom_set_edt() / col_custom_get_filter() */
-        break;
+    case COL_CUSTOM:
+      /* Formatting handled by col_custom_set_edt() / col_custom_get_filter() */
+      col_item->col_fill = NULL;
+      break;
 
-      case NUM_COL_FMTS:  /* keep compiler happy - shouldn't get here */
+    case NUM_COL_FMTS:  /* keep compiler happy - shouldn't get here */
+      ws_assert_not_reached();
+      break;
+    default:
+      if (col_item->col_fmt >= NUM_COL_FMTS) {
         ws_assert_not_reached();
-        break;
-      default:
-        if (col_item->col_fmt >= NUM_COL_FMTS) {
-          ws_assert_not_reached();
-        }
-        /*
-         * Formatting handled by expert.c (COL_EXPERT), or individual
-         * dissectors. Fill in from the text using the internal hfid.
-         */
-        if (fill_col_exprs) {
-          pinfo->cinfo->col_expr.col_expr[i] = proto_registrar_get_nth(col_item->hf_id)->abbrev;
-          (void) g_strlcpy(pinfo->cinfo->col_expr.col_expr_val[i], pinfo->cinfo->columns[i].col_data, (col_item->col_fmt == COL_INFO) ? COL_MAX_INFO_LEN : COL_MAX_LEN);
-        }
-        break;
       }
+      col_item->col_fill = col_fill_dissector_filled;
+      break;
     }
   }
 }
 
+void
+col_fill_in(packet_info *pinfo, const bool fill_col_exprs, const bool fill_fd_colums)
+{
+  int i;
+  col_item_t* col_item;
+
+  if (!pinfo->cinfo)
+    return;
+
+  for (i = 0; i < pinfo->cinfo->num_cols; i++) {
+    col_item = &pinfo->cinfo->columns[i];
+    if (col_item->col_fill)
+      col_item->col_fill(pinfo, i, fill_col_exprs, fill_fd_colums);
+  }
+}
+
 /*
  * Fill in columns if we got an error reading the packet.
  * We set most columns to "???", fill in columns that don't need data read
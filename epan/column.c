@@ -1080,6 +1080,8 @@ col_finalize(column_info *cinfo)
       cinfo->col_last[j] = i;
     }
   }
+
+  col_compile_fill_funcs(cinfo);
 }
 
 void
@@ -112,6 +112,12 @@ static const char *type_names[] = {
  */
 static wmem_map_t *conversation_hashtable_element_list;
 
+/*
+ * Cache mapping the packed element-type signature of a key list to its
+ * hash table, so that repeated lookups skip rebuilding the name string.
+ */
+static wmem_map_t *conversation_hashtable_element_signature;
+
 /*
  * Hash table for conversations based on addresses only
  */
@@ -164,6 +170,49 @@ static uint32_t new_index;
  */
 static address null_address_ = ADDRESS_INIT_NONE;
 
+/*
+ * One-entry memo of the most recent find_conversation() query.
+ *
+ * While one packet is being dissected, find_conversation() tends to be
+ * called several times with the same 5-tuple - the dissector itself,
+ * subdissectors, taps and helpers such as find_or_create_conversation()
+ * each do their own lookup - so remembering the last query (including a
+ * query that found nothing) short-circuits most of the repeated hash
+ * table walks. The memo is invalidated whenever the hash tables are
+ * mutated, which also covers the conversation_set_addr2() and
+ * conversation_set_port2() side effects of the lookups themselves.
+ *
+ * The addresses are stored inline; queries with addresses longer than
+ * the inline storage (large enough for IPv6 plus the usual interface
+ * qualifiers) are simply not memoized.
+ */
+#define FIND_MEMO_MAX_ADDR 32
+
+static struct {
+    bool valid;
+    uint32_t frame_num;
+    conversation_type ctype;
+    uint32_t port_a;
+    uint32_t port_b;
+    unsigned options;
+    int addr_a_type;
+    int addr_a_len;
+    uint8_t addr_a_data[FIND_MEMO_MAX_ADDR];
+    int addr_b_type;
+    int addr_b_len;
+    uint8_t addr_b_data[FIND_MEMO_MAX_ADDR];
+    conversation_t *result;
+} find_memo;
+
+static bool
+find_memo_addr_match(const address *addr, int type, int len, const uint8_t *data)
+{
+    if (addr->type != type || addr->len != len) {
+        return false;
+    }
+    return len == 0 || memcmp(addr->data, data, len) == 0;
+}
+
 
 /* Element count including the terminating CE_CONVERSATION_TYPE */
 #define MAX_CONVERSATION_ELEMENTS 8 // Arbitrary.
@@ -207,6 +256,22 @@ conversation_element_list_name(wmem_allocator_t *allocator, conversation_element
     return wmem_strbuf_finalize(conv_hash_group);
 }
 
+/* Pack the element types into a single value, as suggested at the top of
+ * this file: four bits per element (the +1 keeps every nibble nonzero),
+ * at most MAX_CONVERSATION_ELEMENTS elements. Two element lists have the
+ * same signature exactly when they have the same name. */
+static uint32_t
+conversation_element_list_signature(conversation_element_t *elements)
+{
+    uint32_t signature = 0;
+    size_t element_count = conversation_element_count(elements);
+    for (size_t i = 0; i < element_count; i++) {
+        DISSECTOR_ASSERT(elements[i].type < array_length(type_names));
+        signature = (signature << 4) | ((uint32_t)elements[i].type + 1);
+    }
+    return signature;
+}
+
 #if 0 // debugging
 static char* conversation_element_list_values(conversation_element_t *elements) {
     char *sep = "";
@@ -546,6 +611,7 @@ conversation_init(void)
      * above.
      */
     conversation_hashtable_element_list = wmem_map_new(wmem_epan_scope(), wmem_str_hash, g_str_equal);
+    conversation_hashtable_element_signature = wmem_map_new(wmem_epan_scope(), g_direct_hash, g_direct_equal);
 
     conversation_element_t exact_elements[EXACT_IDX_COUNT] = {
         { CE_ADDRESS, .addr_val = ADDRESS_INIT_NONE },
@@ -700,6 +766,7 @@ conversation_epan_reset(void)
      * Start the conversation indices over at 0.
      */
     new_index = 0;
+    find_memo.valid = false;
 }
 
 /*
@@ -713,6 +780,8 @@ conversation_insert_into_hashtable(wmem_map_t *hashtable, conversation_t *conv)
 {
     conversation_t *chain_head, *chain_tail, *cur, *prev;
 
+    find_memo.valid = false;
+
     chain_head = (conversation_t *)wmem_map_lookup(hashtable, conv->key_ptr);
 
     if (NULL==chain_head) {
@@ -770,6 +839,8 @@ conversation_remove_from_hashtable(wmem_map_t *hashtable, conversation_t *conv)
 {
     conversation_t *chain_head, *cur, *prev;
 
+    find_memo.valid = false;
+
     chain_head = (conversation_t *)wmem_map_lookup(hashtable, conv->key_ptr);
 
     if (conv == chain_head) {
@@ -825,12 +896,18 @@ conversation_t *conversation_new_full(const uint32_t setup_frame, conversation_e
 {
     DISSECTOR_ASSERT(elements);
 
-    char *el_list_map_key = conversation_element_list_name(wmem_epan_scope(), elements);
-    wmem_map_t *el_list_map = (wmem_map_t *) wmem_map_lookup(conversation_hashtable_element_list, el_list_map_key);
+    uint32_t el_list_sig = conversation_element_list_signature(elements);
+    wmem_map_t *el_list_map = (wmem_map_t *) wmem_map_lookup(conversation_hashtable_element_signature,
+            GUINT_TO_POINTER(el_list_sig));
     if (!el_list_map) {
-        el_list_map = wmem_map_new_autoreset(wmem_epan_scope(), wmem_file_scope(), conversation_hash_element_list,
-                conversation_match_element_list);
-        wmem_map_insert(conversation_hashtable_element_list, wmem_strdup(wmem_epan_scope(), el_list_map_key), el_list_map);
+        char *el_list_map_key = conversation_element_list_name(wmem_epan_scope(), elements);
+        el_list_map = (wmem_map_t *) wmem_map_lookup(conversation_hashtable_element_list, el_list_map_key);
+        if (!el_list_map) {
+            el_list_map = wmem_map_new_autoreset(wmem_epan_scope(), wmem_file_scope(), conversation_hash_element_list,
+                    conversation_match_element_list);
+            wmem_map_insert(conversation_hashtable_element_list, el_list_map_key, el_list_map);
+        }
+        wmem_map_insert(conversation_hashtable_element_signature, GUINT_TO_POINTER(el_list_sig), el_list_map);
     }
 
     size_t element_count = conversation_element_count(elements);
@@ -1356,11 +1433,17 @@ static conversation_t *conversation_lookup_hashtable(wmem_map_t *conversation_ha
 
 conversation_t *find_conversation_full(const uint32_t frame_num, conversation_element_t *elements)
 {
-    char *el_list_map_key = conversation_element_list_name(NULL, elements);
-    wmem_map_t *el_list_map = (wmem_map_t *) wmem_map_lookup(conversation_hashtable_element_list, el_list_map_key);
-    g_free(el_list_map_key);
+    uint32_t el_list_sig = conversation_element_list_signature(elements);
+    wmem_map_t *el_list_map = (wmem_map_t *) wmem_map_lookup(conversation_hashtable_element_signature,
+            GUINT_TO_POINTER(el_list_sig));
     if (!el_list_map) {
-        return NULL;
+        char *el_list_map_key = conversation_element_list_name(NULL, elements);
+        el_list_map = (wmem_map_t *) wmem_map_lookup(conversation_hashtable_element_list, el_list_map_key);
+        g_free(el_list_map_key);
+        if (!el_list_map) {
+            return NULL;
+        }
+        wmem_map_insert(conversation_hashtable_element_signature, GUINT_TO_POINTER(el_list_sig), el_list_map);
     }
 
     return conversation_lookup_hashtable(el_list_map, frame_num, elements);
@@ -1556,20 +1639,12 @@ conversation_lookup_deinterlacer(const uint32_t frame_num, const address *addr1,
  *
  *	otherwise, we found no matching conversation, and return NULL.
  */
-conversation_t *
-find_conversation(const uint32_t frame_num, const address *addr_a, const address *addr_b, const conversation_type ctype,
+static conversation_t *
+find_conversation_real(const uint32_t frame_num, const address *addr_a, const address *addr_b, const conversation_type ctype,
         const uint32_t port_a, const uint32_t port_b, const unsigned options)
 {
     conversation_t *conversation, *other_conv;
 
-    if (!addr_a) {
-        addr_a = &null_address_;
-    }
-
-    if (!addr_b) {
-        addr_b = &null_address_;
-    }
-
     DINSTR(char *addr_a_str = address_to_str(NULL, addr_a));
     DINSTR(char *addr_b_str = address_to_str(NULL, addr_b));
     /*
@@ -1937,6 +2012,61 @@ end:
     return conversation;
 }
 
+conversation_t *
+find_conversation(const uint32_t frame_num, const address *addr_a, const address *addr_b, const conversation_type ctype,
+        const uint32_t port_a, const uint32_t port_b, const unsigned options)
+{
+    conversation_t *conversation;
+
+    if (!addr_a) {
+        addr_a = &null_address_;
+    }
+
+    if (!addr_b) {
+        addr_b = &null_address_;
+    }
+
+    if (find_memo.valid &&
+        find_memo.frame_num == frame_num &&
+        find_memo.ctype == ctype &&
+        find_memo.port_a == port_a &&
+        find_memo.port_b == port_b &&
+        find_memo.options == options &&
+        find_memo_addr_match(addr_a, find_memo.addr_a_type, find_memo.addr_a_len, find_memo.addr_a_data) &&
+        find_memo_addr_match(addr_b, find_memo.addr_b_type, find_memo.addr_b_len, find_memo.addr_b_data)) {
+        return find_memo.result;
+    }
+
+    conversation = find_conversation_real(frame_num, addr_a, addr_b, ctype, port_a, port_b, options);
+
+    /*
+     * The lookup itself may have modified the tables (via
+     * conversation_set_addr2() and friends), clearing the memo, so only
+     * record the query once the final result is known.
+     */
+    if (addr_a->len <= FIND_MEMO_MAX_ADDR && addr_b->len <= FIND_MEMO_MAX_ADDR) {
+        find_memo.frame_num = frame_num;
+        find_memo.ctype = ctype;
+        find_memo.port_a = port_a;
+        find_memo.port_b = port_b;
+        find_memo.options = options;
+        find_memo.addr_a_type = addr_a->type;
+        find_memo.addr_a_len = addr_a->len;
+        if (addr_a->len > 0) {
+            memcpy(find_memo.addr_a_data, addr_a->data, addr_a->len);
+        }
+        find_memo.addr_b_type = addr_b->type;
+        find_memo.addr_b_len = addr_b->len;
+        if (addr_b->len > 0) {
+            memcpy(find_memo.addr_b_data, addr_b->data, addr_b->len);
+        }
+        find_memo.result = conversation;
+        find_memo.valid = true;
+    }
+
+    return conversation;
+}
+
 conversation_t *
 find_conversation_deinterlaced(const uint32_t frame_num, const address *addr_a, const address *addr_b, const conversation_type ctype,
         const uint32_t port_a, const uint32_t port_b, const uint32_t anchor, const unsigned options)
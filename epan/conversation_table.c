@@ -216,16 +216,16 @@ static unsigned
 conversation_hash(const void *v)
 {
     const conv_key_t *key = (const conv_key_t *)v;
-    unsigned hash_val;
+    unsigned hash_fwd, hash_rev;
 
-    hash_val = 0;
-    hash_val = add_address_to_hash(hash_val, &key->addr1);
-    hash_val += key->port1;
-    hash_val = add_address_to_hash(hash_val, &key->addr2);
-    hash_val += key->port2;
-    hash_val ^= key->conv_id;
+    /* Hash each endpoint separately and combine commutatively, so a key
+     * and its reverse land in the same bucket; conversation_equal()
+     * matches both directions, which lets callers find a conversation
+     * with a single lookup regardless of packet direction. */
+    hash_fwd = add_address_to_hash(0, &key->addr1) + key->port1;
+    hash_rev = add_address_to_hash(0, &key->addr2) + key->port2;
 
-    return hash_val;
+    return (hash_fwd + hash_rev) ^ key->conv_id;
 }
 
 /** Compare two conversation keys for an exact match.
@@ -675,7 +675,8 @@ add_conversation_table_data_with_conv_id(
                                               NULL);              /* value_destroy_func */
 
     } else { /* try to find it among the existing known conversations */
-        /* first, check in the fwd conversations */
+        /* The hash is direction-independent and the comparison matches
+         * reversed keys, so one lookup covers both directions. */
         conv_key_t existing_key;
         void *conversation_idx_hash_val;
 
@@ -686,19 +687,11 @@ add_conversation_table_data_with_conv_id(
         existing_key.conv_id = conv_id;
         if (g_hash_table_lookup_extended(ch->hashtable, &existing_key, NULL, &conversation_idx_hash_val)) {
             conv_item = &g_array_index(ch->conv_array, conv_item_t, GPOINTER_TO_UINT(conversation_idx_hash_val));
-        }
-        if (conv_item == NULL) {
-            /* then, check in the rev conversations if not found in 'fwd' */
-            existing_key.addr1 = *dst;
-            existing_key.addr2 = *src;
-            existing_key.port1 = dst_port;
-            existing_key.port2 = src_port;
-            if (g_hash_table_lookup_extended(ch->hashtable, &existing_key, NULL, &conversation_idx_hash_val)) {
-                conv_item = &g_array_index(ch->conv_array, conv_item_t, GPOINTER_TO_UINT(conversation_idx_hash_val));
-            }
-        } else {
-            /* a conversation was found in this same fwd direction */
-            is_fwd_direction = true;
+            /* Which direction of the stored conversation is this packet
+             * going in?  (For a conversation between one endpoint and
+             * itself the two are the same, so the answer is moot.) */
+            is_fwd_direction = (conv_item->src_port == src_port) &&
+                addresses_equal(&conv_item->src_address, src);
         }
     }
 
@@ -80,12 +80,10 @@ int Dot11DecryptGcmpDecrypt(
 	gcmp_construct_nonce(wh, pn, nonce);
 	dot11decrypt_construct_aad(wh, aad, &aad_len);
 
-	if (gcry_cipher_open(&handle, GCRY_CIPHER_AES, GCRY_CIPHER_MODE_GCM, 0)) {
+	handle = dot11decrypt_cipher_cached(GCRY_CIPHER_MODE_GCM, TK1, tk_len);
+	if (handle == NULL) {
 		return 1;
 	}
-	if (gcry_cipher_setkey(handle, TK1, tk_len)) {
-		goto err_out;
-	}
 	if (gcry_cipher_setiv(handle, nonce, sizeof(nonce))) {
 		goto err_out;
 	}
@@ -102,9 +100,7 @@ int Dot11DecryptGcmpDecrypt(
 	/* TODO replay check	(IEEE 802.11i-2004, pg. 62)			*/
 	/* TODO PN must be incremental (IEEE 802.11i-2004, pg. 62)		*/
 
-	gcry_cipher_close(handle);
 	return 0;
 err_out:
-	gcry_cipher_close(handle);
 	return 1;
 }
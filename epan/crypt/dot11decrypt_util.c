@@ -398,6 +398,57 @@ dot11decrypt_derive_ft_ptk(const uint8_t *pmk_r1, size_t pmk_r1_len,
     return true;
 }
 
+/*
+ * AES cipher handle cache for the per-record CCMP/GCMP paths.
+ *
+ * Opening a handle and setting the key runs the AES key schedule, and
+ * doing that for every protected frame dominates small-frame captures.
+ * Consecutive frames almost always come from the same security
+ * association, so keeping the last handle open and only resetting the
+ * per-record state turns the setup into a memcmp on the key.
+ *
+ * The returned handle stays owned by the cache: set the IV and lengths,
+ * decrypt, check the tag, but don't close it.  Like the rest of
+ * dot11decrypt, this is only safe from the (single) dissection thread.
+ */
+static gcry_cipher_hd_t cached_cipher_handle;
+static int cached_cipher_mode;
+static uint8_t cached_cipher_key[32];
+static size_t cached_cipher_key_len;
+
+gcry_cipher_hd_t
+dot11decrypt_cipher_cached(int mode, const uint8_t *key, size_t key_len)
+{
+    if (key_len > sizeof(cached_cipher_key))
+        return NULL;
+
+    if (cached_cipher_handle != NULL && mode == cached_cipher_mode &&
+        key_len == cached_cipher_key_len &&
+        memcmp(key, cached_cipher_key, key_len) == 0) {
+        /* Forget the previous record's IV, AAD and tag state. */
+        gcry_cipher_reset(cached_cipher_handle);
+        return cached_cipher_handle;
+    }
+
+    if (cached_cipher_handle != NULL) {
+        gcry_cipher_close(cached_cipher_handle);
+        cached_cipher_handle = NULL;
+    }
+    if (gcry_cipher_open(&cached_cipher_handle, GCRY_CIPHER_AES, mode, 0)) {
+        cached_cipher_handle = NULL;
+        return NULL;
+    }
+    if (gcry_cipher_setkey(cached_cipher_handle, key, key_len)) {
+        gcry_cipher_close(cached_cipher_handle);
+        cached_cipher_handle = NULL;
+        return NULL;
+    }
+    cached_cipher_mode = mode;
+    cached_cipher_key_len = key_len;
+    memcpy(cached_cipher_key, key, key_len);
+    return cached_cipher_handle;
+}
+
 /*
  * Editor modelines
  *
@@ -57,6 +57,12 @@ dot11decrypt_derive_ft_ptk(const uint8_t *pmk_r1, size_t pmk_r1_len,
                            const uint8_t *bssid, const uint8_t *sta_addr,
                            int hash_algo,
                            uint8_t *ptk, const size_t ptk_len, uint8_t *ptk_name);
+
+/* Return an open AES cipher handle for the given mode and key, reusing
+ * the previous one when they match.  The cache owns the handle; callers
+ * must not close it. */
+gcry_cipher_hd_t
+dot11decrypt_cipher_cached(int mode, const uint8_t *key, size_t key_len);
 #endif /* _DOT11DECRYPT_UTIL_H */
 
 /*
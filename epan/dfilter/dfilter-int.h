@@ -31,13 +31,24 @@ typedef struct {
 	unsigned idx;
 } df_cell_iter_t;
 
+struct dfvm_insn;
+
 /* Passed back to user */
 struct epan_dfilter {
 	GPtrArray	*insns;
+	/* Contiguous copy of insns built after code generation; this is
+	 * what the interpreter walks, to avoid chasing one heap pointer
+	 * per instruction. */
+	struct dfvm_insn *insn_vec;
+	unsigned	insn_vec_len;
 	unsigned	num_registers;
 	df_cell_t	*registers;
 	int		*interesting_fields;
 	int		num_interesting_fields;
+	/* True if the filter cannot match a tree that contains none of
+	 * the interesting fields, so evaluation can return false as soon
+	 * as a presence scan over interesting_fields comes up empty. */
+	bool		skip_when_fields_absent;
 	GPtrArray	*deprecated;
 	GSList		*warnings;
 	char		*expanded_text;
@@ -47,6 +58,9 @@ struct epan_dfilter {
 	/* Used to pass arguments to functions. List of Lists (list of registers). */
 	GSList		*function_stack;
 	GSList		*set_stack;
+	/* Hash tables for large constant sets, indexed by the
+	 * SET_ADD_HASHED instruction argument.  NULL if none. */
+	GPtrArray	*set_hash_tables;
 };
 
 typedef struct {
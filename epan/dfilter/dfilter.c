@@ -176,6 +176,9 @@ dfilter_free(dfilter_t *df)
 	if (df->insns) {
 		free_insns(df->insns);
 	}
+	g_free(df->insn_vec);
+	if (df->set_hash_tables)
+		g_ptr_array_unref(df->set_hash_tables);
 
 	g_free(df->interesting_fields);
 
@@ -491,6 +494,9 @@ dfwork_build(dfwork_t *dfw)
 	dfilter = dfilter_new(dfw->deprecated);
 	dfilter->insns = dfw->insns;
 	dfw->insns = NULL;
+	dfilter->set_hash_tables = dfvm_hash_sets(dfilter->insns);
+	dfilter->insn_vec = dfvm_insn_vector(dfilter->insns,
+						&dfilter->insn_vec_len);
 	dfilter->interesting_fields = dfw_interesting_fields(dfw,
 		&dfilter->num_interesting_fields);
 	dfilter->expanded_text = dfw->expanded_text;
@@ -517,6 +523,18 @@ dfwork_build(dfwork_t *dfw)
 	dfilter->num_registers = dfw->next_register;
 	dfilter->registers = g_new0(df_cell_t, dfilter->num_registers);
 
+	/* Run the filter once against an empty tree.  If the verdict is
+	 * false, a packet in which none of the interesting fields occur
+	 * can never match and dfvm_apply() may skip the bytecode for it
+	 * entirely.  Field references are resolved against a different
+	 * frame than the one being tested, so they void the shortcut. */
+	if (g_hash_table_size(dfilter->references) == 0 &&
+	    g_hash_table_size(dfilter->raw_references) == 0) {
+		proto_tree *empty_tree = proto_tree_create_root(NULL);
+		dfilter->skip_when_fields_absent = !dfvm_apply(dfilter, empty_tree);
+		proto_tree_free(empty_tree);
+	}
+
 	return dfilter;
 }
 
@@ -712,6 +730,13 @@ dfilter_prime_proto_tree(const dfilter_t *df, proto_tree *tree)
 	}
 }
 
+const int *
+dfilter_interesting_fields(const dfilter_t *df, int *num_fields)
+{
+	*num_fields = df->num_interesting_fields;
+	return df->interesting_fields;
+}
+
 bool
 dfilter_has_interesting_fields(const dfilter_t *df)
 {
@@ -772,6 +797,17 @@ dfilter_requires_columns(const dfilter_t *df)
 	return dfilter_interested_in_proto(df, proto_cols);
 }
 
+bool
+dfilter_uses_field_references(const dfilter_t *df)
+{
+	if (df == NULL) {
+		return false;
+	}
+
+	return g_hash_table_size(df->references) > 0 ||
+			g_hash_table_size(df->raw_references) > 0;
+}
+
 GPtrArray *
 dfilter_deprecated_tokens(dfilter_t *df) {
 	if (df->deprecated && df->deprecated->len > 0) {
@@ -149,6 +149,16 @@ dfilter_load_field_references_edt(const dfilter_t *df, struct epan_dissect *edt)
 bool
 dfilter_has_interesting_fields(const dfilter_t *df);
 
+/* Get the fields/protocols used in a dfilter.
+ *
+ * @param df The dfilter
+ * @param num_fields Set to the number of entries in the returned array
+ * @return The header field info IDs the dfilter is interested in; owned
+ * by the dfilter and valid as long as it is
+ */
+const int *
+dfilter_interesting_fields(const dfilter_t *df, int *num_fields);
+
 /* Check if dfilter is interested in a given field
  *
  * @param df The dfilter
@@ -172,6 +182,12 @@ WS_DLL_PUBLIC
 bool
 dfilter_requires_columns(const dfilter_t *df);
 
+/* Check if the filter uses ${...} field references, whose values are
+ * loaded from the selected frame rather than the frame being tested. */
+WS_DLL_PUBLIC
+bool
+dfilter_uses_field_references(const dfilter_t *df);
+
 WS_DLL_PUBLIC
 GPtrArray *
 dfilter_deprecated_tokens(dfilter_t *df);
@@ -56,6 +56,7 @@ dfvm_opcode_tostr(dfvm_opcode_t code)
 		case DFVM_SET_ANY_NOT_IN:	return "SET_ANY_NOT_IN";
 		case DFVM_SET_ADD:		return "SET_ADD";
 		case DFVM_SET_ADD_RANGE:	return "SET_ADD_RANGE";
+		case DFVM_SET_ADD_HASHED:	return "SET_ADD_HASHED";
 		case DFVM_SET_CLEAR:		return "SET_CLEAR";
 		case DFVM_SLICE:		return "SLICE";
 		case DFVM_LENGTH:		return "LENGTH";
@@ -166,6 +167,85 @@ dfvm_insn_free(dfvm_insn_t *insn)
 	g_free(insn);
 }
 
+dfvm_insn_t*
+dfvm_insn_vector(GPtrArray *insns, unsigned *len_ptr)
+{
+	dfvm_insn_t	*vec;
+	unsigned	i;
+
+	vec = g_new(dfvm_insn_t, insns->len);
+	for (i = 0; i < insns->len; i++) {
+		vec[i] = *(dfvm_insn_t *)g_ptr_array_index(insns, i);
+	}
+	*len_ptr = insns->len;
+	return vec;
+}
+
+/* Minimum run of constant singleton members worth a hash table; below
+ * this the linear scan wins on setup cost. */
+#define SET_HASH_MIN_MEMBERS	8
+
+static bool
+set_member_hashable(const dfvm_insn_t *insn)
+{
+	const fvalue_t *fv;
+
+	if (insn->op != DFVM_SET_ADD || insn->arg1->type != FVALUE)
+		return false;
+	fv = dfvm_value_get_fvalue(insn->arg1);
+	return ftype_can_hash(fvalue_type_ftenum(fv));
+}
+
+GPtrArray*
+dfvm_hash_sets(GPtrArray *insns)
+{
+	GPtrArray	*tables = NULL;
+	GHashTable	*table;
+	dfvm_insn_t	*insn;
+	unsigned	i, j, k;
+
+	for (i = 0; i < insns->len; i = j) {
+		/* Find a maximal run of hashable SET_ADD instructions. */
+		j = i;
+		while (j < insns->len &&
+				set_member_hashable(g_ptr_array_index(insns, j))) {
+			j++;
+		}
+		if (j == i) {
+			j = i + 1;
+			continue;
+		}
+		if (j - i < SET_HASH_MIN_MEMBERS)
+			continue;
+
+		/* The table owns duplicates of the member values, so the
+		 * absorbed instructions can drop theirs. */
+		table = g_hash_table_new_full((GHashFunc)fvalue_hash,
+						(GEqualFunc)fvalue_equal,
+						(GDestroyNotify)fvalue_free, NULL);
+		for (k = i; k < j; k++) {
+			insn = g_ptr_array_index(insns, k);
+			g_hash_table_add(table,
+				fvalue_dup(dfvm_value_get_fvalue(insn->arg1)));
+			if (k == i) {
+				dfvm_value_unref(insn->arg1);
+				insn->arg1 = dfvm_value_new_uint(
+						tables ? tables->len : 0);
+				insn->op = DFVM_SET_ADD_HASHED;
+			}
+			else {
+				dfvm_insn_replace_no_op(insn);
+			}
+		}
+		if (tables == NULL) {
+			tables = g_ptr_array_new_with_free_func(
+					(GDestroyNotify)g_hash_table_destroy);
+		}
+		g_ptr_array_add(tables, table);
+	}
+	return tables;
+}
+
 
 dfvm_value_t*
 dfvm_value_new(dfvm_value_type_t type)
@@ -563,6 +643,10 @@ append_op_args(wmem_strbuf_t *buf, dfvm_insn_t *insn, GSList **stack_print,
 						arg1_str, arg1_str_type, arg2_str, arg2_str_type);
 			break;
 
+		case DFVM_SET_ADD_HASHED:
+			wmem_strbuf_append_printf(buf, "set(%s)", arg1_str);
+			break;
+
 		case DFVM_BITWISE_AND:
 			wmem_strbuf_append_printf(buf, "%s%s & %s%s",
 						arg1_str, arg1_str_type, arg2_str, arg2_str_type);
@@ -1066,7 +1150,7 @@ all_test_unary(dfilter_t *df, DFVMTestFunc func, dfvm_value_t *arg1)
 }
 
 static bool
-cmp_test(dfilter_t *df, DFVMCompareFunc cmp,
+cmp_test(dfilter_t *df, DFVMCompareFunc cmp, fvalue_cmp_rel_t rel,
 			dfvm_value_t *arg1, dfvm_value_t *arg2,
 			enum match_how how)
 {
@@ -1092,23 +1176,33 @@ cmp_test(dfilter_t *df, DFVMCompareFunc cmp,
 		ws_assert_not_reached();
 	}
 
+	/* If the values share a type with a direct comparison, use it
+	 * instead of dispatching through the fvalue method table for
+	 * every pair. */
+	if (fv1->len > 0 && fv2->len > 0) {
+		fvalue_cmp_fn spec = fvalue_cmp_specialized(
+			fvalue_type_ftenum(fv2->pdata[0]), rel);
+		if (spec != NULL)
+			cmp = spec;
+	}
+
 	return cmp_test_internal(how, cmp, fv1, fv2);
 }
 
 /* cmp(A) <=> cmp(a1) OR cmp(a2) OR cmp(a3) OR ... */
 static inline bool
-any_test(dfilter_t *df, DFVMCompareFunc cmp,
+any_test(dfilter_t *df, DFVMCompareFunc cmp, fvalue_cmp_rel_t rel,
 				dfvm_value_t *arg1, dfvm_value_t *arg2)
 {
-	return cmp_test(df, cmp, arg1, arg2, MATCH_ANY);
+	return cmp_test(df, cmp, rel, arg1, arg2, MATCH_ANY);
 }
 
 /* cmp(A) <=> cmp(a1) AND cmp(a2) AND cmp(a3) AND ... */
 static bool
-all_test(dfilter_t *df, DFVMCompareFunc cmp,
+all_test(dfilter_t *df, DFVMCompareFunc cmp, fvalue_cmp_rel_t rel,
 				dfvm_value_t *arg1, dfvm_value_t *arg2)
 {
-	return cmp_test(df, cmp, arg1, arg2, MATCH_ALL);
+	return cmp_test(df, cmp, rel, arg1, arg2, MATCH_ALL);
 }
 
 static bool
@@ -1143,13 +1237,37 @@ all_matches(dfilter_t *df, dfvm_value_t *arg1, dfvm_value_t *arg2)
 	return true;
 }
 
+typedef struct {
+	GPtrArray	*low;
+	GPtrArray	*high;		/* Non-NULL for a range member. */
+	GHashTable	*hashed;	/* Hashed constant members, or NULL. */
+} df_set_t;
+
 static bool
-test_in_internal(fvalue_t *fv, GPtrArray *range[2])
+test_in_internal(fvalue_t *fv, df_set_t *set)
 {
-	GPtrArray *low = range[0];
-	GPtrArray *high = range[1];
+	GPtrArray *low = set->low;
+	GPtrArray *high = set->high;
 	bool low_ok = false, high_ok = false;
 
+	if (set->hashed) {
+		if (G_UNLIKELY(!ftype_can_hash(fvalue_type_ftenum(fv)))) {
+			/* Cannot hash the field value; fall back to
+			 * comparing against every member. */
+			GHashTableIter iter;
+			gpointer member;
+
+			g_hash_table_iter_init(&iter, set->hashed);
+			while (g_hash_table_iter_next(&iter, &member, NULL)) {
+				if (fvalue_eq(fv, member) == FT_TRUE) {
+					return true;
+				}
+			}
+			return false;
+		}
+		return g_hash_table_contains(set->hashed, fv);
+	}
+
 	if (high) {
 		/* range */
 		for (unsigned i = 0; i < high->len; i++) {
@@ -1575,18 +1693,18 @@ stack_pop(dfilter_t *df, dfvm_value_t *arg1)
 static void
 set_push(dfilter_t *df, dfvm_value_t *arg1, dfvm_value_t *arg2)
 {
-	GPtrArray **range;
+	df_set_t *set;
 
 	/* We don´t need to use reference counting because the lifetime of each
 	 * arg is guaranteed to outlive the set stack. */
 
-	range = g_new0(GPtrArray *, 2);
+	set = g_new0(df_set_t, 1);
 
 	if (arg1->type == FVALUE) {
-		range[0] = arg1->value.fvalue_p;
+		set->low = arg1->value.fvalue_p;
 	}
 	else if (arg1->type == REGISTER) {
-		range[0] = df_cell_ptr(&df->registers[arg1->value.numeric]);
+		set->low = df_cell_ptr(&df->registers[arg1->value.numeric]);
 	}
 	else {
 		ws_assert_not_reached();
@@ -1594,17 +1712,28 @@ set_push(dfilter_t *df, dfvm_value_t *arg1, dfvm_value_t *arg2)
 
 	if (arg2) {
 		if (arg2->type == FVALUE) {
-			range[1] = arg2->value.fvalue_p;
+			set->high = arg2->value.fvalue_p;
 		}
 		else if (arg2->type == REGISTER) {
-			range[1] = df_cell_ptr(&df->registers[arg2->value.numeric]);
+			set->high = df_cell_ptr(&df->registers[arg2->value.numeric]);
 		}
 		else {
 			ws_assert_not_reached();
 		}
 	}
 
-	df->set_stack = g_slist_prepend(df->set_stack, range);
+	df->set_stack = g_slist_prepend(df->set_stack, set);
+}
+
+static void
+set_push_hashed(dfilter_t *df, dfvm_value_t *arg1)
+{
+	df_set_t *set;
+
+	set = g_new0(df_set_t, 1);
+	set->hashed = g_ptr_array_index(df->set_hash_tables,
+						arg1->value.numeric);
+	df->set_stack = g_slist_prepend(df->set_stack, set);
 }
 
 static void
@@ -1654,19 +1783,38 @@ dfvm_apply_full(dfilter_t *df, proto_tree *tree, GPtrArray **fvals)
 {
 	int		id, length;
 	bool	accum = true;
-	dfvm_insn_t	*insn;
+	const dfvm_insn_t	*insn_vec = df->insn_vec;
+	const dfvm_insn_t	*insn;
 	dfvm_value_t	*arg1;
 	dfvm_value_t	*arg2;
 	dfvm_value_t	*arg3 = NULL;
 
 	ws_assert(tree);
 
-	length = df->insns->len;
+	/* Pre-pass: if the filter cannot match a tree without any of its
+	 * interesting fields, scan for their presence before touching the
+	 * bytecode.  Not done when extracting values, so that *fvals is
+	 * always filled in by the RETURN instruction. */
+	if (df->skip_when_fields_absent && fvals == NULL) {
+		bool any_present = false;
+		for (int i = 0; i < df->num_interesting_fields; i++) {
+			GPtrArray *finfos = proto_get_finfo_ptr_array(tree,
+						df->interesting_fields[i]);
+			if (finfos != NULL && g_ptr_array_len(finfos) > 0) {
+				any_present = true;
+				break;
+			}
+		}
+		if (!any_present)
+			return false;
+	}
+
+	length = df->insn_vec_len;
 
 	for (id = 0; id < length; id++) {
 
 	  AGAIN:
-		insn = g_ptr_array_index(df->insns, id);
+		insn = &insn_vec[id];
 		arg1 = insn->arg1;
 		arg2 = insn->arg2;
 		arg3 = insn->arg3;
@@ -1725,51 +1873,51 @@ dfvm_apply_full(dfilter_t *df, proto_tree *tree, GPtrArray **fvals)
 				break;
 
 			case DFVM_ALL_EQ:
-				accum = all_test(df, fvalue_eq, arg1, arg2);
+				accum = all_test(df, fvalue_eq, FVALUE_CMP_EQ, arg1, arg2);
 				break;
 
 			case DFVM_ANY_EQ:
-				accum = any_test(df, fvalue_eq, arg1, arg2);
+				accum = any_test(df, fvalue_eq, FVALUE_CMP_EQ, arg1, arg2);
 				break;
 
 			case DFVM_ALL_NE:
-				accum = all_test(df, fvalue_ne, arg1, arg2);
+				accum = all_test(df, fvalue_ne, FVALUE_CMP_NE, arg1, arg2);
 				break;
 
 			case DFVM_ANY_NE:
-				accum = any_test(df, fvalue_ne, arg1, arg2);
+				accum = any_test(df, fvalue_ne, FVALUE_CMP_NE, arg1, arg2);
 				break;
 
 			case DFVM_ALL_GT:
-				accum = all_test(df, fvalue_gt, arg1, arg2);
+				accum = all_test(df, fvalue_gt, FVALUE_CMP_GT, arg1, arg2);
 				break;
 
 			case DFVM_ANY_GT:
-				accum = any_test(df, fvalue_gt, arg1, arg2);
+				accum = any_test(df, fvalue_gt, FVALUE_CMP_GT, arg1, arg2);
 				break;
 
 			case DFVM_ALL_GE:
-				accum = all_test(df, fvalue_ge, arg1, arg2);
+				accum = all_test(df, fvalue_ge, FVALUE_CMP_GE, arg1, arg2);
 				break;
 
 			case DFVM_ANY_GE:
-				accum = any_test(df, fvalue_ge, arg1, arg2);
+				accum = any_test(df, fvalue_ge, FVALUE_CMP_GE, arg1, arg2);
 				break;
 
 			case DFVM_ALL_LT:
-				accum = all_test(df, fvalue_lt, arg1, arg2);
+				accum = all_test(df, fvalue_lt, FVALUE_CMP_LT, arg1, arg2);
 				break;
 
 			case DFVM_ANY_LT:
-				accum = any_test(df, fvalue_lt, arg1, arg2);
+				accum = any_test(df, fvalue_lt, FVALUE_CMP_LT, arg1, arg2);
 				break;
 
 			case DFVM_ALL_LE:
-				accum = all_test(df, fvalue_le, arg1, arg2);
+				accum = all_test(df, fvalue_le, FVALUE_CMP_LE, arg1, arg2);
 				break;
 
 			case DFVM_ANY_LE:
-				accum = any_test(df, fvalue_le, arg1, arg2);
+				accum = any_test(df, fvalue_le, FVALUE_CMP_LE, arg1, arg2);
 				break;
 
 			case DFVM_BITWISE_AND:
@@ -1801,11 +1949,11 @@ dfvm_apply_full(dfilter_t *df, proto_tree *tree, GPtrArray **fvals)
 				break;
 
 			case DFVM_ALL_CONTAINS:
-				accum = all_test(df, fvalue_contains, arg1, arg2);
+				accum = all_test(df, fvalue_contains, FVALUE_CMP_NONE, arg1, arg2);
 				break;
 
 			case DFVM_ANY_CONTAINS:
-				accum = any_test(df, fvalue_contains, arg1, arg2);
+				accum = any_test(df, fvalue_contains, FVALUE_CMP_NONE, arg1, arg2);
 				break;
 
 			case DFVM_ALL_MATCHES:
@@ -1824,6 +1972,10 @@ dfvm_apply_full(dfilter_t *df, proto_tree *tree, GPtrArray **fvals)
 				set_push(df, arg1, arg2);
 				break;
 
+			case DFVM_SET_ADD_HASHED:
+				set_push_hashed(df, arg1);
+				break;
+
 			case DFVM_SET_ALL_IN:
 				accum = all_in(df, arg1);
 				break;
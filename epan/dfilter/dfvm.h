@@ -84,6 +84,7 @@ typedef enum {
 	DFVM_SET_ANY_NOT_IN,
 	DFVM_SET_ADD,
 	DFVM_SET_ADD_RANGE,
+	DFVM_SET_ADD_HASHED,
 	DFVM_SET_CLEAR,
 	DFVM_SLICE,
 	DFVM_LENGTH,
@@ -105,7 +106,7 @@ typedef enum {
 const char *
 dfvm_opcode_tostr(dfvm_opcode_t code);
 
-typedef struct {
+typedef struct dfvm_insn {
 	int		id;
 	dfvm_opcode_t	op;
 	dfvm_value_t	*arg1;
@@ -122,6 +123,20 @@ dfvm_insn_replace_no_op(dfvm_insn_t *insn);
 void
 dfvm_insn_free(dfvm_insn_t *insn);
 
+/* Copy the instruction stream into one contiguous array for the
+ * interpreter to execute; the copies share the (refcounted) argument
+ * values with the originals.  Freed with g_free(). */
+dfvm_insn_t*
+dfvm_insn_vector(GPtrArray *insns, unsigned *len_ptr);
+
+/* Replace long runs of SET_ADD instructions with constant singleton
+ * members by a single SET_ADD_HASHED backed by a hash table, so that
+ * membership tests for large sets are O(1) instead of a linear scan.
+ * Returns the tables (indexed by the SET_ADD_HASHED argument), or NULL
+ * if no run was converted.  Freed with g_ptr_array_unref(). */
+GPtrArray*
+dfvm_hash_sets(GPtrArray *insns);
+
 dfvm_value_t*
 dfvm_value_new(dfvm_value_type_t type);
 
@@ -4286,7 +4286,7 @@ proto_register_dcm(void)
             "When not set, the decoding may fail and the exports may become corrupt.",
             &global_dcm_reassemble);
 
-    dicom_eo_tap = register_export_object(proto_dcm, dcm_eo_packet, NULL);
+    dicom_eo_tap = register_export_object_final(proto_dcm, dcm_eo_packet, NULL);
 
     register_init_routine(&dcm_init);
 
@@ -4936,6 +4936,15 @@ dissect_dns_common(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree,
   } else if (is_llmnr) {
     /* TODO */
   } else {
+    // resetting to zero for the next response
+    dns_qr_r_ra_ttl_index = 0;
+    dns_qr_r_ru_ttl_index = 0;
+    dns_qr_r_rd_ttl_index = 0;
+    if (!have_tap_listener(dns_tap)) {
+      /* Building the tap payload re-parses the QNAME and formats
+       * addresses, so don't pay for it when nothing is listening. */
+      return;
+    }
     dns_stats = wmem_new0(pinfo->pool, struct DnsTap);
     dns_stats->packet_rcode = rcode;
     dns_stats->packet_opcode = opcode;
@@ -4983,10 +4992,6 @@ dissect_dns_common(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree,
     else {
       ws_label_strcpy(dns_stats->source, sizeof(dns_stats->source), 0, "n/a",0);
     }
-    // resetting to zero for the next response
-    dns_qr_r_ra_ttl_index = 0;
-    dns_qr_r_ru_ttl_index = 0;
-    dns_qr_r_rd_ttl_index = 0;
     tap_queue_packet(dns_tap, pinfo, dns_stats);
   }
 }
@@ -2260,6 +2260,14 @@ inflate_http2_header_block(tvbuff_t *tvb, packet_info *pinfo, unsigned offset, p
     wmem_strbuf_t* headers_buf = wmem_strbuf_create(pinfo->pool);
     wmem_strbuf_t* header_buf;
 
+    /* The header context only depends on the frame and the session, not on
+     * the individual header lines, so resolve it once for the whole block
+     * instead of repeating the stream info lookups for every line. */
+    uint32_t tracking_stream_id = 0;
+    if (!PINFO_FD_VISITED(pinfo)) {
+        tracking_stream_id = is_in_header_context(tvb, pinfo, h2session);
+    }
+
     for(i = 0; i < wmem_array_get_count(headers); ++i) {
         http2_header_t *in = (http2_header_t*)wmem_array_index(headers, i);
 
@@ -2312,9 +2320,8 @@ inflate_http2_header_block(tvbuff_t *tvb, packet_info *pinfo, unsigned offset, p
          * For PUSH_PROMISE and CONTINUATION frames thereof, add to the promised stream id.
          * Only do it for the first pass in case the current layer changes, altering where the headers frame number,
          * http2_frame_num_t points to. */
-        uint32_t header_stream_id;
-        if (!PINFO_FD_VISITED(pinfo) && (header_stream_id = is_in_header_context(tvb, pinfo, h2session))) {
-            populate_http_header_tracking(tvb, pinfo, h2session, header_value_length, header_name, header_value, header_stream_id, false);
+        if (tracking_stream_id) {
+            populate_http_header_tracking(tvb, pinfo, h2session, header_value_length, header_name, header_value, tracking_stream_id, false);
         }
 
         /* Add encoding representation */
@@ -3288,6 +3295,7 @@ get_real_header_value(packet_info* pinfo, const char* name, bool the_other_direc
     unsigned i;
     uint32_t name_len;
     uint32_t value_len;
+    const uint32_t sought_name_len = (uint32_t)strlen(name);
     http2_header_t *hdr;
     char* data;
 
@@ -3320,7 +3328,7 @@ get_real_header_value(packet_info* pinfo, const char* name, bool the_other_direc
             */
             data = (char*) hdr->table.data.data;
             name_len = pntoh32(data);
-            if (strlen(name) == name_len && strncmp(data + 4, name, name_len) == 0) {
+            if (sought_name_len == name_len && strncmp(data + 4, name, name_len) == 0) {
                 value_len = pntoh32(data + 4 + name_len);
                 if (4 + name_len + 4 + value_len == hdr->table.data.datalen) {
                     /* return value */
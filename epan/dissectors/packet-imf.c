@@ -1376,7 +1376,7 @@ proto_register_imf(void)
     wmem_map_insert(imf_field_table, (void *)f->name, (void *)f);
 
   /* Register for tapping */
-  imf_eo_tap = register_export_object(proto_imf, imf_eo_packet, NULL);
+  imf_eo_tap = register_export_object_final(proto_imf, imf_eo_packet, NULL);
 
 }
 
@@ -747,6 +747,16 @@ before_member(void *tvbparse_data, const void *wanted_data _U_, tvbparse_elem_t
 	proto_tree *subtree;
 	proto_item *ti;
 
+	if (tree == NULL && !json_compact && !json_raw) {
+		/* Neither the protocol tree nor the compact/raw forms are wanted,
+		 * so nobody will look at the key or the path. Keep the stacks
+		 * balanced and skip the string extraction. */
+		wmem_stack_push(data->stack, NULL);
+		wmem_stack_push(data->stack_path, NULL);
+		wmem_stack_push(data->stack_path, NULL);
+		return;
+	}
+
 	const char* key_string_without_quotation_marks = get_json_string(data->pinfo->pool, tok->sub, true);
 
 	ti = proto_tree_add_string(tree, hf_json_member, tok->tvb, tok->offset, tok->len, key_string_without_quotation_marks);
@@ -819,16 +829,16 @@ after_member(void *tvbparse_data, const void *wanted_data _U_, tvbparse_elem_t *
 	proto_tree *tree = (proto_tree *)wmem_stack_pop(data->stack);
 
 	tvbparse_elem_t* key_tok = tok->sub;
-	if (tree && key_tok && key_tok->id == JSON_TOKEN_STRING) {
 
-		const char* key_string_without_quotation_marks = get_json_string(data->pinfo->pool, key_tok, true);
+	// extended path based filtering
+	/* the key pushed by before_member() is the same string that would be
+	 * extracted from key_tok here, so reuse it instead of unescaping again */
+	char* key_string_without_quotation_marks = (char*)wmem_stack_pop(data->stack_path); // Pop key
+	char* path = (char*)wmem_stack_pop(data->stack_path);
 
+	if (tree && key_tok && key_tok->id == JSON_TOKEN_STRING) {
 		proto_tree_add_string(tree, hf_json_key, key_tok->tvb, key_tok->offset, key_tok->len, key_string_without_quotation_marks);
 	}
-
-	// extended path based filtering
-	wmem_stack_pop(data->stack_path); // Pop key
-	char* path = (char*)wmem_stack_pop(data->stack_path);
 	if (tree)
 	{
 		proto_item* path_item = proto_tree_add_string(tree, hf_json_path, tok->tvb, tok->offset, tok->len, path);
@@ -877,7 +887,10 @@ before_array(void *tvbparse_data, const void *wanted_data _U_, tvbparse_elem_t *
 	wmem_stack_push(data->stack_path, "[]");
 
 	// Try key_lookup
-	json_key_lookup(tree, tok, last_key_string, data->pinfo, false);
+	/* the key can be NULL if before_member() skipped building it */
+	if (last_key_string) {
+		json_key_lookup(tree, tok, last_key_string, data->pinfo, false);
+	}
 
 	if (json_compact) {
 		proto_tree* tree_compact = (proto_tree*)wmem_stack_peek(data->stack_compact);
@@ -984,6 +997,13 @@ after_value(void *tvbparse_data, const void *wanted_data _U_, tvbparse_elem_t *t
 	char* key_string = (char*)wmem_stack_pop(data->stack_path);
 	char* path = (char*)wmem_stack_pop(data->stack_path);
 
+	wmem_stack_push(data->stack_path, path);
+	wmem_stack_push(data->stack_path, key_string);
+
+	/* Everything below only produces protocol tree items, so skip the value
+	 * extraction and path formatting entirely when no tree is being built.
+	 * This is where most of the time dissecting large JSON bodies goes. */
+	if (tree) {
 	const char* value_str = NULL;
 	if (value_id == JSON_TOKEN_STRING && tok->len >= 2)
 	{
@@ -1008,9 +1028,6 @@ after_value(void *tvbparse_data, const void *wanted_data _U_, tvbparse_elem_t *t
 		proto_item_set_hidden(member_with_value_item);
 	}
 
-	wmem_stack_push(data->stack_path, path);
-	wmem_stack_push(data->stack_path, key_string);
-
 	switch (value_id) {
 		case JSON_TOKEN_STRING:
 			if (tok->len >= 2) {
@@ -1057,6 +1074,7 @@ after_value(void *tvbparse_data, const void *wanted_data _U_, tvbparse_elem_t *t
 			proto_tree_add_format_text(tree, tok->tvb, tok->offset, tok->len);
 			break;
 	}
+	}
 
 	if (json_compact) {
 		proto_tree *tree_compact = (proto_tree *)wmem_stack_peek(data->stack_compact);
@@ -778,6 +778,25 @@ static const value_string election_types[] = {
  * by default */
 static bool kafka_show_string_bytes_lengths;
 
+/* Whether to decompress message payloads. Running gzip/snappy/lz4/zstd over
+ * every record batch dominates load time of Produce/Fetch heavy captures, so
+ * allow turning it off when only the protocol exchange is of interest */
+static bool kafka_decompress_payloads = true;
+
+/* Decompressed record batch, cached per frame so that revisiting the packet
+ * (second pass, clicking in the packet list, re-filtering) doesn't run the
+ * codec again. The compressed payload is identified by its offset from the
+ * beginning of the frame data; the compressed length and codec are kept as
+ * a consistency check */
+typedef struct _kafka_decompressed_batch_t {
+    struct _kafka_decompressed_batch_t *next;
+    int         raw_offset;
+    uint32_t    compressed_length;
+    int         codec;
+    uint8_t    *plaintext;
+    unsigned    plaintext_length;
+} kafka_decompressed_batch_t;
+
 typedef struct _kafka_query_response_t {
     kafka_api_key_t     api_key;
     kafka_api_version_t api_version;
@@ -1967,6 +1986,10 @@ decompress_zstd(tvbuff_t *tvb _U_, packet_info *pinfo, int offset _U_, uint32_t
 static bool
 decompress(tvbuff_t *tvb, packet_info *pinfo, int offset, uint32_t length, int codec, tvbuff_t **decompressed_tvb, int *decompressed_offset)
 {
+    kafka_decompressed_batch_t *cached, *head;
+    int  raw_offset;
+    bool rc;
+
     if (length > MAX_DECOMPRESSION_SIZE) {
         expert_add_info(pinfo, NULL, &ei_kafka_bad_decompression_length);
         return false;
@@ -1975,21 +1998,74 @@ decompress(tvbuff_t *tvb, packet_info *pinfo, int offset, uint32_t length, int c
         expert_add_info(pinfo, NULL, &ei_kafka_zero_decompression_length);
         return false;
     }
+
+    if (codec == KAFKA_MESSAGE_CODEC_NONE) {
+        return decompress_none(tvb, pinfo, offset, length, decompressed_tvb, decompressed_offset);
+    }
+
+    if (!kafka_decompress_payloads) {
+        col_append_str(pinfo->cinfo, COL_INFO, " [kafka decompression disabled]");
+        return false;
+    }
+
+    /*
+     * The decompressed payload depends only on the captured bytes, so once a
+     * batch has been inflated its plaintext can be reused on every further
+     * visit to the frame instead of running the codec again.
+     */
+    raw_offset = tvb_raw_offset(tvb) + offset;
+    head = (kafka_decompressed_batch_t *)p_get_proto_data(wmem_file_scope(), pinfo, proto_kafka, 0);
+    for (cached = head; cached; cached = cached->next) {
+        if (cached->raw_offset == raw_offset &&
+            cached->compressed_length == length &&
+            cached->codec == codec) {
+            *decompressed_tvb = tvb_new_child_real_data(tvb, cached->plaintext,
+                                                        cached->plaintext_length,
+                                                        cached->plaintext_length);
+            *decompressed_offset = 0;
+            return true;
+        }
+    }
+
     switch (codec) {
         case KAFKA_MESSAGE_CODEC_SNAPPY:
-            return decompress_snappy(tvb, pinfo, offset, length, decompressed_tvb, decompressed_offset);
+            rc = decompress_snappy(tvb, pinfo, offset, length, decompressed_tvb, decompressed_offset);
+            break;
         case KAFKA_MESSAGE_CODEC_LZ4:
-            return decompress_lz4(tvb, pinfo, offset, length, decompressed_tvb, decompressed_offset);
+            rc = decompress_lz4(tvb, pinfo, offset, length, decompressed_tvb, decompressed_offset);
+            break;
         case KAFKA_MESSAGE_CODEC_ZSTD:
-            return decompress_zstd(tvb, pinfo, offset, length, decompressed_tvb, decompressed_offset);
+            rc = decompress_zstd(tvb, pinfo, offset, length, decompressed_tvb, decompressed_offset);
+            break;
         case KAFKA_MESSAGE_CODEC_GZIP:
-            return decompress_gzip(tvb, pinfo, offset, length, decompressed_tvb, decompressed_offset);
-        case KAFKA_MESSAGE_CODEC_NONE:
-            return decompress_none(tvb, pinfo, offset, length, decompressed_tvb, decompressed_offset);
+            rc = decompress_gzip(tvb, pinfo, offset, length, decompressed_tvb, decompressed_offset);
+            break;
         default:
             col_append_str(pinfo->cinfo, COL_INFO, " [unsupported compression type]");
             return false;
     }
+
+    if (rc) {
+        cached = wmem_new(wmem_file_scope(), kafka_decompressed_batch_t);
+        cached->next = NULL;
+        cached->raw_offset = raw_offset;
+        cached->compressed_length = length;
+        cached->codec = codec;
+        cached->plaintext_length = tvb_captured_length_remaining(*decompressed_tvb, *decompressed_offset);
+        cached->plaintext = (uint8_t *)tvb_memdup(wmem_file_scope(), *decompressed_tvb,
+                                                  *decompressed_offset, cached->plaintext_length);
+        if (head) {
+            kafka_decompressed_batch_t *tail = head;
+            while (tail->next) {
+                tail = tail->next;
+            }
+            tail->next = cached;
+        } else {
+            p_add_proto_data(wmem_file_scope(), pinfo, proto_kafka, 0, cached);
+        }
+    }
+
+    return rc;
 }
 
 /*
@@ -11263,6 +11339,12 @@ proto_register_kafka_preferences(const int proto)
                                    "Show length for string and bytes fields in the protocol tree",
                                    "",
                                    &kafka_show_string_bytes_lengths);
+    prefs_register_bool_preference(kafka_module, "decompress_payloads",
+                                   "Decompress message payloads",
+                                   "Decompress gzip/snappy/lz4/zstd compressed record batches. "
+                                   "Disabling this considerably speeds up loading of captures with "
+                                   "large payloads when only the protocol exchange is of interest.",
+                                   &kafka_decompress_payloads);
 }
 
 
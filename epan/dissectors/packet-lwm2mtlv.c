@@ -313,6 +313,7 @@ static lwm2m_allocated_fields_t oma_allocated_fields;
 static lwm2m_allocated_fields_t uat_allocated_fields;
 
 /* LwM2M Objects defined by User */
+static uat_t *lwm2m_object_name_uat;
 static lwm2m_object_name_t *lwm2m_uat_object_names;
 static unsigned num_lwm2m_uat_object_names;
 static lwm2m_resource_t *lwm2m_uat_resources;
@@ -355,6 +356,13 @@ static void lwm2m_object_name_free_cb(void *record)
 	g_free(rec->name);
 }
 
+static char *lwm2m_object_name_key_cb(const void *record)
+{
+	const lwm2m_object_name_t *rec = (const lwm2m_object_name_t *)record;
+
+	return ws_strdup_printf("%u", rec->object_id);
+}
+
 UAT_DEC_CB_DEF(object_name, object_id, lwm2m_object_name_t)
 UAT_CSTRING_CB_DEF(object_name, name, lwm2m_object_name_t)
 
@@ -974,12 +982,13 @@ dissect_lwm2mtlv(tvbuff_t *tvb, packet_info *pinfo, proto_tree *tree, void *data
 
 		if (object_id != -1) {
 			const char *object_name = NULL;
+			char object_key[16];
+			lwm2m_object_name_t *object_rec;
 
-			for (unsigned i = 0; i < num_lwm2m_uat_object_names; i++) {
-				if ((unsigned)object_id == lwm2m_uat_object_names[i].object_id) {
-					object_name = lwm2m_uat_object_names[i].name;
-					break;
-				}
+			snprintf(object_key, sizeof(object_key), "%d", object_id);
+			object_rec = (lwm2m_object_name_t *)uat_lookup(lwm2m_object_name_uat, object_key);
+			if (object_rec) {
+				object_name = object_rec->name;
 			}
 
 			if (!object_name) {
@@ -1142,20 +1151,21 @@ void proto_register_lwm2mtlv(void)
 		UAT_END_FIELDS
 	};
 
-	uat_t *object_name_uat = uat_new("User Object Names",
-	                                 sizeof(lwm2m_object_name_t),
-	                                 "lwm2m_object_names",
-	                                 true,
-	                                 &lwm2m_uat_object_names,
-	                                 &num_lwm2m_uat_object_names,
-	                                 UAT_AFFECTS_DISSECTION,
-	                                 "ChLwM2MResourceNames",
-	                                 lwm2m_object_name_copy_cb,
-	                                 lwm2m_object_name_update_cb,
-	                                 lwm2m_object_name_free_cb,
-	                                 NULL,
-	                                 NULL,
-	                                 lwm2m_object_name_flds);
+	lwm2m_object_name_uat = uat_new("User Object Names",
+	                                sizeof(lwm2m_object_name_t),
+	                                "lwm2m_object_names",
+	                                true,
+	                                &lwm2m_uat_object_names,
+	                                &num_lwm2m_uat_object_names,
+	                                UAT_AFFECTS_DISSECTION,
+	                                "ChLwM2MResourceNames",
+	                                lwm2m_object_name_copy_cb,
+	                                lwm2m_object_name_update_cb,
+	                                lwm2m_object_name_free_cb,
+	                                NULL,
+	                                NULL,
+	                                lwm2m_object_name_flds);
+	uat_set_lookup_key_cb(lwm2m_object_name_uat, lwm2m_object_name_key_cb);
 
 	uat_t *resource_uat = uat_new("User Resource Names",
 	                              sizeof(lwm2m_resource_t),
@@ -1190,7 +1200,7 @@ void proto_register_lwm2mtlv(void)
 	prefs_register_uat_preference(lwm2mtlv_module, "object_table",
 	                              "Object Names",
 	                              "User Object Names",
-	                              object_name_uat);
+	                              lwm2m_object_name_uat);
 
 	prefs_register_uat_preference(lwm2mtlv_module, "resource_table",
 	                              "Resource Names",
@@ -184,6 +184,20 @@ static GHashTable *pbf_hf_hash;
  */
 static dissector_table_t protobuf_field_subdissector_table;
 
+/* Dissection info of a field that is expensive to look up by full name,
+ * resolved once per field descriptor and reused for every later occurrence
+ * of the field. Without this, dissecting a capture full of identical message
+ * types repeats the name based hash lookups for every single value. The
+ * cache is flushed whenever the descriptor pool or the dynamic header
+ * fields are rebuilt */
+typedef struct {
+    int* hf_id_ptr;                     /* entry of pbf_hf_hash, NULL if none */
+    dissector_handle_t field_dissector; /* subdissector registered for this field, NULL if none */
+} pbf_field_resolution_t;
+
+/* the key is a PbwFieldDescriptor pointer, the value is pbf_field_resolution_t */
+static GHashTable *pbf_field_resolutions;
+
 static dissector_handle_t protobuf_handle;
 
 /* store varint tvb info */
@@ -585,6 +599,32 @@ abs_time_to_rfc3339(wmem_allocator_t *scope, const nstime_t *nstime, bool use_ut
     return wmem_strdup_printf(scope, datetime_format, nsecs_buf);
 }
 
+/* Get the resolved dissection info of a field, creating it on first use. */
+static const pbf_field_resolution_t*
+resolve_pbf_field(const PbwFieldDescriptor* field_desc)
+{
+    pbf_field_resolution_t* res;
+    const char* field_full_name;
+
+    if (pbf_field_resolutions == NULL) {
+        pbf_field_resolutions = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+    }
+
+    res = (pbf_field_resolution_t*)g_hash_table_lookup(pbf_field_resolutions, field_desc);
+    if (res == NULL) {
+        res = g_new0(pbf_field_resolution_t, 1);
+        field_full_name = pbw_FieldDescriptor_full_name(field_desc);
+        if (field_full_name) {
+            res->field_dissector = dissector_get_string_handle(protobuf_field_subdissector_table, field_full_name);
+            if (pbf_as_hf) {
+                res->hf_id_ptr = (int*)g_hash_table_lookup(pbf_hf_hash, field_full_name);
+            }
+        }
+        g_hash_table_insert(pbf_field_resolutions, (void*)field_desc, res);
+    }
+    return res;
+}
+
 /* Dissect field value based on a specific type. */
 static void
 // NOLINTNEXTLINE(misc-no-recursion)
@@ -604,14 +644,15 @@ protobuf_dissect_field_value(proto_tree *value_tree, tvbuff_t *tvb, unsigned off
     const PbwDescriptor* sub_message_desc = NULL;
     const PbwEnumDescriptor* enum_desc = NULL;
     int* hf_id_ptr = NULL;
+    const pbf_field_resolution_t* field_res = field_desc ? resolve_pbf_field(field_desc) : NULL;
     const char* field_full_name = field_desc ? pbw_FieldDescriptor_full_name(field_desc) : NULL;
     proto_tree* field_tree = proto_item_get_subtree(ti_field);
     proto_tree* field_parent_tree = proto_tree_get_parent_tree(field_tree);
     proto_tree* pbf_tree = field_tree;
-    dissector_handle_t field_dissector = field_full_name ? dissector_get_string_handle(protobuf_field_subdissector_table, field_full_name) : NULL;
+    dissector_handle_t field_dissector = field_res ? field_res->field_dissector : NULL;
 
     if (pbf_as_hf && field_full_name) {
-        hf_id_ptr = (int*)g_hash_table_lookup(pbf_hf_hash, field_full_name);
+        hf_id_ptr = field_res->hf_id_ptr;
         DISSECTOR_ASSERT_HINT(hf_id_ptr && (*hf_id_ptr) > 0, "hf must have been initialized properly");
     }
 
@@ -1236,7 +1277,7 @@ add_missing_fields_with_default_values(tvbuff_t* tvb, unsigned offset, packet_in
 
         hf_id_ptr = NULL;
         if (pbf_as_hf && field_full_name) {
-            hf_id_ptr = (int*)g_hash_table_lookup(pbf_hf_hash, field_full_name);
+            hf_id_ptr = resolve_pbf_field(field_desc)->hf_id_ptr;
             DISSECTOR_ASSERT_HINT(hf_id_ptr && (*hf_id_ptr) > 0, "hf must have been initialized properly");
         }
 
@@ -1943,6 +1984,13 @@ deregister_header_fields(void)
         g_hash_table_destroy(pbf_hf_hash);
         pbf_hf_hash = NULL;
     }
+
+    /* cached per-field resolutions hold pointers into the descriptor pool
+     * and pbf_hf_hash, so they must not survive a reload of either */
+    if (pbf_field_resolutions) {
+        g_hash_table_destroy(pbf_field_resolutions);
+        pbf_field_resolutions = NULL;
+    }
 }
 
 /* convert the names of the enum's values to value_string array */
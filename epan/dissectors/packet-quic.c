@@ -434,6 +434,7 @@ struct quic_info_data {
     wmem_map_t     *client_streams; /**< Map from Stream ID -> STREAM info (uint64_t -> quic_stream_state), sent by the client. */
     wmem_map_t     *server_streams; /**< Map from Stream ID -> STREAM info (uint64_t -> quic_stream_state), sent by the server. */
     wmem_list_t    *streams_list;   /**< Ordered list of QUIC Stream ID in this connection (both directions). Used by "Follow QUIC Stream" functionality */
+    wmem_map_t     *streams_seen;   /**< Set of Stream IDs already on streams_list, to keep the per-frame duplicate check cheap. */
     wmem_map_t     *streams_map;    /**< Map pinfo->num --> First stream in that frame (unsigned -> quic_follow_stream). Used by "Follow QUIC Stream" functionality */
     wmem_map_t     *client_crypto;
     wmem_map_t     *server_crypto;
@@ -4725,12 +4726,18 @@ quic_cleanup(void)
 static void
 quic_streams_add(packet_info *pinfo, quic_info_data_t *quic_info, uint64_t stream_id)
 {
-    /* List: ordered list of Stream IDs in this connection */
+    /* List: ordered list of Stream IDs in this connection
+     * This runs for every STREAM frame on the first pass, so test
+     * membership against a set instead of walking the list, and append
+     * through the sorted-append fast path (new Stream IDs are almost
+     * always the largest seen so far). */
     if (!quic_info->streams_list) {
         quic_info->streams_list = wmem_list_new(wmem_file_scope());
+        quic_info->streams_seen = wmem_map_new(wmem_file_scope(), g_direct_hash, g_direct_equal);
     }
-    if (!wmem_list_find(quic_info->streams_list, GUINT_TO_POINTER(stream_id))) {
-        wmem_list_insert_sorted(quic_info->streams_list, GUINT_TO_POINTER(stream_id),
+    if (!wmem_map_contains(quic_info->streams_seen, GUINT_TO_POINTER(stream_id))) {
+        wmem_map_insert(quic_info->streams_seen, GUINT_TO_POINTER(stream_id), GUINT_TO_POINTER(1));
+        wmem_list_append_sorted(quic_info->streams_list, GUINT_TO_POINTER(stream_id),
                                 wmem_compare_uint);
     }
 
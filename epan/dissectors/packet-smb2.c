@@ -6683,6 +6683,19 @@ dissect_file_data_smb2_pipe(tvbuff_t *raw_tvb, packet_info *pinfo, proto_tree *t
 	 */
 	const smb2_info_t *si = (const smb2_info_t *)data;
 	bool result=false;
+
+	/*
+	 * Bulk file I/O fast path: named pipes only exist on IPC$ shares, so
+	 * when the file belongs to a tree known to be a disk or printer share
+	 * there is no point in running the pipe heuristics, the reassembly
+	 * machinery and the data dissector over the payload. The caller will
+	 * just register the data bytes as a single item.
+	 */
+	if (si != NULL && si->tree != NULL &&
+	    (si->tree->share_type == SMB2_SHARE_TYPE_DISK ||
+	     si->tree->share_type == SMB2_SHARE_TYPE_PRINT)) {
+		return offset;
+	}
 	bool save_fragmented;
 	int remaining;
 	unsigned reported_len;
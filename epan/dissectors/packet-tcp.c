@@ -2767,6 +2767,21 @@ finished_checking_retransmission_type:
             nextseq+=1;
         }
         ual->nextseq=nextseq;
+
+        /* Maintain the cached sequence bounds of the list so the
+         * bytes-in-flight calculation below doesn't have to rescan it.
+         */
+        if(ual->next==NULL) {
+            tcpd->fwd->tcp_analyze_seq_info->min_unacked_seq=ual->seq;
+            tcpd->fwd->tcp_analyze_seq_info->max_unacked_nextseq=ual->nextseq;
+        } else {
+            if( (ual->seq-tcpd->fwd->base_seq) < (tcpd->fwd->tcp_analyze_seq_info->min_unacked_seq-tcpd->fwd->base_seq) ) {
+                tcpd->fwd->tcp_analyze_seq_info->min_unacked_seq=ual->seq;
+            }
+            if( (ual->nextseq-tcpd->fwd->base_seq) > (tcpd->fwd->tcp_analyze_seq_info->max_unacked_nextseq-tcpd->fwd->base_seq) ) {
+                tcpd->fwd->tcp_analyze_seq_info->max_unacked_nextseq=ual->nextseq;
+            }
+        }
     }
 
     /* Every time we are moving the highest number seen,
@@ -2864,7 +2879,11 @@ finished_checking_retransmission_type:
 
 
     /* remove all segments this ACKs and we don't need to keep around any more
+     * The walk already visits every list entry, so refresh the cached
+     * sequence bounds of the surviving entries along the way.
      */
+    uint32_t keep_min_seq = 0, keep_max_nextseq = 0;
+    bool keep_seen = false;
     prevual = NULL;
     ual = tcpd->rev->tcp_analyze_seq_info->segments;
     while(ual) {
@@ -2905,6 +2924,18 @@ finished_checking_retransmission_type:
         }
         /* If this acknowledges a segment prior to this one, leave this segment alone and move on */
         else if (GT_SEQ(ual->nextseq,ack)) {
+            if(!keep_seen) {
+                keep_min_seq = ual->seq;
+                keep_max_nextseq = ual->nextseq;
+                keep_seen = true;
+            } else {
+                if( (ual->seq-tcpd->rev->base_seq) < (keep_min_seq-tcpd->rev->base_seq) ) {
+                    keep_min_seq = ual->seq;
+                }
+                if( (ual->nextseq-tcpd->rev->base_seq) > (keep_max_nextseq-tcpd->rev->base_seq) ) {
+                    keep_max_nextseq = ual->nextseq;
+                }
+            }
             prevual = ual;
             ual = ual->next;
             continue;
@@ -2930,6 +2961,10 @@ finished_checking_retransmission_type:
         ual = tmpual;
         tcpd->rev->tcp_analyze_seq_info->segment_count--;
     }
+    if(keep_seen) {
+        tcpd->rev->tcp_analyze_seq_info->min_unacked_seq = keep_min_seq;
+        tcpd->rev->tcp_analyze_seq_info->max_unacked_nextseq = keep_max_nextseq;
+    }
 
     /* how many bytes of data are there in flight after this frame
      * was sent
@@ -2958,17 +2993,12 @@ finished_checking_retransmission_type:
 
                 dry_bif_handling = true;
 
-                first_seq = ual->seq - tcpd->fwd->base_seq;
-                last_seq = ual->nextseq - tcpd->fwd->base_seq;
-                while (ual) {
-                    if ((ual->nextseq-tcpd->fwd->base_seq)>last_seq) {
-                        last_seq = ual->nextseq-tcpd->fwd->base_seq;
-                    }
-                    if ((ual->seq-tcpd->fwd->base_seq)<first_seq) {
-                        first_seq = ual->seq-tcpd->fwd->base_seq;
-                    }
-                    ual = ual->next;
-                }
+                /* the sequence bounds of the list are maintained on every
+                 * insertion and ACK removal, saving a walk of up to
+                 * TCP_MAX_UNACKED_SEGMENTS entries for each data segment.
+                 */
+                first_seq = tcpd->fwd->tcp_analyze_seq_info->min_unacked_seq - tcpd->fwd->base_seq;
+                last_seq = tcpd->fwd->tcp_analyze_seq_info->max_unacked_nextseq - tcpd->fwd->base_seq;
                 in_flight = last_seq-first_seq;
             }
         } else { /* calculation based on SEQ numbers (see issue 7703) */
@@ -4481,14 +4511,23 @@ again:
              * list of unused out of order segments. Since we know the gap will
              * never be filled, we could pass it to the subdissector, but
              * we want to be consistent between passes.
+             *
+             * The list is sorted on (seq, frame), so we can stop looking as
+             * soon as we have passed the place where this segment would be,
+             * instead of scanning the whole leftover list for every visited
+             * segment on later passes.
              */
-            ooo_segment_item *fd;
-            fd = wmem_new0(pinfo->pool, ooo_segment_item);
-            fd->frame = pinfo->num;
-            fd->seq = seq;
-            fd->len = nxtseq - seq;
-            if (wmem_list_find_custom(tcpd->fwd->ooo_segments, fd, compare_ooo_segment_item)) {
-                has_gap = true;
+            wmem_list_frame_t *curr_entry;
+            for (curr_entry = wmem_list_head(tcpd->fwd->ooo_segments);
+                 curr_entry; curr_entry = wmem_list_frame_next(curr_entry)) {
+                const ooo_segment_item *fd = (const ooo_segment_item *)wmem_list_frame_data(curr_entry);
+                if (GT_SEQ(fd->seq, seq) || (fd->seq == seq && fd->frame > pinfo->num)) {
+                    break;
+                }
+                if (fd->seq == seq && fd->frame == pinfo->num) {
+                    has_gap = true;
+                    break;
+                }
             }
         }
     }
@@ -306,6 +306,13 @@ typedef enum {
 typedef struct tcp_analyze_seq_flow_info_t {
 	tcp_unacked_t *segments;/* List of segments for which we haven't seen an ACK */
 	uint16_t segment_count;	/* How many unacked segments we're currently storing */
+	uint32_t min_unacked_seq;/* Smallest seq on the segments list, under relative
+				 * sequence comparison. Maintained on every insertion
+				 * and ACK removal so the bytes-in-flight calculation
+				 * doesn't have to rescan the list. Only meaningful
+				 * while 'segments' is non-NULL */
+	uint32_t max_unacked_nextseq;/* Largest nextseq on the segments list, under
+				 * relative sequence comparison. See min_unacked_seq */
 	uint32_t lastack;	/* Last seen ack for the reverse flow */
 	nstime_t lastacktime;	/* Time of the last ack packet */
 	uint32_t lastnondupack;	/* frame number of last seen non dupack */
@@ -1136,7 +1136,7 @@ proto_register_tftp(void)
     "Whether fragmented TFTP files should be reassembled", &tftp_defragment);
 
   /* Register the tap for the "Export Object" function */
-  tftp_eo_tap = register_export_object(proto_tftp, tftp_eo_packet, NULL);
+  tftp_eo_tap = register_export_object_final(proto_tftp, tftp_eo_packet, NULL);
 }
 
 void
@@ -6121,7 +6121,7 @@ tls_add_packet_info(int proto, packet_info *pinfo, uint8_t curr_layer_num_ssl)
 void
 ssl_add_record_info(int proto, packet_info *pinfo, const unsigned char *data, int data_len, int record_id, SslFlow *flow, ContentType type, uint8_t curr_layer_num_ssl)
 {
-    SslRecordInfo* rec, **prec;
+    SslRecordInfo* rec;
     SslPacketInfo *pi = tls_add_packet_info(proto, pinfo, curr_layer_num_ssl);
 
     rec = wmem_new(wmem_file_scope(), SslRecordInfo);
@@ -6139,10 +6139,15 @@ ssl_add_record_info(int proto, packet_info *pinfo, const unsigned char *data, in
                          G_STRFUNC, rec->seq, rec->seq + data_len, (void*)flow);
     }
 
-    /* Remember decrypted records. */
-    prec = &pi->records;
-    while (*prec) prec = &(*prec)->next;
-    *prec = rec;
+    /* Remember decrypted records. A frame can carry a lot of coalesced
+     * records, so append through the tail pointer instead of walking the
+     * whole list for each record. */
+    if (pi->records_tail) {
+        pi->records_tail->next = rec;
+    } else {
+        pi->records = rec;
+    }
+    pi->records_tail = rec;
 }
 
 /* search in packet data for the specified id; return a newly created tvb for the associated data */
@@ -6191,10 +6196,15 @@ ssl_common_init(ssl_master_key_map_t *mk_map,
     ssl_data_alloc(compressed_data, 32);
 }
 
+static void tls_keylog_index_forget_tables(const ssl_master_key_map_t *mk_map);
+
 void
 ssl_common_cleanup(ssl_master_key_map_t *mk_map, FILE **ssl_keylog_file,
                    StringInfo *decrypted_data, StringInfo *compressed_data)
 {
+    /* The tables are going away; drop their keylog index associations. */
+    tls_keylog_index_forget_tables(mk_map);
+
     g_hash_table_destroy(mk_map->session);
     g_hash_table_destroy(mk_map->tickets);
     g_hash_table_destroy(mk_map->crandom);
@@ -6350,6 +6360,73 @@ ssl_save_master_key(const char *label, GHashTable *ht, StringInfo *key,
     ssl_print_string("stored (pre-)master secret", master_secret);
 }
 
+/* Compiled keylog index. {{{
+ *
+ * Very large key log files (fleet-wide SSLKEYLOGFILE collection easily
+ * exceeds a million lines) are compiled once into an on-disk hash index
+ * (see epan/secrets.h) stored next to the key log, then mapped read-only.
+ * Opening a capture no longer replays the whole key log and concurrent
+ * tshark processes share the mapped pages. Secrets are pulled out of the
+ * index on demand when a master key table lookup misses.
+ */
+
+/* Tags naming the master key tables within a compiled index. The values are
+ * part of the on-disk format, so only append to this list. The order matches
+ * tls_keylog_index_groups[] below. */
+enum {
+    TLS_KEYLOG_TAG_PRE_MASTER,
+    TLS_KEYLOG_TAG_SESSION,
+    TLS_KEYLOG_TAG_CRANDOM,
+    TLS_KEYLOG_TAG_PMS,
+    TLS_KEYLOG_TAG_CLIENT_EARLY,
+    TLS_KEYLOG_TAG_CLIENT_HANDSHAKE,
+    TLS_KEYLOG_TAG_SERVER_HANDSHAKE,
+    TLS_KEYLOG_TAG_CLIENT_APPDATA,
+    TLS_KEYLOG_TAG_SERVER_APPDATA,
+    TLS_KEYLOG_TAG_EARLY_EXPORTER,
+    TLS_KEYLOG_TAG_EXPORTER,
+};
+
+/* Key log files at least this large get a compiled ".index" sidecar; smaller
+ * ones are parsed line by line as before. */
+#define TLS_KEYLOG_INDEX_MIN_SIZE   (4 * 1024 * 1024)
+
+static secrets_index_t *tls_keylog_index;
+/** Key log path the open index was compiled from. */
+static char *tls_keylog_index_source;
+/** Maps a master key table (GHashTable*) to its index tag plus one. */
+static GHashTable *tls_keylog_index_tags;
+
+/** Looks up a secret in the compiled keylog index after a master key table
+ * miss. A hit is copied into the table so that repeated restores for the
+ * same session hit the table directly. */
+static StringInfo *
+tls_keylog_index_lookup(GHashTable *ht, StringInfo *key)
+{
+    const uint8_t *value;
+    unsigned value_len;
+    void *tag;
+    StringInfo value_si;
+    StringInfo *secret;
+
+    if (!tls_keylog_index || !tls_keylog_index_tags)
+        return NULL;
+    tag = g_hash_table_lookup(tls_keylog_index_tags, ht);
+    if (!tag)
+        return NULL;
+    if (!secrets_index_lookup(tls_keylog_index,
+                              (uint8_t)(GPOINTER_TO_UINT(tag) - 1),
+                              key->data, key->data_len, &value, &value_len))
+        return NULL;
+
+    value_si.data = (unsigned char *)value;
+    value_si.data_len = value_len;
+    secret = ssl_data_clone(&value_si);
+    g_hash_table_insert(ht, ssl_data_clone(key), secret);
+    return secret;
+}
+/* Compiled keylog index. }}} */
+
 /** restore a (pre-)master secret given some key in the cache */
 static bool
 ssl_restore_master_key(SslDecryptSession *ssl, const char *label,
@@ -6364,6 +6441,9 @@ ssl_restore_master_key(SslDecryptSession *ssl, const char *label,
     }
 
     ms = (StringInfo *)g_hash_table_lookup(ht, key);
+    if (!ms) {
+        ms = tls_keylog_index_lookup(ht, key);
+    }
     if (!ms) {
         ssl_debug_printf("%s can't find %smaster secret by %s\n", G_STRFUNC,
                          is_pre_master ? "pre-" : "", label);
@@ -6504,6 +6584,9 @@ tls13_load_secret(SslDecryptSession *ssl, ssl_master_key_map_t *mk_map,
     ssl->state &= ~(SSL_MASTER_SECRET | SSL_PRE_MASTER_SECRET | SSL_HAVE_SESSION_KEY);
 
     StringInfo *secret = (StringInfo *)g_hash_table_lookup(key_map, &ssl->client_random);
+    if (!secret) {
+        secret = tls_keylog_index_lookup(key_map, &ssl->client_random);
+    }
     if (!secret) {
         ssl_debug_printf("%s Cannot find %s, decryption impossible\n", G_STRFUNC, label);
         /* Disable decryption, the keys are invalid. */
@@ -6812,6 +6895,245 @@ tls_keylog_process_lines(const ssl_master_key_map_t *mk_map, const uint8_t *data
     }
 }
 
+/* Regex group names in the order of the index tags above. */
+static const char *const tls_keylog_index_groups[] = {
+    "encrypted_pmk",        /* TLS_KEYLOG_TAG_PRE_MASTER */
+    "session_id",           /* TLS_KEYLOG_TAG_SESSION */
+    "client_random",        /* TLS_KEYLOG_TAG_CRANDOM */
+    "client_random_pms",    /* TLS_KEYLOG_TAG_PMS */
+    "client_early",         /* TLS_KEYLOG_TAG_CLIENT_EARLY */
+    "client_handshake",     /* TLS_KEYLOG_TAG_CLIENT_HANDSHAKE */
+    "server_handshake",     /* TLS_KEYLOG_TAG_SERVER_HANDSHAKE */
+    "client_appdata",       /* TLS_KEYLOG_TAG_CLIENT_APPDATA */
+    "server_appdata",       /* TLS_KEYLOG_TAG_SERVER_APPDATA */
+    "early_exporter",       /* TLS_KEYLOG_TAG_EARLY_EXPORTER */
+    "exporter",             /* TLS_KEYLOG_TAG_EXPORTER */
+};
+
+/* Like from_hex(), but without allocating in the file scope; the compile
+ * pass can run before any capture file is open. */
+static bool
+tls_keylog_hex_to_bytes(const char *in, GByteArray *out)
+{
+    size_t hex_len = strlen(in);
+
+    if (hex_len & 1)
+        return false;
+
+    g_byte_array_set_size(out, 0);
+    for (size_t i = 0; i < hex_len / 2; i++) {
+        int a = ws_xton(in[i*2]);
+        int b = ws_xton(in[i*2 + 1]);
+        uint8_t byte;
+        if (a == -1 || b == -1)
+            return false;
+        byte = (uint8_t)(a << 4 | b);
+        g_byte_array_append(out, &byte, 1);
+    }
+    return true;
+}
+
+/** Compiles the whole key log file into an index sidecar in one pass. */
+static bool
+tls_keylog_compile_index(const char *keylog_path, const char *index_path)
+{
+    GRegex *regex = ssl_compile_keyfile_regex();
+    secrets_index_writer_t *writer;
+    char *contents;
+    gsize datalen;
+    GByteArray *key_bytes, *secret_bytes;
+
+    if (!regex)
+        return false;
+    if (!g_file_get_contents(keylog_path, &contents, &datalen, NULL)) {
+        ssl_debug_printf("%s failed to read %s\n", G_STRFUNC, keylog_path);
+        return false;
+    }
+
+    writer = secrets_index_writer_new();
+    key_bytes = g_byte_array_new();
+    secret_bytes = g_byte_array_new();
+
+    const char *next_line = contents;
+    const char *line_end = contents + datalen;
+    while (next_line && next_line < line_end) {
+        const char *line = next_line;
+        next_line = (const char *)memchr(line, '\n', line_end - line);
+        ssize_t linelen;
+
+        if (next_line) {
+            linelen = next_line - line;
+            next_line++;    /* drop LF */
+        } else {
+            linelen = (ssize_t)(line_end - line);
+        }
+        if (linelen > 0 && line[linelen - 1] == '\r') {
+            linelen--;      /* drop CR */
+        }
+
+        GMatchInfo *mi;
+        if (g_regex_match_full(regex, line, linelen, 0, G_REGEX_MATCH_ANCHORED, &mi, NULL)) {
+            char *hex_key, *hex_pre_ms_or_ms;
+
+            hex_pre_ms_or_ms = g_match_info_fetch_named(mi, "master_secret");
+            if (hex_pre_ms_or_ms == NULL || !*hex_pre_ms_or_ms) {
+                g_free(hex_pre_ms_or_ms);
+                hex_pre_ms_or_ms = g_match_info_fetch_named(mi, "pms");
+            }
+            if (hex_pre_ms_or_ms == NULL || !*hex_pre_ms_or_ms) {
+                g_free(hex_pre_ms_or_ms);
+                hex_pre_ms_or_ms = g_match_info_fetch_named(mi, "derived_secret");
+            }
+            DISSECTOR_ASSERT(hex_pre_ms_or_ms && strlen(hex_pre_ms_or_ms));
+
+            for (unsigned i = 0; i < G_N_ELEMENTS(tls_keylog_index_groups); i++) {
+                hex_key = g_match_info_fetch_named(mi, tls_keylog_index_groups[i]);
+                if (hex_key && *hex_key) {
+                    if (tls_keylog_hex_to_bytes(hex_key, key_bytes) &&
+                        tls_keylog_hex_to_bytes(hex_pre_ms_or_ms, secret_bytes)) {
+                        secrets_index_writer_add(writer, (uint8_t)i,
+                                key_bytes->data, key_bytes->len,
+                                secret_bytes->data, secret_bytes->len);
+                    }
+                    g_free(hex_key);
+                    break;
+                }
+                g_free(hex_key);
+            }
+            g_free(hex_pre_ms_or_ms);
+        }
+        g_match_info_free(mi);
+    }
+
+    g_byte_array_free(key_bytes, TRUE);
+    g_byte_array_free(secret_bytes, TRUE);
+    g_free(contents);
+    return secrets_index_writer_finish(writer, index_path);
+}
+
+/** Associates the master key tables of this protocol (TLS or DTLS has its
+ * own set) with the index tags, so table misses can fall through to the
+ * index. */
+static void
+tls_keylog_index_register_tables(const ssl_master_key_map_t *mk_map)
+{
+    const struct {
+        GHashTable *ht;
+        unsigned tag;
+    } assocs[] = {
+        { mk_map->pre_master,               TLS_KEYLOG_TAG_PRE_MASTER },
+        { mk_map->session,                  TLS_KEYLOG_TAG_SESSION },
+        { mk_map->crandom,                  TLS_KEYLOG_TAG_CRANDOM },
+        { mk_map->pms,                      TLS_KEYLOG_TAG_PMS },
+        { mk_map->tls13_client_early,       TLS_KEYLOG_TAG_CLIENT_EARLY },
+        { mk_map->tls13_client_handshake,   TLS_KEYLOG_TAG_CLIENT_HANDSHAKE },
+        { mk_map->tls13_server_handshake,   TLS_KEYLOG_TAG_SERVER_HANDSHAKE },
+        { mk_map->tls13_client_appdata,     TLS_KEYLOG_TAG_CLIENT_APPDATA },
+        { mk_map->tls13_server_appdata,     TLS_KEYLOG_TAG_SERVER_APPDATA },
+        { mk_map->tls13_early_exporter,     TLS_KEYLOG_TAG_EARLY_EXPORTER },
+        { mk_map->tls13_exporter,           TLS_KEYLOG_TAG_EXPORTER },
+    };
+
+    if (!tls_keylog_index_tags) {
+        tls_keylog_index_tags = g_hash_table_new(g_direct_hash, g_direct_equal);
+    }
+    for (unsigned i = 0; i < G_N_ELEMENTS(assocs); i++) {
+        g_hash_table_insert(tls_keylog_index_tags, assocs[i].ht,
+                            GUINT_TO_POINTER(assocs[i].tag + 1));
+    }
+}
+
+/** Drops the table associations registered for this protocol; called when
+ * the tables themselves are about to be destroyed. */
+static void
+tls_keylog_index_forget_tables(const ssl_master_key_map_t *mk_map)
+{
+    if (!tls_keylog_index_tags) {
+        return;
+    }
+    g_hash_table_remove(tls_keylog_index_tags, mk_map->pre_master);
+    g_hash_table_remove(tls_keylog_index_tags, mk_map->session);
+    g_hash_table_remove(tls_keylog_index_tags, mk_map->crandom);
+    g_hash_table_remove(tls_keylog_index_tags, mk_map->pms);
+    g_hash_table_remove(tls_keylog_index_tags, mk_map->tls13_client_early);
+    g_hash_table_remove(tls_keylog_index_tags, mk_map->tls13_client_handshake);
+    g_hash_table_remove(tls_keylog_index_tags, mk_map->tls13_server_handshake);
+    g_hash_table_remove(tls_keylog_index_tags, mk_map->tls13_client_appdata);
+    g_hash_table_remove(tls_keylog_index_tags, mk_map->tls13_server_appdata);
+    g_hash_table_remove(tls_keylog_index_tags, mk_map->tls13_early_exporter);
+    g_hash_table_remove(tls_keylog_index_tags, mk_map->tls13_exporter);
+}
+
+static void
+tls_keylog_index_close(void)
+{
+    secrets_index_close(tls_keylog_index);
+    tls_keylog_index = NULL;
+    g_free(tls_keylog_index_source);
+    tls_keylog_index_source = NULL;
+}
+
+/** Tries to serve the key log through a compiled index. Returns true if an
+ * up-to-date index is open, in which case line-by-line parsing must be
+ * skipped. */
+static bool
+tls_keylog_try_index(const char *keylog_path, const ssl_master_key_map_t *mk_map)
+{
+    ws_statb64 log_st, idx_st;
+    char *index_path;
+    bool fresh;
+
+    if (ws_stat64(keylog_path, &log_st) != 0 ||
+        log_st.st_size < TLS_KEYLOG_INDEX_MIN_SIZE) {
+        return false;
+    }
+
+    /* One index at a time; if another (say, DTLS) key log is already being
+     * served, fall back to plain parsing rather than thrash. */
+    if (tls_keylog_index && g_strcmp0(tls_keylog_index_source, keylog_path) != 0) {
+        return false;
+    }
+
+    index_path = g_strconcat(keylog_path, ".index", NULL);
+    fresh = ws_stat64(index_path, &idx_st) == 0 &&
+            idx_st.st_mtime >= log_st.st_mtime;
+
+    if (tls_keylog_index) {
+        if (fresh) {
+            /* Reuse the open index; the tables may belong to a fresh capture
+             * file, so (re-)register them. */
+            tls_keylog_index_register_tables(mk_map);
+            g_free(index_path);
+            return true;
+        }
+        /* The key log grew or changed under us. Drop the index and let this
+         * session parse the file; the next one recompiles it. */
+        ssl_debug_printf("%s index for %s is stale, dropping it\n",
+                         G_STRFUNC, keylog_path);
+        tls_keylog_index_close();
+        g_free(index_path);
+        return false;
+    }
+
+    if (!fresh && !tls_keylog_compile_index(keylog_path, index_path)) {
+        /* Could not build the sidecar (e.g. read-only directory); fall back
+         * to plain parsing. */
+        g_free(index_path);
+        return false;
+    }
+
+    tls_keylog_index = secrets_index_open(index_path);
+    g_free(index_path);
+    if (!tls_keylog_index) {
+        return false;
+    }
+    tls_keylog_index_source = g_strdup(keylog_path);
+    tls_keylog_index_register_tables(mk_map);
+    ssl_debug_printf("%s using compiled keylog index for %s\n", G_STRFUNC,
+                     keylog_path);
+    return true;
+}
+
 void
 ssl_load_keyfile(const char *tls_keylog_filename, FILE **keylog_file,
                  const ssl_master_key_map_t *mk_map)
@@ -6828,6 +7150,12 @@ ssl_load_keyfile(const char *tls_keylog_filename, FILE **keylog_file,
         return;
     }
 
+    /* Large key logs are served from a compiled index instead of being
+     * replayed line by line on every capture file open. */
+    if (tls_keylog_try_index(tls_keylog_filename, mk_map)) {
+        return;
+    }
+
     ssl_debug_printf("trying to use TLS keylog in %s\n", tls_keylog_filename);
 
     /* if the keylog file was deleted/overwritten, re-open it */
@@ -452,7 +452,9 @@ typedef struct _TlsHsFragment {
 
 typedef struct {
     SslRecordInfo *records; /**< Decrypted records within this frame. */
+    SslRecordInfo *records_tail;    /**< Last decrypted record, for cheap appends. */
     TlsHsFragment *hs_fragments;    /**< Handshake records that are part of a reassembly. */
+    TlsHsFragment *hs_fragments_tail;   /**< Last handshake fragment, for cheap appends. */
     uint32_t srcport;        /**< Used for Decode As */
     uint32_t destport;
     int cipher;            /**< Cipher at time of Key Exchange handshake message.
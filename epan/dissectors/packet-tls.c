@@ -2562,9 +2562,12 @@ save_tls_handshake_fragment(packet_info *pinfo, uint8_t curr_layer_num_tls,
     frag_info->offset = frag_offset;
     frag_info->type = msg_type;
 
-    TlsHsFragment **p = &pi->hs_fragments;
-    while (*p) p = &(*p)->next;
-    *p = frag_info;
+    if (pi->hs_fragments_tail) {
+        pi->hs_fragments_tail->next = frag_info;
+    } else {
+        pi->hs_fragments = frag_info;
+    }
+    pi->hs_fragments_tail = frag_info;
 
     // Add (subset of) record data.
     fragment_add_check(&tls_hs_reassembly_table, tvb, offset,
@@ -31,6 +31,7 @@
 #include "epan_dissect.h"
 
 #include <wsutil/nstime.h>
+#include <wsutil/time_util.h>
 #include <wsutil/wslog.h>
 #include <wsutil/ws_assert.h>
 #include <wsutil/version_info.h>
@@ -110,7 +111,123 @@
 static GSList *epan_plugin_register_all_procotols;
 static GSList *epan_plugin_register_all_handoffs;
 
-static wmem_allocator_t *pinfo_pool_cache;
+/*
+ * Startup phase tracing.  When enabled (before epan_init()), each call
+ * to epan_startup_trace_mark() charges the wall and CPU time since the
+ * previous mark to a named phase, so cold-start latency can be broken
+ * down by subsystem instead of guessed at.
+ */
+typedef struct {
+	const char *name;
+	int64_t wall_usecs;
+	int64_t cpu_usecs;
+} startup_phase_t;
+
+static bool startup_trace_enabled;
+static GArray *startup_phases;
+static int64_t startup_phase_wall_start;
+static int64_t startup_phase_cpu_start;
+
+static int64_t
+startup_trace_cpu_usecs(void)
+{
+	double user_secs, sys_secs;
+
+	get_resource_usage(&user_secs, &sys_secs);
+	return (int64_t)((user_secs + sys_secs) * 1000000.0);
+}
+
+void
+epan_startup_trace_enable(void)
+{
+	startup_trace_enabled = true;
+	if (startup_phases == NULL)
+		startup_phases = g_array_new(false, false, sizeof(startup_phase_t));
+	startup_phase_wall_start = g_get_monotonic_time();
+	startup_phase_cpu_start = startup_trace_cpu_usecs();
+}
+
+void
+epan_startup_trace_mark(const char *phase)
+{
+	startup_phase_t entry;
+	int64_t wall_now, cpu_now;
+
+	if (!startup_trace_enabled)
+		return;
+
+	wall_now = g_get_monotonic_time();
+	cpu_now = startup_trace_cpu_usecs();
+	entry.name = phase;
+	entry.wall_usecs = wall_now - startup_phase_wall_start;
+	entry.cpu_usecs = cpu_now - startup_phase_cpu_start;
+	g_array_append_val(startup_phases, entry);
+	startup_phase_wall_start = wall_now;
+	startup_phase_cpu_start = cpu_now;
+}
+
+char *
+epan_startup_trace_report(void)
+{
+	GString *report;
+	int64_t wall_total = 0, cpu_total = 0;
+
+	if (startup_phases == NULL)
+		return NULL;
+
+	report = g_string_new("Startup phase                   Wall (ms)     CPU (ms)\n");
+	for (unsigned i = 0; i < startup_phases->len; i++) {
+		const startup_phase_t *phase =
+		    &g_array_index(startup_phases, startup_phase_t, i);
+
+		g_string_append_printf(report, "%-30s %10.3f %12.3f\n",
+		    phase->name,
+		    phase->wall_usecs / 1000.0,
+		    phase->cpu_usecs / 1000.0);
+		wall_total += phase->wall_usecs;
+		cpu_total += phase->cpu_usecs;
+	}
+	g_string_append_printf(report, "%-30s %10.3f %12.3f\n",
+	    "total", wall_total / 1000.0, cpu_total / 1000.0);
+	return g_string_free(report, FALSE);
+}
+
+/*
+ * Small cache of recycled pinfo pools.  A single slot is enough for the
+ * classic one-edt-at-a-time dissection loop; a few more slots let
+ * applications that keep several epan_dissect_t instances alive at once
+ * (e.g. a future parallel dissection worker pool) recycle their pools
+ * instead of destroying and recreating an allocator per instance.
+ */
+#define PINFO_POOL_CACHE_SIZE 8
+static wmem_allocator_t *pinfo_pool_cache[PINFO_POOL_CACHE_SIZE];
+
+static wmem_allocator_t *
+pinfo_pool_cache_acquire(void)
+{
+	for (unsigned i = 0; i < PINFO_POOL_CACHE_SIZE; i++) {
+		if (pinfo_pool_cache[i] != NULL) {
+			wmem_allocator_t *pool = pinfo_pool_cache[i];
+			pinfo_pool_cache[i] = NULL;
+			return pool;
+		}
+	}
+	return NULL;
+}
+
+/* Takes ownership of the pool; destroys it if the cache is full. */
+static void
+pinfo_pool_cache_release(wmem_allocator_t *pool)
+{
+	for (unsigned i = 0; i < PINFO_POOL_CACHE_SIZE; i++) {
+		if (pinfo_pool_cache[i] == NULL) {
+			wmem_free_all(pool);
+			pinfo_pool_cache[i] = pool;
+			return;
+		}
+	}
+	wmem_destroy_allocator(pool);
+}
 
 /* Global variables holding the content of the corresponding environment variable
  * to save fetching it repeatedly.
@@ -270,9 +387,13 @@ epan_init(register_cb cb, void *client_data, bool load_plugins)
 	/* initialize the GUID to name mapping table */
 	guids_init();
 
+	epan_startup_trace_mark("wmem & guids");
+
 	/* initialize name resolution (addr_resolv.c) */
 	addr_resolv_init();
 
+	epan_startup_trace_mark("addr_resolv init");
+
 	except_init();
 
 	dfilter_translator_init();
@@ -283,6 +404,8 @@ epan_init(register_cb cb, void *client_data, bool load_plugins)
 #endif
 	}
 
+	epan_startup_trace_mark("plugin scan");
+
 	/* initialize libgcrypt (beware, it won't be thread-safe) */
 #if GCRYPT_VERSION_NUMBER >= 0x010a00
 	/* Ensure FIPS mode is disabled; it makes it impossible to decrypt
@@ -318,6 +441,7 @@ epan_init(register_cb cb, void *client_data, bool load_plugins)
 #endif
 
 	TRY {
+		epan_startup_trace_mark("crypto & xml libraries");
 		export_pdu_init();
 		tap_init();
 		prefs_init();
@@ -329,6 +453,7 @@ epan_init(register_cb cb, void *client_data, bool load_plugins)
 		reassembly_tables_init();
 		conversation_filters_init();
 		g_slist_foreach(epan_plugins, epan_plugin_init, NULL);
+		epan_startup_trace_mark("epan subsystems init");
 		proto_init(epan_plugin_register_all_procotols, epan_plugin_register_all_handoffs, cb, client_data);
 		g_slist_foreach(epan_plugins, epan_plugin_register_all_tap_listeners, NULL);
 		packet_cache_proto_handles();
@@ -337,8 +462,10 @@ epan_init(register_cb cb, void *client_data, bool load_plugins)
 		final_registration_all_protocols();
 		print_cache_field_handles();
 		expert_packet_init();
+		epan_startup_trace_mark("final registration");
 #ifdef HAVE_LUA
 		wslua_init(cb, client_data);
+		epan_startup_trace_mark("lua init");
 #endif
 		g_slist_foreach(epan_plugins, epan_plugin_post_init, NULL);
 	}
@@ -372,17 +499,31 @@ epan_load_settings(void)
 {
 	e_prefs *prefs_p;
 
+	/* Whatever the application did between epan_init() and here isn't
+	 * ours; give it its own line rather than polluting "prefs read". */
+	epan_startup_trace_mark("application setup");
+
 	/* load the decode as entries of the current profile */
 	load_decode_as_entries();
 
 	prefs_p = read_prefs();
 
+	epan_startup_trace_mark("prefs read");
+
 	/*
 	 * Read the files that enable and disable protocols and heuristic
 	 * dissectors.
 	 */
 	read_enabled_and_disabled_lists();
 
+	/*
+	 * Restore the heuristic dissector ordering learned in previous
+	 * sessions.
+	 */
+	heur_dissector_order_load();
+
+	epan_startup_trace_mark("enabled/disabled lists");
+
 	return prefs_p;
 }
 
@@ -419,6 +560,7 @@ epan_cleanup(void)
 	 * deregister dynamically registered protocol fields. This must be done
 	 * before proto_cleanup() to avoid inconsistency and memory leaks.
 	 */
+	heur_dissector_order_save();
 	packet_cleanup();
 	prefs_cleanup();
 	proto_cleanup();
@@ -448,9 +590,11 @@ epan_cleanup(void)
 
 	dfilter_translator_cleanup();
 
-	if (pinfo_pool_cache != NULL) {
-		wmem_destroy_allocator(pinfo_pool_cache);
-		pinfo_pool_cache = NULL;
+	for (unsigned i = 0; i < PINFO_POOL_CACHE_SIZE; i++) {
+		if (pinfo_pool_cache[i] != NULL) {
+			wmem_destroy_allocator(pinfo_pool_cache[i]);
+			pinfo_pool_cache[i] = NULL;
+		}
 	}
 
 	wmem_cleanup_scopes();
@@ -564,13 +708,9 @@ epan_dissect_init(epan_dissect_t *edt, epan_t *session, const bool create_proto_
 	edt->session = session;
 
 	memset(&edt->pi, 0, sizeof(edt->pi));
-	if (pinfo_pool_cache != NULL) {
-		edt->pi.pool = pinfo_pool_cache;
-		pinfo_pool_cache = NULL;
-	}
-	else {
+	edt->pi.pool = pinfo_pool_cache_acquire();
+	if (edt->pi.pool == NULL)
 		edt->pi.pool = wmem_allocator_new(WMEM_ALLOCATOR_BLOCK_FAST);
-	}
 
 	if (create_proto_tree) {
 		edt->tree = proto_tree_create_root(&edt->pi);
@@ -667,6 +807,38 @@ epan_dissect_run_with_taps(epan_dissect_t *edt, int file_type_subtype,
 	rec->block = NULL;
 }
 
+void
+epan_dissect_run_batch(epan_dissect_t *edt, int file_type_subtype,
+	epan_batch_item_t *items, unsigned n_items, bool run_taps)
+{
+	for (unsigned i = 0; i < n_items; i++) {
+		epan_batch_item_t *item = &items[i];
+
+#ifdef HAVE_LUA
+		/* The reset between records clears the priming, so this
+		 * has to be redone per record, before entering the wmem
+		 * scope. */
+		wslua_prime_dfilter(edt);
+#endif
+		wmem_enter_packet_scope();
+		if (run_taps)
+			tap_queue_init(edt);
+		dissect_record(edt, file_type_subtype, item->rec, item->tvb,
+		    item->fd, item->cinfo);
+		if (run_taps)
+			tap_push_tapped_queue(edt);
+
+		/* free all memory allocated */
+		wmem_leave_packet_scope();
+		wtap_block_unref(item->rec->block);
+		item->rec->block = NULL;
+
+		/* Leave the last record's state for the caller. */
+		if (i + 1 < n_items)
+			epan_dissect_reset(edt);
+	}
+}
+
 void
 epan_dissect_file_run(epan_dissect_t *edt, wtap_rec *rec,
 	tvbuff_t *tvb, frame_data *fd, column_info *cinfo)
@@ -719,13 +891,7 @@ epan_dissect_cleanup(epan_dissect_t* edt)
 		proto_tree_free(edt->tree);
 	}
 
-	if (pinfo_pool_cache == NULL) {
-		wmem_free_all(edt->pi.pool);
-		pinfo_pool_cache = edt->pi.pool;
-	}
-	else {
-		wmem_destroy_allocator(edt->pi.pool);
-	}
+	pinfo_pool_cache_release(edt->pi.pool);
 }
 
 void
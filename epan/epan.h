@@ -105,6 +105,29 @@ Ref2 for further edits - delete when done
 WS_DLL_PUBLIC
 bool epan_init(register_cb cb, void *client_data, bool load_plugins);
 
+/**
+ * Enable collection of per-phase startup timings.
+ *
+ * Must be called before epan_init() to cover all the phases.
+ */
+WS_DLL_PUBLIC
+void epan_startup_trace_enable(void);
+
+/**
+ * Record the end of a named startup phase.  The phase is charged the
+ * wall and CPU time since the previous mark (or since
+ * epan_startup_trace_enable()).  A no-op unless tracing is enabled.
+ */
+WS_DLL_PUBLIC
+void epan_startup_trace_mark(const char *phase);
+
+/**
+ * Return the collected startup timings as a printable table, or NULL if
+ * tracing was never enabled.  The caller must g_free() the result.
+ */
+WS_DLL_PUBLIC
+char *epan_startup_trace_report(void);
+
 /**
  * Load all settings, from the current profile, that affect epan.
  */
@@ -217,6 +240,25 @@ epan_dissect_run_with_taps(epan_dissect_t *edt, int file_type_subtype,
         wtap_rec *rec, tvbuff_t *tvb, frame_data *fd,
         struct epan_column_info *cinfo);
 
+/** One record in a batch passed to epan_dissect_run_batch(). */
+typedef struct epan_batch_item {
+        wtap_rec *rec;
+        tvbuff_t *tvb;
+        frame_data *fd;
+        struct epan_column_info *cinfo;
+} epan_batch_item_t;
+
+/** Dissect a batch of records with one epan_dissect_t, resetting it
+ * between records.  Per-record results must therefore be consumed
+ * through taps; the state of the last record is left in the
+ * epan_dissect_t for the caller to inspect and reset as usual.
+ * If run_taps is true each record is pushed through the tap system,
+ * as epan_dissect_run_with_taps() would. */
+WS_DLL_PUBLIC
+void
+epan_dissect_run_batch(epan_dissect_t *edt, int file_type_subtype,
+        epan_batch_item_t *items, unsigned n_items, bool run_taps);
+
 /** run a single file packet dissection */
 WS_DLL_PUBLIC
 void
@@ -105,6 +105,196 @@ const value_string expert_checksum_vals[] = {
 
 static expert_field_info *expert_registrar_get_byname(const char *field_name);
 
+/*----------------------------------------------------------------------------*/
+/* Session expert event log.                                                  */
+/*----------------------------------------------------------------------------*/
+
+static bool          expert_log_enabled;
+static bool          expert_log_registered;
+static bool          expert_log_resync;
+static bool          expert_log_stale;
+static uint32_t      expert_log_high_frame;
+static wmem_array_t *expert_log_entries;
+static unsigned      expert_log_severity_counts[5];
+
+static int
+expert_log_severity_index(int severity)
+{
+	switch (severity) {
+		case PI_COMMENT: return 0;
+		case PI_CHAT:    return 1;
+		case PI_NOTE:    return 2;
+		case PI_WARN:    return 3;
+		case PI_ERROR:   return 4;
+	}
+	return -1;
+}
+
+/* Forget everything that was logged for the current capture file. The
+ * entries and strings live in file scope, so they go away with it. */
+static void
+expert_log_clear(void)
+{
+	expert_log_entries = NULL;
+	expert_log_high_frame = 0;
+	expert_log_resync = false;
+	expert_log_stale = false;
+	memset(expert_log_severity_counts, 0, sizeof expert_log_severity_counts);
+}
+
+static void
+expert_log_reset_cb(void *tapdata _U_)
+{
+	/* A retap is starting; it will re-feed frames that were already
+	 * logged, so ignore events until we pass the high-water mark. */
+	expert_log_resync = true;
+}
+
+static tap_packet_status
+expert_log_packet_cb(void *tapdata _U_, packet_info *pinfo, epan_dissect_t *edt _U_,
+		     const void *data, tap_flags_t flags _U_)
+{
+	const expert_info_t *ei = (const expert_info_t *)data;
+	expert_log_entry_t   entry;
+	const char          *col_info;
+	int                  sev_idx;
+
+	if (!expert_log_enabled)
+		return TAP_PACKET_DONT_REDRAW;
+
+	/* The sequential passes feed frames in ascending order; anything at
+	 * or below the high-water mark was logged when it first arrived. */
+	if (pinfo->num > expert_log_high_frame) {
+		expert_log_high_frame = pinfo->num;
+		expert_log_resync = false;
+	} else if (expert_log_resync || pinfo->num < expert_log_high_frame) {
+		return TAP_PACKET_DONT_REDRAW;
+	}
+
+	if (expert_log_entries == NULL) {
+		expert_log_entries = wmem_array_new(wmem_file_scope(),
+						    sizeof(expert_log_entry_t));
+	}
+
+	entry.packet_num = ei->packet_num;
+	entry.group      = ei->group;
+	entry.severity   = ei->severity;
+	entry.hf_index   = ei->hf_index;
+	entry.protocol   = ei->protocol;
+	entry.summary    = wmem_strdup(wmem_file_scope(), ei->summary);
+	col_info         = pinfo->cinfo ? col_get_text(pinfo->cinfo, COL_INFO) : NULL;
+	entry.col_info   = col_info ? wmem_strdup(wmem_file_scope(), col_info) : NULL;
+	wmem_array_append_one(expert_log_entries, entry);
+
+	sev_idx = expert_log_severity_index(ei->severity);
+	if (sev_idx >= 0)
+		expert_log_severity_counts[sev_idx]++;
+
+	return TAP_PACKET_DONT_REDRAW;
+}
+
+void
+expert_log_set_enabled(bool enabled)
+{
+	GString *error;
+
+	expert_log_enabled = enabled;
+	if (enabled && !expert_log_registered) {
+		error = register_tap_listener("expert", &expert_log_enabled, NULL,
+					      TL_REQUIRES_COLUMNS,
+					      expert_log_reset_cb,
+					      expert_log_packet_cb,
+					      NULL, NULL);
+		if (error) {
+			ws_warning("expert: failed to attach the event log: %s",
+				   error->str);
+			g_string_free(error, TRUE);
+			expert_log_enabled = false;
+			return;
+		}
+		expert_log_registered = true;
+	}
+}
+
+bool
+expert_log_get_enabled(void)
+{
+	return expert_log_enabled;
+}
+
+unsigned
+expert_log_count(void)
+{
+	if (expert_log_entries == NULL || expert_log_stale)
+		return 0;
+	return wmem_array_get_count(expert_log_entries);
+}
+
+const expert_log_entry_t *
+expert_log_entry(unsigned idx)
+{
+	if (idx >= expert_log_count())
+		return NULL;
+	return (const expert_log_entry_t *)wmem_array_index(expert_log_entries, idx);
+}
+
+unsigned
+expert_log_severity_count(int severity)
+{
+	int sev_idx = expert_log_severity_index(severity);
+
+	if (sev_idx < 0 || expert_log_stale)
+		return 0;
+	return expert_log_severity_counts[sev_idx];
+}
+
+/*----------------------------------------------------------------------------*/
+/* Per-field event counters.                                                  */
+/*----------------------------------------------------------------------------*/
+
+/* Every expert event is counted here, whether or not an expert subtree was
+ * built for it, so tree-less passes can skip the item work entirely and
+ * still report how often each field fired.
+ *
+ * Key is (hf_index << 3) | severity index; see expert_log_severity_index. */
+static GHashTable *expert_event_counts;
+
+static void
+expert_count_event(int hf_index, int severity)
+{
+	int   sev_idx = expert_log_severity_index(severity);
+	void *key;
+	unsigned count;
+
+	if (sev_idx < 0)
+		return;
+
+	if (expert_event_counts == NULL)
+		expert_event_counts = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+	key = GINT_TO_POINTER((hf_index << 3) | sev_idx);
+	count = GPOINTER_TO_UINT(g_hash_table_lookup(expert_event_counts, key));
+	g_hash_table_insert(expert_event_counts, key, GUINT_TO_POINTER(count + 1));
+}
+
+unsigned
+expert_field_event_count(expert_field *eiindex)
+{
+	expert_field_info *eiinfo;
+	int                sev_idx;
+	void              *key;
+
+	/* Look up the item */
+	EXPERT_REGISTRAR_GET_NTH(eiindex->ei, eiinfo);
+
+	sev_idx = expert_log_severity_index(eiinfo->severity);
+	if (sev_idx < 0 || expert_event_counts == NULL)
+		return 0;
+
+	key = GINT_TO_POINTER((*eiinfo->hf_info.p_id << 3) | sev_idx);
+	return GPOINTER_TO_UINT(g_hash_table_lookup(expert_event_counts, key));
+}
+
 /*----------------------------------------------------------------------------*/
 /* UAT for customizing severity levels.                                       */
 /*----------------------------------------------------------------------------*/
@@ -256,6 +446,11 @@ expert_packet_init(void)
 
 	highest_severity = 0;
 
+	expert_log_clear();
+
+	if (expert_event_counts != NULL)
+		g_hash_table_remove_all(expert_event_counts);
+
 	proto_malformed = proto_get_id_by_filter_name("_ws.malformed");
 }
 
@@ -273,6 +468,7 @@ expert_init(void)
 void
 expert_packet_cleanup(void)
 {
+	expert_log_clear();
 }
 
 void
@@ -301,6 +497,11 @@ expert_cleanup(void)
 		g_ptr_array_free(deregistered_expertinfos, true);
 		deregistered_expertinfos = NULL;
 	}
+
+	if (expert_event_counts) {
+		g_hash_table_destroy(expert_event_counts);
+		expert_event_counts = NULL;
+	}
 }
 
 
@@ -315,6 +516,12 @@ expert_update_comment_count(uint64_t count)
 {
 	if (count==0 && highest_severity==PI_COMMENT)
 		highest_severity = 0;
+
+	/* Comment events in the session log were recorded at dissection
+	 * time; if the comments have changed since, the log is no longer
+	 * trustworthy until the next redissection rebuilds it. */
+	if (expert_log_enabled && count != expert_log_severity_counts[0])
+		expert_log_stale = true;
 }
 
 expert_module_t *expert_register_protocol(int id)
@@ -545,6 +752,7 @@ expert_set_info_vformat(packet_info *pinfo, proto_item *pi, int group, int sever
 	char           formatted[ITEM_LABEL_LENGTH];
 	int            pos;
 	int            tap;
+	bool           has_finfo;
 	expert_info_t *ei;
 	proto_tree    *tree;
 	proto_item    *ti;
@@ -563,15 +771,27 @@ expert_set_info_vformat(packet_info *pinfo, proto_item *pi, int group, int sever
 	}
 
 	/* XXX: can we get rid of these checks and make them programming errors instead now? */
-	if (pi != NULL && PITEM_FINFO(pi) != NULL) {
+	has_finfo = (pi != NULL && PITEM_FINFO(pi) != NULL);
+	if (has_finfo) {
 		expert_set_item_flags(pi, group, severity);
 	}
 
-	if ((pi == NULL) || (PITEM_FINFO(pi) == NULL) ||
+	if (!has_finfo ||
 		((unsigned)severity >= FI_GET_FLAG(PITEM_FINFO(pi), PI_SEVERITY_MASK))) {
 		col_add_str(pinfo->cinfo, COL_EXPERT, val_to_str(severity, expert_severity_vals, "Unknown (%u)"));
 	}
 
+	expert_count_event(hf_index, severity);
+
+	tap = have_tap_listener(expert_tap);
+
+	/* With no real item to decorate and nobody listening on the tap, the
+	 * count and the column are all this event amounts to; skip formatting
+	 * the message and building the (invisible) expert subtree. */
+	if (!has_finfo && !tap) {
+		return NULL;
+	}
+
 	if (use_vaformat) {
 		pos = vsnprintf(formatted, ITEM_LABEL_LENGTH, format, ap);
 	} else {
@@ -586,30 +806,32 @@ expert_set_info_vformat(packet_info *pinfo, proto_item *pi, int group, int sever
 		ws_utf8_truncate(formatted, ITEM_LABEL_LENGTH - 1);
 	}
 
-	tree = expert_create_tree(pi, group, severity, formatted);
+	if (has_finfo) {
+		tree = expert_create_tree(pi, group, severity, formatted);
 
-	if (hf_index <= 0) {
-		/* If no filterable expert info, just add the message */
-		ti = proto_tree_add_string(tree, hf_expert_msg, NULL, 0, 0, formatted);
+		if (hf_index <= 0) {
+			/* If no filterable expert info, just add the message */
+			ti = proto_tree_add_string(tree, hf_expert_msg, NULL, 0, 0, formatted);
+			proto_item_set_generated(ti);
+		} else {
+			/* If filterable expert info, hide the "generic" form of the message,
+			   and generate the formatted filterable expert info */
+			ti = proto_tree_add_none_format(tree, hf_index, NULL, 0, 0, "%s", formatted);
+			proto_item_set_generated(ti);
+			ti = proto_tree_add_string(tree, hf_expert_msg, NULL, 0, 0, formatted);
+			proto_item_set_hidden(ti);
+		}
+
+		ti = proto_tree_add_uint_format_value(tree, hf_expert_severity, NULL, 0, 0, severity,
+						      "%s", val_to_str_const(severity, expert_severity_vals, "Unknown"));
 		proto_item_set_generated(ti);
-	} else {
-		/* If filterable expert info, hide the "generic" form of the message,
-		   and generate the formatted filterable expert info */
-		ti = proto_tree_add_none_format(tree, hf_index, NULL, 0, 0, "%s", formatted);
+		ti = proto_tree_add_uint_format_value(tree, hf_expert_group, NULL, 0, 0, group,
+						      "%s", val_to_str_const(group, expert_group_vals, "Unknown"));
 		proto_item_set_generated(ti);
-		ti = proto_tree_add_string(tree, hf_expert_msg, NULL, 0, 0, formatted);
-		proto_item_set_hidden(ti);
+	} else {
+		tree = NULL;
 	}
 
-	ti = proto_tree_add_uint_format_value(tree, hf_expert_severity, NULL, 0, 0, severity,
-					      "%s", val_to_str_const(severity, expert_severity_vals, "Unknown"));
-	proto_item_set_generated(ti);
-	ti = proto_tree_add_uint_format_value(tree, hf_expert_group, NULL, 0, 0, group,
-					      "%s", val_to_str_const(group, expert_group_vals, "Unknown"));
-	proto_item_set_generated(ti);
-
-	tap = have_tap_listener(expert_tap);
-
 	if (!tap)
 		return tree;
 
@@ -623,7 +845,7 @@ expert_set_info_vformat(packet_info *pinfo, proto_item *pi, int group, int sever
 	ei->summary     = wmem_strdup(pinfo->pool, formatted);
 
 	/* if we have a proto_item (not a faked item), set expert attributes to it */
-	if (pi != NULL && PITEM_FINFO(pi) != NULL) {
+	if (has_finfo) {
 		ei->pitem = pi;
 	}
 	/* XXX: remove this because we don't have an internal-only function now? */
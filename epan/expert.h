@@ -96,6 +96,53 @@ expert_get_highest_severity(void);
 WS_DLL_PUBLIC void
 expert_update_comment_count(uint64_t count);
 
+/** One entry of the session expert event log. */
+typedef struct expert_log_entry_s {
+	uint32_t     packet_num;
+	int          group;
+	int          severity;
+	int          hf_index; /* hf_index of the expert item. Might be -1. */
+	const char  *protocol;
+	const char  *summary;
+	const char  *col_info; /* Info column text of the packet. Might be NULL. */
+} expert_log_entry_t;
+
+/** Enable (or disable) the session expert event log.
+ *
+ * While enabled, every expert info emitted the first time a frame is
+ * dissected is appended to a log that lives until the capture file is
+ * closed or redissected. Consumers can then read the events back with
+ * expert_log_count() and expert_log_entry() instead of re-dissecting the
+ * whole file through the "expert" tap. Note that the log requires the
+ * columns to be constructed while it is enabled.
+ */
+WS_DLL_PUBLIC void
+expert_log_set_enabled(bool enabled);
+
+WS_DLL_PUBLIC bool
+expert_log_get_enabled(void);
+
+/** Number of entries in the session expert event log, or 0 if the log
+ * does not (yet) cover the capture file. */
+WS_DLL_PUBLIC unsigned
+expert_log_count(void);
+
+/** Get an entry of the session expert event log, in dissection order. */
+WS_DLL_PUBLIC const expert_log_entry_t *
+expert_log_entry(unsigned idx);
+
+/** Number of logged events of the given PI_ severity. */
+WS_DLL_PUBLIC unsigned
+expert_log_severity_count(int severity);
+
+/** Number of times the given expert info field fired at its current
+ * severity since the capture file was opened.
+ *
+ * Events are counted even during tree-less passes, where no expert
+ * items or subtrees are built for them. */
+WS_DLL_PUBLIC unsigned
+expert_field_event_count(expert_field *eiindex);
+
 /** Add an expert info.
  Add an expert info tree to a protocol item using registered expert info item
  @param pinfo Packet info of the currently processed packet. May be NULL if
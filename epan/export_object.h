@@ -62,6 +62,30 @@ typedef void (*export_object_gui_reset_cb)(void);
  */
 WS_DLL_PUBLIC int register_export_object(const int proto_id, tap_packet_cb export_packet_func, export_object_gui_reset_cb reset_cb);
 
+/** Register an export object handler whose entries are complete when
+ * add_entry is called and are never modified afterwards.  Consumers
+ * (e.g. tshark --export-objects) may then write each object out and
+ * release it immediately instead of holding every object in memory for
+ * the whole run.  Handlers that keep appending data to entries already
+ * passed to add_entry (through get_entry) must use
+ * register_export_object() instead.
+ *
+ * @param proto_id is the protocol with objects to export
+ * @param export_packet_func the tap processing function
+ * @param reset_cb handles clearing intermediate data structures constructed
+ *  for exporting objects. If no function is needed a NULL value should be passed instead
+ * @return Tap id registered for the Export Object
+ */
+WS_DLL_PUBLIC int register_export_object_final(const int proto_id, tap_packet_cb export_packet_func, export_object_gui_reset_cb reset_cb);
+
+/** Check whether entries from this Export Object are complete at
+ * add_entry time (see register_export_object_final())
+ *
+ * @param eo Registered Export Object
+ * @return true if entries are never modified after add_entry
+ */
+WS_DLL_PUBLIC bool get_eo_entries_final(register_eo_t* eo);
+
 /** Get protocol ID from Export Object
  *
  * @param eo Registered Export Object
@@ -20,10 +20,45 @@
 #include <wiretap/wtap.h>
 
 #include <wsutil/pint.h>
+#include <wsutil/glib-compat.h>
 
 static GSList *export_pdu_tap_name_list;
 static wmem_map_t *export_pdu_encap_table;
 
+/*
+ * Cache of the most recently built common-tags buffer. All common tags except
+ * the original frame number depend only on the protocol and the flow 5-tuple,
+ * and exported PDUs overwhelmingly arrive in runs from the same flow, so the
+ * previous buffer can usually be replayed with just the frame number patched
+ * instead of sizing and populating every tag again.
+ */
+typedef struct {
+	bool		valid;
+	char		*proto_name;
+	uint16_t	tag_type;
+	address		net_src;
+	address		net_dst;
+	port_type	ptype;
+	uint32_t	srcport;
+	uint32_t	destport;
+	uint8_t		*tlv_buffer;
+	unsigned	tlv_buffer_len;
+} exp_pdu_common_tags_cache_t;
+
+static exp_pdu_common_tags_cache_t common_tags_cache;
+
+static void
+common_tags_cache_reset(void)
+{
+	if (!common_tags_cache.valid)
+		return;
+	g_free(common_tags_cache.proto_name);
+	free_address(&common_tags_cache.net_src);
+	free_address(&common_tags_cache.net_dst);
+	g_free(common_tags_cache.tlv_buffer);
+	memset(&common_tags_cache, 0, sizeof(common_tags_cache));
+}
+
 static int exp_pdu_data_ip_size(const address* addr)
 {
 	if (addr->type == AT_IPv4){
@@ -207,8 +242,44 @@ exp_pdu_data_t *export_pdu_create_common_tags(packet_info *pinfo, const char *pr
 		&exp_pdu_data_orig_frame_num,
 		NULL
 	};
+	exp_pdu_data_t *exp_pdu_data;
+
+	if (common_tags_cache.valid &&
+	    common_tags_cache.tag_type == tag_type &&
+	    strcmp(common_tags_cache.proto_name, proto_name) == 0 &&
+	    common_tags_cache.ptype == pinfo->ptype &&
+	    common_tags_cache.srcport == pinfo->srcport &&
+	    common_tags_cache.destport == pinfo->destport &&
+	    addresses_equal(&common_tags_cache.net_src, &pinfo->net_src) &&
+	    addresses_equal(&common_tags_cache.net_dst, &pinfo->net_dst)) {
+		/* Same protocol and flow as the previous PDU; replay the
+		 * template. The original frame number is the last tag before
+		 * the 4-byte end-of-options, so its value occupies the last
+		 * 4 bytes before that. */
+		exp_pdu_data = wmem_new(pinfo->pool, exp_pdu_data_t);
+		exp_pdu_data->tlv_buffer_len = common_tags_cache.tlv_buffer_len;
+		exp_pdu_data->tlv_buffer = (uint8_t *)wmem_memdup(pinfo->pool,
+			common_tags_cache.tlv_buffer, common_tags_cache.tlv_buffer_len);
+		phton32(exp_pdu_data->tlv_buffer + exp_pdu_data->tlv_buffer_len - 8, pinfo->num);
+		return exp_pdu_data;
+	}
 
-	return export_pdu_create_tags(pinfo, proto_name, tag_type, common_exp_pdu_items);
+	exp_pdu_data = export_pdu_create_tags(pinfo, proto_name, tag_type, common_exp_pdu_items);
+
+	common_tags_cache_reset();
+	common_tags_cache.proto_name = g_strdup(proto_name);
+	common_tags_cache.tag_type = tag_type;
+	copy_address(&common_tags_cache.net_src, &pinfo->net_src);
+	copy_address(&common_tags_cache.net_dst, &pinfo->net_dst);
+	common_tags_cache.ptype = pinfo->ptype;
+	common_tags_cache.srcport = pinfo->srcport;
+	common_tags_cache.destport = pinfo->destport;
+	common_tags_cache.tlv_buffer = (uint8_t *)g_memdup2(exp_pdu_data->tlv_buffer,
+		exp_pdu_data->tlv_buffer_len);
+	common_tags_cache.tlv_buffer_len = exp_pdu_data->tlv_buffer_len;
+	common_tags_cache.valid = true;
+
+	return exp_pdu_data;
 }
 
 /**
@@ -328,6 +399,7 @@ void export_pdu_init(void)
 
 void export_pdu_cleanup(void)
 {
+	common_tags_cache_reset();
 	g_slist_free_full(export_pdu_tap_name_list, g_free);
 }
 
@@ -230,7 +230,8 @@ follow_tvb_tap_listener(void *tapdata, packet_info *pinfo,
         copy_address(&follow_info->server_ip, &pinfo->dst);
     }
 
-    if (addresses_equal(&follow_info->client_ip, &pinfo->src) && follow_info->client_port == pinfo->srcport)
+    /* Cheap port comparison first; the address comparison may memcmp. */
+    if (follow_info->client_port == pinfo->srcport && addresses_equal(&follow_info->client_ip, &pinfo->src))
         follow_record->is_server = false;
     else
         follow_record->is_server = true;
@@ -233,6 +233,7 @@ frame_data_init(frame_data *fdata, uint32_t num, const wtap_rec *rec,
   fdata->color_filter = NULL;
   fdata->shift_offset.secs = 0;
   fdata->shift_offset.nsecs = 0;
+  fdata->dissect_gen = 0;
   fdata->frame_ref_num = 0;
   fdata->prev_dis_num = 0;
 }
@@ -303,6 +304,61 @@ frame_data_set_after_dissect(frame_data *fdata,
   }
 }
 
+/*
+ * Find the first entry >= frame_num in the sorted dependent frame array,
+ * returning deps->len if there is none.  The halving step uses an
+ * arithmetic select rather than a taken/not-taken branch, so lookups
+ * stay cheap on the second pass even though the branch predictor has no
+ * useful history for any individual frame's array.
+ */
+static unsigned
+dependent_frames_lower_bound(const GArray *deps, uint32_t frame_num)
+{
+  const uint32_t *start = (const uint32_t *)(void *)deps->data;
+  const uint32_t *base  = start;
+  unsigned        len   = deps->len;
+  unsigned        half;
+
+  while (len > 1) {
+    half = len / 2;
+    base += (base[half - 1] < frame_num) ? half : 0;
+    len -= half;
+  }
+  if (len == 1 && base[0] < frame_num)
+    base++;
+  return (unsigned)(base - start);
+}
+
+void
+frame_data_add_dependent_frame(frame_data *fdata, uint32_t frame_num)
+{
+  unsigned idx;
+
+  if (fdata->dependent_frames == NULL)
+    fdata->dependent_frames = g_array_new(false, false, sizeof(uint32_t));
+
+  idx = dependent_frames_lower_bound(fdata->dependent_frames, frame_num);
+  if (idx < fdata->dependent_frames->len &&
+      g_array_index(fdata->dependent_frames, uint32_t, idx) == frame_num) {
+    /* Already recorded. */
+    return;
+  }
+  g_array_insert_val(fdata->dependent_frames, idx, frame_num);
+}
+
+bool
+frame_data_depends_on_frame(const frame_data *fdata, uint32_t frame_num)
+{
+  unsigned idx;
+
+  if (fdata->dependent_frames == NULL)
+    return false;
+
+  idx = dependent_frames_lower_bound(fdata->dependent_frames, frame_num);
+  return idx < fdata->dependent_frames->len &&
+         g_array_index(fdata->dependent_frames, uint32_t, idx) == frame_num;
+}
+
 void
 frame_data_reset(frame_data *fdata)
 {
@@ -314,7 +370,7 @@ frame_data_reset(frame_data *fdata)
   }
 
   if (fdata->dependent_frames) {
-    g_hash_table_destroy(fdata->dependent_frames);
+    g_array_free(fdata->dependent_frames, true);
     fdata->dependent_frames = NULL;
   }
 }
@@ -328,7 +384,7 @@ frame_data_destroy(frame_data *fdata)
   }
 
   if (fdata->dependent_frames) {
-    g_hash_table_destroy(fdata->dependent_frames);
+    g_array_free(fdata->dependent_frames, true);
     fdata->dependent_frames = NULL;
   }
 }
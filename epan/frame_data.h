@@ -70,7 +70,7 @@ typedef struct _frame_data {
      LLP64 (64-bit Windows) platforms.  Put them here, one after the
      other, so they don't require padding between them. */
   GSList      *pfd;          /**< Per frame proto data */
-  GHashTable  *dependent_frames;     /**< A hash table of frames which this one depends on */
+  GArray      *dependent_frames;     /**< Sorted array of frame numbers (uint32_t) which this one depends on */
   const struct _color_filter *color_filter;  /**< Per-packet matching color_filter_t object */
   uint8_t      tcp_snd_manual_analysis;   /**< TCP SEQ Analysis Overriding, 0 = none, 1 = OOO, 2 = RET , 3 = Fast RET, 4 = Spurious RET  */
   /* Keep the bitfields below to 24 bits, so this plus the previous field
@@ -91,6 +91,10 @@ typedef struct _frame_data {
   nstime_t     shift_offset; /**< How much the abs_tm of the frame is shifted */
   uint32_t     frame_ref_num; /**< Previous reference frame (0 if this is one) */
   uint32_t     prev_dis_num; /**< Previous displayed frame (0 if first one) */
+  uint32_t     dissect_gen;  /**< Generation counter stamped by the application when the
+                                  frame is (re-)dissected, so consumers working in the
+                                  background can detect per-frame staleness across a
+                                  redissection. This fits in the struct's trailing padding. */
 } frame_data;
 DIAG_ON_PEDANTIC
 
@@ -118,6 +122,17 @@ WS_DLL_PUBLIC void frame_data_set_before_dissect(frame_data *fdata,
 WS_DLL_PUBLIC void frame_data_set_after_dissect(frame_data *fdata,
                 uint32_t *cum_bytes);
 
+/**
+ * Records that fdata depends on frame number frame_num.  The dependent
+ * frame array is kept sorted and free of duplicates.
+ */
+WS_DLL_PUBLIC void frame_data_add_dependent_frame(frame_data *fdata,
+                uint32_t frame_num);
+
+/** Checks whether fdata records a dependency on frame number frame_num. */
+WS_DLL_PUBLIC bool frame_data_depends_on_frame(const frame_data *fdata,
+                uint32_t frame_num);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -13,9 +13,24 @@
 #include <glib.h>
 
 #include <epan/packet.h>
+#include <epan/prefs.h>
+
+#include <wsutil/file_util.h>
+#include <wsutil/tempfile.h>
 
 #include "frame_data_sequence.h"
 
+#ifndef _WIN32
+/*
+ * Bounded-memory mode spills frame_data leaf nodes to a temporary file
+ * with mmap; there's no equivalent implementation for Windows yet, so
+ * the budget preference is ignored there.
+ */
+#define FRAME_DATA_SPILL_POSSIBLE 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 /*
  * We store the frame_data structures in a radix tree, with 1024
  * elements per level.  The leaf nodes are arrays of 1024 frame_data
@@ -32,8 +47,18 @@
 struct _frame_data_sequence {
   uint32_t     count;           /* Total number of frames */
   void        *ptree_root;      /* Pointer to the root node */
+  /* Bounded-memory mode (see protocols.frame_data_spill_budget): leaf
+     nodes beyond the resident budget live in a temporary spill file
+     mapped into the address space rather than in ordinary memory. */
+  uint32_t     resident_leaves_max; /* Leaf node budget; 0 = unlimited */
+  uint32_t     resident_leaves;    /* Leaf nodes allocated with g_malloc */
+  int          spill_fd;           /* Spill file, or -1 if none yet */
+  int64_t      spill_size;         /* Current size of the spill file */
+  GHashTable  *spill_leaves;       /* Leaf pointers that live in the spill file */
 };
 
+#define LEAF_BYTES (sizeof(frame_data) * NODES_PER_LEVEL)
+
 /*
  * For a given frame number, calculate the indices into a level 3
  * node, a level 2 node, a level 1 node, and a leaf node.
@@ -55,9 +80,81 @@ new_frame_data_sequence(void)
   fds = (frame_data_sequence *)g_malloc(sizeof *fds);
   fds->count = 0;
   fds->ptree_root = NULL;
+  fds->resident_leaves_max = 0;
+  fds->resident_leaves = 0;
+  fds->spill_fd = -1;
+  fds->spill_size = 0;
+  fds->spill_leaves = NULL;
+#ifdef FRAME_DATA_SPILL_POSSIBLE
+  if (prefs.frame_data_spill_budget > 0) {
+    uint64_t budget_bytes =
+        (uint64_t)prefs.frame_data_spill_budget * 1024 * 1024;
+    fds->resident_leaves_max = (uint32_t)MAX(1, budget_bytes / LEAF_BYTES);
+  }
+#endif
   return fds;
 }
 
+/*
+ * Allocate a leaf node.  In bounded-memory mode, leaves beyond the
+ * resident budget are carved out of an unlinked temporary file and
+ * mapped MAP_SHARED: the kernel can write their pages back and evict
+ * them under memory pressure and faults them back in on access, while
+ * the mapping address - and thus every frame_data pointer we've handed
+ * out - stays stable for the life of the sequence.  If the spill file
+ * can't be created or mapped we fall back to an ordinary allocation.
+ */
+static frame_data *
+frame_data_sequence_alloc_leaf(frame_data_sequence *fds)
+{
+#ifdef FRAME_DATA_SPILL_POSSIBLE
+  if (fds->resident_leaves_max != 0 &&
+      fds->resident_leaves >= fds->resident_leaves_max) {
+    void *leaf;
+
+    if (fds->spill_fd == -1) {
+      char *namebuf = NULL;
+
+      fds->spill_fd = create_tempfile(NULL, &namebuf, "wireshark_fdata",
+                                      NULL, NULL);
+      if (fds->spill_fd != -1) {
+        /* Unlink it immediately; the file lives on until it's closed. */
+        ws_unlink(namebuf);
+      }
+      g_free(namebuf);
+    }
+    if (fds->spill_fd != -1 &&
+        ftruncate(fds->spill_fd, fds->spill_size + (int64_t)LEAF_BYTES) != -1) {
+      leaf = mmap(NULL, LEAF_BYTES, PROT_READ|PROT_WRITE, MAP_SHARED,
+                  fds->spill_fd, (off_t)fds->spill_size);
+      if (leaf != MAP_FAILED) {
+        fds->spill_size += (int64_t)LEAF_BYTES;
+        if (fds->spill_leaves == NULL) {
+          fds->spill_leaves = g_hash_table_new(g_direct_hash, g_direct_equal);
+        }
+        g_hash_table_add(fds->spill_leaves, leaf);
+        return (frame_data *)leaf;
+      }
+    }
+  }
+#endif
+  fds->resident_leaves++;
+  return (frame_data *)g_malloc(LEAF_BYTES);
+}
+
+static void
+frame_data_sequence_free_leaf(frame_data_sequence *fds, void *leaf)
+{
+#ifdef FRAME_DATA_SPILL_POSSIBLE
+  if (fds->spill_leaves != NULL &&
+      g_hash_table_remove(fds->spill_leaves, leaf)) {
+    munmap(leaf, LEAF_BYTES);
+    return;
+  }
+#endif
+  g_free(leaf);
+}
+
 /*
  * Add a new frame_data structure to a frame_data_sequence.
  */
@@ -80,7 +177,7 @@ frame_data_sequence_add(frame_data_sequence *fds, frame_data *fdata)
   if (fds->count == 0) {
     /* The tree is empty; allocate the first leaf node, which will be
        the root node. */
-    leaf = (frame_data *)g_malloc((sizeof *leaf)*NODES_PER_LEVEL);
+    leaf = frame_data_sequence_alloc_leaf(fds);
     node = &leaf[0];
     fds->ptree_root = leaf;
   } else if (fds->count < NODES_PER_LEVEL) {
@@ -91,7 +188,7 @@ frame_data_sequence_add(frame_data_sequence *fds, frame_data *fdata)
     /* It's a 1-level tree that will turn into a 2-level tree. */
     level1 = (frame_data **)g_malloc0((sizeof *level1)*NODES_PER_LEVEL);
     level1[0] = (frame_data *)fds->ptree_root;
-    leaf = (frame_data *)g_malloc((sizeof *leaf)*NODES_PER_LEVEL);
+    leaf = frame_data_sequence_alloc_leaf(fds);
     level1[1] = leaf;
     node = &leaf[0];
     fds->ptree_root = level1;
@@ -100,7 +197,7 @@ frame_data_sequence_add(frame_data_sequence *fds, frame_data *fdata)
     level1 = (frame_data **)fds->ptree_root;
     leaf = level1[fds->count >> LOG2_NODES_PER_LEVEL];
     if (leaf == NULL) {
-      leaf = (frame_data *)g_malloc((sizeof *leaf)*NODES_PER_LEVEL);
+      leaf = frame_data_sequence_alloc_leaf(fds);
       level1[fds->count >> LOG2_NODES_PER_LEVEL] = leaf;
     }
     node = &leaf[LEAF_INDEX(fds->count)];
@@ -110,7 +207,7 @@ frame_data_sequence_add(frame_data_sequence *fds, frame_data *fdata)
     level2[0] = (frame_data **)fds->ptree_root;
     level1 = (frame_data **)g_malloc0((sizeof *level1)*NODES_PER_LEVEL);
     level2[1] = level1;
-    leaf = (frame_data *)g_malloc((sizeof *leaf)*NODES_PER_LEVEL);
+    leaf = frame_data_sequence_alloc_leaf(fds);
     level1[0] = leaf;
     node = &leaf[0];
     fds->ptree_root = level2;
@@ -124,7 +221,7 @@ frame_data_sequence_add(frame_data_sequence *fds, frame_data *fdata)
     }
     leaf = level1[LEVEL_1_INDEX(fds->count)];
     if (leaf == NULL) {
-      leaf = (frame_data *)g_malloc((sizeof *leaf)*NODES_PER_LEVEL);
+      leaf = frame_data_sequence_alloc_leaf(fds);
       level1[LEVEL_1_INDEX(fds->count)] = leaf;
     }
     node = &leaf[LEAF_INDEX(fds->count)];
@@ -136,7 +233,7 @@ frame_data_sequence_add(frame_data_sequence *fds, frame_data *fdata)
     level3[1] = level2;
     level1 = (frame_data **)g_malloc0((sizeof *level1)*NODES_PER_LEVEL);
     level2[0] = level1;
-    leaf = (frame_data *)g_malloc((sizeof *leaf)*NODES_PER_LEVEL);
+    leaf = frame_data_sequence_alloc_leaf(fds);
     level1[0] = leaf;
     node = &leaf[0];
     fds->ptree_root = level3;
@@ -162,7 +259,7 @@ frame_data_sequence_add(frame_data_sequence *fds, frame_data *fdata)
     }
     leaf = level1[LEVEL_1_INDEX(fds->count)];
     if (leaf == NULL) {
-      leaf = (frame_data *)g_malloc((sizeof *leaf)*NODES_PER_LEVEL);
+      leaf = frame_data_sequence_alloc_leaf(fds);
       level1[LEVEL_1_INDEX(fds->count)] = leaf;
     }
     node = &leaf[LEAF_INDEX(fds->count)];
@@ -227,7 +324,8 @@ frame_data_sequence_find(frame_data_sequence *fds, uint32_t num)
 /* recursively frees a frame_data radix level */
 static void
 // NOLINTNEXTLINE(misc-no-recursion)
-free_frame_data_array(void *array, unsigned count, unsigned level, bool last)
+free_frame_data_array(frame_data_sequence *fds, void *array, unsigned count,
+                      unsigned level, bool last)
 {
   unsigned i, level_count;
 
@@ -257,11 +355,14 @@ free_frame_data_array(void *array, unsigned count, unsigned level, bool last)
 
     for (i=0; i < level_count-1; i++) {
       // We recurse here, but we're limited to four levels.
-      free_frame_data_array(real_array[i], count, level-1, false);
+      free_frame_data_array(fds, real_array[i], count, level-1, false);
     }
 
     // We recurse here, but we're limited to four levels.
-    free_frame_data_array(real_array[level_count-1], count, level-1, last);
+    free_frame_data_array(fds, real_array[level_count-1], count, level-1, last);
+
+    /* free the array itself */
+    g_free(array);
   }
   else if (level == 1) {
     /* bottom level, so just clean up all the frame data */
@@ -270,10 +371,10 @@ free_frame_data_array(void *array, unsigned count, unsigned level, bool last)
     for (i=0; i < level_count; i++) {
       frame_data_destroy(&real_array[i]);
     }
-  }
 
-  /* free the array itself */
-  g_free(array);
+    /* free the leaf itself; it may live in the spill file */
+    frame_data_sequence_free_leaf(fds, array);
+  }
 }
 
 /*
@@ -307,30 +408,385 @@ free_frame_data_sequence(frame_data_sequence *fds)
 
   /* call the recursive free function */
   if (levels > 0) {
-    free_frame_data_array(fds->ptree_root, fds->count, levels, true);
+    free_frame_data_array(fds, fds->ptree_root, fds->count, levels, true);
   }
 
+#ifdef FRAME_DATA_SPILL_POSSIBLE
+  if (fds->spill_leaves != NULL) {
+    g_hash_table_destroy(fds->spill_leaves);
+  }
+  if (fds->spill_fd != -1) {
+    ws_close(fds->spill_fd);
+  }
+#endif
+
   /* free the header struct */
   g_free(fds);
 }
 
+/*
+ * Compact sequence.
+ *
+ * Frames are packed COMPACT_FRAMES_PER_CHUNK to a chunk, as one byte
+ * stream per chunk.  Each frame starts with a varint of flag bits -
+ * the frame_data bitfield flags plus bits saying which of the rarely
+ * interesting fields follow explicitly - and is followed by varints
+ * for the packet length and for the file offset and timestamp, the
+ * latter two as zigzag deltas from the previous frame.  Fields that
+ * almost always follow a pattern (cap_len == pkt_len, cum_bytes
+ * advancing by pkt_len, prev_dis_num == num - 1) cost nothing unless
+ * they deviate from it.
+ *
+ * Random access re-decodes from the start of the frame's chunk; a
+ * cursor remembers the last decode position so that in-order scans
+ * pick up where they left off.
+ */
+#define COMPACT_FRAMES_PER_CHUNK 1024
+
+/* Frame flag bits, as stored; the low bits mirror the frame_data
+   bitfields. */
+#define COMPACT_F_PASSED_DFILTER    (1U << 0)
+#define COMPACT_F_DEPENDENT_OF_DISP (1U << 1)
+#define COMPACT_F_ENCODING          (1U << 2)
+#define COMPACT_F_VISITED           (1U << 3)
+#define COMPACT_F_MARKED            (1U << 4)
+#define COMPACT_F_REF_TIME          (1U << 5)
+#define COMPACT_F_IGNORED           (1U << 6)
+#define COMPACT_F_HAS_TS            (1U << 7)
+#define COMPACT_F_HAS_MODIFIED_BLOCK (1U << 8)
+#define COMPACT_F_NEED_COLORIZE     (1U << 9)
+#define COMPACT_F_TSPREC_SHIFT      10
+#define COMPACT_F_TSPREC_MASK       (0xFU << COMPACT_F_TSPREC_SHIFT)
+/* Bits saying which explicit fields follow. */
+#define COMPACT_F_CAP_LEN_DIFFERS   (1U << 14)
+#define COMPACT_F_CUM_BYTES_DIFFER  (1U << 15)
+#define COMPACT_F_TCP_ANALYSIS      (1U << 16)
+#define COMPACT_F_REF_NUM_DIFFERS   (1U << 17)
+#define COMPACT_F_PREV_DIS_DIFFERS  (1U << 18)
+
+/* Predictor state: the encoded values of the previous frame. */
+typedef struct {
+  int64_t  file_off;
+  nstime_t abs_ts;
+  uint32_t cum_bytes;
+  uint32_t frame_ref_num;
+} compact_prev_state;
+
+typedef struct {
+  uint8_t  *data;
+  unsigned  data_len;
+} compact_chunk;
+
+struct _compact_frame_data_sequence {
+  uint32_t    count;         /* Total number of frames */
+  GArray     *chunks;        /* Sealed chunks, of compact_chunk */
+  GArray     *chunk_bases;   /* Predictor state at the start of each sealed chunk */
+  GByteArray *open;          /* Chunk currently being appended to */
+  compact_prev_state open_base;  /* Predictor state at the start of the open chunk */
+  compact_prev_state prev;       /* Predictor state after the last frame added */
+  /* Decode cursor */
+  uint32_t    cursor_next;   /* Frame number the cursor will decode next; 0 if unset */
+  unsigned    cursor_pos;    /* Byte position of the cursor within its chunk */
+  compact_prev_state cursor_prev;
+};
+
+static void
+compact_put_uvarint(GByteArray *out, uint64_t val)
+{
+  uint8_t byte;
+
+  do {
+    byte = val & 0x7F;
+    val >>= 7;
+    if (val != 0)
+      byte |= 0x80;
+    g_byte_array_append(out, &byte, 1);
+  } while (val != 0);
+}
+
+static uint64_t
+compact_get_uvarint(const uint8_t *data, unsigned *pos)
+{
+  uint64_t val = 0;
+  unsigned shift = 0;
+  uint8_t byte;
+
+  do {
+    byte = data[(*pos)++];
+    val |= (uint64_t)(byte & 0x7F) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  return val;
+}
+
+static uint64_t
+compact_zigzag(int64_t val)
+{
+  return ((uint64_t)val << 1) ^ (uint64_t)(val >> 63);
+}
+
+static int64_t
+compact_unzigzag(uint64_t val)
+{
+  return (int64_t)(val >> 1) ^ -(int64_t)(val & 1);
+}
+
+compact_frame_data_sequence *
+new_compact_frame_data_sequence(void)
+{
+  compact_frame_data_sequence *cfds;
+
+  cfds = g_new0(compact_frame_data_sequence, 1);
+  cfds->chunks = g_array_new(false, false, sizeof(compact_chunk));
+  cfds->chunk_bases = g_array_new(false, false, sizeof(compact_prev_state));
+  cfds->open = g_byte_array_new();
+  return cfds;
+}
+
+/* Move the open chunk, now full, onto the list of sealed chunks. */
+static void
+compact_seal_chunk(compact_frame_data_sequence *cfds)
+{
+  compact_chunk chunk;
+
+  chunk.data_len = cfds->open->len;
+  chunk.data = g_byte_array_free(cfds->open, false);
+  g_array_append_val(cfds->chunks, chunk);
+  g_array_append_val(cfds->chunk_bases, cfds->open_base);
+  cfds->open = g_byte_array_new();
+  cfds->open_base = cfds->prev;
+}
+
+bool
+compact_frame_data_sequence_add(compact_frame_data_sequence *cfds,
+                                const frame_data *fdata)
+{
+  uint32_t num = cfds->count + 1;
+  uint32_t flags;
+
+  /* Frames carrying dissection state can't be reconstructed from
+     packed columns. */
+  if (fdata->pfd != NULL || fdata->dependent_frames != NULL ||
+      fdata->color_filter != NULL || !nstime_is_zero(&fdata->shift_offset))
+    return false;
+  if (fdata->num != num)
+    return false;
+
+  if (cfds->count != 0 && (cfds->count % COMPACT_FRAMES_PER_CHUNK) == 0)
+    compact_seal_chunk(cfds);
+
+  flags = 0;
+  if (fdata->passed_dfilter)
+    flags |= COMPACT_F_PASSED_DFILTER;
+  if (fdata->dependent_of_displayed)
+    flags |= COMPACT_F_DEPENDENT_OF_DISP;
+  if (fdata->encoding)
+    flags |= COMPACT_F_ENCODING;
+  if (fdata->visited)
+    flags |= COMPACT_F_VISITED;
+  if (fdata->marked)
+    flags |= COMPACT_F_MARKED;
+  if (fdata->ref_time)
+    flags |= COMPACT_F_REF_TIME;
+  if (fdata->ignored)
+    flags |= COMPACT_F_IGNORED;
+  if (fdata->has_ts)
+    flags |= COMPACT_F_HAS_TS;
+  if (fdata->has_modified_block)
+    flags |= COMPACT_F_HAS_MODIFIED_BLOCK;
+  if (fdata->need_colorize)
+    flags |= COMPACT_F_NEED_COLORIZE;
+  flags |= (fdata->tsprec << COMPACT_F_TSPREC_SHIFT) & COMPACT_F_TSPREC_MASK;
+  if (fdata->cap_len != fdata->pkt_len)
+    flags |= COMPACT_F_CAP_LEN_DIFFERS;
+  if (fdata->cum_bytes != cfds->prev.cum_bytes + fdata->pkt_len)
+    flags |= COMPACT_F_CUM_BYTES_DIFFER;
+  if (fdata->tcp_snd_manual_analysis != 0)
+    flags |= COMPACT_F_TCP_ANALYSIS;
+  if (fdata->frame_ref_num != cfds->prev.frame_ref_num)
+    flags |= COMPACT_F_REF_NUM_DIFFERS;
+  if (fdata->prev_dis_num != num - 1)
+    flags |= COMPACT_F_PREV_DIS_DIFFERS;
+
+  compact_put_uvarint(cfds->open, flags);
+  compact_put_uvarint(cfds->open, fdata->pkt_len);
+  if (flags & COMPACT_F_CAP_LEN_DIFFERS)
+    compact_put_uvarint(cfds->open, fdata->cap_len);
+  compact_put_uvarint(cfds->open,
+      compact_zigzag(fdata->file_off - cfds->prev.file_off));
+  compact_put_uvarint(cfds->open,
+      compact_zigzag((int64_t)fdata->abs_ts.secs - (int64_t)cfds->prev.abs_ts.secs));
+  compact_put_uvarint(cfds->open,
+      compact_zigzag((int64_t)fdata->abs_ts.nsecs - (int64_t)cfds->prev.abs_ts.nsecs));
+  if (flags & COMPACT_F_CUM_BYTES_DIFFER)
+    compact_put_uvarint(cfds->open,
+        compact_zigzag((int64_t)fdata->cum_bytes - (int64_t)cfds->prev.cum_bytes));
+  if (flags & COMPACT_F_TCP_ANALYSIS)
+    compact_put_uvarint(cfds->open, fdata->tcp_snd_manual_analysis);
+  if (flags & COMPACT_F_REF_NUM_DIFFERS)
+    compact_put_uvarint(cfds->open,
+        compact_zigzag((int64_t)fdata->frame_ref_num - (int64_t)cfds->prev.frame_ref_num));
+  if (flags & COMPACT_F_PREV_DIS_DIFFERS)
+    compact_put_uvarint(cfds->open,
+        compact_zigzag((int64_t)fdata->prev_dis_num - (int64_t)(num - 1)));
+
+  cfds->prev.file_off = fdata->file_off;
+  cfds->prev.abs_ts = fdata->abs_ts;
+  cfds->prev.cum_bytes = fdata->cum_bytes;
+  cfds->prev.frame_ref_num = fdata->frame_ref_num;
+  cfds->count++;
+  return true;
+}
+
+uint32_t
+compact_frame_data_sequence_count(const compact_frame_data_sequence *cfds)
+{
+  return cfds->count;
+}
+
+/* Decode the frame at *pos, filling in fdata and advancing prev. */
+static void
+compact_decode_frame(const uint8_t *data, unsigned *pos, uint32_t num,
+                     compact_prev_state *prev, frame_data *fdata)
+{
+  uint32_t flags;
+
+  memset(fdata, 0, sizeof *fdata);
+  fdata->num = num;
+
+  flags = (uint32_t)compact_get_uvarint(data, pos);
+  fdata->passed_dfilter = (flags & COMPACT_F_PASSED_DFILTER) ? 1 : 0;
+  fdata->dependent_of_displayed = (flags & COMPACT_F_DEPENDENT_OF_DISP) ? 1 : 0;
+  fdata->encoding = (flags & COMPACT_F_ENCODING) ? 1 : 0;
+  fdata->visited = (flags & COMPACT_F_VISITED) ? 1 : 0;
+  fdata->marked = (flags & COMPACT_F_MARKED) ? 1 : 0;
+  fdata->ref_time = (flags & COMPACT_F_REF_TIME) ? 1 : 0;
+  fdata->ignored = (flags & COMPACT_F_IGNORED) ? 1 : 0;
+  fdata->has_ts = (flags & COMPACT_F_HAS_TS) ? 1 : 0;
+  fdata->has_modified_block = (flags & COMPACT_F_HAS_MODIFIED_BLOCK) ? 1 : 0;
+  fdata->need_colorize = (flags & COMPACT_F_NEED_COLORIZE) ? 1 : 0;
+  fdata->tsprec = (flags & COMPACT_F_TSPREC_MASK) >> COMPACT_F_TSPREC_SHIFT;
+
+  fdata->pkt_len = (uint32_t)compact_get_uvarint(data, pos);
+  if (flags & COMPACT_F_CAP_LEN_DIFFERS)
+    fdata->cap_len = (uint32_t)compact_get_uvarint(data, pos);
+  else
+    fdata->cap_len = fdata->pkt_len;
+  fdata->file_off = prev->file_off +
+      compact_unzigzag(compact_get_uvarint(data, pos));
+  fdata->abs_ts.secs = (time_t)((int64_t)prev->abs_ts.secs +
+      compact_unzigzag(compact_get_uvarint(data, pos)));
+  fdata->abs_ts.nsecs = (int)((int64_t)prev->abs_ts.nsecs +
+      compact_unzigzag(compact_get_uvarint(data, pos)));
+  if (flags & COMPACT_F_CUM_BYTES_DIFFER)
+    fdata->cum_bytes = (uint32_t)((int64_t)prev->cum_bytes +
+        compact_unzigzag(compact_get_uvarint(data, pos)));
+  else
+    fdata->cum_bytes = prev->cum_bytes + fdata->pkt_len;
+  if (flags & COMPACT_F_TCP_ANALYSIS)
+    fdata->tcp_snd_manual_analysis =
+        (uint8_t)compact_get_uvarint(data, pos);
+  if (flags & COMPACT_F_REF_NUM_DIFFERS)
+    fdata->frame_ref_num = (uint32_t)((int64_t)prev->frame_ref_num +
+        compact_unzigzag(compact_get_uvarint(data, pos)));
+  else
+    fdata->frame_ref_num = prev->frame_ref_num;
+  if (flags & COMPACT_F_PREV_DIS_DIFFERS)
+    fdata->prev_dis_num = (uint32_t)((int64_t)(num - 1) +
+        compact_unzigzag(compact_get_uvarint(data, pos)));
+  else
+    fdata->prev_dis_num = num - 1;
+
+  prev->file_off = fdata->file_off;
+  prev->abs_ts = fdata->abs_ts;
+  prev->cum_bytes = fdata->cum_bytes;
+  prev->frame_ref_num = fdata->frame_ref_num;
+}
+
+bool
+compact_frame_data_sequence_materialize(compact_frame_data_sequence *cfds,
+                                        uint32_t num, frame_data *fdata)
+{
+  uint32_t chunk_index;
+  const uint8_t *data;
+
+  if (num == 0 || cfds == NULL || num > cfds->count) {
+    /* There is no such frame. */
+    return false;
+  }
+
+  /* If the cursor isn't already positioned at or before the frame,
+     within the frame's chunk, restart at the start of that chunk. */
+  chunk_index = (num - 1) / COMPACT_FRAMES_PER_CHUNK;
+  if (cfds->cursor_next == 0 || cfds->cursor_next > num ||
+      (cfds->cursor_next - 1) / COMPACT_FRAMES_PER_CHUNK != chunk_index) {
+    cfds->cursor_next = chunk_index * COMPACT_FRAMES_PER_CHUNK + 1;
+    cfds->cursor_pos = 0;
+    if (chunk_index < cfds->chunks->len)
+      cfds->cursor_prev = g_array_index(cfds->chunk_bases,
+                                        compact_prev_state, chunk_index);
+    else
+      cfds->cursor_prev = cfds->open_base;
+  }
+
+  /* The open chunk's data may move as frames are appended, so look the
+     pointer up on every call. */
+  if (chunk_index < cfds->chunks->len)
+    data = g_array_index(cfds->chunks, compact_chunk, chunk_index).data;
+  else
+    data = cfds->open->data;
+
+  for (;;) {
+    compact_decode_frame(data, &cfds->cursor_pos, cfds->cursor_next,
+                         &cfds->cursor_prev, fdata);
+    if (cfds->cursor_next == num) {
+      cfds->cursor_next++;
+      if ((cfds->cursor_next - 1) % COMPACT_FRAMES_PER_CHUNK == 0) {
+        /* The cursor crossed into the next chunk, which has its own
+           byte stream. */
+        cfds->cursor_pos = 0;
+      }
+      return true;
+    }
+    cfds->cursor_next++;
+  }
+}
+
+void
+free_compact_frame_data_sequence(compact_frame_data_sequence *cfds)
+{
+  unsigned i;
+
+  for (i = 0; i < cfds->chunks->len; i++)
+    g_free(g_array_index(cfds->chunks, compact_chunk, i).data);
+  g_array_free(cfds->chunks, true);
+  g_array_free(cfds->chunk_bases, true);
+  g_byte_array_free(cfds->open, true);
+  g_free(cfds);
+}
+
 void
-find_and_mark_frame_depended_upon(void *key, void *value _U_, void *user_data)
+find_and_mark_frames_depended_upon(frame_data_sequence *frames,
+                                   const GArray *dependent_frames)
 {
   frame_data   *dependent_fd;
-  uint32_t      dependent_frame = GPOINTER_TO_UINT(key);
-  frame_data_sequence *frames   = (frame_data_sequence *)user_data;
+  uint32_t      dependent_frame;
+  unsigned      i;
+
+  if (!frames || !dependent_frames)
+    return;
 
-  if (dependent_frame && frames) {
+  for (i = 0; i < dependent_frames->len; i++) {
+    dependent_frame = g_array_index(dependent_frames, uint32_t, i);
+    if (dependent_frame == 0)
+      continue;
     dependent_fd = frame_data_sequence_find(frames, dependent_frame);
     /* Don't recurse for packets we've already marked. Note we assume that no
      * packet depends on a future packet; we assume that in other places too.
      */
     if (!(dependent_fd->dependent_of_displayed || dependent_fd->passed_dfilter)) {
       dependent_fd->dependent_of_displayed = 1;
-      if (dependent_fd->dependent_frames) {
-        g_hash_table_foreach(dependent_fd->dependent_frames, find_and_mark_frame_depended_upon, frames);
-      }
+      find_and_mark_frames_depended_upon(frames, dependent_fd->dependent_frames);
     }
   }
 }
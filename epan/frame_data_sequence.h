@@ -33,7 +33,57 @@ WS_DLL_PUBLIC frame_data *frame_data_sequence_find(frame_data_sequence *fds,
  */
 WS_DLL_PUBLIC void free_frame_data_sequence(frame_data_sequence *fds);
 
-WS_DLL_PUBLIC void find_and_mark_frame_depended_upon(void *key, void *value, void *user_data);
+/*
+ * Walk a sorted dependent frame array (frame_data.dependent_frames) and
+ * mark every frame in it - and, recursively, every frame those frames
+ * depend on - as depended upon by a displayed frame.
+ */
+WS_DLL_PUBLIC void find_and_mark_frames_depended_upon(frame_data_sequence *frames,
+    const GArray *dependent_frames);
+
+/*
+ * Compact, append-only variant of a frame_data_sequence.
+ *
+ * A frame_data_sequence hands out stable pointers to mutable frame_data
+ * structures, which the dissection engine and the UIs rely on; that
+ * forces it to store the full structure for every frame.  When all
+ * that's needed later is to reconstruct the values a frame had when it
+ * was added - its flags, lengths, file offset and timestamp - the
+ * frames can instead be packed into per-chunk columns, with the file
+ * offset and timestamp stored as varint-encoded deltas from the
+ * previous frame, costing on the order of 16 bytes per frame rather
+ * than sizeof(frame_data).
+ *
+ * Frames must be added in order, and frames that carry dissection state
+ * (per-frame proto data, dependent frames, a color filter match or a
+ * time shift) can't be packed; compact_frame_data_sequence_add()
+ * refuses them, and the caller must use a full frame_data_sequence
+ * instead.
+ *
+ * Decoding is sequential within a chunk; a cursor makes in-order scans
+ * cheap, while random access costs at most one chunk decode.
+ */
+typedef struct _compact_frame_data_sequence compact_frame_data_sequence;
+
+WS_DLL_PUBLIC compact_frame_data_sequence *new_compact_frame_data_sequence(void);
+
+/*
+ * Append a frame.  Returns false, without adding the frame, if it
+ * isn't the next frame in order or carries state that can't be packed.
+ */
+WS_DLL_PUBLIC bool compact_frame_data_sequence_add(compact_frame_data_sequence *cfds,
+    const frame_data *fdata);
+
+WS_DLL_PUBLIC uint32_t compact_frame_data_sequence_count(const compact_frame_data_sequence *cfds);
+
+/*
+ * Reconstruct the frame_data for the specified frame number into
+ * caller-provided storage.  Returns false if there's no such frame.
+ */
+WS_DLL_PUBLIC bool compact_frame_data_sequence_materialize(compact_frame_data_sequence *cfds,
+    uint32_t num, frame_data *fdata);
+
+WS_DLL_PUBLIC void free_compact_frame_data_sequence(compact_frame_data_sequence *cfds);
 
 
 #ifdef __cplusplus
@@ -0,0 +1,240 @@
+/* frame_data_sequence_test.c
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+#undef G_DISABLE_ASSERT
+
+#include <stdio.h>
+#include <string.h>
+#include <glib.h>
+
+#include <epan/frame_data.h>
+
+#include "frame_data_sequence.h"
+
+/* Simple deterministic generator, so every run packs the same frames. */
+static uint32_t prng_state;
+
+static uint32_t
+prng_next(void)
+{
+    prng_state = prng_state * 1103515245 + 12345;
+    return (prng_state >> 16) & 0x7FFF;
+}
+
+/* Build the frame_data for frame number num the way a capture pass
+   would: lengths and timestamps vary, offsets and times only move
+   forward, and the occasional frame deviates from the usual patterns
+   (snapshot length applied, time reference set, display gaps). */
+static void
+make_fdata(frame_data *fdata, uint32_t num, int64_t *file_off,
+           nstime_t *ts, uint32_t *cum_bytes, uint32_t *ref_num)
+{
+    memset(fdata, 0, sizeof *fdata);
+    fdata->num = num;
+    fdata->pkt_len = 64 + prng_next() % 1460;
+    fdata->cap_len = (prng_next() % 16 == 0) ? 64 : fdata->pkt_len;
+    *file_off += fdata->cap_len + 32;
+    fdata->file_off = *file_off;
+    ts->secs += prng_next() % 2;
+    ts->nsecs += (int)(prng_next() % 1000000);
+    if (ts->nsecs >= 1000000000)
+        ts->nsecs -= 1000000000;
+    fdata->abs_ts = *ts;
+    fdata->has_ts = 1;
+    fdata->tsprec = 6;
+    fdata->visited = 1;
+    fdata->passed_dfilter = (prng_next() % 4 != 0) ? 1 : 0;
+    fdata->marked = (prng_next() % 100 == 0) ? 1 : 0;
+    if (prng_next() % 500 == 0) {
+        fdata->ref_time = 1;
+        *ref_num = num;
+    }
+    fdata->frame_ref_num = *ref_num;
+    fdata->prev_dis_num = (prng_next() % 8 == 0 && num > 2) ? num - 2 : num - 1;
+    if (prng_next() % 50 == 0)
+        fdata->tcp_snd_manual_analysis = 1 + prng_next() % 4;
+    *cum_bytes += fdata->pkt_len;
+    fdata->cum_bytes = *cum_bytes;
+}
+
+static void
+assert_fdata_equal(const frame_data *expected, const frame_data *actual)
+{
+    g_assert_cmpuint(expected->num, ==, actual->num);
+    g_assert_cmpuint(expected->pkt_len, ==, actual->pkt_len);
+    g_assert_cmpuint(expected->cap_len, ==, actual->cap_len);
+    g_assert_cmpuint(expected->cum_bytes, ==, actual->cum_bytes);
+    g_assert_cmpint(expected->file_off, ==, actual->file_off);
+    g_assert_cmpint(expected->abs_ts.secs, ==, actual->abs_ts.secs);
+    g_assert_cmpint(expected->abs_ts.nsecs, ==, actual->abs_ts.nsecs);
+    g_assert_cmpuint(expected->passed_dfilter, ==, actual->passed_dfilter);
+    g_assert_cmpuint(expected->visited, ==, actual->visited);
+    g_assert_cmpuint(expected->marked, ==, actual->marked);
+    g_assert_cmpuint(expected->ref_time, ==, actual->ref_time);
+    g_assert_cmpuint(expected->ignored, ==, actual->ignored);
+    g_assert_cmpuint(expected->has_ts, ==, actual->has_ts);
+    g_assert_cmpuint(expected->tsprec, ==, actual->tsprec);
+    g_assert_cmpuint(expected->tcp_snd_manual_analysis, ==, actual->tcp_snd_manual_analysis);
+    g_assert_cmpuint(expected->frame_ref_num, ==, actual->frame_ref_num);
+    g_assert_cmpuint(expected->prev_dis_num, ==, actual->prev_dis_num);
+}
+
+#define TEST_FRAME_COUNT 3000   /* spans several chunks */
+
+// Sequential add and in-order materialization round-trips every field
+static void
+test_compact_sequential(void)
+{
+    compact_frame_data_sequence *cfds;
+    frame_data fdata, decoded;
+    int64_t file_off = 0;
+    nstime_t ts = { 1700000000, 0 };
+    uint32_t cum_bytes = 0;
+    uint32_t ref_num = 1;
+    uint32_t num;
+
+    prng_state = 42;
+    cfds = new_compact_frame_data_sequence();
+    for (num = 1; num <= TEST_FRAME_COUNT; num++) {
+        make_fdata(&fdata, num, &file_off, &ts, &cum_bytes, &ref_num);
+        g_assert_true(compact_frame_data_sequence_add(cfds, &fdata));
+    }
+    g_assert_cmpuint(compact_frame_data_sequence_count(cfds), ==,
+                     TEST_FRAME_COUNT);
+
+    prng_state = 42;
+    file_off = 0;
+    ts.secs = 1700000000;
+    ts.nsecs = 0;
+    cum_bytes = 0;
+    ref_num = 1;
+    for (num = 1; num <= TEST_FRAME_COUNT; num++) {
+        make_fdata(&fdata, num, &file_off, &ts, &cum_bytes, &ref_num);
+        g_assert_true(compact_frame_data_sequence_materialize(cfds, num,
+                                                              &decoded));
+        assert_fdata_equal(&fdata, &decoded);
+    }
+    free_compact_frame_data_sequence(cfds);
+}
+
+// Random access matches the full frame_data_sequence for the same frames
+static void
+test_compact_random_access(void)
+{
+    compact_frame_data_sequence *cfds;
+    frame_data_sequence *fds;
+    frame_data fdata, decoded;
+    frame_data *stored;
+    int64_t file_off = 0;
+    nstime_t ts = { 1700000000, 0 };
+    uint32_t cum_bytes = 0;
+    uint32_t ref_num = 1;
+    uint32_t num;
+    unsigned i;
+
+    prng_state = 4711;
+    cfds = new_compact_frame_data_sequence();
+    fds = new_frame_data_sequence();
+    for (num = 1; num <= TEST_FRAME_COUNT; num++) {
+        make_fdata(&fdata, num, &file_off, &ts, &cum_bytes, &ref_num);
+        g_assert_true(compact_frame_data_sequence_add(cfds, &fdata));
+        frame_data_sequence_add(fds, &fdata);
+    }
+
+    /* Jump around, backwards and across chunk boundaries. */
+    for (i = 0; i < 1000; i++) {
+        num = 1 + (prng_next() * 37) % TEST_FRAME_COUNT;
+        stored = frame_data_sequence_find(fds, num);
+        g_assert_nonnull(stored);
+        g_assert_true(compact_frame_data_sequence_materialize(cfds, num,
+                                                              &decoded));
+        assert_fdata_equal(stored, &decoded);
+    }
+
+    /* Out-of-range lookups fail. */
+    g_assert_false(compact_frame_data_sequence_materialize(cfds, 0, &decoded));
+    g_assert_false(compact_frame_data_sequence_materialize(cfds,
+                                                           TEST_FRAME_COUNT + 1,
+                                                           &decoded));
+
+    free_frame_data_sequence(fds);
+    free_compact_frame_data_sequence(cfds);
+}
+
+// Frames that can't be packed, or arrive out of order, are refused
+static void
+test_compact_refusal(void)
+{
+    compact_frame_data_sequence *cfds;
+    frame_data fdata;
+    int64_t file_off = 0;
+    nstime_t ts = { 1700000000, 0 };
+    uint32_t cum_bytes = 0;
+    uint32_t ref_num = 1;
+
+    prng_state = 7;
+    cfds = new_compact_frame_data_sequence();
+
+    make_fdata(&fdata, 1, &file_off, &ts, &cum_bytes, &ref_num);
+    g_assert_true(compact_frame_data_sequence_add(cfds, &fdata));
+
+    /* Wrong frame number. */
+    make_fdata(&fdata, 5, &file_off, &ts, &cum_bytes, &ref_num);
+    g_assert_false(compact_frame_data_sequence_add(cfds, &fdata));
+
+    /* Dissection state attached. */
+    make_fdata(&fdata, 2, &file_off, &ts, &cum_bytes, &ref_num);
+    fdata.pfd = (GSList *)&fdata;   /* any non-null pointer */
+    g_assert_false(compact_frame_data_sequence_add(cfds, &fdata));
+    fdata.pfd = NULL;
+
+    /* Shifted time. */
+    fdata.shift_offset.secs = 1;
+    g_assert_false(compact_frame_data_sequence_add(cfds, &fdata));
+    fdata.shift_offset.secs = 0;
+
+    /* The same frame is accepted once it's clean again. */
+    g_assert_true(compact_frame_data_sequence_add(cfds, &fdata));
+    g_assert_cmpuint(compact_frame_data_sequence_count(cfds), ==, 2);
+
+    free_compact_frame_data_sequence(cfds);
+}
+
+int
+main(int argc, char **argv)
+{
+    int result;
+
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/frame_data_sequence/compact_sequential",
+                    test_compact_sequential);
+    g_test_add_func("/frame_data_sequence/compact_random_access",
+                    test_compact_random_access);
+    g_test_add_func("/frame_data_sequence/compact_refusal",
+                    test_compact_refusal);
+
+    result = g_test_run();
+
+    return result;
+}
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 4
+ * tab-width: 8
+ * indent-tabs-mode: nil
+ * End:
+ *
+ * vi: set shiftwidth=4 tabstop=8 expandtab:
+ * :indentSize=4:tabSize=8:noTabs=true:
+ */
@@ -303,6 +303,15 @@ ftype_can_eq(enum ftenum ftype)
 	return ft->compare != NULL;
 }
 
+bool
+ftype_can_hash(enum ftenum ftype)
+{
+	const ftype_t	*ft;
+
+	FTYPE_LOOKUP(ftype, ft);
+	return ft->hash != NULL;
+}
+
 bool
 ftype_can_cmp(enum ftenum ftype)
 {
@@ -1313,6 +1322,118 @@ fvalue_le(const fvalue_t *a, const fvalue_t *b)
 	return cmp <= 0 ? FT_TRUE : FT_FALSE;
 }
 
+/*
+ * Direct comparisons for the dominant field types, bypassing the
+ * per-type method table on the display filter hot path.  Same-name
+ * fields can put values of a different type next to each other, so
+ * every predicate falls back to the generic function unless both
+ * operands share its representation.
+ */
+#define CMP_DIRECT(classname, member, relname, relop, generic)		\
+static ft_bool_t							\
+classname##_##relname##_direct(const fvalue_t *a, const fvalue_t *b)	\
+{									\
+	if (G_UNLIKELY(a->ftype != b->ftype))				\
+		return generic(a, b);					\
+	return (a->value.member relop b->value.member) ? FT_TRUE : FT_FALSE; \
+}
+
+#define CMP_DIRECT_CLASS(classname, member)				\
+CMP_DIRECT(classname, member, eq, ==, fvalue_eq)			\
+CMP_DIRECT(classname, member, ne, !=, fvalue_ne)			\
+CMP_DIRECT(classname, member, gt, >,  fvalue_gt)			\
+CMP_DIRECT(classname, member, ge, >=, fvalue_ge)			\
+CMP_DIRECT(classname, member, lt, <,  fvalue_lt)			\
+CMP_DIRECT(classname, member, le, <=, fvalue_le)
+
+CMP_DIRECT_CLASS(uinteger64, uinteger64)
+CMP_DIRECT_CLASS(sinteger64, sinteger64)
+
+#define STRCMP_DIRECT(relname, relop, generic)				\
+static ft_bool_t							\
+string_##relname##_direct(const fvalue_t *a, const fvalue_t *b)		\
+{									\
+	if (G_UNLIKELY(a->ftype != b->ftype))				\
+		return generic(a, b);					\
+	return (wmem_strbuf_strcmp(a->value.strbuf, b->value.strbuf) relop 0) ? \
+						FT_TRUE : FT_FALSE;	\
+}
+
+STRCMP_DIRECT(eq, ==, fvalue_eq)
+STRCMP_DIRECT(ne, !=, fvalue_ne)
+STRCMP_DIRECT(gt, >,  fvalue_gt)
+STRCMP_DIRECT(ge, >=, fvalue_ge)
+STRCMP_DIRECT(lt, <,  fvalue_lt)
+STRCMP_DIRECT(le, <=, fvalue_le)
+
+fvalue_cmp_fn
+fvalue_cmp_specialized(enum ftenum ftype, fvalue_cmp_rel_t rel)
+{
+	if (rel == FVALUE_CMP_NONE)
+		return NULL;
+
+	switch (ftype) {
+		case FT_CHAR:
+		case FT_UINT8:
+		case FT_UINT16:
+		case FT_UINT24:
+		case FT_UINT32:
+		case FT_UINT40:
+		case FT_UINT48:
+		case FT_UINT56:
+		case FT_UINT64:
+		/* Not FT_BOOLEAN: its comparisons are by truthiness,
+		 * not by stored value. */
+		case FT_FRAMENUM:
+			switch (rel) {
+				case FVALUE_CMP_EQ: return uinteger64_eq_direct;
+				case FVALUE_CMP_NE: return uinteger64_ne_direct;
+				case FVALUE_CMP_GT: return uinteger64_gt_direct;
+				case FVALUE_CMP_GE: return uinteger64_ge_direct;
+				case FVALUE_CMP_LT: return uinteger64_lt_direct;
+				case FVALUE_CMP_LE: return uinteger64_le_direct;
+				default: break;
+			}
+			break;
+		case FT_INT8:
+		case FT_INT16:
+		case FT_INT24:
+		case FT_INT32:
+		case FT_INT40:
+		case FT_INT48:
+		case FT_INT56:
+		case FT_INT64:
+			switch (rel) {
+				case FVALUE_CMP_EQ: return sinteger64_eq_direct;
+				case FVALUE_CMP_NE: return sinteger64_ne_direct;
+				case FVALUE_CMP_GT: return sinteger64_gt_direct;
+				case FVALUE_CMP_GE: return sinteger64_ge_direct;
+				case FVALUE_CMP_LT: return sinteger64_lt_direct;
+				case FVALUE_CMP_LE: return sinteger64_le_direct;
+				default: break;
+			}
+			break;
+		case FT_STRING:
+		case FT_STRINGZ:
+		case FT_UINT_STRING:
+		case FT_STRINGZPAD:
+		case FT_STRINGZTRUNC:
+			switch (rel) {
+				case FVALUE_CMP_EQ: return string_eq_direct;
+				case FVALUE_CMP_NE: return string_ne_direct;
+				case FVALUE_CMP_GT: return string_gt_direct;
+				case FVALUE_CMP_GE: return string_ge_direct;
+				case FVALUE_CMP_LT: return string_lt_direct;
+				case FVALUE_CMP_LE: return string_le_direct;
+				default: break;
+			}
+			break;
+		default:
+			break;
+	}
+	return NULL;
+}
+
 ft_bool_t
 fvalue_contains(const fvalue_t *a, const fvalue_t *b)
 {
@@ -220,6 +220,10 @@ WS_DLL_PUBLIC
 bool
 ftype_can_eq(enum ftenum ftype);
 
+WS_DLL_PUBLIC
+bool
+ftype_can_hash(enum ftenum ftype);
+
 WS_DLL_PUBLIC
 bool
 ftype_can_cmp(enum ftenum ftype);
@@ -542,6 +546,29 @@ WS_DLL_PUBLIC
 ft_bool_t
 fvalue_le(const fvalue_t *a, const fvalue_t *b);
 
+/* Signature shared with the fvalue_eq() family above. */
+typedef ft_bool_t (*fvalue_cmp_fn)(const fvalue_t *a, const fvalue_t *b);
+
+typedef enum {
+	FVALUE_CMP_NONE,	/* no specialization for this predicate */
+	FVALUE_CMP_EQ,
+	FVALUE_CMP_NE,
+	FVALUE_CMP_GT,
+	FVALUE_CMP_GE,
+	FVALUE_CMP_LT,
+	FVALUE_CMP_LE,
+} fvalue_cmp_rel_t;
+
+/* Return a comparison predicate specialized for the given type, or
+ * NULL if no specialization exists.  The returned predicate gives the
+ * same answers as the corresponding generic function but compares the
+ * values directly, without going through the per-type method table;
+ * operands whose type differs from its own are handed back to the
+ * generic path. */
+WS_DLL_PUBLIC
+fvalue_cmp_fn
+fvalue_cmp_specialized(enum ftenum ftype, fvalue_cmp_rel_t rel);
+
 WS_DLL_PUBLIC
 ft_bool_t
 fvalue_contains(const fvalue_t *a, const fvalue_t *b);
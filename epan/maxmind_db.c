@@ -161,11 +161,13 @@ static bool mmdbr_pipe_valid(void) {
 }
 
 // Writing to mmdbr_pipe.stdin_fd can block. Do so in a separate thread.
+#define MAX_MMDB_REQUEST_BATCH 8192
 static void *
 write_mmdbr_stdin_worker(void *data _U_) {
     GIOStatus status;
     GError *err = NULL;
     size_t bytes_written;
+    bool stop = false;
     ws_debug("starting write worker");
 
     while (1) {
@@ -184,19 +186,37 @@ write_mmdbr_stdin_worker(void *data _U_) {
             return NULL;
         }
 
-        ws_noisy("write %s ql %d", request, g_async_queue_length(mmdbr_request_q));
-        status = g_io_channel_write_chars(mmdbr_pipe.stdin_io, request, strlen(request), &bytes_written, &err);
+        // Coalesce whatever else is already queued into one pipe write, so
+        // a burst of endpoints costs one syscall here and one buffer fill
+        // on the resolver side instead of one of each per address.
+        GString *batch = g_string_new(request);
+        g_free(request);
+        while (batch->len < MAX_MMDB_REQUEST_BATCH &&
+               (request = (char *) g_async_queue_try_pop(mmdbr_request_q)) != NULL) {
+            if (strcmp(request, mmdbr_stop_sentinel) == 0) {
+                g_free(request);
+                stop = true;
+                break;
+            }
+            g_string_append(batch, request);
+            g_free(request);
+        }
+
+        ws_noisy("write %s ql %d", batch->str, g_async_queue_length(mmdbr_request_q));
+        status = g_io_channel_write_chars(mmdbr_pipe.stdin_io, batch->str, batch->len, &bytes_written, &err);
+        g_string_free(batch, TRUE);
         if (status != G_IO_STATUS_NORMAL) {
             ws_debug("write error %s. exiting thread.", err->message);
             g_clear_error(&err);
-            g_free(request);
             mmdb_response_t *response = g_new0(mmdb_response_t, 1);
             response->fatal_err = true;
             g_async_queue_push(mmdbr_response_q, response); // Will be freed by maxmind_db_pop_response.
             return NULL;
         }
         g_clear_error(&err);
-        g_free(request);
+        if (stop) {
+            return NULL;
+        }
     }
     return NULL;
 }
@@ -80,6 +80,46 @@ static const oid_value_type_t unknown_type =    { FT_BYTES,  BASE_NONE, BER_CLAS
 
 static oid_info_t oid_root = { 0, NULL, OID_KIND_UNKNOWN, NULL, &unknown_type, -2, NULL, NULL, NULL};
 
+/*
+ * Memoized oid_resolved() results, keyed by the subid sequence. SNMP-walk
+ * captures resolve the same OIDs - and the same table-column prefixes -
+ * over and over, and once the MIBs are loaded a resolution never changes
+ * until another node is registered, so the cache is simply dropped
+ * whenever add_oid() runs.
+ */
+typedef struct {
+	unsigned        len;
+	const uint32_t *subids;
+} oid_resolved_key_t;
+
+static GHashTable* oid_resolved_cache;
+
+static guint oid_resolved_cache_hash(gconstpointer k_p) {
+	const oid_resolved_key_t* k = (const oid_resolved_key_t*)k_p;
+	guint hash = k->len;
+	unsigned i;
+
+	for (i = 0; i < k->len; i++)
+		hash = (hash << 5) + hash + k->subids[i];
+
+	return hash;
+}
+
+static gboolean oid_resolved_cache_equal(gconstpointer a_p, gconstpointer b_p) {
+	const oid_resolved_key_t* a = (const oid_resolved_key_t*)a_p;
+	const oid_resolved_key_t* b = (const oid_resolved_key_t*)b_p;
+
+	return a->len == b->len &&
+		memcmp(a->subids, b->subids, a->len * sizeof(uint32_t)) == 0;
+}
+
+static void oid_resolved_cache_key_free(gpointer k_p) {
+	oid_resolved_key_t* k = (oid_resolved_key_t*)k_p;
+
+	g_free((void*)k->subids);
+	g_free(k);
+}
+
 // NOLINTNEXTLINE(misc-no-recursion)
 static void prepopulate_oids(void) {
 	if (!oid_root.children) {
@@ -107,6 +147,11 @@ static oid_info_t* add_oid(const char* name, oid_kind_t kind, const oid_value_ty
 	oid_info_t* c = &oid_root;
 
 	prepopulate_oids();
+
+	/* The new node may lengthen the match for OIDs resolved earlier. */
+	if (oid_resolved_cache)
+		g_hash_table_remove_all(oid_resolved_cache);
+
 	oid_len--;
 
 	do {
@@ -867,6 +912,10 @@ void oids_init(void) {
 }
 
 void oids_cleanup(void) {
+	if (oid_resolved_cache) {
+		g_hash_table_destroy(oid_resolved_cache);
+		oid_resolved_cache = NULL;
+	}
 #ifdef HAVE_LIBSMI
 	unregister_mibs();
 #else
@@ -1221,32 +1270,53 @@ char *oid_resolved(wmem_allocator_t *scope, uint32_t num_subids, uint32_t* subid
 	unsigned matched;
 	unsigned left;
 	oid_info_t* oid;
+	oid_resolved_key_t lookup_key;
+	oid_resolved_key_t* key;
+	char* ret;
 
 	if(! (subids && *subids <= 2 ))
 		return wmem_strdup(scope, "*** Malformed OID ***");
 
+	lookup_key.len = num_subids;
+	lookup_key.subids = subids;
+
+	if (oid_resolved_cache) {
+		ret = (char *)g_hash_table_lookup(oid_resolved_cache, &lookup_key);
+		if (ret)
+			return wmem_strdup(scope, ret);
+	} else {
+		oid_resolved_cache = g_hash_table_new_full(oid_resolved_cache_hash,
+			oid_resolved_cache_equal, oid_resolved_cache_key_free, g_free);
+	}
+
 	oid = oid_get(num_subids, subids, &matched, &left);
 
 	while (! oid->name ) {
 		if (!(oid = oid->parent)) {
-			return oid_subid2string(scope, subids,num_subids);
+			ret = oid_subid2string(scope, subids,num_subids);
+			goto done;
 		}
 		left++;
 		matched--;
 	}
 
 	if (left) {
-		char *ret,
-			  *str1 = oid_subid2string(NULL, subids,matched),
+		char *str1 = oid_subid2string(NULL, subids,matched),
 			  *str2 = oid_subid2string(NULL, &(subids[matched]),left);
 
 		ret = wmem_strconcat(scope, oid->name ? oid->name : str1, ".", str2, NULL);
 		wmem_free(NULL, str1);
 		wmem_free(NULL, str2);
-		return ret;
 	} else {
-		return oid->name ? wmem_strdup(scope, oid->name) : oid_subid2string(scope, subids,matched);
+		ret = oid->name ? wmem_strdup(scope, oid->name) : oid_subid2string(scope, subids,matched);
 	}
+
+done:
+	key = g_new(oid_resolved_key_t, 1);
+	key->len = num_subids;
+	key->subids = (const uint32_t *)g_memdup2(subids, num_subids * sizeof(uint32_t));
+	g_hash_table_insert(oid_resolved_cache, key, g_strdup(ret));
+	return ret;
 }
 
 extern void oid_both(wmem_allocator_t *scope, unsigned oid_len, uint32_t *subids, char** resolved_p, char** numeric_p) {
@@ -43,6 +43,8 @@
 #include <wsutil/str_util.h>
 #include <wsutil/wslog.h>
 #include <wsutil/ws_assert.h>
+#include <wsutil/filesystem.h>
+#include <wsutil/file_util.h>
 
 static int proto_malformed;
 static dissector_handle_t frame_handle;
@@ -92,6 +94,13 @@ struct dissector_table {
 	protocol_t	*protocol;
 	GHashFunc	hash_func;
 	bool	supports_decode_as;
+	/* One-entry memo of the most recent uint lookup; traffic tends to
+	 * hit the same selector (e.g. TCP port) many packets in a row,
+	 * and this avoids rehashing it on every packet.  Invalidated
+	 * whenever the table is mutated. */
+	uint32_t	last_uint_pattern;
+	dtbl_entry_t	*last_uint_entry;
+	bool	last_uint_valid;
 };
 
 /*
@@ -289,6 +298,10 @@ packet_cleanup(void)
 	g_hash_table_destroy(heuristic_short_names);
 	g_slist_foreach(shutdown_routines, &call_routine, NULL);
 	g_slist_free(shutdown_routines);
+	if (dissector_timing_table) {
+		g_hash_table_destroy(dissector_timing_table);
+		dissector_timing_table = NULL;
+	}
 	if (postdissectors) {
 		for (unsigned i = 0; i < postdissectors->len; i++) {
 			if (POSTDISSECTORS(i).wanted_hfids) {
@@ -477,10 +490,7 @@ mark_frame_as_depended_upon(frame_data *fd, uint32_t frame_num)
 		/* ws_assert(frame_num < fd->num) - we assume in several other
 		 * places in the code that frames don't depend on future
 		 * frames. */
-		if (fd->dependent_frames == NULL) {
-			fd->dependent_frames = g_hash_table_new(g_direct_hash, g_direct_equal);
-		}
-		g_hash_table_add(fd->dependent_frames, GUINT_TO_POINTER(frame_num));
+		frame_data_add_dependent_frame(fd, frame_num);
 	}
 }
 
@@ -517,6 +527,13 @@ dissect_record(epan_dissect_t *edt, int file_type_subtype,
 	const char *volatile record_type;
 	frame_data_t frame_dissector_data;
 
+	/* An exception in a dissector can unwind past the timing balance
+	 * in call_dissector_work(); start each record from a clean slate. */
+	if (G_UNLIKELY(dissector_timing_enabled))
+		dissector_timing_child_usecs = 0;
+	if (G_UNLIKELY(dissector_profile_enabled))
+		dissector_profile_depth = 0;
+
 	switch (rec->rec_type) {
 
 	case REC_TYPE_PACKET:
@@ -683,6 +700,11 @@ dissect_file(epan_dissect_t *edt, wtap_rec *rec,
 {
 	file_data_t file_dissector_data;
 
+	if (G_UNLIKELY(dissector_timing_enabled))
+		dissector_timing_child_usecs = 0;
+	if (G_UNLIKELY(dissector_profile_enabled))
+		dissector_profile_depth = 0;
+
 	if (cinfo != NULL)
 		col_init(cinfo, edt->session);
 	edt->pi.epan = edt->session;
@@ -834,6 +856,184 @@ remove_last_layer(packet_info *pinfo, bool reduce_count)
 }
 
 
+/*
+ * Check whether the dissection ceiling preferences forbid descending
+ * into another protocol layer for this packet.  Dissection stops either
+ * once protocols.dissection_depth_limit layers have been entered or
+ * once the protocol named by protocols.dissection_stop_after has been
+ * dissected; any remaining payload is left undissected.
+ */
+static bool
+dissection_at_ceiling(packet_info *pinfo)
+{
+	static const char *cached_stop_after;
+	static int         cached_stop_after_id = -1;
+
+	if (prefs.dissection_depth_limit != 0 &&
+	    pinfo->curr_layer_num >= prefs.dissection_depth_limit)
+		return true;
+
+	/*
+	 * Resolve the stop-after protocol name to a protocol ID once per
+	 * preference change; the preference machinery replaces the string
+	 * rather than modifying it in place, so a pointer comparison
+	 * suffices to detect a new value.
+	 */
+	if (prefs.dissection_stop_after != cached_stop_after) {
+		cached_stop_after = prefs.dissection_stop_after;
+		cached_stop_after_id = -1;
+		if (cached_stop_after != NULL && cached_stop_after[0] != '\0')
+			cached_stop_after_id =
+			    proto_get_id_by_filter_name(cached_stop_after);
+	}
+	if (cached_stop_after_id != -1 && pinfo->layers != NULL &&
+	    wmem_list_find(pinfo->layers, GINT_TO_POINTER(cached_stop_after_id)))
+		return true;
+
+	return false;
+}
+
+/*
+ * Per-dissector timing, for attributing dissection time to protocols
+ * without disabling them one at a time. Keyed by protocol id; -1 collects
+ * dissectors with no protocol. Only touched from the dissection thread,
+ * and only when enabled: the instrumentation in call_dissector_work()
+ * costs two monotonic clock reads per dissector call when on and a
+ * single branch when off.
+ */
+static bool dissector_timing_enabled;
+static GHashTable *dissector_timing_table;
+/* Inclusive time spent in subdissectors of the dissector currently on
+ * the call stack, for computing exclusive time. */
+static int64_t dissector_timing_child_usecs;
+
+void
+dissector_timing_set_enabled(bool enable)
+{
+	dissector_timing_enabled = enable;
+	if (enable && dissector_timing_table == NULL) {
+		dissector_timing_table = g_hash_table_new_full(g_direct_hash,
+		    g_direct_equal, NULL, g_free);
+	}
+}
+
+bool
+dissector_timing_get_enabled(void)
+{
+	return dissector_timing_enabled;
+}
+
+void
+dissector_timing_reset(void)
+{
+	if (dissector_timing_table != NULL)
+		g_hash_table_remove_all(dissector_timing_table);
+	dissector_timing_child_usecs = 0;
+}
+
+static void
+dissector_timing_record(dissector_handle_t handle, int64_t incl_usecs,
+			int64_t excl_usecs)
+{
+	int proto_id = -1;
+	dissector_timing_t *timing;
+
+	if (handle->protocol != NULL)
+		proto_id = proto_get_id(handle->protocol);
+
+	timing = (dissector_timing_t *)g_hash_table_lookup(
+	    dissector_timing_table, GINT_TO_POINTER(proto_id));
+	if (timing == NULL) {
+		timing = g_new0(dissector_timing_t, 1);
+		timing->proto_id = proto_id;
+		g_hash_table_insert(dissector_timing_table,
+		    GINT_TO_POINTER(proto_id), timing);
+	}
+	timing->calls++;
+	timing->incl_usecs += incl_usecs;
+	timing->excl_usecs += excl_usecs;
+}
+
+static int
+dissector_timing_compare(const void *a, const void *b)
+{
+	const dissector_timing_t *timing_a = (const dissector_timing_t *)a;
+	const dissector_timing_t *timing_b = (const dissector_timing_t *)b;
+
+	if (timing_a->excl_usecs != timing_b->excl_usecs)
+		return (timing_a->excl_usecs < timing_b->excl_usecs) ? 1 : -1;
+	return 0;
+}
+
+GArray *
+dissector_timing_get(void)
+{
+	GArray *timings;
+	GHashTableIter iter;
+	void *value;
+
+	timings = g_array_new(false, false, sizeof(dissector_timing_t));
+	if (dissector_timing_table != NULL) {
+		g_hash_table_iter_init(&iter, dissector_timing_table);
+		while (g_hash_table_iter_next(&iter, NULL, &value))
+			g_array_append_vals(timings, value, 1);
+	}
+	g_array_sort(timings, dissector_timing_compare);
+	return timings;
+}
+
+/*
+ * Dissection profile stack. When enabled, call_dissector_work() maintains
+ * a shadow stack of the protocols currently being dissected, so a
+ * sampling profiler can attribute samples to protocol stacks without
+ * unwinding native frames. The snapshot function only reads the stack
+ * and is safe to call from a signal handler interrupting the dissection
+ * thread; a handler can at worst observe a stack that is torn between
+ * two dissector calls, which is acceptable for sampling.
+ */
+static bool dissector_profile_enabled;
+static volatile int dissector_profile_stack[DISSECTOR_PROFILE_MAX_DEPTH];
+static volatile int dissector_profile_depth;
+
+void
+dissector_profile_set_enabled(bool enable)
+{
+	dissector_profile_enabled = enable;
+	dissector_profile_depth = 0;
+}
+
+bool
+dissector_profile_get_enabled(void)
+{
+	return dissector_profile_enabled;
+}
+
+int
+dissector_profile_current_proto(void)
+{
+	int depth = dissector_profile_depth;
+
+	if (depth <= 0)
+		return -1;
+	if (depth > DISSECTOR_PROFILE_MAX_DEPTH)
+		depth = DISSECTOR_PROFILE_MAX_DEPTH;
+	return dissector_profile_stack[depth - 1];
+}
+
+int
+dissector_profile_snapshot(int *proto_ids, int max_depth)
+{
+	int depth = dissector_profile_depth;
+
+	if (depth > DISSECTOR_PROFILE_MAX_DEPTH)
+		depth = DISSECTOR_PROFILE_MAX_DEPTH;
+	if (depth > max_depth)
+		depth = max_depth;
+	for (int i = 0; i < depth; i++)
+		proto_ids[i] = dissector_profile_stack[i];
+	return depth;
+}
+
 /* This function will return
  *   >0  this protocol was successfully dissected and this was this protocol.
  *   0   this packet did not match this protocol.
@@ -899,6 +1099,8 @@ call_dissector_work(dissector_handle_t handle, tvbuff_t *tvb, packet_info *pinfo
 	unsigned     saved_tree_count = tree ? tree->tree_data->count : 0;
 	unsigned     saved_desegment_len = pinfo->desegment_len;
 	bool         consumed_none;
+	int64_t      timing_start_usecs = 0;
+	int64_t      saved_child_usecs = 0;
 
 	if (handle->protocol != NULL &&
 	    !proto_is_protocol_enabled(handle->protocol)) {
@@ -908,6 +1110,14 @@ call_dissector_work(dissector_handle_t handle, tvbuff_t *tvb, packet_info *pinfo
 		return 0;
 	}
 
+	if (dissection_at_ceiling(pinfo)) {
+		/*
+		 * We've reached the configured dissection ceiling;
+		 * don't descend into another protocol layer.
+		 */
+		return 0;
+	}
+
 	saved_proto = pinfo->current_proto;
 	saved_can_desegment = pinfo->can_desegment;
 	saved_layers_len = wmem_list_count(pinfo->layers);
@@ -942,6 +1152,21 @@ call_dissector_work(dissector_handle_t handle, tvbuff_t *tvb, packet_info *pinfo
 		}
 	}
 
+	if (G_UNLIKELY(dissector_profile_enabled)) {
+		if (dissector_profile_depth < DISSECTOR_PROFILE_MAX_DEPTH) {
+			dissector_profile_stack[dissector_profile_depth] =
+			    handle->protocol != NULL ?
+			    proto_get_id(handle->protocol) : -1;
+		}
+		dissector_profile_depth++;
+	}
+
+	if (G_UNLIKELY(dissector_timing_enabled)) {
+		saved_child_usecs = dissector_timing_child_usecs;
+		dissector_timing_child_usecs = 0;
+		timing_start_usecs = g_get_monotonic_time();
+	}
+
 	if (pinfo->flags.in_error_pkt) {
 		len = call_dissector_work_error(handle, tvb, pinfo, tree, data);
 	} else {
@@ -950,6 +1175,19 @@ call_dissector_work(dissector_handle_t handle, tvbuff_t *tvb, packet_info *pinfo
 		 */
 		len = call_dissector_through_handle(handle, tvb, pinfo, tree, data);
 	}
+
+	if (G_UNLIKELY(dissector_timing_enabled)) {
+		const int64_t incl_usecs =
+		    g_get_monotonic_time() - timing_start_usecs;
+
+		dissector_timing_record(handle, incl_usecs,
+		    incl_usecs - dissector_timing_child_usecs);
+		dissector_timing_child_usecs = saved_child_usecs + incl_usecs;
+	}
+
+	if (G_UNLIKELY(dissector_profile_enabled) && dissector_profile_depth > 0)
+		dissector_profile_depth--;
+
 	consumed_none = len == 0 || (pinfo->desegment_len != saved_desegment_len && pinfo->desegment_offset == 0);
 	/* If len == 0, then the dissector didn't accept the packet.
 	 * In the latter case, the dissector accepted the packet, but didn't
@@ -1130,10 +1368,25 @@ find_dissector_table(const char *name)
 	return dissector_table;
 }
 
+/* Forget the memoized uint lookup; must be called whenever a table's
+ * contents change. */
+static void
+invalidate_uint_lookup_memo(dissector_table_t sub_dissectors)
+{
+	sub_dissectors->last_uint_valid = false;
+	sub_dissectors->last_uint_entry = NULL;
+}
+
 /* Find an entry in a uint dissector table. */
 static dtbl_entry_t *
 find_uint_dtbl_entry(dissector_table_t sub_dissectors, const uint32_t pattern)
 {
+	dtbl_entry_t *dtbl_entry;
+
+	if (sub_dissectors->last_uint_valid &&
+	    sub_dissectors->last_uint_pattern == pattern)
+		return sub_dissectors->last_uint_entry;
+
 	switch (sub_dissectors->type) {
 
 	case FT_UINT8:
@@ -1157,10 +1410,15 @@ find_uint_dtbl_entry(dissector_table_t sub_dissectors, const uint32_t pattern)
 	}
 
 	/*
-	 * Find the entry.
+	 * Find the entry, and remember it (even a miss) for the next
+	 * packet.
 	 */
-	return (dtbl_entry_t *)g_hash_table_lookup(sub_dissectors->hash_table,
+	dtbl_entry = (dtbl_entry_t *)g_hash_table_lookup(sub_dissectors->hash_table,
 				   GUINT_TO_POINTER(pattern));
+	sub_dissectors->last_uint_pattern = pattern;
+	sub_dissectors->last_uint_entry = dtbl_entry;
+	sub_dissectors->last_uint_valid = true;
+	return dtbl_entry;
 }
 
 #if 0
@@ -1240,6 +1498,7 @@ dissector_add_uint(const char *name, const uint32_t pattern, dissector_handle_t
 	dtbl_entry->initial = dtbl_entry->current;
 
 	/* do the table insertion */
+	invalidate_uint_lookup_memo(sub_dissectors);
 	g_hash_table_insert(sub_dissectors->hash_table,
 			     GUINT_TO_POINTER(pattern), (void *)dtbl_entry);
 
@@ -1396,6 +1655,7 @@ dissector_delete_uint(const char *name, const uint32_t pattern,
 		/*
 		 * Found - remove it.
 		 */
+		invalidate_uint_lookup_memo(sub_dissectors);
 		g_hash_table_remove(sub_dissectors->hash_table,
 				    GUINT_TO_POINTER(pattern));
 	}
@@ -1468,6 +1728,7 @@ void dissector_delete_all(const char *name, dissector_handle_t handle)
 	dissector_table_t sub_dissectors = find_dissector_table(name);
 	ws_assert (sub_dissectors);
 
+	invalidate_uint_lookup_memo(sub_dissectors);
 	g_hash_table_foreach_remove (sub_dissectors->hash_table, dissector_delete_all_check, handle);
 }
 
@@ -1477,6 +1738,7 @@ dissector_delete_from_table(gpointer key _U_, gpointer value, gpointer user_data
 	dissector_table_t sub_dissectors = (dissector_table_t) value;
 	ws_assert (sub_dissectors);
 
+	invalidate_uint_lookup_memo(sub_dissectors);
 	g_hash_table_foreach_remove(sub_dissectors->hash_table, dissector_delete_all_check, user_data);
 	sub_dissectors->dissector_handles = g_slist_remove(sub_dissectors->dissector_handles, user_data);
 }
@@ -1509,6 +1771,7 @@ dissector_change_uint(const char *name, const uint32_t pattern, dissector_handle
 		 * to decode it, just remove the entry to save memory.
 		 */
 		if (handle == NULL && dtbl_entry->initial == NULL) {
+			invalidate_uint_lookup_memo(sub_dissectors);
 			g_hash_table_remove(sub_dissectors->hash_table,
 					    GUINT_TO_POINTER(pattern));
 			return;
@@ -1530,6 +1793,7 @@ dissector_change_uint(const char *name, const uint32_t pattern, dissector_handle
 	dtbl_entry->current = handle;
 
 	/* do the table insertion */
+	invalidate_uint_lookup_memo(sub_dissectors);
 	g_hash_table_insert(sub_dissectors->hash_table,
 			     GUINT_TO_POINTER(pattern), (void *)dtbl_entry);
 }
@@ -1558,6 +1822,7 @@ dissector_reset_uint(const char *name, const uint32_t pattern)
 	if (dtbl_entry->initial != NULL) {
 		dtbl_entry->current = dtbl_entry->initial;
 	} else {
+		invalidate_uint_lookup_memo(sub_dissectors);
 		g_hash_table_remove(sub_dissectors->hash_table,
 				    GUINT_TO_POINTER(pattern));
 	}
@@ -2785,6 +3050,7 @@ register_dissector_table(const char *name, const char *ui_name, const int proto,
 	sub_dissectors->param   = param;
 	sub_dissectors->protocol  = (proto == -1) ? NULL : find_protocol_by_id(proto);
 	sub_dissectors->supports_decode_as = false;
+	invalidate_uint_lookup_memo(sub_dissectors);
 	g_hash_table_insert(dissector_tables, (void *)name, (void *) sub_dissectors);
 	return sub_dissectors;
 }
@@ -2815,6 +3081,7 @@ dissector_table_t register_custom_dissector_table(const char *name,
 	sub_dissectors->param   = BASE_NONE;
 	sub_dissectors->protocol  = (proto == -1) ? NULL : find_protocol_by_id(proto);
 	sub_dissectors->supports_decode_as = false;
+	invalidate_uint_lookup_memo(sub_dissectors);
 	g_hash_table_insert(dissector_tables, (void *)name, (void *) sub_dissectors);
 	return sub_dissectors;
 }
@@ -3043,6 +3310,15 @@ dissector_try_heuristic(heur_dissector_list_t sub_dissectors, tvbuff_t *tvb,
 	unsigned           saved_desegment_len;
 	unsigned           saved_tree_count = tree ? tree->tree_data->count : 0;
 
+	if (dissection_at_ceiling(pinfo)) {
+		/*
+		 * We've reached the configured dissection ceiling; don't
+		 * try any heuristic dissectors either.
+		 */
+		*heur_dtbl_entry = NULL;
+		return false;
+	}
+
 	/* can_desegment is set to 2 by anyone which offers this api/service.
 	   then every time a subdissector is called it is decremented by one.
 	   thus only the subdissector immediately ontop of whoever offers this
@@ -3139,6 +3415,137 @@ dissector_try_heuristic(heur_dissector_list_t sub_dissectors, tvbuff_t *tvb,
 	return status;
 }
 
+/*
+ * Persisted heuristic dissector ordering.
+ *
+ * dissector_try_heuristic() bubbles a matching entry to the front of its
+ * list, so within a session the lists converge towards trying the likely
+ * dissectors first.  The learned ordering is saved to a per-profile file
+ * on shutdown and restored on startup, so a fresh session doesn't start
+ * from registration order again.
+ *
+ * The file has one line per table: the table name followed by the short
+ * names of its heuristic entries, space-separated, in list order.  Short
+ * names are restricted to lowercase letters, digits, '-', '_' and '.'
+ * (see check_valid_heur_name_or_fail()), so they can't contain the
+ * separator.
+ */
+#define HEUR_ORDER_FILE_NAME	"heuristic_order"
+
+static void
+heur_dissector_order_save_table(void *key, void *value, void *user_data)
+{
+	const char               *table_name = (const char *)key;
+	heur_dissector_list_t     sub_dissectors = (heur_dissector_list_t)value;
+	FILE                     *f = (FILE *)user_data;
+	GSList                   *entry;
+
+	/* A list with fewer than two entries has nothing to reorder. */
+	if (sub_dissectors->dissectors == NULL ||
+	    g_slist_next(sub_dissectors->dissectors) == NULL)
+		return;
+
+	fputs(table_name, f);
+	for (entry = sub_dissectors->dissectors; entry != NULL;
+	    entry = g_slist_next(entry)) {
+		fprintf(f, " %s", ((heur_dtbl_entry_t *)entry->data)->short_name);
+	}
+	fputc('\n', f);
+}
+
+void
+heur_dissector_order_save(void)
+{
+	char *ff_path;
+	FILE *f;
+
+	if (heur_dissector_lists == NULL)
+		return;
+
+	ff_path = get_persconffile_path(HEUR_ORDER_FILE_NAME, true);
+	f = ws_fopen(ff_path, "w");
+	if (f == NULL) {
+		/* Not being able to save the ordering only costs a warm-up;
+		   don't report it as an error. */
+		g_free(ff_path);
+		return;
+	}
+	g_free(ff_path);
+
+	fputs("# Heuristic dissector ordering, learned from matches in previous sessions.\n"
+	      "# This file is automatically generated, DO NOT MODIFY.\n", f);
+	g_hash_table_foreach(heur_dissector_lists,
+			     heur_dissector_order_save_table, f);
+	fclose(f);
+}
+
+void
+heur_dissector_order_load(void)
+{
+	char  *ff_path;
+	FILE  *f;
+	char   line[4096];
+
+	ff_path = get_persconffile_path(HEUR_ORDER_FILE_NAME, true);
+	f = ws_fopen(ff_path, "r");
+	g_free(ff_path);
+	if (f == NULL)
+		return;
+
+	while (fgets(line, sizeof(line), f) != NULL) {
+		char                 **tokens;
+		heur_dissector_list_t  sub_dissectors;
+		GSList                *ordered = NULL;
+		unsigned               i;
+
+		if (line[0] == '#' || line[0] == '\n')
+			continue;
+		g_strchomp(line);
+
+		tokens = g_strsplit(line, " ", -1);
+		if (tokens[0] == NULL) {
+			g_strfreev(tokens);
+			continue;
+		}
+
+		sub_dissectors = find_heur_dissector_list(tokens[0]);
+		if (sub_dissectors == NULL) {
+			/* The table no longer exists (e.g. a plugin was
+			   removed); just skip its line. */
+			g_strfreev(tokens);
+			continue;
+		}
+
+		/*
+		 * Move the entries named in the file, in file order, to
+		 * the front of the list.  Entries not mentioned (newly
+		 * registered since the ordering was saved) keep their
+		 * registration order after them, and names with no
+		 * matching entry are ignored.
+		 */
+		for (i = 1; tokens[i] != NULL; i++) {
+			GSList *entry;
+
+			for (entry = sub_dissectors->dissectors; entry != NULL;
+			    entry = g_slist_next(entry)) {
+				heur_dtbl_entry_t *hdtbl_entry = (heur_dtbl_entry_t *)entry->data;
+
+				if (strcmp(hdtbl_entry->short_name, tokens[i]) == 0) {
+					sub_dissectors->dissectors =
+						g_slist_remove_link(sub_dissectors->dissectors, entry);
+					ordered = g_slist_concat(ordered, entry);
+					break;
+				}
+			}
+		}
+		sub_dissectors->dissectors =
+			g_slist_concat(ordered, sub_dissectors->dissectors);
+
+		g_strfreev(tokens);
+	}
+	fclose(f);
+}
+
 typedef struct heur_dissector_foreach_info {
 	void *        caller_data;
 	DATFunc_heur  caller_func;
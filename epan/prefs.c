@@ -3715,6 +3715,11 @@ prefs_register_modules(void)
                                    10,
                                    &prefs.gui_packet_list_cached_rows_max);
 
+    prefs_register_bool_preference(gui_module, "packet_list_cache_all_column_text",
+                                   "Cache all column text",
+                                   "Keep the column text of every row in memory so that scrolling and sorting never require redissection. Increases memory consumption in proportion to the capture file size",
+                                   &prefs.gui_packet_list_cache_all_column_text);
+
     prefs_register_bool_preference(gui_module, "interfaces_show_hidden",
                                    "Show hidden interfaces",
                                    "Show all interfaces, including interfaces marked as hidden",
@@ -4017,6 +4022,30 @@ prefs_register_modules(void)
             "of cache entries to maintain. A 0 means no limit.",
             10, &prefs.ignore_dup_frames_cache_entries);
 
+    prefs_register_uint_preference(protocols_module, "dissection_depth_limit",
+            "Maximum number of protocol layers to dissect",
+            "Stop dissecting a packet after this many protocol layers "
+            "(counting the frame pseudo-protocol); deeper payload is left "
+            "undissected. A 0 means no limit.",
+            10, &prefs.dissection_depth_limit);
+
+    prefs_register_string_preference(protocols_module, "dissection_stop_after",
+            "Stop dissection after this protocol",
+            "Don't descend into further protocol layers once the protocol "
+            "with this filter name (e.g. \"tcp\") has been dissected. "
+            "An empty string means dissect everything.",
+            (const char **)&prefs.dissection_stop_after);
+
+    prefs_register_uint_preference(protocols_module, "frame_data_spill_budget",
+            "Resident frame metadata budget (MB)",
+            "When loading a capture, keep at most this many megabytes of "
+            "per-frame metadata in ordinary memory per file; metadata for "
+            "further frames is kept in a temporary spill file mapped into "
+            "the address space, so it is paged in and out on demand instead "
+            "of exhausting memory. A 0 means keep everything in memory. "
+            "Not supported on Windows.",
+            10, &prefs.frame_data_spill_budget);
+
 
     /* Obsolete preferences
      * These "modules" were reorganized/renamed to correspond to their GUI
@@ -4393,6 +4422,7 @@ pre_init_prefs(void)
     prefs.gui_packet_list_show_minimap = true;
     prefs.gui_packet_list_sortable     = true;
     prefs.gui_packet_list_cached_rows_max = 10000;
+    prefs.gui_packet_list_cache_all_column_text = false;
     g_free (prefs.gui_interfaces_hide_types);
     prefs.gui_interfaces_hide_types = g_strdup("");
     prefs.gui_interfaces_show_hidden = false;
@@ -4459,6 +4489,8 @@ pre_init_prefs(void)
     prefs.display_byte_fields_with_spaces = false;
     prefs.ignore_dup_frames = false;
     prefs.ignore_dup_frames_cache_entries = 10000;
+    prefs.dissection_depth_limit = 0;
+    prefs.frame_data_spill_budget = 0;
 
     /* set the default values for the io graph dialog */
     prefs.gui_io_graph_automatic_update = true;
@@ -5481,6 +5513,18 @@ deprecated_heur_dissector_pref(char *pref_name, const char *value)
     unsigned int i;
     heur_dtbl_entry_t* heuristic;
 
+    static GHashTable *deprecated_names;
+    if (deprecated_names == NULL) {
+        deprecated_names = g_hash_table_new(g_str_hash, g_str_equal);
+        for (i = 0; i < array_length(heur_prefs); i++) {
+            g_hash_table_add(deprecated_names, (void *)heur_prefs[i].pref_name);
+        }
+    }
+    /* Nearly every preference line misses all of these; get out with one
+     * lookup instead of a strcmp() per table entry. */
+    if (!g_hash_table_contains(deprecated_names, pref_name)) {
+        return false;
+    }
 
     for (i = 0; i < array_length(heur_prefs); i++)
     {
@@ -5717,6 +5761,23 @@ deprecated_port_pref(char *pref_name, const char *value)
     module_t *module;
     pref_t *pref;
 
+    static GHashTable *deprecated_names;
+    if (deprecated_names == NULL) {
+        deprecated_names = g_hash_table_new(g_str_hash, g_str_equal);
+        for (i = 0; i < G_N_ELEMENTS(port_prefs); i++) {
+            g_hash_table_add(deprecated_names, (void *)port_prefs[i].pref_name);
+        }
+        for (i = 0; i < G_N_ELEMENTS(port_range_prefs); i++) {
+            g_hash_table_add(deprecated_names, (void *)port_range_prefs[i].pref_name);
+        }
+        for (i = 0; i < G_N_ELEMENTS(tpkt_subdissector_port_prefs); i++) {
+            g_hash_table_add(deprecated_names, (void *)tpkt_subdissector_port_prefs[i].pref_name);
+        }
+        for (i = 0; i < G_N_ELEMENTS(obsolete_prefs); i++) {
+            g_hash_table_add(deprecated_names, (void *)obsolete_prefs[i].pref_name);
+        }
+    }
+
     static bool sanity_checked;
     if (!sanity_checked) {
         sanity_checked = true;
@@ -5737,6 +5798,12 @@ deprecated_port_pref(char *pref_name, const char *value)
         }
     }
 
+    /* Nearly every preference line misses all of these; get out with one
+     * lookup instead of a strcmp() per table entry. */
+    if (!g_hash_table_contains(deprecated_names, pref_name)) {
+        return false;
+    }
+
     for (i = 0; i < G_N_ELEMENTS(port_prefs); i++) {
         if (strcmp(pref_name, port_prefs[i].pref_name) == 0) {
             if (!ws_basestrtou32(value, NULL, &uval, port_prefs[i].base))
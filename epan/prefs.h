@@ -222,6 +222,9 @@ typedef struct _e_prefs {
   int          conversation_deinterlacing_key;
   bool         ignore_dup_frames;
   unsigned     ignore_dup_frames_cache_entries;
+  unsigned     dissection_depth_limit;
+  char        *dissection_stop_after;
+  unsigned     frame_data_spill_budget;
   bool         filter_expressions_old;  /* true if old filter expressions preferences were loaded. */
   bool         cols_hide_new; /* true if the new (index-based) gui.column.hide preference was loaded. */
   bool         gui_update_enabled;
@@ -240,6 +243,7 @@ typedef struct _e_prefs {
   bool         gui_packet_list_show_minimap;
   bool         gui_packet_list_sortable;
   unsigned     gui_packet_list_cached_rows_max;
+  bool         gui_packet_list_cache_all_column_text;
   int          gui_decimal_places1; /* Used for type 1 calculations */
   int          gui_decimal_places2; /* Used for type 2 calculations */
   int          gui_decimal_places3; /* Used for type 3 calculations */
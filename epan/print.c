@@ -2467,7 +2467,8 @@ static void proto_tree_get_node_field_values(proto_node *node, void *data)
     /* dissection with an invisible proto tree? */
     ws_assert(fi);
 
-    field_index = g_hash_table_lookup(call_data->fields->field_indicies, fi->hfinfo->abbrev);
+    field_index = g_hash_table_lookup(call_data->fields->field_indicies,
+                                      GINT_TO_POINTER(fi->hfinfo->id));
     if (NULL != field_index) {
         format_field_values(call_data->fields, field_index,
                             get_node_field_value(fi, call_data->edt) /* g_ alloc'd string */
@@ -2501,18 +2502,26 @@ static void write_specified_fields(fields_format format, output_fields_t *fields
     data.edt = edt;
 
     if (NULL == fields->field_indicies) {
-        /* Prepare a lookup table from string abbreviation for field to its index. */
-        fields->field_indicies = g_hash_table_new(g_str_hash, g_str_equal);
+        /* Prepare a lookup table from hf id for field to its index.
+         * Keying by id rather than by abbreviation means the per-node
+         * lookup below hashes a pointer-sized integer instead of
+         * walking the abbreviation string; several fields can share
+         * one abbreviation, so register the whole same-name chain.
+         */
+        fields->field_indicies = g_hash_table_new(g_direct_hash, g_direct_equal);
 
         i = 0;
         while (i < fields->fields->len) {
             char *field = (char *)g_ptr_array_index(fields->fields, i);
+            header_field_info *hfi = proto_registrar_get_byname(field);
             /* Store field indicies +1 so that zero is not a valid value,
              * and can be distinguished from NULL as a pointer.
              */
             ++i;
-            if (proto_registrar_get_byname(field)) {
-                g_hash_table_insert(fields->field_indicies, field, GUINT_TO_POINTER(i));
+            while (hfi) {
+                g_hash_table_insert(fields->field_indicies,
+                                    GINT_TO_POINTER(hfi->id), GUINT_TO_POINTER(i));
+                hfi = hfi->same_name_next;
             }
         }
     }
@@ -38,6 +38,7 @@
 #include "address_types.h"
 #include "oids.h"
 #include "proto.h"
+#include "epan.h"
 #include "epan_dissect.h"
 #include "dfilter/dfilter.h"
 #include "tvbuff.h"
@@ -270,6 +271,15 @@ static const char *hfinfo_numeric_value_format64(const header_field_info *hfinfo
 
 static void proto_cleanup_base(void);
 
+/* Field listeners, see proto_register_field_listener(). Maps an hf id
+ * to a GSList of field_listener_t. */
+typedef struct {
+	proto_field_listener_cb	 cb;
+	void			*user_data;
+} field_listener_t;
+
+static GHashTable *field_listeners;
+
 static proto_item *
 proto_tree_add_node(proto_tree *tree, field_info *fi);
 
@@ -418,6 +428,13 @@ static GPtrArray *deregistered_fields;
 static GPtrArray *deregistered_data;
 static GPtrArray *deregistered_slice;
 
+/* Lookup structures built on first use for large plain value_string
+ * arrays, keyed by the array pointer; see hf_try_plain_val_to_str().
+ * Arrays found unsuitable for an extended value string are mapped to
+ * &auto_vals_ext_unsuitable so they are only inspected once. */
+static GHashTable *auto_vals_ext_cache;
+static value_string_ext auto_vals_ext_unsuitable;
+
 /* indexed by prefix, contains initializers */
 static GHashTable* prefixes;
 
@@ -435,6 +452,28 @@ static GHashTable* prefixes;
 #define PROTO_NODE_FREE(pool, node)			\
 	wmem_free(pool, node)
 
+/* proto_nodes are never freed individually; the whole tree is dropped by
+ * resetting the packet pool.  Carve them out of slabs bump-allocated from
+ * that pool rather than one wmem allocation per node, sizing the first
+ * slab from the previous tree's node count so a typical tree fits in a
+ * single contiguous block.
+ */
+#define PROTO_NODE_SLAB_MIN_COUNT 64
+
+static proto_node *
+proto_node_new(tree_data_t *tree_data, wmem_allocator_t *pool)
+{
+	if (tree_data->node_slab_free == 0) {
+		unsigned slab_count = MAX(tree_data->prev_node_count,
+					  PROTO_NODE_SLAB_MIN_COUNT);
+		tree_data->node_slab = (proto_node *)wmem_alloc(pool,
+					  slab_count * sizeof(proto_node));
+		tree_data->node_slab_free = slab_count;
+	}
+	tree_data->node_slab_free--;
+	return tree_data->node_slab++;
+}
+
 /* String space for protocol and field items for the GUI */
 #define ITEM_LABEL_NEW(pool, il)			\
 	il = wmem_new(pool, item_label_t);
@@ -630,6 +669,8 @@ proto_init(GSList *register_all_plugin_protocols_list,
 		(*cb)(RA_PLUGIN_REGISTER, NULL, client_data);
 	g_slist_foreach(dissector_plugins, call_plugin_register_protoinfo, NULL);
 
+	epan_startup_trace_mark("proto registration");
+
 	/* Now call the "handoff registration" routines of all built-in
 	   dissectors; those routines register the dissector in other
 	   dissectors' handoff tables, and fetch any dissector handles
@@ -646,6 +687,8 @@ proto_init(GSList *register_all_plugin_protocols_list,
 		(*cb)(RA_PLUGIN_HANDOFF, NULL, client_data);
 	g_slist_foreach(dissector_plugins, call_plugin_register_handoff, NULL);
 
+	epan_startup_trace_mark("proto handoff");
+
 	/* sort the protocols by protocol name */
 	protocols = g_list_sort(protocols, proto_compare_name);
 
@@ -734,6 +777,12 @@ proto_cleanup_base(void)
 		deregistered_slice = NULL;
 	}
 
+	if (auto_vals_ext_cache) {
+		/* The value_string_ext structs themselves are epan scoped. */
+		g_hash_table_destroy(auto_vals_ext_cache);
+		auto_vals_ext_cache = NULL;
+	}
+
 	g_free(tree_is_expanded);
 	tree_is_expanded = NULL;
 
@@ -749,6 +798,17 @@ proto_cleanup(void)
 
 	g_slist_free(dissector_plugins);
 	dissector_plugins = NULL;
+
+	if (field_listeners) {
+		GHashTableIter iter;
+		void * value;
+
+		g_hash_table_iter_init(&iter, field_listeners);
+		while (g_hash_table_iter_next(&iter, NULL, &value))
+			g_slist_free_full((GSList *)value, g_free);
+		g_hash_table_destroy(field_listeners);
+		field_listeners = NULL;
+	}
 }
 
 static bool
@@ -850,8 +910,13 @@ proto_tree_reset(proto_tree *tree)
 		g_hash_table_remove_all(tree_data->interesting_hfids);
 	}
 
-	/* Reset track of the number of children */
+	/* Reset track of the number of children, remembering it as the
+	 * sizing hint for the next tree's first node slab.  The slab
+	 * itself lives in the packet pool, whose reset reclaims it. */
+	tree_data->prev_node_count = tree_data->count;
 	tree_data->count = 0;
+	tree_data->node_slab = NULL;
+	tree_data->node_slab_free = 0;
 
 	PROTO_NODE_INIT(tree);
 }
@@ -6405,7 +6470,7 @@ proto_tree_add_node(proto_tree *tree, field_info *fi)
 		/* XXX - is it safe to continue here? */
 	}
 
-	pnode = wmem_new(PNODE_POOL(tree), proto_node);
+	pnode = proto_node_new(PTREE_DATA(tree), PNODE_POOL(tree));
 	PROTO_NODE_INIT(pnode);
 	pnode->parent = tnode;
 	PNODE_FINFO(pnode) = fi;
@@ -6838,7 +6903,11 @@ proto_tree_set_representation(proto_item *pi, const char *format, va_list ap)
 
 	DISSECTOR_ASSERT(fi);
 
-	if (!proto_item_is_hidden(pi)) {
+	/* As above, only build the representation if the tree is visible;
+	 * consumers of invisible trees (taps, -T fields) read field values,
+	 * not labels, and fall back to proto_item_fill_label() if they do
+	 * need one. */
+	if (PTREE_DATA(pi)->visible && !proto_item_is_hidden(pi)) {
 		ITEM_LABEL_NEW(PNODE_POOL(pi), fi->rep);
 
 		str = wmem_strdup_vprintf(PNODE_POOL(pi), format, ap);
@@ -7597,6 +7666,13 @@ proto_item_append_text(proto_item *pi, const char *format, ...)
 		return;
 	}
 
+	/* Don't materialize a default label in an invisible tree just to
+	 * append to it; readers of invisible trees regenerate labels on
+	 * demand with proto_item_fill_label(). */
+	if (fi->rep == NULL && !PTREE_DATA(pi)->visible) {
+		return;
+	}
+
 	if (!proto_item_is_hidden(pi)) {
 		/*
 		 * If we don't already have a representation,
@@ -7650,6 +7726,12 @@ proto_item_prepend_text(proto_item *pi, const char *format, ...)
 		return;
 	}
 
+	/* As in proto_item_append_text(), skip label work entirely in an
+	 * invisible tree. */
+	if (fi->rep == NULL && !PTREE_DATA(pi)->visible) {
+		return;
+	}
+
 	if (!proto_item_is_hidden(pi)) {
 		/*
 		 * If we don't already have a representation,
@@ -7818,6 +7900,11 @@ proto_tree_create_root(packet_info *pinfo)
 	/* Keep track of the number of children */
 	pnode->tree_data->count = 0;
 
+	/* The first proto_node slab is allocated on demand */
+	pnode->tree_data->node_slab = NULL;
+	pnode->tree_data->node_slab_free = 0;
+	pnode->tree_data->prev_node_count = 0;
+
 	return (proto_tree *)pnode;
 }
 
@@ -7882,6 +7969,115 @@ proto_tree_prime_with_hfid_print(proto_tree *tree _U_, const int hfid)
 	}
 }
 
+/*
+ * Field listeners.
+ *
+ * Embedders subscribe to hf ids and get the typed raw values of every
+ * occurrence via callback, without walking the tree and without any
+ * string formatting. Values are attached to tree items after the item
+ * is linked into the tree, so there is no single point during
+ * dissection where a completed value could be reported; instead the
+ * subscribed fields are collected through the usual "interesting
+ * fields" machinery (which materializes them even in a faked tree) and
+ * delivered in one batch right after dissection.
+ */
+
+void
+proto_register_field_listener(const int hfid, proto_field_listener_cb cb, void *user_data)
+{
+	field_listener_t *listener;
+	GSList *listeners;
+
+	DISSECTOR_ASSERT(cb);
+
+	if (field_listeners == NULL) {
+		field_listeners = g_hash_table_new(g_direct_hash, NULL /* g_direct_equal */);
+	}
+
+	listener = g_new(field_listener_t, 1);
+	listener->cb = cb;
+	listener->user_data = user_data;
+
+	listeners = (GSList *)g_hash_table_lookup(field_listeners, GINT_TO_POINTER(hfid));
+	listeners = g_slist_append(listeners, listener);
+	g_hash_table_insert(field_listeners, GINT_TO_POINTER(hfid), listeners);
+}
+
+void
+proto_deregister_field_listener(const int hfid, proto_field_listener_cb cb, void *user_data)
+{
+	GSList *listeners, *le;
+
+	if (field_listeners == NULL)
+		return;
+
+	listeners = (GSList *)g_hash_table_lookup(field_listeners, GINT_TO_POINTER(hfid));
+	for (le = listeners; le != NULL; le = le->next) {
+		field_listener_t *listener = (field_listener_t *)le->data;
+
+		if (listener->cb == cb && listener->user_data == user_data) {
+			listeners = g_slist_delete_link(listeners, le);
+			g_free(listener);
+			break;
+		}
+	}
+
+	if (listeners)
+		g_hash_table_insert(field_listeners, GINT_TO_POINTER(hfid), listeners);
+	else
+		g_hash_table_remove(field_listeners, GINT_TO_POINTER(hfid));
+}
+
+static void
+prime_with_field_listener(void * key, void * value _U_, void * user_data)
+{
+	proto_tree_prime_with_hfid((proto_tree *)user_data, GPOINTER_TO_INT(key));
+}
+
+void
+proto_tree_prime_with_field_listeners(proto_tree *tree)
+{
+	if (field_listeners == NULL)
+		return;
+
+	g_hash_table_foreach(field_listeners, prime_with_field_listener, tree);
+}
+
+unsigned
+proto_tree_notify_field_listeners(proto_tree *tree)
+{
+	GHashTableIter iter;
+	void * key, *value;
+	unsigned delivered = 0;
+
+	if (field_listeners == NULL || tree == NULL)
+		return 0;
+
+	g_hash_table_iter_init(&iter, field_listeners);
+	while (g_hash_table_iter_next(&iter, &key, &value)) {
+		GPtrArray *finfos;
+		unsigned   i;
+		GSList	  *le;
+
+		finfos = proto_get_finfo_ptr_array(tree, GPOINTER_TO_INT(key));
+		if (finfos == NULL)
+			continue;
+
+		for (i = 0; i < finfos->len; i++) {
+			field_info *fi = (field_info *)g_ptr_array_index(finfos, i);
+
+			for (le = (GSList *)value; le != NULL; le = le->next) {
+				field_listener_t *listener = (field_listener_t *)le->data;
+
+				listener->cb(fi, listener->user_data);
+			}
+			delivered++;
+		}
+	}
+
+	return delivered;
+}
+
 proto_tree *
 proto_item_add_subtree(proto_item *pi,	const int idx) {
 	field_info *fi;
@@ -8885,6 +9081,18 @@ free_deregistered_field (void *data, void *user_data _U_)
 	header_field_info *hfi = (header_field_info *) data;
 	int hf_id = hfi->id;
 
+	/* Drop any lookup structure built for this field's value_string
+	 * array before the array itself is freed below. */
+	if (auto_vals_ext_cache != NULL && hfi->strings != NULL) {
+		value_string_ext *vse = (value_string_ext *)
+		    g_hash_table_lookup(auto_vals_ext_cache, hfi->strings);
+		if (vse != NULL) {
+			g_hash_table_remove(auto_vals_ext_cache, hfi->strings);
+			if (vse != &auto_vals_ext_unsuitable)
+				value_string_ext_free(vse);
+		}
+	}
+
 	g_free((char *)hfi->name);
 	g_free((char *)hfi->abbrev);
 	g_free((char *)hfi->blurb);
@@ -9634,7 +9842,11 @@ proto_register_field_init(header_field_info *hfinfo, const int parent)
 			gpa_hfinfo.hfi[0] = NULL;
 			gpa_hfinfo.len = 1;
 		} else {
-			gpa_hfinfo.allocated_len += 1000;
+			/* Grow geometrically: with third-party plugins the
+			 * field count can far exceed the preallocation, and
+			 * fixed-size increments would copy the (multi-MB)
+			 * array over and over during startup. */
+			gpa_hfinfo.allocated_len += gpa_hfinfo.allocated_len / 2;
 			gpa_hfinfo.hfi = (header_field_info **)g_realloc(gpa_hfinfo.hfi,
 						   sizeof(header_field_info *)*gpa_hfinfo.allocated_len);
 			/*ws_warning("gpa_hfinfo.allocated_len %u", gpa_hfinfo.allocated_len);*/
@@ -10147,6 +10359,60 @@ fill_label_boolean(const field_info *fi, char *label_str)
 	label_fill(label_str, bitfield_byte_length, hfinfo, tfs_get_string(!!value, hfinfo->strings));
 }
 
+/* Above this many entries, a plain value_string array is wrapped in an
+ * extended value string on first use so later lookups can use an index
+ * or binary search instead of a linear scan. Smaller arrays stay on the
+ * linear scan, which beats a hash probe at that size. */
+#define HF_AUTO_VALS_EXT_THRESHOLD 32
+
+static const char *
+hf_try_plain_val_to_str(uint32_t value, const header_field_info *hfinfo)
+{
+	const value_string *vs = (const value_string *) hfinfo->strings;
+	value_string_ext   *vse = NULL;
+	bool                sorted;
+	unsigned            n;
+
+	if (auto_vals_ext_cache != NULL)
+		vse = (value_string_ext *)g_hash_table_lookup(auto_vals_ext_cache, vs);
+	if (vse == &auto_vals_ext_unsuitable)
+		return try_val_to_str(value, vs);
+	if (vse != NULL)
+		return try_val_to_str_ext(value, vse);
+
+	for (n = 0; n < HF_AUTO_VALS_EXT_THRESHOLD; n++) {
+		if (vs[n].strptr == NULL)
+			return NULL;
+		if (vs[n].value == value)
+			return vs[n].strptr;
+	}
+
+	/* A large array, scanned past the threshold for the first time.
+	 * Wrap it in an extended value string if its values are strictly
+	 * ascending (so the ext init picks index or binary search, never
+	 * the linear fallback and its warning) and it is terminated with
+	 * the {0, NULL} entry value_string_ext_new() requires. Remember
+	 * unsuitable arrays so they are only inspected once. */
+	sorted = true;
+	for (n = 1; vs[n].strptr != NULL; n++) {
+		if (vs[n - 1].value >= vs[n].value)
+			sorted = false;
+	}
+
+	if (auto_vals_ext_cache == NULL)
+		auto_vals_ext_cache = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+	if (sorted && vs[n].value == 0) {
+		vse = value_string_ext_new(vs, n + 1, hfinfo->abbrev);
+		g_hash_table_insert(auto_vals_ext_cache, (void *)vs, vse);
+		return try_val_to_str_ext(value, vse);
+	}
+
+	g_hash_table_insert(auto_vals_ext_cache, (void *)vs,
+	    &auto_vals_ext_unsuitable);
+	return try_val_to_str(value, vs);
+}
+
 static const char *
 hf_try_val_to_str(uint32_t value, const header_field_info *hfinfo)
 {
@@ -10166,7 +10432,7 @@ hf_try_val_to_str(uint32_t value, const header_field_info *hfinfo)
 	if (hfinfo->display & BASE_UNIT_STRING)
 		return unit_name_string_get_value(value, (const struct unit_name_string*) hfinfo->strings);
 
-	return try_val_to_str(value, (const value_string *) hfinfo->strings);
+	return hf_try_plain_val_to_str(value, hfinfo);
 }
 
 static const char *
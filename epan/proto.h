@@ -895,6 +895,9 @@ typedef struct {
     bool                 visible;
     bool                 fake_protocols;
     unsigned             count;
+    struct _proto_node  *node_slab;       /**< slab the next proto_node is carved from */
+    unsigned             node_slab_free;  /**< nodes remaining in node_slab */
+    unsigned             prev_node_count; /**< node count of the previous tree; sizes the first slab */
     struct _packet_info *pinfo;
 } tree_data_t;
 
@@ -1237,6 +1240,45 @@ proto_tree_prime_with_hfid(proto_tree *tree, const int hfid);
 extern void
 proto_tree_prime_with_hfid_print(proto_tree *tree, const int hfid);
 
+/** Callback invoked by proto_tree_notify_field_listeners() for every
+ * occurrence of a subscribed field. The field_info carries the typed
+ * raw value (fi->value) and tvb location; no string representation is
+ * built. The field_info is only valid during the callback.
+ @param fi the field occurrence
+ @param user_data user data given at registration */
+typedef void (*proto_field_listener_cb)(field_info *fi, void *user_data);
+
+/** Subscribe to the values of a field by hf id.
+ * Embedders that only need a handful of field values can register
+ * listeners instead of walking the protocol tree: prime each tree with
+ * proto_tree_prime_with_field_listeners() before dissection, so the
+ * subscribed fields are materialized even when all other items are
+ * faked, and call proto_tree_notify_field_listeners() afterwards.
+ @param hfid the field id to subscribe to
+ @param cb the callback to invoke per field occurrence
+ @param user_data passed through to the callback */
+WS_DLL_PUBLIC void
+proto_register_field_listener(const int hfid, proto_field_listener_cb cb, void *user_data);
+
+/** Remove a field listener registered with the same arguments. */
+WS_DLL_PUBLIC void
+proto_deregister_field_listener(const int hfid, proto_field_listener_cb cb, void *user_data);
+
+/** Mark all fields with registered listeners as "interesting" so they
+ * are materialized during dissection even in a faked tree.
+ @param tree the tree to be primed */
+WS_DLL_PUBLIC void
+proto_tree_prime_with_field_listeners(proto_tree *tree);
+
+/** Deliver the collected values of all subscribed fields to their
+ * listeners. Only works with trees primed with
+ * proto_tree_prime_with_field_listeners(), and is fast: no tree walk
+ * takes place.
+ @param tree the dissected tree
+ @return the number of field occurrences delivered */
+WS_DLL_PUBLIC unsigned
+proto_tree_notify_field_listeners(proto_tree *tree);
+
 /** Get a parent item of a subtree.
  @param tree the tree to get the parent from
  @return parent item */
@@ -688,7 +688,12 @@ fragment_add_seq_offset(reassembly_table *table, const packet_info *pinfo, const
 static void
 update_first_gap(fragment_head *fd_head, fragment_item *inserted, bool multi_insert)
 {
-	uint32_t frag_end = inserted->offset + inserted->len;
+	/* For block sequence reassemblies the offsets are fragment numbers,
+	 * not byte offsets, so the next expected offset is one past this
+	 * fragment; contiguous_len then counts the consecutive fragment
+	 * numbers seen starting from 0. */
+	bool seq = (fd_head->flags & FD_BLOCKSEQUENCE) != 0;
+	uint32_t frag_end = seq ? inserted->offset + 1 : inserted->offset + inserted->len;
 	fragment_item *iter;
 	uint32_t contiguous;
 
@@ -701,7 +706,7 @@ update_first_gap(fragment_head *fd_head, fragment_item *inserted, bool multi_ins
 			/* inserted node is not first fragment */
 			return;
 		}
-		contiguous = inserted->len;
+		contiguous = frag_end;
 		iter = inserted;
 	} else {
 		contiguous = MAX(fd_head->contiguous_len, frag_end);
@@ -713,7 +718,7 @@ update_first_gap(fragment_head *fd_head, fragment_item *inserted, bool multi_ins
 			break;
 		}
 		iter = iter->next;
-		contiguous = MAX(contiguous, iter->offset + iter->len);
+		contiguous = MAX(contiguous, seq ? iter->offset + 1 : iter->offset + iter->len);
 	}
 
 	/* iter is either pointing to last fragment before gap or tail */
@@ -1883,7 +1888,11 @@ fragment_defragment_and_free (fragment_head *fd_head, const packet_info *pinfo)
 	tvb_set_free_cb(fd_head->tvb_data, g_free);
 	fd_head->len = size;		/* record size for caller	*/
 
-	/* add all data fragments */
+	/* add all data fragments, freeing each fragment's data as soon as
+	 * the walk moves past it (the duplicate check below only ever looks
+	 * at the immediately preceding fragment), so the peak memory usage
+	 * is one copy of the PDU plus one fragment rather than two copies
+	 * of the PDU */
 	last_fd=NULL;
 	for (fd_i=fd_head->next; fd_i; fd_i=fd_i->next) {
 		if (fd_i->len) {
@@ -1902,16 +1911,21 @@ fragment_defragment_and_free (fragment_head *fd_head, const packet_info *pinfo)
 				}
 			}
 		}
+		if (last_fd) {
+			if (last_fd->flags & FD_SUBSET_TVB)
+				last_fd->flags &= ~FD_SUBSET_TVB;
+			else if (last_fd->tvb_data)
+				tvb_free(last_fd->tvb_data);
+			last_fd->tvb_data=NULL;
+		}
 		last_fd=fd_i;
 	}
-
-	/* we have defragmented the pdu, now free all fragments*/
-	for (fd_i=fd_head->next;fd_i;fd_i=fd_i->next) {
-		if (fd_i->flags & FD_SUBSET_TVB)
-			fd_i->flags &= ~FD_SUBSET_TVB;
-		else if (fd_i->tvb_data)
-			tvb_free(fd_i->tvb_data);
-		fd_i->tvb_data=NULL;
+	if (last_fd) {
+		if (last_fd->flags & FD_SUBSET_TVB)
+			last_fd->flags &= ~FD_SUBSET_TVB;
+		else if (last_fd->tvb_data)
+			tvb_free(last_fd->tvb_data);
+		last_fd->tvb_data=NULL;
 	}
 	if (old_tvb_data)
 		tvb_free(old_tvb_data);
@@ -2138,16 +2152,12 @@ fragment_add_seq_work(fragment_head *fd_head, tvbuff_t *tvb, const int offset,
 	}
 
 
-	/* check if we have received the entire fragment
-	 * this is easy since the list is sorted and the head is faked.
-	 * common case the whole list is scanned.
+	/* check if we have received the entire fragment.
+	 * LINK_FRAG() above kept contiguous_len up to date, and for block
+	 * sequence reassemblies it counts the consecutive fragment numbers
+	 * seen starting from 0, so there is no need to rescan the list.
 	 */
-	max = 0;
-	for(fd_i=fd_head->next;fd_i;fd_i=fd_i->next) {
-	  if ( fd_i->offset==max ){
-		max++;
-	  }
-	}
+	max = fd_head->contiguous_len;
 	/* max will now be datalen+1 if all fragments have been seen */
 
 	if (max <= fd_head->datalen) {
@@ -2255,9 +2265,11 @@ fragment_add_seq_common(reassembly_table *table, tvbuff_t *tvb,
 			/*
 			 * If we weren't given an initial fragment number,
 			 * use the next expected fragment number as the fragment
-			 * number for this fragment.
+			 * number for this fragment. Start the walk at the last
+			 * fragment before the first gap - with in-order
+			 * delivery that is already the tail of the list.
 			 */
-			for (fd = fd_head->next; fd != NULL; fd = fd->next) {
+			for (fd = fd_head->first_gap ? fd_head->first_gap : fd_head->next; fd != NULL; fd = fd->next) {
 				if (fd->next == NULL)
 					frag_number = fd->offset + 1;
 			}
@@ -2439,9 +2451,10 @@ fragment_add_seq_single_move(reassembly_table *table, const packet_info *pinfo,
 	}
 	new_fh = lookup_fd_head(table, pinfo, id+offset, data, NULL);
 	if (new_fh != NULL) {
-		/* Attach to the end of the sorted list. */
-		prev_fd = NULL;
-		for(fd = fh->next; fd != NULL; fd=fd->next) {
+		/* Attach to the end of the sorted list, starting the walk
+		 * at the last fragment before the first gap. */
+		prev_fd = fh->first_gap;
+		for(fd = prev_fd ? prev_fd->next : fh->next; fd != NULL; fd=fd->next) {
 		    prev_fd = fd;
 		}
 		/* Don't take a reassembly starting with a First fragment. */
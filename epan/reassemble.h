@@ -66,7 +66,9 @@ typedef struct _fragment_head {
 	struct _fragment_item *first_gap;	/**< pointer to last fragment before first gap.
 					 * NULL if there is no fragment starting at offset 0 */
 	unsigned ref_count; 		/**< reference count in reassembled_table */
-	uint32_t contiguous_len;	/**< contiguous length from head up to first gap */
+	uint32_t contiguous_len;	/**< contiguous length from head up to first gap;
+					 * when flags&FD_BLOCKSEQUENCE is set, the number of
+					 * consecutive fragment numbers seen starting from 0 */
 	uint32_t frame;			/**< maximum of all frame numbers added to reassembly */
 	uint32_t	len;			/**< When flags&FD_BLOCKSEQUENCE and FD_DEFRAGMENTED
 					 * are set, the number of bytes of the full datagram.
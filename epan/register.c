@@ -33,7 +33,7 @@ static void set_cb_name(const char *proto) {
 }
 
 static void *
-register_all_protocols_worker(void *arg _U_)
+register_all_protocols_body(void)
 {
     void *volatile error_message = NULL;
 
@@ -57,19 +57,41 @@ register_all_protocols_worker(void *arg _U_)
     }
     ENDTRY;
 
-    g_async_queue_push(register_cb_done_q, GINT_TO_POINTER(true));
     return (void *) error_message;
 }
 
+static void *
+register_all_protocols_worker(void *arg _U_)
+{
+    void *error_message = register_all_protocols_body();
+
+    g_async_queue_push(register_cb_done_q, GINT_TO_POINTER(true));
+    return error_message;
+}
+
 void
 register_all_protocols(register_cb cb, void *cb_data)
 {
     const char *cb_name;
-    register_cb_done_q = g_async_queue_new();
     bool called_back = false;
     GThread *rapw_thread;
     const char *error_message;
 
+    if (cb == NULL) {
+        /*
+         * Nobody wants progress callbacks - typical for the CLI tools,
+         * which scripts may launch over and over. Run the registration
+         * loop directly instead of spawning a worker thread and polling
+         * it at CB_WAIT_TIME intervals.
+         */
+        error_message = (const char *) register_all_protocols_body();
+        if (error_message != NULL)
+            THROW_MESSAGE(DissectorError, error_message);
+        return;
+    }
+
+    register_cb_done_q = g_async_queue_new();
+
     rapw_thread = g_thread_new("register_all_protocols_worker", &register_all_protocols_worker, NULL);
     while (!g_async_queue_timeout_pop(register_cb_done_q, CB_WAIT_TIME)) {
         g_mutex_lock(&cur_cb_name_mtx);
@@ -89,7 +111,7 @@ register_all_protocols(register_cb cb, void *cb_data)
 }
 
 static void *
-register_all_protocol_handoffs_worker(void *arg _U_)
+register_all_protocol_handoffs_body(void)
 {
     void *volatile error_message = NULL;
 
@@ -113,10 +135,18 @@ register_all_protocol_handoffs_worker(void *arg _U_)
     }
     ENDTRY;
 
-    g_async_queue_push(register_cb_done_q, GINT_TO_POINTER(true));
     return (void *) error_message;
 }
 
+static void *
+register_all_protocol_handoffs_worker(void *arg _U_)
+{
+    void *error_message = register_all_protocol_handoffs_body();
+
+    g_async_queue_push(register_cb_done_q, GINT_TO_POINTER(true));
+    return error_message;
+}
+
 void
 register_all_protocol_handoffs(register_cb cb, void *cb_data)
 {
@@ -125,6 +155,15 @@ register_all_protocol_handoffs(register_cb cb, void *cb_data)
     GThread *raphw_thread;
     const char *error_message;
 
+    if (cb == NULL) {
+        /* As in register_all_protocols(), skip the worker thread and the
+         * polling loop when there's nobody to report progress to. */
+        error_message = (const char *) register_all_protocol_handoffs_body();
+        if (error_message != NULL)
+            THROW_MESSAGE(DissectorError, error_message);
+        return;
+    }
+
     set_cb_name(NULL);
     raphw_thread = g_thread_new("register_all_protocol_handoffs_worker", &register_all_protocol_handoffs_worker, NULL);
     while (!g_async_queue_timeout_pop(register_cb_done_q, CB_WAIT_TIME)) {
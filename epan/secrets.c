@@ -17,8 +17,10 @@
 #include <wiretap/wtap.h>
 #include <wsutil/glib-compat.h>
 #include <wsutil/wslog.h>
+#include <wsutil/file_util.h>
 
 #include <string.h>
+#include <errno.h>
 #ifdef HAVE_LIBGNUTLS
 # include <gnutls/gnutls.h>
 # include <gnutls/abstract.h>
@@ -26,12 +28,15 @@
 # include <wsutil/rsa.h>
 # include <epan/uat.h>
 # include <wsutil/report_message.h>
-# include <wsutil/file_util.h>
-# include <errno.h>
 #endif  /* HAVE_LIBGNUTLS */
 
 #ifdef _WIN32
 #include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 /** Maps uint32_t secrets_type -> secrets_block_callback_t. */
@@ -107,6 +112,299 @@ secrets_wtap_callback(uint32_t secrets_type, const void *secrets, unsigned size)
     }
 }
 
+/* Compiled secrets index. {{{
+ *
+ * File layout (all fields in host byte order):
+ *
+ *   secrets_index_header_t
+ *   secrets_index_bucket_t[bucket_count]   (open addressing, linear probing)
+ *   blob                                   (concatenated keys and values)
+ *
+ * A bucket is empty iff both its key and value lengths are zero; key and
+ * value offsets are relative to the start of the blob. bucket_count is a
+ * power of two with a load factor of at most 50%, so probe sequences stay
+ * short and a lookup touching an empty bucket can stop.
+ */
+
+#define SECRETS_INDEX_MAGIC     0x57535349      /* "WSSI" */
+#define SECRETS_INDEX_VERSION   1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t bucket_count;
+    uint32_t entry_count;
+    uint64_t blob_len;
+} secrets_index_header_t;
+
+typedef struct {
+    uint32_t hash;
+    uint32_t key_off;
+    uint32_t value_off;
+    uint16_t key_len;
+    uint16_t value_len;
+    uint8_t  tag;
+    uint8_t  pad[3];
+} secrets_index_bucket_t;
+
+struct secrets_index {
+    void       *data;           /**< Whole file contents (mapping or copy). */
+    size_t      data_len;
+    bool        mapped;         /**< true if data must be munmap()ed. */
+    const secrets_index_header_t *header;
+    const secrets_index_bucket_t *buckets;
+    const uint8_t *blob;
+};
+
+struct secrets_index_writer {
+    GArray     *entries;        /**< Of secrets_index_bucket_t. */
+    GByteArray *blob;
+};
+
+static uint32_t
+secrets_index_hash(uint8_t tag, const uint8_t *key, unsigned key_len)
+{
+    /* FNV-1a over the tag followed by the key bytes. */
+    uint32_t hash = 2166136261u;
+
+    hash = (hash ^ tag) * 16777619u;
+    for (unsigned i = 0; i < key_len; i++) {
+        hash = (hash ^ key[i]) * 16777619u;
+    }
+    return hash;
+}
+
+secrets_index_writer_t *
+secrets_index_writer_new(void)
+{
+    secrets_index_writer_t *writer = g_new0(secrets_index_writer_t, 1);
+
+    writer->entries = g_array_new(FALSE, FALSE, sizeof(secrets_index_bucket_t));
+    writer->blob = g_byte_array_new();
+    return writer;
+}
+
+void
+secrets_index_writer_add(secrets_index_writer_t *writer, uint8_t tag,
+        const uint8_t *key, unsigned key_len,
+        const uint8_t *value, unsigned value_len)
+{
+    secrets_index_bucket_t entry = { 0 };
+
+    if (key_len == 0 || key_len > UINT16_MAX || value_len > UINT16_MAX) {
+        return;
+    }
+
+    entry.hash = secrets_index_hash(tag, key, key_len);
+    entry.tag = tag;
+    entry.key_off = writer->blob->len;
+    entry.key_len = (uint16_t)key_len;
+    g_byte_array_append(writer->blob, key, key_len);
+    entry.value_off = writer->blob->len;
+    entry.value_len = (uint16_t)value_len;
+    g_byte_array_append(writer->blob, value, value_len);
+    g_array_append_val(writer->entries, entry);
+}
+
+static void
+secrets_index_writer_free(secrets_index_writer_t *writer)
+{
+    g_array_free(writer->entries, TRUE);
+    g_byte_array_free(writer->blob, TRUE);
+    g_free(writer);
+}
+
+bool
+secrets_index_writer_finish(secrets_index_writer_t *writer, const char *path)
+{
+    secrets_index_header_t header = { 0 };
+    secrets_index_bucket_t *buckets;
+    uint32_t bucket_count, mask;
+    char *tmp_path;
+    FILE *fp;
+    bool ok;
+
+    /* Size the table to a power of two with at most 50% occupancy. */
+    bucket_count = 16;
+    while (bucket_count < 2 * writer->entries->len) {
+        bucket_count *= 2;
+    }
+    mask = bucket_count - 1;
+    buckets = g_new0(secrets_index_bucket_t, bucket_count);
+
+    for (unsigned i = 0; i < writer->entries->len; i++) {
+        const secrets_index_bucket_t *entry =
+            &g_array_index(writer->entries, secrets_index_bucket_t, i);
+        uint32_t slot = entry->hash & mask;
+
+        /* Probe for a free slot; a duplicate (tag, key) is overwritten so
+         * that the last occurrence in the source wins, matching the
+         * behavior of replaying the source into a hash table. */
+        while (buckets[slot].key_len || buckets[slot].value_len) {
+            if (buckets[slot].hash == entry->hash &&
+                buckets[slot].tag == entry->tag &&
+                buckets[slot].key_len == entry->key_len &&
+                !memcmp(writer->blob->data + buckets[slot].key_off,
+                        writer->blob->data + entry->key_off, entry->key_len)) {
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+        buckets[slot] = *entry;
+    }
+
+    header.magic = SECRETS_INDEX_MAGIC;
+    header.version = SECRETS_INDEX_VERSION;
+    header.bucket_count = bucket_count;
+    header.entry_count = writer->entries->len;
+    header.blob_len = writer->blob->len;
+
+    /* Write to a temporary file and rename so that concurrent readers only
+     * ever observe a complete index. */
+    tmp_path = g_strconcat(path, ".tmp", NULL);
+    fp = ws_fopen(tmp_path, "wb");
+    ok = fp != NULL;
+    if (ok) {
+        ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+             fwrite(buckets, sizeof(*buckets), bucket_count, fp) == bucket_count &&
+             (writer->blob->len == 0 ||
+              fwrite(writer->blob->data, writer->blob->len, 1, fp) == 1);
+        ok = (fclose(fp) == 0) && ok;
+        if (ok) {
+            ok = ws_rename(tmp_path, path) == 0;
+        }
+        if (!ok) {
+            ws_unlink(tmp_path);
+        }
+    }
+    if (!ok) {
+        ws_debug("failed to write secrets index %s: %s", path, g_strerror(errno));
+    }
+
+    g_free(tmp_path);
+    g_free(buckets);
+    secrets_index_writer_free(writer);
+    return ok;
+}
+
+secrets_index_t *
+secrets_index_open(const char *path)
+{
+    secrets_index_t *index;
+    const secrets_index_header_t *header;
+    void *data = NULL;
+    int64_t file_len;
+    bool mapped = false;
+
+#ifndef _WIN32
+    int fd = ws_open(path, O_RDONLY, 0);
+    if (fd == -1) {
+        return NULL;
+    }
+    ws_statb64 st;
+    if (ws_fstat64(fd, &st) == -1 || st.st_size < (int64_t)sizeof(*header)) {
+        ws_close(fd);
+        return NULL;
+    }
+    file_len = st.st_size;
+    data = mmap(NULL, (size_t)file_len, PROT_READ, MAP_SHARED, fd, 0);
+    ws_close(fd);
+    if (data == MAP_FAILED) {
+        return NULL;
+    }
+    mapped = true;
+#else
+    /* No mmap; reading the file into memory still avoids re-parsing the
+     * source, it merely loses cross-process page sharing. */
+    gsize contents_len;
+    if (!g_file_get_contents(path, (char **)&data, &contents_len, NULL)) {
+        return NULL;
+    }
+    file_len = (int64_t)contents_len;
+    if (file_len < (int64_t)sizeof(*header)) {
+        g_free(data);
+        return NULL;
+    }
+#endif
+
+    header = (const secrets_index_header_t *)data;
+    if (header->magic != SECRETS_INDEX_MAGIC ||
+        header->version != SECRETS_INDEX_VERSION ||
+        header->bucket_count == 0 ||
+        (header->bucket_count & (header->bucket_count - 1)) != 0 ||
+        (uint64_t)file_len != sizeof(*header) +
+            (uint64_t)header->bucket_count * sizeof(secrets_index_bucket_t) +
+            header->blob_len) {
+        ws_debug("rejecting malformed secrets index %s", path);
+#ifndef _WIN32
+        munmap(data, (size_t)file_len);
+#else
+        g_free(data);
+#endif
+        return NULL;
+    }
+
+    index = g_new0(secrets_index_t, 1);
+    index->data = data;
+    index->data_len = (size_t)file_len;
+    index->mapped = mapped;
+    index->header = header;
+    index->buckets = (const secrets_index_bucket_t *)((const uint8_t *)data + sizeof(*header));
+    index->blob = (const uint8_t *)(index->buckets + header->bucket_count);
+    return index;
+}
+
+bool
+secrets_index_lookup(const secrets_index_t *index, uint8_t tag,
+        const uint8_t *key, unsigned key_len,
+        const uint8_t **value, unsigned *value_len)
+{
+    uint32_t hash = secrets_index_hash(tag, key, key_len);
+    uint32_t mask = index->header->bucket_count - 1;
+    uint32_t slot = hash & mask;
+
+    for (uint32_t probes = 0; probes <= mask; probes++, slot = (slot + 1) & mask) {
+        const secrets_index_bucket_t *bucket = &index->buckets[slot];
+
+        if (bucket->key_len == 0 && bucket->value_len == 0) {
+            return false;
+        }
+        if (bucket->hash != hash || bucket->tag != tag ||
+            bucket->key_len != key_len) {
+            continue;
+        }
+        /* Bounds-check offsets; the index is a cache that could have been
+         * corrupted on disk. */
+        if ((uint64_t)bucket->key_off + bucket->key_len > index->header->blob_len ||
+            (uint64_t)bucket->value_off + bucket->value_len > index->header->blob_len) {
+            return false;
+        }
+        if (memcmp(index->blob + bucket->key_off, key, key_len) == 0) {
+            *value = index->blob + bucket->value_off;
+            *value_len = bucket->value_len;
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+secrets_index_close(secrets_index_t *index)
+{
+    if (!index) {
+        return;
+    }
+#ifndef _WIN32
+    if (index->mapped) {
+        munmap(index->data, index->data_len);
+    }
+#else
+    g_free(index->data);
+#endif
+    g_free(index);
+}
+/* Compiled secrets index. }}} */
+
 #ifdef HAVE_LIBGNUTLS
 static unsigned
 key_id_hash(const void *key)
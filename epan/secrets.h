@@ -83,6 +83,68 @@ typedef void (*secrets_block_callback_t)(const void *secrets, unsigned size);
 WS_DLL_PUBLIC void
 secrets_register_type(uint32_t secrets_type, secrets_block_callback_t cb);
 
+/**
+ * Compiled secrets index.
+ *
+ * An index is an on-disk open-addressing hash table mapping (tag, key) pairs
+ * to opaque secret blobs. It is compiled once from a slowly-changing source
+ * (typically a large TLS key log file) and then mapped read-only by every
+ * process that needs it, so batch jobs stop re-parsing the source on each
+ * capture file open. The consumer defines the meaning of the tag values; the
+ * index itself treats keys and values as opaque byte strings.
+ *
+ * The file is a cache in host byte order, not an interchange format; readers
+ * reject files whose magic or version does not match and the consumer is
+ * expected to rebuild a stale or rejected index from its source.
+ */
+struct secrets_index;
+typedef struct secrets_index secrets_index_t;
+
+struct secrets_index_writer;
+typedef struct secrets_index_writer secrets_index_writer_t;
+
+/** Starts building a new secrets index. */
+WS_DLL_PUBLIC secrets_index_writer_t *
+secrets_index_writer_new(void);
+
+/**
+ * Adds one entry to the index under construction. A later entry with the same
+ * (tag, key) replaces an earlier one. Entries with an empty key or with a key
+ * or value larger than 65535 bytes are silently dropped.
+ */
+WS_DLL_PUBLIC void
+secrets_index_writer_add(secrets_index_writer_t *writer, uint8_t tag,
+        const uint8_t *key, unsigned key_len,
+        const uint8_t *value, unsigned value_len);
+
+/**
+ * Writes the index to the given path (atomically, via a temporary file) and
+ * frees the writer. Returns false if the file could not be written.
+ */
+WS_DLL_PUBLIC bool
+secrets_index_writer_finish(secrets_index_writer_t *writer, const char *path);
+
+/**
+ * Opens a compiled index read-only, mapping it into memory where the platform
+ * allows so that the page cache is shared between processes. Returns NULL if
+ * the file is missing, malformed or of an unsupported version.
+ */
+WS_DLL_PUBLIC secrets_index_t *
+secrets_index_open(const char *path);
+
+/**
+ * Looks up a (tag, key) pair. On a hit, *value and *value_len describe the
+ * stored secret; the pointer is valid until secrets_index_close().
+ */
+WS_DLL_PUBLIC bool
+secrets_index_lookup(const secrets_index_t *index, uint8_t tag,
+        const uint8_t *key, unsigned key_len,
+        const uint8_t **value, unsigned *value_len);
+
+/** Closes an index and releases its mapping. */
+WS_DLL_PUBLIC void
+secrets_index_close(secrets_index_t *index);
+
 #ifdef HAVE_LIBGNUTLS
 /**
  * Retrieve a list of available key URIs. PKCS #11 token URIs begin with
@@ -83,6 +83,12 @@ typedef struct _tap_listener_t {
 	int tap_id;
 	bool needs_redraw;
 	bool failed;
+	/* Per-frame memo of the filter verdict; a filter depends only on
+	 * the dissection, so it need not be re-run for every entry a tap
+	 * queued for the same frame. Valid while filter_checked is set,
+	 * which tap_push_tapped_queue() clears per frame. */
+	bool filter_checked;
+	bool filter_passed;
 	unsigned flags;
 	char *fstring;
 	dfilter_t *code;
@@ -319,6 +325,12 @@ tap_push_tapped_queue(epan_dissect_t *edt)
 		return;
 	}
 
+	/* All queued entries belong to the frame just dissected, so any
+	   filter verdicts cached below are stale; clear them. */
+	for(tl=tap_listener_queue;tl;tl=tl->next){
+		tl->filter_checked=false;
+	}
+
 	/* loop over all tap listeners and call the listener callback
 	   for all packets that match the filter. */
 	for(i=0;i<tap_packet_index;i++){
@@ -350,7 +362,26 @@ tap_push_tapped_queue(epan_dissect_t *edt)
 					 */
 					unsigned flags = tl->flags;
 					if(tl->code){
-						if (!dfilter_apply_edt(tl->code, edt)){
+						if(!tl->filter_checked){
+							/* Listeners with an identical
+							 * filter share one evaluation
+							 * per frame. */
+							tap_listener_t *tl2;
+
+							for(tl2=tap_listener_queue;tl2!=tl;tl2=tl2->next){
+								if(tl2->filter_checked && tl2->code &&
+								    strcmp(tl2->fstring, tl->fstring)==0){
+									tl->filter_passed=tl2->filter_passed;
+									tl->filter_checked=true;
+									break;
+								}
+							}
+							if(!tl->filter_checked){
+								tl->filter_passed=dfilter_apply_edt(tl->code, edt);
+								tl->filter_checked=true;
+							}
+						}
+						if (!tl->filter_passed){
 							/* The packet didn't
 							 * pass the filter. */
 							if (tl->flags & TL_IGNORE_DISPLAY_FILTER)
@@ -747,6 +778,15 @@ have_tap_listener(int tap_id)
 	return false;
 }
 
+/*
+ * Return true if any tap listeners are registered, false otherwise.
+ */
+bool
+have_tap_listeners(void)
+{
+	return tap_listener_queue != NULL;
+}
+
 /*
  * Return true if we have any tap listeners with filters, false otherwise.
  */
@@ -790,6 +830,24 @@ union_of_tap_listener_flags(void)
 	return flags;
 }
 
+/*
+ * The sampling interval of the program feeding us packets: 1 when every
+ * record is processed, N when only every Nth record is.
+ */
+static unsigned tap_sampling_interval = 1;
+
+void
+set_tap_sampling_interval(unsigned interval)
+{
+	tap_sampling_interval = interval != 0 ? interval : 1;
+}
+
+unsigned
+get_tap_sampling_interval(void)
+{
+	return tap_sampling_interval;
+}
+
 void tap_cleanup(void)
 {
 	tap_listener_t *elem_lq;
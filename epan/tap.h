@@ -260,6 +260,9 @@ WS_DLL_PUBLIC bool have_tap_listener(int tap_id);
 /** Return true if we have any tap listeners with filters, false otherwise. */
 WS_DLL_PUBLIC bool have_filtering_tap_listeners(void);
 
+/** Return true if any tap listeners are registered, false otherwise. */
+WS_DLL_PUBLIC bool have_tap_listeners(void);
+
 /** If any tap listeners have a filter with references to the currently
  * selected frame in the GUI (edt->tree), update them.
  */
@@ -272,6 +275,18 @@ WS_DLL_PUBLIC void tap_listeners_load_field_references(epan_dissect_t *edt);
  */
 WS_DLL_PUBLIC unsigned union_of_tap_listener_flags(void);
 
+/** Record that the program feeding us packets is sampling, i.e. processing
+ * only every interval'th record of the capture.  Tap listeners that
+ * accumulate additive statistics (packet and byte counts) can multiply
+ * them by the interval to estimate the totals for the whole capture.
+ */
+WS_DLL_PUBLIC void set_tap_sampling_interval(unsigned interval);
+
+/** Get the sampling interval recorded by set_tap_sampling_interval(),
+ * or 1 if every record is being processed.
+ */
+WS_DLL_PUBLIC unsigned get_tap_sampling_interval(void);
+
 /** This function can be used by a dissector to fetch any tapped data before
  * returning.
  * This can be useful if one wants to extract the data inside dissector  BEFORE
@@ -95,4 +95,9 @@ void tvb_add_to_chain(tvbuff_t *parent, tvbuff_t *child);
 unsigned tvb_offset_from_real_beginning_counter(const tvbuff_t *tvb, const unsigned counter);
 
 void tvb_check_offset_length(const tvbuff_t *tvb, const int offset, int const length_val, unsigned *offset_ptr, unsigned *length_ptr);
+
+/* Copy accounting internals, shared with tvbuff_composite.c. */
+extern bool tvb_copy_stats_enabled;
+
+void tvb_copy_stats_record(tvb_copy_kind_t kind, uint64_t bytes);
 #endif
@@ -42,6 +42,7 @@
 #include "to_str.h"
 #include "charsets.h"
 #include "proto.h"	/* XXX - only used for DISSECTOR_ASSERT, probably a new header file? */
+#include "packet.h"	/* for dissector_profile_current_proto() */
 #include "exceptions.h"
 
 #include <time.h>
@@ -61,6 +62,93 @@ ensure_contiguous(tvbuff_t *tvb, const int offset, const int length);
 static inline uint8_t *
 tvb_get_raw_string(wmem_allocator_t *scope, tvbuff_t *tvb, const int offset, const int length);
 
+/*
+ * Copy accounting. When enabled, accessors that materialize tvbuff data
+ * record the copy, attributed to the protocol whose dissector is
+ * currently running.
+ */
+bool tvb_copy_stats_enabled;
+
+static GHashTable *tvb_copy_stats_table;
+
+void
+tvb_copy_stats_set_enabled(bool enabled)
+{
+	tvb_copy_stats_enabled = enabled;
+}
+
+bool
+tvb_copy_stats_get_enabled(void)
+{
+	return tvb_copy_stats_enabled;
+}
+
+void
+tvb_copy_stats_reset(void)
+{
+	if (tvb_copy_stats_table != NULL)
+		g_hash_table_remove_all(tvb_copy_stats_table);
+}
+
+void
+tvb_copy_stats_record(tvb_copy_kind_t kind, uint64_t bytes)
+{
+	tvb_copy_stat_t *stat;
+	int proto_id;
+
+	proto_id = dissector_profile_current_proto();
+
+	if (tvb_copy_stats_table == NULL) {
+		tvb_copy_stats_table = g_hash_table_new_full(g_direct_hash,
+		    g_direct_equal, NULL, g_free);
+	}
+
+	stat = (tvb_copy_stat_t *)g_hash_table_lookup(tvb_copy_stats_table,
+	    GINT_TO_POINTER(proto_id));
+	if (stat == NULL) {
+		stat = g_new0(tvb_copy_stat_t, 1);
+		stat->proto_id = proto_id;
+		g_hash_table_insert(tvb_copy_stats_table,
+		    GINT_TO_POINTER(proto_id), stat);
+	}
+	stat->calls[kind]++;
+	stat->bytes[kind] += bytes;
+}
+
+static int
+tvb_copy_stats_compare(const void *a, const void *b)
+{
+	const tvb_copy_stat_t *sa = (const tvb_copy_stat_t *)a;
+	const tvb_copy_stat_t *sb = (const tvb_copy_stat_t *)b;
+	uint64_t ta = 0, tb = 0;
+	int kind;
+
+	for (kind = 0; kind < TVB_COPY_NUM_KINDS; kind++) {
+		ta += sa->bytes[kind];
+		tb += sb->bytes[kind];
+	}
+	if (ta != tb)
+		return (ta < tb) ? 1 : -1;
+	return 0;
+}
+
+GArray *
+tvb_copy_stats_get(void)
+{
+	GArray *stats;
+	GHashTableIter iter;
+	void *value;
+
+	stats = g_array_new(false, false, sizeof(tvb_copy_stat_t));
+	if (tvb_copy_stats_table != NULL) {
+		g_hash_table_iter_init(&iter, tvb_copy_stats_table);
+		while (g_hash_table_iter_next(&iter, NULL, &value))
+			g_array_append_vals(stats, value, 1);
+	}
+	g_array_sort(stats, tvb_copy_stats_compare);
+	return stats;
+}
+
 tvbuff_t *
 tvb_new(const struct tvb_ops *ops)
 {
@@ -991,6 +1079,9 @@ tvb_memdup(wmem_allocator_t *scope, tvbuff_t *tvb, const int offset, size_t leng
 	if (abs_length == 0)
 		return NULL;
 
+	if (G_UNLIKELY(tvb_copy_stats_enabled))
+		tvb_copy_stats_record(TVB_COPY_MEMDUP, abs_length);
+
 	duped = wmem_alloc(scope, abs_length);
 	return tvb_memcpy(tvb, duped, abs_offset, abs_length);
 }
@@ -3239,6 +3330,9 @@ tvb_get_string_enc(wmem_allocator_t *scope, tvbuff_t *tvb, const int offset,
 		THROW(ReportedBoundsError);
 	}
 
+	if (G_UNLIKELY(tvb_copy_stats_enabled))
+		tvb_copy_stats_record(TVB_COPY_STRING, length);
+
 	switch (encoding & ENC_CHARENCODING_MASK) {
 
 	case ENC_ASCII:
@@ -3917,6 +4011,12 @@ tvb_get_stringz_enc(wmem_allocator_t *scope, tvbuff_t *tvb, const int offset, in
 		break;
 	}
 
+	if (G_UNLIKELY(tvb_copy_stats_enabled) && strptr != NULL) {
+		/* The converted string may be longer or shorter than the
+		 * octets in the tvbuff; its UTF-8 size is close enough. */
+		tvb_copy_stats_record(TVB_COPY_STRING, strlen((const char *)strptr) + 1);
+	}
+
 	return strptr;
 }
 
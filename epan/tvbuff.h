@@ -1331,6 +1331,41 @@ WS_DLL_PUBLIC unsigned tvb_get_varint(tvbuff_t *tvb, unsigned offset, unsigned m
 
 /************** END OF ACCESSORS ****************/
 
+/* Copy accounting.
+ *
+ * When enabled, tvbuff accessors that materialize data -- tvb_memdup(),
+ * string extraction, and composite tvbuff flattening -- record the number
+ * of copies and the bytes copied, attributed to the protocol whose
+ * dissector is currently running (see dissector_profile_current_proto()
+ * in packet.h). */
+
+typedef enum {
+	TVB_COPY_MEMDUP,	/**< tvb_memdup() and friends */
+	TVB_COPY_STRING,	/**< string extraction (tvb_get_string_enc() etc.) */
+	TVB_COPY_COMPOSITE,	/**< composite tvbuff flattening */
+	TVB_COPY_NUM_KINDS
+} tvb_copy_kind_t;
+
+typedef struct tvb_copy_stat {
+	int proto_id;				/**< protocol id, or -1 if no dissector was active */
+	uint64_t calls[TVB_COPY_NUM_KINDS];	/**< number of copies, per kind */
+	uint64_t bytes[TVB_COPY_NUM_KINDS];	/**< bytes copied, per kind */
+} tvb_copy_stat_t;
+
+/** Enable or disable tvbuff copy accounting. */
+WS_DLL_PUBLIC void tvb_copy_stats_set_enabled(bool enabled);
+
+/** Report whether tvbuff copy accounting is enabled. */
+WS_DLL_PUBLIC bool tvb_copy_stats_get_enabled(void);
+
+/** Discard all accumulated copy statistics. */
+WS_DLL_PUBLIC void tvb_copy_stats_reset(void);
+
+/** Return the accumulated per-protocol copy statistics as an array of
+ * tvb_copy_stat_t, sorted by total bytes copied, descending. The caller
+ * owns the returned array and must free it with g_array_free(). */
+WS_DLL_PUBLIC GArray *tvb_copy_stats_get(void);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -24,8 +24,19 @@ typedef struct {
 	unsigned		*start_offsets;
 	unsigned		*end_offsets;
 
+	/* Copies of small cross-boundary ranges handed out by get_ptr,
+	 * so that such requests don't flatten the whole composite. They
+	 * live until the tvbuff is freed, preserving the usual
+	 * tvb_get_ptr() pointer lifetime. */
+	GPtrArray	*slices;
+	unsigned	 slice_bytes;
+
 } tvb_comp_t;
 
+/* Largest cross-boundary request served from a slice; anything bigger
+ * flattens the composite as before. */
+#define COMPOSITE_SLICE_MAX	64
+
 struct tvb_composite {
 	struct tvbuff tvb;
 
@@ -42,6 +53,8 @@ composite_free(tvbuff_t *tvb)
 
 	g_free(composite->start_offsets);
 	g_free(composite->end_offsets);
+	if (composite->slices)
+		g_ptr_array_free(composite->slices, true);
 	g_free((void *)tvb->real_data);
 }
 
@@ -51,6 +64,9 @@ composite_offset(const tvbuff_t *tvb _U_, const unsigned counter)
 	return counter;
 }
 
+static void *
+composite_memcpy(tvbuff_t *tvb, void* _target, unsigned abs_offset, unsigned abs_length);
+
 static const uint8_t*
 composite_get_ptr(tvbuff_t *tvb, unsigned abs_offset, unsigned abs_length)
 {
@@ -92,8 +108,31 @@ composite_get_ptr(tvbuff_t *tvb, unsigned abs_offset, unsigned abs_length)
 		return tvb_get_ptr(member_tvb, member_offset, abs_length);
 	}
 	else {
+		/* The range crosses a member boundary. Flattening the whole
+		 * composite doubles the memory used by every reassembled PDU,
+		 * and the typical caller that gets here is a fixed-width
+		 * accessor needing just a handful of bytes, so serve small
+		 * requests from a copy of only the requested range. Once the
+		 * slices add up to a sizeable share of the full length,
+		 * flattening is the cheaper option after all. */
+		if (abs_length <= COMPOSITE_SLICE_MAX &&
+		    composite->slice_bytes + abs_length <= tvb->length / 2) {
+			uint8_t *slice = (uint8_t *)g_malloc(abs_length);
+
+			composite_memcpy(tvb, slice, abs_offset, abs_length);
+			if (composite->slices == NULL)
+				composite->slices = g_ptr_array_new_with_free_func(g_free);
+			g_ptr_array_add(composite->slices, slice);
+			composite->slice_bytes += abs_length;
+			if (G_UNLIKELY(tvb_copy_stats_enabled))
+				tvb_copy_stats_record(TVB_COPY_COMPOSITE, abs_length);
+			return slice;
+		}
+
 		/* Use a temporary variable as tvb_memcpy is also checking tvb->real_data pointer */
 		void *real_data = g_malloc(tvb->length);
+		if (G_UNLIKELY(tvb_copy_stats_enabled))
+			tvb_copy_stats_record(TVB_COPY_COMPOSITE, tvb->length);
 		tvb_memcpy(tvb, real_data, 0, tvb->length);
 		tvb->real_data = (const uint8_t *)real_data;
 		return tvb->real_data + abs_offset;
@@ -167,6 +206,68 @@ composite_memcpy(tvbuff_t *tvb, void* _target, unsigned abs_offset, unsigned abs
 	DISSECTOR_ASSERT_NOT_REACHED();
 }
 
+static int
+composite_find_uint8(tvbuff_t *tvb, unsigned abs_offset, unsigned limit, uint8_t needle)
+{
+	struct tvb_composite *composite_tvb = (struct tvb_composite *) tvb;
+	tvb_comp_t *composite = &composite_tvb->composite;
+	GSList	   *slist;
+	unsigned    i = 0;
+
+	/* Search the members covering the range one by one, so that the
+	 * search doesn't materialize a contiguous copy of the composite. */
+	for (slist = composite->tvbs; slist != NULL && limit > 0; slist = slist->next, i++) {
+		tvbuff_t *member_tvb = (tvbuff_t *)slist->data;
+		unsigned  member_offset, member_limit;
+		int	  result;
+
+		if (abs_offset > composite->end_offsets[i])
+			continue;
+
+		member_offset = abs_offset - composite->start_offsets[i];
+		member_limit = MIN(limit, member_tvb->length - member_offset);
+
+		result = tvb_find_uint8(member_tvb, member_offset, member_limit, needle);
+		if (result != -1)
+			return (int) ((unsigned)result + composite->start_offsets[i]);
+
+		abs_offset += member_limit;
+		limit	   -= member_limit;
+	}
+
+	return -1;
+}
+
+static int
+composite_pbrk_uint8(tvbuff_t *tvb, unsigned abs_offset, unsigned limit, const ws_mempbrk_pattern* pattern, unsigned char *found_needle)
+{
+	struct tvb_composite *composite_tvb = (struct tvb_composite *) tvb;
+	tvb_comp_t *composite = &composite_tvb->composite;
+	GSList	   *slist;
+	unsigned    i = 0;
+
+	for (slist = composite->tvbs; slist != NULL && limit > 0; slist = slist->next, i++) {
+		tvbuff_t *member_tvb = (tvbuff_t *)slist->data;
+		unsigned  member_offset, member_limit;
+		int	  result;
+
+		if (abs_offset > composite->end_offsets[i])
+			continue;
+
+		member_offset = abs_offset - composite->start_offsets[i];
+		member_limit = MIN(limit, member_tvb->length - member_offset);
+
+		result = tvb_ws_mempbrk_pattern_uint8(member_tvb, member_offset, member_limit, pattern, found_needle);
+		if (result != -1)
+			return (int) ((unsigned)result + composite->start_offsets[i]);
+
+		abs_offset += member_limit;
+		limit	   -= member_limit;
+	}
+
+	return -1;
+}
+
 static const struct tvb_ops tvb_composite_ops = {
 	sizeof(struct tvb_composite), /* size */
 
@@ -174,8 +275,8 @@ static const struct tvb_ops tvb_composite_ops = {
 	composite_offset,     /* offset */
 	composite_get_ptr,    /* get_ptr */
 	composite_memcpy,     /* memcpy */
-	NULL,                 /* find_uint8 XXX */
-	NULL,                 /* pbrk_uint8 XXX */
+	composite_find_uint8, /* find_uint8 */
+	composite_pbrk_uint8, /* pbrk_uint8 */
 	NULL,                 /* clone */
 };
 
@@ -201,6 +302,8 @@ tvb_new_composite(void)
 	composite->tvbs		 = NULL;
 	composite->start_offsets = NULL;
 	composite->end_offsets	 = NULL;
+	composite->slices	 = NULL;
+	composite->slice_bytes	 = 0;
 
 	return tvb;
 }
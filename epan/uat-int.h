@@ -58,6 +58,9 @@ struct epan_uat {
     GArray* user_data;  /**< An array of valid records that will be exposed to the dissector. */
     GArray* raw_data;   /**< An array of records containing possibly invalid data. For internal use only. */
     GArray* valid_data; /**< An array of booleans describing whether the records in 'raw_data' are valid or not. */
+    uat_lookup_key_cb_t key_cb; /**< Optional, derives the key of a record for 'lookup_index'. */
+    GHashTable* lookup_index;   /**< Lazily rebuilt key-to-record map over 'user_data', see uat_lookup(). */
+    bool index_valid;
     bool changed;
     uat_rep_t* rep;
     uat_rep_free_cb_t free_rep;
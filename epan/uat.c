@@ -89,6 +89,9 @@ uat_t* uat_new(const char* name,
     uat->user_data = g_array_new(false,false,(unsigned)uat->record_size);
     uat->raw_data = g_array_new(false,false,(unsigned)uat->record_size);
     uat->valid_data = g_array_new(false,false,sizeof(bool));
+    uat->key_cb = NULL;
+    uat->lookup_index = NULL;
+    uat->index_valid = false;
     uat->changed = false;
     uat->loaded = false;
     uat->rep = NULL;
@@ -114,6 +117,12 @@ uat_t* uat_new(const char* name,
     return uat;
 }
 
+/* Marks the lookup index as stale. Called whenever the user-visible record
+ * list changes; the index is rebuilt on the next uat_lookup(). */
+static void uat_index_invalidate(uat_t* uat) {
+    uat->index_valid = false;
+}
+
 void* uat_add_record(uat_t* uat, const void* data, bool valid_rec) {
     void* rec;
     bool* valid;
@@ -131,6 +140,7 @@ void* uat_add_record(uat_t* uat, const void* data, bool valid_rec) {
         }
 
         UAT_UPDATE(uat);
+        uat_index_invalidate(uat);
 
         valid = &g_array_index(uat->valid_data, bool, uat->valid_data->len-1);
         *valid = valid_rec;
@@ -285,6 +295,45 @@ void uat_set_default_values(uat_t *uat_in, const char *default_values[])
     uat_in->default_values = default_values;
 }
 
+void uat_set_lookup_key_cb(uat_t *uat_in, uat_lookup_key_cb_t key_cb)
+{
+    uat_in->key_cb = key_cb;
+    uat_index_invalidate(uat_in);
+}
+
+void* uat_lookup(uat_t *uat_in, const char *key)
+{
+    unsigned i;
+
+    ws_assert(uat_in->key_cb);
+
+    if (!uat_in->index_valid) {
+        if (uat_in->lookup_index) {
+            g_hash_table_remove_all(uat_in->lookup_index);
+        } else {
+            uat_in->lookup_index = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+        }
+
+        for (i = 0; i < uat_in->user_data->len; i++) {
+            void* rec = UAT_USER_INDEX_PTR(uat_in, i);
+            char* rec_key = uat_in->key_cb(rec);
+
+            if (!rec_key) continue;
+
+            /* First record wins, as it would in a linear scan. */
+            if (g_hash_table_contains(uat_in->lookup_index, rec_key)) {
+                g_free(rec_key);
+            } else {
+                g_hash_table_insert(uat_in->lookup_index, rec_key, rec);
+            }
+        }
+
+        uat_in->index_valid = true;
+    }
+
+    return g_hash_table_lookup(uat_in->lookup_index, key);
+}
+
 char *uat_fld_tostr(void *rec, uat_field_t *f) {
     unsigned     len;
     char       *ptr;
@@ -434,6 +483,7 @@ bool uat_save(uat_t* uat, char** error) {
         }
     }
 
+    uat_index_invalidate(uat);
 
     fprintf(fp,"# This file is automatically generated, DO NOT MODIFY.\n");
 
@@ -491,6 +541,8 @@ void uat_clear(uat_t* uat) {
     g_array_set_size(uat->user_data,0);
     g_array_set_size(uat->valid_data,0);
 
+    uat_index_invalidate(uat);
+
     *((uat)->user_ptr) = NULL;
     *((uat)->nrows_p) = 0;
 
@@ -523,6 +575,8 @@ static void free_uat(uat_t *uat)
     g_array_free(uat->user_data, true);
     g_array_free(uat->raw_data, true);
     g_array_free(uat->valid_data, true);
+    if (uat->lookup_index)
+        g_hash_table_destroy(uat->lookup_index);
     for (j = 0; uat->fields[j].title; j++)
         g_free(uat->fields[j].priv);
     g_free(uat);
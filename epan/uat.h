@@ -124,6 +124,16 @@ typedef void (*uat_reset_cb_t)(void);
  */
 typedef bool (*uat_update_cb_t)(void *record, char **error);
 
+/*
+ * Lookup Key CB
+ * key(record)
+ *
+ * Returns the lookup key of a valid record as a g_malloc()'d string, or
+ * NULL if the record should not be indexed. Only needed by UATs that use
+ * uat_lookup(), see uat_set_lookup_key_cb().
+ */
+typedef char* (*uat_lookup_key_cb_t)(const void *record);
+
 
 /*******
  * Callbacks for single fields (these deal with single values)
@@ -364,6 +374,38 @@ uat_t* uat_get_table_by_name(const char* name);
 WS_DLL_PUBLIC
 void uat_set_default_values(uat_t *uat_in, const char *default_values[]);
 
+/**
+ * Declare a lookup key for a UAT, enabling uat_lookup().
+ *
+ * The callback derives the key of a record in the user-visible list.
+ * The UAT maintains a hash index from key to record, rebuilt whenever the
+ * records change, so consumers with many entries do not have to scan the
+ * whole table on every packet.
+ *
+ * @param uat_in Pointer to a uat. Must not be NULL.
+ * @param key_cb Returns the key of a record as a g_malloc()'d string, or
+ * NULL to leave that record out of the index.
+ */
+WS_DLL_PUBLIC
+void uat_set_lookup_key_cb(uat_t *uat_in, uat_lookup_key_cb_t key_cb);
+
+/**
+ * Find the valid record with the given key.
+ *
+ * If several records share a key the first one wins, as it would in a
+ * linear scan of the table. The returned pointer follows the same rules
+ * as the records exposed through 'data_ptr': it is only valid until the
+ * table changes. Must only be called on a UAT with a lookup key declared
+ * through uat_set_lookup_key_cb().
+ *
+ * @param uat_in Pointer to a uat. Must not be NULL.
+ * @param key The key to look up.
+ *
+ * @return A pointer to the record on success, NULL if no record matches.
+ */
+WS_DLL_PUBLIC
+void* uat_lookup(uat_t *uat_in, const char *key);
+
 /*
  * Some common uat_fld_chk_cbs
  */
@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <epan/expert.h>
 #include <epan/ex-opt.h>
+#include <epan/prefs.h>
 #include <epan/introspection.h>
 #include <wiretap/introspection.h>
 #include <wsutil/privileges.h>
@@ -60,6 +61,32 @@ static int hf_wslua_fake;
 static int hf_wslua_text;
 
 static expert_field ei_lua_error;
+static expert_field ei_lua_suspended;
+
+/* Per-packet execution budget for Lua dissectors, in microseconds.
+ * 0 (the default) disables the budget. A Lua dissector that blows the
+ * budget on a single packet is suspended for the rest of the session,
+ * so one pathological script can't silently multiply load time. Its
+ * cumulative cost shows up per protocol in "tshark -z dissector,time"
+ * like any other dissector's. */
+static unsigned wslua_packet_budget;
+static GHashTable *wslua_suspended_dissectors;
+
+static bool wslua_dissector_is_suspended(const char *name) {
+    return wslua_packet_budget > 0 &&
+        wslua_suspended_dissectors != NULL &&
+        g_hash_table_contains(wslua_suspended_dissectors, name);
+}
+
+static void wslua_suspend_dissector(const char *name, int64_t elapsed) {
+    if (wslua_suspended_dissectors == NULL) {
+        wslua_suspended_dissectors = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    }
+    g_hash_table_add(wslua_suspended_dissectors, g_strdup(name));
+    report_warning("The Lua dissector %s spent %" PRId64 " microseconds on one packet, "
+                   "over the budget of %u; suspending it for this session.",
+                   name, elapsed, wslua_packet_budget);
+}
 
 static expert_field ei_lua_proto_checksum_comment;
 static expert_field ei_lua_proto_checksum_chat;
@@ -309,7 +336,16 @@ int dissect_lua(tvbuff_t* tvb, packet_info* pinfo, proto_tree* tree, void* data
     lua_remove(L,2);
 
     // Is the dissector a function?
-    if (lua_isfunction(L,2)) {
+    if (!lua_isfunction(L,2)) {
+        proto_tree_add_expert_format(tree, pinfo, &ei_lua_error, tvb, 0, 0,
+                    "Lua Error: did not find the %s dissector in the dissectors table", pinfo->current_proto);
+    } else if (wslua_dissector_is_suspended(pinfo->current_proto)) {
+        proto_tree_add_expert_format(tree, pinfo, &ei_lua_suspended, tvb, 0, 0,
+                    "The %s dissector was suspended after exceeding the per-packet budget of %u microseconds",
+                    pinfo->current_proto, wslua_packet_budget);
+        lua_settop(L,0);
+    } else {
+        int64_t start_time = wslua_packet_budget > 0 ? g_get_monotonic_time() : 0;
 
         // After call, stack: [ error_handler_func, dissector, tvb ]
         push_Tvb(L,tvb);
@@ -331,9 +367,12 @@ int dissect_lua(tvbuff_t* tvb, packet_info* pinfo, proto_tree* tree, void* data
             }
         }
 
-    } else {
-        proto_tree_add_expert_format(tree, pinfo, &ei_lua_error, tvb, 0, 0,
-                    "Lua Error: did not find the %s dissector in the dissectors table", pinfo->current_proto);
+        if (wslua_packet_budget > 0) {
+            int64_t elapsed = g_get_monotonic_time() - start_time;
+            if (elapsed > (int64_t)wslua_packet_budget) {
+                wslua_suspend_dissector(pinfo->current_proto, elapsed);
+            }
+        }
     }
 
     wmem_register_callback(pinfo->pool, lua_pinfo_end, NULL);
@@ -413,6 +452,13 @@ bool heur_dissect_lua(tvbuff_t* tvb, packet_info* pinfo, proto_tree* tree, void*
         return false;
     }
 
+    if (wslua_dissector_is_suspended(pinfo->current_proto)) {
+        lua_settop(L,0);
+        return false;
+    }
+
+    int64_t start_time = wslua_packet_budget > 0 ? g_get_monotonic_time() : 0;
+
     push_Tvb(L,tvb);
     push_Pinfo(L,pinfo);
     lua_tree = push_TreeItem(L, tree, proto_tree_add_item(tree, hf_wslua_fake, tvb, 0, 0, ENC_NA));
@@ -434,6 +480,13 @@ bool heur_dissect_lua(tvbuff_t* tvb, packet_info* pinfo, proto_tree* tree, void*
         lua_pop(L, 1);
     }
 
+    if (wslua_packet_budget > 0) {
+        int64_t elapsed = g_get_monotonic_time() - start_time;
+        if (elapsed > (int64_t)wslua_packet_budget) {
+            wslua_suspend_dissector(pinfo->current_proto, elapsed);
+        }
+    }
+
     wmem_register_callback(pinfo->pool, lua_pinfo_end, NULL);
 
     lua_pinfo = saved_lua_pinfo;
@@ -1500,6 +1553,9 @@ void wslua_init(register_cb cb, void *client_data) {
 
         /* this one is for reporting errors executing Lua code */
         { &ei_lua_error, { "_ws.lua.error", PI_UNDECODED, PI_ERROR ,"Lua Error", EXPFILL }},
+
+        /* and this one for packets skipped because their dissector blew the per-packet budget */
+        { &ei_lua_suspended, { "_ws.lua.suspended", PI_UNDECODED, PI_WARN ,"Lua dissector suspended", EXPFILL }},
     };
 
     if (first_time) {
@@ -1519,6 +1575,14 @@ void wslua_init(register_cb cb, void *client_data) {
         proto_register_subtree_array(ett, array_length(ett));
         expert_lua = expert_register_protocol(proto_lua);
         expert_register_field_array(expert_lua, ei, array_length(ei));
+
+        module_t *lua_module = prefs_register_protocol(proto_lua, NULL);
+        prefs_register_uint_preference(lua_module, "packet_budget",
+                "Per-packet budget for Lua dissectors (microseconds)",
+                "If nonzero, a Lua dissector that spends longer than this on a "
+                "single packet is suspended for the rest of the session and "
+                "reported with a warning. 0 disables the budget.",
+                10, &wslua_packet_budget);
     }
 
     lua_atpanic(L,wslua_panic);
@@ -716,6 +716,56 @@ WSLUA_METAMETHOD Field__call (lua_State* L) {
     WSLUA_RETURN(items_found); /* All the values of this field */
 }
 
+WSLUA_FUNCTION wslua_fetch_fields(lua_State* L) {
+    /*
+    Obtain the first `FieldInfo` (or nil) of each given `Field`, in a single call.
+
+    Calling each extractor separately crosses the Lua/C boundary once per field;
+    a tap that needs several fields per packet can fetch them all at once with
+    this function instead:
+
+    local src, dst, len = fetch_fields(f_src, f_dst, f_len)
+
+    Unlike calling the extractor, only the first value of a multi-valued field
+    is returned. Like the extractors themselves, this can only be used inside
+    dissectors, post-dissectors, heuristic dissectors and taps.
+    */
+    int n = lua_gettop(L);
+    int i;
+
+    if (! lua_pinfo ) {
+        WSLUA_ERROR(wslua_fetch_fields,"Fields cannot be used outside dissectors or taps");
+        return 0;
+    }
+
+    for (i = 1; i <= n; i++) {
+        Field f = checkField(L,i);
+        header_field_info* in = f->hfi;
+        field_info* first = NULL;
+
+        if (! in) {
+            luaL_error(L,"invalid field");
+            return 0;
+        }
+
+        while (in && !first) {
+            GPtrArray* found = proto_get_finfo_ptr_array(lua_tree->tree, in->id);
+            if (found && found->len > 0) {
+                first = (field_info *) g_ptr_array_index(found,0);
+            }
+            in = (in->same_name_prev_id != -1) ? proto_registrar_get_nth(in->same_name_prev_id) : NULL;
+        }
+
+        if (first) {
+            push_FieldInfo(L, first);
+        } else {
+            lua_pushnil(L);
+        }
+    }
+
+    WSLUA_RETURN(n); /* One `FieldInfo` (or nil) per argument, in argument order */
+}
+
 WSLUA_METAMETHOD Field__tostring(lua_State* L) {
     /* Obtain a string with the field filter name. */
     Field f = checkField(L,1);
@@ -26,6 +26,7 @@
 #include <wsutil/ws_assert.h>
 #include <wsutil/version_info.h>
 #include <wsutil/report_message.h>
+#include <wsutil/ws_taskpool.h>
 
 #include <wiretap/merge.h>
 
@@ -80,6 +81,10 @@ static bool read_record(capture_file *cf, wtap_rec *rec, Buffer *buf,
 
 static void rescan_packets(capture_file *cf, const char *action, const char *action_item, bool redissect);
 
+static void records_cache_clear(capture_file *cf);
+
+static void cf_prefetch_invalidate(capture_file *cf);
+
 typedef enum {
     MR_NOTMATCHED,
     MR_MATCHED,
@@ -138,6 +143,10 @@ static void cf_rename_failure_alert_box(const char *filename, int err);
 /* Show the progress bar after this many seconds. */
 #define PROGBAR_SHOW_DELAY 0.5
 
+/* How much of the file around the selected packet to ask the OS to
+   prefetch, since the next packet read is likely to be a neighbor. */
+#define PREFETCH_WINDOW (1024 * 1024)
+
 /*
  * Maximum number of records we support in a file.
  *
@@ -257,10 +266,12 @@ cf_open(capture_file *cf, const char *fname, unsigned int type, bool is_tempfile
 
     /* Initialize the record metadata. */
     wtap_rec_init(&cf->rec);
+    wtap_rec_init(&cf->prefetch_rec);
 
     /* XXX - we really want to initialize this after we've read all
        the packets, so we know how much we'll ultimately need. */
     ws_buffer_init(&cf->buf, 1514);
+    ws_buffer_init(&cf->prefetch_buf, 1514);
 
     /* We're about to start reading the file. */
     cf->state = FILE_READ_IN_PROGRESS;
@@ -365,6 +376,7 @@ cf_close(capture_file *cf)
         wtap_close(cf->provider.wth);
         cf->provider.wth = NULL;
     }
+    records_cache_clear(cf);
     /* We have no file open... */
     if (cf->filename != NULL) {
         /* If it's a temporary file, remove it. */
@@ -379,19 +391,28 @@ cf_close(capture_file *cf)
     /* no open_routine type */
     cf->open_type = WTAP_TYPE_AUTO;
 
+    /* Get rid of the speculatively dissected frame, if any. */
+    cf_prefetch_invalidate(cf);
+
     /* Clean up the record metadata. */
     wtap_rec_cleanup(&cf->rec);
+    wtap_rec_cleanup(&cf->prefetch_rec);
 
     /* Clear the packet list. */
     packet_list_freeze();
     packet_list_clear();
     packet_list_thaw();
 
-    /* Free up the packet buffer. */
+    /* Free up the packet buffers. */
     ws_buffer_free(&cf->buf);
+    ws_buffer_free(&cf->prefetch_buf);
 
     dfilter_free(cf->rfcode);
     cf->rfcode = NULL;
+    if (cf->dfilter_verdicts != NULL) {
+        g_hash_table_destroy(cf->dfilter_verdicts);
+        cf->dfilter_verdicts = NULL;
+    }
     if (cf->provider.frames != NULL) {
         free_frame_data_sequence(cf->provider.frames);
         cf->provider.frames = NULL;
@@ -577,8 +598,18 @@ cf_read(capture_file *cf, bool reloading)
        XXX - do we know this at open time? */
     cf->compression_type = wtap_get_compression_type(cf->provider.wth);
 
-    /* The packet list window will be empty until the file is completely loaded */
-    packet_list_freeze();
+    /* On an initial load, leave the packet list live so that rows appear
+       and can be selected while the rest of the file is still being read,
+       the same way live capture ingestion behaves. The progress updates
+       below pump the GUI event loop between records, and anything unsafe
+       while we hold the read lock (redissection, filtering, sorting) is
+       either queued or refused until the read finishes.
+
+       Reloads keep the old frozen behavior: the surrounding code (e.g. a
+       profile change) may have frozen the list itself and relies on the
+       thaw below to restore the new column layout in one step. */
+    if (reloading)
+        packet_list_freeze();
 
     cf->stop_flag = false;
     start_time = g_get_monotonic_time();
@@ -731,8 +762,12 @@ cf_read(capture_file *cf, bool reloading)
        WTAP_ENCAP_PER_PACKET). */
     cf->lnk_t = wtap_file_encap(cf->provider.wth);
 
-    cf->current_frame = frame_data_sequence_find(cf->provider.frames, cf->first_displayed);
+    /* If the user already selected a packet while the live list was
+       loading, keep that selection. */
+    if (cf->current_frame == NULL)
+        cf->current_frame = frame_data_sequence_find(cf->provider.frames, cf->first_displayed);
 
+    /* A no-op if the list wasn't frozen above or by our caller. */
     packet_list_thaw();
 
     /* It is safe again to execute redissections or sort. */
@@ -1217,6 +1252,112 @@ cf_set_rfcode(capture_file *cf, dfilter_t *rfcode)
     cf->rfcode = rfcode;
 }
 
+/*
+ * Cache of per-frame display filter verdicts, keyed by filter text.
+ * When an analyst switches back to a filter that has already been
+ * applied to this file, the verdicts let rescan_packets() skip reading
+ * and dissecting every frame.  The cache is only consulted and recorded
+ * when the verdicts cannot be observed to differ between runs: no
+ * redissection, no tap listeners, no columns and no ${...} references.
+ */
+#define DFILTER_VERDICT_CACHE_MAX 8
+
+typedef struct {
+    uint8_t  *passed;    /* One bit per frame; frame number 1 is bit 0. */
+    uint8_t  *depended;  /* dependent_of_displayed bits, same layout. */
+    uint32_t  count;     /* Number of frames covered. */
+    unsigned  last_used; /* Age stamp for eviction. */
+} dfilter_verdicts_t;
+
+static unsigned dfilter_verdict_age;
+
+#define VERDICT_BYTE(framenum) (((framenum) - 1) / 8)
+#define VERDICT_BIT(framenum)  (1 << (((framenum) - 1) % 8))
+
+static void
+dfilter_verdicts_free(void *data)
+{
+    dfilter_verdicts_t *v = (dfilter_verdicts_t *)data;
+
+    g_free(v->passed);
+    g_free(v->depended);
+    g_free(v);
+}
+
+static void
+dfilter_verdicts_invalidate(capture_file *cf)
+{
+    if (cf->dfilter_verdicts)
+        g_hash_table_remove_all(cf->dfilter_verdicts);
+}
+
+static const dfilter_verdicts_t *
+dfilter_verdicts_lookup(capture_file *cf, const char *dftext)
+{
+    dfilter_verdicts_t *v;
+
+    if (cf->dfilter_verdicts == NULL)
+        return NULL;
+
+    v = (dfilter_verdicts_t *)g_hash_table_lookup(cf->dfilter_verdicts, dftext);
+    if (v)
+        v->last_used = ++dfilter_verdict_age;
+    return v;
+}
+
+static void
+dfilter_verdicts_record(capture_file *cf, const char *dftext, uint32_t frames_count)
+{
+    dfilter_verdicts_t *v;
+    frame_data *fdata;
+    uint32_t framenum;
+    size_t nbytes;
+
+    if (frames_count == 0)
+        return;
+
+    if (cf->dfilter_verdicts == NULL) {
+        cf->dfilter_verdicts = g_hash_table_new_full(g_str_hash, g_str_equal,
+                g_free, dfilter_verdicts_free);
+    }
+    else if (g_hash_table_size(cf->dfilter_verdicts) >= DFILTER_VERDICT_CACHE_MAX) {
+        GHashTableIter iter;
+        void *key, *value;
+        const char *oldest_key = NULL;
+        unsigned oldest_age = 0;
+
+        g_hash_table_iter_init(&iter, cf->dfilter_verdicts);
+        while (g_hash_table_iter_next(&iter, &key, &value)) {
+            v = (dfilter_verdicts_t *)value;
+            if (oldest_key == NULL || v->last_used < oldest_age) {
+                oldest_key = (const char *)key;
+                oldest_age = v->last_used;
+            }
+        }
+        g_hash_table_remove(cf->dfilter_verdicts, oldest_key);
+    }
+
+    nbytes = VERDICT_BYTE(frames_count) + 1;
+    v = g_new(dfilter_verdicts_t, 1);
+    v->passed = g_new0(uint8_t, nbytes);
+    v->depended = g_new0(uint8_t, nbytes);
+    v->count = frames_count;
+    v->last_used = ++dfilter_verdict_age;
+
+    /* The dependent_of_displayed bits are set by later frames that
+     * depend on earlier ones, so they can only be collected after the
+     * whole file has been scanned. */
+    for (framenum = 1; framenum <= frames_count; framenum++) {
+        fdata = frame_data_sequence_find(cf->provider.frames, framenum);
+        if (fdata->passed_dfilter)
+            v->passed[VERDICT_BYTE(framenum)] |= VERDICT_BIT(framenum);
+        if (fdata->dependent_of_displayed)
+            v->depended[VERDICT_BYTE(framenum)] |= VERDICT_BIT(framenum);
+    }
+
+    g_hash_table_replace(cf->dfilter_verdicts, g_strdup(dftext), v);
+}
+
 static void
 add_packet_to_packet_list(frame_data *fdata, capture_file *cf,
         epan_dissect_t *edt, dfilter_t *dfcode, column_info *cinfo,
@@ -1254,6 +1395,9 @@ add_packet_to_packet_list(frame_data *fdata, capture_file *cf,
             frame_tvbuff_new_buffer(&cf->provider, fdata, buf),
             fdata, cinfo);
 
+    /* The frame's state now belongs to the current dissection generation. */
+    fdata->dissect_gen = cf->dissection_generation;
+
     if (fdata->passed_dfilter && dfcode != NULL) {
         fdata->passed_dfilter = dfilter_apply_edt(dfcode, edt) ? 1 : 0;
 
@@ -1262,7 +1406,7 @@ add_packet_to_packet_list(frame_data *fdata, capture_file *cf,
              * (potentially not displayed) frames.  Find those frames and mark them
              * as depended upon.
              */
-            g_hash_table_foreach(edt->pi.fd->dependent_frames, find_and_mark_frame_depended_upon, cf->provider.frames);
+            find_and_mark_frames_depended_upon(cf->provider.frames, edt->pi.fd->dependent_frames);
         }
     }
 
@@ -1618,6 +1762,105 @@ cf_redissect_packets(capture_file *cf)
     }
 }
 
+bool
+cf_frame_dissection_current(capture_file *cf, const frame_data *fdata)
+{
+    return fdata->dissect_gen == cf->dissection_generation;
+}
+
+/*
+ * Recently read records are kept in a small MRU list so that revisiting a
+ * packet (selecting it again, reflowing the detail tree) in a compressed
+ * capture doesn't go back through the decompressor. wiretap's
+ * file_wrappers.c already keeps the current decompressed chunk and fast
+ * seek points per stream; this is the record-level tier above that.
+ */
+#define RECORDS_CACHE_MAX 64
+
+typedef struct {
+    uint32_t num;
+    wtap_rec rec;
+    Buffer   buf;
+} cached_record_t;
+
+static void
+cached_record_free(void *data)
+{
+    cached_record_t *cr = (cached_record_t *)data;
+
+    wtap_rec_cleanup(&cr->rec);
+    ws_buffer_free(&cr->buf);
+    g_free(cr);
+}
+
+static void
+records_cache_clear(capture_file *cf)
+{
+    if (cf->records_cache) {
+        g_queue_free_full(cf->records_cache, cached_record_free);
+        cf->records_cache = NULL;
+    }
+}
+
+static bool
+records_cache_lookup(capture_file *cf, uint32_t num, wtap_rec *rec, Buffer *buf)
+{
+    GList *link;
+
+    if (!cf->records_cache)
+        return false;
+    for (link = cf->records_cache->head; link != NULL; link = link->next) {
+        cached_record_t *cr = (cached_record_t *)link->data;
+        Buffer options;
+
+        if (cr->num != num)
+            continue;
+        /* Move to the front so frequently revisited packets stay cached. */
+        g_queue_unlink(cf->records_cache, link);
+        g_queue_push_head_link(cf->records_cache, link);
+
+        /* Hand the caller its own copy; the block reference is shared. */
+        wtap_rec_reset(rec);
+        options = rec->options_buf;
+        *rec = cr->rec;
+        rec->block = cr->rec.block ? wtap_block_ref(cr->rec.block) : NULL;
+        rec->options_buf = options;
+        ws_buffer_clean(&rec->options_buf);
+        ws_buffer_append_buffer(&rec->options_buf, &cr->rec.options_buf);
+        ws_buffer_clean(buf);
+        ws_buffer_append_buffer(buf, &cr->buf);
+        return true;
+    }
+    return false;
+}
+
+static void
+records_cache_store(capture_file *cf, uint32_t num, wtap_rec *rec, Buffer *buf)
+{
+    cached_record_t *cr;
+
+    /* Re-reading an uncompressed file is cheap; only pay for the copies
+     * when a miss would mean decompressing again. */
+    if (cf->compression_type == WTAP_UNCOMPRESSED)
+        return;
+
+    if (!cf->records_cache)
+        cf->records_cache = g_queue_new();
+
+    cr = g_new(cached_record_t, 1);
+    cr->num = num;
+    cr->rec = *rec;
+    cr->rec.block = rec->block ? wtap_block_ref(rec->block) : NULL;
+    ws_buffer_init(&cr->rec.options_buf, ws_buffer_length(&rec->options_buf));
+    ws_buffer_append_buffer(&cr->rec.options_buf, &rec->options_buf);
+    ws_buffer_init(&cr->buf, ws_buffer_length(buf));
+    ws_buffer_append_buffer(&cr->buf, buf);
+    g_queue_push_head(cf->records_cache, cr);
+
+    if (cf->records_cache->length > RECORDS_CACHE_MAX)
+        cached_record_free(g_queue_pop_tail(cf->records_cache));
+}
+
 bool
 cf_read_record(capture_file *cf, const frame_data *fdata,
         wtap_rec *rec, Buffer *buf)
@@ -1625,10 +1868,13 @@ cf_read_record(capture_file *cf, const frame_data *fdata,
     int    err;
     char *err_info;
 
+    if (records_cache_lookup(cf, fdata->num, rec, buf))
+        return true;
     if (!wtap_seek_read(cf->provider.wth, fdata->file_off, rec, buf, &err, &err_info)) {
         cfile_read_failure_alert_box(cf->filename, err, err_info);
         return false;
     }
+    records_cache_store(cf, fdata->num, rec, buf);
     return true;
 }
 
@@ -1639,10 +1885,13 @@ cf_read_record_no_alert(capture_file *cf, const frame_data *fdata,
     int    err;
     char *err_info;
 
+    if (records_cache_lookup(cf, fdata->num, rec, buf))
+        return true;
     if (!wtap_seek_read(cf->provider.wth, fdata->file_off, rec, buf, &err, &err_info)) {
         g_free(err_info);
         return false;
     }
+    records_cache_store(cf, fdata->num, rec, buf);
     return true;
 }
 
@@ -1663,7 +1912,17 @@ cf_read_current_record(capture_file *cf)
    "redissect" is true if we need to make the dissectors reconstruct
    any state information they have (because a preference that affects
    some dissector has changed, meaning some dissector might construct
-   its state differently from the way it was constructed the last time). */
+   its state differently from the way it was constructed the last time).
+
+   The frame loop below is intentionally serial.  Re-dissecting a frame
+   is not read-only with respect to other frames: dissectors advance
+   conversation, reassembly and decryption state that later frames
+   depend on, and all of it lives in the single epan session's
+   file-scope pool.  Partitioning frames across threads with one
+   epan_dissect_t each would need a session whose state either is
+   immutable after the first pass or can be split per worker; neither
+   holds today.  The cheaper paths above (fast_refilter_ok and the
+   verdict cache) exist to avoid this loop instead. */
 static void
 rescan_packets(capture_file *cf, const char *action, const char *action_item, bool redissect)
 {
@@ -1767,6 +2026,30 @@ rescan_packets(capture_file *cf, const char *action, const char *action_item, bo
          (tap_flags & TL_REQUIRES_PROTO_TREE) ||
          (redissect && postdissectors_want_hfids()));
 
+    /*
+     * If we're just clearing the filter -- not redissecting, no filter,
+     * no tap listeners, no columns to rebuild -- every visited frame is
+     * displayed and re-dissecting it would only recompute state that
+     * already exists from the previous pass.  In that case we skip the
+     * read and dissection per frame and do only the bookkeeping.
+     */
+    bool fast_refilter_ok =
+        (!redissect && cf->dfcode == NULL && cinfo == NULL &&
+         !create_proto_tree && !have_tap_listeners());
+
+    /*
+     * If the filter has been applied to this file before, its cached
+     * verdicts let us skip the read and dissection the same way,
+     * provided nothing besides passed_dfilter is produced per frame.
+     */
+    const dfilter_verdicts_t *verdicts = NULL;
+    bool verdicts_usable =
+        (!redissect && cf->dfcode != NULL && cinfo == NULL &&
+         !have_tap_listeners() &&
+         !dfilter_uses_field_references(cf->dfcode));
+    if (verdicts_usable)
+        verdicts = dfilter_verdicts_lookup(cf, cf->dfilter);
+
     reset_tap_listeners();
     /* Which frame, if any, is the currently selected frame?
        XXX - should the selected frame or the focus frame be the "current"
@@ -1791,6 +2074,15 @@ rescan_packets(capture_file *cf, const char *action, const char *action_item, bo
            want to dissect those before their time. */
         cf->redissecting = true;
 
+        /* Everything dissected so far is now stale; frames are restamped
+           with the new generation as they are re-dissected, so consumers
+           can tell per frame whether results are still valid. */
+        cf->dissection_generation++;
+
+        /* The speculatively dissected frame belongs to the session
+           we're about to free. */
+        cf_prefetch_invalidate(cf);
+
         /* 'reset' dissection session */
         epan_free(cf->epan);
         if (cf->edt && cf->edt->pi.fd) {
@@ -1815,6 +2107,10 @@ rescan_packets(capture_file *cf, const char *action, const char *action_item, bo
          * packet list store. */
         packet_list_clear();
         add_to_packet_list = true;
+
+        /* Dissection state changed, so cached filter verdicts may no
+         * longer hold. */
+        dfilter_verdicts_invalidate(cf);
     }
 
     /* We don't yet know which will be the first and last frames displayed. */
@@ -1945,9 +2241,6 @@ rescan_packets(capture_file *cf, const char *action, const char *action_item, bo
         /* Frame dependencies from the previous dissection/filtering are no longer valid. */
         fdata->dependent_of_displayed = 0;
 
-        if (!cf_read_record(cf, fdata, &rec, &buf))
-            break; /* error reading the frame */
-
         /* If the previous frame is displayed, and we haven't yet seen the
            selected frame, remember that frame - it's the closest one we've
            yet seen before the selected frame. */
@@ -1956,9 +2249,48 @@ rescan_packets(capture_file *cf, const char *action, const char *action_item, bo
             preceding_frame = prev_frame;
         }
 
-        add_packet_to_packet_list(fdata, cf, &edt, cf->dfcode,
-                cinfo, &rec, &buf,
-                add_to_packet_list);
+        if (fast_refilter_ok && fdata->visited) {
+            /* Reproduce just the bookkeeping that
+             * add_packet_to_packet_list() would have done for a frame
+             * that passes with no filter in place. */
+            frame_data_set_before_dissect(fdata, &cf->elapsed_time,
+                    &cf->provider.ref, cf->provider.prev_dis);
+            cf->provider.prev_cap = fdata;
+            fdata->passed_dfilter = 1;
+            cf->displayed_count++;
+            frame_data_set_after_dissect(fdata, &cf->cum_bytes);
+            if (fdata->has_ts)
+                cf->provider.prev_dis = fdata;
+            if (cf->first_displayed == 0)
+                cf->first_displayed = fdata->num;
+            cf->last_displayed = fdata->num;
+        } else if (verdicts && fdata->visited && fdata->num <= verdicts->count) {
+            /* Replay the cached verdict, mirroring the bookkeeping of
+             * add_packet_to_packet_list() for an already visited frame. */
+            frame_data_set_before_dissect(fdata, &cf->elapsed_time,
+                    &cf->provider.ref, cf->provider.prev_dis);
+            cf->provider.prev_cap = fdata;
+            fdata->passed_dfilter =
+                (verdicts->passed[VERDICT_BYTE(fdata->num)] & VERDICT_BIT(fdata->num)) ? 1 : 0;
+            fdata->dependent_of_displayed =
+                (verdicts->depended[VERDICT_BYTE(fdata->num)] & VERDICT_BIT(fdata->num)) ? 1 : 0;
+            if (fdata->passed_dfilter || fdata->ref_time) {
+                cf->displayed_count++;
+                frame_data_set_after_dissect(fdata, &cf->cum_bytes);
+                if (fdata->has_ts)
+                    cf->provider.prev_dis = fdata;
+                if (cf->first_displayed == 0)
+                    cf->first_displayed = fdata->num;
+                cf->last_displayed = fdata->num;
+            }
+        } else {
+            if (!cf_read_record(cf, fdata, &rec, &buf))
+                break; /* error reading the frame */
+
+            add_packet_to_packet_list(fdata, cf, &edt, cf->dfcode,
+                    cinfo, &rec, &buf,
+                    add_to_packet_list);
+        }
 
         /* If this frame is displayed, and this is the first frame we've
            seen displayed after the selected frame, remember this frame -
@@ -1988,6 +2320,15 @@ rescan_packets(capture_file *cf, const char *action, const char *action_item, bo
     /* We are done redissecting the packet list. */
     cf->redissecting = false;
 
+    /* If we scanned every frame with a filter in place, remember the
+     * verdicts so reapplying this filter can skip the dissection. */
+    if (cf->dfcode != NULL && framenum > frames_count &&
+        !cf->stop_flag && queued_rescan_type == RESCAN_NONE &&
+        !dfilter_uses_field_references(cf->dfcode) &&
+        !(verdicts && verdicts->count == frames_count)) {
+        dfilter_verdicts_record(cf, cf->dfilter, frames_count);
+    }
+
     if (redissect) {
         frames_count = cf->count;
         /* Clear out what remains of the visited flags and per-frame data
@@ -2109,7 +2450,11 @@ cf_reftime_packets(capture_file* cf)
     cf->provider.prev_dis = NULL;
     cf->cum_bytes = 0;
 
-    for (framenum = 1; framenum <= cf->count; framenum++) {
+    /* Relative and delta time fields are changing, so cached filter
+     * verdicts that depend on them would be stale. */
+    dfilter_verdicts_invalidate(cf);
+
+    for (framenum = 1; framenum <= frames_count; framenum++) {
         fdata = frame_data_sequence_find(cf->provider.frames, framenum);
 
         /* just add some value here until we know if it is being displayed or not */
@@ -2196,19 +2541,186 @@ typedef enum {
     PSP_FAILED
 } psp_return_t;
 
+/*
+ * Record prefetching for retaps.
+ *
+ * Re-running the taps spends its time in two places: seek-reading every
+ * record back from the file (I/O, and decompression for compressed
+ * captures) and dissecting it.  The tap callbacks run inside dissection,
+ * which is single-threaded, but the reads don't have to be: a prefetcher
+ * thread with its own random-access handle on the same file stays a few
+ * records ahead of the dissection loop, so the main thread rarely waits
+ * on the file.
+ *
+ * A fixed set of items circulates between two bounded queues; since the
+ * queues can each hold every item, only the pops ever block.  The
+ * prefetcher always pushes a final zero-numbered item before exiting,
+ * so the main thread knows when to stop draining.
+ */
+#define RETAP_PREFETCH_DEPTH 32
+
+typedef struct {
+    uint32_t num;   /* frame number; 0 marks the prefetcher's last item */
+    bool     ok;    /* whether the seek-read succeeded */
+    wtap_rec rec;
+    Buffer   buf;
+} retap_prefetch_item_t;
+
+typedef struct {
+    capture_file       *cf;
+    wtap               *wth;        /* private handle; only the thread uses it */
+    uint32_t            last_frame;
+    int                 stop;       /* atomic */
+    bool                finished;   /* the main thread saw the final item */
+    ws_bounded_queue_t *empty_q;
+    ws_bounded_queue_t *filled_q;
+    GThread            *thread;
+    retap_prefetch_item_t items[RETAP_PREFETCH_DEPTH];
+} retap_prefetcher_t;
+
+static void *
+retap_prefetcher_thread(void *arg)
+{
+    retap_prefetcher_t *pf = (retap_prefetcher_t *)arg;
+    retap_prefetch_item_t *item = NULL;
+    frame_data *fdata;
+    uint32_t    framenum;
+    int         err;
+    char       *err_info;
+
+    for (framenum = 1; framenum <= pf->last_frame; framenum++) {
+        fdata = frame_data_sequence_find(pf->cf->provider.frames, framenum);
+
+        item = (retap_prefetch_item_t *)ws_bounded_queue_pop(pf->empty_q);
+        if (g_atomic_int_get(&pf->stop))
+            break;
+        item->num = framenum;
+        item->ok = wtap_seek_read(pf->wth, fdata->file_off, &item->rec,
+                &item->buf, &err, &err_info);
+        if (!item->ok) {
+            /* The main thread will retry on its own handle and report. */
+            g_free(err_info);
+        }
+        ws_bounded_queue_push(pf->filled_q, item);
+        item = NULL;
+    }
+
+    /* Tell the main thread nothing more is coming. */
+    if (item == NULL)
+        item = (retap_prefetch_item_t *)ws_bounded_queue_pop(pf->empty_q);
+    item->num = 0;
+    ws_bounded_queue_push(pf->filled_q, item);
+    return NULL;
+}
+
+static retap_prefetcher_t *
+retap_prefetcher_new(capture_file *cf, uint32_t last_frame)
+{
+    retap_prefetcher_t *pf;
+    wtap     *wth;
+    unsigned  i;
+    int       err;
+    char     *err_info;
+
+    if (cf->filename == NULL || last_frame == 0)
+        return NULL;
+    wth = wtap_open_offline(cf->filename, cf->open_type, &err, &err_info, true);
+    if (wth == NULL) {
+        /* Fall back to reading on the main thread. */
+        g_free(err_info);
+        return NULL;
+    }
+
+    pf = g_new0(retap_prefetcher_t, 1);
+    pf->cf = cf;
+    pf->wth = wth;
+    pf->last_frame = last_frame;
+    pf->empty_q = ws_bounded_queue_new(RETAP_PREFETCH_DEPTH);
+    pf->filled_q = ws_bounded_queue_new(RETAP_PREFETCH_DEPTH);
+    for (i = 0; i < RETAP_PREFETCH_DEPTH; i++) {
+        wtap_rec_init(&pf->items[i].rec);
+        ws_buffer_init(&pf->items[i].buf, 1514);
+        ws_bounded_queue_push(pf->empty_q, &pf->items[i]);
+    }
+    pf->thread = g_thread_new("retap_prefetch", retap_prefetcher_thread, pf);
+    return pf;
+}
+
+static void
+retap_prefetcher_recycle(retap_prefetcher_t *pf, retap_prefetch_item_t *item)
+{
+    wtap_rec_reset(&item->rec);
+    ws_bounded_queue_push(pf->empty_q, item);
+}
+
+/* Return the prefetched record for frame "num", or NULL if the caller
+   has to read it itself. */
+static retap_prefetch_item_t *
+retap_prefetcher_get(retap_prefetcher_t *pf, uint32_t num)
+{
+    retap_prefetch_item_t *item;
+
+    while (!pf->finished) {
+        item = (retap_prefetch_item_t *)ws_bounded_queue_pop(pf->filled_q);
+        if (item->num == 0) {
+            pf->finished = true;
+            ws_bounded_queue_push(pf->empty_q, item);
+            break;
+        }
+        if (item->num == num) {
+            if (item->ok)
+                return item;
+            /* Re-read on the main thread's handle, which reports errors. */
+            retap_prefetcher_recycle(pf, item);
+            return NULL;
+        }
+        /* A frame the range skipped; drop it and keep looking. */
+        retap_prefetcher_recycle(pf, item);
+    }
+    return NULL;
+}
+
+static void
+retap_prefetcher_free(retap_prefetcher_t *pf)
+{
+    retap_prefetch_item_t *item;
+    unsigned i;
+
+    g_atomic_int_set(&pf->stop, 1);
+    /* Recycle items until the final one, so the thread can't be stuck
+       waiting for a free slot. */
+    while (!pf->finished) {
+        item = (retap_prefetch_item_t *)ws_bounded_queue_pop(pf->filled_q);
+        if (item->num == 0)
+            pf->finished = true;
+        retap_prefetcher_recycle(pf, item);
+    }
+    g_thread_join(pf->thread);
+    for (i = 0; i < RETAP_PREFETCH_DEPTH; i++) {
+        ws_buffer_free(&pf->items[i].buf);
+        wtap_rec_cleanup(&pf->items[i].rec);
+    }
+    ws_bounded_queue_free(pf->empty_q);
+    ws_bounded_queue_free(pf->filled_q);
+    wtap_close(pf->wth);
+    g_free(pf);
+}
+
 static psp_return_t
 process_specified_records(capture_file *cf, packet_range_t *range,
         const char *string1, const char *string2, bool terminate_is_stop,
         bool (*callback)(capture_file *, frame_data *,
             wtap_rec *, Buffer *, void *),
         void *callback_args,
-        bool show_progress_bar)
+        bool show_progress_bar, bool prefetch)
 {
     uint32_t         framenum;
     frame_data      *fdata;
     wtap_rec         rec;
     Buffer           buf;
     psp_return_t     ret     = PSP_FINISHED;
+    retap_prefetcher_t    *pf = NULL;
+    retap_prefetch_item_t *item;
 
     progdlg_t       *progbar = NULL;
     GTimer          *prog_timer = g_timer_new();
@@ -2245,6 +2757,12 @@ process_specified_records(capture_file *cf, packet_range_t *range,
     if (range != NULL)
         packet_range_process_init(range);
 
+    /* If asked to, read ahead of the processing loop on a second thread.
+       If the prefetcher can't start (no file name, open failure), we
+       just read everything here, as before. */
+    if (prefetch)
+        pf = retap_prefetcher_new(cf, cf->count);
+
     /* Iterate through all the packets, printing the packets that
        were selected by the current display filter.  */
     for (framenum = 1; framenum <= cf->count; framenum++) {
@@ -2303,7 +2821,21 @@ process_specified_records(capture_file *cf, packet_range_t *range,
             }
         }
 
-        /* Get the packet */
+        /* Get and process the packet.  If the prefetcher is running, the
+           record is usually already waiting for us. */
+        item = (pf != NULL) ? retap_prefetcher_get(pf, fdata->num) : NULL;
+        if (item != NULL) {
+            bool ok = callback(cf, fdata, &item->rec, &item->buf,
+                    callback_args);
+            retap_prefetcher_recycle(pf, item);
+            if (!ok) {
+                /* Callback failed.  We assume it reported the error
+                   appropriately. */
+                ret = PSP_FAILED;
+                break;
+            }
+            continue;
+        }
         if (!cf_read_record(cf, fdata, &rec, &buf)) {
             /* Attempt to get the packet failed. */
             ret = PSP_FAILED;
@@ -2318,6 +2850,9 @@ process_specified_records(capture_file *cf, packet_range_t *range,
         wtap_rec_reset(&rec);
     }
 
+    if (pf != NULL)
+        retap_prefetcher_free(pf);
+
     /* We're done printing the packets; destroy the progress bar if
        it was created. */
     if (progbar != NULL)
@@ -2451,7 +2986,7 @@ cf_retap_packets(capture_file *cf)
 
     ret = process_specified_records(cf, &range, "Recalculating statistics on",
             "all packets", true, retap_packet,
-            &callback_args, true);
+            &callback_args, true, true);
 
     packet_range_cleanup(&range);
     epan_dissect_cleanup(&callback_args.edt);
@@ -2790,7 +3325,7 @@ cf_print_packets(capture_file *cf, print_args_t *print_args,
        told to print. */
     ret = process_specified_records(cf, &print_args->range, "Printing",
             "selected packets", true, print_packet,
-            &callback_args, show_progress_bar);
+            &callback_args, show_progress_bar, false);
     epan_dissect_cleanup(&callback_args.edt);
     g_free(callback_args.header_line_buf);
     g_free(callback_args.line_buf);
@@ -2885,7 +3420,7 @@ cf_write_pdml_packets(capture_file *cf, print_args_t *print_args)
        told to print. */
     ret = process_specified_records(cf, &print_args->range, "Writing PDML",
             "selected packets", true,
-            write_pdml_packet, &callback_args, true);
+            write_pdml_packet, &callback_args, true, false);
 
     epan_dissect_cleanup(&callback_args.edt);
 
@@ -2969,7 +3504,7 @@ cf_write_psml_packets(capture_file *cf, print_args_t *print_args)
        told to print. */
     ret = process_specified_records(cf, &print_args->range, "Writing PSML",
             "selected packets", true,
-            write_psml_packet, &callback_args, true);
+            write_psml_packet, &callback_args, true, false);
 
     epan_dissect_cleanup(&callback_args.edt);
 
@@ -3051,7 +3586,7 @@ cf_write_csv_packets(capture_file *cf, print_args_t *print_args)
        told to print. */
     ret = process_specified_records(cf, &print_args->range, "Writing CSV",
             "selected packets", true,
-            write_csv_packet, &callback_args, true);
+            write_csv_packet, &callback_args, true, false);
 
     epan_dissect_cleanup(&callback_args.edt);
 
@@ -3118,7 +3653,7 @@ cf_write_carrays_packets(capture_file *cf, print_args_t *print_args)
     ret = process_specified_records(cf, &print_args->range,
             "Writing C Arrays",
             "selected packets", true,
-            carrays_write_packet, &callback_args, true);
+            carrays_write_packet, &callback_args, true, false);
 
     epan_dissect_cleanup(&callback_args.edt);
 
@@ -3186,7 +3721,7 @@ cf_write_json_packets(capture_file *cf, print_args_t *print_args)
        told to print. */
     ret = process_specified_records(cf, &print_args->range, "Writing JSON",
             "selected packets", true,
-            write_json_packet, &callback_args, true);
+            write_json_packet, &callback_args, true, false);
 
     epan_dissect_cleanup(&callback_args.edt);
 
@@ -4642,7 +5177,13 @@ find_packet(capture_file *cf, ws_match_function match_function,
          * likely trigger UI paint events, which might take a while depending on
          * the platform and display. Reset our timer *after* painting.
          */
-        if (g_timer_elapsed(prog_timer, NULL) > PROGBAR_UPDATE_INTERVAL) {
+        /*
+         * Reading the clock itself costs a call per frame, which adds up
+         * when skipping over millions of filtered-out frames, so only look
+         * at it every 256 frames.
+         */
+        if ((count & 0xff) == 0 &&
+            g_timer_elapsed(prog_timer, NULL) > PROGBAR_UPDATE_INTERVAL) {
             /* let's not divide by zero. I should never be started
              * with count == 0, so let's assert that
              */
@@ -4882,6 +5423,56 @@ cf_goto_framenum(capture_file *cf)
     return false;
 }
 
+/*
+ * Speculative dissection for selection.
+ *
+ * An analyst who clicks frame N almost always views frame N+1 next, so
+ * after building the tree for a selected frame we also dissect its
+ * successor into a spare edt; when the next click asks for exactly
+ * that frame, we hand over the cached tree instead of dissecting
+ * again.  The cache is a single frame and is thrown away whenever the
+ * dissection session it was built in goes away (close, redissection).
+ */
+static void
+cf_prefetch_invalidate(capture_file *cf)
+{
+    if (cf->prefetch_edt != NULL) {
+        epan_dissect_free(cf->prefetch_edt);
+        cf->prefetch_edt = NULL;
+    }
+    cf->prefetch_frame = NULL;
+}
+
+static void
+cf_prefetch_next(capture_file *cf, const frame_data *fdata)
+{
+    frame_data *next_fdata;
+
+    if (cf->provider.frames == NULL || fdata->num >= cf->count)
+        return;
+    next_fdata = frame_data_sequence_find(cf->provider.frames, fdata->num + 1);
+    if (next_fdata == NULL || !next_fdata->visited) {
+        /* Don't speculatively run what would be a first-pass dissection;
+           that has to happen in file order. */
+        return;
+    }
+
+    wtap_rec_reset(&cf->prefetch_rec);
+    if (!cf_read_record_no_alert(cf, next_fdata, &cf->prefetch_rec,
+                &cf->prefetch_buf)) {
+        /* It was only speculation; the real read will complain. */
+        return;
+    }
+
+    /* Same kind of dissection as the selection itself gets below. */
+    cf->prefetch_edt = epan_dissect_new(cf->epan, true, true);
+    tap_build_interesting(cf->prefetch_edt);
+    epan_dissect_run(cf->prefetch_edt, cf->cd_t, &cf->prefetch_rec,
+            frame_tvbuff_new_buffer(&cf->provider, next_fdata, &cf->prefetch_buf),
+            next_fdata, NULL);
+    cf->prefetch_frame = next_fdata;
+}
+
 /* Select the packet on a given row. */
 void
 cf_select_packet(capture_file *cf, frame_data *fdata)
@@ -4893,6 +5484,39 @@ cf_select_packet(capture_file *cf, frame_data *fdata)
         return;
     }
 
+    if (cf->prefetch_edt != NULL && cf->prefetch_frame == fdata) {
+        /* We dissected this frame speculatively when its predecessor
+           was selected.  The cached tree references the record data in
+           prefetch_rec/prefetch_buf, so swap those in wholesale. */
+        wtap_rec rec_tmp = cf->rec;
+        Buffer buf_tmp = cf->buf;
+
+        cf->rec = cf->prefetch_rec;
+        cf->buf = cf->prefetch_buf;
+        cf->prefetch_rec = rec_tmp;
+        cf->prefetch_buf = buf_tmp;
+
+        cf->current_frame = fdata;
+
+        old_edt = cf->edt;
+        cf->edt = cf->prefetch_edt;
+        cf->prefetch_edt = NULL;
+        cf->prefetch_frame = NULL;
+        if (old_edt != NULL)
+            epan_dissect_free(old_edt);
+
+        /* Keep a step ahead of the user. */
+        cf_prefetch_next(cf, fdata);
+        return;
+    }
+    cf_prefetch_invalidate(cf);
+
+    /* The user is browsing: chances are the next record read will be a
+     * neighbor of this one, so ask the OS to fetch the surrounding
+     * region of the file before we need it. */
+    wtap_prefetch(cf->provider.wth, fdata->file_off - PREFETCH_WINDOW / 2,
+                  PREFETCH_WINDOW + fdata->cap_len);
+
     /* Get the data in that frame. */
     if (!cf_read_record(cf, fdata, &cf->rec, &cf->buf)) {
         return;
@@ -4932,6 +5556,9 @@ cf_select_packet(capture_file *cf, frame_data *fdata)
 
     if (old_edt != NULL)
         epan_dissect_free(old_edt);
+
+    /* Dissect the frame the user will probably ask for next. */
+    cf_prefetch_next(cf, fdata);
 }
 
 /* Unselect the selected packet, if any. */
@@ -4940,6 +5567,8 @@ cf_unselect_packet(capture_file *cf)
 {
     epan_dissect_t *old_edt = cf->edt;
 
+    cf_prefetch_invalidate(cf);
+
     /*
      * See the comment in cf_select_packet() about deferring the freeing
      * of the old cf->edt.
@@ -5402,8 +6031,10 @@ rescan_file(capture_file *cf, const char *fname, bool is_tempfile)
     uint32_t             framenum;
     frame_data          *fdata;
 
-    /* Close the old handle. */
+    /* Close the old handle. The rewritten file need not number the frames
+     * the way the cached records were keyed. */
     wtap_close(cf->provider.wth);
+    records_cache_clear(cf);
 
     /* Open the new file. */
     /* XXX: this will go through all open_routines for a matching one. But right
@@ -5720,7 +6351,7 @@ cf_save_records(capture_file *cf, const char *fname, unsigned save_format,
         callback_args.fname = fname;
         callback_args.file_type = save_format;
         switch (process_specified_records(cf, NULL, "Saving", "packets",
-                    true, save_record, &callback_args, true)) {
+                    true, save_record, &callback_args, true, false)) {
 
             case PSP_FINISHED:
                 /* Completed successfully. */
@@ -5985,7 +6616,7 @@ cf_export_specified_packets(capture_file *cf, const char *fname,
     callback_args.fname = fname;
     callback_args.file_type = save_format;
     switch (process_specified_records(cf, range, "Writing", "specified records",
-                true, save_record, &callback_args, true)) {
+                true, save_record, &callback_args, true, false)) {
 
         case PSP_FINISHED:
             /* Completed successfully. */
@@ -419,6 +419,20 @@ unsigned long cf_get_computed_elapsed(capture_file *cf);
  */
 void cf_redissect_packets(capture_file *cf);
 
+/**
+ * Check whether a frame's dissection state belongs to the current
+ * dissection generation.  Each redissection bumps the capture file's
+ * generation counter, and every frame is restamped as it is re-dissected;
+ * background tasks (sorting, searching, exporting) can therefore keep
+ * partial results for frames that have already been re-dissected and
+ * recompute only the stale ones, instead of restarting from zero.
+ *
+ * @param cf the capture file
+ * @param fdata the frame to check
+ * @return true if the frame was dissected under the current generation
+ */
+bool cf_frame_dissection_current(capture_file *cf, const frame_data *fdata);
+
 /**
  * Rescan all packets and just run taps - don't reconstruct the display.
  *
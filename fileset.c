@@ -21,9 +21,6 @@
 
 #include <wsutil/file_util.h>
 #include <wsutil/filesystem.h>
-#include <wsutil/ws_assert.h>
-
-#include <wiretap/wtap.h>
 
 #include <epan/strutil.h>
 
@@ -59,144 +56,6 @@ static fileset set;
   #endif /* creation time on UN*X */
 #endif /* _WIN32 */
 
-/* is this a probable file of a file set (does the naming pattern match)? */
-fileset_match_t
-fileset_filename_match_pattern(const char *fname, char **prefix, char **suffix, char **time)
-{
-    char        *sfx;
-    char        *filename;
-    fileset_match_t ret = FILESET_NO_MATCH;
-    static char *pattern = "(?P<prefix>.*)_\\d{5}_(?P<time>\\d{14})$";
-    static char *pattern2 = "(?P<prefix>.*)_(?P<time>\\d{14})_\\d{5}$";
-    static GRegex *regex = NULL;
-    static GRegex *regex2 = NULL;
-
-    if (regex == NULL) {
-        GError *gerr = NULL;
-        regex = g_regex_new(pattern,
-                        (GRegexCompileFlags)(G_REGEX_OPTIMIZE | G_REGEX_ANCHORED),
-                        G_REGEX_MATCH_ANCHORED, &gerr);
-        if (gerr) {
-                ws_warning("failed to compile regex: %s", gerr->message);
-                g_error_free(gerr);
-                regex = NULL;
-                return ret;
-        }
-    }
-
-    if (regex2 == NULL) {
-        GError *gerr = NULL;
-        regex2 = g_regex_new(pattern2,
-                        (GRegexCompileFlags)(G_REGEX_OPTIMIZE | G_REGEX_ANCHORED),
-                        G_REGEX_MATCH_ANCHORED, &gerr);
-        if (gerr) {
-                ws_warning("failed to compile regex: %s", gerr->message);
-                g_error_free(gerr);
-                regex2 = NULL;
-                return ret;
-        }
-    }
-
-    /* d:\dir1\test_00001_20050418010750.cap */
-    filename = g_path_get_basename(fname);
-
-    /* test_00001_20050418010750.cap */
-    sfx = strrchr(filename, '.');
-    if (sfx != NULL) {
-        *sfx = '\0';
-        GSList *compression_type_extensions = wtap_get_all_compression_type_extensions_list();
-        char *ext = g_ascii_strdown(sfx + 1, -1);
-        for (GSList *compression_extension = compression_type_extensions;
-                compression_extension != NULL;
-                compression_extension = g_slist_next(compression_extension)) {
-            if (g_strcmp0(ext, (const char*)compression_extension->data) == 0) {
-                sfx = strrchr(filename, '.');
-                if (sfx != NULL) {
-                    *sfx = '\0';
-                }
-                break;
-            }
-        }
-        g_free(ext);
-        g_slist_free(compression_type_extensions);
-    } else { /* suffix is optional */
-        sfx = filename + strlen(filename);
-    }
-
-    /* test_00001_20050418010750 */
-
-    GMatchInfo *match_info;
-    g_regex_match(regex, filename, 0, &match_info);
-    if (g_match_info_matches(match_info)) {
-        if (prefix) {
-            *prefix = g_match_info_fetch_named(match_info, "prefix");
-        }
-        if (time) {
-            *time = g_match_info_fetch_named(match_info, "time");
-        }
-        if (suffix) {
-            *suffix = g_strdup(sfx);
-        }
-        ret = FILESET_NUM_TIME;
-    }
-    g_match_info_free(match_info);
-
-    if (ret == FILESET_NO_MATCH) {
-        g_regex_match(regex2, filename, 0, &match_info);
-        if (g_match_info_matches(match_info)) {
-            if (prefix) {
-                *prefix = g_match_info_fetch_named(match_info, "prefix");
-            }
-            if (time) {
-                *time = g_match_info_fetch_named(match_info, "time");
-            }
-            if (suffix) {
-                *suffix = g_strdup(sfx);
-            }
-            ret = FILESET_TIME_NUM;
-        }
-        g_match_info_free(match_info);
-    }
-
-    g_free(filename);
-
-    return ret;
-}
-
-
-/* test if both files could be in the same file set */
-/* (fname2 must already be in correct shape) */
-static bool
-fileset_is_file_in_set(const char *fname1, const char *fname2)
-{
-    char        *pfx1;
-    char        *pfx2;
-    char        *sfx1;
-    char        *sfx2;
-    fileset_match_t match1;
-    fileset_match_t match2;
-    bool        ret = false;
-
-    match1 = fileset_filename_match_pattern(fname1, &pfx1, &sfx1, NULL);
-    if (match1 == FILESET_NO_MATCH) {
-        return false;
-    }
-
-    match2 = fileset_filename_match_pattern(fname2, &pfx2, &sfx2, NULL);
-    /* just to be sure ... */
-    ws_assert(match2 != FILESET_NO_MATCH);
-    if (match1 == match2 && g_strcmp0(pfx1, pfx2) == 0 && g_strcmp0(sfx1, sfx2) == 0) {
-        ret = true;
-    }
-
-    g_free(pfx1);
-    g_free(pfx2);
-    g_free(sfx1);
-    g_free(sfx2);
-
-    return ret;
-}
-
 /* GCompareFunc helper for g_list_find_custom() */
 static int
 fileset_find_by_path(const void *a, const void *b)
@@ -430,6 +289,22 @@ fileset_get_previous(void)
 }
 
 
+/* get the newest file set entry (the last one in sort order), or NULL */
+fileset_entry *
+fileset_get_latest(void)
+{
+    GList         *le;
+
+
+    le = g_list_last(set.entries);
+    if(le == NULL) {
+        return NULL;
+    }
+
+    return (fileset_entry *)le->data;
+}
+
+
 /* delete a single entry */
 static void fileset_entry_delete(void *data, void *user_data _U_)
 {
@@ -15,6 +15,8 @@
 #include <inttypes.h>
 #include <time.h>
 
+#include "fileset_index.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -28,27 +30,6 @@ typedef struct _fileset_entry {
     bool     current;        /* is this the currently loaded file? */
 } fileset_entry;
 
-typedef enum {
-    FILESET_NO_MATCH,
-    FILESET_TIME_NUM,
-    FILESET_NUM_TIME
-} fileset_match_t;
-
-/* helper: is this a probable file of a file set (does the naming pattern match)?
- * Possible naming patterns are prefix_NNNNN_YYYYMMDDHHMMSS.ext[.gz] and
- * prefix_YYYYMMDDHHMMSS_NNNNN.ext[.gz], where any compression suffix
- * supported by libwiretap is allowed. The validation is minimal; e.g., the
- * time is only checked to see if all 14 characters are digits.
- *
- * @param[in] fname The filename to check for a naming pattern.
- * @param[out] prefix If not NULL and the filename matches, the prefix
- * @param[out] suffix If not NULL and the filename matches, the suffix
- * (file extension) not including the compression suffix
- * @param[out] time If not NULL and the filename matches, the time component
- * @return The type of pattern match, or FILESET_NO_MATCH.
- * */
-extern fileset_match_t fileset_filename_match_pattern(const char *fname, char **prefix, char **suffix, char **time);
-
 extern void fileset_add_dir(const char *fname, void *window);
 
 extern void fileset_delete(void);
@@ -59,6 +40,9 @@ extern const char *fileset_get_dirname(void);
 extern fileset_entry *fileset_get_next(void);
 extern fileset_entry *fileset_get_previous(void);
 
+/* get the newest entry of the set, or NULL */
+extern fileset_entry *fileset_get_latest(void);
+
 /**
  * Add an entry to our dialog / window. Called by fileset_update_dlg.
  * Must be implemented in the UI.
@@ -0,0 +1,654 @@
+/* fileset_index.c
+ * File set naming-pattern matching and the file set index, a per-set
+ * manifest recording each member file's time span, packet count and
+ * encapsulation, so that "which file contains time T" queries over
+ * large file sets are an index lookup rather than a scan that opens
+ * files until one matches.
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <config.h>
+
+#include <wireshark.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <wsutil/file_util.h>
+#include <wsutil/filesystem.h>
+#include <wsutil/ws_assert.h>
+#include <wsutil/wslog.h>
+
+#include <wiretap/wtap.h>
+#include <wiretap/pcapng.h>
+
+#include "fileset_index.h"
+
+/*
+ * The manifest is a plain text file named <prefix>.fileset in the set's
+ * directory, one member per line:
+ *
+ *     name <TAB> start <TAB> stop <TAB> packets <TAB> encap <TAB> size
+ *
+ * with the times as seconds.nanoseconds since the epoch, or "-" when the
+ * file had no timestamped records, and encap as the WTAP_ENCAP_ number.
+ * Comment lines start with '#'.  The manifest is only trusted when it is
+ * no older than every member file it describes.
+ */
+#define FILESET_INDEX_SUFFIX ".fileset"
+#define FILESET_INDEX_MAGIC  "# Wireshark file set index, version 1"
+
+/* is this a probable file of a file set (does the naming pattern match)? */
+fileset_match_t
+fileset_filename_match_pattern(const char *fname, char **prefix, char **suffix, char **time)
+{
+    char        *sfx;
+    char        *filename;
+    fileset_match_t ret = FILESET_NO_MATCH;
+    static char *pattern = "(?P<prefix>.*)_\\d{5}_(?P<time>\\d{14})$";
+    static char *pattern2 = "(?P<prefix>.*)_(?P<time>\\d{14})_\\d{5}$";
+    static GRegex *regex = NULL;
+    static GRegex *regex2 = NULL;
+
+    if (regex == NULL) {
+        GError *gerr = NULL;
+        regex = g_regex_new(pattern,
+                        (GRegexCompileFlags)(G_REGEX_OPTIMIZE | G_REGEX_ANCHORED),
+                        G_REGEX_MATCH_ANCHORED, &gerr);
+        if (gerr) {
+                ws_warning("failed to compile regex: %s", gerr->message);
+                g_error_free(gerr);
+                regex = NULL;
+                return ret;
+        }
+    }
+
+    if (regex2 == NULL) {
+        GError *gerr = NULL;
+        regex2 = g_regex_new(pattern2,
+                        (GRegexCompileFlags)(G_REGEX_OPTIMIZE | G_REGEX_ANCHORED),
+                        G_REGEX_MATCH_ANCHORED, &gerr);
+        if (gerr) {
+                ws_warning("failed to compile regex: %s", gerr->message);
+                g_error_free(gerr);
+                regex2 = NULL;
+                return ret;
+        }
+    }
+
+    /* d:\dir1\test_00001_20050418010750.cap */
+    filename = g_path_get_basename(fname);
+
+    /* test_00001_20050418010750.cap */
+    sfx = strrchr(filename, '.');
+    if (sfx != NULL) {
+        *sfx = '\0';
+        GSList *compression_type_extensions = wtap_get_all_compression_type_extensions_list();
+        char *ext = g_ascii_strdown(sfx + 1, -1);
+        for (GSList *compression_extension = compression_type_extensions;
+                compression_extension != NULL;
+                compression_extension = g_slist_next(compression_extension)) {
+            if (g_strcmp0(ext, (const char*)compression_extension->data) == 0) {
+                sfx = strrchr(filename, '.');
+                if (sfx != NULL) {
+                    *sfx = '\0';
+                }
+                break;
+            }
+        }
+        g_free(ext);
+        g_slist_free(compression_type_extensions);
+    } else { /* suffix is optional */
+        sfx = filename + strlen(filename);
+    }
+
+    /* test_00001_20050418010750 */
+
+    GMatchInfo *match_info;
+    g_regex_match(regex, filename, 0, &match_info);
+    if (g_match_info_matches(match_info)) {
+        if (prefix) {
+            *prefix = g_match_info_fetch_named(match_info, "prefix");
+        }
+        if (time) {
+            *time = g_match_info_fetch_named(match_info, "time");
+        }
+        if (suffix) {
+            *suffix = g_strdup(sfx);
+        }
+        ret = FILESET_NUM_TIME;
+    }
+    g_match_info_free(match_info);
+
+    if (ret == FILESET_NO_MATCH) {
+        g_regex_match(regex2, filename, 0, &match_info);
+        if (g_match_info_matches(match_info)) {
+            if (prefix) {
+                *prefix = g_match_info_fetch_named(match_info, "prefix");
+            }
+            if (time) {
+                *time = g_match_info_fetch_named(match_info, "time");
+            }
+            if (suffix) {
+                *suffix = g_strdup(sfx);
+            }
+            ret = FILESET_TIME_NUM;
+        }
+        g_match_info_free(match_info);
+    }
+
+    g_free(filename);
+
+    return ret;
+}
+
+
+/* test if both files could be in the same file set */
+/* (fname2 must already be in correct shape) */
+bool
+fileset_is_file_in_set(const char *fname1, const char *fname2)
+{
+    char        *pfx1;
+    char        *pfx2;
+    char        *sfx1;
+    char        *sfx2;
+    fileset_match_t match1;
+    fileset_match_t match2;
+    bool        ret = false;
+
+    match1 = fileset_filename_match_pattern(fname1, &pfx1, &sfx1, NULL);
+    if (match1 == FILESET_NO_MATCH) {
+        return false;
+    }
+
+    match2 = fileset_filename_match_pattern(fname2, &pfx2, &sfx2, NULL);
+    /* just to be sure ... */
+    ws_assert(match2 != FILESET_NO_MATCH);
+    if (match1 == match2 && g_strcmp0(pfx1, pfx2) == 0 && g_strcmp0(sfx1, sfx2) == 0) {
+        ret = true;
+    }
+
+    g_free(pfx1);
+    g_free(pfx2);
+    g_free(sfx1);
+    g_free(sfx2);
+
+    return ret;
+}
+
+
+static void
+fileset_index_entry_free(void *data)
+{
+    fileset_index_entry *entry = (fileset_index_entry *)data;
+
+    g_free(entry->name);
+    g_free(entry);
+}
+
+
+/* compare two index entries by start time, unset times last */
+static int
+fileset_index_entry_compare(const void *a, const void *b)
+{
+    const fileset_index_entry *entry_a = *(const fileset_index_entry *const *)a;
+    const fileset_index_entry *entry_b = *(const fileset_index_entry *const *)b;
+
+    if (nstime_is_unset(&entry_a->start_time)) {
+        return nstime_is_unset(&entry_b->start_time) ?
+            strcmp(entry_a->name, entry_b->name) : 1;
+    }
+    if (nstime_is_unset(&entry_b->start_time)) {
+        return -1;
+    }
+    return nstime_cmp(&entry_a->start_time, &entry_b->start_time);
+}
+
+
+static void
+fileset_index_print_time(FILE *fh, const nstime_t *when)
+{
+    if (nstime_is_unset(when)) {
+        fputs("-", fh);
+    } else {
+        fprintf(fh, "%" PRId64 ".%09d", (int64_t)when->secs, when->nsecs);
+    }
+}
+
+
+static bool
+fileset_index_parse_time(const char *str, nstime_t *when)
+{
+    char *end;
+    int64_t secs;
+    long nsecs = 0;
+
+    if (strcmp(str, "-") == 0) {
+        nstime_set_unset(when);
+        return true;
+    }
+    secs = g_ascii_strtoll(str, &end, 10);
+    if (end == str) {
+        return false;
+    }
+    if (*end == '.') {
+        nsecs = strtol(end + 1, &end, 10);
+    }
+    if (*end != '\0' || nsecs < 0 || nsecs >= 1000000000) {
+        return false;
+    }
+    when->secs = (time_t)secs;
+    when->nsecs = (int)nsecs;
+    return true;
+}
+
+
+/* Read every record's metadata from one member file and fill in an
+ * index entry for it, or return NULL if the file can't be read. */
+static fileset_index_entry *
+fileset_index_scan_file(const char *dirname, const char *fname)
+{
+    fileset_index_entry *entry;
+    char       *path;
+    wtap       *wth;
+    wtap_rec    rec;
+    Buffer      buf;
+    int64_t     data_offset;
+    ws_statb64  statb;
+    int         err = 0;
+    char       *err_info = NULL;
+
+    path = ws_strdup_printf("%s%s", dirname, fname);
+    wth = wtap_open_offline(path, WTAP_TYPE_AUTO, &err, &err_info, true);
+    if (wth == NULL) {
+        ws_message("file set index: can't open \"%s\": %s", path,
+                   wtap_strerror(err));
+        g_free(err_info);
+        g_free(path);
+        return NULL;
+    }
+
+    /* We only look at the record metadata */
+    wtap_set_read_metadata_only(wth, true);
+
+    entry = g_new0(fileset_index_entry, 1);
+    entry->name = g_strdup(fname);
+    nstime_set_unset(&entry->start_time);
+    nstime_set_unset(&entry->stop_time);
+
+    /* If the file ends in the per-interface statistics blocks dumpcap
+     * writes when it closes a file, they already give us the packet
+     * count and time bounds, so we can skip the record scan. */
+    {
+        GArray  *tail_stats;
+        bool     complete = false;
+        uint64_t total_delivered = 0;
+        unsigned i;
+
+        tail_stats = g_array_new(false, true, sizeof(pcapng_if_stats_t));
+        if (pcapng_read_trailing_statistics(wth, tail_stats, &err, &err_info) &&
+            tail_stats->len > 0) {
+            complete = true;
+            for (i = 0; i < tail_stats->len; i++) {
+                const pcapng_if_stats_t *st =
+                    &g_array_index(tail_stats, pcapng_if_stats_t, i);
+
+                if (st->packets_delivered == UINT64_MAX ||
+                    !st->has_start_time || !st->has_end_time) {
+                    complete = false;
+                    break;
+                }
+                total_delivered += st->packets_delivered;
+                if (nstime_is_unset(&entry->start_time) ||
+                    nstime_cmp(&st->start_time, &entry->start_time) < 0) {
+                    entry->start_time = st->start_time;
+                }
+                if (nstime_is_unset(&entry->stop_time) ||
+                    nstime_cmp(&st->end_time, &entry->stop_time) > 0) {
+                    entry->stop_time = st->end_time;
+                }
+            }
+        } else {
+            g_free(err_info);
+            err_info = NULL;
+        }
+        err = 0;
+        g_array_free(tail_stats, true);
+        if (complete) {
+            entry->packet_count = total_delivered;
+            entry->encap = wtap_file_encap(wth);
+            if (ws_stat64(path, &statb) == 0) {
+                entry->size = statb.st_size;
+            }
+            wtap_close(wth);
+            g_free(path);
+            return entry;
+        }
+        /* The statistics were missing or incomplete; rescan from scratch. */
+        nstime_set_unset(&entry->start_time);
+        nstime_set_unset(&entry->stop_time);
+    }
+
+    wtap_rec_init(&rec);
+    ws_buffer_init(&buf, 1514);
+    while (wtap_read(wth, &rec, &buf, &err, &err_info, &data_offset)) {
+        if (rec.presence_flags & WTAP_HAS_TS) {
+            if (nstime_is_unset(&entry->start_time)) {
+                entry->start_time = rec.ts;
+            }
+            entry->stop_time = rec.ts;
+        }
+        entry->packet_count++;
+        wtap_rec_reset(&rec);
+    }
+    wtap_rec_cleanup(&rec);
+    ws_buffer_free(&buf);
+    if (err != 0) {
+        /* Index what we could read of a damaged or growing file */
+        ws_message("file set index: error reading \"%s\": %s", path,
+                   wtap_strerror(err));
+        g_free(err_info);
+    }
+
+    entry->encap = wtap_file_encap(wth);
+    if (ws_stat64(path, &statb) == 0) {
+        entry->size = statb.st_size;
+    }
+
+    wtap_close(wth);
+    g_free(path);
+
+    return entry;
+}
+
+
+static bool
+fileset_index_save(const fileset_index *idx, const char *index_path)
+{
+    FILE *fh;
+    unsigned i;
+
+    fh = ws_fopen(index_path, "w");
+    if (fh == NULL) {
+        return false;
+    }
+
+    fputs(FILESET_INDEX_MAGIC "\n", fh);
+    fputs("# name\tstart\tstop\tpackets\tencap\tsize\n", fh);
+    for (i = 0; i < idx->entries->len; i++) {
+        const fileset_index_entry *entry =
+            (const fileset_index_entry *)g_ptr_array_index(idx->entries, i);
+
+        fprintf(fh, "%s\t", entry->name);
+        fileset_index_print_time(fh, &entry->start_time);
+        fputs("\t", fh);
+        fileset_index_print_time(fh, &entry->stop_time);
+        fprintf(fh, "\t%" PRIu64 "\t%d\t%" PRId64 "\n",
+                entry->packet_count, entry->encap, entry->size);
+    }
+
+    if (fclose(fh) == EOF) {
+        ws_unlink(index_path);
+        return false;
+    }
+    return true;
+}
+
+
+/* Load the manifest, but only accept it if it describes exactly the
+ * member files we were given; otherwise the set has changed shape and
+ * the caller must rescan. */
+static fileset_index *
+fileset_index_load(const char *index_path, const char *dirname,
+                   GPtrArray *members)
+{
+    fileset_index *idx;
+    FILE  *fh;
+    char   line[2048];
+    bool   ok = true;
+    unsigned i;
+
+    fh = ws_fopen(index_path, "r");
+    if (fh == NULL) {
+        return NULL;
+    }
+    if (fgets(line, sizeof(line), fh) == NULL ||
+        strncmp(line, FILESET_INDEX_MAGIC, strlen(FILESET_INDEX_MAGIC)) != 0) {
+        fclose(fh);
+        return NULL;
+    }
+
+    idx = g_new0(fileset_index, 1);
+    idx->dirname = g_strdup(dirname);
+    idx->entries = g_ptr_array_new_with_free_func(fileset_index_entry_free);
+
+    while (ok && fgets(line, sizeof(line), fh) != NULL) {
+        char **fields;
+        fileset_index_entry *entry;
+
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        g_strchomp(line);
+        fields = g_strsplit(line, "\t", -1);
+        if (g_strv_length(fields) != 6) {
+            g_strfreev(fields);
+            ok = false;
+            break;
+        }
+
+        entry = g_new0(fileset_index_entry, 1);
+        entry->name = g_strdup(fields[0]);
+        ok = fileset_index_parse_time(fields[1], &entry->start_time) &&
+             fileset_index_parse_time(fields[2], &entry->stop_time);
+        entry->packet_count = g_ascii_strtoull(fields[3], NULL, 10);
+        entry->encap = (int)strtol(fields[4], NULL, 10);
+        entry->size = g_ascii_strtoll(fields[5], NULL, 10);
+        g_strfreev(fields);
+
+        g_ptr_array_add(idx->entries, entry);
+    }
+    fclose(fh);
+
+    /* The manifest must cover the current members, no more and no less */
+    ok = ok && idx->entries->len == members->len;
+    for (i = 0; ok && i < members->len; i++) {
+        const char *name = (const char *)g_ptr_array_index(members, i);
+        unsigned j;
+
+        for (j = 0; j < idx->entries->len; j++) {
+            const fileset_index_entry *entry =
+                (const fileset_index_entry *)g_ptr_array_index(idx->entries, j);
+            if (strcmp(entry->name, name) == 0) {
+                break;
+            }
+        }
+        ok = j < idx->entries->len;
+    }
+
+    if (!ok) {
+        fileset_index_free(idx);
+        return NULL;
+    }
+    return idx;
+}
+
+
+/* is the manifest at least as new as every member file? */
+static bool
+fileset_index_is_fresh(const char *index_path, const char *dirname,
+                       GPtrArray *members)
+{
+    ws_statb64 index_statb;
+    unsigned i;
+
+    if (ws_stat64(index_path, &index_statb) != 0) {
+        return false;
+    }
+
+    for (i = 0; i < members->len; i++) {
+        char *path = ws_strdup_printf("%s%s", dirname,
+            (const char *)g_ptr_array_index(members, i));
+        ws_statb64 statb;
+        bool newer = ws_stat64(path, &statb) != 0 ||
+                     statb.st_mtime > index_statb.st_mtime;
+
+        g_free(path);
+        if (newer) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+fileset_index *
+fileset_index_build(const char *fname, bool use_cached)
+{
+    fileset_index *idx;
+    GPtrArray  *members;
+    GString    *dirname;
+    char       *fname_dup;
+    char       *basename;
+    char       *prefix = NULL;
+    char       *index_path = NULL;
+    unsigned    i;
+
+    /* get (convert) directory name, but don't touch the given string */
+    fname_dup = g_strdup(fname);
+    dirname = g_string_new(get_dirname(fname_dup));
+    g_free(fname_dup);
+    dirname = g_string_append_c(dirname, G_DIR_SEPARATOR);
+
+    basename = g_path_get_basename(fname);
+    members = g_ptr_array_new_with_free_func(g_free);
+
+    if (fileset_filename_match_pattern(fname, &prefix, NULL, NULL) != FILESET_NO_MATCH) {
+        WS_DIR    *dir;
+        WS_DIRENT *file;
+
+        if ((dir = ws_dir_open(dirname->str, 0, NULL)) != NULL) {
+            while ((file = ws_dir_read_name(dir)) != NULL) {
+                const char *name = ws_dir_get_name(file);
+                if (fileset_is_file_in_set(name, basename)) {
+                    g_ptr_array_add(members, g_strdup(name));
+                }
+            }
+            ws_dir_close(dir);
+        }
+        index_path = ws_strdup_printf("%s%s" FILESET_INDEX_SUFFIX,
+                                      dirname->str, prefix);
+    } else {
+        /* a "standalone file"; index just this one, with no manifest */
+        g_ptr_array_add(members, g_strdup(basename));
+    }
+
+    if (use_cached && index_path != NULL &&
+        fileset_index_is_fresh(index_path, dirname->str, members)) {
+        idx = fileset_index_load(index_path, dirname->str, members);
+        if (idx != NULL) {
+            goto done;
+        }
+    }
+
+    idx = g_new0(fileset_index, 1);
+    idx->dirname = g_strdup(dirname->str);
+    idx->entries = g_ptr_array_new_with_free_func(fileset_index_entry_free);
+
+    for (i = 0; i < members->len; i++) {
+        fileset_index_entry *entry = fileset_index_scan_file(dirname->str,
+            (const char *)g_ptr_array_index(members, i));
+        if (entry != NULL) {
+            g_ptr_array_add(idx->entries, entry);
+        }
+    }
+
+    if (idx->entries->len == 0) {
+        fileset_index_free(idx);
+        idx = NULL;
+        goto done;
+    }
+
+    g_ptr_array_sort(idx->entries, fileset_index_entry_compare);
+
+    /* Leave a manifest behind for the next caller; not being able to
+     * (e.g. a read-only archive) is no reason to fail. */
+    if (index_path != NULL) {
+        fileset_index_save(idx, index_path);
+    }
+
+done:
+    g_ptr_array_free(members, TRUE);
+    g_string_free(dirname, TRUE);
+    g_free(basename);
+    g_free(prefix);
+    g_free(index_path);
+    return idx;
+}
+
+
+const fileset_index_entry *
+fileset_index_find_time(const fileset_index *idx, const nstime_t *when)
+{
+    unsigned lo = 0, hi = idx->entries->len;
+
+    /* find the first entry starting after the given time ... */
+    while (lo < hi) {
+        unsigned mid = lo + (hi - lo) / 2;
+        const fileset_index_entry *entry =
+            (const fileset_index_entry *)g_ptr_array_index(idx->entries, mid);
+
+        if (!nstime_is_unset(&entry->start_time) &&
+            nstime_cmp(&entry->start_time, when) <= 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    /* ... then walk back over the ones starting at or before it; spans
+     * can overlap when files were captured in parallel */
+    while (lo > 0) {
+        const fileset_index_entry *entry =
+            (const fileset_index_entry *)g_ptr_array_index(idx->entries, --lo);
+
+        if (nstime_is_unset(&entry->start_time)) {
+            break;
+        }
+        if (nstime_cmp(&entry->stop_time, when) >= 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+
+void
+fileset_index_free(fileset_index *idx)
+{
+    if (idx == NULL) {
+        return;
+    }
+    g_ptr_array_free(idx->entries, TRUE);
+    g_free(idx->dirname);
+    g_free(idx);
+}
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 4
+ * tab-width: 8
+ * indent-tabs-mode: nil
+ * End:
+ *
+ * vi: set shiftwidth=4 tabstop=8 expandtab:
+ * :indentSize=4:tabSize=8:noTabs=true:
+ */
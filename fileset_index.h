@@ -0,0 +1,108 @@
+/** @file
+ *
+ * Definitions for the file set index: naming-pattern matching and a
+ * per-set manifest recording each member file's time span, packet
+ * count and encapsulation.
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __FILESET_INDEX_H__
+#define __FILESET_INDEX_H__
+
+#include <inttypes.h>
+
+#include <glib.h>
+
+#include <wsutil/nstime.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+typedef enum {
+    FILESET_NO_MATCH,
+    FILESET_TIME_NUM,
+    FILESET_NUM_TIME
+} fileset_match_t;
+
+/* helper: is this a probable file of a file set (does the naming pattern match)?
+ * Possible naming patterns are prefix_NNNNN_YYYYMMDDHHMMSS.ext[.gz] and
+ * prefix_YYYYMMDDHHMMSS_NNNNN.ext[.gz], where any compression suffix
+ * supported by libwiretap is allowed. The validation is minimal; e.g., the
+ * time is only checked to see if all 14 characters are digits.
+ *
+ * @param[in] fname The filename to check for a naming pattern.
+ * @param[out] prefix If not NULL and the filename matches, the prefix
+ * @param[out] suffix If not NULL and the filename matches, the suffix
+ * (file extension) not including the compression suffix
+ * @param[out] time If not NULL and the filename matches, the time component
+ * @return The type of pattern match, or FILESET_NO_MATCH.
+ * */
+extern fileset_match_t fileset_filename_match_pattern(const char *fname, char **prefix, char **suffix, char **time);
+
+/* test if both files could be in the same file set */
+/* (fname2 must already be in correct shape) */
+extern bool fileset_is_file_in_set(const char *fname1, const char *fname2);
+
+/*
+ * One member file in a file set index.  The times are the timestamps of
+ * the first and last record in the file, which need not be its minimum
+ * and maximum if the file isn't in time order.
+ */
+typedef struct _fileset_index_entry {
+    char     *name;          /* file name without path */
+    nstime_t  start_time;    /* time of the first record */
+    nstime_t  stop_time;     /* time of the last record */
+    uint64_t  packet_count;
+    int       encap;         /* WTAP_ENCAP_..., possibly PER_PACKET */
+    int64_t   size;          /* size of file in bytes */
+} fileset_index_entry;
+
+typedef struct _fileset_index {
+    char      *dirname;      /* directory of the set, with trailing separator */
+    GPtrArray *entries;      /* fileset_index_entry *, sorted by start time */
+} fileset_index;
+
+/** Build the index for the file set that fname belongs to.
+ *
+ * If use_cached is true and a manifest file exists beside the set that is
+ * no older than any member file, the index is loaded from it; otherwise
+ * every member is scanned (a metadata-only read) and, when possible, a
+ * manifest is written for the next caller.  A file whose name doesn't
+ * match the file set pattern yields an index with that file as its only
+ * entry, and no manifest.
+ *
+ * @param fname Path of any member of the file set.
+ * @param use_cached Whether a fresh manifest may be used instead of scanning.
+ * @return The index, or NULL if no member file could be read.
+ */
+extern fileset_index *fileset_index_build(const char *fname, bool use_cached);
+
+/** Find the entry whose time span contains the given time, or NULL. */
+extern const fileset_index_entry *fileset_index_find_time(const fileset_index *idx, const nstime_t *when);
+
+extern void fileset_index_free(fileset_index *idx);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __FILESET_INDEX_H__ */
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 4
+ * tab-width: 8
+ * indent-tabs-mode: nil
+ * End:
+ *
+ * vi: set shiftwidth=4 tabstop=8 expandtab:
+ * :indentSize=4:tabSize=8:noTabs=true:
+ */
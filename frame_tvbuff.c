@@ -66,13 +66,16 @@ frame_cache(struct tvb_frame *frame_tvb)
         if (G_UNLIKELY(!buffer_cache)) buffer_cache = g_ptr_array_sized_new(1024);
 
         if (buffer_cache->len > 0) {
+            /* Recycled buffers keep their backing allocation, so frames
+             * bigger than the small-buffer pool in wsutil/buffer.c don't
+             * cost a malloc/free cycle each time they're re-read. */
             frame_tvb->buf = (struct Buffer *) g_ptr_array_remove_index(buffer_cache, buffer_cache->len - 1);
+            ws_buffer_assure_space(frame_tvb->buf, frame_tvb->tvb.length + frame_tvb->offset);
         } else {
             frame_tvb->buf = g_new(struct Buffer, 1);
+            ws_buffer_init(frame_tvb->buf, frame_tvb->tvb.length + frame_tvb->offset);
         }
 
-        ws_buffer_init(frame_tvb->buf, frame_tvb->tvb.length + frame_tvb->offset);
-
         if (!frame_read(frame_tvb, &rec, frame_tvb->buf))
         { /* TODO: THROW(???); */ }
     }
@@ -88,7 +91,9 @@ frame_free(tvbuff_t *tvb)
     struct tvb_frame *frame_tvb = (struct tvb_frame *) tvb;
 
     if (frame_tvb->buf) {
-        ws_buffer_free(frame_tvb->buf);
+        /* Keep the allocation with the Buffer; frame_cache() reuses it
+         * for the next lazily-read frame. */
+        ws_buffer_clean(frame_tvb->buf);
         g_ptr_array_add(buffer_cache, frame_tvb->buf);
     }
 }
@@ -15,6 +15,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
 #include <maxminddb.h>
 
 #define MAX_ADDR_LEN 46
@@ -58,6 +62,19 @@ static void exit_err(void) {
     exit(1);
 }
 
+// Is another request already waiting on stdin? If so we can skip the
+// per-address flush and emit one batch of responses in a single write.
+// Only meaningful where stdin is unbuffered, so that poll() sees exactly
+// what we haven't consumed; on Windows we keep flushing per address.
+static int more_input_pending(void) {
+#ifndef _WIN32
+    struct pollfd pfd = { 0, POLLIN, 0 };
+    return poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN);
+#else
+    return 0;
+#endif
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -72,6 +89,9 @@ main(int argc, char *argv[])
         return 1;
     }
     setvbuf(stdout, out_buf, _IOFBF, OUT_BUF_SIZE);
+#ifndef _WIN32
+    setvbuf(stdin, NULL, _IONBF, 0);
+#endif
 
     fprintf(stdout, "[init]\n");
 
@@ -181,7 +201,9 @@ main(int argc, char *argv[])
             }
         }
         fprintf(stdout, "# End %s\n", addr_str);
-        fflush(stdout);
+        if (!more_input_pending()) {
+            fflush(stdout);
+        }
     }
 
     free(mmdbs);
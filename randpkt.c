@@ -100,7 +100,10 @@ usage(bool is_error)
     fprintf(output, "  -c                packet count (default: 1000)\n");
     fprintf(output, "  -F                output file type (default: pcapng)\n");
     fprintf(output, "                    an empty \"-F\" option will list the file types\n");
-    fprintf(output, "  -r                select a different random type for each packet\n");
+    fprintf(output, "  -p                number of packet generator threads (default: 1)\n");
+    fprintf(output, "  -r                select a different random type for each packet;\n");
+    fprintf(output, "                    with -t, a comma-separated \"type:weight\" list gives\n");
+    fprintf(output, "                    a weighted mix of types\n");
     fprintf(output, "  -t                packet type\n");
     fprintf(output, "  -h, --help        display this help and exit.\n");
     fprintf(output, "  -v, --version     print version information and exit.\n");
@@ -141,6 +144,7 @@ main(int argc, char *argv[])
     char *produce_filename = NULL;
     int produce_max_bytes = 5000;
     int produce_count = 1000;
+    int produce_threads = 1;
     int file_type_subtype = WTAP_FILE_TYPE_SUBTYPE_UNKNOWN;
     randpkt_example *example;
     uint8_t* type = NULL;
@@ -190,7 +194,7 @@ main(int argc, char *argv[])
 
     ws_init_version_info("Randpkt", NULL, NULL);
 
-    while ((opt = ws_getopt_long(argc, argv, "b:c:F:ht:rv", long_options, NULL)) != -1) {
+    while ((opt = ws_getopt_long(argc, argv, "b:c:F:hp:t:rv", long_options, NULL)) != -1) {
         switch (opt) {
             case 'b':	/* max bytes */
                 produce_max_bytes = get_positive_int(ws_optarg, "max bytes");
@@ -214,6 +218,10 @@ main(int argc, char *argv[])
                 }
                 break;
 
+            case 'p':	/* generator threads */
+                produce_threads = get_positive_int(ws_optarg, "thread count");
+                break;
+
             case 't':	/* type of packet to produce */
                 type = g_strdup(ws_optarg);
                 break;
@@ -275,15 +283,21 @@ main(int argc, char *argv[])
         ret = randpkt_example_init(example, produce_filename, produce_max_bytes, file_type_subtype);
         if (ret != EXIT_SUCCESS)
             goto clean_exit;
-        randpkt_loop(example, produce_count, 0);
+        if (produce_threads > 1)
+            randpkt_loop_threaded(example, produce_count, produce_threads);
+        else
+            randpkt_loop(example, produce_count, 0);
     } else {
         if (type) {
-            fprintf(stderr, "Can't set type in random mode\n");
-            ret = INVALID_TYPE;
-            goto clean_exit;
+            /* In random mode, -t gives a weighted mix of types */
+            if (!randpkt_parse_mix(type)) {
+                ret = INVALID_TYPE;
+                goto clean_exit;
+            }
+            g_free(type);
         }
 
-        produce_type = randpkt_parse_type(NULL);
+        produce_type = randpkt_pick_mix_type();
         example = randpkt_find_example(produce_type);
         if (!example) {
             ret = WS_EXIT_INVALID_OPTION;
@@ -295,7 +309,7 @@ main(int argc, char *argv[])
 
         while (produce_count-- > 0) {
             randpkt_loop(example, 1, 0);
-            produce_type = randpkt_parse_type(NULL);
+            produce_type = randpkt_pick_mix_type();
 
             savedump = example->dump;
 
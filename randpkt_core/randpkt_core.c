@@ -555,12 +555,56 @@ randpkt_example* randpkt_find_example(int type)
 	return NULL;
 }
 
-void randpkt_loop(randpkt_example* example, uint64_t produce_count, uint64_t packet_delay_ms)
+/* Generate one random packet into buffer and ps_header, using the given
+ * PRNG, and return its capture length.  The sample bytes must already be
+ * at the start of buffer; this fills in everything after them.  Shared
+ * by the serial and threaded generation loops.
+ */
+static unsigned
+randpkt_produce(randpkt_example* example, GRand* rnd, uint8_t* buffer,
+    union wtap_pseudo_header* ps_header)
 {
-	unsigned i, j;
-	int err;
+	unsigned j;
 	unsigned len_random;
 	unsigned len_this_pkt;
+
+	if (example->produce_max_bytes > 0) {
+		len_random = g_rand_int_range(rnd, 0, example->produce_max_bytes + 1);
+	}
+	else {
+		len_random = 0;
+	}
+
+	len_this_pkt = example->sample_length + len_random;
+	if (len_this_pkt > WTAP_MAX_PACKET_SIZE_STANDARD) {
+		/*
+		 * Wiretap will fail when trying to read packets
+		 * bigger than WTAP_MAX_PACKET_SIZE_STANDARD.
+		 */
+		len_this_pkt = WTAP_MAX_PACKET_SIZE_STANDARD;
+	}
+
+	for (j = example->pseudo_length; j < (int) sizeof(*ps_header); j++) {
+		((uint8_t*)ps_header)[j] = g_rand_int_range(rnd, 0, 0x100);
+	}
+
+	for (j = example->sample_length; j < len_this_pkt; j++) {
+		/* Add format strings here and there */
+		if ((int) (100.0*g_rand_double(rnd)) < 3 && j < (len_random - 3)) {
+			memcpy(&buffer[j], "%s", 3);
+			j += 2;
+		} else {
+			buffer[j] = g_rand_int_range(rnd, 0, 0x100);
+		}
+	}
+
+	return len_this_pkt;
+}
+
+void randpkt_loop(randpkt_example* example, uint64_t produce_count, uint64_t packet_delay_ms)
+{
+	unsigned i;
+	int err;
 	char* err_info;
 	union wtap_pseudo_header* ps_header;
 	uint8_t* buffer;
@@ -585,40 +629,13 @@ void randpkt_loop(randpkt_example* example, uint64_t produce_count, uint64_t pac
 
 	/* Produce random packets */
 	for (i = 0; i < produce_count; i++) {
-		if (example->produce_max_bytes > 0) {
-			len_random = g_rand_int_range(pkt_rand, 0, example->produce_max_bytes + 1);
-		}
-		else {
-			len_random = 0;
-		}
-
-		len_this_pkt = example->sample_length + len_random;
-		if (len_this_pkt > WTAP_MAX_PACKET_SIZE_STANDARD) {
-			/*
-			 * Wiretap will fail when trying to read packets
-			 * bigger than WTAP_MAX_PACKET_SIZE_STANDARD.
-			 */
-			len_this_pkt = WTAP_MAX_PACKET_SIZE_STANDARD;
-		}
+		unsigned len_this_pkt = randpkt_produce(example, pkt_rand,
+		    buffer, ps_header);
 
 		rec->rec_header.packet_header.caplen = len_this_pkt;
 		rec->rec_header.packet_header.len = len_this_pkt;
 		rec->ts.secs = i; /* just for variety */
 
-		for (j = example->pseudo_length; j < (int) sizeof(*ps_header); j++) {
-			((uint8_t*)ps_header)[j] = g_rand_int_range(pkt_rand, 0, 0x100);
-		}
-
-		for (j = example->sample_length; j < len_this_pkt; j++) {
-			/* Add format strings here and there */
-			if ((int) (100.0*g_rand_double(pkt_rand)) < 3 && j < (len_random - 3)) {
-				memcpy(&buffer[j], "%s", 3);
-				j += 2;
-			} else {
-				buffer[j] = g_rand_int_range(pkt_rand, 0, 0x100);
-			}
-		}
-
 		if (!wtap_dump(example->dump, rec, buffer, &err, &err_info)) {
 			cfile_write_failure_message(NULL,
 			    example->filename, err, err_info, 0,
@@ -638,6 +655,145 @@ void randpkt_loop(randpkt_example* example, uint64_t produce_count, uint64_t pac
 	g_free(buffer);
 }
 
+/* Number of packets each worker thread generates per round; this bounds
+ * the memory used for staged packets to
+ * n_threads * RANDPKT_CHUNK_PACKETS * max packet length.
+ */
+#define RANDPKT_CHUNK_PACKETS 256
+
+typedef struct {
+	randpkt_example* example;
+	GRand* rand;		/* this worker's private PRNG stream */
+	unsigned count;		/* packets to produce this round */
+	unsigned max_len;	/* bytes reserved per packet buffer */
+	uint8_t* buffers;	/* RANDPKT_CHUNK_PACKETS * max_len bytes */
+	unsigned* lengths;
+	union wtap_pseudo_header* pseudo_headers;
+	GThread* thread;
+} randpkt_worker_t;
+
+static void*
+randpkt_worker_run(void* arg)
+{
+	randpkt_worker_t* worker = (randpkt_worker_t*)arg;
+	randpkt_example* example = worker->example;
+	unsigned i;
+
+	for (i = 0; i < worker->count; i++) {
+		union wtap_pseudo_header* ps_header = &worker->pseudo_headers[i];
+
+		memset(ps_header, 0, sizeof(*ps_header));
+		if (example->pseudo_buffer)
+			memcpy(ps_header, example->pseudo_buffer,
+			    example->pseudo_length);
+
+		worker->lengths[i] = randpkt_produce(example, worker->rand,
+		    &worker->buffers[(size_t)i * worker->max_len], ps_header);
+	}
+	return NULL;
+}
+
+void randpkt_loop_threaded(randpkt_example* example, uint64_t produce_count, unsigned n_threads)
+{
+	randpkt_worker_t* workers;
+	wtap_rec* rec;
+	uint64_t assigned = 0;
+	uint64_t num = 0;
+	unsigned max_len;
+	unsigned t, i;
+	int err;
+	char* err_info;
+
+	if (n_threads <= 1) {
+		randpkt_loop(example, produce_count, 0);
+		return;
+	}
+
+	max_len = example->sample_length + example->produce_max_bytes;
+	if (max_len > WTAP_MAX_PACKET_SIZE_STANDARD)
+		max_len = WTAP_MAX_PACKET_SIZE_STANDARD;
+
+	workers = g_new0(randpkt_worker_t, n_threads);
+	for (t = 0; t < n_threads; t++) {
+		workers[t].example = example;
+		/* Derive each worker's seed from the shared PRNG, so runs
+		 * are repeatable for a given pkt_rand seed regardless of
+		 * thread scheduling. */
+		workers[t].rand = g_rand_new_with_seed(g_rand_int(pkt_rand));
+		workers[t].max_len = max_len;
+		workers[t].buffers = (uint8_t*)g_malloc0((size_t)RANDPKT_CHUNK_PACKETS * max_len);
+		workers[t].lengths = g_new0(unsigned, RANDPKT_CHUNK_PACKETS);
+		workers[t].pseudo_headers = g_new0(union wtap_pseudo_header, RANDPKT_CHUNK_PACKETS);
+
+		/* Load the sample into each per-packet buffer up front */
+		if (example->sample_buffer) {
+			for (i = 0; i < RANDPKT_CHUNK_PACKETS; i++) {
+				memcpy(&workers[t].buffers[(size_t)i * max_len],
+				    example->sample_buffer, example->sample_length);
+			}
+		}
+	}
+
+	rec = g_new0(wtap_rec, 1);
+	rec->rec_type = REC_TYPE_PACKET;
+	rec->presence_flags = WTAP_HAS_TS;
+	rec->rec_header.packet_header.pkt_encap = example->sample_wtap_encap;
+
+	while (num < produce_count) {
+		unsigned active = 0;
+
+		/* Hand each worker a chunk and set it generating */
+		for (t = 0; t < n_threads && assigned < produce_count; t++) {
+			workers[t].count = (unsigned)MIN(RANDPKT_CHUNK_PACKETS,
+			    produce_count - assigned);
+			assigned += workers[t].count;
+			workers[t].thread = g_thread_new("randpkt",
+			    randpkt_worker_run, &workers[t]);
+			active++;
+		}
+
+		/* Drain the workers in order, writing while the rest are
+		 * still generating */
+		for (t = 0; t < active; t++) {
+			g_thread_join(workers[t].thread);
+			workers[t].thread = NULL;
+
+			for (i = 0; i < workers[t].count; i++) {
+				rec->rec_header.packet_header.caplen = workers[t].lengths[i];
+				rec->rec_header.packet_header.len = workers[t].lengths[i];
+				rec->rec_header.packet_header.pseudo_header = workers[t].pseudo_headers[i];
+				rec->ts.secs = num; /* just for variety */
+
+				if (!wtap_dump(example->dump, rec,
+				    &workers[t].buffers[(size_t)i * max_len],
+				    &err, &err_info)) {
+					cfile_write_failure_message(NULL,
+					    example->filename, err, err_info, 0,
+					    wtap_dump_file_type_subtype(example->dump));
+				}
+				num++;
+			}
+		}
+	}
+
+	for (t = 0; t < n_threads; t++) {
+		g_rand_free(workers[t].rand);
+		g_free(workers[t].buffers);
+		g_free(workers[t].lengths);
+		g_free(workers[t].pseudo_headers);
+	}
+	g_free(workers);
+	g_free(rec);
+}
+
+void randpkt_seed_prng(uint32_t seed)
+{
+	if (pkt_rand != NULL) {
+		g_rand_free(pkt_rand);
+	}
+	pkt_rand = g_rand_new_with_seed(seed);
+}
+
 bool randpkt_example_close(randpkt_example* example)
 {
 	int err;
@@ -721,6 +877,55 @@ int randpkt_parse_type(char *string)
 	return -1;
 }
 
+/* The weighted type mix: each type appears in the array once per unit of
+ * weight, so picking a uniformly random element gives the weighted
+ * distribution.  Weights are expected to be small.
+ */
+static GArray *mix_types;
+
+bool randpkt_parse_mix(char *string)
+{
+	char	**entries;
+	unsigned i, j;
+
+	if (mix_types != NULL)
+		g_array_free(mix_types, TRUE);
+	mix_types = g_array_new(FALSE, FALSE, sizeof(int));
+
+	entries = g_strsplit(string, ",", -1);
+	for (i = 0; entries[i] != NULL; i++) {
+		char	*colon = strchr(entries[i], ':');
+		unsigned weight = 1;
+		int	type;
+
+		if (colon != NULL) {
+			*colon = '\0';
+			weight = (unsigned)strtoul(colon + 1, NULL, 10);
+			if (weight == 0 || weight > 1000) {
+				fprintf(stderr, "randpkt: Bad weight \"%s\" for type %s.\n",
+				    colon + 1, entries[i]);
+				g_strfreev(entries);
+				return false;
+			}
+		}
+		type = randpkt_parse_type(entries[i]);
+		for (j = 0; j < weight; j++)
+			g_array_append_val(mix_types, type);
+	}
+	g_strfreev(entries);
+
+	return mix_types->len > 0;
+}
+
+int randpkt_pick_mix_type(void)
+{
+	if (mix_types == NULL || mix_types->len == 0)
+		return randpkt_parse_type(NULL);
+
+	return g_array_index(mix_types, int,
+	    g_random_int_range(0, mix_types->len));
+}
+
 void randpkt_example_list(char*** abbrev_list, char*** longname_list)
 {
 	unsigned i;
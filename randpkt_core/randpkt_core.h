@@ -40,6 +40,17 @@ void randpkt_example_list(char*** abbrev_list, char*** longname_list);
 /* Parse command-line option "type" and return enum type */
 int randpkt_parse_type(char *string);
 
+/* Parse a comma-separated list of "type" or "type:weight" entries to use
+ * as the weighted mix sampled by randpkt_pick_mix_type() */
+bool randpkt_parse_mix(char *string);
+
+/* Pick a random type from the weighted mix; with no mix configured,
+ * pick uniformly among all types */
+int randpkt_pick_mix_type(void);
+
+/* Seed the packet generation PRNG, for reproducible traces */
+void randpkt_seed_prng(uint32_t seed);
+
 /* Find pkt_example record and return pointer to it */
 randpkt_example* randpkt_find_example(int type);
 
@@ -49,6 +60,10 @@ int randpkt_example_init(randpkt_example* example, char* produce_filename, int p
 /* Loop the packet generation */
 void randpkt_loop(randpkt_example* example, uint64_t produce_count, uint64_t packet_delay_ms);
 
+/* Loop the packet generation with n_threads worker threads generating
+ * packets, each from its own PRNG stream, while this thread writes them */
+void randpkt_loop_threaded(randpkt_example* example, uint64_t produce_count, unsigned n_threads);
+
 /* Close the current example */
 bool randpkt_example_close(randpkt_example* example);
 
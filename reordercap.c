@@ -20,7 +20,9 @@
 #include <wsutil/ws_getopt.h>
 
 #include <wiretap/wtap.h>
+#include <wiretap/merge.h>
 
+#include <wsutil/clopts_common.h>
 #include <wsutil/cmdarg_err.h>
 #include <wsutil/filesystem.h>
 #include <wsutil/file_util.h>
@@ -50,6 +52,8 @@ print_usage(FILE *output)
     fprintf(output, "\n");
     fprintf(output, "Options:\n");
     fprintf(output, "  -n                don't write to output file if the input file is ordered.\n");
+    fprintf(output, "  -m <max frames>   hold at most <max frames> frames in memory, sorting larger\n");
+    fprintf(output, "                    files in multiple passes via temporary files.\n");
     fprintf(output, "  -h, --help        display this help and exit.\n");
     fprintf(output, "  -v, --version     print version information and exit.\n");
 }
@@ -132,6 +136,88 @@ frames_compare(const void *a, const void *b)
     return nstime_cmp(time1, time2);
 }
 
+/* Sort the frames buffered so far and write them, as one sorted run, to a
+   temporary file, so that large captures can be sorted without holding every
+   frame record in memory.  The seek-reads stay within the byte range covered
+   by the run, so the I/O remains close to sequential.  The frame records are
+   freed and the array emptied; the temporary file's pathname is returned. */
+static char *
+run_write(wtap *wth, GPtrArray *frames, const char *infile)
+{
+    wtap_dump_params params;
+    wtap_dumper *run_pdh;
+    char        *run_filename;
+    wtap_rec     rec;
+    Buffer       buf;
+    int          err;
+    char        *err_info;
+    unsigned     i;
+
+    g_ptr_array_sort(frames, frames_compare);
+
+    wtap_dump_params_init(&params, wth);
+    run_pdh = wtap_dump_open_tempfile(NULL, &run_filename, "reordercap",
+                                      wtap_file_type_subtype(wth),
+                                      WTAP_UNCOMPRESSED, &params, &err,
+                                      &err_info);
+    g_free(params.idb_inf);
+    params.idb_inf = NULL;
+    if (run_pdh == NULL) {
+        cfile_dump_open_failure_message("temporary file", err, err_info,
+                                        wtap_file_type_subtype(wth));
+        exit(1);
+    }
+
+    wtap_rec_init(&rec);
+    ws_buffer_init(&buf, 1514);
+    for (i = 0; i < frames->len; i++) {
+        FrameRecord_t *frame = (FrameRecord_t *)frames->pdata[i];
+
+        frame_write(frame, wth, run_pdh, &rec, &buf, infile, run_filename);
+        g_slice_free(FrameRecord_t, frame);
+    }
+    wtap_rec_cleanup(&rec);
+    ws_buffer_free(&buf);
+    g_ptr_array_set_size(frames, 0);
+
+    if (!wtap_dump_close(run_pdh, NULL, &err, &err_info)) {
+        cfile_close_failure_message(run_filename, err, err_info);
+        wtap_dump_params_cleanup(&params);
+        exit(1);
+    }
+    wtap_dump_params_cleanup(&params);
+
+    return run_filename;
+}
+
+/* Merge the sorted runs, in chronological order, into the output file, and
+   remove the temporary run files. */
+static int
+runs_merge(GPtrArray *run_files, int file_type_subtype, const char *outfile)
+{
+    bool     ok;
+    unsigned i;
+
+    if (strcmp(outfile, "-") == 0) {
+        ok = merge_files_to_stdout(file_type_subtype,
+                                   (const char *const *)run_files->pdata,
+                                   run_files->len, false,
+                                   IDB_MERGE_MODE_ALL_SAME, 0,
+                                   get_appname_and_version(), NULL);
+    } else {
+        ok = merge_files(outfile, file_type_subtype,
+                         (const char *const *)run_files->pdata,
+                         run_files->len, false, IDB_MERGE_MODE_ALL_SAME, 0,
+                         get_appname_and_version(), NULL);
+    }
+
+    for (i = 0; i < run_files->len; i++) {
+        ws_unlink((const char *)run_files->pdata[i]);
+    }
+
+    return ok ? EXIT_SUCCESS : OUTPUT_FILE_ERROR;
+}
+
 /*
  * General errors and warnings are reported with an console message
  * in reordercap.
@@ -182,11 +268,15 @@ main(int argc, char *argv[])
     int64_t data_offset;
     unsigned wrong_order_count = 0;
     bool write_output_regardless = true;
+    unsigned max_frames_in_mem = 0;
+    unsigned frame_count = 0;
     unsigned i;
     wtap_dump_params params;
     int                          ret = EXIT_SUCCESS;
 
     GPtrArray *frames;
+    GPtrArray *run_files = NULL;
+    FrameRecord_t prevFrameStore;
     FrameRecord_t *prevFrame = NULL;
 
     int opt;
@@ -234,11 +324,14 @@ main(int argc, char *argv[])
     wtap_init(true);
 
     /* Process the options first */
-    while ((opt = ws_getopt_long(argc, argv, "hnv", long_options, NULL)) != -1) {
+    while ((opt = ws_getopt_long(argc, argv, "hm:nv", long_options, NULL)) != -1) {
         switch (opt) {
             case 'n':
                 write_output_regardless = false;
                 break;
+            case 'm':
+                max_frames_in_mem = get_nonzero_uint32(ws_optarg, "maximum frames in memory");
+                break;
             case 'h':
                 show_help_header("Reorder timestamps of input file frames into output file.");
                 print_usage(stdout);
@@ -286,7 +379,7 @@ main(int argc, char *argv[])
         FrameRecord_t *newFrameRecord;
 
         newFrameRecord = g_slice_new(FrameRecord_t);
-        newFrameRecord->num = frames->len + 1;
+        newFrameRecord->num = ++frame_count;
         newFrameRecord->offset = data_offset;
         if (rec.presence_flags & WTAP_HAS_TS) {
             newFrameRecord->frame_time = rec.ts;
@@ -299,8 +392,20 @@ main(int argc, char *argv[])
         }
 
         g_ptr_array_add(frames, newFrameRecord);
-        prevFrame = newFrameRecord;
+        /* Copy, rather than keep a pointer, as run_write() may free the
+           record before the next frame is read. */
+        prevFrameStore = *newFrameRecord;
+        prevFrame = &prevFrameStore;
         wtap_rec_reset(&rec);
+
+        /* If we've hit the in-memory frame limit, spill a sorted run to a
+           temporary file and carry on reading. */
+        if (max_frames_in_mem > 0 && frames->len >= max_frames_in_mem) {
+            if (run_files == NULL) {
+                run_files = g_ptr_array_new_with_free_func(g_free);
+            }
+            g_ptr_array_add(run_files, run_write(wth, frames, infile));
+        }
     }
     wtap_rec_cleanup(&rec);
     ws_buffer_free(&buf);
@@ -309,7 +414,29 @@ main(int argc, char *argv[])
       cfile_read_failure_message(infile, err, err_info);
     }
 
-    printf("%u frames, %u out of order\n", frames->len, wrong_order_count);
+    printf("%u frames, %u out of order\n", frame_count, wrong_order_count);
+
+    if (run_files != NULL) {
+        /* External sort: flush the remaining frames as the final run, then
+           merge the sorted runs in chronological order. */
+        if (frames->len > 0) {
+            g_ptr_array_add(run_files, run_write(wth, frames, infile));
+        }
+        g_ptr_array_free(frames, TRUE);
+
+        if (write_output_regardless || (wrong_order_count > 0)) {
+            ret = runs_merge(run_files, wtap_file_type_subtype(wth), outfile);
+        } else {
+            printf("Not writing output file because input file is already in order.\n");
+            for (i = 0; i < run_files->len; i++) {
+                ws_unlink((const char *)run_files->pdata[i]);
+            }
+        }
+        g_ptr_array_free(run_files, TRUE);
+
+        wtap_close(wth);
+        goto clean_exit;
+    }
 
     wtap_dump_params_init(&params, wth);
 
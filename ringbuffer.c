@@ -85,6 +85,7 @@ typedef struct _ringbuf_data {
     bool          unlimited;           /**< true if unlimited number of files */
 
     int           fd;                  /**< Current ringbuffer file descriptor */
+    uint64_t      prealloc_size;       /**< Bytes to preallocate per file (0 = none) */
     FILE         *pdh;
     char         *io_buffer;              /**< The IO buffer used to write to the file */
     bool          group_read_access;   /**< true if files need to be opened with group read access */
@@ -169,6 +170,12 @@ ringbuf_exec_compress(char* name)
         return -1;
     }
 
+    /* Grow the gzip output buffer from its 8KB default to match our
+       read chunks, so the compressed stream is written in fewer,
+       larger chunks and the compressor thread competes less with the
+       capture thread for I/O. */
+    (void)ZLIB_PREFIX(gzbuffer)(fi, FS_READ_SIZE);
+
     while ((nread = ws_read(fd, buffer, FS_READ_SIZE)) > 0) {
         int n = ZLIB_PREFIX(gzwrite)(fi, buffer, (unsigned int)nread);
         if (n <= 0) {
@@ -270,15 +277,48 @@ ringbuf_open_file(rb_file *rfile, int *err)
         *err = errno;
     }
 
+#ifdef HAVE_POSIX_FALLOCATE
+    if (rb_data.fd != -1 && rb_data.prealloc_size != 0) {
+        /* Reserve the blocks for the whole file up front, so the file
+           system doesn't have to extend the file while we're writing
+           packets to it.  Allocation failure (e.g. an unsupported file
+           system) is harmless; we just fall back to growing the file
+           as we write.  The unused tail is trimmed when the file is
+           closed at the next switch. */
+        (void)posix_fallocate(rb_data.fd, 0, (off_t)rb_data.prealloc_size);
+    }
+#endif
+
     return rb_data.fd;
 }
 
+#ifdef HAVE_POSIX_FALLOCATE
+/*
+ * Trim the preallocated tail of the current file back to the bytes
+ * actually written, so readers don't see zero padding after the last
+ * packet.
+ */
+static void
+ringbuf_trim_prealloc(void)
+{
+    long written;
+
+    if (rb_data.prealloc_size == 0 || rb_data.pdh == NULL)
+        return;
+
+    fflush(rb_data.pdh);
+    written = ftell(rb_data.pdh);
+    if (written >= 0)
+        (void)ftruncate(rb_data.fd, (off_t)written);
+}
+#endif
+
 /*
  * Initialize the ringbuffer data structures
  */
 int
 ringbuf_init(const char *capfile_name, unsigned num_files, bool group_read_access,
-        char *compress_type, bool has_nametimenum)
+        char *compress_type, bool has_nametimenum, uint64_t prealloc_size)
 {
     unsigned int i;
     char        *pfx;
@@ -291,6 +331,7 @@ ringbuf_init(const char *capfile_name, unsigned num_files, bool group_read_acces
     rb_data.nametimenum = has_nametimenum;
     rb_data.unlimited = false;
     rb_data.fd = -1;
+    rb_data.prealloc_size = prealloc_size;
     rb_data.pdh = NULL;
     rb_data.io_buffer = NULL;
     rb_data.group_read_access = group_read_access;
@@ -451,6 +492,9 @@ ringbuf_switch_file(FILE **pdh, char **save_file, int *save_file_fd, int *err)
 
     /* close current file */
 
+#ifdef HAVE_POSIX_FALLOCATE
+    ringbuf_trim_prealloc();
+#endif
     if (fclose(rb_data.pdh) == EOF) {
         if (err != NULL) {
             *err = errno;
@@ -503,6 +547,9 @@ ringbuf_libpcap_dump_close(char **save_file, int *err)
 
     /* close current file, if it's open */
     if (rb_data.pdh != NULL) {
+#ifdef HAVE_POSIX_FALLOCATE
+        ringbuf_trim_prealloc();
+#endif
         if (fclose(rb_data.pdh) == EOF) {
             if (err != NULL) {
                 *err = errno;
@@ -25,7 +25,7 @@
 #define RINGBUFFER_WARN_NUM_FILES 65535
 
 int ringbuf_init(const char *capture_name, unsigned num_files, bool group_read_access, char* compress_type,
-                 bool nametimenum);
+                 bool nametimenum, uint64_t prealloc_size);
 bool ringbuf_is_initialized(void);
 const char *ringbuf_current_filename(void);
 FILE *ringbuf_init_libpcap_fdopen(int *err);
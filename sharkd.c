@@ -291,7 +291,7 @@ process_packet(capture_file *cf, epan_dissect_t *edt,
          */
         if (edt && cf->dfcode) {
             if (dfilter_apply_edt(cf->dfcode, edt) && edt->pi.fd->dependent_frames) {
-                g_hash_table_foreach(edt->pi.fd->dependent_frames, find_and_mark_frame_depended_upon, cf->provider.frames);
+                find_and_mark_frames_depended_upon(cf->provider.frames, edt->pi.fd->dependent_frames);
             }
         }
 
@@ -309,8 +309,12 @@ process_packet(capture_file *cf, epan_dissect_t *edt,
 }
 
 
+/* Report progress at most this often while loading. */
+#define LOAD_PROGRESS_INTERVAL_US (500 * 1000)
+
 static int
-load_cap_file(capture_file *cf, int max_packet_count, int64_t max_byte_count)
+load_cap_file(capture_file *cf, int max_packet_count, int64_t max_byte_count,
+        sharkd_load_progress_func_t progress_cb, void *progress_data)
 {
     int          err;
     char        *err_info = NULL;
@@ -318,6 +322,7 @@ load_cap_file(capture_file *cf, int max_packet_count, int64_t max_byte_count)
     wtap_rec     rec;
     Buffer       buf;
     epan_dissect_t *edt = NULL;
+    int64_t      progress_next = 0;
 
     {
         /* Allocate a frame_data_sequence for all the frames. */
@@ -348,6 +353,9 @@ load_cap_file(capture_file *cf, int max_packet_count, int64_t max_byte_count)
         wtap_rec_init(&rec);
         ws_buffer_init(&buf, 1514);
 
+        if (progress_cb)
+            progress_next = g_get_monotonic_time() + LOAD_PROGRESS_INTERVAL_US;
+
         while (wtap_read(cf->provider.wth, &rec, &buf, &err, &err_info, &data_offset)) {
             if (process_packet(cf, edt, data_offset, &rec, &buf)) {
                 wtap_rec_reset(&rec);
@@ -361,6 +369,14 @@ load_cap_file(capture_file *cf, int max_packet_count, int64_t max_byte_count)
                     break;
                 }
             }
+
+            /* Check the clock only every so many frames; reading the
+             * monotonic clock per frame is measurable on large files. */
+            if (progress_cb && (cf->count & 0x3ff) == 0 &&
+                    g_get_monotonic_time() >= progress_next) {
+                progress_cb(cf->count, (uint64_t) data_offset, progress_data);
+                progress_next = g_get_monotonic_time() + LOAD_PROGRESS_INTERVAL_US;
+            }
         }
 
         if (edt) {
@@ -470,10 +486,54 @@ sharkd_cf_open(const char *fname, unsigned int type, bool is_tempfile, int *err)
     return cf_open(&cfile, fname, type, is_tempfile, err);
 }
 
+/*
+ * XXX - it is tempting to snapshot the first-pass results here so a
+ * restarted sharkd could skip the sequential dissection.  frame_data
+ * records themselves would serialize, but correct second-pass dissection
+ * also depends on the epan session state built during this pass -
+ * conversation tables, reassembly fragments and per-dissector
+ * conversation data - all of which hold raw pointers into wmem file
+ * scope and dissector-private structs with no stable on-disk form.
+ * Restoring frame metadata without that state silently mis-dissects
+ * stateful protocols, so no snapshot/restore path is offered; a restart
+ * has to reload the file.
+ */
 int
 sharkd_load_cap_file(void)
 {
-    return load_cap_file(&cfile, 0, 0);
+    return load_cap_file(&cfile, 0, 0, NULL, NULL);
+}
+
+int
+sharkd_load_cap_file_with_progress(sharkd_load_progress_func_t progress_cb, void *progress_data)
+{
+    return load_cap_file(&cfile, 0, 0, progress_cb, progress_data);
+}
+
+int
+sharkd_preload_cap_file(const char *fname)
+{
+    int err = 0;
+
+    if (sharkd_cf_open(fname, WTAP_TYPE_AUTO, false, &err) != CF_OK)
+        return -1;
+    return sharkd_load_cap_file();
+}
+
+bool
+sharkd_reopen_cap_file(void)
+{
+    int err = 0;
+
+    if (cfile.provider.wth == NULL)
+        return true;
+
+    /* A forked session shares the parent's file-table entries, and with
+       them the seek position of the random-access descriptor; reopen it
+       so each session seeks independently of its siblings.  The
+       sequential descriptor doesn't matter - after the load, sessions
+       only seek-read. */
+    return wtap_fdreopen(cfile.provider.wth, cfile.filename, &err);
 }
 
 frame_data *
@@ -605,7 +665,7 @@ sharkd_retap(void)
 }
 
 int
-sharkd_filter(const char *dftext, uint8_t **result)
+sharkd_filter(const char *dftext, uint8_t **result, dfilter_t **dfcode_r)
 {
     dfilter_t  *dfcode = NULL;
 
@@ -621,6 +681,8 @@ sharkd_filter(const char *dftext, uint8_t **result)
 
     epan_dissect_t edt;
 
+    *dfcode_r = NULL;
+
     if (!dfilter_compile(dftext, &dfcode, NULL)) {
         return -1;
     }
@@ -680,7 +742,9 @@ sharkd_filter(const char *dftext, uint8_t **result)
     ws_buffer_free(&buf);
     epan_dissect_cleanup(&edt);
 
-    dfilter_free(dfcode);
+    /* The caller keeps the compiled code, so a reissued filter does not
+     * have to be recompiled. */
+    *dfcode_r = dfcode;
 
     *result = result_bits;
 
@@ -27,12 +27,16 @@
 #define SHARKD_MODE_GOLD_DAEMON        4
 
 typedef void (*sharkd_dissect_func_t)(epan_dissect_t *edt, proto_tree *tree, struct epan_column_info *cinfo, const GSList *data_src, void *data);
+typedef void (*sharkd_load_progress_func_t)(uint32_t frames, uint64_t bytes, void *data);
 
 /* sharkd.c */
 cf_status_t sharkd_cf_open(const char *fname, unsigned int type, bool is_tempfile, int *err);
 int sharkd_load_cap_file(void);
+int sharkd_load_cap_file_with_progress(sharkd_load_progress_func_t progress_cb, void *progress_data);
+int sharkd_preload_cap_file(const char *fname);
+bool sharkd_reopen_cap_file(void);
 int sharkd_retap(void);
-int sharkd_filter(const char *dftext, uint8_t **result);
+int sharkd_filter(const char *dftext, uint8_t **result, dfilter_t **dfcode_r);
 frame_data *sharkd_get_frame(uint32_t framenum);
 enum dissect_request_status {
   DISSECT_REQUEST_SUCCESS,
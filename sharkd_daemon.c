@@ -52,6 +52,7 @@
 
 static int mode;
 static socket_handle_t _server_fd = INVALID_SOCKET;
+static char *preload_file;
 
 static socket_handle_t
 socket_init(char *path)
@@ -183,6 +184,11 @@ print_usage(FILE* output)
     fprintf(output, "  -v, --version            show version information\n");
     fprintf(output, "  -C <config profile>, --config-profile <config profile>\n");
     fprintf(output, "                           start with specified configuration profile\n");
+    fprintf(output, "  -p <infile>, --preload <infile>\n");
+    fprintf(output, "                           load the capture file before serving sessions;\n");
+    fprintf(output, "                           daemon sessions then start with the file already\n");
+    fprintf(output, "                           loaded, sharing the loaded state where the OS\n");
+    fprintf(output, "                           allows (fork)\n");
 
     fprintf(output, "\n");
     fprintf(output, "  Examples:\n");
@@ -217,7 +223,7 @@ sharkd_init(int argc, char **argv)
      * platform-dependent.
      */
 
-#define OPTSTRING "+" "a:hmvC:"
+#define OPTSTRING "+" "a:hmp:vC:"
 
     static const char    optstring[] = OPTSTRING;
 
@@ -225,6 +231,7 @@ sharkd_init(int argc, char **argv)
     static const struct ws_option long_options[] = {
         {"api", ws_required_argument, NULL, 'a'},
         {"help", ws_no_argument, NULL, 'h'},
+        {"preload", ws_required_argument, NULL, 'p'},
         {"version", ws_no_argument, NULL, 'v'},
         {"config-profile", ws_required_argument, NULL, 'C'},
         {0, 0, 0, 0 }
@@ -322,6 +329,11 @@ sharkd_init(int argc, char **argv)
                     mode = SHARKD_MODE_GOLD_CONSOLE;
                     break;
 
+                case 'p':
+                    // loaded in sharkd_loop(), after wiretap and epan are up
+                    preload_file = ws_optarg;
+                    break;
+
                 case 'v':         /* Show version and exit */
                     show_version();
                     exit(0);
@@ -363,6 +375,22 @@ sharkd_loop(int argc _U_, char* argv[] _U_)
 sharkd_loop(int argc _U_, char* argv[])
 #endif
 {
+    if (preload_file != NULL)
+    {
+        /* One load for all the sessions: on systems where the daemon
+           forks its session processes, they inherit the frame metadata
+           and the dissection state built here as copy-on-write pages,
+           so N analysts on the same capture cost one load rather than
+           N.  On Windows each session process is spawned with the
+           --preload option and loads the file itself at startup. */
+        if (sharkd_preload_cap_file(preload_file) != 0)
+        {
+            fprintf(stderr, "cannot preload \"%s\"\n", preload_file);
+            return 2;
+        }
+        fprintf(stderr, "Sharkd preloaded: %s\n", preload_file);
+    }
+
     if (mode == SHARKD_MODE_CLASSIC_CONSOLE || mode == SHARKD_MODE_GOLD_CONSOLE)
     {
         return sharkd_session_main(mode);
@@ -400,6 +428,14 @@ sharkd_loop(int argc _U_, char* argv[])
             dup2(fd, 1);
             close(fd);
 
+            /* The inherited descriptors share seek positions with our
+               siblings; get our own before serving. */
+            if (preload_file != NULL && !sharkd_reopen_cap_file())
+            {
+                fprintf(stderr, "cannot reopen preloaded \"%s\"\n", preload_file);
+                exit(2);
+            }
+
             exit(sharkd_session_main(mode));
         }
 
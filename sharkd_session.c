@@ -29,6 +29,7 @@
 #include <file.h>
 #include <epan/epan_dissect.h>
 #include <epan/exceptions.h>
+#include <epan/packet.h>
 #include <epan/color_filters.h>
 #include <epan/prefs.h>
 #include <epan/prefs-int.h>
@@ -82,9 +83,31 @@
 struct sharkd_filter_item
 {
     uint8_t *filtered; /* can be NULL if all frames are matching for given filter. */
+    dfilter_t *dfcode; /* compiled filter, NULL if all frames are matching. */
+    unsigned last_used; /* age stamp for LRU eviction. */
 };
 
+/* Upper bound on cached filters; the oldest entry is evicted beyond it. */
+#define SHARKD_FILTER_CACHE_MAX 64
+
 static GHashTable *filter_table;
+static unsigned filter_table_age;
+
+struct sharkd_frame_cache_item
+{
+    char *response;     /* serialized response tail, from "result" onward. */
+    unsigned last_used; /* age stamp for LRU eviction. */
+};
+
+/* Upper bound on cached frame responses; the oldest entry is evicted
+ * beyond it.  The cache only lives for the duration of a run of "frame"
+ * requests - any other method clears it - so it exists to make
+ * scrolling (which re-requests recently shown frames) independent of
+ * dissection cost. */
+#define SHARKD_FRAME_CACHE_MAX 128
+
+static GHashTable *frame_cache;
+static unsigned frame_cache_age;
 
 static int mode;
 static uint32_t rpcid;
@@ -376,6 +399,7 @@ json_prep(char* buf, const jsmntok_t* tokens, int count)
         {"method",     "bye",            1, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"method",     "check",          1, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"method",     "complete",       1, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
+        {"method",     "dissectortime",  1, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"method",     "download",       1, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"method",     "dumpconf",       1, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"method",     "follow",         1, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
@@ -387,6 +411,7 @@ json_prep(char* buf, const jsmntok_t* tokens, int count)
         {"method",     "load",           1, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"method",     "setcomment",     1, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"method",     "setconf",        1, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
+        {"method",     "stats",          1, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"method",     "status",         1, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"method",     "tap",            1, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
 
@@ -395,6 +420,8 @@ json_prep(char* buf, const jsmntok_t* tokens, int count)
         {"check",      "filter",         2, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"complete",   "field",          2, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"complete",   "pref",           2, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
+        {"dissectortime", "enabled",     2, JSMN_PRIMITIVE,    SHARKD_JSON_BOOLEAN,  SHARKD_OPTIONAL},
+        {"dissectortime", "reset",       2, JSMN_PRIMITIVE,    SHARKD_JSON_BOOLEAN,  SHARKD_OPTIONAL},
         {"download",   "token",          2, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"dumpconf",   "pref",           2, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"follow",     "follow",         2, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_MANDATORY},
@@ -443,6 +470,7 @@ json_prep(char* buf, const jsmntok_t* tokens, int count)
         {"setcomment", "comment",        2, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"setconf",    "name",           2, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_MANDATORY},
         {"setconf",    "value",          2, JSMN_UNDEFINED,    SHARKD_JSON_ANY,      SHARKD_MANDATORY},
+        {"stats",      "reset",          2, JSMN_PRIMITIVE,    SHARKD_JSON_BOOLEAN,  SHARKD_OPTIONAL},
         {"tap",        "tap0",           2, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_MANDATORY},
         {"tap",        "tap1",           2, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
         {"tap",        "tap2",           2, JSMN_STRING,       SHARKD_JSON_STRING,   SHARKD_OPTIONAL},
@@ -727,9 +755,34 @@ sharkd_session_filter_free(void *data)
     struct sharkd_filter_item *l = (struct sharkd_filter_item *) data;
 
     g_free(l->filtered);
+    dfilter_free(l->dfcode);
     g_free(l);
 }
 
+static void
+sharkd_session_filter_evict_oldest(void)
+{
+    GHashTableIter iter;
+    void *key, *value;
+    const char *oldest_key = NULL;
+    unsigned oldest_age = 0;
+
+    g_hash_table_iter_init(&iter, filter_table);
+    while (g_hash_table_iter_next(&iter, &key, &value))
+    {
+        struct sharkd_filter_item *l = (struct sharkd_filter_item *) value;
+
+        if (oldest_key == NULL || l->last_used < oldest_age)
+        {
+            oldest_key = (const char *) key;
+            oldest_age = l->last_used;
+        }
+    }
+
+    if (oldest_key)
+        g_hash_table_remove(filter_table, oldest_key);
+}
+
 static const struct sharkd_filter_item *
 sharkd_session_filter_data(const char *filter)
 {
@@ -739,21 +792,68 @@ sharkd_session_filter_data(const char *filter)
     if (!l)
     {
         uint8_t *filtered = NULL;
+        dfilter_t *dfcode = NULL;
 
-        int ret = sharkd_filter(filter, &filtered);
+        int ret = sharkd_filter(filter, &filtered, &dfcode);
 
         if (ret == -1)
             return NULL;
 
+        if (g_hash_table_size(filter_table) >= SHARKD_FILTER_CACHE_MAX)
+            sharkd_session_filter_evict_oldest();
+
         l = g_new(struct sharkd_filter_item, 1);
         l->filtered = filtered;
+        l->dfcode = dfcode;
 
         g_hash_table_insert(filter_table, g_strdup(filter), l);
     }
 
+    l->last_used = ++filter_table_age;
+
     return l;
 }
 
+static void
+sharkd_session_frame_cache_free(void *data)
+{
+    struct sharkd_frame_cache_item *l = (struct sharkd_frame_cache_item *) data;
+
+    g_free(l->response);
+    g_free(l);
+}
+
+static void
+sharkd_session_frame_cache_evict_oldest(void)
+{
+    GHashTableIter iter;
+    void *key, *value;
+    const char *oldest_key = NULL;
+    unsigned oldest_age = 0;
+
+    g_hash_table_iter_init(&iter, frame_cache);
+    while (g_hash_table_iter_next(&iter, &key, &value))
+    {
+        struct sharkd_frame_cache_item *l = (struct sharkd_frame_cache_item *) value;
+
+        if (oldest_key == NULL || l->last_used < oldest_age)
+        {
+            oldest_key = (const char *) key;
+            oldest_age = l->last_used;
+        }
+    }
+
+    if (oldest_key)
+        g_hash_table_remove(frame_cache, oldest_key);
+}
+
+static void
+sharkd_session_frame_cache_reset(void)
+{
+    if (frame_cache)
+        g_hash_table_remove_all(frame_cache);
+}
+
 static bool
 sharkd_rtp_match_init(rtpstream_id_t *id, const char *init_str)
 {
@@ -1167,6 +1267,20 @@ sharkd_session_process_info(void)
  * Output object with attributes:
  *   (m) err - error code
  */
+static void
+sharkd_session_load_progress_cb(uint32_t frames, uint64_t bytes, void *data _U_)
+{
+    /* JSON-RPC notification (no id): periodic progress while loading. */
+    json_dumper_begin_object(&dumper);
+    sharkd_json_value_string("jsonrpc", "2.0");
+    sharkd_json_value_string("method", "load_progress");
+    sharkd_json_object_open("params");
+    sharkd_json_value_anyf("frames", "%u", frames);
+    sharkd_json_value_anyf("bytes", "%" PRIu64, bytes);
+    sharkd_json_object_close();
+    sharkd_json_response_close();
+}
+
 static void
 sharkd_session_process_load(const char *buf, const jsmntok_t *tokens, int count)
 {
@@ -1178,6 +1292,9 @@ sharkd_session_process_load(const char *buf, const jsmntok_t *tokens, int count)
 
     fprintf(stderr, "load: filename=%s\n", tok_file);
 
+    /* Cached match bitsets index frames of the previous capture. */
+    g_hash_table_remove_all(filter_table);
+
     if (sharkd_cf_open(tok_file, WTAP_TYPE_AUTO, false, &err) != CF_OK)
     {
         sharkd_json_error(
@@ -1189,7 +1306,7 @@ sharkd_session_process_load(const char *buf, const jsmntok_t *tokens, int count)
 
     TRY
     {
-        err = sharkd_load_cap_file();
+        err = sharkd_load_cap_file_with_progress(sharkd_session_load_progress_cb, NULL);
     }
     CATCH(OutOfMemoryError)
     {
@@ -1288,6 +1405,177 @@ sharkd_session_process_status(void)
     sharkd_json_result_epilogue();
 }
 
+/**
+ * sharkd_session_process_dissectortime()
+ *
+ * Process dissectortime request
+ *
+ * Input:
+ *   (o) enabled - enable or disable per-dissector timing collection;
+ *                 takes effect for subsequent dissection passes
+ *   (o) reset   - when true, discard the timing collected so far
+ *
+ * Output object with attributes:
+ *   (m) enabled    - whether timing collection is enabled
+ *   (m) dissectors - array of objects, sorted by exclusive time descending,
+ *                    with attributes:
+ *                      'protocol'  - protocol filter name
+ *                      'calls'     - number of dissector invocations
+ *                      'incl_usec' - time including subdissectors, in microseconds
+ *                      'excl_usec' - time excluding subdissectors, in microseconds
+ */
+static void
+sharkd_session_process_dissectortime(char *buf, const jsmntok_t *tokens, int count)
+{
+    const char *tok_enabled = json_find_attr(buf, tokens, count, "enabled");
+    const char *tok_reset   = json_find_attr(buf, tokens, count, "reset");
+    GArray *timings;
+
+    if (tok_enabled)
+        dissector_timing_set_enabled(!strcmp(tok_enabled, "true"));
+    if (tok_reset && !strcmp(tok_reset, "true"))
+        dissector_timing_reset();
+
+    sharkd_json_result_prologue(rpcid);
+
+    sharkd_json_value_anyf("enabled", dissector_timing_get_enabled() ? "true" : "false");
+
+    timings = dissector_timing_get();
+    sharkd_json_array_open("dissectors");
+    for (unsigned i = 0; i < timings->len; i++)
+    {
+        const dissector_timing_t *timing = &g_array_index(timings, dissector_timing_t, i);
+
+        sharkd_json_object_open(NULL);
+        sharkd_json_value_string("protocol", timing->proto_id >= 0 ?
+                proto_get_protocol_filter_name(timing->proto_id) : "(no protocol)");
+        sharkd_json_value_anyf("calls", "%" PRIu64, timing->calls);
+        sharkd_json_value_anyf("incl_usec", "%" PRIu64, timing->incl_usecs);
+        sharkd_json_value_anyf("excl_usec", "%" PRIu64, timing->excl_usecs);
+        sharkd_json_object_close();
+    }
+    sharkd_json_array_close();
+    g_array_free(timings, true);
+
+    sharkd_json_result_epilogue();
+}
+
+/* Per-method latency histograms. Bucket i counts requests that took
+ * [2^i, 2^(i+1)) microseconds; the last bucket also absorbs anything
+ * slower. */
+#define SHARKD_LATENCY_BUCKETS 24
+
+struct sharkd_method_stat
+{
+    uint64_t calls;
+    uint64_t total_usecs;
+    uint64_t min_usecs;
+    uint64_t max_usecs;
+    uint64_t buckets[SHARKD_LATENCY_BUCKETS];
+};
+
+static GHashTable *sharkd_method_stats;
+
+static void
+sharkd_method_stats_record(const char *method, int64_t elapsed_usecs)
+{
+    struct sharkd_method_stat *stat;
+    uint64_t usecs = (elapsed_usecs > 0) ? (uint64_t) elapsed_usecs : 0;
+    unsigned bucket = 0;
+
+    if (!sharkd_method_stats)
+        sharkd_method_stats = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+
+    stat = (struct sharkd_method_stat *) g_hash_table_lookup(sharkd_method_stats, method);
+    if (!stat)
+    {
+        stat = g_new0(struct sharkd_method_stat, 1);
+        stat->min_usecs = UINT64_MAX;
+        g_hash_table_insert(sharkd_method_stats, g_strdup(method), stat);
+    }
+
+    stat->calls++;
+    stat->total_usecs += usecs;
+    if (usecs < stat->min_usecs)
+        stat->min_usecs = usecs;
+    if (usecs > stat->max_usecs)
+        stat->max_usecs = usecs;
+
+    while ((usecs >> (bucket + 1)) != 0 && bucket < SHARKD_LATENCY_BUCKETS - 1)
+        bucket++;
+    stat->buckets[bucket]++;
+}
+
+/**
+ * sharkd_session_process_stats()
+ *
+ * Process stats request
+ *
+ * Input:
+ *   (o) reset - when true, discard the latency statistics collected so far
+ *
+ * Output object with attributes:
+ *   (m) methods - array of objects, one per RPC method called so far,
+ *                 sorted by method name, with attributes:
+ *                   'name'       - method name
+ *                   'calls'      - number of requests
+ *                   'total_usec' - summed latency, in microseconds
+ *                   'min_usec'   - fastest request, in microseconds
+ *                   'max_usec'   - slowest request, in microseconds
+ *                   'buckets'    - latency histogram; entry i counts
+ *                                  requests that took [2^i, 2^(i+1)) usec,
+ *                                  the last entry absorbing slower ones
+ */
+static void
+sharkd_session_process_stats(char *buf, const jsmntok_t *tokens, int count)
+{
+    const char *tok_reset = json_find_attr(buf, tokens, count, "reset");
+    GList *keys, *l;
+
+    sharkd_json_result_prologue(rpcid);
+
+    sharkd_json_array_open("methods");
+    if (sharkd_method_stats)
+    {
+        keys = g_list_sort(g_hash_table_get_keys(sharkd_method_stats), (GCompareFunc) strcmp);
+        for (l = keys; l; l = l->next)
+        {
+            const char *name = (const char *) l->data;
+            const struct sharkd_method_stat *stat =
+                (const struct sharkd_method_stat *) g_hash_table_lookup(sharkd_method_stats, name);
+            unsigned last;
+
+            sharkd_json_object_open(NULL);
+            sharkd_json_value_string("name", name);
+            sharkd_json_value_anyf("calls", "%" PRIu64, stat->calls);
+            sharkd_json_value_anyf("total_usec", "%" PRIu64, stat->total_usecs);
+            sharkd_json_value_anyf("min_usec", "%" PRIu64, stat->min_usecs);
+            sharkd_json_value_anyf("max_usec", "%" PRIu64, stat->max_usecs);
+
+            /* don't serialize the empty tail of the histogram */
+            last = SHARKD_LATENCY_BUCKETS;
+            while (last > 0 && stat->buckets[last - 1] == 0)
+                last--;
+            sharkd_json_array_open("buckets");
+            for (unsigned i = 0; i < last; i++)
+                sharkd_json_value_anyf(NULL, "%" PRIu64, stat->buckets[i]);
+            sharkd_json_array_close();
+
+            sharkd_json_object_close();
+        }
+        g_list_free(keys);
+    }
+    sharkd_json_array_close();
+
+    sharkd_json_result_epilogue();
+
+    if (tok_reset && !strcmp(tok_reset, "true"))
+    {
+        if (sharkd_method_stats)
+            g_hash_table_remove_all(sharkd_method_stats);
+    }
+}
+
 struct sharkd_analyse_data
 {
     GHashTable *protocols_set;
@@ -4831,6 +5119,9 @@ sharkd_session_process_frame(char *buf, const jsmntok_t *tokens, int count)
     uint32_t framenum, ref_frame_num, prev_dis_num;
     uint32_t dissect_flags = SHARKD_DISSECT_FLAG_NULL;
     struct sharkd_frame_request_data req_data;
+    struct sharkd_frame_cache_item *cached;
+    char *cache_key;
+    GString *response_str;
     wtap_rec rec; /* Record metadata */
     Buffer rec_buf;   /* Record data */
     enum dissect_request_status status;
@@ -4880,17 +5171,58 @@ sharkd_session_process_frame(char *buf, const jsmntok_t *tokens, int count)
 
     req_data.display_hidden = (json_find_attr(buf, tokens, count, "v") != NULL);
 
+    /* Clients re-request recently shown frames with identical parameters
+     * while scrolling; serve those from the serialized response cache.
+     * The cache is cleared by any other method, so nothing can change the
+     * capture state between a store and a hit.  Only the "result" tail is
+     * cached - the id differs per request and is re-emitted here. */
+    cache_key = g_strdup_printf("%u-%u-%u-%x-%d",
+            framenum, ref_frame_num, prev_dis_num, dissect_flags,
+            req_data.display_hidden);
+    cached = (struct sharkd_frame_cache_item *) g_hash_table_lookup(frame_cache, cache_key);
+    if (cached)
+    {
+        cached->last_used = ++frame_cache_age;
+        fprintf(stdout, "{\"jsonrpc\":\"2.0\",\"id\":%d,%s", rpcid, cached->response);
+        fflush(stdout);
+        g_free(cache_key);
+        return;
+    }
+
     wtap_rec_init(&rec);
     ws_buffer_init(&rec_buf, 1514);
 
+    response_str = g_string_new(NULL);
+    dumper.output_string = response_str;
+
     status = sharkd_dissect_request(framenum, ref_frame_num, prev_dis_num,
             &rec, &rec_buf, cinfo, dissect_flags,
             &sharkd_session_process_frame_cb, &req_data, &err, &err_info);
+
+    dumper.output_string = NULL;
+
     switch (status) {
 
         case DISSECT_REQUEST_SUCCESS:
-            /* success */
+        {
+            const char *result = strstr(response_str->str, "\"result\":");
+
+            if (result)
+            {
+                struct sharkd_frame_cache_item *l;
+
+                if (g_hash_table_size(frame_cache) >= SHARKD_FRAME_CACHE_MAX)
+                    sharkd_session_frame_cache_evict_oldest();
+
+                l = g_new(struct sharkd_frame_cache_item, 1);
+                l->response = g_strdup(result);
+                l->last_used = ++frame_cache_age;
+
+                g_hash_table_insert(frame_cache, cache_key, l);
+                cache_key = NULL;
+            }
             break;
+        }
 
         case DISSECT_REQUEST_NO_SUCH_FRAME:
             sharkd_json_error(
@@ -4909,6 +5241,9 @@ sharkd_session_process_frame(char *buf, const jsmntok_t *tokens, int count)
             break;
     }
 
+    g_string_free(response_str, TRUE);
+    g_free(cache_key);
+
     wtap_rec_cleanup(&rec);
     ws_buffer_free(&rec_buf);
 }
@@ -5915,6 +6250,16 @@ sharkd_session_process(char *buf, const jsmntok_t *tokens, int count)
                     "No method found");
             return;
         }
+
+        /* Any method other than "frame" may change what a frame response
+         * would contain (loading, rescanning, comments, preferences, ...),
+         * so cached frame responses only survive runs of "frame" calls. */
+        if (strcmp(tok_method, "frame"))
+            sharkd_session_frame_cache_reset();
+
+        int64_t start_usecs = g_get_monotonic_time();
+        bool known_method = true;
+
         if (!strcmp(tok_method, "load"))
             sharkd_session_process_load(buf, tokens, count);
         else if (!strcmp(tok_method, "status"))
@@ -5945,6 +6290,10 @@ sharkd_session_process(char *buf, const jsmntok_t *tokens, int count)
             sharkd_session_process_setconf(buf, tokens, count);
         else if (!strcmp(tok_method, "dumpconf"))
             sharkd_session_process_dumpconf(buf, tokens, count);
+        else if (!strcmp(tok_method, "dissectortime"))
+            sharkd_session_process_dissectortime(buf, tokens, count);
+        else if (!strcmp(tok_method, "stats"))
+            sharkd_session_process_stats(buf, tokens, count);
         else if (!strcmp(tok_method, "download"))
             sharkd_session_process_download(buf, tokens, count);
         else if (!strcmp(tok_method, "bye"))
@@ -5954,11 +6303,17 @@ sharkd_session_process(char *buf, const jsmntok_t *tokens, int count)
         }
         else
         {
+            known_method = false;
             sharkd_json_error(
                     rpcid, -32601, NULL,
                     "The method \"%s\" is unknown", tok_method
                     );
         }
+
+        /* The method strings are a fixed set, so an unknown (possibly
+         * hostile) method name never becomes a hash table key. */
+        if (known_method)
+            sharkd_method_stats_record(tok_method, g_get_monotonic_time() - start_usecs);
     }
 }
 
@@ -5976,6 +6331,7 @@ sharkd_session_main(int mode_setting)
     dumper.output_file = stdout;
 
     filter_table = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, sharkd_session_filter_free);
+    frame_cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, sharkd_session_frame_cache_free);
 
 #ifdef HAVE_MAXMINDDB
     /* mmdbresolve was stopped before fork(), force starting it */
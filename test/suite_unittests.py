@@ -19,6 +19,10 @@ class TestUnitTests:
         '''exntest'''
         subprocess.check_call(program('exntest'), env=base_env)
 
+    def test_unit_frame_data_sequence_test(self, program, base_env):
+        '''frame_data_sequence_test'''
+        subprocess.check_call(program('frame_data_sequence_test'), env=base_env)
+
     def test_unit_oids_test(self, program, base_env):
         '''oids_test'''
         subprocess.check_call(program('oids_test'), env=base_env)
@@ -1052,7 +1052,7 @@ process_packet_first_pass(capture_file *cf, epan_dissect_t *edt,
          * epan hasn't been initialized.
          */
         if (edt && edt->pi.fd->dependent_frames) {
-            g_hash_table_foreach(edt->pi.fd->dependent_frames, find_and_mark_frame_depended_upon, cf->provider.frames);
+            find_and_mark_frames_depended_upon(cf->provider.frames, edt->pi.fd->dependent_frames);
         }
 
         cf->count++;
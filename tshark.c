@@ -146,6 +146,11 @@
 #define LONGOPT_HEXDUMP                 LONGOPT_BASE_APPLICATION+7
 #define LONGOPT_SELECTED_FRAME          LONGOPT_BASE_APPLICATION+8
 #define LONGOPT_PRINT_TIMERS            LONGOPT_BASE_APPLICATION+9
+#define LONGOPT_SAMPLE_EVERY            LONGOPT_BASE_APPLICATION+10
+#define LONGOPT_PROFILE                 LONGOPT_BASE_APPLICATION+11
+#define LONGOPT_TRACE_STARTUP           LONGOPT_BASE_APPLICATION+12
+#define LONGOPT_SHARD                   LONGOPT_BASE_APPLICATION+13
+#define LONGOPT_PIPELINE                LONGOPT_BASE_APPLICATION+14
 
 capture_file cfile;
 
@@ -270,6 +275,21 @@ static void tshark_cmdarg_err_cont(const char *msg_format, va_list ap);
 
 static GHashTable *output_only_tables;
 
+/* Process only every Nth record of the file (--sample-every); 1 means all. */
+static unsigned sampling_interval = 1;
+
+/* Process only the shard_index'th of shard_count contiguous, equal-count
+ * frame ranges of the file (--shard); 0 means sharding is disabled.
+ * Each shard is handled by an independent tshark process, possibly on
+ * another host; the order-insensitive -z reports are merged afterwards. */
+static unsigned shard_index;
+static unsigned shard_count;
+static uint32_t shard_first_frame;
+static uint32_t shard_last_frame;
+
+/* Overlap file reading and -w writing with dissection (--pipeline). */
+static bool pipeline_enabled;
+
 static bool opt_print_timers;
 struct elapsed_pass_s {
     int64_t dissect;
@@ -286,6 +306,141 @@ static struct {
 }
 tshark_elapsed;
 
+#ifndef _WIN32
+/*
+ * Sampling profiler (--profile). A SIGPROF timer samples the dissection
+ * protocol shadow stack maintained by epan (dissector_profile_snapshot)
+ * and aggregates the samples in a fixed open-addressing table, which is
+ * written out as a collapsed-stack file ("proto;proto;... count" lines)
+ * that flame graph tools consume directly. Everything the signal handler
+ * touches is preallocated; the handler only reads the shadow stack and
+ * increments counters, so it is safe to run against the dissection loop
+ * where external profilers aren't available.
+ */
+
+#include <sys/time.h>
+
+#define PROFILE_INTERVAL_USECS 1000   /* sample at 1 kHz of CPU time */
+#define PROFILE_TABLE_SIZE 16384      /* power of two */
+
+typedef struct {
+    uint32_t count;
+    int32_t  depth;                   /* < 0: slot is empty */
+    int      proto_ids[DISSECTOR_PROFILE_MAX_DEPTH];
+} profile_slot_t;
+
+static char *profile_filename;
+static profile_slot_t *profile_table;
+static uint64_t profile_samples;
+static uint64_t profile_dropped;
+static bool profile_running;
+
+static void
+profile_sigprof_handler(int sig _U_)
+{
+    int proto_ids[DISSECTOR_PROFILE_MAX_DEPTH];
+    int depth = dissector_profile_snapshot(proto_ids, DISSECTOR_PROFILE_MAX_DEPTH);
+    uint32_t hash = 2166136261u;
+
+    for (int i = 0; i < depth; i++)
+        hash = (hash ^ (uint32_t)proto_ids[i]) * 16777619u;
+
+    profile_samples++;
+    for (unsigned probe = 0; probe < PROFILE_TABLE_SIZE; probe++) {
+        profile_slot_t *slot = &profile_table[(hash + probe) % PROFILE_TABLE_SIZE];
+
+        if (slot->depth < 0) {
+            slot->depth = depth;
+            memcpy(slot->proto_ids, proto_ids, depth * sizeof(int));
+            slot->count = 1;
+            return;
+        }
+        if (slot->depth == depth &&
+            memcmp(slot->proto_ids, proto_ids, depth * sizeof(int)) == 0) {
+            slot->count++;
+            return;
+        }
+    }
+    /* Table full; the dump notes how many samples were lost. */
+    profile_dropped++;
+}
+
+static bool
+profile_start(void)
+{
+    struct sigaction sa;
+    struct itimerval timer;
+
+    profile_table = g_new(profile_slot_t, PROFILE_TABLE_SIZE);
+    for (unsigned i = 0; i < PROFILE_TABLE_SIZE; i++)
+        profile_table[i].depth = -1;
+    profile_samples = 0;
+    profile_dropped = 0;
+
+    dissector_profile_set_enabled(true);
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = profile_sigprof_handler;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGPROF, &sa, NULL) == -1) {
+        cmdarg_err("Can't install the SIGPROF handler: %s", g_strerror(errno));
+        return false;
+    }
+
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = PROFILE_INTERVAL_USECS;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, NULL) == -1) {
+        cmdarg_err("Can't start the profiling timer: %s", g_strerror(errno));
+        return false;
+    }
+    profile_running = true;
+    return true;
+}
+
+static void
+profile_stop_and_dump(void)
+{
+    struct itimerval timer;
+    FILE *fp;
+
+    if (!profile_running)
+        return;
+    profile_running = false;
+
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, NULL);
+    signal(SIGPROF, SIG_IGN);
+    dissector_profile_set_enabled(false);
+
+    fp = ws_fopen(profile_filename, "w");
+    if (fp == NULL) {
+        cmdarg_err("Can't open %s for writing", profile_filename);
+        return;
+    }
+    for (unsigned i = 0; i < PROFILE_TABLE_SIZE; i++) {
+        const profile_slot_t *slot = &profile_table[i];
+
+        if (slot->depth < 0)
+            continue;
+        fputs("tshark", fp);
+        for (int32_t j = 0; j < slot->depth; j++) {
+            fprintf(fp, ";%s", slot->proto_ids[j] >= 0 ?
+                proto_get_protocol_filter_name(slot->proto_ids[j]) :
+                "(no protocol)");
+        }
+        fprintf(fp, " %u\n", slot->count);
+    }
+    fclose(fp);
+
+    ws_message("Wrote %" PRIu64 " profile samples to %s (%" PRIu64 " dropped)",
+               profile_samples, profile_filename, profile_dropped);
+    g_free(profile_table);
+    profile_table = NULL;
+}
+#endif /* !_WIN32 */
+
 static void
 print_elapsed_json(const char *cf_name, const char *dfilter)
 {
@@ -481,6 +636,9 @@ print_usage(FILE *output)
     fprintf(output, "Processing:\n");
     fprintf(output, "  -2                       perform a two-pass analysis\n");
     fprintf(output, "  -M <packet count>        perform session auto reset\n");
+    fprintf(output, "  --sample-every <interval>\n");
+    fprintf(output, "                           process only every <interval>th record of the file;\n");
+    fprintf(output, "                           statistics taps scale packet and byte counts back up\n");
     fprintf(output, "  -R <read filter>, --read-filter <read filter>\n");
     fprintf(output, "                           packet Read filter in Wireshark display filter syntax\n");
     fprintf(output, "                           (requires -2)\n");
@@ -909,6 +1067,52 @@ warn_about_capture_filter(const char *rfilter)
 }
 #endif
 
+/* Carve the capture file into shard_count contiguous, equal-count frame
+ * ranges and record the range belonging to shard_index.  Counting the
+ * records needs a pass over the file, but a metadata-only one, so only
+ * the record headers are touched; this is what lets every worker agree
+ * on the shard boundaries without a coordinator shipping an index. */
+static bool
+compute_shard_range(const char *filename)
+{
+    wtap *wth;
+    wtap_rec rec;
+    Buffer buf;
+    int64_t data_offset;
+    uint64_t total = 0;
+    int err = 0;
+    char *err_info = NULL;
+
+    wth = wtap_open_offline(filename, WTAP_TYPE_AUTO, &err, &err_info, false);
+    if (wth == NULL) {
+        cfile_open_failure_message(filename, err, err_info);
+        return false;
+    }
+    wtap_set_read_metadata_only(wth, true);
+
+    wtap_rec_init(&rec);
+    ws_buffer_init(&buf, 1514);
+    while (wtap_read(wth, &rec, &buf, &err, &err_info, &data_offset)) {
+        total++;
+        wtap_rec_reset(&rec);
+    }
+    ws_buffer_free(&buf);
+    wtap_rec_cleanup(&rec);
+    wtap_close(wth);
+
+    if (err != 0) {
+        cfile_read_failure_message(filename, err, err_info);
+        return false;
+    }
+
+    shard_first_frame = (uint32_t)((total * (shard_index - 1)) / shard_count) + 1;
+    shard_last_frame = (uint32_t)((total * shard_index) / shard_count);
+    ws_debug("tshark: shard %u/%u covers records %u to %u of %" PRIu64,
+            shard_index, shard_count, shard_first_frame, shard_last_frame,
+            total);
+    return true;
+}
+
 #ifdef HAVE_LIBPCAP
 static GList *cached_if_list;
 
@@ -978,6 +1182,11 @@ Tb_Main(char filename[1000])
         {"hexdump", ws_required_argument, NULL, LONGOPT_HEXDUMP},
         {"selected-frame", ws_required_argument, NULL, LONGOPT_SELECTED_FRAME},
         {"print-timers", ws_no_argument, NULL, LONGOPT_PRINT_TIMERS},
+        {"sample-every", ws_required_argument, NULL, LONGOPT_SAMPLE_EVERY},
+        {"profile", ws_required_argument, NULL, LONGOPT_PROFILE},
+        {"trace-startup", ws_no_argument, NULL, LONGOPT_TRACE_STARTUP},
+        {"shard", ws_required_argument, NULL, LONGOPT_SHARD},
+        {"pipeline", ws_no_argument, NULL, LONGOPT_PIPELINE},
         {0, 0, 0, 0}
     };
     bool                 arg_error = false;
@@ -1203,6 +1412,11 @@ Tb_Main(char filename[1000])
             case LONGOPT_ELASTIC_MAPPING_FILTER:
                 elastic_mapping_filter = ws_optarg;
                 break;
+            case LONGOPT_TRACE_STARTUP:
+                /* Must be enabled before epan_init() to cover all the
+                 * phases, hence handled in this first pass. */
+                epan_startup_trace_enable();
+                break;
             default:
                 break;
         }
@@ -1378,6 +1592,14 @@ Tb_Main(char filename[1000])
     prefs_p = epan_load_settings();
     prefs_loaded = true;
 
+    /* If --trace-startup was given, all the traced phases are behind us
+     * now; report before any capture or dissection output starts. */
+    char *startup_report = epan_startup_trace_report();
+    if (startup_report != NULL) {
+        fprintf(stderr, "%s", startup_report);
+        g_free(startup_report);
+    }
+
     cap_file_init(&cfile);
 
     /* Print format defaults to this. */
@@ -1893,6 +2115,40 @@ Tb_Main(char filename[1000])
             case LONGOPT_PRINT_TIMERS:
                 opt_print_timers = true;
                 break;
+            case LONGOPT_SAMPLE_EVERY:
+                sampling_interval = get_nonzero_uint32(ws_optarg, "sampling interval");
+                break;
+            case LONGOPT_PROFILE:
+#ifdef _WIN32
+                cmdarg_err("--profile is not supported on Windows");
+                exit_status = WS_EXIT_INVALID_OPTION;
+                goto clean_exit;
+#else
+                g_free(profile_filename);
+                profile_filename = g_strdup(ws_optarg);
+                break;
+#endif
+            case LONGOPT_TRACE_STARTUP:
+                /* Handled in the first getopt_long() pass. */
+                break;
+            case LONGOPT_SHARD:
+            {
+                const char *end;
+
+                if (!ws_strtou32(ws_optarg, &end, &shard_index) ||
+                    *end != '/' ||
+                    !ws_strtou32(end + 1, NULL, &shard_count) ||
+                    shard_index < 1 || shard_count < 1 ||
+                    shard_index > shard_count) {
+                    cmdarg_err("\"%s\" isn't a valid shard; expecting <shard>/<count> with 1 <= shard <= count", ws_optarg);
+                    exit_status = WS_EXIT_INVALID_OPTION;
+                    goto clean_exit;
+                }
+                break;
+            }
+            case LONGOPT_PIPELINE:
+                pipeline_enabled = true;
+                break;
             default:
             case '?':        /* Bad flag - print usage message */
                 switch(ws_optopt) {
@@ -1931,6 +2187,48 @@ Tb_Main(char filename[1000])
         goto clean_exit;
     }
 
+    if (sampling_interval > 1) {
+        if (cf_name == NULL) {
+            cmdarg_err("--sample-every can only be used when reading a capture file.");
+            exit_status = WS_EXIT_INVALID_OPTION;
+            goto clean_exit;
+        }
+        /* Let tap listeners scale additive statistics back up. */
+        set_tap_sampling_interval(sampling_interval);
+    }
+
+    if (shard_count > 0) {
+        if (cf_name == NULL) {
+            cmdarg_err("--shard can only be used when reading a capture file.");
+            exit_status = WS_EXIT_INVALID_OPTION;
+            goto clean_exit;
+        }
+        if (sampling_interval > 1) {
+            cmdarg_err("--shard and --sample-every can't be used together.");
+            exit_status = WS_EXIT_INVALID_OPTION;
+            goto clean_exit;
+        }
+        if (!compute_shard_range(cf_name)) {
+            exit_status = WS_EXIT_OPEN_ERROR;
+            goto clean_exit;
+        }
+    }
+
+    if (pipeline_enabled) {
+        if (cf_name == NULL) {
+            cmdarg_err("--pipeline can only be used when reading a capture file.");
+            exit_status = WS_EXIT_INVALID_OPTION;
+            goto clean_exit;
+        }
+        if (sampling_interval > 1 || shard_count > 0) {
+            /* Both steer the reader with metadata-only reads from the
+             * processing loop, which now runs on a different thread. */
+            cmdarg_err("--pipeline can't be combined with --sample-every or --shard.");
+            exit_status = WS_EXIT_INVALID_OPTION;
+            goto clean_exit;
+        }
+    }
+
     /* If we specified output fields, but not the output field type... */
     /* XXX: If we specfied both output fields with -e *and* protocol filters
      * with -j/-J, only the former are used. Should we warn or abort?
@@ -2490,6 +2788,13 @@ Tb_Main(char filename[1000])
         do_dissection = must_do_dissection(rfcode, dfcode, pdu_export_arg);
         ws_debug("tshark: do_dissection = %s", do_dissection ? "TRUE" : "FALSE");
 
+#ifndef _WIN32
+        if (profile_filename != NULL && !profile_start()) {
+            exit_status = 2;
+            goto clean_exit;
+        }
+#endif
+
         /* Process the packets in the file */
         ws_debug("tshark: invoking process_cap_file() to process the packets");
         TRY {
@@ -2553,6 +2858,10 @@ Tb_Main(char filename[1000])
         }
     } else {
         ws_debug("tshark: no capture file specified");
+#ifndef _WIN32
+        if (profile_filename != NULL)
+            ws_message("Ignoring option --profile because we are doing a live capture");
+#endif
         /* No capture file specified, so we're supposed to do a live capture
            or get a list of link-layer types for a live capture device;
            do we have support for live captures? */
@@ -2763,6 +3072,10 @@ Tb_Main(char filename[1000])
     if (draw_taps)
         draw_tap_listeners(true);
 
+#ifndef _WIN32
+    profile_stop_and_dump();
+#endif
+
     if (tls_session_keys_file) {
         size_t keylist_length;
         char *keylist = ssl_export_sessions(&keylist_length);
@@ -2875,6 +3188,10 @@ Tb_Main(char filename[1000])
 clean_exit:
     cf_close(&cfile);
     g_free(cf_name);
+#ifndef _WIN32
+    g_free(profile_filename);
+    profile_filename = NULL;
+#endif
     destroy_print_stream(print_stream);
     g_free(output_file_name);
 #ifdef HAVE_LIBPCAP
@@ -2905,6 +3222,127 @@ main(int argc, char* argv[])
 bool loop_running;
 uint32_t packet_count;
 
+/*
+ * Pipelined single-pass processing (--pipeline).
+ *
+ * A reader thread runs wtap_read() ahead of dissection through a bounded
+ * pool of record slots, and, when writing with -w, a writer thread runs
+ * wtap_dump() behind it, so file input and output overlap dissection.
+ *
+ * Dissection itself stays on one thread; the invariant that makes the
+ * rest safe is that the wtap handle belongs to the reader thread alone
+ * while the pipeline runs.  The dissection thread therefore serves
+ * interface names from a snapshot of the interface table instead of the
+ * usual cap_file_provider routines, and whenever the reader sees new
+ * IDBs appear mid-file it parks itself until the dissection thread has
+ * refreshed that snapshot (and forwarded the IDBs to the dump file).
+ */
+
+#define PIPELINE_QUEUE_DEPTH 64
+
+typedef struct {
+    wtap_rec  rec;
+    Buffer    buf;
+    int64_t   data_offset;
+    bool      eof;           /* no record; the reader is done, see err */
+    bool      idbs_changed;  /* new IDBs arrived with this record */
+    int       err;
+    char     *err_info;
+} pipeline_item_t;
+
+static GAsyncQueue *pipeline_empty_q;    /* free slots; bounds the read-ahead */
+static GAsyncQueue *pipeline_filled_q;   /* read records, in file order */
+static GAsyncQueue *pipeline_write_q;    /* dissected records awaiting -w */
+
+static GMutex   pipeline_lock;
+static GCond    pipeline_cond;
+static bool     pipeline_barrier_release;    /* reader may continue past new IDBs */
+static unsigned pipeline_write_outstanding;  /* records queued but not yet written */
+static int      pipeline_stop;               /* atomic; tells the threads to quit */
+static int      pipeline_write_err;          /* atomic; the writer hit an error */
+static int      pipeline_write_err_code;
+static char    *pipeline_write_err_info;
+
+/* Interface name/description snapshot served to dissectors in pipeline
+ * mode.  Only ever touched by the dissection thread, and only refreshed
+ * while the reader thread is parked at an IDB barrier. */
+static GPtrArray *pipeline_iface_names;
+static GPtrArray *pipeline_iface_descrs;
+static GArray    *pipeline_shb_iface_base;   /* global id of each section's interface 0 */
+
+static unsigned
+pipeline_interface_count(wtap *wth)
+{
+    wtapng_iface_descriptions_t *idb_info = wtap_file_get_idb_info(wth);
+    unsigned n = idb_info->interface_data->len;
+
+    g_free(idb_info);
+    return n;
+}
+
+static void
+pipeline_snapshot_interfaces(wtap *wth)
+{
+    wtapng_iface_descriptions_t *idb_info = wtap_file_get_idb_info(wth);
+
+    if (pipeline_iface_names == NULL) {
+        pipeline_iface_names = g_ptr_array_new_with_free_func(g_free);
+        pipeline_iface_descrs = g_ptr_array_new_with_free_func(g_free);
+        pipeline_shb_iface_base = g_array_new(FALSE, FALSE, sizeof(unsigned));
+    }
+    g_ptr_array_set_size(pipeline_iface_names, 0);
+    g_ptr_array_set_size(pipeline_iface_descrs, 0);
+    g_array_set_size(pipeline_shb_iface_base, 0);
+
+    for (unsigned i = 0; i < idb_info->interface_data->len; i++) {
+        wtap_block_t idb = g_array_index(idb_info->interface_data, wtap_block_t, i);
+        char *str;
+        char *name = NULL;
+        char *descr = NULL;
+
+        /* Same fallback order as cap_file_provider_get_interface_name(). */
+        if (wtap_block_get_string_option_value(idb, OPT_IDB_NAME, &str) == WTAP_OPTTYPE_SUCCESS)
+            name = g_strdup(str);
+        else if (wtap_block_get_string_option_value(idb, OPT_IDB_DESCRIPTION, &str) == WTAP_OPTTYPE_SUCCESS)
+            name = g_strdup(str);
+        else if (wtap_block_get_string_option_value(idb, OPT_IDB_HARDWARE, &str) == WTAP_OPTTYPE_SUCCESS)
+            name = g_strdup(str);
+        if (wtap_block_get_string_option_value(idb, OPT_IDB_DESCRIPTION, &str) == WTAP_OPTTYPE_SUCCESS)
+            descr = g_strdup(str);
+        g_ptr_array_add(pipeline_iface_names, name);
+        g_ptr_array_add(pipeline_iface_descrs, descr);
+    }
+    g_free(idb_info);
+
+    for (unsigned section = 0; section < wtap_file_get_num_shbs(wth); section++) {
+        unsigned base = wtap_file_get_shb_global_interface_id(wth, section, 0);
+        g_array_append_val(pipeline_shb_iface_base, base);
+    }
+}
+
+static const char *
+pipeline_provider_get_interface_name(struct packet_provider_data *prov _U_,
+        uint32_t interface_id, unsigned section_number)
+{
+    if (pipeline_shb_iface_base != NULL && section_number < pipeline_shb_iface_base->len)
+        interface_id += g_array_index(pipeline_shb_iface_base, unsigned, section_number);
+    if (pipeline_iface_names != NULL && interface_id < pipeline_iface_names->len &&
+        g_ptr_array_index(pipeline_iface_names, interface_id) != NULL)
+        return (const char *)g_ptr_array_index(pipeline_iface_names, interface_id);
+    return "unknown";
+}
+
+static const char *
+pipeline_provider_get_interface_description(struct packet_provider_data *prov _U_,
+        uint32_t interface_id, unsigned section_number)
+{
+    if (pipeline_shb_iface_base != NULL && section_number < pipeline_shb_iface_base->len)
+        interface_id += g_array_index(pipeline_shb_iface_base, unsigned, section_number);
+    if (pipeline_iface_descrs != NULL && interface_id < pipeline_iface_descrs->len)
+        return (const char *)g_ptr_array_index(pipeline_iface_descrs, interface_id);
+    return NULL;
+}
+
 static epan_t *
 tshark_epan_new(capture_file *cf)
 {
@@ -2914,8 +3352,14 @@ tshark_epan_new(capture_file *cf)
         cap_file_provider_get_interface_description,
         NULL,
     };
+    static const struct packet_provider_funcs pipeline_funcs = {
+        cap_file_provider_get_frame_ts,
+        pipeline_provider_get_interface_name,
+        pipeline_provider_get_interface_description,
+        NULL,
+    };
 
-    return epan_new(&cf->provider, &funcs);
+    return epan_new(&cf->provider, pipeline_enabled ? &pipeline_funcs : &funcs);
 }
 
 #ifdef HAVE_LIBPCAP
@@ -3446,8 +3890,10 @@ process_packet_first_pass(capture_file *cf, epan_dissect_t *edt,
         }
 
         elapsed_start = g_get_monotonic_time();
+        /* See process_packet_single_pass: no seek-reads from tvbuffs
+           while the pipeline reader thread owns the wtap handle. */
         epan_dissect_run(edt, cf->cd_t, rec,
-                frame_tvbuff_new_buffer(&cf->provider, &fdlocal, buf),
+                frame_tvbuff_new_buffer(pipeline_enabled ? NULL : &cf->provider, &fdlocal, buf),
                 &fdlocal, cinfo);
         tshark_elapsed.first_pass.dissect += g_get_monotonic_time() - elapsed_start;
 
@@ -3471,8 +3917,12 @@ process_packet_first_pass(capture_file *cf, epan_dissect_t *edt,
          */
         if (edt && cf->dfcode) {
             elapsed_start = g_get_monotonic_time();
-            if (dfilter_apply_edt(cf->dfcode, edt) && edt->pi.fd->dependent_frames) {
-                g_hash_table_foreach(edt->pi.fd->dependent_frames, find_and_mark_frame_depended_upon, cf->provider.frames);
+            bool matched = dfilter_apply_edt(cf->dfcode, edt);
+            /* Remember the verdict so the second pass can skip frames
+             * that are known not to be displayed. */
+            cf->provider.prev_dis->passed_dfilter = matched ? 1 : 0;
+            if (matched && edt->pi.fd->dependent_frames) {
+                find_and_mark_frames_depended_upon(cf->provider.frames, edt->pi.fd->dependent_frames);
             }
 
             if (selected_frame_number != 0 && selected_frame_number == cf->count + 1) {
@@ -3599,6 +4049,32 @@ process_cap_file_first_pass(capture_file *cf, int max_packet_count,
         }
         framenum++;
 
+        if (sampling_interval > 1) {
+            /* Records we're going to sample out don't need their data;
+               request a metadata-only read for the next one if so. */
+            wtap_set_read_metadata_only(cf->provider.wth,
+                    framenum % sampling_interval != 0);
+            if ((framenum - 1) % sampling_interval != 0) {
+                wtap_rec_reset(&rec);
+                continue;
+            }
+        }
+
+        if (shard_count > 0) {
+            if ((uint32_t)framenum > shard_last_frame) {
+                /* The rest of the file belongs to later shards. */
+                break;
+            }
+            /* Records before our shard don't need their data; request
+               a metadata-only read for the next one if so. */
+            wtap_set_read_metadata_only(cf->provider.wth,
+                    (uint32_t)framenum + 1 < shard_first_frame);
+            if ((uint32_t)framenum < shard_first_frame) {
+                wtap_rec_reset(&rec);
+                continue;
+            }
+        }
+
         if (process_packet_first_pass(cf, edt, data_offset, &rec, &buf)) {
             /* Stop reading if we hit a stop condition */
             if (max_packet_count > 0 && framenum >= max_packet_count) {
@@ -3841,12 +4317,35 @@ process_cap_file_second_pass(capture_file *cf, wtap_dumper *pdh,
      */
     set_resolution_synchrony(true);
 
+    /*
+     * If we ran the display filter on the first pass, its verdict for
+     * each frame is cached in the frame_data.  A frame that failed the
+     * filter and isn't depended upon by a displayed frame won't be
+     * printed, written out, or counted, and the state its dissection
+     * would rebuild already exists from the first pass, so we can skip
+     * reading and dissecting it entirely -- but only if no taps are
+     * registered, since tap listeners see every frame.
+     */
+    bool skip_unfiltered = cf->dfcode != NULL && do_dissection &&
+        !have_tap_listeners();
+
     for (framenum = 1; framenum <= (int)cf->count; framenum++) {
         if (read_interrupted) {
             status = PASS_INTERRUPTED;
             break;
         }
         fdata = frame_data_sequence_find(cf->provider.frames, framenum);
+        if (skip_unfiltered && !fdata->passed_dfilter &&
+            !fdata->dependent_of_displayed) {
+            /* Keep the reference frame and capture-order bookkeeping
+             * consistent with what a full dissection would have done. */
+            if (cf->provider.ref == NULL || fdata->ref_time) {
+                ref_frame = *fdata;
+                cf->provider.ref = &ref_frame;
+            }
+            cf->provider.prev_cap = fdata;
+            continue;
+        }
         if (!wtap_seek_read(cf->provider.wth, fdata->file_off, &rec, &buf, err,
                     err_info)) {
             /* Error reading from the input file. */
@@ -3976,6 +4475,32 @@ process_cap_file_single_pass(capture_file *cf, wtap_dumper *pdh,
             break;
         }
 
+        if (sampling_interval > 1) {
+            /* Records we're going to sample out don't need their data;
+               request a metadata-only read for the next one if so. */
+            wtap_set_read_metadata_only(cf->provider.wth,
+                    framenum % sampling_interval != 0);
+            if ((framenum - 1) % sampling_interval != 0) {
+                wtap_rec_reset(&rec);
+                continue;
+            }
+        }
+
+        if (shard_count > 0) {
+            if ((uint32_t)framenum > shard_last_frame) {
+                /* The rest of the file belongs to later shards. */
+                break;
+            }
+            /* Records before our shard don't need their data; request
+               a metadata-only read for the next one if so. */
+            wtap_set_read_metadata_only(cf->provider.wth,
+                    (uint32_t)framenum + 1 < shard_first_frame);
+            if ((uint32_t)framenum < shard_first_frame) {
+                wtap_rec_reset(&rec);
+                continue;
+            }
+        }
+
         ws_debug("tshark: processing packet #%d", framenum);
 
         reset_epan_mem(cf, edt, create_proto_tree, print_packet_info && print_details);
@@ -4040,6 +4565,483 @@ process_cap_file_single_pass(capture_file *cf, wtap_dumper *pdh,
     return status;
 }
 
+/* Reader stage: owns the wtap handle, reads records into free slots and
+ * hands them to the dissection thread in file order.  When new IDBs
+ * appear it parks at a barrier until the dissection thread has adopted
+ * them, so nobody else ever sees the interface table mid-update. */
+static void *
+pipeline_reader_thread(void *arg)
+{
+    capture_file *cf = (capture_file *)arg;
+    wtap *wth = cf->provider.wth;
+    unsigned n_idbs = pipeline_interface_count(wth);
+
+    for (;;) {
+        pipeline_item_t *item = (pipeline_item_t *)g_async_queue_pop(pipeline_empty_q);
+
+        if (g_atomic_int_get(&pipeline_stop)) {
+            g_async_queue_push(pipeline_empty_q, item);
+            break;
+        }
+
+        item->eof = false;
+        item->idbs_changed = false;
+        item->err = 0;
+        item->err_info = NULL;
+        if (!wtap_read(wth, &item->rec, &item->buf, &item->err,
+                       &item->err_info, &item->data_offset)) {
+            /* End of file or a read error; either way we're done. */
+            item->eof = true;
+            g_async_queue_push(pipeline_filled_q, item);
+            break;
+        }
+
+        if (pipeline_interface_count(wth) != n_idbs) {
+            n_idbs = pipeline_interface_count(wth);
+            item->idbs_changed = true;
+            g_mutex_lock(&pipeline_lock);
+            pipeline_barrier_release = false;
+            g_mutex_unlock(&pipeline_lock);
+            g_async_queue_push(pipeline_filled_q, item);
+            /* Park until the dissection thread has refreshed its
+               interface snapshot and forwarded the IDBs to the dump
+               file; until then it may be looking at the interface
+               table, which our next wtap_read() could grow again. */
+            g_mutex_lock(&pipeline_lock);
+            while (!pipeline_barrier_release && !g_atomic_int_get(&pipeline_stop))
+                g_cond_wait(&pipeline_cond, &pipeline_lock);
+            g_mutex_unlock(&pipeline_lock);
+            if (g_atomic_int_get(&pipeline_stop))
+                break;
+        } else {
+            g_async_queue_push(pipeline_filled_q, item);
+        }
+    }
+    return NULL;
+}
+
+/* Writer stage: runs wtap_dump() behind dissection and recycles the
+ * slots.  The first write error is latched; later records are dropped
+ * so the dissection thread can wind down in order. */
+static void *
+pipeline_writer_thread(void *arg)
+{
+    wtap_dumper *pdh = (wtap_dumper *)arg;
+
+    for (;;) {
+        pipeline_item_t *item = (pipeline_item_t *)g_async_queue_pop(pipeline_write_q);
+
+        if (item->eof)      /* sentinel pushed by the dissection thread */
+            break;
+
+        if (!g_atomic_int_get(&pipeline_write_err)) {
+            int err = 0;
+            char *err_info = NULL;
+
+            if (!wtap_dump(pdh, &item->rec, ws_buffer_start_ptr(&item->buf),
+                           &err, &err_info)) {
+                pipeline_write_err_code = err;
+                pipeline_write_err_info = err_info;
+                g_atomic_int_set(&pipeline_write_err, 1);
+            }
+        }
+        wtap_rec_reset(&item->rec);
+        g_async_queue_push(pipeline_empty_q, item);
+
+        g_mutex_lock(&pipeline_lock);
+        pipeline_write_outstanding--;
+        g_cond_broadcast(&pipeline_cond);
+        g_mutex_unlock(&pipeline_lock);
+    }
+    return NULL;
+}
+
+/* Wait until the writer has written everything queued so far, so the
+ * dump side is quiescent before we add IDBs to it. */
+static void
+pipeline_wait_for_writer(void)
+{
+    g_mutex_lock(&pipeline_lock);
+    while (pipeline_write_outstanding > 0)
+        g_cond_wait(&pipeline_cond, &pipeline_lock);
+    g_mutex_unlock(&pipeline_lock);
+}
+
+/* First pass of two-pass analysis with --pipeline: same reader stage as
+ * the single-pass pipeline, no writer stage.  Mirrors
+ * process_cap_file_first_pass; building conversation and reassembly
+ * state stays in frame order on this thread, only the file reading and
+ * decompression run ahead of it. */
+static pass_status_t
+process_cap_file_first_pass_pipelined(capture_file *cf, int max_packet_count,
+        int64_t max_byte_count, int *err, char **err_info)
+{
+    epan_dissect_t *edt = NULL;
+    int             framenum = 0;
+    pass_status_t   status = PASS_SUCCEEDED;
+    GThread        *reader;
+    pipeline_item_t *items;
+
+    /* Allocate a frame_data_sequence for all the frames. */
+    cf->provider.frames = new_frame_data_sequence();
+
+    if (do_dissection) {
+        /* Same proto tree decision as process_cap_file_first_pass. */
+        bool create_proto_tree =
+            (cf->rfcode != NULL || cf->dfcode != NULL || postdissectors_want_hfids() || dissect_color);
+
+        ws_debug("tshark: create_proto_tree = %s", create_proto_tree ? "TRUE" : "FALSE");
+
+        /* We're not going to display the protocol tree on this pass,
+           so it's not going to be "visible". */
+        edt = epan_dissect_new(cf->epan, create_proto_tree, false);
+    }
+
+    /* From here until the reader thread is joined, this thread only
+       looks at its interface snapshot. */
+    pipeline_snapshot_interfaces(cf->provider.wth);
+
+    g_atomic_int_set(&pipeline_stop, 0);
+    pipeline_empty_q = g_async_queue_new();
+    pipeline_filled_q = g_async_queue_new();
+
+    items = g_new0(pipeline_item_t, PIPELINE_QUEUE_DEPTH);
+    for (unsigned i = 0; i < PIPELINE_QUEUE_DEPTH; i++) {
+        wtap_rec_init(&items[i].rec);
+        ws_buffer_init(&items[i].buf, 1514);
+        g_async_queue_push(pipeline_empty_q, &items[i]);
+    }
+
+    reader = g_thread_new("tshark-read", pipeline_reader_thread, cf);
+
+    ws_debug("tshark: reading records for first pass");
+    *err = 0;
+    for (;;) {
+        pipeline_item_t *item = (pipeline_item_t *)g_async_queue_pop(pipeline_filled_q);
+        bool stop = false;
+
+        if (item->eof) {
+            *err = item->err;
+            *err_info = item->err_info;
+            item->err_info = NULL;
+            break;
+        }
+        if (read_interrupted) {
+            status = PASS_INTERRUPTED;
+            g_async_queue_push(pipeline_empty_q, item);
+            break;
+        }
+        framenum++;
+
+        if (item->idbs_changed) {
+            /* The reader is parked; refresh the snapshot, then release it. */
+            pipeline_snapshot_interfaces(cf->provider.wth);
+            g_mutex_lock(&pipeline_lock);
+            pipeline_barrier_release = true;
+            g_cond_broadcast(&pipeline_cond);
+            g_mutex_unlock(&pipeline_lock);
+        }
+
+        if (process_packet_first_pass(cf, edt, item->data_offset, &item->rec,
+                                      &item->buf)) {
+            /* Stop reading if we hit a stop condition */
+            if (max_packet_count > 0 && framenum >= max_packet_count) {
+                ws_debug("tshark: max_packet_count (%d) reached", max_packet_count);
+                stop = true;
+            }
+            if (max_byte_count != 0 && item->data_offset >= max_byte_count) {
+                ws_debug("tshark: max_byte_count (%" PRId64 "/%" PRId64 ") reached",
+                        item->data_offset, max_byte_count);
+                stop = true;
+            }
+        }
+        wtap_rec_reset(&item->rec);
+        g_async_queue_push(pipeline_empty_q, item);
+        if (stop)
+            break;
+    }
+    if (*err != 0)
+        status = PASS_READ_ERROR;
+
+    /* Wind the reader down, as in process_cap_file_pipelined. */
+    g_atomic_int_set(&pipeline_stop, 1);
+    g_mutex_lock(&pipeline_lock);
+    g_cond_broadcast(&pipeline_cond);
+    g_mutex_unlock(&pipeline_lock);
+    for (;;) {
+        pipeline_item_t *item = (pipeline_item_t *)g_async_queue_try_pop(pipeline_filled_q);
+
+        if (item == NULL)
+            break;
+        g_free(item->err_info);
+        item->err_info = NULL;
+        wtap_rec_reset(&item->rec);
+        g_async_queue_push(pipeline_empty_q, item);
+    }
+    g_thread_join(reader);
+
+    for (unsigned i = 0; i < PIPELINE_QUEUE_DEPTH; i++) {
+        g_free(items[i].err_info);
+        ws_buffer_free(&items[i].buf);
+        wtap_rec_cleanup(&items[i].rec);
+    }
+    g_free(items);
+    g_async_queue_unref(pipeline_empty_q);
+    pipeline_empty_q = NULL;
+    g_async_queue_unref(pipeline_filled_q);
+    pipeline_filled_q = NULL;
+
+    if (edt)
+        epan_dissect_free(edt);
+
+    /* Close the sequential I/O side, to free up memory it requires. */
+    wtap_sequential_close(cf->provider.wth);
+
+    /* Allow the protocol dissectors to free up memory that they
+     * don't need after the sequential run-through of the packets. */
+    postseq_cleanup_all_protocols();
+
+    cf->provider.prev_dis = NULL;
+    cf->provider.prev_cap = NULL;
+
+    return status;
+}
+
+/* Single-pass processing with --pipeline: the dissection (middle) stage.
+ * Mirrors process_cap_file_single_pass, with reading and -w writing
+ * delegated to the stage threads. */
+static pass_status_t
+process_cap_file_pipelined(capture_file *cf, wtap_dumper *pdh,
+        int max_packet_count, int64_t max_byte_count,
+        int max_write_packet_count,
+        int *err, char **err_info,
+        volatile uint32_t *err_framenum)
+{
+    bool create_proto_tree = false;
+    bool            filtering_tap_listeners;
+    unsigned        tap_flags;
+    int             framenum = 0;
+    int             write_framenum = 0;
+    epan_dissect_t *edt = NULL;
+    pass_status_t   status = PASS_SUCCEEDED;
+    GThread        *reader;
+    GThread        *writer = NULL;
+    pipeline_item_t *items;
+    static pipeline_item_t writer_sentinel = { .eof = true };
+
+    /* Do we have any tap listeners with filters? */
+    filtering_tap_listeners = have_filtering_tap_listeners();
+
+    /* Get the union of the flags for all tap listeners. */
+    tap_flags = union_of_tap_listener_flags();
+
+    if (do_dissection) {
+        /* Same proto tree decision as process_cap_file_single_pass. */
+        create_proto_tree =
+            (cf->rfcode || cf->dfcode || print_details || filtering_tap_listeners ||
+             (tap_flags & TL_REQUIRES_PROTO_TREE) || postdissectors_want_hfids() ||
+             have_custom_cols(&cf->cinfo) || dissect_color);
+
+        ws_debug("tshark: create_proto_tree = %s", create_proto_tree ? "TRUE" : "FALSE");
+
+        bool visible = print_packet_info && print_details && output_fields_num_fields(output_fields) == 0;
+        edt = epan_dissect_new(cf->epan, create_proto_tree, visible);
+    }
+
+    /*
+     * Force synchronous resolution of IP addresses; we're doing only
+     * one pass, so we can't do it in the background and fix up past
+     * dissections.
+     */
+    set_resolution_synchrony(true);
+
+    /* Adopt the IDBs read at open time before the reader thread takes
+       ownership of the wtap handle; from here until the threads are
+       joined, this thread only looks at its interface snapshot. */
+    if (!process_new_idbs(cf->provider.wth, pdh, err, err_info)) {
+        *err_framenum = 0;
+        if (edt)
+            epan_dissect_free(edt);
+        return PASS_WRITE_ERROR;
+    }
+    pipeline_snapshot_interfaces(cf->provider.wth);
+
+    g_atomic_int_set(&pipeline_stop, 0);
+    g_atomic_int_set(&pipeline_write_err, 0);
+    pipeline_write_outstanding = 0;
+    pipeline_empty_q = g_async_queue_new();
+    pipeline_filled_q = g_async_queue_new();
+    if (pdh != NULL)
+        pipeline_write_q = g_async_queue_new();
+
+    items = g_new0(pipeline_item_t, PIPELINE_QUEUE_DEPTH);
+    for (unsigned i = 0; i < PIPELINE_QUEUE_DEPTH; i++) {
+        wtap_rec_init(&items[i].rec);
+        ws_buffer_init(&items[i].buf, 1514);
+        g_async_queue_push(pipeline_empty_q, &items[i]);
+    }
+
+    reader = g_thread_new("tshark-read", pipeline_reader_thread, cf);
+    if (pdh != NULL)
+        writer = g_thread_new("tshark-write", pipeline_writer_thread, pdh);
+
+    *err = 0;
+    for (;;) {
+        pipeline_item_t *item = (pipeline_item_t *)g_async_queue_pop(pipeline_filled_q);
+        int64_t data_offset;
+
+        if (item->eof) {
+            *err = item->err;
+            *err_info = item->err_info;
+            item->err_info = NULL;
+            break;
+        }
+        if (read_interrupted) {
+            status = PASS_INTERRUPTED;
+            g_async_queue_push(pipeline_empty_q, item);
+            break;
+        }
+        framenum++;
+        data_offset = item->data_offset;
+
+        if (item->idbs_changed) {
+            /* The reader is parked; quiesce the writer, pick up the new
+               IDBs and refresh the snapshot, then release the reader. */
+            if (pdh != NULL)
+                pipeline_wait_for_writer();
+            if (!process_new_idbs(cf->provider.wth, pdh, err, err_info)) {
+                *err_framenum = framenum;
+                status = PASS_WRITE_ERROR;
+                g_async_queue_push(pipeline_empty_q, item);
+                break;
+            }
+            pipeline_snapshot_interfaces(cf->provider.wth);
+            g_mutex_lock(&pipeline_lock);
+            pipeline_barrier_release = true;
+            g_cond_broadcast(&pipeline_cond);
+            g_mutex_unlock(&pipeline_lock);
+        }
+
+        ws_debug("tshark: processing packet #%d", framenum);
+
+        reset_epan_mem(cf, edt, create_proto_tree, print_packet_info && print_details);
+
+        if (process_packet_single_pass(cf, edt, data_offset, &item->rec,
+                                       &item->buf, tap_flags)) {
+            /* Either there's no read filtering or this packet passed the
+               filter, so, if we're writing to a capture file, hand this
+               packet to the writer thread. */
+            write_framenum++;
+            if (pdh != NULL) {
+                ws_debug("tshark: queueing packet #%d for write as #%d",
+                        framenum, write_framenum);
+                g_mutex_lock(&pipeline_lock);
+                pipeline_write_outstanding++;
+                g_mutex_unlock(&pipeline_lock);
+                g_async_queue_push(pipeline_write_q, item);
+                item = NULL;
+            }
+        }
+        if (item != NULL) {
+            wtap_rec_reset(&item->rec);
+            g_async_queue_push(pipeline_empty_q, item);
+        }
+
+        if (g_atomic_int_get(&pipeline_write_err)) {
+            /* Error writing to the output file. */
+            ws_debug("tshark: error writing to a capture file (%d)",
+                    pipeline_write_err_code);
+            *err = pipeline_write_err_code;
+            *err_info = pipeline_write_err_info;
+            pipeline_write_err_info = NULL;
+            *err_framenum = framenum;
+            status = PASS_WRITE_ERROR;
+            break;
+        }
+        /* Stop reading if we hit a stop condition */
+        if (max_packet_count > 0 && framenum >= max_packet_count) {
+            ws_debug("tshark: max_packet_count (%d) reached", max_packet_count);
+            break;
+        }
+        if (max_write_packet_count > 0 && write_framenum >= max_write_packet_count) {
+            ws_debug("tshark: max_write_packet_count (%d) reached", max_write_packet_count);
+            break;
+        }
+        if (max_byte_count != 0 && data_offset >= max_byte_count) {
+            ws_debug("tshark: max_byte_count (%" PRId64 "/%" PRId64 ") reached",
+                    data_offset, max_byte_count);
+            break;
+        }
+    }
+
+    /* Wind the stages down: wake the reader whatever it's blocked on,
+       flush the writer, then join both. */
+    g_atomic_int_set(&pipeline_stop, 1);
+    g_mutex_lock(&pipeline_lock);
+    g_cond_broadcast(&pipeline_cond);
+    g_mutex_unlock(&pipeline_lock);
+
+    if (writer != NULL) {
+        g_async_queue_push(pipeline_write_q, &writer_sentinel);
+        g_thread_join(writer);
+    }
+
+    /* Recycle whatever the reader got ahead with, so a reader blocked
+       waiting for a free slot wakes up and sees the stop flag. */
+    for (;;) {
+        pipeline_item_t *item = (pipeline_item_t *)g_async_queue_try_pop(pipeline_filled_q);
+
+        if (item == NULL)
+            break;
+        g_free(item->err_info);
+        item->err_info = NULL;
+        wtap_rec_reset(&item->rec);
+        g_async_queue_push(pipeline_empty_q, item);
+    }
+    g_thread_join(reader);
+
+    if (status == PASS_SUCCEEDED) {
+        if (*err != 0) {
+            /* Error reading from the input file. */
+            status = PASS_READ_ERROR;
+        } else if (g_atomic_int_get(&pipeline_write_err)) {
+            /* The writer failed on one of the last queued records. */
+            *err = pipeline_write_err_code;
+            *err_info = pipeline_write_err_info;
+            pipeline_write_err_info = NULL;
+            *err_framenum = framenum;
+            status = PASS_WRITE_ERROR;
+        } else {
+            /* Process whatever IDBs we haven't seen yet; the threads
+               are gone, so the wtap and dump handles are ours again. */
+            if (!process_new_idbs(cf->provider.wth, pdh, err, err_info)) {
+                *err_framenum = framenum;
+                status = PASS_WRITE_ERROR;
+            }
+        }
+    }
+
+    if (edt)
+        epan_dissect_free(edt);
+
+    for (unsigned i = 0; i < PIPELINE_QUEUE_DEPTH; i++) {
+        g_free(items[i].err_info);
+        ws_buffer_free(&items[i].buf);
+        wtap_rec_cleanup(&items[i].rec);
+    }
+    g_free(items);
+    g_async_queue_unref(pipeline_empty_q);
+    pipeline_empty_q = NULL;
+    g_async_queue_unref(pipeline_filled_q);
+    pipeline_filled_q = NULL;
+    if (pipeline_write_q != NULL) {
+        g_async_queue_unref(pipeline_write_q);
+        pipeline_write_q = NULL;
+    }
+
+    return status;
+}
+
 static process_file_status_t
 process_cap_file(capture_file *cf, char *save_file, int out_file_type,
         bool out_file_name_res, int max_packet_count, int64_t max_byte_count,
@@ -4135,10 +5137,17 @@ process_cap_file(capture_file *cf, char *save_file, int out_file_type,
         ws_debug("tshark: perform_two_pass_analysis, do_dissection=%s", do_dissection ? "TRUE" : "FALSE");
 
         elapsed_start = g_get_monotonic_time();
-        first_pass_status = process_cap_file_first_pass(cf, max_packet_count,
-                max_byte_count,
-                &err_pass1,
-                &err_info_pass1);
+        if (pipeline_enabled)
+            first_pass_status = process_cap_file_first_pass_pipelined(cf,
+                    max_packet_count,
+                    max_byte_count,
+                    &err_pass1,
+                    &err_info_pass1);
+        else
+            first_pass_status = process_cap_file_first_pass(cf, max_packet_count,
+                    max_byte_count,
+                    &err_pass1,
+                    &err_info_pass1);
         tshark_elapsed.elapsed_first_pass = g_get_monotonic_time() - elapsed_start;
 
         ws_debug("tshark: done with first pass");
@@ -4171,12 +5180,20 @@ process_cap_file(capture_file *cf, char *save_file, int out_file_type,
         first_pass_status = PASS_SUCCEEDED; /* There is no first pass */
 
         elapsed_start = g_get_monotonic_time();
-        second_pass_status = process_cap_file_single_pass(cf, pdh,
-                max_packet_count,
-                max_byte_count,
-                max_write_packet_count,
-                &err, &err_info,
-                &err_framenum);
+        if (pipeline_enabled)
+            second_pass_status = process_cap_file_pipelined(cf, pdh,
+                    max_packet_count,
+                    max_byte_count,
+                    max_write_packet_count,
+                    &err, &err_info,
+                    &err_framenum);
+        else
+            second_pass_status = process_cap_file_single_pass(cf, pdh,
+                    max_packet_count,
+                    max_byte_count,
+                    max_write_packet_count,
+                    &err, &err_info,
+                    &err_framenum);
         tshark_elapsed.elapsed_first_pass = g_get_monotonic_time() - elapsed_start;
 
         ws_debug("tshark: done with single pass");
@@ -4377,8 +5394,15 @@ process_packet_single_pass(capture_file *cf, epan_dissect_t *edt, int64_t offset
            2) we're printing packet info but we're *not* verbose; in verbose
            mode, we print the protocol tree, not the protocol summary.
            or
-           3) there is a column mapped as an individual field */
-        if ((tap_listeners_require_columns()) || (print_packet_info && print_summary) || output_fields_has_cols(output_fields) || dfilter_requires_columns(cf->dfcode))
+           3) there is a column mapped as an individual field
+
+           The inputs to this decision don't change between packets, so
+           make it once; dfilter_requires_columns() walks the filter's
+           field list. */
+        static int need_cols = -1;
+        if (need_cols < 0)
+            need_cols = (tap_listeners_require_columns() || (print_packet_info && print_summary) || output_fields_has_cols(output_fields) || dfilter_requires_columns(cf->dfcode));
+        if (need_cols)
             cinfo = &cf->cinfo;
         else
             cinfo = NULL;
@@ -4398,10 +5422,24 @@ process_packet_single_pass(capture_file *cf, epan_dissect_t *edt, int64_t offset
         /* epan_dissect_run (and epan_dissect_reset) unref the block.
          * We need it later, e.g. in order to copy the options. */
         block = wtap_block_ref(rec->block);
+        /* In pipeline mode the reader thread owns the wtap handle, so
+           the tvbuff must not be able to seek-read from it; without a
+           provider, cloned tvbuffs copy their data instead. */
+        const struct packet_provider_data *tvb_prov =
+            pipeline_enabled ? NULL : &cf->provider;
         elapsed_start = g_get_monotonic_time();
-        epan_dissect_run_with_taps(edt, cf->cd_t, rec,
-                frame_tvbuff_new_buffer(&cf->provider, &fdata, buf),
-                &fdata, cinfo);
+        if (have_tap_listeners()) {
+            epan_dissect_run_with_taps(edt, cf->cd_t, rec,
+                    frame_tvbuff_new_buffer(tvb_prov, &fdata, buf),
+                    &fdata, cinfo);
+        } else {
+            /* No tap listeners, so don't pay for the tap queue on
+             * every packet; on a live filtered capture this loop is
+             * the bottleneck. */
+            epan_dissect_run(edt, cf->cd_t, rec,
+                    frame_tvbuff_new_buffer(tvb_prov, &fdata, buf),
+                    &fdata, cinfo);
+        }
         tshark_elapsed.first_pass.dissect += g_get_monotonic_time() - elapsed_start;
 
         /* Run the filter if we have it. */
@@ -520,6 +520,16 @@ capture_info_new_packets(int to_read, wtap *wth, info_data_t* cap_info)
                 to_read--;
             }
             wtap_rec_reset(&rec);
+        } else {
+            /* EOF or a read error.  Don't spin retrying here in the UI
+               thread; any records we haven't seen yet will be picked up
+               on the next batch, as our file position persists. */
+            if (err != 0) {
+                ws_warning("capture_info_new_packets: %d (%s)", err,
+                           err_info != NULL ? err_info : "no information");
+                g_free(err_info);
+            }
+            break;
         }
     }
     wtap_rec_cleanup(&rec);
@@ -528,7 +538,29 @@ capture_info_new_packets(int to_read, wtap *wth, info_data_t* cap_info)
     capture_info_ui_update(&cap_info->ui);
 }
 
-/* capture child tells us we have new packets to read */
+/* capture child tells us we have new packets to read
+ *
+ * Note that packet records never cross the sync pipe: dumpcap writes
+ * them to the capture file and the pipe only carries control messages,
+ * with SP_PACKET_COUNT throttled to the update interval rather than
+ * sent per packet.  We tail-read the records from the capture file
+ * through wiretap's buffered I/O, so freshly written records are
+ * normally served from the OS page cache - the page cache is, in
+ * effect, the shared memory between dumpcap and us.  A dedicated
+ * shared-memory ring wouldn't remove a copy that matters; the
+ * per-batch cost here is dissection, not the file read.
+ */
+
+/* How many records to hand to cf_continue_tail at a time, and how long
+ * we let one sync pipe message keep the main loop busy dissecting.
+ * Dissection has to run on this thread - it shares the epan state the
+ * rest of the UI reads - so the way to keep the UI responsive under a
+ * burst is to stop after the budget and let the leftovers catch up on
+ * the next message, lagging the tail of the packet list a little
+ * instead of freezing the whole window. */
+#define CAPTURE_READ_SLICE          256
+#define CAPTURE_READ_BUDGET_USECS   (100 * 1000)
+
 static void
 capture_input_new_packets(capture_session *cap_session, int to_read)
 {
@@ -553,11 +585,31 @@ capture_input_new_packets(capture_session *cap_session, int to_read)
             capture_callback_invoke(capture_cb_capture_update_started, cap_session);
         }
         /* Read from the capture file the number of records the child told us it added. */
-        to_read += cap_session->count_pending;
+        int remaining = to_read + (int)cap_session->count_pending;
         cap_session->count_pending = 0;
-        switch (cf_continue_tail((capture_file *)cap_session->cf, to_read,
-                                 &cap_session->rec, &cap_session->buf, &err,
-                                 &cap_session->frame_dup_cache, cap_session->frame_cksum)) {
+
+        /* Dissect the batch in slices so we can stop when the budget
+           runs out; whatever is left goes back to count_pending and is
+           read the next time the child checks in. */
+        int64_t batch_start = g_get_monotonic_time();
+        cf_read_status_t status = CF_READ_OK;
+
+        while (remaining > 0 && status == CF_READ_OK) {
+            int slice = MIN(remaining, CAPTURE_READ_SLICE);
+
+            status = cf_continue_tail((capture_file *)cap_session->cf, slice,
+                                      &cap_session->rec, &cap_session->buf, &err,
+                                      &cap_session->frame_dup_cache, cap_session->frame_cksum);
+            remaining -= slice;
+            if (g_get_monotonic_time() - batch_start > CAPTURE_READ_BUDGET_USECS)
+                break;
+        }
+        if (remaining > 0 && status == CF_READ_OK) {
+            /* Out of budget; catch up on the next message. */
+            cap_session->count_pending = remaining;
+        }
+
+        switch (status) {
 
             case CF_READ_OK:
             case CF_READ_ERROR:
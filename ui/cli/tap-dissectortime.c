@@ -0,0 +1,110 @@
+/* tap-dissectortime.c
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+/* This module reports per-dissector time attribution for tshark.
+ * It enables the timing collection in epan's call_dissector_work() and
+ * prints inclusive/exclusive time and call counts per protocol at the
+ * end of the run, so dissection time regressions can be attributed to
+ * a protocol without disabling dissectors one at a time.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <epan/packet.h>
+#include <epan/proto.h>
+#include <epan/tap.h>
+#include <epan/stat_tap_ui.h>
+
+#include <wsutil/cmdarg_err.h>
+
+void register_tap_listener_dissectortime(void);
+
+/* Unique address to register the listener with. */
+static int dissectortime_tap_data;
+
+static void
+dissectortime_draw(void *arg _U_)
+{
+	GArray *timings = dissector_timing_get();
+
+	printf("\n");
+	printf("===================================================================\n");
+	printf("Dissector Time\n");
+	printf("Protocol                        Calls    Excl (ms)    Incl (ms)\n");
+	for (unsigned i = 0; i < timings->len; i++) {
+		const dissector_timing_t *timing =
+		    &g_array_index(timings, dissector_timing_t, i);
+		const char *name = timing->proto_id >= 0 ?
+		    proto_get_protocol_filter_name(timing->proto_id) :
+		    "(no protocol)";
+
+		printf("%-26s %10" PRIu64 " %12.3f %12.3f\n",
+		    name, timing->calls,
+		    timing->excl_usecs / 1000.0,
+		    timing->incl_usecs / 1000.0);
+	}
+	printf("===================================================================\n");
+	g_array_free(timings, true);
+}
+
+static void
+dissectortime_init(const char *opt_arg, void *userdata _U_)
+{
+	GString *error_string;
+
+	if (strcmp("dissector,time", opt_arg) != 0) {
+		cmdarg_err("invalid \"-z dissector,time\" argument");
+		exit(1);
+	}
+
+	dissector_timing_set_enabled(true);
+	dissector_timing_reset();
+
+	error_string = register_tap_listener("frame", &dissectortime_tap_data,
+	    NULL, 0, NULL, NULL, dissectortime_draw, NULL);
+	if (error_string) {
+		/* error, we failed to attach to the tap. clean up */
+		cmdarg_err("Couldn't register dissector,time tap: %s",
+			error_string->str);
+		g_string_free(error_string, TRUE);
+		exit(1);
+	}
+}
+
+static stat_tap_ui dissectortime_ui = {
+	REGISTER_STAT_GROUP_GENERIC,
+	NULL,
+	"dissector,time",
+	dissectortime_init,
+	0,
+	NULL
+};
+
+void
+register_tap_listener_dissectortime(void)
+{
+	register_stat_tap_ui(&dissectortime_ui, NULL);
+}
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 8
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * End:
+ *
+ * vi: set shiftwidth=8 tabstop=8 noexpandtab:
+ * :indentSize=8:tabSize=8:noTabs=false:
+ */
@@ -29,6 +29,10 @@
 typedef struct _export_object_list_gui_t {
     GSList *entries;
     register_eo_t* eo;
+    /* Entries from "final" handlers are written as they arrive instead
+     * of being held for the whole run; see register_export_object_final(). */
+    bool streaming;
+    bool output_dir_ok;
 } export_object_list_gui_t;
 
 static GHashTable* eo_opts;
@@ -82,11 +86,72 @@ bool eo_tap_opt_add(const char *option_string)
     return false;
 }
 
+/* Make sure the destination directory for this protocol's objects exists,
+   creating it (and its parents) if necessary. */
+static bool
+eo_ensure_output_dir(export_object_list_gui_t *object_list, const char *save_in_path)
+{
+    if (object_list->output_dir_ok)
+        return true;
+
+    if (!g_file_test(save_in_path, G_FILE_TEST_IS_DIR)) {
+        if (g_mkdir_with_parents(save_in_path, 0755) == -1) {
+            fprintf(stderr, "Failed to create export objects output directory \"%s\": %s\n",
+                    save_in_path, g_strerror(errno));
+            return false;
+        }
+    }
+
+    object_list->output_dir_ok = true;
+    return true;
+}
+
+/* Write one object under a collision-free name in the destination directory. */
+static void
+eo_write_entry(const char *save_in_path, export_object_entry_t *entry)
+{
+    GString *safe_filename = NULL;
+    char *save_as_fullpath = NULL;
+    unsigned count = 0;
+
+    do {
+        g_free(save_as_fullpath);
+        if (entry->filename) {
+            safe_filename = eo_massage_str(entry->filename,
+                EXPORT_OBJECT_MAXFILELEN, count);
+        } else {
+            char generic_name[EXPORT_OBJECT_MAXFILELEN+1];
+            const char *ext;
+            ext = eo_ct2ext(entry->content_type);
+            snprintf(generic_name, sizeof(generic_name),
+                "object%u%s%s", entry->pkt_num, ext ? "." : "", ext ? ext : "");
+            safe_filename = eo_massage_str(generic_name,
+                EXPORT_OBJECT_MAXFILELEN, count);
+        }
+        save_as_fullpath = g_build_filename(save_in_path, safe_filename->str, NULL);
+        g_string_free(safe_filename, TRUE);
+    } while (g_file_test(save_as_fullpath, G_FILE_TEST_EXISTS) && ++count < prefs.gui_max_export_objects);
+    write_file_binary_mode(save_as_fullpath, entry->payload_data, entry->payload_len);
+    g_free(save_as_fullpath);
+}
+
 static void
 object_list_add_entry(void *gui_data, export_object_entry_t *entry)
 {
     export_object_list_gui_t *object_list = (export_object_list_gui_t*)gui_data;
 
+    if (object_list->streaming) {
+        /* The handler guarantees this entry is complete; write it out now
+         * and release it instead of accumulating the whole capture's worth
+         * of objects in memory. */
+        char* save_in_path = (char*)g_hash_table_lookup(eo_opts, proto_get_protocol_filter_name(get_eo_proto_id(object_list->eo)));
+
+        if (eo_ensure_output_dir(object_list, save_in_path))
+            eo_write_entry(save_in_path, entry);
+        eo_free_entry(entry);
+        return;
+    }
+
     object_list->entries = g_slist_append(object_list->entries, entry);
 }
 
@@ -104,44 +169,17 @@ eo_draw(void *tapdata)
     export_object_list_t *tap_object = (export_object_list_t *)tapdata;
     export_object_list_gui_t *object_list = (export_object_list_gui_t*)tap_object->gui_data;
     GSList *slist = object_list->entries;
-    export_object_entry_t *entry;
     char* save_in_path = (char*)g_hash_table_lookup(eo_opts, proto_get_protocol_filter_name(get_eo_proto_id(object_list->eo)));
-    GString *safe_filename = NULL;
-    char *save_as_fullpath = NULL;
-    unsigned count = 0;
 
-    if (!g_file_test(save_in_path, G_FILE_TEST_IS_DIR)) {
-        /* If the destination directory (or its parents) do not exist, create them. */
-        if (g_mkdir_with_parents(save_in_path, 0755) == -1) {
-            fprintf(stderr, "Failed to create export objects output directory \"%s\": %s\n",
-                    save_in_path, g_strerror(errno));
-            return;
-        }
-    }
+    /* Streaming handlers have already written everything as it arrived. */
+    if (object_list->streaming)
+        return;
+
+    if (!eo_ensure_output_dir(object_list, save_in_path))
+        return;
 
     while (slist) {
-        entry = (export_object_entry_t *)slist->data;
-        do {
-            g_free(save_as_fullpath);
-            if (entry->filename) {
-                safe_filename = eo_massage_str(entry->filename,
-                    EXPORT_OBJECT_MAXFILELEN, count);
-            } else {
-                char generic_name[EXPORT_OBJECT_MAXFILELEN+1];
-                const char *ext;
-                ext = eo_ct2ext(entry->content_type);
-                snprintf(generic_name, sizeof(generic_name),
-                    "object%u%s%s", entry->pkt_num, ext ? "." : "", ext ? ext : "");
-                safe_filename = eo_massage_str(generic_name,
-                    EXPORT_OBJECT_MAXFILELEN, count);
-            }
-            save_as_fullpath = g_build_filename(save_in_path, safe_filename->str, NULL);
-            g_string_free(safe_filename, TRUE);
-        } while (g_file_test(save_as_fullpath, G_FILE_TEST_EXISTS) && ++count < prefs.gui_max_export_objects);
-        count = 0;
-        write_file_binary_mode(save_as_fullpath, entry->payload_data, entry->payload_len);
-        g_free(save_as_fullpath);
-        save_as_fullpath = NULL;
+        eo_write_entry(save_in_path, (export_object_entry_t *)slist->data);
         slist = slist->next;
     }
 }
@@ -169,6 +207,7 @@ exportobject_handler(void *key, void *value _U_, void *user_data _U_)
     tap_data->gui_data = (void*)object_list;
 
     object_list->eo = eo;
+    object_list->streaming = get_eo_entries_final(eo);
 
     /* Data will be gathered via a tap callback */
     error_msg = register_tap_listener(get_eo_tap_listener_name(eo), tap_data, NULL, 0,
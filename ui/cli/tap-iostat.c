@@ -559,6 +559,7 @@ iostat_draw(void *arg)
         maxfltr_w, ftype;
     unsigned int fr_mag;    /* The magnitude of the max frame number in this column */
     unsigned int val_mag;   /* The magnitude of the max value in this column */
+    unsigned int sample_scale = get_tap_sampling_interval(); /* Scale counts when sampling */
     char *spaces, *spaces_s, *filler_s = NULL, **fmts, *fmt = NULL;
     const char *filter;
     static char dur_mag_s[3], invl_prec_s[3], fr_mag_s[3], val_mag_s[3], *invl_fmt, *full_fmt;
@@ -673,7 +674,7 @@ iostat_draw(void *arg)
         if (type == CALC_TYPE_FRAMES
          || type == CALC_TYPE_FRAMES_AND_BYTES) {
 
-            fr_mag = magnitude(iot->max_frame[j], 15);
+            fr_mag = magnitude((uint64_t)iot->max_frame[j] * sample_scale, 15);
             fr_mag = MAX(6, fr_mag);
             col_w[j].fr = fr_mag;
             tabrow_w += col_w[j].fr + 3;
@@ -684,7 +685,7 @@ iostat_draw(void *arg)
             } else {
                 /* CALC_TYPE_FRAMES_AND_BYTES
                 */
-                val_mag = magnitude(iot->max_vals[j], 15);
+                val_mag = magnitude(iot->max_vals[j] * sample_scale, 15);
                 val_mag = MAX(5, val_mag);
                 col_w[j].val = val_mag;
                 tabrow_w += (col_w[j].val + 3);
@@ -699,7 +700,8 @@ iostat_draw(void *arg)
         case CALC_TYPE_BYTES:
         case CALC_TYPE_COUNT:
 
-            val_mag = magnitude(iot->max_vals[j], 15);
+            val_mag = magnitude(type == CALC_TYPE_BYTES ?
+                iot->max_vals[j] * sample_scale : iot->max_vals[j], 15);
             val_mag = MAX(5, val_mag);
             col_w[j].val = val_mag;
             snprintf(val_mag_s, 3, "%u", val_mag);
@@ -1114,14 +1116,16 @@ iostat_draw(void *arg)
             if (item) {
                 switch (type) {
                 case CALC_TYPE_FRAMES:
-                    printf(fmt, item->frames);
+                    printf(fmt, item->frames * sample_scale);
                     break;
                 case CALC_TYPE_BYTES:
+                    printf(fmt, item->counter * sample_scale);
+                    break;
                 case CALC_TYPE_COUNT:
                     printf(fmt, item->counter);
                     break;
                 case CALC_TYPE_FRAMES_AND_BYTES:
-                    printf(fmt, item->frames, item->counter);
+                    printf(fmt, item->frames * sample_scale, item->counter * sample_scale);
                     break;
 
                 case CALC_TYPE_SUM:
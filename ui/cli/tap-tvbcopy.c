@@ -0,0 +1,115 @@
+/* tap-tvbcopy.c
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+/* This module reports tvbuff copy accounting for tshark.
+ * It enables the copy counters in epan/tvbuff.c and prints, per
+ * protocol, how many times dissectors materialized tvbuff data
+ * (memdup, string extraction, composite flattening) and how many bytes
+ * were copied, so the heaviest copiers can be found without a heap
+ * profiler.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <epan/packet.h>
+#include <epan/proto.h>
+#include <epan/tap.h>
+#include <epan/tvbuff.h>
+#include <epan/stat_tap_ui.h>
+
+#include <wsutil/cmdarg_err.h>
+
+void register_tap_listener_tvbcopy(void);
+
+/* Unique address to register the listener with. */
+static int tvbcopy_tap_data;
+
+static void
+tvbcopy_draw(void *arg _U_)
+{
+	GArray *stats = tvb_copy_stats_get();
+
+	printf("\n");
+	printf("===========================================================================================\n");
+	printf("tvbuff Copies\n");
+	printf("Protocol                      Memdup        Bytes      Strings        Bytes    Composite        Bytes\n");
+	for (unsigned i = 0; i < stats->len; i++) {
+		const tvb_copy_stat_t *stat =
+		    &g_array_index(stats, tvb_copy_stat_t, i);
+		const char *name = stat->proto_id >= 0 ?
+		    proto_get_protocol_filter_name(stat->proto_id) :
+		    "(no protocol)";
+
+		printf("%-24s %11" PRIu64 " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 "\n",
+		    name,
+		    stat->calls[TVB_COPY_MEMDUP], stat->bytes[TVB_COPY_MEMDUP],
+		    stat->calls[TVB_COPY_STRING], stat->bytes[TVB_COPY_STRING],
+		    stat->calls[TVB_COPY_COMPOSITE], stat->bytes[TVB_COPY_COMPOSITE]);
+	}
+	printf("===========================================================================================\n");
+	g_array_free(stats, true);
+}
+
+static void
+tvbcopy_init(const char *opt_arg, void *userdata _U_)
+{
+	GString *error_string;
+
+	if (strcmp("tvb,copy", opt_arg) != 0) {
+		cmdarg_err("invalid \"-z tvb,copy\" argument");
+		exit(1);
+	}
+
+	/* Attribution relies on the dissector shadow stack. */
+	dissector_profile_set_enabled(true);
+	tvb_copy_stats_set_enabled(true);
+	tvb_copy_stats_reset();
+
+	error_string = register_tap_listener("frame", &tvbcopy_tap_data,
+	    NULL, 0, NULL, NULL, tvbcopy_draw, NULL);
+	if (error_string) {
+		/* error, we failed to attach to the tap. clean up */
+		cmdarg_err("Couldn't register tvb,copy tap: %s",
+			error_string->str);
+		g_string_free(error_string, TRUE);
+		exit(1);
+	}
+}
+
+static stat_tap_ui tvbcopy_ui = {
+	REGISTER_STAT_GROUP_GENERIC,
+	NULL,
+	"tvb,copy",
+	tvbcopy_init,
+	0,
+	NULL
+};
+
+void
+register_tap_listener_tvbcopy(void)
+{
+	register_stat_tap_ui(&tvbcopy_ui, NULL);
+}
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 8
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * End:
+ *
+ * vi: set shiftwidth=8 tabstop=8 noexpandtab:
+ * :indentSize=8:tabSize=8:noTabs=false:
+ */
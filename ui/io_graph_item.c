@@ -136,6 +136,110 @@ GString *check_field_unit(const char *field_name, int *hf_index, io_graph_item_u
     return err_str;
 }
 
+/* Merge the counters of one interval item into another, so that the result
+ * is what a single tap pass over both intervals would have produced. Which
+ * union members are live depends on the field type, as in
+ * update_io_graph_item(). */
+static void
+merge_io_graph_item(io_graph_item_t *dst, const io_graph_item_t *src, int adv_type)
+{
+    if (src->first_frame_in_invl != 0) {
+        if (dst->first_frame_in_invl == 0) {
+            dst->first_frame_in_invl = src->first_frame_in_invl;
+        }
+        dst->last_frame_in_invl = src->last_frame_in_invl;
+    }
+    dst->frames += src->frames;
+    dst->bytes  += src->bytes;
+
+    if (src->fields) {
+        switch (adv_type) {
+        case FT_INT8:
+        case FT_INT16:
+        case FT_INT24:
+        case FT_INT32:
+        case FT_INT40:
+        case FT_INT48:
+        case FT_INT56:
+        case FT_INT64:
+            if (dst->fields == 0 || src->int_max > dst->int_max) {
+                dst->int_max = src->int_max;
+                dst->max_frame_in_invl = src->max_frame_in_invl;
+            }
+            if (dst->fields == 0 || src->int_min < dst->int_min) {
+                dst->int_min = src->int_min;
+                dst->min_frame_in_invl = src->min_frame_in_invl;
+            }
+            dst->double_tot += src->double_tot;
+            break;
+        case FT_UINT8:
+        case FT_UINT16:
+        case FT_UINT24:
+        case FT_UINT32:
+        case FT_UINT40:
+        case FT_UINT48:
+        case FT_UINT56:
+        case FT_UINT64:
+            if (dst->fields == 0 || src->uint_max > dst->uint_max) {
+                dst->uint_max = src->uint_max;
+                dst->max_frame_in_invl = src->max_frame_in_invl;
+            }
+            if (dst->fields == 0 || src->uint_min < dst->uint_min) {
+                dst->uint_min = src->uint_min;
+                dst->min_frame_in_invl = src->min_frame_in_invl;
+            }
+            dst->double_tot += src->double_tot;
+            break;
+        case FT_FLOAT:
+        case FT_DOUBLE:
+            if (dst->fields == 0 || src->double_max > dst->double_max) {
+                dst->double_max = src->double_max;
+                dst->max_frame_in_invl = src->max_frame_in_invl;
+            }
+            if (dst->fields == 0 || src->double_min < dst->double_min) {
+                dst->double_min = src->double_min;
+                dst->min_frame_in_invl = src->min_frame_in_invl;
+            }
+            dst->double_tot += src->double_tot;
+            break;
+        case FT_RELATIVE_TIME:
+            if (dst->fields == 0 || nstime_cmp(&src->time_max, &dst->time_max) > 0) {
+                dst->time_max = src->time_max;
+                dst->max_frame_in_invl = src->max_frame_in_invl;
+            }
+            if (dst->fields == 0 || nstime_cmp(&src->time_min, &dst->time_min) < 0) {
+                dst->time_min = src->time_min;
+                dst->min_frame_in_invl = src->min_frame_in_invl;
+            }
+            nstime_add(&dst->time_tot, &src->time_tot);
+            break;
+        default:
+            /* Field only counted, not summed or compared. */
+            break;
+        }
+        dst->fields += src->fields;
+    }
+}
+
+int
+rebucket_io_graph_items(io_graph_item_t *items, int cur_idx, int factor, int hf_index)
+{
+    int adv_type = (hf_index < 0) ? -1 : proto_registrar_get_ftype(hf_index);
+    int new_cur_idx = cur_idx / factor;
+
+    for (int k = 0; k <= new_cur_idx; k++) {
+        io_graph_item_t merged = items[k * factor];
+
+        for (int i = 1; i < factor && (k * factor) + i <= cur_idx; i++) {
+            merge_io_graph_item(&merged, &items[(k * factor) + i], adv_type);
+        }
+        items[k] = merged;
+    }
+    reset_io_graph_items(&items[new_cur_idx + 1], cur_idx - new_cur_idx, hf_index);
+
+    return new_cur_idx;
+}
+
 // Adapted from get_it_value in gtk/io_stat.c.
 double get_io_graph_item(const io_graph_item_t *items_, io_graph_item_unit_t val_units_, int idx, int hf_index_, const capture_file *cap_file, int interval_, int cur_idx_)
 {
@@ -192,6 +192,21 @@ GString *check_field_unit(const char *field_name, int *hf_index, io_graph_item_u
  */
 double get_io_graph_item(const io_graph_item_t *items, io_graph_item_unit_t val_units, int idx, int hf_index, const capture_file *cap_file, int interval, int cur_idx);
 
+/** Merge items in place so they cover a coarser interval.
+ *
+ * Combines each run of factor consecutive items into one, producing the
+ * same counters a tap pass at the coarser interval would have, and zeroes
+ * the items left unused at the tail. Only valid when the new interval is
+ * an exact integer multiple of the interval the items were collected at.
+ *
+ * @param items [in,out] Array containing the items to merge.
+ * @param cur_idx [in] Index of the last item in use.
+ * @param factor [in] Ratio of the new interval to the old one. Must be >= 1.
+ * @param hf_index [in] Header field index for advanced statistics.
+ * @return The index of the last item in use after merging.
+ */
+int rebucket_io_graph_items(io_graph_item_t *items, int cur_idx, int factor, int hf_index);
+
 /** Update the values of an io_graph_item_t.
  *
  * Frame and byte counts are always calculated. If edt is non-NULL advanced
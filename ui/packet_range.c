@@ -27,12 +27,11 @@ static void
 depended_frames_add(GHashTable* depended_table, frame_data_sequence *frames, frame_data *frame)
 {
     if (g_hash_table_add(depended_table, GUINT_TO_POINTER(frame->num)) && frame->dependent_frames) {
-        GHashTableIter iter;
-        void *key;
+        unsigned i;
         frame_data *depended_fd;
-        g_hash_table_iter_init(&iter, frame->dependent_frames);
-        while (g_hash_table_iter_next(&iter, &key, NULL)) {
-            depended_fd = frame_data_sequence_find(frames, GPOINTER_TO_UINT(key));
+        for (i = 0; i < frame->dependent_frames->len; i++) {
+            depended_fd = frame_data_sequence_find(frames,
+                g_array_index(frame->dependent_frames, uint32_t, i));
             depended_frames_add(depended_table, frames, depended_fd);
         }
     }
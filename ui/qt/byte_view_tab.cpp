@@ -83,12 +83,7 @@ void ByteViewTab::captureActive(int cap)
     }
 }
 
-void ByteViewTab::addTab(const char *name, tvbuff_t *tvb) {
-    if (count() == 1) { // Remove empty placeholder.
-        ByteViewText *cur_text = qobject_cast<ByteViewText *>(currentWidget());
-        if (cur_text && cur_text->isEmpty()) delete currentWidget();
-    }
-
+void ByteViewTab::setTabData(int idx, const char *name, tvbuff_t *tvb) {
     packet_char_enc encoding = PACKET_CHAR_ENC_CHAR_ASCII;
     if (cap_file_ && cap_file_->current_frame)
         encoding = (packet_char_enc)cap_file_->current_frame->encoding;
@@ -104,48 +99,61 @@ void ByteViewTab::addTab(const char *name, tvbuff_t *tvb) {
         }
     }
 
-    ByteViewText * byte_view_text = new ByteViewText(data, encoding, this);
-    byte_view_text->setAccessibleName(name);
-    byte_view_text->setMonospaceFont(mainApp->monospaceFont(true));
-
-    if (tvb)
-    {
-        // There are some secondary data source tvbuffs whose datais not freed
-        // when the epan_dissect_t is freed, but at some other point expected
-        // to outlive the packet, generally when the capture file is closed.
-        // If this is a PacketDialog, it can break that assumption.
-        // To get around this, we deep copy their data when the file is closed.
-        //
-        // XXX: We could add a function to the tvbuff API and only do this if
-        // there is no free_cb (a free_cb implies the data is freed at the
-        // same time as the tvb, i.e. when leaving the packet.)
-        if (is_fixed_packet_ && count() > 0) {
-            connect(this, &ByteViewTab::detachData, byte_view_text, &ByteViewText::detachData);
-        }
-        // See above - this tvb is (expected to be) scoped to the packet, but
-        // the real data is not necessarily so. If this is a PacketDialog
-        // and such a secondary data source, then we MUST NOT use any tvb
-        // function that accesses the real data after the capture file closes.
-        // That includes via the ds_tvb item of a field_info in the tree.
-        // proto_find_field_from_offset() is OK. See #14363.
-        //
-        // XXX: It sounds appealing to clone the secondary data source tvbs
-        // and set them to be freed when the byte_view_text is freed, perhaps
-        // even doing so only when the capture file is closing. However, while
-        // relatively simple for the few number of secondary data sources, it
-        // would be a pain to change the pointers for every field_info.
+    ByteViewText * byte_view_text = qobject_cast<ByteViewText *>(widget(idx));
+    if (byte_view_text) {
+        // Reuse the widget from the previously selected packet. Tearing
+        // down and rebuilding the widgets, their context menus and their
+        // connections is the main per-selection cost when walking the
+        // packet list with the keyboard.
+        byte_view_text->setData(data, encoding);
+        byte_view_text->setAccessibleName(name);
         byte_view_text->setProperty(tvb_data_property, VariantPointer<tvbuff_t>::asQVariant(tvb));
+        setTabText(idx, name);
+        setTabToolTip(idx, name);
+        return;
+    }
 
-        connect(mainApp, SIGNAL(zoomMonospaceFont(QFont)), byte_view_text, SLOT(setMonospaceFont(QFont)));
+    byte_view_text = new ByteViewText(data, encoding, this);
+    byte_view_text->setAccessibleName(name);
+    byte_view_text->setMonospaceFont(mainApp->monospaceFont(true));
 
-        connect(byte_view_text, SIGNAL(byteHovered(int)), this, SLOT(byteViewTextHovered(int)));
-        connect(byte_view_text, SIGNAL(byteSelected(int)), this, SLOT(byteViewTextMarked(int)));
-        connect(byte_view_text, SIGNAL(byteViewSettingsChanged()), this, SIGNAL(byteViewSettingsChanged()));
-        connect(this, SIGNAL(byteViewSettingsChanged()), byte_view_text, SLOT(updateByteViewSettings()));
-        connect(this, SIGNAL(byteViewUnmarkField()), byte_view_text, SLOT(unmarkField()));
+    // There are some secondary data source tvbuffs whose datais not freed
+    // when the epan_dissect_t is freed, but at some other point expected
+    // to outlive the packet, generally when the capture file is closed.
+    // If this is a PacketDialog, it can break that assumption.
+    // To get around this, we deep copy their data when the file is closed.
+    //
+    // XXX: We could add a function to the tvbuff API and only do this if
+    // there is no free_cb (a free_cb implies the data is freed at the
+    // same time as the tvb, i.e. when leaving the packet.)
+    if (tvb && is_fixed_packet_ && count() > 0) {
+        connect(this, &ByteViewTab::detachData, byte_view_text, &ByteViewText::detachData);
     }
-
-    int idx = QTabWidget::addTab(byte_view_text, name);
+    // See above - this tvb is (expected to be) scoped to the packet, but
+    // the real data is not necessarily so. If this is a PacketDialog
+    // and such a secondary data source, then we MUST NOT use any tvb
+    // function that accesses the real data after the capture file closes.
+    // That includes via the ds_tvb item of a field_info in the tree.
+    // proto_find_field_from_offset() is OK. See #14363.
+    //
+    // XXX: It sounds appealing to clone the secondary data source tvbs
+    // and set them to be freed when the byte_view_text is freed, perhaps
+    // even doing so only when the capture file is closing. However, while
+    // relatively simple for the few number of secondary data sources, it
+    // would be a pain to change the pointers for every field_info.
+    byte_view_text->setProperty(tvb_data_property, VariantPointer<tvbuff_t>::asQVariant(tvb));
+
+    // Connect everything up front even if this particular tab is a
+    // placeholder; it may be reused with real data later.
+    connect(mainApp, SIGNAL(zoomMonospaceFont(QFont)), byte_view_text, SLOT(setMonospaceFont(QFont)));
+
+    connect(byte_view_text, SIGNAL(byteHovered(int)), this, SLOT(byteViewTextHovered(int)));
+    connect(byte_view_text, SIGNAL(byteSelected(int)), this, SLOT(byteViewTextMarked(int)));
+    connect(byte_view_text, SIGNAL(byteViewSettingsChanged()), this, SIGNAL(byteViewSettingsChanged()));
+    connect(this, SIGNAL(byteViewSettingsChanged()), byte_view_text, SLOT(updateByteViewSettings()));
+    connect(this, SIGNAL(byteViewUnmarkField()), byte_view_text, SLOT(unmarkField()));
+
+    idx = QTabWidget::addTab(byte_view_text, name);
     byte_view_text->setProperty("tab_index", QVariant::fromValue(idx));
 
     QTabWidget::setTabToolTip(idx, name);
@@ -244,9 +252,6 @@ void ByteViewTab::setTabsVisible() {
 
 void ByteViewTab::selectedFrameChanged(QList<int> frames)
 {
-    clear();
-    qDeleteAll(findChildren<ByteViewText *>());
-
     if (!is_fixed_packet_) {
         /* If this is not a fixed packet (not the packet dialog), it must be the
          * byte view associated with the packet list. */
@@ -261,12 +266,11 @@ void ByteViewTab::selectedFrameChanged(QList<int> frames)
         }
     }
 
+    int src_count = 0;
+
     /* only show the bytes for single selections */
-    if (frames.count() == 1)
+    if (frames.count() == 1 && cap_file_ && cap_file_->edt)
     {
-        if (! cap_file_ || ! cap_file_->edt)
-            return;
-
         /* This code relies on a dissection, which had happened somewhere else. It also does not
          * really check, if the dissection happened for the correct frame. In the future we might
          * rewrite this for directly calling the dissection engine here. */
@@ -276,12 +280,22 @@ void ByteViewTab::selectedFrameChanged(QList<int> frames)
             char* source_name;
             source = (struct data_source *)src_le->data;
             source_name = get_data_source_name(source);
-            addTab(source_name, get_data_source_tvb(source));
+            setTabData(src_count++, source_name, get_data_source_tvb(source));
             wmem_free(NULL, source_name);
         }
     }
-    else
-        addTab("PlaceHolder", 0);
+
+    if (src_count == 0) {
+        setTabData(src_count++, "PlaceHolder", 0);
+    }
+
+    /* Most packets have the same data sources as the last one, so the
+     * loop above reused the existing widgets; drop any leftovers. */
+    while (count() > src_count) {
+        QWidget *extra = widget(count() - 1);
+        removeTab(count() - 1);
+        delete extra;
+    }
 
     setCurrentIndex(0);
 }
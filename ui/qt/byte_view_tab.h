@@ -60,7 +60,7 @@ private:
 
     void setTabsVisible();
     ByteViewText * findByteViewTextForTvb(tvbuff_t * search, int * idx = 0);
-    void addTab(const char *name = "", tvbuff_t *tvb = NULL);
+    void setTabData(int idx, const char *name = "", tvbuff_t *tvb = NULL);
 
 protected:
     void tabInserted(int);
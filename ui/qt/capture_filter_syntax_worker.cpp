@@ -56,6 +56,7 @@ void CaptureFilterSyntaxWorker::checkFilter(const QString filter)
     int pc_err;
     enum SyntaxLineEdit::SyntaxState state = SyntaxLineEdit::Valid;
     QString err_str;
+    QString dlts_sig;
 
     DEBUG_SYNTAX_CHECK("received", "?");
 
@@ -75,6 +76,7 @@ void CaptureFilterSyntaxWorker::checkFilter(const QString filter)
                     // Capture filter for DLT_USER is unknown
                     state = SyntaxLineEdit::Deprecated;
                     err_str = "Unable to check capture filter";
+                    dlts_sig += "u ";
                 } else {
                     active_dlts.insert(device->active_dlt);
                 }
@@ -84,6 +86,26 @@ void CaptureFilterSyntaxWorker::checkFilter(const QString filter)
         }
     }
 
+    // If neither the filter text nor the set of things we'd check it
+    // against has changed since the last check, reuse the previous
+    // result; re-checks of unchanged text are common (focus changes,
+    // window activation) and compiling a large filter once per active
+    // link type - or spawning an extcap process - isn't free.
+    foreach(int dlt, active_dlts.values()) {
+        dlts_sig += QString::number(dlt) + ' ';
+    }
+    foreach(unsigned extcapif, active_extcap.values()) {
+        interface_t *device;
+
+        device = &g_array_index(global_capture_opts.all_ifaces, interface_t, extcapif);
+        dlts_sig += QString(device->name) + ' ';
+    }
+    if (filter == last_filter_ && dlts_sig == last_dlts_) {
+        emit syntaxResult(filter, last_state_, last_err_str_);
+        DEBUG_SYNTAX_CHECK("cached", "idle");
+        return;
+    }
+
     foreach(int dlt, active_dlts.values()) {
         pcap_compile_mtx_.lock();
         pd = pcap_open_dead(dlt, DUMMY_SNAPLENGTH);
@@ -138,6 +160,11 @@ void CaptureFilterSyntaxWorker::checkFilter(const QString filter)
             g_free(error);
         }
     }
+    last_filter_ = filter;
+    last_dlts_ = dlts_sig;
+    last_state_ = state;
+    last_err_str_ = err_str;
+
     emit syntaxResult(filter, state, err_str);
 
     DEBUG_SYNTAX_CHECK("known", "idle");
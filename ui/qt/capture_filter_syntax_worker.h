@@ -19,13 +19,21 @@ class CaptureFilterSyntaxWorker : public QObject
     Q_OBJECT
 
 public:
-    CaptureFilterSyntaxWorker(QObject *parent = 0) : QObject(parent) {}
+    CaptureFilterSyntaxWorker(QObject *parent = 0) : QObject(parent), last_state_(0) {}
 
 public slots:
     void checkFilter(const QString filter);
 
 signals:
     void syntaxResult(QString filter, int state, QString err_msg);
+
+private:
+    // Result of the most recent check, so re-checks of unchanged text
+    // (e.g. on focus changes) don't recompile the filter.
+    QString last_filter_;
+    QString last_dlts_;
+    int last_state_;
+    QString last_err_str_;
 };
 
 #endif // CAPTURE_FILTER_SYNTAX_WORKER_H
@@ -141,6 +141,17 @@ void ExpertInfoDialog::retapPackets()
     clearAllData();
     removeTapListeners();
 
+    /* Record expert events in epan's session log from now on; once the
+     * log covers the capture file we can fill the model from it directly
+     * and skip the full retap on subsequent visits. */
+    expert_log_set_enabled(true);
+
+    if (!ui->limitCheckBox->isChecked() && expert_log_count() > 0) {
+        expert_info_model_->populateFromLog();
+        updateWidgets();
+        return;
+    }
+
     if (!registerTapListener("expert",
                              expert_info_model_,
                              ui->limitCheckBox->isChecked() ? display_filter_.toUtf8().constData(): NULL,
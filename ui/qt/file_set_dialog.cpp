@@ -22,6 +22,7 @@
 #include "main_application.h"
 
 #include <QDialogButtonBox>
+#include <QFileSystemWatcher>
 #include <QPushButton>
 #include <QDateTime>
 #include <QFontMetrics>
@@ -57,7 +58,8 @@ FileSetDialog::FileSetDialog(QWidget *parent) :
     GeometryStateDialog(parent),
     fs_ui_(new Ui::FileSetDialog),
     fileset_entry_model_(new FilesetEntryModel(this)),
-    close_button_(NULL)
+    close_button_(NULL),
+    dir_watcher_(new QFileSystemWatcher(this))
 {
     fs_ui_->setupUi(this);
     loadGeometry ();
@@ -71,6 +73,16 @@ FileSetDialog::FileSetDialog(QWidget *parent) :
     connect(fs_ui_->fileSetTree->selectionModel(), &QItemSelectionModel::selectionChanged,
             this, &FileSetDialog::selectionChanged);
 
+    // The watcher only reports that something in the directory changed.
+    // A ring buffer rotation creates the new file and may remove an old
+    // one in short succession; coalesce the notifications and give
+    // dumpcap a moment to finish creating the file before rescanning.
+    connect(dir_watcher_, &QFileSystemWatcher::directoryChanged,
+            this, &FileSetDialog::directoryChanged);
+    rescan_timer_.setSingleShot(true);
+    rescan_timer_.setInterval(500);
+    connect(&rescan_timer_, &QTimer::timeout, this, &FileSetDialog::rescanDirectory);
+
     beginAddFile();
     addFile();
     endAddFile();
@@ -85,12 +97,17 @@ FileSetDialog::~FileSetDialog()
 /* a new capture file was opened, browse the dir and look for files matching the given file set */
 void FileSetDialog::fileOpened(const capture_file *cf) {
     if (!cf) return;
+    cur_cf_path_ = QString::fromUtf8(cf->filename);
     fileset_entry_model_->clear();
     fileset_add_dir(cf->filename, this);
+    updateWatchedDirectory();
 }
 
 /* the capture file was closed */
 void FileSetDialog::fileClosed() {
+    cur_cf_path_.clear();
+    rescan_timer_.stop();
+    updateWatchedDirectory();
     fileset_entry_model_->clear();
 }
 
@@ -149,6 +166,52 @@ void FileSetDialog::selectionChanged(const QItemSelection &selected, const QItem
     }
 }
 
+void FileSetDialog::on_followSetCheckBox_toggled(bool)
+{
+    updateWatchedDirectory();
+}
+
+void FileSetDialog::directoryChanged(const QString &)
+{
+    rescan_timer_.start();
+}
+
+/* The watched directory changed, e.g. a ring buffer rotated to a new file.
+ * Rebuild the file set from disk and open the newest member. Going through
+ * the regular open path keeps memory bounded to a single ring file; older
+ * files stay on disk and can be revisited from the list. */
+void FileSetDialog::rescanDirectory()
+{
+    fileset_entry *latest;
+
+    if (cur_cf_path_.isEmpty())
+        return;
+
+    QByteArray cf_path_bytes = cur_cf_path_.toUtf8();
+
+    /* The model's clear() also deletes the file set itself. */
+    fileset_entry_model_->clear();
+    fileset_add_dir(cf_path_bytes.constData(), this);
+
+    latest = fileset_get_latest();
+    if (latest && !latest->current) {
+        emit fileSetOpenCaptureFile(QString::fromUtf8(latest->fullname));
+    }
+}
+
+void FileSetDialog::updateWatchedDirectory()
+{
+    const QStringList watched = dir_watcher_->directories();
+    if (!watched.isEmpty())
+        dir_watcher_->removePaths(watched);
+
+    if (fs_ui_->followSetCheckBox->isChecked() && !cur_cf_path_.isEmpty()) {
+        const char *dirname = fileset_get_dirname();
+        if (dirname)
+            dir_watcher_->addPath(QString::fromUtf8(dirname));
+    }
+}
+
 void FileSetDialog::on_buttonBox_helpRequested()
 {
     mainApp->helpTopicAction(HELP_FILESET_DIALOG);
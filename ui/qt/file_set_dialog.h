@@ -18,6 +18,9 @@
 #include "geometry_state_dialog.h"
 
 #include <QItemSelection>
+#include <QTimer>
+
+class QFileSystemWatcher;
 
 namespace Ui {
 class FileSetDialog;
@@ -45,11 +48,19 @@ signals:
 private slots:
     void selectionChanged(const QItemSelection &selected, const QItemSelection &);
     void on_buttonBox_helpRequested();
+    void on_followSetCheckBox_toggled(bool checked);
+    void directoryChanged(const QString &path);
+    void rescanDirectory();
 
 private:
+    void updateWatchedDirectory();
+
     Ui::FileSetDialog *fs_ui_;
     FilesetEntryModel *fileset_entry_model_;
     QPushButton *close_button_;
+    QFileSystemWatcher *dir_watcher_;
+    QTimer rescan_timer_;
+    QString cur_cf_path_;
     int cur_idx_;
 };
 
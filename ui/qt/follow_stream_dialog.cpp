@@ -58,6 +58,12 @@
 // Matches SplashOverlay.
 static int info_update_freq_ = 100;
 
+// Cap on the amount of stream payload rendered into the text document.
+// QTextDocument gets somewhere between slow and fatal on multi-GB text,
+// so beyond this we stop appending and tell the user to use "Save as…",
+// which exports the whole stream straight from the follow records.
+static const qint64 max_document_length_ = 500 * 1000 * 1000;
+
 // Handle the loop breaking notification properly
 static QMutex loop_break_mutex;
 
@@ -79,6 +85,7 @@ FollowStreamDialog::FollowStreamDialog(QWidget &parent, CaptureFile &cf, int pro
     last_from_server_(0),
     turns_(0),
     use_regex_find_(false),
+    truncated_(false),
     terminating_(false),
     previous_sub_stream_num_(0)
 {
@@ -331,20 +338,51 @@ void FollowStreamDialog::saveAs()
         return;
     }
 
-    // XXX: What if truncated_ is true? We should save the entire stream.
+    if (truncated_ || recent.gui_follow_show == SHOW_RAW) {
+        // The document doesn't hold the whole stream (or, for "Raw", holds
+        // a hex rendering of it). Export the stream payload itself, one
+        // follow record at a time, so a multi-GB stream never has to fit
+        // in a QByteArray.
+        saveStreamRecords(file);
+        return;
+    }
+
     // Unconditionally save data as UTF-8 (even if data is decoded otherwise).
     QByteArray bytes = ui->teStreamContent->toPlainText().toUtf8();
-    if (recent.gui_follow_show == SHOW_RAW) {
-        // The "Raw" format is currently displayed as hex data and needs to be
-        // converted to binary data. fromHex() skips over non hex characters
-        // including line breaks, which is what we want.
-        bytes = QByteArray::fromHex(bytes);
-    }
 
     QDataStream out(&file);
     out.writeRawData(bytes.constData(), static_cast<int>(bytes.size()));
 }
 
+void FollowStreamDialog::saveStreamRecords(QFile &file)
+{
+    QDataStream out(&file);
+    QElapsedTimer elapsed_timer;
+
+    elapsed_timer.start();
+
+    for (GList *cur = g_list_last(follow_info_.payload); cur; cur = g_list_previous(cur)) {
+        follow_record_t *follow_record = (follow_record_t *)cur->data;
+
+        if (!follow_record->is_server) {
+            if (follow_info_.show_stream == FROM_SERVER) {
+                continue;
+            }
+        } else {
+            if (follow_info_.show_stream == FROM_CLIENT) {
+                continue;
+            }
+        }
+
+        out.writeRawData((const char *)follow_record->data->data,
+                         follow_record->data->len);
+        if (elapsed_timer.elapsed() > info_update_freq_) {
+            mainApp->processEvents();
+            elapsed_timer.start();
+        }
+    }
+}
+
 void FollowStreamDialog::helpButton()
 {
     mainApp->helpTopicAction(HELP_FOLLOW_STREAM_DIALOG);
@@ -601,6 +639,7 @@ void FollowStreamDialog::readStream()
     server_packet_count_ = 0;
     last_packet_ = 0;
     turns_ = 0;
+    truncated_ = false;
 
     if (!follower_) {
         ws_assert_not_reached();
@@ -1187,6 +1226,7 @@ void FollowStreamDialog::readFollowStream()
     follow_record_t *follow_record;
     QElapsedTimer elapsed_timer;
     QByteArray buffer;
+    qint64 rendered = 0;
 
     elapsed_timer.start();
 
@@ -1212,6 +1252,11 @@ void FollowStreamDialog::readFollowStream()
         }
 
         if (!skip) {
+            rendered += follow_record->data->len;
+            if (rendered > max_document_length_) {
+                truncated_ = true;
+                break;
+            }
             // This will only detach / deep copy if the buffer data is
             // modified. Try to avoid doing that as much as possible
             // (and avoid new memory allocations that have to be freed).
@@ -1231,6 +1276,11 @@ void FollowStreamDialog::readFollowStream()
         }
     }
 
+    if (truncated_) {
+        addText(tr("\n[Stream output truncated. Use \"Save as…\" to export the whole stream.]\n"),
+                false, 0, false);
+    }
+
     loop_break_mutex.lock();
     isReadRunning = false;
     loop_break_mutex.unlock();
@@ -88,6 +88,7 @@ private:
                 uint32_t packet_num, nstime_t abs_ts, uint32_t *global_pos);
     void readStream();
     void readFollowStream();
+    void saveStreamRecords(QFile &file);
 
     void followStream();
     void addText(QString text, bool is_from_server, uint32_t packet_num, bool colorize = true);
@@ -116,6 +117,8 @@ private:
 
     bool                    use_regex_find_;
 
+    bool                    truncated_;
+
     bool                    terminating_;
 
     int                     previous_sub_stream_num_;
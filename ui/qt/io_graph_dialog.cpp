@@ -1546,6 +1546,7 @@ void IOGraphDialog::on_intervalComboBox_currentIndexChanged(int)
 {
     int interval = ui->intervalComboBox->itemData(ui->intervalComboBox->currentIndex()).toInt();
     bool need_retap = false;
+    bool need_recalc = false;
 
     precision_ = ceil(log10(SCALE_F / interval));
     if (precision_ < 0) {
@@ -1567,10 +1568,16 @@ void IOGraphDialog::on_intervalComboBox_currentIndexChanged(int)
         for (int row = 0; row < uat_model_->rowCount(); row++) {
             IOGraph *iog = ioGraphs_.value(row, NULL);
             if (iog) {
-                iog->setInterval(interval);
                 if (iog->visible()) {
-                    need_retap = true;
+                    /* Growing the interval by an integer factor merges
+                     * whole items, so we can reuse the tapped data. */
+                    if (iog->setIntervalRebucket(interval)) {
+                        need_recalc = true;
+                    } else {
+                        need_retap = true;
+                    }
                 } else {
+                    iog->setInterval(interval);
                     iog->setNeedRetap(true);
                 }
             }
@@ -1579,6 +1586,8 @@ void IOGraphDialog::on_intervalComboBox_currentIndexChanged(int)
 
     if (need_retap) {
         scheduleRetap(true);
+    } else if (need_recalc) {
+        scheduleRecalc(true);
     }
 }
 
@@ -2829,6 +2838,26 @@ void IOGraph::setInterval(int interval)
     }
 }
 
+// Sets the interval, merging the tapped data in place when the new interval
+// is an exact multiple of the current one. Each coarse item is then the sum
+// of whole current items, so the result matches what a retap would produce.
+// Returns false if the data is stale and a retap is still required.
+bool IOGraph::setIntervalRebucket(int interval)
+{
+    if (interval == interval_) {
+        return true;
+    }
+    if (need_retap_ || cur_idx_ < 0 || interval_ <= 0 ||
+        interval < interval_ || interval % interval_ != 0) {
+        setInterval(interval);
+        return false;
+    }
+
+    cur_idx_ = rebucket_io_graph_items(&items_[0], cur_idx_, interval / interval_, hf_index_);
+    setInterval(interval);
+    return true;
+}
+
 // Get the value at the given interval (idx) for the current value unit.
 double IOGraph::getItemValue(int idx, const capture_file *cap_file) const
 {
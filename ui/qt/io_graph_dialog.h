@@ -86,6 +86,7 @@ public:
     void setValueUnitField(const QString &vu_field);
     unsigned int movingAveragePeriod() const { return moving_avg_period_; }
     void setInterval(int interval);
+    bool setIntervalRebucket(int interval);
     bool addToLegend();
     bool removeFromLegend();
     QCPGraph *graph() const { return graph_; }
@@ -27,6 +27,18 @@ ExpertPacketItem::ExpertPacketItem(const expert_info_t& expert_info, column_info
     }
 }
 
+ExpertPacketItem::ExpertPacketItem(const expert_log_entry_t& entry, ExpertPacketItem* parent) :
+    packet_num_(entry.packet_num),
+    group_(entry.group),
+    severity_(entry.severity),
+    hf_id_(entry.hf_index),
+    protocol_(entry.protocol),
+    summary_(entry.summary),
+    info_(entry.col_info),
+    parentItem_(parent)
+{
+}
+
 ExpertPacketItem::~ExpertPacketItem()
 {
     for (int row = 0; row < childItems_.count(); row++)
@@ -386,6 +398,49 @@ void ExpertInfoModel::addExpertInfo(const struct expert_info_s& expert_info)
     expert_summary_root->appendChild(expert_summary, summaryKey);
 }
 
+void ExpertInfoModel::addLogEntry(const expert_log_entry_t& entry)
+{
+    QString groupKey = ExpertPacketItem::groupKey(false, entry.severity, entry.group, QString(entry.protocol), entry.hf_index);
+    QString summaryKey = ExpertPacketItem::groupKey(true, entry.severity, entry.group, QString(entry.protocol), entry.hf_index);
+
+    ExpertPacketItem* expert_root = root_->child(groupKey);
+    if (expert_root == NULL) {
+        expert_root = new ExpertPacketItem(entry, root_);
+        root_->appendChild(expert_root, groupKey);
+    }
+
+    expert_root->appendChild(new ExpertPacketItem(entry, expert_root), groupKey);
+
+    //add the summary children off of the first child of the root children
+    ExpertPacketItem* summary_root = expert_root->child(0);
+
+    ExpertPacketItem* expert_summary_root = summary_root->child(summaryKey);
+    if (expert_summary_root == NULL) {
+        expert_summary_root = new ExpertPacketItem(entry, summary_root);
+        summary_root->appendChild(expert_summary_root, summaryKey);
+    }
+
+    expert_summary_root->appendChild(new ExpertPacketItem(entry, expert_summary_root), summaryKey);
+}
+
+void ExpertInfoModel::populateFromLog()
+{
+    beginResetModel();
+
+    eventCounts_.clear();
+    delete root_;
+    root_ = createRootItem();
+
+    for (unsigned idx = 0; idx < expert_log_count(); idx++) {
+        const expert_log_entry_t *entry = expert_log_entry(idx);
+
+        addLogEntry(*entry);
+        eventCounts_[(enum ExpertSeverity)entry->severity]++;
+    }
+
+    endResetModel();
+}
+
 void ExpertInfoModel::tapReset(void *eid_ptr)
 {
     ExpertInfoModel *model = static_cast<ExpertInfoModel*>(eid_ptr);
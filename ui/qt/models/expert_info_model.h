@@ -28,6 +28,7 @@ class ExpertPacketItem
 {
 public:
     ExpertPacketItem(const expert_info_t& expert_info, column_info *cinfo, ExpertPacketItem* parent);
+    ExpertPacketItem(const expert_log_entry_t& entry, ExpertPacketItem* parent);
     virtual ~ExpertPacketItem();
 
     unsigned int packetNum() const { return packet_num_; }
@@ -110,6 +111,9 @@ public:
     // Called from tapPacket
     void addExpertInfo(const struct expert_info_s& expert_info);
 
+    // Fill the model from the epan session expert event log, without a retap
+    void populateFromLog();
+
     // Callbacks for register_tap_listener
     static void tapReset(void *eid_ptr);
     static tap_packet_status tapPacket(void *eid_ptr, struct _packet_info *pinfo, struct epan_dissect *, const void *data, tap_flags_t flags);
@@ -119,6 +123,7 @@ private:
     CaptureFile& capture_file_;
 
     ExpertPacketItem* createRootItem();
+    void addLogEntry(const expert_log_entry_t& entry);
 
     bool group_by_summary_;
     ExpertPacketItem* root_;
@@ -36,6 +36,7 @@
 #include <QColor>
 #include <QElapsedTimer>
 #include <QFontMetrics>
+#include <QHash>
 #include <QModelIndex>
 #include <QElapsedTimer>
 
@@ -78,7 +79,10 @@ PacketListModel::PacketListModel(QObject *parent, capture_file *cf) :
     number_to_row_(QVector<int>()),
     max_row_height_(0),
     max_line_count_(1),
-    idle_dissection_row_(0)
+    idle_dissection_row_(0),
+    prefetch_row_(0),
+    prefetch_end_row_(-1),
+    prefetch_scheduled_(false)
 {
     Q_ASSERT(glbl_plist_model == Q_NULLPTR);
     glbl_plist_model = this;
@@ -106,16 +110,32 @@ PacketListModel::PacketListModel(QObject *parent, capture_file *cf) :
             this, &PacketListModel::emitItemHeightChanged,
             Qt::QueuedConnection);
     idle_dissection_timer_ = new QElapsedTimer();
+    flush_limit_timer_ = new QElapsedTimer();
 }
 
 PacketListModel::~PacketListModel()
 {
     delete idle_dissection_timer_;
+    delete flush_limit_timer_;
 }
 
+// How many rows recently closed capture files had, keyed by file name.
+// Reopening a file is common enough (and the eventual size is knowable
+// enough) that it's worth reserving the full amount up front instead of
+// growing the row vectors through repeated reallocations.
+static QHash<QString, qsizetype> closed_file_row_counts_;
+
 void PacketListModel::setCaptureFile(capture_file *cf)
 {
     cap_file_ = cf;
+    if (cf && cf->filename) {
+        qsizetype prev_count = closed_file_row_counts_.value(QString::fromUtf8(cf->filename), 0);
+        if (prev_count > physical_rows_.capacity()) {
+            physical_rows_.reserve(prev_count);
+            visible_rows_.reserve(prev_count);
+            number_to_row_.reserve(prev_count);
+        }
+    }
 }
 
 // Packet list records have no children (for now, at least).
@@ -146,6 +166,9 @@ unsigned PacketListModel::recreateVisibleRows()
 {
     beginResetModel();
     visible_rows_.resize(0);
+    // Any queued rows are already in physical_rows_ and will be picked up
+    // by the rebuild below; don't let a pending flush add them twice.
+    new_visible_rows_.resize(0);
     number_to_row_.fill(0);
     endResetModel();
 
@@ -169,6 +192,13 @@ unsigned PacketListModel::recreateVisibleRows()
 }
 
 void PacketListModel::clear() {
+    // We're called from the file-closing callback, so the file name is
+    // still around. Only files bigger than the default reservation are
+    // interesting.
+    if (cap_file_ && cap_file_->filename && physical_rows_.count() > reserved_packets_) {
+        closed_file_row_counts_.insert(QString::fromUtf8(cap_file_->filename),
+                physical_rows_.count());
+    }
     beginResetModel();
     qDeleteAll(physical_rows_);
     PacketListRecord::invalidateAllRecords();
@@ -180,7 +210,10 @@ void PacketListModel::clear() {
     max_row_height_ = 0;
     max_line_count_ = 1;
     idle_dissection_timer_->invalidate();
+    flush_limit_timer_->invalidate();
     idle_dissection_row_ = 0;
+    prefetch_row_ = 0;
+    prefetch_end_row_ = -1;
 }
 
 void PacketListModel::invalidateAllColumnStrings()
@@ -567,6 +600,12 @@ void PacketListModel::sort(int column, Qt::SortOrder order)
 {
     if (!cap_file_ || visible_rows_.count() < 1) return;
     if (column < 0) return;
+    if (cap_file_->read_lock) {
+        // New rows are still being appended; sorting a moving target
+        // would scramble the row bookkeeping. PacketList sorts again
+        // when reading finishes.
+        return;
+    }
 
     if (physical_rows_.count() < 1)
         return;
@@ -578,10 +617,13 @@ void PacketListModel::sort(int column, Qt::SortOrder order)
 
     QString col_title = get_column_title(column);
 
-    if (text_sort_column_ >= 0 && (unsigned)visible_rows_.count() > prefs.gui_packet_list_cached_rows_max) {
+    if (text_sort_column_ >= 0 &&
+        !prefs.gui_packet_list_cache_all_column_text &&
+        (unsigned)visible_rows_.count() > prefs.gui_packet_list_cached_rows_max) {
         /* Column not based on frame data but by column text that requires
          * dissection, so to sort in a reasonable amount of time the column
-         * text needs to be cached.
+         * text needs to be cached. With the persistent column text store
+         * there is no row limit.
          */
         /* If the sort is being triggered because the columns were already
          * sorted and the filter is being cleared (or changed to something
@@ -645,7 +687,80 @@ void PacketListModel::sort(int column, Qt::SortOrder order)
     sort_column_is_numeric_ = isNumericColumn(sort_column_);
     QVector<PacketListRecord *> sorted_visible_rows_ = visible_rows_;
     try {
-        std::sort(sorted_visible_rows_.begin(), sorted_visible_rows_.end(), recordLessThan);
+        if (text_sort_column_ < 0) {
+            // Column is based on frame data; comparisons are cheap, so
+            // sort the records directly.
+            std::sort(sorted_visible_rows_.begin(), sorted_visible_rows_.end(), recordLessThan);
+        } else {
+            // Column text requires dissection. Extract each row's sort key
+            // exactly once up front - the column string plus, for numeric
+            // columns, its parsed value - instead of fetching and parsing
+            // them again for every one of the O(N log N) comparisons.
+            struct SortKey {
+                PacketListRecord *record;
+                QString str;
+                double num;
+                bool num_ok;
+            };
+
+            QVector<SortKey> keys;
+            keys.reserve(sorted_visible_rows_.size());
+            for (qsizetype i = 0; i < sorted_visible_rows_.size(); i++) {
+                if (busy_timer_.elapsed() > busy_timeout_) {
+                    if (progress_frame_) {
+                        progress_frame_->setValue(static_cast<int>(i * 100 / sorted_visible_rows_.size()));
+                    }
+                    mainApp->processEvents(QEventLoop::ExcludeSocketNotifiers, 1);
+                    if (stop_flag_) {
+                        throw SortAbort("Sorting aborted");
+                    }
+                    busy_timer_.restart();
+                }
+                SortKey key;
+                key.record = sorted_visible_rows_[i];
+                key.str = key.record->columnString(sort_cap_file_, sort_column_);
+                key.num = 0.0;
+                key.num_ok = false;
+                if (sort_column_is_numeric_) {
+                    key.num = parseNumericColumn(key.str, &key.num_ok);
+                }
+                keys.append(key);
+            }
+
+            auto keyLessThan = [](const SortKey &k1, const SortKey &k2) {
+                if (busy_timer_.elapsed() > busy_timeout_) {
+                    mainApp->processEvents(QEventLoop::ExcludeSocketNotifiers, 1);
+                    if (stop_flag_) {
+                        throw SortAbort("Sorting aborted");
+                    }
+                    busy_timer_.restart();
+                }
+                int cmp_val = k1.str.compare(k2.str);
+                if (cmp_val != 0 && sort_column_is_numeric_) {
+                    if (!k1.num_ok && !k2.num_ok) {
+                        cmp_val = 0;
+                    } else if (!k1.num_ok || (k2.num_ok && k1.num < k2.num)) {
+                        cmp_val = -1;
+                    } else if (!k2.num_ok || (k1.num > k2.num)) {
+                        cmp_val = 1;
+                    }
+                }
+                if (cmp_val == 0) {
+                    // All else being equal, compare column numbers.
+                    cmp_val = frame_data_compare(sort_cap_file_->epan, k1.record->frameData(), k2.record->frameData(), COL_NUMBER);
+                }
+                if (sort_order_ == Qt::AscendingOrder) {
+                    return cmp_val < 0;
+                } else {
+                    return cmp_val > 0;
+                }
+            };
+            std::sort(keys.begin(), keys.end(), keyLessThan);
+
+            for (qsizetype i = 0; i < keys.size(); i++) {
+                sorted_visible_rows_[i] = keys[i].record;
+            }
+        }
 
         beginResetModel();
         visible_rows_.resize(0);
@@ -969,12 +1084,20 @@ QVariant PacketListModel::headerData(int section, Qt::Orientation orientation,
     return QVariant();
 }
 
+// Minimum time between queued-row flushes. Each beginInsertRows /
+// endInsertRows cycle makes the views redo layout work, so during live
+// capture we want one insertion covering a batch of packets per screen
+// update rather than one per pipe read.
+static const int flush_interval_ = 100; // ms
+
 void PacketListModel::flushVisibleRows()
 {
     int pos = static_cast<int>(visible_rows_.count());
 
+    flush_limit_timer_->start();
+
     if (new_visible_rows_.count() > 0) {
-        beginInsertRows(QModelIndex(), pos, pos + static_cast<int>(new_visible_rows_.count()));
+        beginInsertRows(QModelIndex(), pos, pos + static_cast<int>(new_visible_rows_.count()) - 1);
         foreach (PacketListRecord *record, new_visible_rows_) {
             frame_data *fdata = record->frameData();
 
@@ -1001,6 +1124,17 @@ void PacketListModel::dissectIdle(bool reset)
         return;
     }
 
+    if (!cap_file_ || cap_file_->read_lock) {
+        // A rescan or redissection is under way, and its progress dialog
+        // processes events, so we can get here in the middle of it;
+        // dissecting against the file now would race the rescan (which
+        // may even have freed the epan session). Stop the sweep -
+        // captureFileReadFinished() restarts it from row 0 once the
+        // rescan is done.
+        idle_dissection_timer_->invalidate();
+        return;
+    }
+
     idle_dissection_timer_->restart();
 
     int first = idle_dissection_row_;
@@ -1021,6 +1155,52 @@ void PacketListModel::dissectIdle(bool reset)
     emit bgColorizationProgress(first+1, idle_dissection_row_+1);
 }
 
+// The linear cache fill above starts over from row 0, which doesn't help
+// when the user has scrolled deep into a large file. Materialize a window
+// of rows around the viewport first, in idle time slices, so that by the
+// time the view asks for their data they're (usually) already cached.
+void PacketListModel::setViewportRange(int first, int last)
+{
+    if (first < 0 || last < first || visible_rows_.count() < 1)
+        return;
+
+    // Prefetch one viewport height above and below the displayed rows.
+    int margin = last - first + 1;
+    prefetch_row_ = qMax(0, first - margin);
+    prefetch_end_row_ = qMin(static_cast<int>(visible_rows_.count()) - 1, last + margin);
+
+    if (!prefetch_scheduled_) {
+        prefetch_scheduled_ = true;
+        QTimer::singleShot(0, this, &PacketListModel::prefetchRows);
+    }
+}
+
+void PacketListModel::prefetchRows()
+{
+    prefetch_scheduled_ = false;
+    if (!cap_file_ || cap_file_->read_lock)
+        return;
+
+    QElapsedTimer slice;
+    slice.start();
+    while (slice.elapsed() < idle_dissection_interval_
+           && prefetch_row_ <= prefetch_end_row_) {
+        PacketListRecord *record = visible_rows_.value(prefetch_row_, nullptr);
+        if (record) {
+            // Unlike ensureRowColorized, cache the column strings even if
+            // it evicts older rows; the window around the viewport is what
+            // we want the fixed-size cache to hold.
+            record->columnString(cap_file_, 0, true);
+        }
+        prefetch_row_++;
+    }
+
+    if (prefetch_row_ <= prefetch_end_row_) {
+        prefetch_scheduled_ = true;
+        QTimer::singleShot(0, this, &PacketListModel::prefetchRows);
+    }
+}
+
 // XXX Pass in cinfo from packet_list_append so that we can fill in
 // line counts?
 int PacketListModel::appendPacket(frame_data *fdata)
@@ -1039,9 +1219,17 @@ int PacketListModel::appendPacket(frame_data *fdata)
     if (fdata->passed_dfilter || fdata->ref_time) {
         new_visible_rows_ << record;
         if (new_visible_rows_.count() < 2) {
-            // This is the first queued packet. Schedule an insertion for
-            // the next UI update.
-            QTimer::singleShot(0, this, &PacketListModel::flushVisibleRows);
+            // This is the first queued packet. Schedule an insertion, but
+            // keep at least flush_interval_ between insertions so that a
+            // fast capture coalesces into one batch per screen update.
+            int delay = 0;
+            if (flush_limit_timer_->isValid()) {
+                qint64 since_flush = flush_limit_timer_->elapsed();
+                if (since_flush < flush_interval_) {
+                    delay = flush_interval_ - static_cast<int>(since_flush);
+                }
+            }
+            QTimer::singleShot(delay, this, &PacketListModel::flushVisibleRows);
         }
         pos = static_cast<int>( visible_rows_.count() + new_visible_rows_.count() ) - 1;
     }
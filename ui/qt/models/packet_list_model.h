@@ -56,6 +56,11 @@ public:
     frame_data *getRowFdata(QModelIndex idx) const;
     frame_data *getRowFdata(int row) const;
     void ensureRowColorized(int row);
+    /**
+     * @brief Tell the model which rows the view is displaying so that it
+     * can materialize the rows around them while the application is idle.
+     */
+    void setViewportRange(int first, int last);
     int visibleIndexOf(frame_data *fdata) const;
     /**
      * @brief Invalidate any cached column strings.
@@ -120,10 +125,19 @@ private:
     QElapsedTimer *idle_dissection_timer_;
     int idle_dissection_row_;
 
+    // Time of the last queued-row flush, used to rate limit insertions
+    // during live capture.
+    QElapsedTimer *flush_limit_timer_;
+
+    int prefetch_row_;
+    int prefetch_end_row_;
+    bool prefetch_scheduled_;
+
     bool isNumericColumn(int column);
 
 private slots:
     void emitItemHeightChanged(const QModelIndex &ih_index);
+    void prefetchRows();
 };
 
 #endif // PACKET_LIST_MODEL_H
@@ -14,12 +14,15 @@
 #include <epan/epan_dissect.h>
 #include <epan/column.h>
 #include <epan/conversation.h>
+#include <epan/prefs.h>
 #include <epan/wmem_scopes.h>
 
 #include <epan/color_filters.h>
 
 #include "frame_tvbuff.h"
 
+#include <wsutil/wslog.h>
+
 #include <ui/qt/utils/qt_ui_utils.h>
 
 #include <QStringList>
@@ -27,6 +30,112 @@
 QCache<uint32_t, QStringList> PacketListRecord::col_text_cache_(500);
 QMap<int, int> PacketListRecord::cinfo_column_;
 unsigned PacketListRecord::rows_color_ver_ = 1;
+QVector<PacketListRecord::ColumnTextStore> PacketListRecord::col_stores_;
+quint64 PacketListRecord::dissections_ = 0;
+quint64 PacketListRecord::column_dissections_ = 0;
+
+// Sharing a prefix shorter than this isn't worth an entry header.
+static const quint32 min_shared_prefix_ = 8;
+
+bool PacketListRecord::ColumnTextStore::contains(uint32_t frame_num) const
+{
+    return frame_num >= 1 && frame_num <= (uint32_t)offsets_.size() &&
+        offsets_.at(frame_num - 1) != 0;
+}
+
+bool PacketListRecord::ColumnTextStore::entryEquals(quint32 entry_off, const char *text, quint32 len) const
+{
+    EntryHeader eh;
+    memcpy(&eh, arena_.constData() + entry_off, sizeof(eh));
+    if (eh.prefix_len + eh.suffix_len != len) {
+        return false;
+    }
+    return memcmp(arena_.constData() + eh.base_off, text, eh.prefix_len) == 0 &&
+        memcmp(arena_.constData() + entry_off + sizeof(eh), text + eh.prefix_len, eh.suffix_len) == 0;
+}
+
+void PacketListRecord::ColumnTextStore::insert(uint32_t frame_num, const char *text)
+{
+    quint32 len = (quint32)strlen(text);
+
+    if (frame_num < 1) {
+        return;
+    }
+    if (frame_num > (uint32_t)offsets_.size()) {
+        offsets_.insert(offsets_.size(), frame_num - offsets_.size(), 0);
+    }
+    if (offsets_.at(frame_num - 1) != 0) {
+        if (entryEquals(offsets_.at(frame_num - 1) - 1, text, len)) {
+            return;
+        }
+        // Text changed (e.g. redissection); fall through and re-store.
+    }
+
+    uint hash = (uint)qHashBits(text, len, 0);
+    for (auto it = dedupe_.constFind(hash); it != dedupe_.constEnd() && it.key() == hash; ++it) {
+        if (entryEquals(it.value(), text, len)) {
+            offsets_[frame_num - 1] = it.value() + 1;
+            return;
+        }
+    }
+
+    // Share a prefix with the last uncompressed entry when long enough.
+    quint32 prefix_len = 0;
+    if (last_full_len_ > 0) {
+        const char *last_full = arena_.constData() + last_full_off_;
+        quint32 max_len = qMin(last_full_len_, len);
+        while (prefix_len < max_len && last_full[prefix_len] == text[prefix_len]) {
+            prefix_len++;
+        }
+        if (prefix_len < min_shared_prefix_) {
+            prefix_len = 0;
+        }
+    }
+
+    EntryHeader eh = { prefix_len ? last_full_off_ : 0, prefix_len, len - prefix_len };
+    quint32 entry_off = (quint32)arena_.size();
+    arena_.append(reinterpret_cast<const char *>(&eh), sizeof(eh));
+    arena_.append(text + prefix_len, eh.suffix_len);
+    if (prefix_len == 0) {
+        last_full_off_ = entry_off + sizeof(eh);
+        last_full_len_ = len;
+    }
+    dedupe_.insert(hash, entry_off);
+    offsets_[frame_num - 1] = entry_off + 1;
+}
+
+void PacketListRecord::ColumnTextStore::remove(uint32_t frame_num)
+{
+    if (frame_num >= 1 && frame_num <= (uint32_t)offsets_.size()) {
+        offsets_[frame_num - 1] = 0;
+    }
+}
+
+QString PacketListRecord::ColumnTextStore::at(uint32_t frame_num) const
+{
+    if (!contains(frame_num)) {
+        return QString();
+    }
+    quint32 entry_off = offsets_.at(frame_num - 1) - 1;
+    EntryHeader eh;
+    memcpy(&eh, arena_.constData() + entry_off, sizeof(eh));
+
+    if (eh.prefix_len == 0) {
+        return QString::fromUtf8(arena_.constData() + entry_off + sizeof(eh), eh.suffix_len);
+    }
+    QByteArray text;
+    text.reserve(eh.prefix_len + eh.suffix_len);
+    text.append(arena_.constData() + eh.base_off, eh.prefix_len);
+    text.append(arena_.constData() + entry_off + sizeof(eh), eh.suffix_len);
+    return QString::fromUtf8(text);
+}
+
+void PacketListRecord::removeFromStores(uint32_t frame_num)
+{
+    for (ColumnTextStore &store : col_stores_) {
+        store.remove(frame_num);
+    }
+}
 
 PacketListRecord::PacketListRecord(frame_data *frameData) :
     fdata_(frameData),
@@ -43,6 +152,12 @@ PacketListRecord::~PacketListRecord()
 {
 }
 
+void PacketListRecord::invalidateAllRecords()
+{
+    col_text_cache_.clear();
+    col_stores_.clear();
+}
+
 void PacketListRecord::ensureColorized(capture_file *cap_file)
 {
     // packet_list_store.c:packet_list_get_value
@@ -54,8 +169,11 @@ void PacketListRecord::ensureColorized(capture_file *cap_file)
 
     bool dissect_color = !colorized_ || ( color_ver_ != rows_color_ver_ );
     if (dissect_color) {
-        /* Dissect columns only if it won't evict anything from cache */
-        bool dissect_columns = col_text_cache_.totalCost() < col_text_cache_.maxCost();
+        /* Dissect columns only if it won't evict anything from cache,
+         * unless the persistent store is on - there the whole point is to
+         * capture every row's text during the idle pass. */
+        bool dissect_columns = prefs.gui_packet_list_cache_all_column_text ||
+                               col_text_cache_.totalCost() < col_text_cache_.maxCost();
         dissect(cap_file, dissect_columns, dissect_color);
     }
 }
@@ -77,6 +195,10 @@ const QString PacketListRecord::columnString(capture_file *cap_file, int column,
     // properly colorized?
     //
     bool dissect_color = ( colorized && !colorized_ ) || ( color_ver_ != rows_color_ver_ );
+    if (!dissect_color && column < col_stores_.size() &&
+        col_stores_.at(column).contains(fdata_->num)) {
+        return col_stores_.at(column).at(fdata_->num);
+    }
     QStringList *col_text = nullptr;
     if (!dissect_color) {
         col_text = col_text_cache_.object(fdata_->num);
@@ -120,9 +242,14 @@ void PacketListRecord::dissect(capture_file *cap_file, bool dissect_columns, boo
         return;
     }
 
+    dissections_++;
     if (dissect_columns) {
+        column_dissections_++;
         cinfo = &cap_file->cinfo;
     }
+    ws_noisy("GUI thread dissection of frame %u (columns=%s, color=%s)",
+             fdata_->num, dissect_columns ? "yes" : "no",
+             dissect_color ? "yes" : "no");
 
     wtap_rec_init(&rec);
     ws_buffer_init(&buf, 1514);
@@ -222,6 +349,12 @@ void PacketListRecord::cacheColumnStrings(column_info *cinfo)
 
     QStringList *col_text = new QStringList();
 
+    if (prefs.gui_packet_list_cache_all_column_text &&
+        col_stores_.size() != cinfo->num_cols) {
+        col_stores_.clear();
+        col_stores_.resize(cinfo->num_cols);
+    }
+
     lines_ = 1;
     line_count_changed_ = false;
 
@@ -234,7 +367,12 @@ void PacketListRecord::cacheColumnStrings(column_info *cinfo)
             col_fill_in_frame_data(fdata_, cinfo, column, false);
         }
 
-        col_str = QString(get_column_text(cinfo, column));
+        const char *text = get_column_text(cinfo, column);
+        if (prefs.gui_packet_list_cache_all_column_text && text != nullptr &&
+            column < col_stores_.size()) {
+            col_stores_[column].insert(fdata_->num, text);
+        }
+        col_str = QString(text);
         *col_text << col_str;
         col_lines = static_cast<int>(col_str.count('\n'));
         if (col_lines > lines_) {
@@ -20,10 +20,11 @@
 #include <QByteArray>
 #include <QCache>
 #include <QList>
+#include <QMultiHash>
 #include <QVariant>
+#include <QVector>
 
 struct conversation;
-struct _GStringChunk;
 
 class PacketListRecord
 {
@@ -44,8 +45,8 @@ public:
     int columnTextSize(const char *str);
 
     void invalidateColorized() { colorized_ = false; }
-    void invalidateRecord() { col_text_cache_.remove(fdata_->num); }
-    static void invalidateAllRecords() { col_text_cache_.clear(); }
+    void invalidateRecord() { col_text_cache_.remove(fdata_->num); removeFromStores(fdata_->num); }
+    static void invalidateAllRecords();
     /* In Qt 6, QCache maxCost is a qsizetype, but the QAbstractItemModel
      * number of rows is still an int, so we're limited to INT_MAX anyway.
      */
@@ -53,6 +54,11 @@ public:
     static void resetColumns(column_info *cinfo);
     static void resetColorization() { rows_color_ver_++; }
 
+    // Running totals of dissections performed on the GUI thread, for
+    // the packet list performance HUD.
+    static quint64 dissectionCount() { return dissections_; }
+    static quint64 columnDissectionCount() { return column_dissections_; }
+
     inline int lineCount() { return lines_; }
     inline int lineCountChanged() { return line_count_changed_; }
 
@@ -60,11 +66,45 @@ private:
     /** The column text for some columns */
     static QCache<uint32_t, QStringList> col_text_cache_;
 
+    /** Persistent column text, when the "cache all column text" preference
+     * is enabled. Each column has its own store: an append-only arena of
+     * encoded entries plus an offset array indexed by frame number, so a
+     * record dissected once never needs redissection just to redisplay or
+     * sort, and 50M-row files don't fragment the heap with per-row string
+     * objects. Identical texts (Protocol, addresses, ports) are stored
+     * once, and an entry sharing a long prefix with the column's last
+     * uncompressed entry stores only the suffix.
+     */
+    class ColumnTextStore {
+    public:
+        bool contains(uint32_t frame_num) const;
+        void insert(uint32_t frame_num, const char *text);
+        void remove(uint32_t frame_num);
+        QString at(uint32_t frame_num) const;
+    private:
+        struct EntryHeader {
+            quint32 base_off;     // arena offset of the shared prefix bytes
+            quint32 prefix_len;
+            quint32 suffix_len;   // suffix bytes follow the header
+        };
+        bool entryEquals(quint32 entry_off, const char *text, quint32 len) const;
+        QByteArray arena_;         // append-only encoded entries
+        QVector<quint32> offsets_; // frame number - 1 -> entry offset + 1
+        QMultiHash<uint, quint32> dedupe_; // text hash -> entry offset
+        quint32 last_full_off_ = 0;  // text bytes of the last uncompressed entry
+        quint32 last_full_len_ = 0;
+    };
+    static QVector<ColumnTextStore> col_stores_;
+    static void removeFromStores(uint32_t frame_num);
+
     frame_data *fdata_;
     int lines_;
     bool line_count_changed_;
     static QMap<int, int> cinfo_column_;
 
+    static quint64 dissections_;
+    static quint64 column_dissections_;
+
     /** Has this record been colorized? */
     static unsigned int rows_color_ver_;
     unsigned int color_ver_;
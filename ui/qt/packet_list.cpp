@@ -232,8 +232,19 @@ PacketList::PacketList(QWidget *parent) :
     cur_history_(-1),
     in_history_(false),
     finfo_array(nullptr),
-    profile_switcher_(nullptr)
-{
+    profile_switcher_(nullptr),
+    hud_enabled_(qEnvironmentVariableIsSet("WIRESHARK_PACKET_LIST_HUD")),
+    hud_rows_drawn_(0),
+    hud_paints_(0),
+    hud_paint_usecs_(0),
+    hud_paint_max_usecs_(0),
+    hud_rows_(0),
+    hud_dissections_(0),
+    hud_column_dissections_(0)
+{
+    if (hud_enabled_) {
+        hud_log_timer_.start();
+    }
     setItemsExpandable(false);
     setRootIsDecorated(false);
     setSortingEnabled(prefs.gui_packet_list_sortable);
@@ -442,6 +453,10 @@ QString PacketList::joinSummaryRow(QStringList col_parts, int row, SummaryCopyTy
 
 void PacketList::drawRow (QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
+    if (hud_enabled_) {
+        hud_rows_drawn_++;
+    }
+
     QTreeView::drawRow(painter, option, index);
 
     if (prefs.gui_packet_list_separator) {
@@ -844,7 +859,50 @@ void PacketList::paintEvent(QPaintEvent *event)
     // require a new overlay, e.g. page up/down, scrolling, column
     // resizing, etc.
     create_near_overlay_ = true;
+
+    if (!hud_enabled_) {
+        QTreeView::paintEvent(event);
+        return;
+    }
+
+    quint64 dissections_before = PacketListRecord::dissectionCount();
+    quint64 column_dissections_before = PacketListRecord::columnDissectionCount();
+    hud_rows_drawn_ = 0;
+    QElapsedTimer paint_timer;
+    paint_timer.start();
+
     QTreeView::paintEvent(event);
+
+    qint64 paint_usecs = paint_timer.nsecsElapsed() / 1000;
+    hud_paints_++;
+    hud_paint_usecs_ += paint_usecs;
+    if (paint_usecs > hud_paint_max_usecs_) {
+        hud_paint_max_usecs_ = paint_usecs;
+    }
+    hud_rows_ += hud_rows_drawn_;
+    hud_dissections_ += PacketListRecord::dissectionCount() - dissections_before;
+    hud_column_dissections_ += PacketListRecord::columnDissectionCount() - column_dissections_before;
+
+    // One structured line per second rather than one per paint, so the
+    // log stays readable while scrolling.
+    if (hud_log_timer_.elapsed() >= 1000) {
+        ws_info("packet_list_hud {\"paints\":%d,\"paint_usec\":%lld,"
+                "\"paint_max_usec\":%lld,\"rows\":%d,\"dissections\":%llu,"
+                "\"column_dissections\":%llu}",
+                hud_paints_,
+                (long long) hud_paint_usecs_,
+                (long long) hud_paint_max_usecs_,
+                hud_rows_,
+                (unsigned long long) hud_dissections_,
+                (unsigned long long) hud_column_dissections_);
+        hud_paints_ = 0;
+        hud_paint_usecs_ = 0;
+        hud_paint_max_usecs_ = 0;
+        hud_rows_ = 0;
+        hud_dissections_ = 0;
+        hud_column_dissections_ = 0;
+        hud_log_timer_.restart();
+    }
 }
 
 void PacketList::mousePressEvent (QMouseEvent *event)
@@ -2012,6 +2070,17 @@ void PacketList::scrollViewChanged(bool at_end)
             emit packetListScrolled(at_end);
         }
     }
+
+    // Let the model fill its row cache around the new viewport while idle,
+    // so further scrolling mostly lands on already-dissected rows.
+    if (packet_list_model_) {
+        int first = indexAt(viewport()->rect().topLeft()).row();
+        int last = indexAt(viewport()->rect().bottomLeft()).row();
+        if (last < 0) {
+            last = packet_list_model_->rowCount() - 1;
+        }
+        packet_list_model_->setViewportRange(first, last);
+    }
 }
 
 // Goal: Overlay the packet list scroll bar with the colors of all of the
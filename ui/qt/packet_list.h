@@ -17,6 +17,7 @@
 #include <ui/qt/models/related_packet_delegate.h>
 #include <ui/qt/utils/field_information.h>
 
+#include <QElapsedTimer>
 #include <QMenu>
 #include <QTime>
 #include <QTreeView>
@@ -152,6 +153,18 @@ private:
     GPtrArray *finfo_array; // Packet data from the last selected packet entry
     ProfileSwitcher *profile_switcher_;
 
+    // Opt-in scrolling performance HUD, enabled by setting
+    // WIRESHARK_PACKET_LIST_HUD in the environment.
+    bool hud_enabled_;
+    mutable int hud_rows_drawn_; // rows materialized by the current paint
+    QElapsedTimer hud_log_timer_;
+    int hud_paints_;
+    qint64 hud_paint_usecs_;
+    qint64 hud_paint_max_usecs_;
+    int hud_rows_;
+    quint64 hud_dissections_;
+    quint64 hud_column_dissections_;
+
     void setFrameReftime(bool set, frame_data *fdata);
     void setColumnVisibility();
     int sizeHintForColumn(int column) const override;
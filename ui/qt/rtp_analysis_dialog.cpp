@@ -328,10 +328,6 @@ RtpAnalysisDialog::~RtpAnalysisDialog()
 
 void RtpAnalysisDialog::deleteTabInfo(tab_info_t *tab_info)
 {
-    delete tab_info->time_vals;
-    delete tab_info->jitter_vals;
-    delete tab_info->diff_vals;
-    delete tab_info->delta_vals;
     delete tab_info->tab_name;
     // tab_info->tree_widget was deleted by ui
     // tab_info->statistics_label was deleted by ui
@@ -718,10 +714,6 @@ void RtpAnalysisDialog::resetStatistics()
 
         tab->stream.rtp_stats.first_packet = true;
         tab->stream.rtp_stats.reg_pt = PT_UNDEFINED;
-        tab->time_vals->clear();
-        tab->jitter_vals->clear();
-        tab->diff_vals->clear();
-        tab->delta_vals->clear();
         tab->tree_widget->clear();
     }
 
@@ -734,10 +726,14 @@ void RtpAnalysisDialog::addPacket(tab_info_t *tab, packet_info *pinfo, const _rt
 {
     rtpstream_info_analyse_process(&tab->stream, pinfo, rtpinfo);
     new RtpAnalysisTreeWidgetItem(tab->tree_widget, &tab->stream.rtp_stats, pinfo, rtpinfo);
-    tab->time_vals->append(tab->stream.rtp_stats.time / 1000);
-    tab->jitter_vals->append(tab->stream.rtp_stats.jitter);
-    tab->diff_vals->append(tab->stream.rtp_stats.diff);
-    tab->delta_vals->append(tab->stream.rtp_stats.delta);
+
+    /* Append the graph points right away instead of buffering them in
+     * side vectors; packets arrive in capture order, so the keys are
+     * already sorted and the containers just grow at the end. */
+    double ts = tab->stream.rtp_stats.time / 1000;
+    tab->jitter_graph->data()->add(QCPGraphData(ts, tab->stream.rtp_stats.jitter));
+    tab->diff_graph->data()->add(QCPGraphData(ts, tab->stream.rtp_stats.diff));
+    tab->delta_graph->data()->add(QCPGraphData(ts, tab->stream.rtp_stats.delta));
 }
 
 void RtpAnalysisDialog::updateStatistics()
@@ -793,9 +789,6 @@ void RtpAnalysisDialog::updateStatistics()
             tabs_[i]->tree_widget->resizeColumnToContents(col);
         }
 
-        tabs_[i]->jitter_graph->setData(*tabs_[i]->time_vals, *tabs_[i]->jitter_vals);
-        tabs_[i]->diff_graph->setData(*tabs_[i]->time_vals, *tabs_[i]->diff_vals);
-        tabs_[i]->delta_graph->setData(*tabs_[i]->time_vals, *tabs_[i]->delta_vals);
     }
 
     updateGraph();
@@ -1073,10 +1066,6 @@ void RtpAnalysisDialog::addRtpStreamsPrivate(QVector<rtpstream_id_t *> stream_id
 
             tab_info_t *new_tab = g_new0(tab_info_t, 1);
             rtpstream_id_copy(id, &(new_tab->stream.id));
-            new_tab->time_vals = new QVector<double>();
-            new_tab->jitter_vals = new QVector<double>();
-            new_tab->diff_vals = new QVector<double>();
-            new_tab->delta_vals = new QVector<double>();
             tabs_ << new_tab;
             cur_tab_no = addTabUI(new_tab);
             tab_hash_.insert(rtpstream_id_to_hash(id), new_tab);
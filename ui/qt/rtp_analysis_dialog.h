@@ -40,10 +40,6 @@ class QDialogButtonBox;
 
 typedef struct {
     rtpstream_info_t stream;
-    QVector<double> *time_vals;
-    QVector<double> *jitter_vals;
-    QVector<double> *diff_vals;
-    QVector<double> *delta_vals;
     QTreeWidget *tree_widget;
     QLabel *statistics_label;
     QString *tab_name;
@@ -45,6 +45,11 @@ enum {
     wide_chars_
 };
 
+// How long to wait after the last keystroke before validating the search
+// text. Long enough to coalesce bursts of typing, short enough that the
+// syntax feedback still feels immediate.
+static const int validate_timeout_ = 200; // ms
+
 SearchFrame::SearchFrame(QWidget *parent) :
     AccordionFrame(parent),
     sf_ui_(new Ui::SearchFrame),
@@ -71,6 +76,10 @@ SearchFrame::SearchFrame(QWidget *parent) :
     }
 
 
+    validate_timer_.setSingleShot(true);
+    validate_timer_.setInterval(validate_timeout_);
+    connect(&validate_timer_, &QTimer::timeout, this, &SearchFrame::updateWidgets);
+
     applyRecentSearchSettings();
 
     updateWidgets();
@@ -386,7 +395,8 @@ void SearchFrame::on_searchTypeComboBox_currentIndexChanged(int idx)
 
 void SearchFrame::on_searchLineEdit_textChanged(const QString &)
 {
-    updateWidgets();
+    // Wait for the typing to pause instead of validating every keystroke.
+    validate_timer_.start();
 }
 
 void SearchFrame::on_dirCheckBox_toggled(bool checked)
@@ -412,6 +422,13 @@ void SearchFrame::on_findButton_clicked()
         return;
     }
 
+    if (validate_timer_.isActive()) {
+        // Flush a pending validation so that regex_ and the syntax state
+        // match what's in the text box.
+        validate_timer_.stop();
+        updateWidgets();
+    }
+
     cap_file_->hex = false;
     cap_file_->string = false;
     cap_file_->case_type = false;
@@ -16,6 +16,8 @@
 
 #include "cfile.h"
 
+#include <QTimer>
+
 namespace Ui {
 class SearchFrame;
 }
@@ -49,6 +51,9 @@ private:
     capture_file *cap_file_;
     ws_regex_t *regex_;
     QString regex_error_;
+    // Debounces per-keystroke validation, which can recompile a regex or
+    // reconvert a hex string on every character.
+    QTimer validate_timer_;
 
 private slots:
     void on_searchInComboBox_currentIndexChanged(int idx);
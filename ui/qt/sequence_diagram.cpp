@@ -23,35 +23,22 @@
 #include <QPalette>
 #include <QPen>
 #include <QPointF>
+#include <QtMath>
 
 const int max_comment_em_width_ = 20;
 
 // UML-like network node sequence diagrams.
 // https://developer.ibm.com/articles/the-sequence-diagram/
 
-WSCPSeqData::WSCPSeqData() :
-  key(0),
-  value(NULL)
-{
-}
-
-WSCPSeqData::WSCPSeqData(double key, struct _seq_analysis_item *value) :
-  key(key),
-  value(value)
-{
-}
-
 SequenceDiagram::SequenceDiagram(QCPAxis *keyAxis, QCPAxis *valueAxis, QCPAxis *commentAxis) :
     QCPAbstractPlottable(keyAxis, valueAxis),
     key_axis_(keyAxis),
     value_axis_(valueAxis),
     comment_axis_(commentAxis),
-    data_(NULL),
     sainfo_(NULL),
     selected_packet_(0),
     selected_key_(-1.0)
 {
-    data_ = new WSCPSeqDataMap();
     // xaxis (value): Address
     // yaxis (key): Time
     // yaxis2 (comment): Extra info ("Comment" in GTK+)
@@ -71,8 +58,12 @@ SequenceDiagram::SequenceDiagram(QCPAxis *keyAxis, QCPAxis *valueAxis, QCPAxis *
         axis->setSelectedTickPen(no_pen);
     }
 
-    QSharedPointer<QCPAxisTicker> ticker(new QCPAxisTickerElided(comment_axis_));
-    comment_axis_->setTicker(ticker);
+    // The time and comment labels are pulled from the sequence items for
+    // the visible rows on each replot instead of being built up front.
+    QSharedPointer<QCPAxisTicker> key_ticker(new SequenceDiagramTicker(this, key_axis_, false));
+    key_axis_->setTicker(key_ticker);
+    QSharedPointer<QCPAxisTicker> comment_ticker(new SequenceDiagramTicker(this, comment_axis_, true));
+    comment_axis_->setTicker(comment_ticker);
 
     value_axis_->grid()->setVisible(false);
 
@@ -104,47 +95,33 @@ SequenceDiagram::SequenceDiagram(QCPAxis *keyAxis, QCPAxis *valueAxis, QCPAxis *
 
 SequenceDiagram::~SequenceDiagram()
 {
-    delete data_;
 }
 
 int SequenceDiagram::adjacentPacket(bool next)
 {
     int adjacent_packet = -1;
-    WSCPSeqDataMap::const_iterator it;
 
-    if (data_->size() < 1) return adjacent_packet;
+    if (data_.size() < 1) return adjacent_packet;
 
     if (selected_packet_ < 1) {
-        if (next) {
-            it = data_->constBegin();
-        } else {
-            it = data_->constEnd();
-            --it;
-        }
-        selected_key_ = it.value().key;
-        return it.value().value->frame_number;
+        int key = next ? 0 : itemCount() - 1;
+        selected_key_ = key;
+        return data_.at(key)->frame_number;
     }
 
     if (next) {
-        for (it = data_->constBegin(); it != data_->constEnd(); ++it) {
-            if (it.value().value->frame_number == selected_packet_) {
-                ++it;
-                if (it != data_->constEnd()) {
-                    adjacent_packet = it.value().value->frame_number;
-                    selected_key_ = it.value().key;
-                }
+        for (int key = 0; key < itemCount() - 1; key++) {
+            if (data_.at(key)->frame_number == selected_packet_) {
+                adjacent_packet = data_.at(key + 1)->frame_number;
+                selected_key_ = key + 1;
                 break;
             }
         }
     } else {
-        it = data_->constEnd();
-        --it;
-        while (it != data_->constBegin()) {
-            uint32_t prev_frame = it.value().value->frame_number;
-            --it;
-            if (prev_frame == selected_packet_) {
-                adjacent_packet = it.value().value->frame_number;
-                selected_key_ = it.value().key;
+        for (int key = itemCount() - 1; key > 0; key--) {
+            if (data_.at(key)->frame_number == selected_packet_) {
+                adjacent_packet = data_.at(key - 1)->frame_number;
+                selected_key_ = key - 1;
                 break;
             }
         }
@@ -155,30 +132,22 @@ int SequenceDiagram::adjacentPacket(bool next)
 
 void SequenceDiagram::setData(_seq_analysis_info *sainfo)
 {
-    data_->clear();
+    data_.clear();
     sainfo_ = sainfo;
     if (!sainfo) return;
 
-    double cur_key = 0.0;
-    QVector<double> key_ticks, val_ticks;
-    QVector<QString> key_labels, val_labels, com_labels;
+    QVector<double> val_ticks;
+    QVector<QString> val_labels;
     char* addr_str;
 
+    // Only the display items are kept, in key order. Their time and
+    // comment labels stay in the items themselves; the axis tickers fetch
+    // them for the visible rows when we're replotted.
+    data_.reserve(g_queue_get_length(sainfo->items));
     for (GList *cur = g_queue_peek_nth_link(sainfo->items, 0); cur; cur = gxx_list_next(cur)) {
         seq_analysis_item_t *sai = gxx_list_data(seq_analysis_item_t *, cur);
         if (sai->display) {
-            WSCPSeqData new_data;
-
-            new_data.key = cur_key;
-            new_data.value = sai;
-            data_->insert(new_data.key, new_data);
-
-            key_ticks.append(cur_key);
-            key_labels.append(sai->time_str);
-
-            com_labels.append(sai->comment);
-
-            cur_key++;
+            data_.append(sai);
         }
     }
 
@@ -193,12 +162,8 @@ void SequenceDiagram::setData(_seq_analysis_info *sainfo)
         wmem_free(Q_NULLPTR, addr_str);
     }
 
-    QSharedPointer<QCPAxisTickerText> key_ticker = qSharedPointerCast<QCPAxisTickerText>(keyAxis()->ticker());
-    key_ticker->setTicks(key_ticks, key_labels);
     QSharedPointer<QCPAxisTickerText> value_ticker = qSharedPointerCast<QCPAxisTickerText>(valueAxis()->ticker());
     value_ticker->setTicks(val_ticks, val_labels);
-    QSharedPointer<QCPAxisTickerText> comment_ticker = qSharedPointerCast<QCPAxisTickerText>(comment_axis_->ticker());
-    comment_ticker->setTicks(key_ticks, com_labels);
 }
 
 void SequenceDiagram::setSelectedPacket(int selected_packet)
@@ -214,10 +179,10 @@ void SequenceDiagram::setSelectedPacket(int selected_packet)
 
 _seq_analysis_item *SequenceDiagram::itemForPosY(int ypos)
 {
-    double key_pos = qRound(key_axis_->pixelToCoord(ypos));
+    int key_pos = qRound(key_axis_->pixelToCoord(ypos));
 
-    if (key_pos >= 0 && key_pos < data_->size()) {
-        return data_->value(key_pos).value;
+    if (key_pos >= 0 && key_pos < itemCount()) {
+        return data_.at(key_pos);
     }
     return NULL;
 }
@@ -238,9 +203,9 @@ QString SequenceDiagram::elidedComment(const QString &text) const
 
 double SequenceDiagram::selectTest(const QPointF &pos, bool, QVariant *) const
 {
-    double key_pos = qRound(key_axis_->pixelToCoord(pos.y()));
+    int key_pos = qRound(key_axis_->pixelToCoord(pos.y()));
 
-    if (key_pos >= 0 && key_pos < data_->size()) {
+    if (key_pos >= 0 && key_pos < itemCount()) {
         return 1.0;
     }
 
@@ -268,17 +233,33 @@ void SequenceDiagram::draw(QCPPainter *painter)
     painter->restore();
     fg_pen = pen();
 
-    WSCPSeqDataMap::const_iterator it;
-    for (it = data_->constBegin(); it != data_->constEnd(); ++it) {
-        double cur_key = it.key();
-        seq_analysis_item_t *sai = it.value().value;
+    // selectedKey() has to be valid even when the selected item is scrolled
+    // out of view, so look it up separately instead of while drawing.
+    if (selected_packet_ > 0) {
+        int sel_key = qRound(selected_key_);
+        if (sel_key < 0 || sel_key >= itemCount() ||
+            data_.at(sel_key)->frame_number != selected_packet_) {
+            selected_key_ = -1.0;
+            for (int key = 0; key < itemCount(); key++) {
+                if (data_.at(key)->frame_number == selected_packet_) {
+                    selected_key_ = key;
+                }
+            }
+        }
+    }
+
+    // Rows are a key unit tall, so only the ones within half a unit of the
+    // key range can touch the visible area.
+    int first_key = qMax(0, qCeil(key_axis_->range().lower - 0.5));
+    int last_key = qMin(itemCount() - 1, qFloor(key_axis_->range().upper + 0.5));
+    for (int cur_key = first_key; cur_key <= last_key; cur_key++) {
+        seq_analysis_item_t *sai = data_.at(cur_key);
         QColor bg_color;
 
         if (sai->frame_number == selected_packet_) {
             QPalette sel_pal;
             fg_pen.setColor(sel_pal.color(QPalette::HighlightedText));
             bg_color = sel_pal.color(QPalette::Highlight);
-            selected_key_ = cur_key;
         } else if ((sai->has_color_filter) && (recent.packet_list_colorize)) {
             fg_pen.setColor(QColor().fromRgb(sai->fg_color));
             bg_color = QColor().fromRgb(sai->bg_color);
@@ -386,18 +367,10 @@ QCPRange SequenceDiagram::getKeyRange(bool &validRange, QCP::SignDomain) const
     QCPRange range;
     bool valid = false;
 
-    WSCPSeqDataMap::const_iterator it = data_->constBegin();
-    while (it != data_->constEnd()) {
-        double cur_key = it.key();
-        if (!valid) {
-            range.lower = range.upper = cur_key;
-            valid = true;
-        } else if (cur_key < range.lower) {
-            range.lower = cur_key;
-        } else if (cur_key > range.upper) {
-            range.upper = cur_key;
-        }
-        ++it;
+    if (!data_.isEmpty()) {
+        range.lower = 0;
+        range.upper = data_.size() - 1;
+        valid = true;
     }
     validRange = valid;
     return range;
@@ -410,9 +383,44 @@ QCPRange SequenceDiagram::getValueRange(bool &validRange, QCP::SignDomain, const
 
     if (sainfo_) {
         range.lower = 0;
-        range.upper = data_->size();
+        range.upper = data_.size();
         valid = true;
     }
     validRange = valid;
     return range;
 }
+
+SequenceDiagramTicker::SequenceDiagramTicker(SequenceDiagram *diagram, QCPAxis *parent, bool comments) :
+    QCPAxisTickerElided(parent),
+    diagram_(diagram),
+    comments_(comments)
+{
+}
+
+QVector<double> SequenceDiagramTicker::createTickVector(double tickStep, const QCPRange &range)
+{
+    Q_UNUSED(tickStep)
+    QVector<double> result;
+
+    // One tick per row. The dialog never zooms the key axis, so the range
+    // only ever covers on the order of a screenful of rows.
+    int first_key = qMax(0, qCeil(range.lower));
+    int last_key = qMin(diagram_->itemCount() - 1, qFloor(range.upper));
+    for (int key = first_key; key <= last_key; key++) {
+        result.append(key);
+    }
+    return result;
+}
+
+QString SequenceDiagramTicker::getTickLabel(double tick, const QLocale&, QChar, int)
+{
+    int key = qRound(tick);
+    if (key < 0 || key >= diagram_->itemCount()) {
+        return QString();
+    }
+    seq_analysis_item_t *sai = diagram_->itemAt(key);
+    if (comments_) {
+        return elidedText(sai->comment);
+    }
+    return sai->time_str;
+}
@@ -15,24 +15,13 @@
 #include <epan/address.h>
 
 #include <QObject>
-#include <QMultiMap>
+#include <QVector>
 #include <ui/qt/widgets/qcustomplot.h>
+#include <ui/qt/widgets/qcp_axis_ticker_elided.h>
 
 struct _seq_analysis_info;
 struct _seq_analysis_item;
 
-// Some of this is probably unnecessary
-class WSCPSeqData
-{
-public:
-  WSCPSeqData();
-  WSCPSeqData(double key, _seq_analysis_item *value);
-  double key;
-  struct _seq_analysis_item *value;
-};
-
-typedef QMultiMap<double, WSCPSeqData> WSCPSeqDataMap;
-
 class SequenceDiagram : public QCPAbstractPlottable
 {
     Q_OBJECT
@@ -51,11 +40,15 @@ public:
 
     // non-property methods:
     struct _seq_analysis_item *itemForPosY(int ypos);
+    // Number of displayed items and the item at a given key position.
+    // Used by SequenceDiagramTicker to create tick labels on demand.
+    int itemCount() const { return static_cast<int>(data_.size()); }
+    struct _seq_analysis_item *itemAt(int key) const { return data_.at(key); }
     bool inComment(QPoint pos) const;
     QString elidedComment(const QString &text) const;
 
     // reimplemented virtual methods:
-    virtual void clearData() { data_->clear(); }
+    virtual void clearData() { data_.clear(); }
     virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details=0) const Q_DECL_OVERRIDE;
 
 public slots:
@@ -71,10 +64,29 @@ private:
     QCPAxis *key_axis_;
     QCPAxis *value_axis_;
     QCPAxis *comment_axis_;
-    WSCPSeqDataMap *data_;
+    // Displayed items in key order. The key for an item is its index,
+    // so we don't have to materialize per-item tick positions.
+    QVector<struct _seq_analysis_item *> data_;
     struct _seq_analysis_info *sainfo_;
     uint32_t selected_packet_;
     double selected_key_;
 };
 
+// Ticker for the time (key) and comment axes. Instead of pre-building a
+// label string for every row when the diagram is filled, fetch the labels
+// for the handful of visible rows from the sequence items each replot.
+class SequenceDiagramTicker : public QCPAxisTickerElided
+{
+public:
+    explicit SequenceDiagramTicker(SequenceDiagram *diagram, QCPAxis *parent, bool comments);
+
+protected:
+    virtual QVector<double> createTickVector(double tickStep, const QCPRange &range) override;
+    virtual QString getTickLabel(double tick, const QLocale &locale, QChar formatChar, int precision) override;
+
+private:
+    SequenceDiagram *diagram_;
+    bool comments_;
+};
+
 #endif // SEQUENCE_DIAGRAM_H
@@ -70,9 +70,13 @@ StatsTreeDialog::StatsTreeDialog(QWidget &parent, CaptureFile &cf, const char *c
 
 StatsTreeDialog::~StatsTreeDialog()
 {
+    removeTapListeners();
     if (st_) {
         stats_tree_free(st_);
     }
+    if (st_cfg_ && st_cfg_->pr == &cfg_pr_) {
+        st_cfg_->pr = NULL;
+    }
 }
 
 // Adds a node to the QTreeWidget
@@ -110,6 +114,7 @@ void StatsTreeDialog::fillTree()
     st_cfg_->pr = &cfg_pr_;
     cfg_pr_.st_dlg = this;
 
+    removeTapListeners();
     if (st_) {
         stats_tree_free(st_);
     }
@@ -139,8 +144,11 @@ void StatsTreeDialog::fillTree()
     cap_file_.retapPackets();
     drawTreeItems(st_);
 
-    removeTapListeners();
-    st_cfg_->pr = NULL;
+    /* Keep the tap listener attached: during a live capture each newly
+     * dissected frame is fed to it exactly once, so the tree keeps growing
+     * incrementally without ever re-walking the frames already counted.
+     * The listener is removed when the filter is reapplied, the capture
+     * file closes or the dialog goes away. */
 
     statsTreeWidget()->setSortingEnabled(true);
     statsTreeWidget()->resizeColumnToContents(item_col_);
@@ -152,7 +160,9 @@ void StatsTreeDialog::resetTap(void *st_ptr)
     if (!st || !st->cfg || !st->cfg->pr || !st->cfg->pr->st_dlg) return;
 
     st->cfg->pr->st_dlg->statsTreeWidget()->clear();
-    st->cfg->init(st);
+    /* A rescan re-feeds every frame, so drop the accumulated nodes and
+     * counters; cfg->init runs again from stats_tree_reinit. */
+    stats_tree_reinit(st);
 }
 
 void StatsTreeDialog::drawTreeItems(void *st_ptr)
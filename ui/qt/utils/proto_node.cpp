@@ -12,26 +12,34 @@
 
 #include <epan/prefs.h>
 
-// NOLINTNEXTLINE(misc-no-recursion)
 ProtoNode::ProtoNode(proto_node *node, ProtoNode *parent) :
-    node_(node), parent_(parent)
+    node_(node), children_built_(false), parent_(parent)
 {
-    if (node_) {
+}
 
-        int num_children = 0;
-        for (proto_node *child = node_->first_child; child; child = child->next) {
-            if (!isHidden(child)) {
-                num_children++;
-            }
+void ProtoNode::ensureChildren() const
+{
+    if (children_built_) {
+        return;
+    }
+    children_built_ = true;
+    if (!node_) {
+        return;
+    }
+
+    int num_children = 0;
+    for (proto_node *child = node_->first_child; child; child = child->next) {
+        if (!isHidden(child)) {
+            num_children++;
         }
+    }
 
-        m_children.reserve(num_children);
+    m_children.reserve(num_children);
 
-        for (proto_node *child = node_->first_child; child; child = child->next) {
-            if (!isHidden(child)) {
-                // We recurse here, but we're limited by tree depth checks in epan
-                m_children.append(new ProtoNode(child, this));
-            }
+    for (proto_node *child = node_->first_child; child; child = child->next) {
+        if (!isHidden(child)) {
+            // Only this level; grandchildren are built when they're needed.
+            m_children.append(new ProtoNode(child, const_cast<ProtoNode *>(this)));
         }
     }
 }
@@ -93,6 +101,7 @@ int ProtoNode::childrenCount() const
 {
     if (!node_) return 0;
 
+    ensureChildren();
     return (int)m_children.count();
 }
 
@@ -102,6 +111,7 @@ int ProtoNode::row()
         return -1;
     }
 
+    // If we exist, our parent has built its child list.
     return (int)parent_->m_children.indexOf(const_cast<ProtoNode*>(this));
 }
 
@@ -120,6 +130,7 @@ proto_node * ProtoNode::protoNode() const
 
 ProtoNode* ProtoNode::child(int row)
 {
+    ensureChildren();
     if (row < 0 || row >= m_children.size())
         return nullptr;
     return m_children.at(row);
@@ -54,8 +54,12 @@ public:
 
 private:
     proto_node * node_;
-    QVector<ProtoNode*>m_children;
+    // The wrappers for our children, built on first access. Collapsed
+    // subtrees that are never shown are never wrapped.
+    mutable QVector<ProtoNode*>m_children;
+    mutable bool children_built_;
     ProtoNode *parent_;
+    void ensureChildren() const;
     static bool isHidden(proto_node * node);
 };
 
@@ -188,6 +188,29 @@ bool ByteViewText::isEmpty() const
     return data_.isEmpty();
 }
 
+void ByteViewText::setData(const QByteArray &data, packet_char_enc encoding)
+{
+    data_ = data;
+    encoding_ = encoding;
+
+    // Match a freshly constructed widget; our marks belonged to the old data.
+    hovered_byte_offset_ = -1;
+    marked_byte_offset_ = -1;
+    proto_start_ = 0;
+    proto_len_ = 0;
+    field_start_ = 0;
+    field_len_ = 0;
+    field_a_start_ = 0;
+    field_a_len_ = 0;
+
+    line_cache_.clear();
+    x_pos_to_column_.clear();
+
+    verticalScrollBar()->setValue(0);
+    updateScrollbars();
+    viewport()->update();
+}
+
 QSize ByteViewText::minimumSizeHint() const
 {
     // Allow panel to shrink to any size
@@ -251,6 +274,9 @@ void ByteViewText::updateByteViewSettings()
 {
     row_width_ = recent.gui_bytes_view == BYTES_BITS ? 8 : 16;
 
+    // The bytes-as and text-as settings change the composed row text.
+    line_cache_.clear();
+
     updateContextMenu();
     updateScrollbars();
     viewport()->update();
@@ -432,6 +458,59 @@ void ByteViewText::drawLine(QPainter *painter, const int offset, const int row_y
     QString line;
     HighlightMode offset_mode = ModeOffsetNormal;
 
+    int row = offset / row_width_;
+    if (row >= line_cache_.size()) {
+        line_cache_.resize(row + 1);
+    }
+    CachedLine &cached = line_cache_[row];
+    // Hovered and marked bytes need the intermediate string widths below,
+    // so those rows (at most two) always take the slow path.
+    bool highlight_in_row =
+            (hovered_byte_offset_ >= offset && hovered_byte_offset_ <= max_tvb_pos) ||
+            (marked_byte_offset_ >= offset && marked_byte_offset_ <= max_tvb_pos);
+
+    if (cached.valid && !build_x_pos && !highlight_in_row) {
+        // Reuse the composed text and only rebuild the highlight ranges,
+        // which are computed from offsets, not from the text.
+        line = cached.text;
+
+        if (show_hex_) {
+            addHexFormatRange(fmt_list, proto_start_, proto_len_, offset, max_tvb_pos, ModeProtocol);
+            if (addHexFormatRange(fmt_list, field_start_, field_len_, offset, max_tvb_pos, ModeField)) {
+                offset_mode = ModeOffsetField;
+            }
+            addHexFormatRange(fmt_list, field_a_start_, field_a_len_, offset, max_tvb_pos, ModeField);
+        }
+
+        if (show_ascii_) {
+            foreach (const auto &np_run, cached.np_runs) {
+                addAsciiFormatRange(fmt_list, np_run.first, np_run.second, offset, max_tvb_pos, ModeNonPrintable);
+            }
+            addAsciiFormatRange(fmt_list, proto_start_, proto_len_, offset, max_tvb_pos, ModeProtocol);
+            if (addAsciiFormatRange(fmt_list, field_start_, field_len_, offset, max_tvb_pos, ModeField)) {
+                offset_mode = ModeOffsetField;
+            }
+            addAsciiFormatRange(fmt_list, field_a_start_, field_a_len_, offset, max_tvb_pos, ModeField);
+        }
+
+        // XXX Fields won't be highlighted if neither hex nor ascii are enabled.
+        addFormatRange(fmt_list, 0, offsetChars(), offset_mode);
+
+        layout_->clearLayout();
+        layout_->clearFormats();
+        layout_->setText(line);
+        layout_->setFormats(fmt_list.toVector());
+        layout_->beginLayout();
+        QTextLine tl = layout_->createLine();
+        tl.setLineWidth(totalPixels());
+        tl.setLeadingIncluded(true);
+        layout_->endLayout();
+        layout_->draw(painter, QPointF(0.0, row_y));
+        return;
+    }
+
+    QVector<QPair<int, int> > np_runs;
+
     // Offset.
     if (show_offset_) {
         line = QString(" %1 ").arg(offset, offsetChars(false), 16, QChar('0'));
@@ -545,7 +624,7 @@ void ByteViewText::drawLine(QPainter *painter, const int offset, const int row_y
                 line += c;
                 if (in_non_printable) {
                     in_non_printable = false;
-                    addAsciiFormatRange(fmt_list, np_start, np_len, offset, max_tvb_pos, ModeNonPrintable);
+                    np_runs.append(qMakePair(np_start, np_len));
                 }
             } else {
                 line += UTF8_MIDDLE_DOT;
@@ -568,7 +647,10 @@ void ByteViewText::drawLine(QPainter *painter, const int offset, const int row_y
             }
         }
         if (in_non_printable) {
-            addAsciiFormatRange(fmt_list, np_start, np_len, offset, max_tvb_pos, ModeNonPrintable);
+            np_runs.append(qMakePair(np_start, np_len));
+        }
+        foreach (const auto &np_run, np_runs) {
+            addAsciiFormatRange(fmt_list, np_run.first, np_run.second, offset, max_tvb_pos, ModeNonPrintable);
         }
         addAsciiFormatRange(fmt_list, proto_start_, proto_len_, offset, max_tvb_pos, ModeProtocol);
         if (addAsciiFormatRange(fmt_list, field_start_, field_len_, offset, max_tvb_pos, ModeField)) {
@@ -577,6 +659,10 @@ void ByteViewText::drawLine(QPainter *painter, const int offset, const int row_y
         addAsciiFormatRange(fmt_list, field_a_start_, field_a_len_, offset, max_tvb_pos, ModeField);
     }
 
+    cached.text = line;
+    cached.np_runs = np_runs;
+    cached.valid = true;
+
     // XXX Fields won't be highlighted if neither hex nor ascii are enabled.
     addFormatRange(fmt_list, 0, offsetChars(), offset_mode);
 
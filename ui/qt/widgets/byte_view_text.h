@@ -41,6 +41,9 @@ public:
 
     void setFormat(bytes_view_type format);
     bool isEmpty() const;
+    // Replace our data in place, e.g. when the selected packet changes.
+    // Resets any highlights and scrolls back to the top.
+    void setData(const QByteArray &data, packet_char_enc encoding);
 
 signals:
     void byteHovered(int pos);
@@ -79,6 +82,16 @@ private:
     QTextLayout *layout_;
     QByteArray data_;
 
+    // A composed row of text. The text and the non-printable character
+    // runs depend only on the data and the display settings, so we keep
+    // them across repaints and only rebuild the highlight ranges.
+    struct CachedLine {
+        QString text;
+        QVector<QPair<int, int> > np_runs; // Non-printable (offset, length) runs.
+        bool valid = false;
+    };
+    QVector<CachedLine> line_cache_;
+
     void updateLayoutMetrics();
     int stringWidth(const QString &line);
     void drawLine(QPainter *painter, const int offset, const int row_y);
@@ -28412,10 +28412,45 @@ void QCPErrorBars::draw(QCPPainter *painter)
     }
     backbones.clear();
     whiskers.clear();
+    // For vertical error bars, consolidate bars that fall into the same key
+    // pixel column: once a column's value span is covered by an already
+    // collected bar, further bars inside that span can't change a single
+    // pixel, so skip them. This keeps the number of drawn lines proportional
+    // to the widget width instead of the data size, analogous to what
+    // QCPGraph's adaptive sampling does for lines and scatters.
+    const bool consolidateColumns = (mErrorType == etValueError);
+    int lastPixelColumn = (std::numeric_limits<int>::min)();
+    double coveredMin = 0;
+    double coveredMax = 0;
     for (QCPErrorBarsDataContainer::const_iterator it=begin; it!=end; ++it)
     {
-      if (!checkPointVisibility || errorBarVisible(int(it-mDataContainer->constBegin())))
-        getErrorBarLines(it, backbones, whiskers);
+      const int index = int(it-mDataContainer->constBegin());
+      if (checkPointVisibility && !errorBarVisible(index))
+        continue;
+      if (consolidateColumns)
+      {
+        const double key = mDataPlottable->interface1D()->dataMainKey(index);
+        const double value = mDataPlottable->interface1D()->dataMainValue(index);
+        if (!qIsNaN(value) && !qIsNaN(it->errorMinus) && !qIsNaN(it->errorPlus))
+        {
+          const double barMin = value-it->errorMinus;
+          const double barMax = value+it->errorPlus;
+          const int pixelColumn = int(mKeyAxis->coordToPixel(key));
+          if (pixelColumn == lastPixelColumn)
+          {
+            if (barMin >= coveredMin && barMax <= coveredMax)
+              continue;
+            coveredMin = qMin(coveredMin, barMin);
+            coveredMax = qMax(coveredMax, barMax);
+          } else
+          {
+            lastPixelColumn = pixelColumn;
+            coveredMin = barMin;
+            coveredMax = barMax;
+          }
+        }
+      }
+      getErrorBarLines(it, backbones, whiskers);
     }
     painter->drawLines(backbones);
     painter->drawLines(whiskers);
@@ -41,7 +41,13 @@ export_pdu_packet(void *tapdata, packet_info *pinfo, epan_dissect_t *edt, const
 
     memset(&rec, 0, sizeof rec);
     buffer_len = exp_pdu_data->tvb_captured_length + exp_pdu_data->tlv_buffer_len;
-    packet_buf = (uint8_t *)g_malloc(buffer_len);
+    /* Assemble the record in a buffer that is reused (and only ever grown)
+     * across packets rather than allocated per packet. */
+    if ((unsigned)buffer_len > exp_pdu_tap_data->packet_buf_size) {
+        exp_pdu_tap_data->packet_buf = (uint8_t *)g_realloc(exp_pdu_tap_data->packet_buf, buffer_len);
+        exp_pdu_tap_data->packet_buf_size = buffer_len;
+    }
+    packet_buf = exp_pdu_tap_data->packet_buf;
 
     if(exp_pdu_data->tlv_buffer_len > 0){
         memcpy(packet_buf, exp_pdu_data->tlv_buffer, exp_pdu_data->tlv_buffer_len);
@@ -76,8 +82,6 @@ export_pdu_packet(void *tapdata, packet_info *pinfo, epan_dissect_t *edt, const
         status = TAP_PACKET_FAILED;
     }
 
-    g_free(packet_buf);
-
     return status;
 }
 
@@ -176,6 +180,8 @@ exp_pdu_open(exp_pdu_t *exp_pdu_tap_data, char *pathname,
 
     exp_pdu_tap_data->pathname = pathname;
     exp_pdu_tap_data->framenum = 0; /* No frames written yet */
+    exp_pdu_tap_data->packet_buf = NULL;
+    exp_pdu_tap_data->packet_buf_size = 0;
     return true;
 }
 
@@ -189,6 +195,10 @@ exp_pdu_close(exp_pdu_t *exp_pdu_tap_data, int *err, char **err_info)
     wtap_block_array_free(exp_pdu_tap_data->shb_hdrs);
     wtap_free_idb_info(exp_pdu_tap_data->idb_inf);
 
+    g_free(exp_pdu_tap_data->packet_buf);
+    exp_pdu_tap_data->packet_buf = NULL;
+    exp_pdu_tap_data->packet_buf_size = 0;
+
     remove_tap_listener(exp_pdu_tap_data);
     return status;
 }
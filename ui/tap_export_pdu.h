@@ -23,6 +23,8 @@ typedef struct _exp_pdu_t {
     GArray* shb_hdrs;
     wtapng_iface_descriptions_t* idb_inf;
     uint32_t     framenum;
+    uint8_t*     packet_buf;        /**< Reusable record assembly buffer. */
+    unsigned     packet_buf_size;
 } exp_pdu_t;
 
 /**
@@ -1544,6 +1544,132 @@ parse_token(token_t token, char *str)
     return IMPORT_SUCCESS;
 }
 
+/*----------------------------------------------------------------------
+ * Line-oriented scanner.
+ *
+ * The flex scanner in text_import_scanner.l hands the state machine one
+ * token at a time, which dominates the import time on very large dumps.
+ * This scanner reads whole lines, classifies whitespace-separated words
+ * the same way the flex rules would, and, for the common case of a run
+ * of two-digit byte values, decodes them straight into the packet
+ * buffer instead of making a parse_token() round trip per byte.
+ *
+ * The hex+ASCII identification heuristic (-a) depends on the scanner's
+ * byte-by-byte lookback, so that mode still goes through the flex
+ * scanner.
+ */
+
+/*
+ * Process one line of input, stripped of its line ending.
+ */
+static import_status_t
+process_line(char *line, size_t len)
+{
+    char *p = line;
+    char *end = line + len;
+
+    /* Directives and comments are anchored to the start of the line. */
+    if (g_str_has_prefix(line, "#TEXT2PCAP")) {
+        if (parse_token(T_DIRECTIVE, line) != IMPORT_SUCCESS)
+            return IMPORT_FAILURE;
+        return parse_token(T_EOL, NULL);
+    }
+    for (p = line; *p == ' ' || *p == '\t'; p++)
+        ;
+    if (*p == '#')
+        return parse_token(T_EOL, NULL);
+
+    p = line;
+    while (p < end) {
+        char  *word;
+        size_t wlen, hexlen;
+        char   saved;
+        import_status_t status;
+
+        if (*p == ' ' || *p == '\t' || *p == '\r') {
+            p++;
+            continue;
+        }
+        word = p;
+        while (p < end && *p != ' ' && *p != '\t' && *p != '\r')
+            p++;
+        wlen = p - word;
+        saved = *p;
+        *p = '\0';
+
+        hexlen = 0;
+        while (hexlen < wlen && g_ascii_isxdigit(word[hexlen]))
+            hexlen++;
+
+        if (wlen == 2 && hexlen == 2 &&
+            (state == READ_OFFSET || state == READ_BYTE)) {
+            /* A byte value in mid-line; decode it in place. */
+            packet_buf[curr_offset++] =
+                (uint8_t)(hex_decode_info.table[(unsigned char)word[0]] << 4 |
+                          hex_decode_info.table[(unsigned char)word[1]]);
+            state = READ_BYTE;
+            status = IMPORT_SUCCESS;
+            if (curr_offset >= info_p->max_frame_length) /* packet full */
+                status = start_new_packet(true);
+        } else if (wlen == 2 && hexlen == 2) {
+            status = parse_token(T_BYTE, word);
+        } else if (hexlen == wlen ||
+                   (hexlen == wlen - 1 && word[wlen - 1] == ':')) {
+            status = parse_token(T_OFFSET, word);
+        } else if (word[0] == '>' && wlen > 1) {
+            /* Possibly a mail-forwarded offset, e.g. ">00000000" */
+            size_t h = 1;
+            while (h < wlen && g_ascii_isxdigit(word[h]))
+                h++;
+            if (h == wlen ||
+                (h > 1 && h == wlen - 1 && word[wlen - 1] == ':')) {
+                status = parse_token(T_OFFSET, word + 1);
+            } else {
+                status = parse_token(T_TEXT, word);
+            }
+        } else {
+            status = parse_token(T_TEXT, word);
+        }
+
+        *p = saved;
+        if (status != IMPORT_SUCCESS)
+            return IMPORT_FAILURE;
+    }
+    return parse_token(T_EOL, NULL);
+}
+
+static import_status_t
+text_import_scan_lines(FILE *fp)
+{
+    size_t buf_size = 65536;
+    char *buf = (char *)g_malloc(buf_size);
+    import_status_t status = IMPORT_SUCCESS;
+
+    while (fgets(buf, (int)buf_size, fp) != NULL) {
+        size_t len = strlen(buf);
+
+        /* Grow the buffer until we have the whole line. */
+        while (len > 0 && buf[len - 1] != '\n' && !feof(fp)) {
+            buf_size *= 2;
+            buf = (char *)g_realloc(buf, buf_size);
+            if (fgets(buf + len, (int)(buf_size - len), fp) == NULL)
+                break;
+            len += strlen(buf + len);
+        }
+        while (len > 0 && (buf[len - 1] == '\n' || buf[len - 1] == '\r'))
+            buf[--len] = '\0';
+
+        if (process_line(buf, len) != IMPORT_SUCCESS) {
+            status = IMPORT_FAILURE;
+            break;
+        }
+    }
+    g_free(buf);
+    if (status == IMPORT_SUCCESS)
+        status = parse_token(T_EOF, NULL);
+    return status;
+}
+
 /*----------------------------------------------------------------------
  * Import a text file.
  */
@@ -1727,7 +1853,10 @@ text_import(text_import_info_t * const info)
     }
 
     if (info->mode == TEXT_IMPORT_HEXDUMP) {
-        status = text_import_scan(info->hexdump.import_text_FILE);
+        if (info->hexdump.identify_ascii)
+            status = text_import_scan(info->hexdump.import_text_FILE);
+        else
+            status = text_import_scan_lines(info->hexdump.import_text_FILE);
         switch(status) {
         case (IMPORT_SUCCESS):
             ret = 0;
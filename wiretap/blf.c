@@ -1218,7 +1218,12 @@ blf_read_bytes_or_eof(blf_params_t *params, uint64_t real_pos, void *target_buff
 
         start_in_buf = real_pos - container->real_start_pos;
 
-        if (params->random) {
+        if (params->random && container->real_data == NULL) {
+            /* Not decompressed yet; position the file for
+             * blf_pull_logcontainer_into_memory(), which reads at the
+             * current offset.  Containers that have already been
+             * pulled are served from their cache without touching the
+             * file. */
             if (file_seek(params->fh, container->infile_data_start, SEEK_SET, err) == -1) {
                 return false;
             }
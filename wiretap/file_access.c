@@ -807,6 +807,13 @@ try_one_open(wtap *wth, const struct open_info *candidate, int *err, char **err_
  * Returns WTAP_OPEN_MINE upon success, WTAP_OPEN_NOT_MINE if it was not
  * possible to determine a suitable format for the file, or WTAP_OPEN_ERROR if
  * a failure occurred while reading the input.
+ *
+ * Trying many candidates is cheaper than it looks: the rewind in
+ * try_one_open() and each routine's probe reads are served from the
+ * FILE_T buffer once the first candidate has faulted the file head in,
+ * so a failed probe costs memory copies, not system calls.  That, plus
+ * trying the magic-number routines before the heuristic ones, is why
+ * there's no separate probed-prefix cache here.
  */
 static int
 try_open(wtap *wth, unsigned int type, int *err, char **err_info)
@@ -1044,6 +1051,15 @@ wtap_open_offline(const char *filename, unsigned int type, int *err, char **err_
 		file_set_random_access(wth->random_fh, true, wth->fast_seek);
 	}
 
+	/* Tell the OS what to expect: the main stream is read front to
+	   back, the random-access stream jumps around as records are
+	   re-read.  Pipes just ignore the advice. */
+	if (!ispipe) {
+		file_set_access_pattern(wth->fh, FILE_ACCESS_SEQUENTIAL);
+		if (wth->random_fh)
+			file_set_access_pattern(wth->random_fh, FILE_ACCESS_RANDOM);
+	}
+
 	/* Find a file format handler which can read the file. */
 	switch (try_open(wth, type, err, err_info)) {
 	case WTAP_OPEN_NOT_MINE:
@@ -2656,6 +2672,25 @@ wtap_dump_discard_sysdig_meta_events(wtap_dumper *wdh)
 	}
 }
 
+/*
+ * Size of the stdio buffer for uncompressed output.  The stdio default
+ * (4K or 8K on most platforms) means a write system call every few
+ * records; a bigger buffer lets record serialization run well ahead of
+ * the file system and cuts the system-call rate when exporting large
+ * captures.
+ */
+#define DUMP_IO_BUFSIZE	(256 * 1024)
+
+static FILE *
+wtap_dump_fopen_buffered(FILE *fh)
+{
+	if (fh != NULL) {
+		/* If this fails, we just keep the default buffer. */
+		(void)setvbuf(fh, NULL, _IOFBF, DUMP_IO_BUFSIZE);
+	}
+	return fh;
+}
+
 /* internally open a file for writing (compressed or not) */
 #if defined (HAVE_ZLIB) || defined (HAVE_ZLIBNG)
 static WFILE_T
@@ -2664,14 +2699,14 @@ wtap_dump_file_open(wtap_dumper *wdh, const char *filename)
 	if (wdh->compression_type == WTAP_GZIP_COMPRESSED) {
 		return gzwfile_open(filename);
 	} else {
-		return ws_fopen(filename, "wb");
+		return wtap_dump_fopen_buffered(ws_fopen(filename, "wb"));
 	}
 }
 #else
 static WFILE_T
 wtap_dump_file_open(wtap_dumper *wdh _U_, const char *filename)
 {
-	return ws_fopen(filename, "wb");
+	return wtap_dump_fopen_buffered(ws_fopen(filename, "wb"));
 }
 #endif
 
@@ -2683,14 +2718,14 @@ wtap_dump_file_fdopen(wtap_dumper *wdh, int fd)
 	if (wdh->compression_type == WTAP_GZIP_COMPRESSED) {
 		return gzwfile_fdopen(fd);
 	} else {
-		return ws_fdopen(fd, "wb");
+		return wtap_dump_fopen_buffered(ws_fdopen(fd, "wb"));
 	}
 }
 #else
 static WFILE_T
 wtap_dump_file_fdopen(wtap_dumper *wdh _U_, int fd)
 {
-	return ws_fdopen(fd, "wb");
+	return wtap_dump_fopen_buffered(ws_fdopen(fd, "wb"));
 }
 #endif
 
@@ -24,6 +24,10 @@
 
 #include <wsutil/file_util.h>
 
+#ifdef HAVE_POSIX_FADVISE
+#include <fcntl.h>
+#endif /* HAVE_POSIX_FADVISE */
+
 #if defined(HAVE_ZLIB) && !defined(HAVE_ZLIBNG)
 #define USE_ZLIB_OR_ZLIBNG
 #define ZLIB_CONST
@@ -117,8 +121,16 @@ wtap_get_all_compression_type_extensions_list(void)
 	return extensions;
 }
 
-/* #define GZBUFSIZE 8192 */
-#define GZBUFSIZE 4096
+/*
+ * Default buffer size, used when neither the file system's preferred
+ * I/O size nor a decompressor's preferred buffer size is bigger.
+ *
+ * This used to be 4096, matching the common file-system block size,
+ * but that means one read system call and one pass through the
+ * decompressor per 4K of a compressed capture; 64K chunks keep both
+ * well fed without a noticeable memory cost.
+ */
+#define GZBUFSIZE 65536
 
 /* values for wtap_reader compression */
 typedef enum {
@@ -204,8 +216,42 @@ struct wtap_reader {
     /* fast seeking */
     GPtrArray *fast_seek;
     void *fast_seek_cur;
+
+    /* page cache advice */
+    file_access_pattern_e access_pattern; /* expected access pattern */
+    int64_t drop_behind_pos;    /* start of the cached region not yet
+                                   released behind a sequential reader */
 };
 
+#ifdef HAVE_POSIX_FADVISE
+/* How far ahead of a sequential reader to request readahead. */
+#define FADVISE_READAHEAD_WINDOW (4 * 1024 * 1024)
+/* How much recently-read data to keep cached behind a sequential reader;
+   everything older is released in chunks of this size. */
+#define FADVISE_DROP_WINDOW (8 * 1024 * 1024)
+
+/*
+ * Called after a raw read in sequential mode: ask the kernel to read
+ * ahead of the cursor, and release the cache well behind it so that a
+ * long sequential load doesn't evict everything else from the page
+ * cache.
+ */
+static void
+advise_sequential_progress(FILE_T state)
+{
+    if (state->access_pattern != FILE_ACCESS_SEQUENTIAL)
+        return;
+    (void)posix_fadvise(state->fd, state->raw_pos,
+                        FADVISE_READAHEAD_WINDOW, POSIX_FADV_WILLNEED);
+    if (state->raw_pos - state->drop_behind_pos >= 2 * FADVISE_DROP_WINDOW) {
+        (void)posix_fadvise(state->fd, state->drop_behind_pos,
+                            (state->raw_pos - FADVISE_DROP_WINDOW) - state->drop_behind_pos,
+                            POSIX_FADV_DONTNEED);
+        state->drop_behind_pos = state->raw_pos - FADVISE_DROP_WINDOW;
+    }
+}
+#endif /* HAVE_POSIX_FADVISE */
+
 /* Current read offset within a buffer. */
 static unsigned
 offset_in_buffer(struct wtap_reader_buf *buf)
@@ -277,6 +323,9 @@ buf_read(FILE_T state, struct wtap_reader_buf *buf)
         state->eof = true;
     state->raw_pos += ret;
     buf->avail += (unsigned)ret;
+#ifdef HAVE_POSIX_FADVISE
+    advise_sequential_progress(state);
+#endif
     return 0;
 }
 
@@ -1240,15 +1289,16 @@ file_fdopen(int fd)
      * set on all platforms that have st_blksize in struct stat.
      * (Not all platforms have st_blksize in struct stat.)
      *
-     * Is there some reason *not* to make the buffer size the maximum
-     * of GBUFSIZE and st_blksize?  On most UN*Xes, the standard I/O
-     * library does I/O with st_blksize as the buffer size; on others,
-     * and on Windows, it's a 4K buffer size.  If st_blksize is bigger
-     * than GBUFSIZE (which is currently 4KB), that's probably a
-     * hint that reading in st_blksize chunks is considered a good
-     * idea (e.g., an 8K/1K Berkeley fast file system with st_blksize
-     * being 8K, or APFS, where st_blksize is big on at least some
-     * versions of macOS).
+     * We use the maximum of GZBUFSIZE and st_blksize.  On most UN*Xes,
+     * the standard I/O library does I/O with st_blksize as the buffer
+     * size; on others, and on Windows, it's a 4K buffer size.  If
+     * st_blksize is bigger than GZBUFSIZE, that's probably a hint that
+     * reading in st_blksize chunks is considered a good idea (e.g., an
+     * 8K/1K Berkeley fast file system with st_blksize being 8K, or
+     * APFS, where st_blksize is big on at least some versions of
+     * macOS), but an st_blksize smaller than GZBUFSIZE is no reason
+     * to do many small reads and decompressor calls instead of one
+     * larger one.
      */
 #ifdef _STATBUF_ST_BLKSIZE
     ws_statb64 st;
@@ -1320,10 +1370,12 @@ file_fdopen(int fd)
          * so casting it to long won't turn it into a negative number.
          * (We only support 32-bit and 64-bit 2's-complement platforms.)
          */
-        if (st.st_blksize <= (long)MAX_READ_BUF_SIZE)
-            want = (unsigned)st.st_blksize;
-        else
-            want = MAX_READ_BUF_SIZE;
+        if (st.st_blksize > (long)want) {
+            if (st.st_blksize <= (long)MAX_READ_BUF_SIZE)
+                want = (unsigned)st.st_blksize;
+            else
+                want = MAX_READ_BUF_SIZE;
+        }
         /* XXX, verify result? */
     }
 #endif /* _STATBUF_ST_BLKSIZE */
@@ -1463,6 +1515,59 @@ file_set_random_access(FILE_T stream, bool random_flag _U_, GPtrArray *seek)
     stream->fast_seek = seek;
 }
 
+/*
+ * Declare the expected access pattern for a stream, passing it on to
+ * the OS where possible.  In sequential mode, subsequent raw reads
+ * also trigger readahead in front of the cursor and release the page
+ * cache behind it (see advise_sequential_progress()).
+ */
+void
+file_set_access_pattern(FILE_T stream, file_access_pattern_e pattern)
+{
+    stream->access_pattern = pattern;
+    stream->drop_behind_pos = stream->raw_pos;
+#ifdef HAVE_POSIX_FADVISE
+    switch (pattern) {
+
+    case FILE_ACCESS_SEQUENTIAL:
+        (void)posix_fadvise(stream->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        break;
+
+    case FILE_ACCESS_RANDOM:
+        (void)posix_fadvise(stream->fd, 0, 0, POSIX_FADV_RANDOM);
+        break;
+
+    default:
+        (void)posix_fadvise(stream->fd, 0, 0, POSIX_FADV_NORMAL);
+        break;
+    }
+#endif /* HAVE_POSIX_FADVISE */
+}
+
+/*
+ * Hint that the given region of the file is about to be read, e.g.
+ * the records around the row selected in the packet list, so the OS
+ * can fetch it before the reads are issued.  The offset and length
+ * are in uncompressed-data terms, so for compressed files - where
+ * they don't correspond to file offsets - this does nothing.
+ */
+void
+file_prefetch(FILE_T stream, int64_t offset, int64_t length)
+{
+    if (stream->is_compressed)
+        return;
+    if (offset < 0) {
+        /* Clamp a window that starts before the beginning of the file. */
+        length += offset;
+        offset = 0;
+    }
+    if (length <= 0)
+        return;
+#ifdef HAVE_POSIX_FADVISE
+    (void)posix_fadvise(stream->fd, offset, length, POSIX_FADV_WILLNEED);
+#endif /* HAVE_POSIX_FADVISE */
+}
+
 int64_t
 file_seek(FILE_T file, int64_t offset, int whence, int *err)
 {
@@ -1856,6 +1961,27 @@ file_read(void *buf, unsigned int len, FILE_T file)
                we're at the end of the input; just return
                with what we've gotten so far. */
             break;
+        } else if (file->compression == UNCOMPRESSED && buf != NULL &&
+                   len >= file->size && file->in.avail == 0) {
+            /* The file is uncompressed and the caller wants at least
+               a full buffer's worth; read straight into the caller's
+               buffer rather than staging the data through the output
+               buffer and copying it. */
+            ssize_t ret = ws_read(file->fd, buf, len);
+            if (ret < 0) {
+                file->err = errno;
+                file->err_info = NULL;
+                return -1;
+            }
+            if (ret == 0) {
+                file->eof = true;
+                break;
+            }
+            file->raw_pos += ret;
+            file->pos += ret;
+            buf = (char *)buf + ret;
+            len -= (unsigned)ret;
+            got += (unsigned)ret;
         } else {
             /* We have nothing in the output buffer, and
                we can generate more data; get more output,
@@ -13,9 +13,24 @@
 #include "wtap.h"
 #include <wsutil/file_util.h>
 
+/*
+ * Expected access pattern for a stream, used to give the OS page cache
+ * advice (posix_fadvise) where available.  In sequential mode we also
+ * ask for readahead in front of the cursor and release cached pages
+ * well behind it, so loading a huge capture doesn't evict everything
+ * else from the page cache.
+ */
+typedef enum {
+    FILE_ACCESS_DEFAULT,
+    FILE_ACCESS_SEQUENTIAL,
+    FILE_ACCESS_RANDOM
+} file_access_pattern_e;
+
 extern FILE_T file_open(const char *path);
 extern FILE_T file_fdopen(int fildes);
 extern void file_set_random_access(FILE_T stream, bool random_flag, GPtrArray *seek);
+extern void file_set_access_pattern(FILE_T stream, file_access_pattern_e pattern);
+WS_DLL_PUBLIC void file_prefetch(FILE_T stream, int64_t offset, int64_t length);
 WS_DLL_PUBLIC int64_t file_seek(FILE_T stream, int64_t offset, int whence, int *err);
 WS_DLL_PUBLIC int64_t file_tell(FILE_T stream);
 extern int64_t file_tell_raw(FILE_T stream);
@@ -1008,8 +1008,21 @@ libpcap_read_packet(wtap *wth, FILE_T fh, wtap_rec *rec,
 	rec->rec_header.packet_header.len = orig_size;
 
 	/*
-	 * Read the packet data.
+	 * Read the packet data - or, if the caller has promised not to
+	 * look at it and the post-processing for this encapsulation
+	 * doesn't look at it either, just skip over it.
 	 */
+	if (wth->read_metadata_only &&
+	    !pcap_read_post_process_needs_pd(wth->file_encap,
+	    libpcap->byte_swapped)) {
+		if (!wtap_read_bytes(fh, NULL, packet_size, err, err_info))
+			return false;	/* failed */
+
+		pcap_read_post_process(is_nokia, wth->file_encap, rec,
+		    NULL, libpcap->byte_swapped, libpcap->fcs_len);
+		return true;
+	}
+
 	if (!wtap_read_packet_bytes(fh, buf, packet_size, err, err_info))
 		return false;	/* failed */
 
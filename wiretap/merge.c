@@ -35,6 +35,7 @@
 #include <string.h>
 #include "wtap_opttypes.h"
 #include "wtap-int.h"
+#include "pcapng.h"
 
 #include <wsutil/filesystem.h>
 #include "wsutil/os_version_info.h"
@@ -305,21 +306,112 @@ merge_select_frame_type(const int file_type, int in_file_count, merge_in_file_t
 }
 
 /*
- * returns true if first argument is earlier than second
+ * Min-heap of the input files that have a record waiting to be merged.
+ * Picking the next record by scanning all the inputs is fine when
+ * merging a handful of files, but merging hundreds of rotated capture
+ * files made that per-record scan the bottleneck; the heap picks the
+ * next record with O(log n) comparisons instead.
+ *
+ * The heap holds indices into the in_files[] array and orders them by
+ * the rule the old linear scan implemented: records with no time stamp
+ * come before all others (you obviously can't merge those
+ * chronologically), lowest file index first; time-stamped records are
+ * in time stamp order, with ties going to the highest file index, as
+ * the scan kept the last file it saw with the earliest time stamp.
  */
+typedef struct {
+    int *files;    /* indices into in_files[], heap-ordered */
+    int  count;    /* number of entries in use */
+    bool primed;   /* true once every input has been read from */
+    int  pending;  /* file index to refill before the next pick, or -1 */
+} record_heap_t;
+
 static bool
-is_earlier(nstime_t *l, nstime_t *r) /* XXX, move to nstime.c */
+record_is_before(const merge_in_file_t in_files[], int ia, int ib)
 {
-    if (l->secs > r->secs) {  /* left is later */
-        return false;
-    } else if (l->secs < r->secs) { /* left is earlier */
+    const wtap_rec *ra = &in_files[ia].rec;
+    const wtap_rec *rb = &in_files[ib].rec;
+    bool a_has_ts = (ra->presence_flags & WTAP_HAS_TS) != 0;
+    bool b_has_ts = (rb->presence_flags & WTAP_HAS_TS) != 0;
+    int cmp;
+
+    if (!a_has_ts || !b_has_ts) {
+        if (a_has_ts == b_has_ts)
+            return ia < ib;
+        return !a_has_ts;
+    }
+    cmp = nstime_cmp(&ra->ts, &rb->ts);
+    if (cmp != 0)
+        return cmp < 0;
+    return ia > ib;
+}
+
+static void
+record_heap_push(record_heap_t *heap, const merge_in_file_t in_files[],
+                 int file_idx)
+{
+    int pos, parent, tmp;
+
+    pos = heap->count++;
+    heap->files[pos] = file_idx;
+    while (pos > 0) {
+        parent = (pos - 1) / 2;
+        if (!record_is_before(in_files, heap->files[pos],
+                              heap->files[parent]))
+            break;
+        tmp = heap->files[pos];
+        heap->files[pos] = heap->files[parent];
+        heap->files[parent] = tmp;
+        pos = parent;
+    }
+}
+
+/* Remove the root entry, i.e. the file with the earliest record. */
+static void
+record_heap_pop(record_heap_t *heap, const merge_in_file_t in_files[])
+{
+    int pos, child, tmp;
+
+    heap->files[0] = heap->files[--heap->count];
+    pos = 0;
+    for (;;) {
+        child = 2 * pos + 1;
+        if (child >= heap->count)
+            break;
+        if (child + 1 < heap->count &&
+            record_is_before(in_files, heap->files[child + 1],
+                             heap->files[child]))
+            child++;
+        if (!record_is_before(in_files, heap->files[child],
+                              heap->files[pos]))
+            break;
+        tmp = heap->files[pos];
+        heap->files[pos] = heap->files[child];
+        heap->files[child] = tmp;
+        pos = child;
+    }
+}
+
+/* Read the next record from an input file and, if there is one, add
+ * the file to the heap.  Returns false on a read error. */
+static bool
+record_heap_fill(record_heap_t *heap, merge_in_file_t in_files[],
+                 int file_idx, int *err, char **err_info)
+{
+    if (in_files[file_idx].state != RECORD_NOT_PRESENT)
+        return true;
+    if (!wtap_read(in_files[file_idx].wth, &in_files[file_idx].rec,
+                   &in_files[file_idx].frame_buffer, err, err_info,
+                   &in_files[file_idx].data_offset)) {
+        if (*err != 0) {
+            in_files[file_idx].state = GOT_ERROR;
+            return false;
+        }
+        in_files[file_idx].state = AT_EOF;
         return true;
-    } else if (l->nsecs > r->nsecs) { /* tv_sec equal, l.usec later */
-        return false;
     }
-    /* either one < two or one == two
-     * either way, return one
-     */
+    in_files[file_idx].state = RECORD_PRESENT;
+    record_heap_push(heap, in_files, file_idx);
     return true;
 }
 
@@ -337,6 +429,7 @@ is_earlier(nstime_t *l, nstime_t *r) /* XXX, move to nstime.c */
  *
  * @param in_file_count number of entries in in_files
  * @param in_files input file array
+ * @param heap heap of files with a record waiting to be merged
  * @param err wiretap error, if failed
  * @param err_info wiretap error string, if failed
  * @return pointer to merge_in_file_t for file from which that packet
@@ -345,69 +438,46 @@ is_earlier(nstime_t *l, nstime_t *r) /* XXX, move to nstime.c */
  */
 static merge_in_file_t *
 merge_read_packet(int in_file_count, merge_in_file_t in_files[],
-                  int *err, char **err_info)
+                  record_heap_t *heap, int *err, char **err_info)
 {
     int i;
-    int ei = -1;
-    nstime_t tv = NSTIME_INIT_MAX;
-    wtap_rec *rec;
+    int ei;
 
-    /*
-     * Make sure we have a record available from each file that's not at
-     * EOF, and search for the record with the earliest time stamp or
-     * with no time stamp (those records are treated as earlier than
-     * all other records).  Yes, this means you won't get a chronological
-     * merge of those records, but you obviously *can't* get that.
-     */
-    for (i = 0; i < in_file_count; i++) {
-        int64_t data_offset;
-
-        if (in_files[i].state == RECORD_NOT_PRESENT) {
-            /*
-             * No packet available, and we haven't seen an error or EOF yet,
-             * so try to read the next packet.
-             */
-            if (!wtap_read(in_files[i].wth, &in_files[i].rec,
-                           &in_files[i].frame_buffer, err, err_info,
-                           &data_offset)) {
-                if (*err != 0) {
-                    in_files[i].state = GOT_ERROR;
-                    return &in_files[i];
-                }
-                in_files[i].state = AT_EOF;
-            } else
-                in_files[i].state = RECORD_PRESENT;
-        }
-
-        if (in_files[i].state == RECORD_PRESENT) {
-            rec = &in_files[i].rec;
-            if (!(rec->presence_flags & WTAP_HAS_TS)) {
-                /*
-                 * No time stamp.  Pick this record, and stop looking.
-                 */
-                ei = i;
-                break;
-            }
-            if (is_earlier(&rec->ts, &tv)) {
-                /*
-                 * This record's time stamp is earlier than any of the
-                 * records we've seen so far.  Pick it, for now, but
-                 * keep looking.
-                 */
-                tv = rec->ts;
-                ei = i;
-            }
+    if (!heap->primed) {
+        /*
+         * First pick: read a record from every file.
+         */
+        for (i = 0; i < in_file_count; i++) {
+            if (!record_heap_fill(heap, in_files, i, err, err_info))
+                return &in_files[i];
         }
+        heap->primed = true;
+    } else if (heap->pending != -1) {
+        /*
+         * The previous pick's record has been consumed by now, so
+         * it's safe to replace it with the next record from the
+         * file it came from.
+         */
+        i = heap->pending;
+        heap->pending = -1;
+        if (!record_heap_fill(heap, in_files, i, err, err_info))
+            return &in_files[i];
     }
 
-    if (ei == -1) {
+    if (heap->count == 0) {
         /* All the streams are at EOF.  Return an EOF indication. */
         *err = 0;
         return NULL;
     }
 
-    /* We'll need to read another packet from this file. */
+    /* The root of the heap is the file with the earliest record. */
+    ei = heap->files[0];
+    record_heap_pop(heap, in_files);
+
+    /* We'll need to read another packet from this file, but not before
+       the record we're returning has been processed. */
     in_files[ei].state = RECORD_NOT_PRESENT;
+    heap->pending = ei;
 
     /* Count this packet. */
     in_files[ei].packet_num++;
@@ -445,7 +515,6 @@ merge_append_read_packet(int in_file_count, merge_in_file_t in_files[],
                          int *err, char **err_info)
 {
     int i;
-    int64_t data_offset;
 
     /*
      * Find the first file not at EOF, and read the next packet from it.
@@ -455,7 +524,7 @@ merge_append_read_packet(int in_file_count, merge_in_file_t in_files[],
             continue; /* This file is already at EOF */
         if (wtap_read(in_files[i].wth, &in_files[i].rec,
                       &in_files[i].frame_buffer, err, err_info,
-                      &data_offset))
+                      &in_files[i].data_offset))
             break; /* We have a packet */
         if (*err != 0) {
             /* Read error - quit immediately. */
@@ -1034,7 +1103,14 @@ merge_process_packets(wtap_dumper *pdh, const int file_type,
     merge_in_file_t    *in_file;
     int                 count = 0;
     bool                stop_flag = false;
+    bool                written;
     wtap_rec *rec,      snap_rec;
+    record_heap_t       heap;
+
+    heap.files = g_new(int, in_file_count);
+    heap.count = 0;
+    heap.primed = false;
+    heap.pending = -1;
 
     for (;;) {
         *err = 0;
@@ -1044,7 +1120,7 @@ merge_process_packets(wtap_dumper *pdh, const int file_type,
                                                err_info);
         }
         else {
-            in_file = merge_read_packet(in_file_count, in_files, err,
+            in_file = merge_read_packet(in_file_count, in_files, &heap, err,
                                         err_info);
         }
 
@@ -1159,7 +1235,24 @@ merge_process_packets(wtap_dumper *pdh, const int file_type,
             }
         }
 
-        if (!wtap_dump(pdh, rec, ws_buffer_start_ptr(&in_file->frame_buffer),
+        /*
+         * If we aren't modifying this record, try splicing the raw
+         * pcapng block, with the remapped interface ID patched in,
+         * rather than re-encoding it through the dumper.
+         */
+        written = false;
+        if (rec == &in_file->rec && pcapng_can_splice(in_file->wth, pdh)) {
+            written = pcapng_splice_block(in_file->wth, pdh, rec,
+                                          in_file->data_offset,
+                                          err, err_info);
+            if (!written && *err != 0) {
+                status = MERGE_ERR_CANT_WRITE_OUTFILE;
+                break;
+            }
+        }
+
+        if (!written &&
+            !wtap_dump(pdh, rec, ws_buffer_start_ptr(&in_file->frame_buffer),
                        err, err_info)) {
             status = MERGE_ERR_CANT_WRITE_OUTFILE;
             break;
@@ -1227,6 +1320,8 @@ merge_process_packets(wtap_dumper *pdh, const int file_type,
      * happen now, let's keep all pointers in pdh valid for correctness sake. */
     merge_close_in_files(in_file_count, in_files);
 
+    g_free(heap.files);
+
     if (status == MERGE_OK || in_file == NULL) {
         *err_fileno = 0;
         *err_framenum = 0;
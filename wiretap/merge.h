@@ -34,6 +34,7 @@ typedef struct merge_in_file_s {
     Buffer          frame_buffer;
     in_file_state_e state;
     uint32_t        packet_num;     /* current packet number */
+    int64_t         data_offset;    /* offset of the current record in the file */
     int64_t         size;           /* file size */
     GArray         *idb_index_map;  /* used for mapping the old phdr interface_id values to new during merge */
     unsigned        nrbs_seen;      /* number of elements processed so far from wth->nrbs */
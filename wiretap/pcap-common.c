@@ -2585,6 +2585,32 @@ pcap_fixup_len(wtap_rec *rec, const uint8_t *pd)
 	}
 }
 
+/*
+ * Does pcap_read_post_process() look at the packet data for this
+ * encapsulation?  If not, a reader serving a metadata-only caller may
+ * skip over the packet data and pass a null pd.
+ */
+bool
+pcap_read_post_process_needs_pd(int wtap_encap, bool bytes_swapped)
+{
+	switch (wtap_encap) {
+
+	case WTAP_ENCAP_ATM_PDUS:
+	case WTAP_ENCAP_USB_LINUX_MMAPPED:
+		return true;
+
+	case WTAP_ENCAP_SLL:
+	case WTAP_ENCAP_SLL2:
+	case WTAP_ENCAP_USB_LINUX:
+	case WTAP_ENCAP_NFLOG:
+	case WTAP_ENCAP_PFLOG:
+		return bytes_swapped;
+
+	default:
+		return false;
+	}
+}
+
 void
 pcap_read_post_process(bool is_nokia, int wtap_encap,
     wtap_rec *rec, uint8_t *pd, bool bytes_swapped, int fcs_len)
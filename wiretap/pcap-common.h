@@ -27,6 +27,9 @@ extern int pcap_process_pseudo_header(FILE_T fh, bool is_nokia,
 extern void pcap_read_post_process(bool is_nokia, int wtap_encap,
     wtap_rec *rec, uint8_t *pd, bool bytes_swapped, int fcs_len);
 
+extern bool pcap_read_post_process_needs_pd(int wtap_encap,
+    bool bytes_swapped);
+
 extern int pcap_get_phdr_size(int encap,
     const union wtap_pseudo_header *pseudo_header);
 
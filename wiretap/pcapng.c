@@ -1067,7 +1067,9 @@ pcapng_process_options(FILE_T fh, wtapng_block_t *wblock,
                        pcapng_opt_byte_order_e byte_order,
                        int *err, char **err_info)
 {
-    uint8_t *option_content; /* Allocate as large as the options block */
+    uint64_t option_scratch[32];
+    uint8_t *option_content; /* As large as the options block */
+    bool option_content_allocated;
     unsigned opt_bytes_remaining;
     const uint8_t *option_ptr;
     const pcapng_option_header_t *oh;
@@ -1080,25 +1082,36 @@ pcapng_process_options(FILE_T fh, wtapng_block_t *wblock,
         return true;
     }
 
-    /* Allocate enough memory to hold all options */
-    option_content = (uint8_t *)g_try_malloc(opt_cont_buf_len);
-    if (option_content == NULL) {
-        *err = ENOMEM;  /* we assume we're out of memory */
-        return false;
+    /* Get memory to hold all the options.  Most blocks carry only a
+       few small options, so use a stack buffer for the common case
+       rather than paying for a heap allocation and free per block on
+       the sequential read path. */
+    if (opt_cont_buf_len <= sizeof option_scratch) {
+        option_content = (uint8_t *)option_scratch;
+        option_content_allocated = false;
+    } else {
+        option_content = (uint8_t *)g_try_malloc(opt_cont_buf_len);
+        if (option_content == NULL) {
+            *err = ENOMEM;  /* we assume we're out of memory */
+            return false;
+        }
+        option_content_allocated = true;
     }
 
     /* Read all the options into the buffer */
     if (!wtap_read_bytes(fh, option_content, opt_cont_buf_len, err, err_info)) {
         ws_debug("failed to read options");
-        g_free(option_content);
+        if (option_content_allocated)
+            g_free(option_content);
         return false;
     }
 
     /*
      * Now process them.
      * option_ptr starts out aligned on at least a 4-byte boundary, as
-     * that's what g_try_malloc() gives us, and each option is padded
-     * to a length that's a multiple of 4 bytes, so it remains aligned.
+     * both a uint64_t array and g_try_malloc() give us that, and each
+     * option is padded to a length that's a multiple of 4 bytes, so it
+     * remains aligned.
      */
     option_ptr = &option_content[0];
     opt_bytes_remaining = opt_cont_buf_len;
@@ -1109,7 +1122,8 @@ pcapng_process_options(FILE_T fh, wtapng_block_t *wblock,
         if (sizeof (*oh) > opt_bytes_remaining) {
             *err = WTAP_ERR_BAD_FILE;
             *err_info = ws_strdup_printf("pcapng: Not enough data for option header");
-            g_free(option_content);
+            if (option_content_allocated)
+                g_free(option_content);
             return false;
         }
         option_code = oh->option_code;
@@ -1138,6 +1152,8 @@ pcapng_process_options(FILE_T fh, wtapng_block_t *wblock,
             *err = WTAP_ERR_INTERNAL;
             *err_info = ws_strdup_printf("pcapng: invalid byte order %d passed to pcapng_process_options()",
                                         byte_order);
+            if (option_content_allocated)
+                g_free(option_content);
             return false;
         }
         option_ptr += sizeof (*oh); /* 4 bytes, so it remains aligned */
@@ -1151,7 +1167,8 @@ pcapng_process_options(FILE_T fh, wtapng_block_t *wblock,
             *err = WTAP_ERR_BAD_FILE;
             *err_info = ws_strdup_printf("pcapng: Not enough data to handle option of length %u",
                                         option_length);
-            g_free(option_content);
+            if (option_content_allocated)
+                g_free(option_content);
             return false;
         }
 
@@ -1176,7 +1193,8 @@ pcapng_process_options(FILE_T fh, wtapng_block_t *wblock,
                                                   option_ptr,
                                                   byte_order,
                                                   err, err_info)) {
-                    g_free(option_content);
+                    if (option_content_allocated)
+                        g_free(option_content);
                     return false;
                 }
                 break;
@@ -1186,14 +1204,16 @@ pcapng_process_options(FILE_T fh, wtapng_block_t *wblock,
                     !(*process_option)(wblock, (const section_info_t *)section_info, option_code,
                                        option_length, option_ptr,
                                        err, err_info)) {
-                    g_free(option_content);
+                    if (option_content_allocated)
+                        g_free(option_content);
                     return false;
                 }
         }
         option_ptr += rounded_option_length; /* multiple of 4 bytes, so it remains aligned */
         opt_bytes_remaining -= rounded_option_length;
     }
-    g_free(option_content);
+    if (option_content_allocated)
+        g_free(option_content);
     return true;
 }
 
@@ -2305,9 +2325,20 @@ pcapng_read_packet_block(FILE_T fh, pcapng_block_header_t *bh,
     /* Combine the two 32-bit pieces of the timestamp into one 64-bit value */
     ts = (((uint64_t)packet.ts_high) << 32) | ((uint64_t)packet.ts_low);
 
-    /* Convert it to seconds and nanoseconds. */
-    wblock->rec->ts.secs = (time_t)(ts / iface_info.time_units_per_second);
-    wblock->rec->ts.nsecs = (int)(((ts % iface_info.time_units_per_second) * 1000000000) / iface_info.time_units_per_second);
+    /* Convert it to seconds and nanoseconds.  Nearly all interfaces
+       use microsecond or nanosecond resolution; handle those with
+       divisions by constants, which compilers turn into multiplies,
+       rather than paying for two divisions by a variable per packet. */
+    if (iface_info.time_units_per_second == 1000000) {
+        wblock->rec->ts.secs = (time_t)(ts / 1000000);
+        wblock->rec->ts.nsecs = (int)((ts % 1000000) * 1000);
+    } else if (iface_info.time_units_per_second == 1000000000) {
+        wblock->rec->ts.secs = (time_t)(ts / 1000000000);
+        wblock->rec->ts.nsecs = (int)(ts % 1000000000);
+    } else {
+        wblock->rec->ts.secs = (time_t)(ts / iface_info.time_units_per_second);
+        wblock->rec->ts.nsecs = (int)(((ts % iface_info.time_units_per_second) * 1000000000) / iface_info.time_units_per_second);
+    }
 
     /* Add the time stamp offset. */
     wblock->rec->ts.secs = (time_t)(wblock->rec->ts.secs + iface_info.tsoffset);
@@ -4180,7 +4211,14 @@ pcapng_read(wtap *wth, wtap_rec *rec, Buffer *buf, int *err,
     return true;
 }
 
-/* classic wtap: seek to file position and read packet */
+/* classic wtap: seek to file position and read packet
+ *
+ * The seek offsets come from the caller's sequential read pass; random
+ * access is O(1) once that pass has run.  An index block or sidecar
+ * mapping frame numbers to offsets would not let us skip the pass:
+ * it's what builds the frame table, applies IDBs/NRBs/DSBs and feeds
+ * dissection, all of which need every record visited once.  It would
+ * also be a nonstandard block other readers choke on or ignore. */
 static bool
 pcapng_seek_read(wtap *wth, int64_t seek_off,
                  wtap_rec *rec, Buffer *buf,
@@ -6725,6 +6763,293 @@ static bool pcapng_dump_finish(wtap_dumper *wdh, int *err,
     return true;
 }
 
+/* Can blocks be spliced from wth to wdh at all?  See pcapng.h. */
+bool
+pcapng_can_splice(wtap *wth, wtap_dumper *wdh)
+{
+    if (wth->file_type_subtype != pcapng_file_type_subtype ||
+        wdh->file_type_subtype != pcapng_file_type_subtype)
+        return false;
+
+    /*
+     * We briefly seek the sequential stream back over the block just
+     * read; on compressed input that's costly rather than a buffer
+     * operation, and raw bytes can't be dropped into a compressed
+     * output stream anyway.
+     */
+    if (file_iscompressed(wth->fh))
+        return false;
+    if (wdh->compression_type != WTAP_UNCOMPRESSED)
+        return false;
+
+    return true;
+}
+
+/* Splice one packet block from wth to wdh, patching the interface ID in
+   place.  See pcapng.h for the contract. */
+bool
+pcapng_splice_block(wtap *wth, wtap_dumper *wdh, const wtap_rec *rec,
+                    int64_t block_start, int *err, char **err_info)
+{
+    pcapng_t *pcapng = (pcapng_t *)wth->priv;
+    const section_info_t *section_info;
+    pcapng_block_header_t bh;
+    uint32_t interface_id;
+    uint32_t min_size;
+    uint32_t trailer;
+    uint8_t *block;
+    int64_t saved_pos;
+
+    *err = 0;
+
+    if (rec->rec_type != REC_TYPE_PACKET || rec->block_was_modified)
+        return false;
+    if (!(rec->presence_flags & WTAP_HAS_INTERFACE_ID))
+        return false;
+
+    /*
+     * We write in our own byte order, so we can only copy blocks from a
+     * section in our byte order.
+     */
+    if (!(rec->presence_flags & WTAP_HAS_SECTION_NUMBER) ||
+        rec->section_number >= pcapng->sections->len)
+        return false;
+    section_info = &g_array_index(pcapng->sections, section_info_t,
+                                  rec->section_number);
+    if (section_info->byte_swapped)
+        return false;
+
+    /* Map the interface ID the same way the normal writer does. */
+    interface_id = rec->rec_header.packet_header.interface_id;
+    if (wdh->shb_iface_to_global) {
+        interface_id += g_array_index(wdh->shb_iface_to_global, unsigned,
+                                      rec->section_number);
+    }
+
+    /*
+     * The sequential stream is positioned just past the block this
+     * record came from; seek back to its start and re-read the raw
+     * bytes, which leaves the stream exactly where it was.  If we
+     * give up part-way, restore the position first.
+     */
+    saved_pos = file_tell(wth->fh);
+    if (file_seek(wth->fh, block_start, SEEK_SET, err) == -1)
+        return false;
+    if (!wtap_read_bytes(wth->fh, &bh, sizeof bh, err, err_info))
+        return false;
+
+    switch (bh.block_type) {
+
+    case BLOCK_TYPE_EPB:
+        min_size = MIN_EPB_SIZE;
+        break;
+
+    case BLOCK_TYPE_SPB:
+        /* An SPB has no interface ID field; it's implicitly 0. */
+        if (interface_id != 0)
+            goto fallback;
+        min_size = MIN_SPB_SIZE;
+        break;
+
+    default:
+        /* Not laid out the way we expect; write it the normal way. */
+        goto fallback;
+    }
+
+    if (bh.block_total_length < min_size ||
+        bh.block_total_length > MAX_BLOCK_SIZE ||
+        (bh.block_total_length % 4) != 0)
+        goto fallback;
+
+    block = (uint8_t *)g_malloc(bh.block_total_length);
+    memcpy(block, &bh, sizeof bh);
+    if (!wtap_read_bytes(wth->fh, block + sizeof bh,
+                         bh.block_total_length - (unsigned)sizeof bh,
+                         err, err_info)) {
+        g_free(block);
+        return false;
+    }
+
+    /* The trailing total length must agree with the header's. */
+    memcpy(&trailer, block + bh.block_total_length - sizeof trailer,
+           sizeof trailer);
+    if (trailer != bh.block_total_length) {
+        g_free(block);
+        goto fallback;
+    }
+
+    if (bh.block_type == BLOCK_TYPE_EPB) {
+        /* Patch the interface ID in place. */
+        memcpy(block + sizeof bh, &interface_id, sizeof interface_id);
+    }
+
+    /* Flush any pending NRBs, DSBs, and IDBs first, as for a packet. */
+    if (!pcapng_write_internal_blocks(wdh, err)) {
+        g_free(block);
+        return false;
+    }
+
+    if (!wtap_dump_file_write(wdh, block, bh.block_total_length, err)) {
+        g_free(block);
+        return false;
+    }
+    g_free(block);
+
+    return true;
+
+fallback:
+    /* Let the caller write this block through the dumper instead. */
+    if (file_seek(wth->fh, saved_pos, SEEK_SET, err) == -1)
+        return false;
+    *err = 0;
+    return false;
+}
+
+/* Convert a raw pcapng timestamp for the given interface to an nstime_t,
+   the same way the packet block reader does. */
+static void
+pcapng_raw_ts_to_nstime(const interface_info_t *iface_info, uint64_t ts,
+                        nstime_t *nstime)
+{
+    if (iface_info->time_units_per_second == 1000000) {
+        nstime->secs = (time_t)(ts / 1000000);
+        nstime->nsecs = (int)((ts % 1000000) * 1000);
+    } else if (iface_info->time_units_per_second == 1000000000) {
+        nstime->secs = (time_t)(ts / 1000000000);
+        nstime->nsecs = (int)(ts % 1000000000);
+    } else {
+        nstime->secs = (time_t)(ts / iface_info->time_units_per_second);
+        nstime->nsecs = (int)(((ts % iface_info->time_units_per_second) * 1000000000) / iface_info->time_units_per_second);
+    }
+    nstime->secs = (time_t)(nstime->secs + iface_info->tsoffset);
+}
+
+/* Read the run of ISBs at the very end of the file, if any.  See pcapng.h. */
+bool
+pcapng_read_trailing_statistics(wtap *wth, GArray *stats, int *err,
+                                char **err_info)
+{
+    pcapng_t *pcapng = (pcapng_t *)wth->priv;
+    section_info_t *section_info;
+    pcapng_block_header_t bh;
+    int64_t file_size;
+    int64_t saved_pos;
+    int64_t pos;
+    uint32_t trailer;
+
+    *err = 0;
+    if (wth->file_type_subtype != pcapng_file_type_subtype)
+        return true;
+
+    /*
+     * Seeking around the tail of a compressed file isn't cheap, which
+     * defeats the purpose of the probe.
+     */
+    if (file_iscompressed(wth->fh))
+        return true;
+
+    /*
+     * The trailing blocks belong to the file's last section, so use its
+     * byte order and interfaces to interpret them.
+     */
+    section_info = &g_array_index(pcapng->sections, section_info_t,
+                                  pcapng->sections->len - 1);
+
+    file_size = wtap_file_size(wth, err);
+    if (file_size == -1)
+        return false;
+    saved_pos = file_tell(wth->fh);
+
+    /*
+     * Walk backwards from the end of the file, one block at a time,
+     * using the total length trailer, for as long as we see ISBs.
+     */
+    pos = file_size;
+    while (pos >= (int64_t)MIN_ISB_SIZE) {
+        wtapng_block_t wblock;
+        wtapng_if_stats_mandatory_t *if_stats_mand;
+        pcapng_if_stats_t if_stats;
+        uint64_t opt_val;
+
+        if (file_seek(wth->fh, pos - 4, SEEK_SET, err) == -1)
+            return false;
+        if (!wtap_read_bytes(wth->fh, &trailer, sizeof trailer, err, err_info))
+            return false;
+        if (section_info->byte_swapped)
+            trailer = GUINT32_SWAP_LE_BE(trailer);
+        if (trailer < MIN_ISB_SIZE || trailer > MAX_BLOCK_SIZE ||
+            (trailer % 4) != 0 || (int64_t)trailer > pos)
+            break;
+        if (file_seek(wth->fh, pos - trailer, SEEK_SET, err) == -1)
+            return false;
+        if (!wtap_read_bytes(wth->fh, &bh, sizeof bh, err, err_info))
+            return false;
+        if (section_info->byte_swapped) {
+            bh.block_type = GUINT32_SWAP_LE_BE(bh.block_type);
+            bh.block_total_length = GUINT32_SWAP_LE_BE(bh.block_total_length);
+        }
+        if (bh.block_type != BLOCK_TYPE_ISB ||
+            bh.block_total_length != trailer)
+            break;
+
+        memset(&wblock, 0, sizeof wblock);
+        wblock.type = bh.block_type;
+        if (!pcapng_read_interface_statistics_block(wth->fh, &bh,
+                                                    section_info, &wblock,
+                                                    err, err_info))
+            return false;
+
+        if_stats_mand = (wtapng_if_stats_mandatory_t *)wtap_block_get_mandatory_data(wblock.block);
+        memset(&if_stats, 0, sizeof if_stats);
+        if_stats.interface_id = if_stats_mand->interface_id;
+        if_stats.packets_delivered = UINT64_MAX;
+        if_stats.dropped = UINT64_MAX;
+        if (wtap_block_get_uint64_option_value(wblock.block, OPT_ISB_USRDELIV,
+                                               &opt_val) == WTAP_OPTTYPE_SUCCESS)
+            if_stats.packets_delivered = opt_val;
+        if (wtap_block_get_uint64_option_value(wblock.block, OPT_ISB_IFDROP,
+                                               &opt_val) == WTAP_OPTTYPE_SUCCESS)
+            if_stats.dropped = opt_val;
+
+        /*
+         * The timestamps are in the units of the interface the ISB
+         * applies to, so we can only convert them if we've seen that
+         * interface's IDB.
+         */
+        if (if_stats_mand->interface_id < section_info->interfaces->len) {
+            const interface_info_t *iface_info;
+
+            iface_info = &g_array_index(section_info->interfaces,
+                                        interface_info_t,
+                                        if_stats_mand->interface_id);
+            if (wtap_block_get_uint64_option_value(wblock.block,
+                                                   OPT_ISB_STARTTIME,
+                                                   &opt_val) == WTAP_OPTTYPE_SUCCESS) {
+                pcapng_raw_ts_to_nstime(iface_info, opt_val,
+                                        &if_stats.start_time);
+                if_stats.has_start_time = true;
+            }
+            if (wtap_block_get_uint64_option_value(wblock.block,
+                                                   OPT_ISB_ENDTIME,
+                                                   &opt_val) == WTAP_OPTTYPE_SUCCESS) {
+                pcapng_raw_ts_to_nstime(iface_info, opt_val,
+                                        &if_stats.end_time);
+                if_stats.has_end_time = true;
+            }
+        }
+        wtap_block_unref(wblock.block);
+
+        /* We're walking backwards, so put earlier blocks first. */
+        g_array_prepend_val(stats, if_stats);
+        pos -= trailer;
+    }
+
+    /* Put the sequential stream back where we found it. */
+    if (file_seek(wth->fh, saved_pos, SEEK_SET, err) == -1)
+        return false;
+    return true;
+}
+
 /* Returns true on success, false on failure; sets "*err" to an error code on
    failure */
 static bool
@@ -74,4 +74,66 @@ struct pcapng_option_header {
 
 wtap_open_return_val pcapng_open(wtap *wth, int *err, char **err_info);
 
+/*
+ * Block splicing, for copying packets between pcapng files without
+ * re-encoding them (editcap splitting a capture, mergecap combining
+ * captures from the same probe).  pcapng_splice_block() copies the raw
+ * bytes of the packet block that the given record was read from,
+ * patching only the interface ID in place, so unmodified copies run at
+ * disk bandwidth.
+ *
+ * The caller must only splice records it isn't otherwise modifying, and
+ * must ensure the IDB a spliced block's (possibly remapped) interface ID
+ * resolves to in the output is a copy of the source IDB, so that the
+ * verbatim timestamp fields keep their meaning; that holds whenever the
+ * output IDBs were copied from the input, as editcap and mergecap do.
+ */
+
+/** Can blocks be spliced from this input file to this output file at all?
+ * True only if both are pcapng and both are uncompressed, with the input
+ * open for random access.
+ */
+WS_DLL_PUBLIC bool pcapng_can_splice(wtap *wth, wtap_dumper *wdh);
+
+/** Splice the packet block at block_start (the record's data offset as
+ * returned by wtap_read()) from wth to wdh, patching the interface ID
+ * from rec.  Returns true if the block was written.  Returns false with
+ * *err set to 0 if this particular block can't be spliced (wrong byte
+ * order, unexpected block layout, modified record) and should be written
+ * through wtap_dump() instead, or with *err set to an error code on a
+ * read or write failure.
+ */
+WS_DLL_PUBLIC bool pcapng_splice_block(wtap *wth, wtap_dumper *wdh,
+                                       const wtap_rec *rec,
+                                       int64_t block_start,
+                                       int *err, char **err_info);
+
+/*
+ * Trailing interface statistics.  dumpcap writes one ISB per interface
+ * at the end of every file it closes, including each ring buffer file
+ * at rotation; since every pcapng block carries its total length as a
+ * trailer as well, those blocks can be walked backwards from the end of
+ * the file, giving per-file time bounds and packet counts without
+ * reading the records in between.
+ */
+typedef struct pcapng_if_stats_s {
+    uint32_t interface_id;      /**< interface the ISB applies to, within the last section */
+    uint64_t packets_delivered; /**< isb_usrdeliv, or UINT64_MAX if absent */
+    uint64_t dropped;           /**< isb_ifdrop, or UINT64_MAX if absent */
+    bool     has_start_time;    /**< isb_starttime was present and convertible */
+    bool     has_end_time;      /**< isb_endtime was present and convertible */
+    nstime_t start_time;
+    nstime_t end_time;
+} pcapng_if_stats_t;
+
+/** Read any interface statistics blocks at the very end of the file,
+ * appending one pcapng_if_stats_t per ISB to stats, oldest first.
+ * Returns true on success, with stats left empty if the file doesn't
+ * end in ISBs or can't be probed cheaply (not pcapng, or compressed);
+ * returns false with *err set on a read error.  The sequential reading
+ * position is left unchanged.
+ */
+WS_DLL_PUBLIC bool pcapng_read_trailing_statistics(wtap *wth, GArray *stats,
+                                                   int *err, char **err_info);
+
 #endif
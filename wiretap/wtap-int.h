@@ -76,6 +76,12 @@ struct wtap {
     wtap_new_ipv4_callback_t    add_new_ipv4;
     wtap_new_ipv6_callback_t    add_new_ipv6;
     wtap_new_secrets_callback_t add_new_secrets;
+    bool                        read_metadata_only; /**< The caller has promised
+                                                * not to look at the record
+                                                * data, so readers may skip
+                                                * over it instead of filling
+                                                * the caller's Buffer
+                                                */
     GPtrArray                   *fast_seek;
 };
 
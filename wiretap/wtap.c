@@ -505,6 +505,40 @@ wtap_get_debug_if_descr(const wtap_block_t if_descr,
 			if_descr_mand->num_stat_entries,
 			line_end);
 
+	for (unsigned i = 0; i < if_descr_mand->num_stat_entries; i++) {
+		wtap_block_t if_stats = g_array_index(if_descr_mand->interface_statistics,
+				wtap_block_t, i);
+
+		g_string_append_printf(info,
+				"%*cStat entry %u:%s", indent, ' ',
+				i,
+				line_end);
+		if (wtap_block_get_uint64_option_value(if_stats, OPT_ISB_IFRECV, &tmp64) == WTAP_OPTTYPE_SUCCESS) {
+			g_string_append_printf(info,
+					"%*c  Received = %" PRIu64 "%s", indent, ' ',
+					tmp64,
+					line_end);
+		}
+		if (wtap_block_get_uint64_option_value(if_stats, OPT_ISB_IFDROP, &tmp64) == WTAP_OPTTYPE_SUCCESS) {
+			g_string_append_printf(info,
+					"%*c  Dropped = %" PRIu64 "%s", indent, ' ',
+					tmp64,
+					line_end);
+		}
+		if (wtap_block_get_uint64_option_value(if_stats, OPT_ISB_USRDELIV, &tmp64) == WTAP_OPTTYPE_SUCCESS) {
+			g_string_append_printf(info,
+					"%*c  Delivered = %" PRIu64 "%s", indent, ' ',
+					tmp64,
+					line_end);
+		}
+		if (wtap_block_get_nth_string_option_value(if_stats, OPT_COMMENT, 0, &tmp_content) == WTAP_OPTTYPE_SUCCESS) {
+			g_string_append_printf(info,
+					"%*c  Comment = %s%s", indent, ' ',
+					tmp_content ? tmp_content : "NONE",
+					line_end);
+		}
+	}
+
 	return g_string_free(info, FALSE);
 }
 
@@ -1672,6 +1706,13 @@ wtapng_process_nrb(wtap *wth, wtap_block_t nrb)
 	wtapng_process_nrb_ipv6(wth, nrb);
 }
 
+void wtap_set_read_metadata_only(wtap *wth, bool metadata_only) {
+	if (!wth)
+		return;
+
+	wth->read_metadata_only = metadata_only;
+}
+
 void wtap_set_cb_new_secrets(wtap *wth, wtap_new_secrets_callback_t add_new_secrets) {
 	/* Is a valid wth given that supports DSBs? */
 	if (!wth || !wth->dsbs)
@@ -1953,6 +1994,15 @@ wtap_seek_read(wtap *wth, int64_t seek_off, wtap_rec *rec, Buffer *buf,
 	return true;
 }
 
+void
+wtap_prefetch(wtap *wth, int64_t offset, int64_t length)
+{
+	/* Advise on the random-access stream, which is the one
+	   wtap_seek_read() will use. */
+	if (wth->random_fh != NULL)
+		file_prefetch(wth->random_fh, offset, length);
+}
+
 static bool
 wtap_full_file_read_file(wtap *wth, FILE_T fh, wtap_rec *rec, Buffer *buf, int *err, char **err_info)
 {
@@ -1892,6 +1892,18 @@ typedef void (*wtap_new_secrets_callback_t)(uint32_t secrets_type, const void *s
 WS_DLL_PUBLIC
 void wtap_set_cb_new_secrets(wtap *wth, wtap_new_secrets_callback_t add_new_secrets);
 
+/**
+ * Promise that the caller will only look at the metadata in the wtap_rec
+ * filled in by wtap_read(), never at the record data in the Buffer.
+ * File formats that carry the record lengths in their headers may then
+ * skip over the data instead of copying it into the Buffer, which
+ * speeds up pure statistics passes such as capinfos.  The contents of
+ * the Buffer are undefined for records read under this promise.  Has no
+ * effect on file formats that don't support it.
+ */
+WS_DLL_PUBLIC
+void wtap_set_read_metadata_only(wtap *wth, bool metadata_only);
+
 /** Read the next record in the file, filling in *phdr and *buf.
  *
  * @wth a wtap * returned by a call that opened a file for reading.
@@ -1931,6 +1943,22 @@ WS_DLL_PUBLIC
 bool wtap_seek_read(wtap *wth, int64_t seek_off, wtap_rec *rec,
     Buffer *buf, int *err, char **err_info);
 
+/** Hint that records in the given region of the file are about to be
+ * read with wtap_seek_read(), e.g. the frames around the row selected
+ * in the packet list, so the OS can start fetching them before the
+ * reads are issued.  Purely advisory; does nothing for compressed
+ * files or on systems without posix_fadvise().
+ *
+ * @wth a wtap * returned by a call that opened a file for random-access
+ * reading.
+ * @param offset the offset in the file where the region starts; may
+ * be negative, in which case the region is clamped to the start of
+ * the file.
+ * @param length the length of the region.
+ */
+WS_DLL_PUBLIC
+void wtap_prefetch(wtap *wth, int64_t offset, int64_t length);
+
 /*** initialize a wtap_rec structure ***/
 WS_DLL_PUBLIC
 void wtap_rec_init(wtap_rec *rec);
@@ -330,6 +330,20 @@ wtap_block_get_nth_option(wtap_block_t block, unsigned option_id, unsigned idx)
     return NULL;
 }
 
+/*
+ * Recycling pool for packet blocks.  A packet block is created and
+ * destroyed for every record read from a capture file, so the heap
+ * traffic of that create/destroy pair shows up on high-rate read
+ * paths.  Keep a small stack of emptied blocks for reuse; a recycled
+ * block's options array keeps its capacity, so serving a record from
+ * the pool usually doesn't touch the allocator at all.
+ */
+#define PKT_BLOCK_POOL_SIZE 8
+
+static GMutex pkt_block_pool_mutex;
+static wtap_block_t pkt_block_pool[PKT_BLOCK_POOL_SIZE];
+static unsigned pkt_block_pool_count;
+
 wtap_block_t wtap_block_create(wtap_block_type_t block_type)
 {
     wtap_block_t block;
@@ -337,6 +351,24 @@ wtap_block_t wtap_block_create(wtap_block_type_t block_type)
     if (block_type >= MAX_WTAP_BLOCK_TYPE_VALUE)
         return NULL;
 
+    if (block_type == WTAP_BLOCK_PACKET) {
+        g_mutex_lock(&pkt_block_pool_mutex);
+        if (pkt_block_pool_count > 0) {
+            block = pkt_block_pool[--pkt_block_pool_count];
+            g_mutex_unlock(&pkt_block_pool_mutex);
+            /* The pooled block is empty: no options, no mandatory
+               data.  Just revive it. */
+            block->ref_count = 1;
+#ifdef DEBUG_COUNT_REFS
+            block->id = block_count++;
+            rc_set(block->id);
+            wtap_debug("Created #%d %s (recycled)", block->id, block->info->name);
+#endif /* DEBUG_COUNT_REFS */
+            return block;
+        }
+        g_mutex_unlock(&pkt_block_pool_mutex);
+    }
+
     block = g_new(struct wtap_block, 1);
     block->info = blocktype_list[block_type];
     block->options = g_array_new(false, false, sizeof(wtap_option_t));
@@ -441,6 +473,18 @@ void wtap_block_unref(wtap_block_t block)
 
             g_free(block->mandatory_data);
             wtap_block_free_options(block);
+            if (block->info->block_type == WTAP_BLOCK_PACKET) {
+                /* Recycle the block rather than freeing it; see the
+                   pool above wtap_block_create(). */
+                block->mandatory_data = NULL;
+                g_mutex_lock(&pkt_block_pool_mutex);
+                if (pkt_block_pool_count < PKT_BLOCK_POOL_SIZE) {
+                    pkt_block_pool[pkt_block_pool_count++] = block;
+                    g_mutex_unlock(&pkt_block_pool_mutex);
+                    return;
+                }
+                g_mutex_unlock(&pkt_block_pool_mutex);
+            }
             g_array_free(block->options, true);
             g_free(block);
         }
@@ -2271,6 +2315,15 @@ void wtap_opttypes_cleanup(void)
     uint8_t mask;
 #endif /* DEBUG_COUNT_REFS */
 
+    /* Drain the packet block recycling pool. */
+    g_mutex_lock(&pkt_block_pool_mutex);
+    while (pkt_block_pool_count > 0) {
+        wtap_block_t block = pkt_block_pool[--pkt_block_pool_count];
+        g_array_free(block->options, true);
+        g_free(block);
+    }
+    g_mutex_unlock(&pkt_block_pool_mutex);
+
     for (block_type = (unsigned)WTAP_BLOCK_SECTION;
          block_type < (unsigned)MAX_WTAP_BLOCK_TYPE_VALUE; block_type++) {
         if (blocktype_list[block_type]) {
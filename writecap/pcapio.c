@@ -169,6 +169,15 @@ struct ws_option {
 #define ISB_USRDELIV      8
 #define ADD_PADDING(x) ((((x) + 3) >> 2) << 2)
 
+/*
+ * Packets up to this size are staged, together with their record or
+ * block header and trailer, in one buffer on the stack and written
+ * with a single fwrite() call.  For short packets the per-call locking
+ * and bookkeeping in stdio costs more than the extra copy, and at high
+ * capture rates those calls dominate the writer's profile.
+ */
+#define WRITE_STAGE_MAX 256
+
 /* Write to capture file */
 static bool
 write_to_file(FILE* pfile, const uint8_t* data, size_t data_length,
@@ -227,6 +236,16 @@ libpcap_write_packet(FILE* pfile,
         rec_hdr.ts_usec = usec;
         rec_hdr.incl_len = caplen;
         rec_hdr.orig_len = len;
+
+        if (caplen <= WRITE_STAGE_MAX) {
+                /* Write header and data with a single fwrite() call. */
+                uint8_t stage[sizeof(rec_hdr) + WRITE_STAGE_MAX];
+
+                memcpy(stage, &rec_hdr, sizeof(rec_hdr));
+                memcpy(stage + sizeof(rec_hdr), pd, caplen);
+                return write_to_file(pfile, stage, sizeof(rec_hdr) + caplen, bytes_written, err);
+        }
+
         if (!write_to_file(pfile, (const uint8_t*)&rec_hdr, sizeof(rec_hdr), bytes_written, err))
                 return false;
 
@@ -584,6 +603,28 @@ pcapng_write_enhanced_packet_block(FILE* pfile,
         epb.timestamp_low = (uint32_t)(timestamp & 0xffffffff);
         epb.captured_len = caplen;
         epb.packet_len = len;
+
+        if (!comment && flags == 0 && caplen <= WRITE_STAGE_MAX) {
+                /* No options: stage the whole block - header, data,
+                   padding and trailing total length - and write it
+                   with a single fwrite() call. */
+                uint8_t stage[sizeof(struct epb) + ADD_PADDING(WRITE_STAGE_MAX) + sizeof(uint32_t)];
+                uint32_t offset;
+
+                memcpy(stage, &epb, sizeof(struct epb));
+                offset = (uint32_t)sizeof(struct epb);
+                memcpy(stage + offset, pd, caplen);
+                offset += caplen;
+                if (caplen % 4) {
+                        pad_len = 4 - (caplen % 4);
+                        memset(stage + offset, 0, pad_len);
+                        offset += pad_len;
+                }
+                memcpy(stage + offset, &block_total_length, sizeof(uint32_t));
+                offset += (uint32_t)sizeof(uint32_t);
+                return write_to_file(pfile, stage, offset, bytes_written, err);
+        }
+
         if (!write_to_file(pfile, (const uint8_t*)&epb, sizeof(struct epb), bytes_written, err))
                 return false;
         if (!write_to_file(pfile, pd, caplen, bytes_written, err))
@@ -641,6 +682,7 @@ pcapng_write_interface_statistics_block(FILE* pfile,
                                         uint64_t isb_endtime,   /* ISB_ENDTIME           3 */
                                         uint64_t isb_ifrecv,    /* ISB_IFRECV            4 */
                                         uint64_t isb_ifdrop,    /* ISB_IFDROP            5 */
+                                        uint64_t isb_usrdeliv,  /* ISB_USRDELIV          8 */
                                         int *err)
 {
         struct isb isb;
@@ -703,6 +745,10 @@ pcapng_write_interface_statistics_block(FILE* pfile,
                 options_length += (uint32_t)(sizeof(struct ws_option) +
                                             sizeof(uint64_t));
         }
+        if (isb_usrdeliv != UINT64_MAX) {
+                options_length += (uint32_t)(sizeof(struct ws_option) +
+                                            sizeof(uint64_t));
+        }
         /* OPT_COMMENT */
         options_length += pcapng_count_string_option(comment);
         if (isb_starttime !=0) {
@@ -782,6 +828,15 @@ pcapng_write_interface_statistics_block(FILE* pfile,
                 if (!write_to_file(pfile, (const uint8_t*)&isb_ifdrop, sizeof(uint64_t), bytes_written, err))
                         return false;
         }
+        if (isb_usrdeliv != UINT64_MAX) {
+                option.type = ISB_USRDELIV;
+                option.value_length = sizeof(uint64_t);
+                if (!write_to_file(pfile, (const uint8_t*)&option, sizeof(struct ws_option), bytes_written, err))
+                        return false;
+
+                if (!write_to_file(pfile, (const uint8_t*)&isb_usrdeliv, sizeof(uint64_t), bytes_written, err))
+                        return false;
+        }
         if (options_length != 0) {
                 /* write end of options */
                 option.type = OPT_ENDOFOPT;
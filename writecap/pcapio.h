@@ -86,6 +86,7 @@ pcapng_write_interface_statistics_block(FILE* pfile,
                                         uint64_t isb_endtime,   /* ISB_ENDTIME           3 */
                                         uint64_t isb_ifrecv,    /* ISB_IFRECV            4 */
                                         uint64_t isb_ifdrop,    /* ISB_IFDROP            5 */
+                                        uint64_t isb_usrdeliv,  /* ISB_USRDELIV          8 */
                                         int *err);
 
 extern bool
@@ -16,15 +16,28 @@
 #include <wsutil/wslog.h>
 
 #define SMALL_BUFFER_SIZE (2 * 1024) /* Everyone still uses 1500 byte frames, right? */
+#define MEDIUM_BUFFER_SIZE (16 * 1024) /* Catches jumbo frames and USB/D-Bus style records */
+#define LARGE_BUFFER_SIZE (256 * 1024) /* WTAP_MAX_PACKET_SIZE_STANDARD */
 static GPtrArray *small_buffers; /* Guaranteed to be at least SMALL_BUFFER_SIZE */
-/* XXX - Add medium and large buffers? */
+static GPtrArray *medium_buffers; /* Guaranteed to be exactly MEDIUM_BUFFER_SIZE */
+static GPtrArray *large_buffers; /* Guaranteed to be exactly LARGE_BUFFER_SIZE */
+
+/* Unlike the small pool, hanging on to an unbounded number of the
+	bigger buffers could cost real memory after a burst of large
+	records, so cap how many we keep for reuse. */
+#define MEDIUM_POOL_MAX 32
+#define LARGE_POOL_MAX 8
 
 /* Initializes a buffer with a certain amount of allocated space */
 void
 ws_buffer_init(Buffer* buffer, size_t space)
 {
 	ws_assert(buffer);
-	if (G_UNLIKELY(!small_buffers)) small_buffers = g_ptr_array_sized_new(1024);
+	if (G_UNLIKELY(!small_buffers)) {
+		small_buffers = g_ptr_array_sized_new(1024);
+		medium_buffers = g_ptr_array_sized_new(MEDIUM_POOL_MAX);
+		large_buffers = g_ptr_array_sized_new(LARGE_POOL_MAX);
+	}
 
 	if (space <= SMALL_BUFFER_SIZE) {
 		if (small_buffers->len > 0) {
@@ -34,6 +47,22 @@ ws_buffer_init(Buffer* buffer, size_t space)
 			buffer->data = (uint8_t*)g_malloc(SMALL_BUFFER_SIZE);
 		}
 		buffer->allocated = SMALL_BUFFER_SIZE;
+	} else if (space <= MEDIUM_BUFFER_SIZE) {
+		if (medium_buffers->len > 0) {
+			buffer->data = (uint8_t*) g_ptr_array_remove_index(medium_buffers, medium_buffers->len - 1);
+			ws_assert(buffer->data);
+		} else {
+			buffer->data = (uint8_t*)g_malloc(MEDIUM_BUFFER_SIZE);
+		}
+		buffer->allocated = MEDIUM_BUFFER_SIZE;
+	} else if (space <= LARGE_BUFFER_SIZE) {
+		if (large_buffers->len > 0) {
+			buffer->data = (uint8_t*) g_ptr_array_remove_index(large_buffers, large_buffers->len - 1);
+			ws_assert(buffer->data);
+		} else {
+			buffer->data = (uint8_t*)g_malloc(LARGE_BUFFER_SIZE);
+		}
+		buffer->allocated = LARGE_BUFFER_SIZE;
 	} else {
 		buffer->data = (uint8_t*)g_malloc(space);
 		buffer->allocated = space;
@@ -50,6 +79,14 @@ ws_buffer_free(Buffer* buffer)
 	if (buffer->allocated == SMALL_BUFFER_SIZE) {
 		ws_assert(buffer->data);
 		g_ptr_array_add(small_buffers, buffer->data);
+	} else if (buffer->allocated == MEDIUM_BUFFER_SIZE &&
+			medium_buffers->len < MEDIUM_POOL_MAX) {
+		ws_assert(buffer->data);
+		g_ptr_array_add(medium_buffers, buffer->data);
+	} else if (buffer->allocated == LARGE_BUFFER_SIZE &&
+			large_buffers->len < LARGE_POOL_MAX) {
+		ws_assert(buffer->data);
+		g_ptr_array_add(large_buffers, buffer->data);
 	} else {
 		g_free(buffer->data);
 	}
@@ -95,8 +132,18 @@ ws_buffer_assure_space(Buffer* buffer, size_t space)
 		return;
 	}
 
-	/* We'll allocate more space */
-	buffer->allocated += space + 1024;
+	/* We'll allocate more space. Grow to the next pooled size class
+		when one fits, so that a grown buffer can be recycled by
+		ws_buffer_free() and repeated appends step through the classes
+		instead of reallocating a little bit at a time. */
+	space_used = buffer->first_free + space;
+	if (space_used <= MEDIUM_BUFFER_SIZE) {
+		buffer->allocated = MEDIUM_BUFFER_SIZE;
+	} else if (space_used <= LARGE_BUFFER_SIZE) {
+		buffer->allocated = LARGE_BUFFER_SIZE;
+	} else {
+		buffer->allocated = space_used + 1024;
+	}
 	buffer->data = (uint8_t*)g_realloc(buffer->data, buffer->allocated);
 }
 
@@ -189,6 +236,12 @@ ws_buffer_cleanup(void)
 		g_ptr_array_set_free_func(small_buffers, g_free);
 		g_ptr_array_free(small_buffers, true);
 		small_buffers = NULL;
+		g_ptr_array_set_free_func(medium_buffers, g_free);
+		g_ptr_array_free(medium_buffers, true);
+		medium_buffers = NULL;
+		g_ptr_array_set_free_func(large_buffers, g_free);
+		g_ptr_array_free(large_buffers, true);
+		large_buffers = NULL;
 	}
 }
 
@@ -476,6 +476,52 @@ get_cpu_info(GString *str)
      */
     if (ws_cpuid_sse42())
         g_string_append(str, " (with SSE4.2)");
+
+    /*
+     * On multi-socket machines, mention the number of memory nodes;
+     * memory placement matters for performance there, so it's worth
+     * having in bug reports.
+     */
+    unsigned numa_nodes = get_numa_node_count();
+    if (numa_nodes > 1)
+        g_string_append_printf(str, " (%u NUMA nodes)", numa_nodes);
+}
+
+unsigned
+get_numa_node_count(void)
+{
+#if defined(__linux__)
+    /*
+     * The kernel creates one "nodeN" directory per online memory node.
+     * Count them; a machine without NUMA support compiled in just
+     * doesn't have the directory, which we report as a single node.
+     */
+    GDir *node_dir;
+    const char *name;
+    unsigned count = 0;
+
+    node_dir = g_dir_open("/sys/devices/system/node", 0, NULL);
+    if (node_dir == NULL)
+        return 1;
+    while ((name = g_dir_read_name(node_dir)) != NULL) {
+        if (strncmp(name, "node", 4) == 0 && g_ascii_isdigit(name[4]))
+            count++;
+    }
+    g_dir_close(node_dir);
+    return count > 0 ? count : 1;
+#elif defined(_WIN32)
+    ULONG highest_node;
+
+    if (!GetNumaHighestNodeNumber(&highest_node))
+        return 1;
+    return (unsigned)highest_node + 1;
+#else
+    /*
+     * No portable way to ask; the BSDs and macOS don't currently ship
+     * on multi-node hardware we care about.
+     */
+    return 1;
+#endif
 }
 
 /*
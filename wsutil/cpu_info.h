@@ -19,6 +19,14 @@ extern "C" {
 
 WS_DLL_PUBLIC void get_cpu_info(GString *str);
 
+/**
+ * Return the number of NUMA memory nodes, or 1 if the machine has a
+ * single node or the OS doesn't expose the topology.  Parallel code
+ * that places buffers by first touch can use this to decide whether
+ * partitioning work by node is worth the trouble.
+ */
+WS_DLL_PUBLIC unsigned get_numa_node_count(void);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
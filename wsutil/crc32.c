@@ -15,7 +15,21 @@
 
 #include "config.h"
 
+/* see bug 10798: there is a bug in the compiler the buildbots use for Mac OSX
+   and SSE4.2, so we're not going to use SSE4.2 with Mac OSX right now, for
+   older Mac OSX compilers.
+ */
+#ifdef __APPLE__
+#if defined(__clang__) && (__clang_major__ >= 6)
+/* allow HAVE_SSE4_2 to be used for clang 6.0+ case because we know it works */
+#else
+/* don't allow it otherwise, for Mac OSX */
+#undef HAVE_SSE4_2
+#endif
+#endif
+
 #include <wsutil/crc32.h>
+#include "crc32_int.h"
 
 #ifdef HAVE_ZLIBNG
 #include <zlib-ng.h>
@@ -376,18 +390,19 @@ crc32_ccitt_table_lookup (unsigned char pos)
 uint32_t
 crc32c_calculate(const void *buf, int len, uint32_t crc)
 {
-	const uint8_t *p = (const uint8_t *)buf;
-	crc = CRC32C_SWAP(crc);
-	while (len-- > 0) {
-		CRC32C(crc, *p++);
-	}
-	return CRC32C_SWAP(crc);
+	return CRC32C_SWAP(crc32c_calculate_no_swap(buf, len,
+	    CRC32C_SWAP(crc)));
 }
 
 uint32_t
 crc32c_calculate_no_swap(const void *buf, int len, uint32_t crc)
 {
 	const uint8_t *p = (const uint8_t *)buf;
+
+#ifdef HAVE_SSE4_2
+	if (crc32c_sse42_available())
+		return crc32c_sse42_calculate_no_swap(buf, len, crc);
+#endif
 	while (len-- > 0) {
 		CRC32C(crc, *p++);
 	}
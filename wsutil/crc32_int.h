@@ -0,0 +1,40 @@
+/** @file
+ *
+ * Internal interfaces between the portable CRC-32 routines and the
+ * hardware-accelerated implementations.
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __CRC32_INT_H__
+#define __CRC32_INT_H__
+
+#ifdef HAVE_SSE4_2
+/* Returns true if the processor implements the SSE4.2 crc32 instruction;
+ * the answer is computed once and cached. */
+bool crc32c_sse42_available(void);
+
+/* CRC-32C accumulation using the SSE4.2 crc32 instruction. Operates on
+ * the same reflected (little-endian) state as the table-driven loop in
+ * crc32.c, so the two are interchangeable mid-stream. */
+uint32_t crc32c_sse42_calculate_no_swap(const void *buf, int len, uint32_t crc);
+#endif /* HAVE_SSE4_2 */
+
+#endif /* __CRC32_INT_H__ */
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 8
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * End:
+ *
+ * vi: set shiftwidth=8 tabstop=8 noexpandtab:
+ * :indentSize=8:tabSize=8:noTabs=false:
+ */
@@ -0,0 +1,96 @@
+/* crc32_sse42.c
+ * CRC-32C using the SSE4.2 crc32 instruction
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+
+#ifdef HAVE_SSE4_2
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ws_cpuid.h"
+
+#include <nmmintrin.h>
+
+#include "crc32_int.h"
+
+bool
+crc32c_sse42_available(void)
+{
+	static int available = -1;
+
+	if (available < 0)
+		available = ws_cpuid_sse42() ? 1 : 0;
+	return available != 0;
+}
+
+/*
+ * The crc32 instruction computes exactly the CRC described by the
+ * crc32c_table in crc32.c (polynomial 0x1EDC6F41, reflected), directly
+ * on the reflected state, so this drops in for the byte-at-a-time
+ * CRC32C() loop with no pre- or post-processing.
+ */
+uint32_t
+crc32c_sse42_calculate_no_swap(const void *buf, int len, uint32_t crc)
+{
+	const uint8_t *p = (const uint8_t *)buf;
+
+	/* Process single bytes until the pointer is word aligned. */
+	while (len > 0 && ((uintptr_t)p & 7) != 0) {
+		crc = _mm_crc32_u8(crc, *p++);
+		len--;
+	}
+
+#if defined(__x86_64__) || defined(_M_X64)
+	{
+		uint64_t crc64 = crc;
+
+		while (len >= 8) {
+			uint64_t data;
+
+			memcpy(&data, p, sizeof(data));
+			crc64 = _mm_crc32_u64(crc64, data);
+			p += 8;
+			len -= 8;
+		}
+		crc = (uint32_t)crc64;
+	}
+#else
+	while (len >= 4) {
+		uint32_t data;
+
+		memcpy(&data, p, sizeof(data));
+		crc = _mm_crc32_u32(crc, data);
+		p += 4;
+		len -= 4;
+	}
+#endif
+
+	while (len-- > 0)
+		crc = _mm_crc32_u8(crc, *p++);
+
+	return crc;
+}
+
+#endif /* HAVE_SSE4_2 */
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 8
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * End:
+ *
+ * vi: set shiftwidth=8 tabstop=8 noexpandtab:
+ * :indentSize=8:tabSize=8:noTabs=false:
+ */
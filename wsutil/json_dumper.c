@@ -86,22 +86,31 @@ void Allocate_Memory(void)
     Length = 0;
 }
 
-void Construct_Result(char c)
+/* Append a run of bytes to the result buffer, keeping it NUL-terminated. */
+static void
+Append_Result(const char *s, size_t len)
 {
-    *(large_strings + Length) = c;
-    Length++;
+    if (flag == 0)
+    {
+        Allocate_Memory();
+    }
+    if (large_strings == NULL) {
+        return;
+    }
+    memcpy(large_strings + Length, s, len);
+    Length += len;
     *(large_strings + Length) = '\0';
 }
 
+void Construct_Result(char c)
+{
+    Append_Result(&c, 1);
+}
+
 /* JSON Dumper putc */
 static void
 jd_putc(const json_dumper* dumper, char c)
 {
-    if (flag == 0)
-    {
-        Allocate_Memory();
-    }
-
     if (dumper->output_file) {
         Construct_Result(c);
         if(!disable_console) fputc(c, dumper->output_file);
@@ -112,16 +121,12 @@ jd_putc(const json_dumper* dumper, char c)
     }
 }
 
-// Md. Akib Hossain Omi
 /* JSON Dumper puts */
 static void
 jd_puts(const json_dumper* dumper, const char* s)
 {
     if (dumper->output_file) {
-        for (size_t size = 0; size < strlen(s); size++) 
-        {
-            Construct_Result(s[size]);
-        }
+        Append_Result(s, strlen(s));
         if(!disable_console) fputs(s, dumper->output_file);
     }
 
@@ -134,7 +139,8 @@ static void
 jd_puts_len(const json_dumper *dumper, const char *s, size_t len)
 {
     if (dumper->output_file) {
-        fwrite(s, 1, len, dumper->output_file);
+        Append_Result(s, len);
+        if(!disable_console) fwrite(s, 1, len, dumper->output_file);
     }
 
     if (dumper->output_string) {
@@ -145,13 +151,20 @@ jd_puts_len(const json_dumper *dumper, const char *s, size_t len)
 static void
 jd_vprintf(const json_dumper *dumper, const char *format, va_list args)
 {
+    /* Format once, so the result lands in every sink (formatting
+       directly into each sink would also reuse the va_list, which
+       isn't portable). */
+    char *s = g_strdup_vprintf(format, args);
+
     if (dumper->output_file) {
-        vfprintf(dumper->output_file, format, args);
+        Append_Result(s, strlen(s));
+        if(!disable_console) fputs(s, dumper->output_file);
     }
 
     if (dumper->output_string) {
-        g_string_append_vprintf(dumper->output_string, format, args);
+        g_string_append(dumper->output_string, s);
     }
+    g_free(s);
 }
 
 static void
@@ -168,22 +181,37 @@ json_puts_string(const json_dumper *dumper, const char *str, bool dot_to_undersc
     };
 
     jd_putc(dumper, '"');
-    for (int i = 0; str[i]; i++) {
-        if ((unsigned)str[i] < 0x20) {
+    /* Emit runs of characters that need no escaping in one call each;
+       most strings contain few or no characters that do. */
+    int start = 0;
+    int i;
+    for (i = 0; str[i]; i++) {
+        unsigned char c = (unsigned char)str[i];
+
+        if (c >= 0x20 && c != '\\' && c != '"' &&
+            !(dot_to_underscore && c == '.') &&
+            !(c == '/' && i > 0 && str[i - 1] == '<')) {
+            continue;
+        }
+        if (i > start) {
+            jd_puts_len(dumper, str + start, i - start);
+        }
+        if (c < 0x20) {
             jd_putc(dumper, '\\');
-            jd_puts(dumper, json_cntrl[(unsigned)str[i]]);
-        } else if (i > 0 && str[i - 1] == '<' && str[i] == '/') {
+            jd_puts(dumper, json_cntrl[c]);
+        } else if (c == '/') {
             // Convert </script> to <\/script> to avoid breaking web pages.
             jd_puts(dumper, "\\/");
+        } else if (c == '.') {
+            jd_putc(dumper, '_');
         } else {
-            if (str[i] == '\\' || str[i] == '"') {
-                jd_putc(dumper, '\\');
-            }
-            if (dot_to_underscore && str[i] == '.')
-                jd_putc(dumper, '_');
-            else
-                jd_putc(dumper, str[i]);
+            jd_putc(dumper, '\\');
+            jd_putc(dumper, (char)c);
         }
+        start = i + 1;
+    }
+    if (i > start) {
+        jd_puts_len(dumper, str + start, i - start);
     }
     jd_putc(dumper, '"');
 }
@@ -17,6 +17,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <inttypes.h>
 
 #include <gmodule.h>
 
@@ -39,6 +40,31 @@ typedef struct _plugin {
 
 static GSList *plugins_module_list;
 
+/*
+ * Plugin scan cache.
+ *
+ * Probing a candidate file means dlopening it and looking up symbols,
+ * which is expensive on network filesystems. Plugins that register
+ * anything have to be loaded anyway, so those probes cannot be avoided,
+ * but files that were rejected (wrong ABI version, missing symbols,
+ * not loadable) are probed again on every startup for nothing. The scan
+ * cache remembers the outcome of the last probe of each file, keyed by
+ * path and validated by size and mtime, so unchanged rejects are skipped
+ * with a single stat and the cached failure is re-reported instead.
+ */
+typedef struct _plugin_cache_entry {
+    char    *path;
+    int64_t  mtime;
+    int64_t  size;
+    bool     ok;        /* false if the last probe rejected the file */
+    char    *info;      /* plugin version if ok, failure message otherwise */
+} plugin_cache_entry;
+
+#define PLUGIN_SCAN_CACHE_FILE "plugin_scan_cache"
+
+static GHashTable *plugin_scan_cache;
+static bool plugin_scan_cache_dirty;
+
 
 static inline const char *
 type_to_dir(plugin_type_e type)
@@ -93,31 +119,136 @@ compare_plugins(const void *a, const void *b)
     return g_strcmp0((*(plugin *const *)a)->name, (*(plugin *const *)b)->name);
 }
 
-static bool
-pass_plugin_version_compatibility(GModule *handle, const char *name)
+static void
+free_plugin_cache_entry(void *data)
+{
+    plugin_cache_entry *entry = (plugin_cache_entry *)data;
+    g_free(entry->path);
+    g_free(entry->info);
+    g_free(entry);
+}
+
+static void
+plugin_scan_cache_load(void)
+{
+    char *path;
+    FILE *fp;
+    char line[1024];
+
+    if (plugin_scan_cache != NULL)
+        return;
+
+    plugin_scan_cache = g_hash_table_new_full(g_str_hash, g_str_equal,
+                                                NULL, free_plugin_cache_entry);
+
+    path = get_persconffile_path(PLUGIN_SCAN_CACHE_FILE, false);
+    fp = ws_fopen(path, "r");
+    g_free(path);
+    if (fp == NULL)
+        return;
+
+    while (fgets(line, (int)sizeof(line), fp) != NULL) {
+        char **fields;
+
+        if (line[0] == '#')
+            continue;
+
+        fields = g_strsplit(g_strchomp(line), "\t", 5);
+        if (g_strv_length(fields) == 5) {
+            plugin_cache_entry *entry = g_new(plugin_cache_entry, 1);
+
+            entry->path = g_strdup(fields[0]);
+            entry->mtime = g_ascii_strtoll(fields[1], NULL, 10);
+            entry->size = g_ascii_strtoll(fields[2], NULL, 10);
+            entry->ok = (strcmp(fields[3], "ok") == 0);
+            entry->info = g_strdup(fields[4]);
+            g_hash_table_replace(plugin_scan_cache, entry->path, entry);
+        }
+        g_strfreev(fields);
+    }
+    fclose(fp);
+}
+
+static void
+plugin_scan_cache_save(void)
+{
+    char *path;
+    FILE *fp;
+    GHashTableIter iter;
+    void * value;
+
+    if (plugin_scan_cache == NULL || !plugin_scan_cache_dirty)
+        return;
+
+    path = get_persconffile_path(PLUGIN_SCAN_CACHE_FILE, true);
+    fp = ws_fopen(path, "w");
+    g_free(path);
+    if (fp == NULL)
+        return;
+
+    fprintf(fp, "# Plugin scan cache. This file is automatically generated, DO NOT MODIFY.\n");
+    g_hash_table_iter_init(&iter, plugin_scan_cache);
+    while (g_hash_table_iter_next(&iter, NULL, &value)) {
+        plugin_cache_entry *entry = (plugin_cache_entry *)value;
+
+        fprintf(fp, "%s\t%" PRId64 "\t%" PRId64 "\t%s\t%s\n",
+                entry->path, entry->mtime, entry->size,
+                entry->ok ? "ok" : "fail", entry->info);
+    }
+    fclose(fp);
+    plugin_scan_cache_dirty = false;
+}
+
+static void
+plugin_scan_cache_update(const char *path, int64_t mtime, int64_t size,
+                         bool ok, const char *info)
+{
+    plugin_cache_entry *entry;
+
+    if (plugin_scan_cache == NULL)
+        return;
+
+    entry = (plugin_cache_entry *)g_hash_table_lookup(plugin_scan_cache, path);
+    if (entry != NULL && entry->mtime == mtime && entry->size == size &&
+        entry->ok == ok && g_strcmp0(entry->info, info) == 0) {
+        /* Unchanged, don't rewrite the cache file for nothing. */
+        return;
+    }
+
+    entry = g_new(plugin_cache_entry, 1);
+    entry->path = g_strdup(path);
+    entry->mtime = mtime;
+    entry->size = size;
+    entry->ok = ok;
+    entry->info = g_strdup(info);
+    g_hash_table_replace(plugin_scan_cache, entry->path, entry);
+    plugin_scan_cache_dirty = true;
+}
+
+/* Returns NULL if compatible, a failure message (to be freed with g_free)
+ * otherwise. */
+static char *
+check_plugin_version_compatibility(GModule *handle, const char *name)
 {
     void * symb;
     int major, minor;
 
     if(!g_module_symbol(handle, "plugin_want_major", &symb)) {
-        report_failure("The plugin '%s' has no \"plugin_want_major\" symbol", name);
-        return false;
+        return g_strdup_printf("The plugin '%s' has no \"plugin_want_major\" symbol", name);
     }
     major = *(int *)symb;
 
     if(!g_module_symbol(handle, "plugin_want_minor", &symb)) {
-        report_failure("The plugin '%s' has no \"plugin_want_minor\" symbol", name);
-        return false;
+        return g_strdup_printf("The plugin '%s' has no \"plugin_want_minor\" symbol", name);
     }
     minor = *(int *)symb;
 
     if (major != VERSION_MAJOR || minor != VERSION_MINOR) {
-        report_failure("The plugin '%s' was compiled for Wireshark version %d.%d",
+        return g_strdup_printf("The plugin '%s' was compiled for Wireshark version %d.%d",
                             name, major, minor);
-        return false;
     }
 
-    return true;
+    return NULL;
 }
 
 // GLib and Qt allow ".dylib" and ".so" on macOS. Should we do the same?
@@ -139,6 +270,9 @@ scan_plugins_dir(GHashTable *plugins_module, const char *dirpath, plugin_type_e
     const char    *plug_version;
     uint32_t       flags;
     plugin        *new_plug;
+    ws_statb64     st;
+    bool           have_stat;
+    char          *errmsg;
 
     if (append_type)
         plugin_folder = g_build_filename(dirpath, type_to_dir(type), (char *)NULL);
@@ -169,34 +303,54 @@ scan_plugins_dir(GHashTable *plugins_module, const char *dirpath, plugin_type_e
         }
 
         plugin_file = g_build_filename(plugin_folder, name, (char *)NULL);
+
+        have_stat = (ws_stat64(plugin_file, &st) == 0);
+
+        /* If the file is unchanged since a scan that rejected it, skip
+         * the dlopen probe and re-report the cached failure. */
+        if (have_stat && plugin_scan_cache != NULL) {
+            plugin_cache_entry *entry;
+
+            entry = (plugin_cache_entry *)g_hash_table_lookup(plugin_scan_cache, plugin_file);
+            if (entry != NULL && !entry->ok &&
+                entry->mtime == (int64_t)st.st_mtime &&
+                entry->size == (int64_t)st.st_size) {
+                report_failure("%s", entry->info);
+                g_free(plugin_file);
+                continue;
+            }
+        }
+
+        errmsg = NULL;
+        plug_version = NULL;
         handle = g_module_open(plugin_file, G_MODULE_BIND_LOCAL);
         if (handle == NULL) {
             /* g_module_error() provides file path. */
-            report_failure("Couldn't load plugin '%s': %s", name,
+            errmsg = g_strdup_printf("Couldn't load plugin '%s': %s", name,
                             g_module_error());
-            g_free(plugin_file);
-            continue;
         }
-
-        if (!g_module_symbol(handle, "plugin_version", &symbol))
-        {
-            report_failure("The plugin '%s' has no \"plugin_version\" symbol", name);
-            g_module_close(handle);
-            g_free(plugin_file);
-            continue;
+        else if (!g_module_symbol(handle, "plugin_version", &symbol)) {
+            errmsg = g_strdup_printf("The plugin '%s' has no \"plugin_version\" symbol", name);
         }
-        plug_version = (const char *)symbol;
-
-        if (!pass_plugin_version_compatibility(handle, name)) {
-            g_module_close(handle);
-            g_free(plugin_file);
-            continue;
+        else {
+            plug_version = (const char *)symbol;
+            errmsg = check_plugin_version_compatibility(handle, name);
+
+            /* Search for the entry point for the plugin registration function */
+            if (errmsg == NULL && !g_module_symbol(handle, "plugin_register", &symbol)) {
+                errmsg = g_strdup_printf("The plugin '%s' has no \"plugin_register\" symbol", name);
+            }
         }
 
-        /* Search for the entry point for the plugin registration function */
-        if (!g_module_symbol(handle, "plugin_register", &symbol)) {
-            report_failure("The plugin '%s' has no \"plugin_register\" symbol", name);
-            g_module_close(handle);
+        if (errmsg != NULL) {
+            report_failure("%s", errmsg);
+            if (have_stat) {
+                plugin_scan_cache_update(plugin_file, (int64_t)st.st_mtime,
+                                         (int64_t)st.st_size, false, errmsg);
+            }
+            g_free(errmsg);
+            if (handle != NULL)
+                g_module_close(handle);
             g_free(plugin_file);
             continue;
         }
@@ -221,6 +375,10 @@ DIAG_ON_PEDANTIC
         /* Add it to the list of plugins. */
         g_hash_table_replace(plugins_module, new_plug->name, new_plug);
         ws_info("Registered plugin: %s (%s)", new_plug->name, plugin_file);
+        if (have_stat) {
+            plugin_scan_cache_update(plugin_file, (int64_t)st.st_mtime,
+                                     (int64_t)st.st_size, true, plug_version);
+        }
         g_free(plugin_file);
     }
     ws_dir_close(dir);
@@ -238,6 +396,14 @@ plugins_init(plugin_type_e type)
 
     GHashTable *plugins_module = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, free_plugin);
 
+    /*
+     * The scan cache lives in the personal configuration directory, so
+     * leave it alone when running with special privileges.
+     */
+    if (!started_with_special_privs()) {
+        plugin_scan_cache_load();
+    }
+
     /*
      * Scan the global plugin directory.
      */
@@ -255,6 +421,8 @@ plugins_init(plugin_type_e type)
         scan_plugins_dir(plugins_module, get_plugins_pers_dir_with_version(), type, true);
     }
 
+    plugin_scan_cache_save();
+
     plugins_module_list = g_slist_prepend(plugins_module_list, plugins_module);
 
     return plugins_module;
@@ -17,6 +17,9 @@
 struct _ws_regex {
     pcre2_code *code;
     char *pattern;
+    /* Created once with the pattern and reused for every match; the
+     * per-match allocation dominated the cost of short subjects. */
+    pcre2_match_data *match_data;
 };
 
 #define ERROR_MAXLEN_IN_CODE_UNITS   128
@@ -89,9 +92,14 @@ ws_regex_compile_ex(const char *patt, ssize_t size, char **errmsg, unsigned flag
     if (code == NULL)
         return NULL;
 
+    /* Request JIT compilation; if the PCRE2 build lacks JIT support
+     * this fails and pcre2_match() just uses the interpreter. */
+    pcre2_jit_compile(code, PCRE2_JIT_COMPLETE);
+
     ws_regex_t *re = g_new(ws_regex_t, 1);
     re->code = code;
     re->pattern = ws_escape_string_len(NULL, patt, size, false);
+    re->match_data = pcre2_match_data_create_from_pattern(code, NULL);
     return re;
 }
 
@@ -151,18 +159,10 @@ bool
 ws_regex_matches_length(const ws_regex_t *re,
                         const char *subj, ssize_t subj_length)
 {
-    bool matched;
-    pcre2_match_data *match_data;
-
     ws_return_val_if(!re, false);
     ws_return_val_if(!subj, false);
 
-    /* We don't use the matched substring but pcre2_match requires
-     * at least one pair of offsets. */
-    match_data = pcre2_match_data_create(1, NULL);
-    matched = match_pcre2(re->code, subj, subj_length, 0, match_data);
-    pcre2_match_data_free(match_data);
-    return matched;
+    return match_pcre2(re->code, subj, subj_length, 0, re->match_data);
 }
 
 
@@ -172,19 +172,17 @@ ws_regex_matches_pos(const ws_regex_t *re,
                         size_t subj_offset, size_t pos_vect[2])
 {
     bool matched;
-    pcre2_match_data *match_data;
 
     ws_return_val_if(!re, false);
     ws_return_val_if(!subj, false);
 
-    match_data = pcre2_match_data_create(1, NULL);
-    matched = match_pcre2(re->code, subj, subj_length, subj_offset, match_data);
+    matched = match_pcre2(re->code, subj, subj_length, subj_offset,
+                            re->match_data);
     if (matched && pos_vect) {
-        PCRE2_SIZE *ovect = pcre2_get_ovector_pointer(match_data);
+        PCRE2_SIZE *ovect = pcre2_get_ovector_pointer(re->match_data);
         pos_vect[0] = ovect[0];
         pos_vect[1] = ovect[1];
     }
-    pcre2_match_data_free(match_data);
     return matched;
 }
 
@@ -192,6 +190,7 @@ ws_regex_matches_pos(const ws_regex_t *re,
 void
 ws_regex_free(ws_regex_t *re)
 {
+    pcre2_match_data_free(re->match_data);
     pcre2_code_free(re->code);
     g_free(re->pattern);
     g_free(re);
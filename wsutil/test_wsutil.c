@@ -697,6 +697,36 @@ static void free_argv(char **argv)
     g_free(argv);
 }
 
+#include "ws_mempbrk.h"
+
+static void test_mempbrk(void)
+{
+    ws_mempbrk_pattern patt;
+    const uint8_t haystack[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+    unsigned char found;
+
+    /* Few needles: exercises the memchr() fast path. */
+    ws_mempbrk_compile(&patt, "\r\n");
+    g_assert_null(ws_mempbrk_exec(haystack, sizeof(haystack) - 1, &patt, &found));
+
+    ws_mempbrk_compile(&patt, "98");
+    found = 0;
+    g_assert_true(ws_mempbrk_exec(haystack, sizeof(haystack) - 1, &patt, &found) == haystack + 34);
+    g_assert_cmpint(found, ==, '8');
+
+    /* Earliest needle must win regardless of pattern order. */
+    ws_mempbrk_compile(&patt, "zx");
+    found = 0;
+    g_assert_true(ws_mempbrk_exec(haystack, sizeof(haystack) - 1, &patt, &found) == haystack + 23);
+    g_assert_cmpint(found, ==, 'x');
+
+    /* More needles than the fast path handles: table scan. */
+    ws_mempbrk_compile(&patt, "!?#$5");
+    found = 0;
+    g_assert_true(ws_mempbrk_exec(haystack, sizeof(haystack) - 1, &patt, &found) == haystack + 31);
+    g_assert_cmpint(found, ==, '5');
+}
+
 static void test_getopt_long_basic1(void)
 {
     char **argv;
@@ -881,6 +911,8 @@ int main(int argc, char **argv)
 
     g_test_add_func("/nstime/from_iso8601", test_nstime_from_iso8601);
 
+    g_test_add_func("/mempbrk/mempbrk", test_mempbrk);
+
     g_test_add_func("/ws_getopt/basic1", test_getopt_long_basic1);
     g_test_add_func("/ws_getopt/basic2", test_getopt_long_basic2);
     g_test_add_func("/ws_getopt/optional1", test_getopt_optional_argument1);
@@ -12,6 +12,8 @@
 
 #include "unicode-utils.h"
 
+#include <string.h>
+
 const int ws_utf8_seqlen[256] = {
     1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,  /* 0x00...0x0f */
     1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,  /* 0x10...0x1f */
@@ -51,6 +53,23 @@ utf_8_validate(const uint8_t *start, ssize_t length, const uint8_t **end)
 
     while (length > 0) {
 
+        /* Skip over runs of ASCII eight bytes at a time; checking the
+         * high bit of a word costs much less than the per-byte sequence
+         * length checks below, and most protocol strings are mostly (or
+         * entirely) ASCII. */
+        while (length >= 8) {
+            uint64_t chunk;
+
+            memcpy(&chunk, ptr, sizeof(chunk));
+            if (chunk & UINT64_C(0x8080808080808080))
+                break;
+            valid_bytes += 8;
+            ptr += 8;
+            length -= 8;
+        }
+        if (length == 0)
+            break;
+
         ch = *ptr;
 
         if (ch < 0x80) {
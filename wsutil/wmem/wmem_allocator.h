@@ -35,6 +35,12 @@ struct _wmem_allocator_t {
     void  (*gc)(void *private_data);
     void  (*cleanup)(void *private_data);
 
+    /* Optional watermark support for wmem_snapshot()/wmem_rollback();
+     * both NULL if the allocator cannot return to an earlier allocation
+     * point. */
+    void *(*snapshot)(void *private_data);
+    void  (*rollback)(void *private_data, void *snapshot);
+
     /* Callback List */
     struct _wmem_user_cb_container_t *callbacks;
 
@@ -63,8 +63,19 @@ typedef struct _wmem_block_fast_jumbo {
 typedef struct {
     wmem_block_fast_hdr_t   *block_list;
     wmem_block_fast_jumbo_t *jumbo_list;
+    unsigned                 jumbo_count;
 } wmem_block_fast_allocator_t;
 
+/* The state recorded by wmem_snapshot(): the block that was current when
+ * the snapshot was taken and its fill position, plus the number of jumbo
+ * blocks in existence. Jumbo blocks are counted rather than remembered by
+ * address because reallocating a pre-snapshot jumbo moves it. */
+typedef struct {
+    wmem_block_fast_hdr_t *block;
+    int32_t                pos;
+    unsigned               jumbo_count;
+} wmem_block_fast_snapshot_t;
+
 /* Creates a new block, and initializes it. */
 static inline void
 wmem_block_fast_new_block(wmem_block_fast_allocator_t *allocator)
@@ -102,6 +113,7 @@ wmem_block_fast_alloc(void *private_data, const size_t size)
         }
         block->prev = NULL;
         allocator->jumbo_list = block;
+        allocator->jumbo_count++;
 
         chunk = ((wmem_block_fast_chunk_t*)((uint8_t*)(block) + WMEM_JUMBO_HEADER_SIZE));
         chunk->len = JUMBO_MAGIC;
@@ -205,6 +217,57 @@ wmem_block_fast_free_all(void *private_data)
         cur_jum = nxt_jum;
     }
     allocator->jumbo_list = NULL;
+    allocator->jumbo_count = 0;
+}
+
+static void *
+wmem_block_fast_snapshot(void *private_data)
+{
+    wmem_block_fast_allocator_t *allocator = (wmem_block_fast_allocator_t*) private_data;
+    wmem_block_fast_snapshot_t  *snapshot;
+
+    /* Allocate the snapshot record itself from the pool before recording
+     * the watermark; that way rolling back leaves it valid (so it can be
+     * rolled back to more than once) and it is reclaimed along with
+     * everything else by the next free_all. */
+    snapshot = (wmem_block_fast_snapshot_t *)wmem_block_fast_alloc(private_data,
+            sizeof(wmem_block_fast_snapshot_t));
+
+    snapshot->block       = allocator->block_list;
+    snapshot->pos         = allocator->block_list->pos;
+    snapshot->jumbo_count = allocator->jumbo_count;
+
+    return snapshot;
+}
+
+static void
+wmem_block_fast_rollback(void *private_data, void *data)
+{
+    wmem_block_fast_allocator_t *allocator = (wmem_block_fast_allocator_t*) private_data;
+    wmem_block_fast_snapshot_t  *snapshot  = (wmem_block_fast_snapshot_t*) data;
+    wmem_block_fast_hdr_t       *cur;
+    wmem_block_fast_jumbo_t     *cur_jum;
+
+    /* New blocks are pushed onto the front of the block list, so pop
+     * blocks until the snapshot's block is current again, then rewind
+     * its fill position. */
+    while (allocator->block_list != snapshot->block) {
+        cur = allocator->block_list;
+        allocator->block_list = cur->next;
+        wmem_free(NULL, cur);
+    }
+    allocator->block_list->pos = snapshot->pos;
+
+    /* Likewise for any jumbo blocks allocated since the snapshot. */
+    while (allocator->jumbo_count > snapshot->jumbo_count) {
+        cur_jum = allocator->jumbo_list;
+        allocator->jumbo_list = cur_jum->next;
+        wmem_free(NULL, cur_jum);
+        allocator->jumbo_count--;
+    }
+    if (allocator->jumbo_list) {
+        allocator->jumbo_list->prev = NULL;
+    }
 }
 
 static void
@@ -241,10 +304,14 @@ wmem_block_fast_allocator_init(wmem_allocator_t *allocator)
     allocator->gc       = &wmem_block_fast_gc;
     allocator->cleanup  = &wmem_block_fast_allocator_cleanup;
 
+    allocator->snapshot = &wmem_block_fast_snapshot;
+    allocator->rollback = &wmem_block_fast_rollback;
+
     allocator->private_data = (void*) block_allocator;
 
     block_allocator->block_list = NULL;
     block_allocator->jumbo_list = NULL;
+    block_allocator->jumbo_count = 0;
 }
 
 /*
@@ -0,0 +1,281 @@
+/* wmem_allocator_profile.c
+ * Wireshark Memory Manager Profiling Allocator
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "config.h"
+#define WS_LOG_DOMAIN LOG_DOMAIN_WSUTIL
+
+#include <string.h>
+
+#include <glib.h>
+
+#include "wmem_core.h"
+#include "wmem_allocator.h"
+#include "wmem_allocator_profile.h"
+
+#include <wsutil/ws_assert.h>
+#include <wsutil/wslog.h>
+
+/* In this allocator, we do everything the simple allocator does - pass
+ * allocations through to g_malloc and track them so free_all works - but
+ * additionally prefix each allocation with its requested size and keep
+ * running statistics, so that when a capture eats far more memory than
+ * expected we can see which pool is responsible and what its allocation
+ * pattern looks like. Select it at runtime by setting the environment
+ * variable WIRESHARK_DEBUG_WMEM_OVERRIDE=profile; each pool then logs a
+ * summary when it is destroyed, and wmem_profile_get_stats() can be
+ * called at any point for a programmatic snapshot.
+ */
+
+#define DEFAULT_ALLOCS 8192
+
+/* Prefixed to every allocation so free and realloc can account for the
+ * bytes they give back. Padded to the usual strictest alignment. */
+typedef union _wmem_profile_hdr_t {
+    size_t size;
+    double align;
+} wmem_profile_hdr_t;
+
+#define WMEM_HDR_TO_DATA(hdr) ((void *)((wmem_profile_hdr_t *)(hdr) + 1))
+#define WMEM_DATA_TO_HDR(ptr) (((wmem_profile_hdr_t *)(ptr)) - 1)
+
+typedef struct _wmem_profile_allocator_t {
+    int size;
+    int count;
+    wmem_profile_hdr_t **ptrs;
+
+    wmem_profile_stats_t stats;
+} wmem_profile_allocator_t;
+
+static void
+wmem_profile_account_alloc(wmem_profile_allocator_t *allocator,
+        const size_t size)
+{
+    wmem_profile_stats_t *stats = &allocator->stats;
+    unsigned bucket = 0;
+
+    stats->alloc_count++;
+    stats->bytes_allocated += size;
+    stats->current_bytes += size;
+    if (stats->current_bytes > stats->peak_bytes) {
+        stats->peak_bytes = stats->current_bytes;
+    }
+
+    while (bucket < G_N_ELEMENTS(stats->size_hist) - 1 &&
+            ((size_t)1 << bucket) < size) {
+        bucket++;
+    }
+    stats->size_hist[bucket]++;
+}
+
+static void *
+wmem_profile_alloc(void *private_data, const size_t size)
+{
+    wmem_profile_allocator_t *allocator;
+    wmem_profile_hdr_t       *hdr;
+
+    allocator = (wmem_profile_allocator_t*) private_data;
+
+    if (G_UNLIKELY(allocator->count == allocator->size)) {
+        allocator->size *= 2;
+        allocator->ptrs = (wmem_profile_hdr_t**)wmem_realloc(NULL,
+                allocator->ptrs,
+                sizeof(wmem_profile_hdr_t*) * allocator->size);
+    }
+
+    hdr = (wmem_profile_hdr_t *)wmem_alloc(NULL,
+            sizeof(wmem_profile_hdr_t) + size);
+    hdr->size = size;
+    allocator->ptrs[allocator->count++] = hdr;
+
+    wmem_profile_account_alloc(allocator, size);
+
+    return WMEM_HDR_TO_DATA(hdr);
+}
+
+static void
+wmem_profile_free(void *private_data, void *ptr)
+{
+    int                       i;
+    wmem_profile_allocator_t *allocator;
+    wmem_profile_hdr_t       *hdr;
+
+    allocator = (wmem_profile_allocator_t*) private_data;
+    hdr       = WMEM_DATA_TO_HDR(ptr);
+
+    allocator->stats.free_count++;
+    allocator->stats.current_bytes -= hdr->size;
+
+    wmem_free(NULL, hdr);
+    allocator->count--;
+
+    for (i=allocator->count; i>=0; i--) {
+        if (hdr == allocator->ptrs[i]) {
+            if (i < allocator->count) {
+                allocator->ptrs[i] = allocator->ptrs[allocator->count];
+            }
+            return;
+        }
+    }
+
+    g_assert_not_reached();
+}
+
+static void *
+wmem_profile_realloc(void *private_data, void *ptr, const size_t size)
+{
+    int                       i;
+    wmem_profile_allocator_t *allocator;
+    wmem_profile_hdr_t       *hdr;
+
+    allocator = (wmem_profile_allocator_t*) private_data;
+    hdr       = WMEM_DATA_TO_HDR(ptr);
+
+    allocator->stats.realloc_count++;
+    allocator->stats.current_bytes -= hdr->size;
+    wmem_profile_account_alloc(allocator, size);
+    /* account_alloc counted this as a fresh allocation; it isn't one */
+    allocator->stats.alloc_count--;
+
+    for (i=allocator->count-1; i>=0; i--) {
+        if (hdr == allocator->ptrs[i]) {
+            hdr = (wmem_profile_hdr_t *)wmem_realloc(NULL, hdr,
+                    sizeof(wmem_profile_hdr_t) + size);
+            hdr->size = size;
+            allocator->ptrs[i] = hdr;
+            return WMEM_HDR_TO_DATA(hdr);
+        }
+    }
+
+    g_assert_not_reached();
+    /* not reached */
+    return NULL;
+}
+
+static void
+wmem_profile_free_all(void *private_data)
+{
+    wmem_profile_allocator_t *allocator;
+    int i;
+
+    allocator = (wmem_profile_allocator_t*) private_data;
+
+    allocator->stats.free_all_count++;
+    allocator->stats.current_bytes = 0;
+
+    for (i = 0; i<allocator->count; i++) {
+        wmem_free(NULL, allocator->ptrs[i]);
+    }
+    allocator->count = 0;
+}
+
+static void
+wmem_profile_gc(void *private_data _U_)
+{
+    /* Nothing to garbage-collect */
+}
+
+static void
+wmem_profile_log_stats_real(wmem_profile_allocator_t *allocator)
+{
+    wmem_profile_stats_t *stats = &allocator->stats;
+    unsigned i;
+
+    ws_message("wmem profile %p: %" PRIu64 " allocs, %" PRIu64 " reallocs, "
+            "%" PRIu64 " frees, %" PRIu64 " free_alls",
+            (void *)allocator, stats->alloc_count, stats->realloc_count,
+            stats->free_count, stats->free_all_count);
+    ws_message("wmem profile %p: %" PRIu64 " bytes allocated in total, "
+            "%" PRIu64 " live, %" PRIu64 " peak",
+            (void *)allocator, stats->bytes_allocated, stats->current_bytes,
+            stats->peak_bytes);
+    for (i = 0; i < G_N_ELEMENTS(stats->size_hist); i++) {
+        if (stats->size_hist[i] == 0) {
+            continue;
+        }
+        if (i == G_N_ELEMENTS(stats->size_hist) - 1) {
+            ws_message("wmem profile %p:   > %u bytes: %" PRIu64,
+                    (void *)allocator, 1U << (i - 1), stats->size_hist[i]);
+        }
+        else {
+            ws_message("wmem profile %p:   <= %u bytes: %" PRIu64,
+                    (void *)allocator, 1U << i, stats->size_hist[i]);
+        }
+    }
+}
+
+static void
+wmem_profile_allocator_cleanup(void *private_data)
+{
+    wmem_profile_allocator_t *allocator;
+
+    allocator = (wmem_profile_allocator_t*) private_data;
+
+    wmem_profile_log_stats_real(allocator);
+
+    wmem_free(NULL, allocator->ptrs);
+    wmem_free(NULL, allocator);
+}
+
+void
+wmem_profile_get_stats(wmem_allocator_t *allocator,
+        wmem_profile_stats_t *stats)
+{
+    wmem_profile_allocator_t *profile_allocator;
+
+    ws_assert(allocator->type == WMEM_ALLOCATOR_PROFILE);
+
+    profile_allocator = (wmem_profile_allocator_t*) allocator->private_data;
+    *stats = profile_allocator->stats;
+}
+
+void
+wmem_profile_log_stats(wmem_allocator_t *allocator)
+{
+    ws_assert(allocator->type == WMEM_ALLOCATOR_PROFILE);
+
+    wmem_profile_log_stats_real(
+            (wmem_profile_allocator_t*) allocator->private_data);
+}
+
+void
+wmem_profile_allocator_init(wmem_allocator_t *allocator)
+{
+    wmem_profile_allocator_t *profile_allocator;
+
+    profile_allocator = wmem_new0(NULL, wmem_profile_allocator_t);
+
+    allocator->walloc   = &wmem_profile_alloc;
+    allocator->wrealloc = &wmem_profile_realloc;
+    allocator->wfree    = &wmem_profile_free;
+
+    allocator->free_all = &wmem_profile_free_all;
+    allocator->gc       = &wmem_profile_gc;
+    allocator->cleanup  = &wmem_profile_allocator_cleanup;
+
+    allocator->private_data = (void*) profile_allocator;
+
+    profile_allocator->count = 0;
+    profile_allocator->size  = DEFAULT_ALLOCS;
+    profile_allocator->ptrs  = (wmem_profile_hdr_t**)wmem_alloc(NULL,
+            sizeof(wmem_profile_hdr_t*) * DEFAULT_ALLOCS);
+}
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 4
+ * tab-width: 8
+ * indent-tabs-mode: nil
+ * End:
+ *
+ * vi: set shiftwidth=4 tabstop=8 expandtab:
+ * :indentSize=4:tabSize=8:noTabs=true:
+ */
@@ -0,0 +1,69 @@
+/** @file
+ *
+ * Definitions for the Wireshark Memory Manager Profiling Allocator
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __WMEM_ALLOCATOR_PROFILE_H__
+#define __WMEM_ALLOCATOR_PROFILE_H__
+
+#include "wmem_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** Statistics gathered by the profiling allocator for one pool. */
+typedef struct _wmem_profile_stats_t {
+    uint64_t alloc_count;     /**< number of allocations ever made */
+    uint64_t realloc_count;   /**< number of reallocations ever made */
+    uint64_t free_count;      /**< number of individual frees */
+    uint64_t free_all_count;  /**< number of free_all operations */
+    uint64_t bytes_allocated; /**< bytes ever requested, cumulative */
+    uint64_t current_bytes;   /**< bytes currently live */
+    uint64_t peak_bytes;      /**< maximum of current_bytes over time */
+    /** Allocation counts by power-of-two size class; index i counts
+     * requests of at most 2^i bytes, with the last bucket catching
+     * everything larger. */
+    uint64_t size_hist[24];
+} wmem_profile_stats_t;
+
+void
+wmem_profile_allocator_init(wmem_allocator_t *allocator);
+
+/** Copy out the statistics gathered so far for a pool created with the
+ * profiling allocator. Asserts if the pool uses any other allocator. */
+WS_DLL_PUBLIC
+void
+wmem_profile_get_stats(wmem_allocator_t *allocator,
+        wmem_profile_stats_t *stats);
+
+/** Log a human-readable summary of a profiled pool's statistics. Called
+ * automatically when the pool is destroyed. */
+WS_DLL_PUBLIC
+void
+wmem_profile_log_stats(wmem_allocator_t *allocator);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __WMEM_ALLOCATOR_PROFILE_H__ */
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 4
+ * tab-width: 8
+ * indent-tabs-mode: nil
+ * End:
+ *
+ * vi: set shiftwidth=4 tabstop=8 expandtab:
+ * :indentSize=4:tabSize=8:noTabs=true:
+ */
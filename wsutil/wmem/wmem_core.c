@@ -22,6 +22,7 @@
 #include "wmem_allocator_block.h"
 #include "wmem_allocator_block_fast.h"
 #include "wmem_allocator_strict.h"
+#include "wmem_allocator_profile.h"
 
 /* Set according to the WIRESHARK_DEBUG_WMEM_OVERRIDE environment variable in
  * wmem_init. Should not be set again. */
@@ -116,6 +117,32 @@ wmem_gc(wmem_allocator_t *allocator)
     allocator->gc(allocator->private_data);
 }
 
+void *
+wmem_snapshot(wmem_allocator_t *allocator)
+{
+    ws_assert(allocator->in_scope);
+
+    if (allocator->snapshot == NULL) {
+        /* Rollback is only an optimization; allocators without support
+         * simply keep the memory until the next free_all. */
+        return NULL;
+    }
+
+    return allocator->snapshot(allocator->private_data);
+}
+
+void
+wmem_rollback(wmem_allocator_t *allocator, void *snapshot)
+{
+    ws_assert(allocator->in_scope);
+
+    if (snapshot == NULL) {
+        return;
+    }
+
+    allocator->rollback(allocator->private_data, snapshot);
+}
+
 void
 wmem_destroy_allocator(wmem_allocator_t *allocator)
 {
@@ -142,6 +169,10 @@ wmem_allocator_new(const wmem_allocator_type_t type)
     allocator->type      = real_type;
     allocator->callbacks = NULL;
     allocator->in_scope  = true;
+    /* Watermark support is optional; allocators that provide it override
+     * these in their init function. */
+    allocator->snapshot  = NULL;
+    allocator->rollback  = NULL;
 
     switch (real_type) {
         case WMEM_ALLOCATOR_SIMPLE:
@@ -156,6 +187,9 @@ wmem_allocator_new(const wmem_allocator_type_t type)
         case WMEM_ALLOCATOR_STRICT:
             wmem_strict_allocator_init(allocator);
             break;
+        case WMEM_ALLOCATOR_PROFILE:
+            wmem_profile_allocator_init(allocator);
+            break;
         default:
             g_assert_not_reached();
             break;
@@ -192,6 +226,9 @@ wmem_init(void)
         else if (strncmp(override_env, "block_fast", strlen("block_fast")) == 0) {
             override_type = WMEM_ALLOCATOR_BLOCK_FAST;
         }
+        else if (strncmp(override_env, "profile", strlen("profile")) == 0) {
+            override_type = WMEM_ALLOCATOR_PROFILE;
+        }
         else {
             g_warning("Unrecognized wmem override");
             do_override = false;
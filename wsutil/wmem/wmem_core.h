@@ -36,6 +36,18 @@ extern "C" {
  * abort the program. However, they *can* still legally return NULL when the
  * amount of requested memory is zero.
  *
+ * Wmem is not thread safe: allocators keep unsynchronized free lists and
+ * block caches, and a pool must only ever be touched from one thread at a
+ * time. Making the allocators thread local would not be enough to allow
+ * concurrent dissection, because the interesting pools (the epan and file
+ * scopes) hold state that dissectors share across packets - conversation
+ * tables, reassembly fragments, address tables - so the synchronization
+ * problem lives above the allocator, not inside it. Code that wants
+ * per-thread scratch memory can already create a private pool per thread
+ * with wmem_allocator_new() and destroy it with wmem_destroy_allocator();
+ * what it must not do is pass pools, or anything allocated in them,
+ * between threads.
+ *
  * @{
  */
 
@@ -57,11 +69,16 @@ typedef enum _wmem_allocator_type_t {
                 memory usage via things like canaries and scrubbing freed
                 memory. Valgrind is the better choice on platforms that support
                 it. */
-    WMEM_ALLOCATOR_BLOCK_FAST /**< A block allocator like WMEM_ALLOCATOR_BLOCK
+    WMEM_ALLOCATOR_BLOCK_FAST, /**< A block allocator like WMEM_ALLOCATOR_BLOCK
                 but even faster by tracking absolutely minimal metadata and
                 making 'free' a no-op. Useful only for very short-lived scopes
                 where there's no reason to free individual allocations because
                 the next free_all is always just around the corner. */
+    WMEM_ALLOCATOR_PROFILE /**< An allocator that keeps per-pool statistics
+                (counts, live and peak bytes, a size histogram) and logs them
+                when the pool is destroyed. Slow; intended for tracking down
+                runaway memory usage via the WIRESHARK_DEBUG_WMEM_OVERRIDE
+                environment variable, not for production use. */
 } wmem_allocator_type_t;
 
 /** Allocate the requested amount of memory in the given pool.
@@ -186,6 +203,46 @@ WS_DLL_PUBLIC
 void
 wmem_gc(wmem_allocator_t *allocator);
 
+/** Record the current allocation watermark of a pool, so that allocations
+ * made after this call can be released early with wmem_rollback() instead
+ * of lingering until the next wmem_free_all(). Intended for speculative
+ * work - attempt something, and if it is abandoned, give the memory back
+ * immediately.
+ *
+ * Not every allocator supports this; for those that don't (and under the
+ * WIRESHARK_DEBUG_WMEM_OVERRIDE environment variable) this returns NULL,
+ * which wmem_rollback() accepts and ignores - the memory then simply
+ * stays around until the next wmem_free_all(), as it does today. Callers
+ * must therefore treat rollback as an optimization only, never as a
+ * semantic guarantee.
+ *
+ * @param allocator The allocator to record the watermark of.
+ * @return An opaque snapshot to pass to wmem_rollback(), or NULL. The
+ * snapshot is allocated in the pool itself and is invalidated by the next
+ * wmem_free_all(); it must not be freed by the caller.
+ */
+WS_DLL_PUBLIC
+void *
+wmem_snapshot(wmem_allocator_t *allocator);
+
+/** Release every allocation made in the pool since the given snapshot was
+ * taken. The snapshot remains valid, so a single snapshot can bracket
+ * several successive attempts.
+ *
+ * This does NOT run destructors or user callbacks: nothing may still
+ * reference memory allocated after the snapshot - including the results
+ * of wmem_realloc() on older allocations, and anything registered with
+ * wmem_register_callback() - or that reference becomes dangling. The
+ * caller is responsible for ensuring no such references escaped.
+ *
+ * @param allocator The allocator to roll back.
+ * @param snapshot A snapshot from wmem_snapshot() on the same allocator,
+ * or NULL, in which case this does nothing.
+ */
+WS_DLL_PUBLIC
+void
+wmem_rollback(wmem_allocator_t *allocator, void *snapshot);
+
 /** Destroy the given allocator, freeing all memory allocated in it. Once this
  * function has been called, no memory allocated with the allocator is valid.
  *
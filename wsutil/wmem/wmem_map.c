@@ -38,6 +38,8 @@ wmem_init_hashing(void)
 typedef struct _wmem_map_item_t {
     const void *key;
     void *value;
+    uint32_t hash; /* raw hash_func value, cached so growing the table
+                    * and walking collision chains don't recompute it */
     struct _wmem_map_item_t *next;
 } wmem_map_item_t;
 
@@ -52,6 +54,11 @@ struct _wmem_map_t {
 
     wmem_map_item_t **table;
 
+    /* Items reclaimed by remove operations, reused by inserts. New items
+     * are carved from slabs to avoid a trip through the allocator per
+     * insertion (and to keep neighbouring items close in memory). */
+    wmem_map_item_t *item_free_list;
+
     GHashFunc  hash_func;
     GEqualFunc eql_func;
 
@@ -66,15 +73,52 @@ struct _wmem_map_t {
  * the base-2 logarithm, meaning the actual default capacity is 2^5 = 32 */
 #define WMEM_MAP_DEFAULT_CAPACITY 5
 
+/* How many items to carve from one slab allocation. */
+#define WMEM_MAP_ITEM_SLAB 32
+
 /* Macro for calculating the real capacity of the map by using a left-shift to
  * do the 2^x operation. */
 #define CAPACITY(MAP) (((size_t)1) << (MAP)->capacity)
 
 /* Efficient universal integer hashing:
  * https://en.wikipedia.org/wiki/Universal_hashing#Avoiding_modular_arithmetic
+ *
+ * SLOT maps an already-computed raw hash to a table slot; HASH goes all
+ * the way from a key.
  */
+#define SLOT(MAP, HASHVAL) \
+    ((uint32_t)(((HASHVAL) * x) >> (32 - (MAP)->capacity)))
 #define HASH(MAP, KEY) \
-    ((uint32_t)(((MAP)->hash_func(KEY) * x) >> (32 - (MAP)->capacity)))
+    SLOT(MAP, (MAP)->hash_func(KEY))
+
+static wmem_map_item_t *
+wmem_map_item_new(wmem_map_t *map)
+{
+    wmem_map_item_t *item;
+
+    if (map->item_free_list == NULL) {
+        wmem_map_item_t *slab;
+        size_t i;
+
+        slab = wmem_alloc_array(map->data_allocator, wmem_map_item_t,
+                WMEM_MAP_ITEM_SLAB);
+        for (i=0; i<WMEM_MAP_ITEM_SLAB; i++) {
+            slab[i].next = map->item_free_list;
+            map->item_free_list = &slab[i];
+        }
+    }
+
+    item = map->item_free_list;
+    map->item_free_list = item->next;
+    return item;
+}
+
+static void
+wmem_map_item_recycle(wmem_map_t *map, wmem_map_item_t *item)
+{
+    item->next = map->item_free_list;
+    map->item_free_list = item;
+}
 
 static void
 wmem_map_init_table(wmem_map_t *map)
@@ -98,6 +142,7 @@ wmem_map_new(wmem_allocator_t *allocator,
     map->data_allocator = allocator;
     map->count = 0;
     map->table = NULL;
+    map->item_free_list = NULL;
 
     return map;
 }
@@ -110,6 +155,7 @@ wmem_map_reset_cb(wmem_allocator_t *allocator _U_, wmem_cb_event_t event,
 
     map->count = 0;
     map->table = NULL;
+    map->item_free_list = NULL;
 
     if (event == WMEM_CB_DESTROY_EVENT) {
         wmem_unregister_callback(map->metadata_allocator, map->metadata_scope_cb_id);
@@ -144,6 +190,7 @@ wmem_map_new_autoreset(wmem_allocator_t *metadata_scope, wmem_allocator_t *data_
     map->data_allocator = data_scope;
     map->count = 0;
     map->table = NULL;
+    map->item_free_list = NULL;
 
     map->metadata_scope_cb_id = wmem_register_callback(metadata_scope, wmem_map_destroy_cb, map);
     map->data_scope_cb_id  = wmem_register_callback(data_scope, wmem_map_reset_cb, map);
@@ -172,7 +219,7 @@ wmem_map_grow(wmem_map_t *map)
         cur = old_table[i];
         while (cur) {
             nxt              = cur->next;
-            slot             = HASH(map, cur->key);
+            slot             = SLOT(map, cur->hash);
             cur->next        = map->table[slot];
             map->table[slot] = cur;
             cur              = nxt;
@@ -188,6 +235,7 @@ wmem_map_insert(wmem_map_t *map, const void *key, void *value)
 {
     wmem_map_item_t **item;
     void *old_val;
+    uint32_t hash;
 
     /* Make sure we have a table */
     if (map->table == NULL) {
@@ -195,11 +243,12 @@ wmem_map_insert(wmem_map_t *map, const void *key, void *value)
     }
 
     /* get a pointer to the slot */
-    item = &(map->table[HASH(map, key)]);
+    hash = map->hash_func(key);
+    item = &(map->table[SLOT(map, hash)]);
 
     /* check existing items in that slot */
     while (*item) {
-        if (map->eql_func(key, (*item)->key)) {
+        if ((*item)->hash == hash && map->eql_func(key, (*item)->key)) {
             /* replace and return old value for this key */
             old_val = (*item)->value;
             (*item)->value = value;
@@ -209,10 +258,11 @@ wmem_map_insert(wmem_map_t *map, const void *key, void *value)
     }
 
     /* insert new item */
-    (*item) = wmem_new(map->data_allocator, wmem_map_item_t);
+    (*item) = wmem_map_item_new(map);
 
     (*item)->key   = key;
     (*item)->value = value;
+    (*item)->hash  = hash;
     (*item)->next  = NULL;
 
     map->count++;
@@ -230,6 +280,7 @@ bool
 wmem_map_contains(wmem_map_t *map, const void *key)
 {
     wmem_map_item_t *item;
+    uint32_t hash;
 
     /* Make sure we have map and a table */
     if (map == NULL || map->table == NULL) {
@@ -237,11 +288,12 @@ wmem_map_contains(wmem_map_t *map, const void *key)
     }
 
     /* find correct slot */
-    item = map->table[HASH(map, key)];
+    hash = map->hash_func(key);
+    item = map->table[SLOT(map, hash)];
 
     /* scan list of items in this slot for the correct value */
     while (item) {
-        if (map->eql_func(key, item->key)) {
+        if (item->hash == hash && map->eql_func(key, item->key)) {
             return true;
         }
         item = item->next;
@@ -254,6 +306,7 @@ void *
 wmem_map_lookup(wmem_map_t *map, const void *key)
 {
     wmem_map_item_t *item;
+    uint32_t hash;
 
     /* Make sure we have map and a table */
     if (map == NULL || map->table == NULL) {
@@ -261,11 +314,12 @@ wmem_map_lookup(wmem_map_t *map, const void *key)
     }
 
     /* find correct slot */
-    item = map->table[HASH(map, key)];
+    hash = map->hash_func(key);
+    item = map->table[SLOT(map, hash)];
 
     /* scan list of items in this slot for the correct value */
     while (item) {
-        if (map->eql_func(key, item->key)) {
+        if (item->hash == hash && map->eql_func(key, item->key)) {
             return item->value;
         }
         item = item->next;
@@ -278,6 +332,7 @@ bool
 wmem_map_lookup_extended(wmem_map_t *map, const void *key, const void **orig_key, void **value)
 {
     wmem_map_item_t *item;
+    uint32_t hash;
 
     /* Make sure we have map and a table */
     if (map == NULL || map->table == NULL) {
@@ -285,11 +340,12 @@ wmem_map_lookup_extended(wmem_map_t *map, const void *key, const void **orig_key
     }
 
     /* find correct slot */
-    item = map->table[HASH(map, key)];
+    hash = map->hash_func(key);
+    item = map->table[SLOT(map, hash)];
 
     /* scan list of items in this slot for the correct value */
     while (item) {
-        if (map->eql_func(key, item->key)) {
+        if (item->hash == hash && map->eql_func(key, item->key)) {
             if (orig_key) {
                 *orig_key = item->key;
             }
@@ -309,6 +365,7 @@ wmem_map_remove(wmem_map_t *map, const void *key)
 {
     wmem_map_item_t **item, *tmp;
     void *value;
+    uint32_t hash;
 
     /* Make sure we have map and a table */
     if (map == NULL || map->table == NULL) {
@@ -316,16 +373,17 @@ wmem_map_remove(wmem_map_t *map, const void *key)
     }
 
     /* get a pointer to the slot */
-    item = &(map->table[HASH(map, key)]);
+    hash = map->hash_func(key);
+    item = &(map->table[SLOT(map, hash)]);
 
     /* check the items in that slot */
     while (*item) {
-        if (map->eql_func(key, (*item)->key)) {
+        if ((*item)->hash == hash && map->eql_func(key, (*item)->key)) {
             /* found it */
             tmp     = (*item);
             value   = tmp->value;
             (*item) = tmp->next;
-            wmem_free(map->data_allocator, tmp);
+            wmem_map_item_recycle(map, tmp);
             map->count--;
             return value;
         }
@@ -340,6 +398,7 @@ bool
 wmem_map_steal(wmem_map_t *map, const void *key)
 {
     wmem_map_item_t **item, *tmp;
+    uint32_t hash;
 
     /* Make sure we have map and a table */
     if (map == NULL || map->table == NULL) {
@@ -347,14 +406,16 @@ wmem_map_steal(wmem_map_t *map, const void *key)
     }
 
     /* get a pointer to the slot */
-    item = &(map->table[HASH(map, key)]);
+    hash = map->hash_func(key);
+    item = &(map->table[SLOT(map, hash)]);
 
     /* check the items in that slot */
     while (*item) {
-        if (map->eql_func(key, (*item)->key)) {
+        if ((*item)->hash == hash && map->eql_func(key, (*item)->key)) {
             /* found it */
             tmp     = (*item);
             (*item) = tmp->next;
+            wmem_map_item_recycle(map, tmp);
             map->count--;
             return true;
         }
@@ -425,7 +486,7 @@ wmem_map_foreach_remove(wmem_map_t *map, GHRFunc foreach_func, void * user_data)
             if (foreach_func((void *)(*item)->key, (void *)(*item)->value, user_data)) {
                 tmp   = *item;
                 *item = tmp->next;
-                wmem_free(map->data_allocator, tmp);
+                wmem_map_item_recycle(map, tmp);
                 map->count--;
                 deleted++;
             } else {
@@ -22,24 +22,48 @@
 
 #define DEFAULT_MINIMUM_SIZE 16
 
+/* Character buffers up to this size are carved out of the same allocation
+ * as the header, saving an allocation (and, with the NULL allocator, a
+ * free). Short strings dominate - field values, method names, flags - so
+ * most strbufs never need a second allocation at all. */
+#define WMEM_STRBUF_INLINE_SIZE 64
+
 /* _ROOM accounts for the null-terminator, _RAW_ROOM does not.
  * Some functions need one, some functions need the other. */
 #define WMEM_STRBUF_ROOM(S) ((S)->alloc_size - (S)->len - 1)
 #define WMEM_STRBUF_RAW_ROOM(S) ((S)->alloc_size - (S)->len)
 
+/* Whether the character buffer lives inside the header allocation; such
+ * a buffer cannot be realloc'd or freed on its own. */
+static inline bool
+strbuf_is_inline(const wmem_strbuf_t *strbuf)
+{
+    return strbuf->str == (const char *)strbuf + sizeof(wmem_strbuf_t);
+}
+
 wmem_strbuf_t *
 wmem_strbuf_new_sized(wmem_allocator_t *allocator,
                       size_t alloc_size)
 {
     wmem_strbuf_t *strbuf;
 
-    strbuf = wmem_new(allocator, wmem_strbuf_t);
+    if (alloc_size == 0) {
+        alloc_size = DEFAULT_MINIMUM_SIZE;
+    }
+
+    if (alloc_size <= WMEM_STRBUF_INLINE_SIZE) {
+        strbuf = (wmem_strbuf_t *)wmem_alloc(allocator,
+                sizeof(wmem_strbuf_t) + alloc_size);
+        strbuf->str = (char *)strbuf + sizeof(wmem_strbuf_t);
+    }
+    else {
+        strbuf = wmem_new(allocator, wmem_strbuf_t);
+        strbuf->str = (char *)wmem_alloc(allocator, alloc_size);
+    }
 
     strbuf->allocator = allocator;
     strbuf->len       = 0;
-    strbuf->alloc_size = alloc_size ? alloc_size : DEFAULT_MINIMUM_SIZE;
-
-    strbuf->str    = (char *)wmem_alloc(strbuf->allocator, strbuf->alloc_size);
+    strbuf->alloc_size = alloc_size;
     strbuf->str[0] = '\0';
 
     return strbuf;
@@ -115,7 +139,16 @@ wmem_strbuf_grow(wmem_strbuf_t *strbuf, const size_t to_add)
         return;
     }
 
-    strbuf->str = (char *)wmem_realloc(strbuf->allocator, strbuf->str, new_alloc_len);
+    if (strbuf_is_inline(strbuf)) {
+        /* The string is moving out of the header allocation; copy it
+         * rather than realloc'ing a pointer into the middle of it. */
+        char *new_str = (char *)wmem_alloc(strbuf->allocator, new_alloc_len);
+        memcpy(new_str, strbuf->str, strbuf->len + 1);
+        strbuf->str = new_str;
+    }
+    else {
+        strbuf->str = (char *)wmem_realloc(strbuf->allocator, strbuf->str, new_alloc_len);
+    }
 
     strbuf->alloc_size = new_alloc_len;
 }
@@ -385,7 +418,17 @@ wmem_strbuf_finalize(wmem_strbuf_t *strbuf)
     if (strbuf == NULL)
         return NULL;
 
-    char *ret = (char *)wmem_realloc(strbuf->allocator, strbuf->str, strbuf->len+1);
+    char *ret;
+
+    if (strbuf_is_inline(strbuf)) {
+        /* The string lives inside the header allocation; copy it out so
+         * the combined allocation can be released as one. */
+        ret = (char *)wmem_alloc(strbuf->allocator, strbuf->len+1);
+        memcpy(ret, strbuf->str, strbuf->len+1);
+    }
+    else {
+        ret = (char *)wmem_realloc(strbuf->allocator, strbuf->str, strbuf->len+1);
+    }
 
     wmem_free(strbuf->allocator, strbuf);
 
@@ -398,7 +441,9 @@ wmem_strbuf_destroy(wmem_strbuf_t *strbuf)
     if (strbuf == NULL)
         return;
 
-    wmem_free(strbuf->allocator, strbuf->str);
+    if (!strbuf_is_inline(strbuf)) {
+        wmem_free(strbuf->allocator, strbuf->str);
+    }
     wmem_free(strbuf->allocator, strbuf);
 }
 
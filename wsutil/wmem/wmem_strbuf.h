@@ -42,6 +42,8 @@ extern "C" {
 struct _wmem_strbuf_t {
     /* read-only fields */
     wmem_allocator_t *allocator;
+    /* May point into the same allocation as this header for short
+     * strings; never realloc or free it directly. */
     char *str;
     size_t len;
 
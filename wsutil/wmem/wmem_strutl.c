@@ -16,6 +16,8 @@
 #include <stdio.h>
 #include <errno.h>
 
+#include "wmem_user_cb.h"
+
 char *
 wmem_strdup(wmem_allocator_t *allocator, const char *src)
 {
@@ -49,6 +51,83 @@ wmem_strndup(wmem_allocator_t *allocator, const char *src, const size_t len)
     return dst;
 }
 
+/* Maps each pool with interned strings to a GHashTable used as a set of
+ * the strings interned so far. The strings themselves live in the pool;
+ * the tables are destroyed (and the registry entries dropped) from a
+ * wmem user callback when the pool is freed or destroyed. */
+static GHashTable *intern_registry;
+
+static bool
+wmem_strutl_intern_cb(wmem_allocator_t *allocator, wmem_cb_event_t event _U_,
+        void *user_data)
+{
+    g_hash_table_destroy((GHashTable *)user_data);
+    g_hash_table_remove(intern_registry, allocator);
+
+    /* The interned strings went away with the pool's contents, so a
+     * fresh table (and callback) is needed either way. */
+    return false;
+}
+
+const char *
+wmem_strdup_intern(wmem_allocator_t *allocator, const char *src)
+{
+    GHashTable *table;
+    char       *stored;
+
+    /* As in wmem_strdup(), save the callers a null check. */
+    if (!src) {
+        src = "<NULL>";
+    }
+
+    if (intern_registry == NULL) {
+        intern_registry = g_hash_table_new(g_direct_hash, g_direct_equal);
+    }
+
+    table = (GHashTable *)g_hash_table_lookup(intern_registry, allocator);
+    if (table == NULL) {
+        table = g_hash_table_new(g_str_hash, g_str_equal);
+        g_hash_table_insert(intern_registry, allocator, table);
+        wmem_register_callback(allocator, wmem_strutl_intern_cb, table);
+    }
+
+    stored = (char *)g_hash_table_lookup(table, src);
+    if (stored == NULL) {
+        stored = wmem_strdup(allocator, src);
+        g_hash_table_add(table, stored);
+    }
+
+    return stored;
+}
+
+#define INTERN_STACK_BUFFER 512
+
+const char *
+wmem_strndup_intern(wmem_allocator_t *allocator, const char *src,
+        const size_t len)
+{
+    char        buf[INTERN_STACK_BUFFER];
+    char       *tmp;
+    const char *ret;
+    size_t      n;
+
+    /* Match wmem_strndup(): copy at most len bytes, stopping early at a
+     * null terminator. */
+    for (n = 0; n < len && src[n]; n++)
+        ;
+
+    if (n < sizeof(buf)) {
+        memcpy(buf, src, n);
+        buf[n] = '\0';
+        return wmem_strdup_intern(allocator, buf);
+    }
+
+    tmp = g_strndup(src, n);
+    ret = wmem_strdup_intern(allocator, tmp);
+    g_free(tmp);
+    return ret;
+}
+
 char *
 wmem_strdup_printf(wmem_allocator_t *allocator, const char *fmt, ...)
 {
@@ -88,6 +167,25 @@ wmem_strdup_vprintf(wmem_allocator_t *allocator, const char *fmt, va_list ap)
     char *new_buf;
     size_t new_buf_size;
 
+    /* Fast paths for trivial formats, which are common in label and
+     * column formatting: no conversions at all, or exactly "%s" with a
+     * non-null argument. Both skip the printf machinery entirely and
+     * produce byte-identical results. */
+    if (strchr(fmt, '%') == NULL) {
+        return wmem_strdup(allocator, fmt);
+    }
+    if (fmt[0] == '%' && fmt[1] == 's' && fmt[2] == '\0') {
+        const char *src;
+
+        va_copy(ap2, ap);
+        src = va_arg(ap2, const char *);
+        va_end(ap2);
+        if (src != NULL) {
+            return wmem_strdup(allocator, src);
+        }
+        /* Let vsnprintf handle a null argument however it usually does. */
+    }
+
 #ifdef HAVE_VASPRINTF
     if (allocator == NULL) {
         return _strdup_vasprintf(fmt, ap);
@@ -57,6 +57,30 @@ G_GNUC_MALLOC;
 
 #define ws_strdup_vprintf(fmt, ap) wmem_strdup_vprintf(NULL, fmt, ap)
 
+/**
+ * Return an interned copy of a string, allocated in the given pool.
+ *
+ * Repeated calls with equal strings return the same pointer, so values
+ * that recur many times over the lifetime of a pool (hostnames, URIs,
+ * protocol identifiers, ...) are stored only once instead of once per
+ * occurrence. The returned string is shared and must not be modified.
+ *
+ * The allocator must be a real pool, not NULL; the intern table is torn
+ * down when the pool is freed or destroyed.
+ */
+WS_DLL_PUBLIC
+const char *
+wmem_strdup_intern(wmem_allocator_t *allocator, const char *src);
+
+/**
+ * Like wmem_strdup_intern(), but limited to len bytes of src, stopping
+ * early at a null terminator as wmem_strndup() does.
+ */
+WS_DLL_PUBLIC
+const char *
+wmem_strndup_intern(wmem_allocator_t *allocator, const char *src,
+        const size_t len);
+
 /**
  * Return the first occurrence of needle in haystack.
  *
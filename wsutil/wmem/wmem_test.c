@@ -369,6 +369,59 @@ wmem_test_allocator_strict(void)
     wmem_test_allocator_jumbo(WMEM_ALLOCATOR_STRICT, &wmem_strict_check_canaries);
 }
 
+static void
+wmem_test_allocator_snapshot(void)
+{
+    wmem_allocator_t *allocator;
+    void *snapshot;
+    char *ptr;
+    int i;
+
+    allocator = wmem_allocator_force_new(WMEM_ALLOCATOR_BLOCK_FAST);
+
+    /* Allocations made before the snapshot must survive rollbacks. */
+    ptr = (char *)wmem_alloc(allocator, 32);
+    memset(ptr, 'A', 32);
+
+    snapshot = wmem_snapshot(allocator);
+    g_assert_true(snapshot != NULL);
+
+    /* Spill into several fresh blocks and a couple of jumbo allocations,
+     * then roll all of it back; do it twice to check that a snapshot
+     * survives being rolled back to. */
+    for (i=0; i<2; i++) {
+        char *scratch;
+
+        scratch = (char *)wmem_alloc0(allocator, 3*1024*1024);
+        scratch = (char *)wmem_alloc0(allocator, MAX_ALLOC_SIZE);
+        scratch = (char *)wmem_alloc0(allocator, 4*1024*1024);
+        memset(scratch, 'B', 4*1024*1024);
+        wmem_rollback(allocator, snapshot);
+    }
+
+    for (i=0; i<32; i++) {
+        g_assert_true(ptr[i] == 'A');
+    }
+
+    /* The pool must still be usable after a rollback. */
+    ptr = (char *)wmem_alloc0(allocator, 128);
+    g_assert_true(ptr[0] == 0);
+    wmem_free_all(allocator);
+
+    wmem_destroy_allocator(allocator);
+
+    /* Allocators without watermark support hand back NULL, and rolling
+     * back NULL is a no-op. */
+    allocator = wmem_allocator_force_new(WMEM_ALLOCATOR_STRICT);
+    snapshot = wmem_snapshot(allocator);
+    g_assert_true(snapshot == NULL);
+    ptr = (char *)wmem_alloc0(allocator, 32);
+    wmem_rollback(allocator, snapshot);
+    g_assert_true(ptr[0] == 0);
+    wmem_strict_check_canaries(allocator);
+    wmem_destroy_allocator(allocator);
+}
+
 /* UTILITY TESTING FUNCTIONS (/wmem/utils/) */
 
 static void
@@ -449,6 +502,24 @@ wmem_test_strutls(void)
                "........................................"
                "..................................String");
 
+    orig_str = "DUPLICATE";
+    const char *int_str1 = wmem_strdup_intern(allocator, orig_str);
+    g_assert_cmpstr(int_str1, ==, orig_str);
+    g_assert_true(int_str1 != orig_str);
+    const char *int_str2 = wmem_strdup_intern(allocator, "DUPLICATE");
+    g_assert_true(int_str1 == int_str2);
+    int_str2 = wmem_strndup_intern(allocator, "DUPLICATExyz", 9);
+    g_assert_true(int_str1 == int_str2);
+    int_str2 = wmem_strdup_intern(allocator, "UNIQUE");
+    g_assert_true(int_str1 != int_str2);
+    g_assert_cmpstr(int_str2, ==, "UNIQUE");
+    wmem_strict_check_canaries(allocator);
+
+    /* Freeing the pool must also reset the intern table. */
+    wmem_free_all(allocator);
+    int_str2 = wmem_strdup_intern(allocator, "DUPLICATE");
+    g_assert_cmpstr(int_str2, ==, "DUPLICATE");
+
     wmem_destroy_allocator(allocator);
 }
 
@@ -1090,6 +1161,7 @@ wmem_test_strbuf(void)
 {
     wmem_allocator_t   *allocator;
     wmem_strbuf_t      *strbuf;
+    char               *new_str;
     int                 i;
 
     allocator = wmem_allocator_new(WMEM_ALLOCATOR_STRICT);
@@ -1136,6 +1208,21 @@ wmem_test_strbuf(void)
 
     wmem_free_all(allocator);
 
+    /* Short strings are stored inline in the header allocation; check
+     * finalizing one, and growing one past the inline limit. */
+    strbuf = wmem_strbuf_new(allocator, "SHORT");
+    new_str = wmem_strbuf_finalize(strbuf);
+    g_assert_cmpstr(new_str, ==, "SHORT");
+    wmem_strict_check_canaries(allocator);
+
+    strbuf = wmem_strbuf_new(allocator, "START");
+    wmem_strbuf_append_c_count(strbuf, 'x', 200);
+    g_assert_cmpuint(wmem_strbuf_get_len(strbuf), ==, 205);
+    g_assert_true(strncmp(wmem_strbuf_get_str(strbuf), "STARTxxx", 8) == 0);
+    wmem_strict_check_canaries(allocator);
+
+    wmem_free_all(allocator);
+
     strbuf = wmem_strbuf_new(allocator, "TEST");
     for (i=0; i<1024; i++) {
         if (g_test_rand_bit()) {
@@ -1457,6 +1544,7 @@ main(int argc, char **argv)
     g_test_add_func("/wmem/allocator/simple",    wmem_test_allocator_simple);
     g_test_add_func("/wmem/allocator/strict",    wmem_test_allocator_strict);
     g_test_add_func("/wmem/allocator/callbacks", wmem_test_allocator_callbacks);
+    g_test_add_func("/wmem/allocator/snapshot",  wmem_test_allocator_snapshot);
 
     g_test_add_func("/wmem/utils/misc",    wmem_test_miscutls);
     g_test_add_func("/wmem/utils/strings", wmem_test_strutls);
@@ -45,6 +45,10 @@ typedef struct _wmem_tree_node_t wmem_tree_node_t;
 
 typedef struct _wmem_itree_node_t wmem_itree_node_t;
 
+/* Nodes are carved from slabs rather than allocated one by one; see
+ * create_node() in wmem_tree.c. */
+typedef struct _wmem_tree_slab_t wmem_tree_slab_t;
+
 struct _wmem_tree_t {
     wmem_allocator_t *metadata_allocator;
     wmem_allocator_t *data_allocator;
@@ -52,6 +56,9 @@ struct _wmem_tree_t {
     unsigned          metadata_scope_cb_id;
     unsigned          data_scope_cb_id;
 
+    wmem_tree_slab_t *node_slabs;
+    unsigned          node_slab_used;
+
     void (*post_rotation_cb)(wmem_tree_node_t *);
 };
 
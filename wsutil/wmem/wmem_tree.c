@@ -211,6 +211,8 @@ wmem_tree_reset_cb(wmem_allocator_t *allocator _U_, wmem_cb_event_t event,
     wmem_tree_t *tree = (wmem_tree_t *)user_data;
 
     tree->root = NULL;
+    tree->node_slabs = NULL;
+    tree->node_slab_used = 0;
 
     if (event == WMEM_CB_DESTROY_EVENT) {
         wmem_unregister_callback(tree->metadata_allocator, tree->metadata_scope_cb_id);
@@ -275,13 +277,18 @@ free_tree_node(wmem_allocator_t *allocator, wmem_tree_node_t* node, bool free_ke
     if (free_values) {
         wmem_free(allocator, node->data);
     }
-    wmem_free(allocator, node);
 }
 
 void
 wmem_tree_destroy(wmem_tree_t *tree, bool free_keys, bool free_values)
 {
+    wmem_tree_slab_t *slab, *next_slab;
+
     free_tree_node(tree->data_allocator, tree->root, free_keys, free_values);
+    for (slab = tree->node_slabs; slab; slab = next_slab) {
+        next_slab = slab->next;
+        wmem_free(tree->data_allocator, slab);
+    }
     if (tree->metadata_allocator) {
         wmem_unregister_callback(tree->metadata_allocator, tree->metadata_scope_cb_id);
     }
@@ -318,13 +325,35 @@ wmem_tree_count(wmem_tree_t* tree)
     return count;
 }
 
+/* How many nodes to carve from one slab allocation. */
+#define WMEM_TREE_NODE_SLAB 16
+
+struct _wmem_tree_slab_t {
+    struct _wmem_tree_slab_t *next;
+    wmem_tree_node_t nodes[WMEM_TREE_NODE_SLAB];
+};
+
 static wmem_tree_node_t *
-create_node(wmem_allocator_t *allocator, wmem_tree_node_t *parent, const void *key,
+create_node(wmem_tree_t *tree, wmem_tree_node_t *parent, const void *key,
         void *data, wmem_node_color_t color, bool is_subtree)
 {
     wmem_tree_node_t *node;
 
-    node = wmem_new(allocator, wmem_tree_node_t);
+    /* Nodes come from per-tree slabs: one allocator call per
+     * WMEM_TREE_NODE_SLAB insertions, and nodes inserted together (often
+     * in key order) end up adjacent in memory.  There is no per-node
+     * free; "removal" just marks nodes, and the slabs are released when
+     * the tree is destroyed or its scope is reset. */
+    if (tree->node_slabs == NULL ||
+            tree->node_slab_used == WMEM_TREE_NODE_SLAB) {
+        wmem_tree_slab_t *slab;
+
+        slab = wmem_new(tree->data_allocator, wmem_tree_slab_t);
+        slab->next = tree->node_slabs;
+        tree->node_slabs = slab;
+        tree->node_slab_used = 0;
+    }
+    node = &tree->node_slabs->nodes[tree->node_slab_used++];
 
     node->left   = NULL;
     node->right  = NULL;
@@ -355,7 +384,7 @@ lookup_or_insert32_node(wmem_tree_t *tree, uint32_t key,
 
     /* is this the first node ?*/
     if (!node) {
-        new_node = create_node(tree->data_allocator, NULL, GUINT_TO_POINTER(key),
+        new_node = create_node(tree, NULL, GUINT_TO_POINTER(key),
                 CREATE_DATA(func, data), WMEM_NODE_COLOR_BLACK, is_subtree);
         tree->root = new_node;
         return new_node;
@@ -378,7 +407,7 @@ lookup_or_insert32_node(wmem_tree_t *tree, uint32_t key,
             }
             else {
                 /* new node to the left */
-                new_node = create_node(tree->data_allocator, node, GUINT_TO_POINTER(key),
+                new_node = create_node(tree, node, GUINT_TO_POINTER(key),
                         CREATE_DATA(func, data), WMEM_NODE_COLOR_RED,
                         is_subtree);
                 node->left = new_node;
@@ -390,7 +419,7 @@ lookup_or_insert32_node(wmem_tree_t *tree, uint32_t key,
             }
             else {
                 /* new node to the right */
-                new_node = create_node(tree->data_allocator, node, GUINT_TO_POINTER(key),
+                new_node = create_node(tree, node, GUINT_TO_POINTER(key),
                         CREATE_DATA(func, data), WMEM_NODE_COLOR_RED,
                         is_subtree);
                 node->right = new_node;
@@ -448,7 +477,7 @@ wmem_tree_insert(wmem_tree_t *tree, const void *key, void *data, compare_func cm
 
     /* is this the first node ?*/
     if (!node) {
-        tree->root = create_node(tree->data_allocator, node, key,
+        tree->root = create_node(tree, node, key,
                 data, WMEM_NODE_COLOR_BLACK, false);
         return tree->root;
     }
@@ -468,7 +497,7 @@ wmem_tree_insert(wmem_tree_t *tree, const void *key, void *data, compare_func cm
                 node = node->left;
             }
             else {
-                new_node = create_node(tree->data_allocator, node, key,
+                new_node = create_node(tree, node, key,
                         data, WMEM_NODE_COLOR_RED, false);
                 node->left = new_node;
             }
@@ -479,7 +508,7 @@ wmem_tree_insert(wmem_tree_t *tree, const void *key, void *data, compare_func cm
             }
             else {
                 /* new node to the right */
-                new_node = create_node(tree->data_allocator, node, key,
+                new_node = create_node(tree, node, key,
                         data, WMEM_NODE_COLOR_RED, false);
                 node->right = new_node;
             }
@@ -32,8 +32,12 @@ ws_mempbrk_compile(ws_mempbrk_pattern* pattern, const char *needles)
 {
     const char *n = needles;
     memset(pattern->patt, 0, 256);
+    pattern->needle_count = 0;
     while (*n) {
         pattern->patt[(int)*n] = 1;
+        if (pattern->needle_count < WS_MEMPBRK_MAX_FAST_NEEDLES)
+            pattern->needles[pattern->needle_count] = (uint8_t)*n;
+        pattern->needle_count++;
         n++;
     }
 
@@ -48,6 +52,28 @@ ws_mempbrk_portable_exec(const uint8_t* haystack, size_t haystacklen, const ws_m
 {
     const uint8_t *haystack_end = haystack + haystacklen;
 
+    /* For a handful of needles it's cheaper to let memchr() -- which is
+     * vectorized by every libc we care about -- scan once per needle,
+     * narrowing the search to the earliest hit so far, than to walk the
+     * haystack a byte at a time through the lookup table. */
+    if (pattern->needle_count <= WS_MEMPBRK_MAX_FAST_NEEDLES) {
+        const uint8_t *earliest = NULL;
+        size_t scanlen = haystacklen;
+
+        for (unsigned i = 0; i < pattern->needle_count; i++) {
+            const uint8_t *hit = (const uint8_t *)memchr(haystack,
+                pattern->needles[i], scanlen);
+            if (hit) {
+                earliest = hit;
+                if (found_needle)
+                    *found_needle = pattern->needles[i];
+                /* Later needles only matter if they occur sooner. */
+                scanlen = (size_t)(hit - haystack);
+            }
+        }
+        return earliest;
+    }
+
     while (haystack < haystack_end) {
         if (pattern->patt[*haystack]) {
             if (found_needle)
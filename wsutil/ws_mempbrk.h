@@ -18,8 +18,19 @@
 
 /** The pattern object used for ws_mempbrk_exec().
  */
+/** Patterns with at most this many needles get a memchr()-based fast
+ * path on platforms without SSE4.2.
+ */
+#define WS_MEMPBRK_MAX_FAST_NEEDLES 3
+
 typedef struct {
     char patt[256];
+    /** The needle bytes themselves, if there are few enough of them for
+     * the memchr() fast path; needle_count > WS_MEMPBRK_MAX_FAST_NEEDLES
+     * means the table scan must be used.
+     */
+    uint8_t needles[WS_MEMPBRK_MAX_FAST_NEEDLES];
+    unsigned needle_count;
 #ifdef HAVE_SSE4_2
     bool use_sse42;
     __m128i mask;
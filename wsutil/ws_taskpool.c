@@ -0,0 +1,373 @@
+/* ws_taskpool.c
+ * Shared worker-thread pool for parallel work.
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#include "config.h"
+#include "ws_taskpool.h"
+
+#include <wsutil/ws_assert.h>
+
+typedef struct {
+    ws_task_func_t   func;
+    void            *user_data;
+    ws_task_group_t *group;     /* may be NULL (internal tasks) */
+} ws_task_t;
+
+struct ws_taskpool {
+    GThread **threads;
+    unsigned  n_threads;
+    GMutex    lock;
+    GCond     cond;          /* a task was queued, or we're shutting down */
+    GQueue    tasks;         /* of ws_task_t * */
+    bool      shutting_down;
+};
+
+struct ws_task_group {
+    ws_taskpool_t *pool;
+    GMutex         lock;
+    GCond          cond;     /* outstanding dropped to zero */
+    unsigned       outstanding;
+};
+
+static void
+ws_task_group_task_done(ws_task_group_t *group)
+{
+    g_mutex_lock(&group->lock);
+    group->outstanding--;
+    if (group->outstanding == 0)
+        g_cond_broadcast(&group->cond);
+    g_mutex_unlock(&group->lock);
+}
+
+static void *
+ws_taskpool_worker(void *arg)
+{
+    ws_taskpool_t *pool = (ws_taskpool_t *)arg;
+
+    g_mutex_lock(&pool->lock);
+    for (;;) {
+        ws_task_t *task;
+
+        while (g_queue_is_empty(&pool->tasks) && !pool->shutting_down)
+            g_cond_wait(&pool->cond, &pool->lock);
+        if (g_queue_is_empty(&pool->tasks)) {
+            /* Shutting down and nothing left to run. */
+            break;
+        }
+        task = (ws_task_t *)g_queue_pop_head(&pool->tasks);
+        g_mutex_unlock(&pool->lock);
+
+        task->func(task->user_data);
+        if (task->group != NULL)
+            ws_task_group_task_done(task->group);
+        g_free(task);
+
+        g_mutex_lock(&pool->lock);
+    }
+    g_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+ws_taskpool_t *
+ws_taskpool_new(unsigned n_threads)
+{
+    ws_taskpool_t *pool = g_new0(ws_taskpool_t, 1);
+
+    if (n_threads == 0)
+        n_threads = g_get_num_processors();
+
+    g_mutex_init(&pool->lock);
+    g_cond_init(&pool->cond);
+    g_queue_init(&pool->tasks);
+    pool->n_threads = n_threads;
+    pool->threads = g_new0(GThread *, n_threads);
+    for (unsigned i = 0; i < n_threads; i++)
+        pool->threads[i] = g_thread_new("ws_taskpool", ws_taskpool_worker, pool);
+
+    return pool;
+}
+
+ws_taskpool_t *
+ws_taskpool_shared(void)
+{
+    static gsize shared_pool_init;
+    static ws_taskpool_t *shared_pool;
+
+    if (g_once_init_enter(&shared_pool_init)) {
+        shared_pool = ws_taskpool_new(0);
+        g_once_init_leave(&shared_pool_init, 1);
+    }
+    return shared_pool;
+}
+
+unsigned
+ws_taskpool_n_threads(const ws_taskpool_t *pool)
+{
+    return pool->n_threads;
+}
+
+void
+ws_taskpool_free(ws_taskpool_t *pool)
+{
+    g_mutex_lock(&pool->lock);
+    pool->shutting_down = true;
+    g_cond_broadcast(&pool->cond);
+    g_mutex_unlock(&pool->lock);
+
+    for (unsigned i = 0; i < pool->n_threads; i++)
+        g_thread_join(pool->threads[i]);
+
+    ws_assert(g_queue_is_empty(&pool->tasks));
+    g_free(pool->threads);
+    g_mutex_clear(&pool->lock);
+    g_cond_clear(&pool->cond);
+    g_free(pool);
+}
+
+ws_task_group_t *
+ws_task_group_new(ws_taskpool_t *pool)
+{
+    ws_task_group_t *group = g_new0(ws_task_group_t, 1);
+
+    group->pool = pool;
+    g_mutex_init(&group->lock);
+    g_cond_init(&group->cond);
+    return group;
+}
+
+void
+ws_task_group_push(ws_task_group_t *group, ws_task_func_t func, void *user_data)
+{
+    ws_taskpool_t *pool = group->pool;
+    ws_task_t *task = g_new0(ws_task_t, 1);
+
+    task->func = func;
+    task->user_data = user_data;
+    task->group = group;
+
+    g_mutex_lock(&group->lock);
+    group->outstanding++;
+    g_mutex_unlock(&group->lock);
+
+    g_mutex_lock(&pool->lock);
+    g_queue_push_tail(&pool->tasks, task);
+    g_cond_signal(&pool->cond);
+    g_mutex_unlock(&pool->lock);
+}
+
+void
+ws_task_group_wait(ws_task_group_t *group)
+{
+    g_mutex_lock(&group->lock);
+    while (group->outstanding > 0)
+        g_cond_wait(&group->cond, &group->lock);
+    g_mutex_unlock(&group->lock);
+}
+
+void
+ws_task_group_free(ws_task_group_t *group)
+{
+    ws_task_group_wait(group);
+    g_mutex_clear(&group->lock);
+    g_cond_clear(&group->cond);
+    g_free(group);
+}
+
+/*
+ * Parallel-for.  Instead of pre-splitting the range, workers pull
+ * chunks from a shared counter, so a worker that lands on cheap indexes
+ * automatically takes more of the range; that gives the load balancing
+ * of work stealing without per-thread deques.
+ */
+typedef struct {
+    GMutex                 lock;
+    uint64_t               next;
+    uint64_t               end;
+    uint64_t               chunk;
+    ws_parallel_for_func_t func;
+    void                  *user_data;
+} parallel_for_state_t;
+
+static void
+parallel_for_run(void *arg)
+{
+    parallel_for_state_t *state = (parallel_for_state_t *)arg;
+
+    for (;;) {
+        uint64_t chunk_start, chunk_end;
+
+        g_mutex_lock(&state->lock);
+        if (state->next >= state->end) {
+            g_mutex_unlock(&state->lock);
+            return;
+        }
+        chunk_start = state->next;
+        chunk_end = MIN(chunk_start + state->chunk, state->end);
+        state->next = chunk_end;
+        g_mutex_unlock(&state->lock);
+
+        state->func(chunk_start, chunk_end, state->user_data);
+    }
+}
+
+void
+ws_taskpool_parallel_for(ws_taskpool_t *pool, uint64_t start, uint64_t end,
+        uint64_t min_chunk, ws_parallel_for_func_t func, void *user_data)
+{
+    parallel_for_state_t state;
+    ws_task_group_t *group;
+    unsigned n_helpers;
+
+    if (start >= end)
+        return;
+    if (min_chunk == 0)
+        min_chunk = 1;
+    if (pool == NULL)
+        pool = ws_taskpool_shared();
+
+    /* Not worth waking anybody for less than two chunks. */
+    if (end - start < 2 * min_chunk || pool->n_threads == 0) {
+        func(start, end, user_data);
+        return;
+    }
+
+    g_mutex_init(&state.lock);
+    state.next = start;
+    state.end = end;
+    /* Aim for a few chunks per thread (counting ourselves), so the tail
+     * of the range still spreads across workers. */
+    state.chunk = MAX(min_chunk, (end - start) / ((pool->n_threads + 1) * 4));
+    state.func = func;
+    state.user_data = user_data;
+
+    /* No point in more helpers than chunks. */
+    n_helpers = (unsigned)MIN((uint64_t)pool->n_threads,
+                              (end - start) / state.chunk);
+
+    group = ws_task_group_new(pool);
+    for (unsigned i = 0; i < n_helpers; i++)
+        ws_task_group_push(group, parallel_for_run, &state);
+
+    /* The calling thread works too, instead of just blocking. */
+    parallel_for_run(&state);
+
+    ws_task_group_free(group);
+    g_mutex_clear(&state.lock);
+}
+
+/*
+ * Bounded multi-producer/multi-consumer queue: a mutex-protected ring
+ * of pointers with separate "not empty" and "not full" conditions.
+ */
+struct ws_bounded_queue {
+    GMutex    lock;
+    GCond     not_empty;
+    GCond     not_full;
+    void    **items;
+    unsigned  capacity;
+    unsigned  head;       /* index of the oldest item */
+    unsigned  len;
+};
+
+ws_bounded_queue_t *
+ws_bounded_queue_new(unsigned capacity)
+{
+    ws_bounded_queue_t *queue;
+
+    ws_assert(capacity > 0);
+    queue = g_new0(ws_bounded_queue_t, 1);
+    g_mutex_init(&queue->lock);
+    g_cond_init(&queue->not_empty);
+    g_cond_init(&queue->not_full);
+    queue->items = g_new(void *, capacity);
+    queue->capacity = capacity;
+    return queue;
+}
+
+void
+ws_bounded_queue_push(ws_bounded_queue_t *queue, void *item)
+{
+    g_mutex_lock(&queue->lock);
+    while (queue->len == queue->capacity)
+        g_cond_wait(&queue->not_full, &queue->lock);
+    queue->items[(queue->head + queue->len) % queue->capacity] = item;
+    queue->len++;
+    g_cond_signal(&queue->not_empty);
+    g_mutex_unlock(&queue->lock);
+}
+
+bool
+ws_bounded_queue_try_push(ws_bounded_queue_t *queue, void *item)
+{
+    bool pushed = false;
+
+    g_mutex_lock(&queue->lock);
+    if (queue->len < queue->capacity) {
+        queue->items[(queue->head + queue->len) % queue->capacity] = item;
+        queue->len++;
+        g_cond_signal(&queue->not_empty);
+        pushed = true;
+    }
+    g_mutex_unlock(&queue->lock);
+    return pushed;
+}
+
+void *
+ws_bounded_queue_pop(ws_bounded_queue_t *queue)
+{
+    void *item;
+
+    g_mutex_lock(&queue->lock);
+    while (queue->len == 0)
+        g_cond_wait(&queue->not_empty, &queue->lock);
+    item = queue->items[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->len--;
+    g_cond_signal(&queue->not_full);
+    g_mutex_unlock(&queue->lock);
+    return item;
+}
+
+void *
+ws_bounded_queue_try_pop(ws_bounded_queue_t *queue)
+{
+    void *item = NULL;
+
+    g_mutex_lock(&queue->lock);
+    if (queue->len > 0) {
+        item = queue->items[queue->head];
+        queue->head = (queue->head + 1) % queue->capacity;
+        queue->len--;
+        g_cond_signal(&queue->not_full);
+    }
+    g_mutex_unlock(&queue->lock);
+    return item;
+}
+
+void
+ws_bounded_queue_free(ws_bounded_queue_t *queue)
+{
+    g_free(queue->items);
+    g_mutex_clear(&queue->lock);
+    g_cond_clear(&queue->not_empty);
+    g_cond_clear(&queue->not_full);
+    g_free(queue);
+}
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 4
+ * tab-width: 8
+ * indent-tabs-mode: nil
+ * End:
+ *
+ * vi: set shiftwidth=4 tabstop=8 expandtab:
+ * :indentSize=4:tabSize=8:noTabs=true:
+ */
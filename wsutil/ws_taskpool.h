@@ -0,0 +1,144 @@
+/** @file
+ *
+ * Shared worker-thread pool for parallel work.
+ *
+ * Wireshark - Network traffic analyzer
+ * By Gerald Combs <gerald@wireshark.org>
+ * Copyright 1998 Gerald Combs
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef __WS_TASKPOOL_H__
+#define __WS_TASKPOOL_H__
+
+#include <wireshark.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/** @file
+ * A small task scheduler for the parallel features in the libraries and
+ * the CLI tools, so each of them doesn't grow its own threading code.
+ * It provides a pool of worker threads fed from a shared task queue,
+ * task groups that can be waited on, a parallel-for over an index range
+ * with dynamic chunking, and a bounded multi-producer/multi-consumer
+ * queue for pipelines.
+ *
+ * The scheduler runs tasks; it makes no promises about what the tasks
+ * may touch.  In particular, libwireshark dissection is single-threaded,
+ * so tasks must not dissect concurrently.
+ */
+
+struct ws_taskpool;
+typedef struct ws_taskpool ws_taskpool_t;
+
+struct ws_task_group;
+typedef struct ws_task_group ws_task_group_t;
+
+/** A task: called once on some pool thread with its user data. */
+typedef void (*ws_task_func_t)(void *user_data);
+
+/** A parallel-for body: called with half-open index ranges [start, end).
+ * Ranges handed to different calls never overlap and together cover the
+ * whole iteration space, but arrive in no particular order. */
+typedef void (*ws_parallel_for_func_t)(uint64_t start, uint64_t end,
+    void *user_data);
+
+/**
+ * Create a pool with the given number of worker threads; 0 means one
+ * per available processor.
+ */
+WS_DLL_PUBLIC ws_taskpool_t *ws_taskpool_new(unsigned n_threads);
+
+/**
+ * Return the process-wide shared pool, creating it on first use with
+ * one thread per available processor.  Never freed; intended for
+ * subsystems that need occasional parallelism without owning a pool.
+ */
+WS_DLL_PUBLIC ws_taskpool_t *ws_taskpool_shared(void);
+
+/** Return the number of worker threads in the pool. */
+WS_DLL_PUBLIC unsigned ws_taskpool_n_threads(const ws_taskpool_t *pool);
+
+/**
+ * Wait for all queued tasks to finish, join the workers, and free the
+ * pool.  Must not be called from a pool thread.
+ */
+WS_DLL_PUBLIC void ws_taskpool_free(ws_taskpool_t *pool);
+
+/**
+ * Create a task group on a pool.  A group only tracks completion; tasks
+ * from different groups share the pool's queue.
+ */
+WS_DLL_PUBLIC ws_task_group_t *ws_task_group_new(ws_taskpool_t *pool);
+
+/** Queue a task as part of a group. */
+WS_DLL_PUBLIC void ws_task_group_push(ws_task_group_t *group,
+    ws_task_func_t func, void *user_data);
+
+/**
+ * Block until every task pushed to the group so far has finished.
+ * Must not be called from a task in the same group.
+ */
+WS_DLL_PUBLIC void ws_task_group_wait(ws_task_group_t *group);
+
+/** Wait for the group's tasks and free the group. */
+WS_DLL_PUBLIC void ws_task_group_free(ws_task_group_t *group);
+
+/**
+ * Run func over [start, end) on the pool's threads and the calling
+ * thread, handing out chunks of at least min_chunk indexes from a
+ * shared counter, so fast workers automatically take more of the range.
+ * Returns when the whole range has been processed.  Small ranges run
+ * inline on the calling thread.  A NULL pool means the shared pool.
+ */
+WS_DLL_PUBLIC void ws_taskpool_parallel_for(ws_taskpool_t *pool,
+    uint64_t start, uint64_t end, uint64_t min_chunk,
+    ws_parallel_for_func_t func, void *user_data);
+
+struct ws_bounded_queue;
+typedef struct ws_bounded_queue ws_bounded_queue_t;
+
+/**
+ * Create a bounded blocking queue holding up to capacity pointers.
+ * Safe for any number of producers and consumers; pushing into a full
+ * queue and popping from an empty one block, which is what bounds the
+ * memory of a pipeline whose stages run at different speeds.
+ */
+WS_DLL_PUBLIC ws_bounded_queue_t *ws_bounded_queue_new(unsigned capacity);
+
+/** Push an item, blocking while the queue is full. */
+WS_DLL_PUBLIC void ws_bounded_queue_push(ws_bounded_queue_t *queue, void *item);
+
+/** Push an item if there is room; returns false if the queue is full. */
+WS_DLL_PUBLIC bool ws_bounded_queue_try_push(ws_bounded_queue_t *queue, void *item);
+
+/** Pop the oldest item, blocking while the queue is empty. */
+WS_DLL_PUBLIC void *ws_bounded_queue_pop(ws_bounded_queue_t *queue);
+
+/** Pop the oldest item, or return NULL if the queue is empty. */
+WS_DLL_PUBLIC void *ws_bounded_queue_try_pop(ws_bounded_queue_t *queue);
+
+/** Free the queue.  Any items still queued are the caller's problem. */
+WS_DLL_PUBLIC void ws_bounded_queue_free(ws_bounded_queue_t *queue);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __WS_TASKPOOL_H__ */
+
+/*
+ * Editor modelines  -  https://www.wireshark.org/tools/modelines.html
+ *
+ * Local variables:
+ * c-basic-offset: 4
+ * tab-width: 8
+ * indent-tabs-mode: nil
+ * End:
+ *
+ * vi: set shiftwidth=4 tabstop=8 expandtab:
+ * :indentSize=4:tabSize=8:noTabs=true:
+ */